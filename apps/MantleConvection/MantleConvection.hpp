@@ -1353,6 +1353,8 @@ class MantleConvectionModel
          return velocity[int_c( coordIdx )] / ND_.uRef_ / plateVelocityScaling_;
       };
 
+      plateOracle_->prepareAge( plateAge );
+
       for ( coordIdx = 0; coordIdx < u.getDimension(); coordIdx++ )
       {
          //interpolate current plate velocities at the surface
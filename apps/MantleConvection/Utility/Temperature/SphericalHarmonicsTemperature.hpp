@@ -73,6 +73,20 @@ class SphericalHarmonicsTemperature : public TemperatureModel< real_t >
       }
 
       sphTool_ = std::make_shared< terraneo::SphericalHarmonicsTool >( degreeMaxSH_ );
+
+      // collect the random weights in a coefficient vector, so that the whole superposition is evaluated at once
+      coefficientsSH_.assign( terraneo::SphericalHarmonicsTool::numberOfCoefficients( degreeMaxSH_ ), real_c( 0 ) );
+      uint_t count = 0;
+      for ( uint_t deg = degreeMinSH_; deg <= degreeMaxSH_; ++deg )
+      {
+         for ( int ord = -int_c( deg ); ord <= int_c( deg ); ++ord )
+         {
+            const uint_t idx = terraneo::SphericalHarmonicsTool::coefficientIndex(
+                deg, walberla::uint_c( std::abs( ord ) ), ord > 0 ? 1 : 0 );
+            coefficientsSH_[idx] = superpositionRand_[count];
+            ++count;
+         }
+      }
    }
 
    real_t evaluateNoCheck( const hyteg::Point3D& x ) override
@@ -108,20 +122,11 @@ class SphericalHarmonicsTemperature : public TemperatureModel< real_t >
       }
 
       // 1/sqrt(4*pi) below changes the normalisation of the spherical harmonics, more suitable for our temp range of 0, 1
-      uint_t count = 0;
-
-      for ( uint_t deg = degreeMinSH_; deg <= degreeMaxSH_; ++deg )
-      {
-         for ( int ord = -int_c( deg ); ord <= int_c( deg ); ++ord )
-         {
-            // the "buoyancy factor" allows the user to scale up/down the temperature anomalies in the initial state from the parameter file
-            // the required factor, however, will need to be tuned depending on the superposition in question
-            // a more user-friendly solution is in the works
-            retVal += ( buoyancyFactor_ * superpositionRand_[count] * filter *
-                        sphTool_->shconvert_eval( deg, ord, x[0], x[1], x[2] ) / std::sqrt( real_c( 4 ) * pi ) );
-            ++count;
-         }
-      }
+      // the "buoyancy factor" allows the user to scale up/down the temperature anomalies in the initial state from the parameter file
+      // the required factor, however, will need to be tuned depending on the superposition in question
+      // a more user-friendly solution is in the works
+      retVal += ( buoyancyFactor_ * filter * sphTool_->evaluate( coefficientsSH_, degreeMaxSH_, x[0], x[1], x[2] ) /
+                  std::sqrt( real_c( 4 ) * pi ) );
 
       return std::max( std::min( retVal, temperatureCMB_ ), temperatureSurface_ );
    }
@@ -181,6 +186,7 @@ class SphericalHarmonicsTemperature : public TemperatureModel< real_t >
    real_t buoyancyFactor_;              // buoyancy factor for the spherical harmonics temperature initialisation
 
    std::vector< real_t > superpositionRand_;                     // random value vector for the spherical harmoics superposition
+   std::vector< real_t > coefficientsSH_;                        // superposition as vector of spherical harmonics coefficients
    std::shared_ptr< terraneo::SphericalHarmonicsTool > sphTool_; // terraneo spherical harmonics tool
    uint_fast32_t                                       randomSeed_; // random seed;
 };
@@ -205,6 +205,8 @@ void ConvectionSimulation< TemperatureFunction_T, ViscosityFunction_T >::updateP
                TN.simulationParameters.plateVelocityScaling ); //non-dimensionalise by dividing by characteristic velocity
    };
 
+   oracle->prepareAge( TN.simulationParameters.plateAge );
+
    for ( uint_t l = TN.domainParameters.minLevel; l <= TN.domainParameters.maxLevel; ++l )
    {
       for ( coordIdx = 0; coordIdx < 3; ++coordIdx )
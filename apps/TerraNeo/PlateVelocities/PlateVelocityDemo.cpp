@@ -132,6 +132,8 @@ void performComputations( uint_t                                     level,
    if ( jobType == VELOCITIES || jobType == VELOCITIES_AND_IDS )
    {
       surfaceVelocity = std::make_shared< feFuncType >( "plateVelocities", storage, level, level, 3 );
+
+      oracle.prepareAge( age );
       for ( coordIdx = 0; coordIdx < 3; ++coordIdx )
       {
          ( *surfaceVelocity )[coordIdx].interpolate( computeVelocityComponent, level, All );
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2026 Nils Kohl, Marcus Mohr.
+ *
+ * This file is part of HyTeG
+ * (see https://i10git.cs.fau.de/hyteg/hyteg).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Compares the throughput (iterations per second) of the classical Krylov solvers CGSolver and MinResSolver
+// with their pipelined counterparts PipelinedCGSolver and PipelinedMinResSolver. All solvers perform a fixed
+// number of iterations so that only the cost per iteration is measured.
+
+#include <iomanip>
+
+#include "core/Environment.h"
+#include "core/logging/Logging.h"
+#include "core/mpi/Reduce.h"
+#include "core/timing/Timer.h"
+
+#include "hyteg/p1functionspace/P1Function.hpp"
+#include "hyteg/p2functionspace/P2Function.hpp"
+#include "hyteg/primitivestorage/SetupPrimitiveStorage.hpp"
+#include "hyteg/solvers/CGSolver.hpp"
+#include "hyteg/solvers/MinresSolver.hpp"
+#include "hyteg/solvers/PipelinedCGSolver.hpp"
+#include "hyteg/solvers/PipelinedMinresSolver.hpp"
+
+#include "constant_stencil_operator/P1ConstantOperator.hpp"
+#include "constant_stencil_operator/P2ConstantOperator.hpp"
+
+using walberla::real_c;
+using walberla::real_t;
+using walberla::uint_c;
+using walberla::uint_t;
+
+using namespace hyteg;
+
+uint_t   levelGlobal;
+uint_t   numProc;
+uint_t   iterations;
+uint_t   repetitions;
+MeshInfo meshInfo    = MeshInfo::emptyMeshInfo();
+bool     printTiming = false;
+
+template < typename LaplaceOperator, typename SolverType >
+void measure( const std::string&                         solverName,
+              const std::shared_ptr< PrimitiveStorage >& storage,
+              const LaplaceOperator&                     L,
+              const typename LaplaceOperator::srcType&   u,
+              const typename LaplaceOperator::srcType&   f )
+{
+   SolverType solver( storage, levelGlobal, levelGlobal, iterations, real_c( 0 ), real_c( 0 ) );
+
+   double fastest = std::numeric_limits< double >::max();
+   for ( uint_t rep = 0; rep < repetitions; rep++ )
+   {
+      u.interpolate( real_c( 0 ), levelGlobal, All );
+
+      walberla::WcTimer timer;
+      WALBERLA_MPI_BARRIER();
+      timer.start();
+      solver.solve( L, u, f, levelGlobal );
+      WALBERLA_MPI_BARRIER();
+      timer.end();
+
+      fastest = std::min( fastest, timer.last() );
+   }
+   fastest = walberla::mpi::allReduce( fastest, walberla::mpi::MAX, walberla::mpi::MPIManager::instance()->comm() );
+
+   WALBERLA_LOG_INFO_ON_ROOT( std::setw( 16 ) << solverName << " | " << std::setw( 10 ) << std::fixed << std::setprecision( 4 )
+                                              << fastest << " | " << std::setw( 12 ) << std::setprecision( 2 )
+                                              << real_c( iterations ) / fastest );
+}
+
+template < typename LaplaceOperator >
+void runBenchmark()
+{
+   SetupPrimitiveStorage setupStorage( meshInfo, numProc );
+   setupStorage.setMeshBoundaryFlagsOnBoundary( 1, 0, true );
+   auto storage = std::make_shared< PrimitiveStorage >( setupStorage );
+
+   typename LaplaceOperator::srcType f( "f", storage, levelGlobal, levelGlobal );
+   typename LaplaceOperator::srcType u( "u", storage, levelGlobal, levelGlobal );
+
+   LaplaceOperator L( storage, levelGlobal, levelGlobal );
+
+   std::function< real_t( const hyteg::Point3D& ) > rhs = []( const hyteg::Point3D& x ) {
+      return std::sin( 2 * x[0] ) * std::sinh( x[1] ) + x[2];
+   };
+   f.interpolate( rhs, levelGlobal, All );
+
+   auto globalInfo = storage->getGlobalInfo();
+   WALBERLA_LOG_INFO_ON_ROOT( globalInfo )
+
+   WALBERLA_LOG_INFO_ON_ROOT( "Fixed number of iterations per run: " << iterations )
+   WALBERLA_LOG_INFO_ON_ROOT( "          solver |   time (s) |     iter / s" )
+   WALBERLA_LOG_INFO_ON_ROOT( "-----------------+------------+-------------" )
+
+   measure< LaplaceOperator, CGSolver< LaplaceOperator > >( "CG", storage, L, u, f );
+   measure< LaplaceOperator, PipelinedCGSolver< LaplaceOperator > >( "PipelinedCG", storage, L, u, f );
+   measure< LaplaceOperator, MinResSolver< LaplaceOperator > >( "MinRes", storage, L, u, f );
+   measure< LaplaceOperator, PipelinedMinResSolver< LaplaceOperator > >( "PipelinedMinRes", storage, L, u, f );
+
+   if ( printTiming )
+   {
+      walberla::WcTimingTree tt = storage->getTimingTree()->getReduced().getCopyWithRemainder();
+      WALBERLA_LOG_INFO_ON_ROOT( tt );
+   }
+}
+
+int main( int argc, char* argv[] )
+{
+   walberla::Environment env( argc, argv );
+   walberla::MPIManager::instance()->useWorldComm();
+
+   auto cfg = std::make_shared< walberla::config::Config >();
+   if ( env.config() == nullptr )
+   {
+      auto defaultFile = "./PipelinedKrylovBenchmark.prm";
+      WALBERLA_LOG_INFO_ON_ROOT( "No Parameter file given loading default parameter file: " << defaultFile );
+      cfg->readParameterFile( defaultFile );
+   }
+   else
+   {
+      cfg = env.config();
+   }
+   const walberla::Config::BlockHandle mainConf = cfg->getBlock( "Parameters" );
+
+   levelGlobal                      = mainConf.getParameter< uint_t >( "level" );
+   const std::string discretization = mainConf.getParameter< std::string >( "discretization" );
+   const std::string dimension      = mainConf.getParameter< std::string >( "dimension" );
+   iterations                       = mainConf.getParameter< uint_t >( "iterations" );
+   repetitions                      = mainConf.getParameter< uint_t >( "repetitions" );
+   printTiming                      = mainConf.getParameter< bool >( "printTiming" );
+
+   const uint_t facesPerProcess = mainConf.getParameter< uint_t >( "facesPerProcess" );
+
+   const uint_t cubesX = mainConf.getParameter< uint_t >( "cubesX" );
+   const uint_t cubesY = mainConf.getParameter< uint_t >( "cubesY" );
+   const uint_t cubesZ = mainConf.getParameter< uint_t >( "cubesZ" );
+
+   numProc = uint_c( walberla::mpi::MPIManager::instance()->numProcesses() );
+   if ( dimension == "2D" )
+   {
+      meshInfo = hyteg::MeshInfo::meshFaceChain( numProc * facesPerProcess );
+   }
+   else if ( dimension == "3D" )
+   {
+      meshInfo = hyteg::MeshInfo::meshSymmetricCuboid( Point3D( 0, 0, 0 ), Point3D( 1, 1, 1 ), cubesX, cubesY, cubesZ );
+   }
+   else
+   {
+      WALBERLA_ABORT( "Wrong dimension: " << dimension )
+   }
+
+   if ( discretization == "P1" )
+   {
+      runBenchmark< hyteg::P1ConstantLaplaceOperator >();
+   }
+   else if ( discretization == "P2" )
+   {
+      runBenchmark< hyteg::P2ConstantLaplaceOperator >();
+   }
+   else
+   {
+      WALBERLA_ABORT( "Wrong discretization: " << discretization )
+   }
+}
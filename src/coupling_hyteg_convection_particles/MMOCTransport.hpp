@@ -20,6 +20,12 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <map>
+#include <numeric>
+#include <tuple>
+
 #include "core/math/MatrixMxN.h"
 #include "core/mpi/MPIWrapper.h"
 
@@ -34,6 +40,7 @@
 #include "hyteg/memory/TempFunctionManager.hpp"
 #include "hyteg/p1functionspace/P1Function.hpp"
 #include "hyteg/p1functionspace/VertexDoFIndexing.hpp"
+#include "hyteg/p1functionspace/VertexDoFMacroCell.hpp"
 #include "hyteg/p1functionspace/VertexDoFMacroEdge.hpp"
 #include "hyteg/p1functionspace/VertexDoFMacroFace.hpp"
 #include "hyteg/p1functionspace/VertexDoFMacroVertex.hpp"
@@ -608,6 +615,299 @@ inline void
    }
 }
 
+namespace detail {
+
+/// Location of a particle in a micro-cell of its containing macro-cell (see evaluateAtParticlePositions()).
+struct ParticleMicroCellLocation
+{
+   /// local number of the containing macro-cell, set to the number of local macro-cells if the particle is not evaluated
+   uint_t                           macroCell;
+   std::array< indexing::Index, 4 > microVertices;
+   std::array< uint_t, 4 >          vertexArrayIndices;
+   Point3D                          xiLocal;
+};
+
+/// Determines the position at which the functions are evaluated for the passed particle, respecting the handling of
+/// particles outside of the domain. Returns false if the particle is not evaluated at all.
+inline bool positionToEvaluate( const walberla::convection_particles::data::ParticleStorage::Particle& particle,
+                                const bool&                                              setParticlesOutsideDomainToZero,
+                                HandleOutsideDomainMethod                                handleOutsideDomainMethod_,
+                                const std::function< void( const Point3D&, Point3D& ) >& projectPointsBackOutsideDomain_,
+                                Point3D&                                                 position )
+{
+   if ( setParticlesOutsideDomainToZero && particle.getOutsideDomain() == 1 )
+   {
+      return false;
+   }
+
+   position = toPoint3D( particle.getPosition() );
+
+   if ( handleOutsideDomainMethod_ != HandleOutsideDomainMethod::DO_NOTHING && particle.getOutsideDomain() == 1 )
+   {
+      if ( handleOutsideDomainMethod_ == HandleOutsideDomainMethod::THROW_ERROR )
+      {
+         WALBERLA_ABORT( "Some points are tracked outside" );
+      }
+      else if ( handleOutsideDomainMethod_ == HandleOutsideDomainMethod::PROJECT_POINTS_BACK )
+      {
+         Point3D newPosition;
+         projectPointsBackOutsideDomain_( position, newPosition );
+
+         position = newPosition;
+      }
+      else
+      {
+         WALBERLA_ABORT( "Should not be here" );
+      }
+   }
+   return true;
+}
+
+} // namespace detail
+
+/// \brief Evaluates the passed functions at the positions of all particles in the storage.
+///
+/// In 3D, all particles are first located in the micro-cells of their containing macro-cells. They are then evaluated
+/// grouped by macro-cell and micro-cell, so that the DoF indices and values of a micro-cell are gathered only once for
+/// all functions and all particles inside it. Both passes are parallelized with OpenMP. In 2D and for the cautioned
+/// evaluation, the particles are evaluated one by one with evaluateAtParticlePosition() (in parallel as well).
+///
+/// The value of the i-th function at the position of the p-th particle is written to results[p * functions.size() + i].
+/// Particles that are outside the domain are set to zero if setParticlesOutsideDomainToZero is true.
+///
+/// With OpenMP, projectPointsBackOutsideDomain_ is called concurrently by several threads.
+template < typename FunctionType >
+inline void evaluateAtParticlePositions( PrimitiveStorage&                                      storage,
+                                         const std::vector< FunctionType >&                     functions,
+                                         walberla::convection_particles::data::ParticleStorage& particleStorage,
+                                         const uint_t&                                          level,
+                                         std::vector< real_t >&                                 results,
+                                         const bool&                                            setParticlesOutsideDomainToZero,
+                                         const bool&                                            cautionedEvaluate = false,
+                                         HandleOutsideDomainMethod                              handleOutsideDomainMethod_ =
+                                             HandleOutsideDomainMethod::DO_NOTHING,
+                                         std::function< void( const Point3D&, Point3D& ) > projectPointsBackOutsideDomain_ =
+                                             nullptr )
+{
+   const uint_t numParticles = uint_c( particleStorage.size() );
+   const uint_t numFunctions = functions.size();
+
+   results.assign( numParticles * numFunctions, real_c( 0 ) );
+
+   if ( !storage.hasGlobalCells() || cautionedEvaluate )
+   {
+#ifdef HYTEG_BUILD_WITH_OPENMP
+#pragma omp parallel for default( shared )
+#endif
+      for ( int p = 0; p < int_c( numParticles ); p++ )
+      {
+         std::vector< real_t > particleResults( numFunctions );
+         evaluateAtParticlePosition( storage,
+                                     functions,
+                                     particleStorage[uint_c( p )],
+                                     level,
+                                     particleResults,
+                                     setParticlesOutsideDomainToZero,
+                                     cautionedEvaluate,
+                                     handleOutsideDomainMethod_,
+                                     projectPointsBackOutsideDomain_ );
+         std::copy(
+             particleResults.begin(), particleResults.end(), results.begin() + std::ptrdiff_t( uint_c( p ) * numFunctions ) );
+      }
+      return;
+   }
+
+   const auto                      cellMap = storage.getCells();
+   std::vector< const Cell* >      cells;
+   std::map< PrimitiveID, uint_t > macroCellNumbers;
+   for ( const auto& it : cellMap )
+   {
+      macroCellNumbers[it.first] = cells.size();
+      cells.push_back( it.second.get() );
+   }
+   const uint_t notEvaluated = cells.size();
+
+   // 1. locate all particles in the micro-cells
+
+   std::vector< detail::ParticleMicroCellLocation > locations( numParticles );
+
+#ifdef HYTEG_BUILD_WITH_OPENMP
+#pragma omp parallel for default( shared )
+#endif
+   for ( int p = 0; p < int_c( numParticles ); p++ )
+   {
+      const auto particle = particleStorage[uint_c( p )];
+      auto&      location = locations[uint_c( p )];
+      location.macroCell  = notEvaluated;
+
+      Point3D position;
+      if ( !detail::positionToEvaluate( particle,
+                                        setParticlesOutsideDomainToZero,
+                                        handleOutsideDomainMethod_,
+                                        projectPointsBackOutsideDomain_,
+                                        position ) )
+      {
+         continue;
+      }
+
+      WALBERLA_CHECK( storage.cellExistsLocally( particle.getContainingPrimitive() ) );
+      location.macroCell = macroCellNumbers.at( particle.getContainingPrimitive() );
+      const Cell& cell   = *cells[location.macroCell];
+
+      Point3D computationalLocation;
+      cell.getGeometryMap()->evalFinv( position, computationalLocation );
+
+      location.microVertices = vertexdof::macrocell::detail::findLocalMicroCell( level, cell, computationalLocation );
+      for ( uint_t k = 0; k < 4; k++ )
+      {
+         location.vertexArrayIndices[k] = vertexdof::macrocell::index(
+             level, location.microVertices[k].x(), location.microVertices[k].y(), location.microVertices[k].z() );
+      }
+
+      location.xiLocal = vertexdof::macrocell::detail::transformToLocalTet(
+          vertexdof::macrocell::coordinateFromIndex( level, cell, location.microVertices[0] ),
+          vertexdof::macrocell::coordinateFromIndex( level, cell, location.microVertices[1] ),
+          vertexdof::macrocell::coordinateFromIndex( level, cell, location.microVertices[2] ),
+          vertexdof::macrocell::coordinateFromIndex( level, cell, location.microVertices[3] ),
+          computationalLocation );
+   }
+
+   // 2. sort the particles by macro-cell and micro-cell, particles that are not evaluated end up at the back
+
+   std::vector< uint_t > order( numParticles );
+   std::iota( order.begin(), order.end(), uint_t( 0 ) );
+   std::sort( order.begin(), order.end(), [&locations]( uint_t a, uint_t b ) {
+      return std::tie( locations[a].macroCell, locations[a].vertexArrayIndices ) <
+             std::tie( locations[b].macroCell, locations[b].vertexArrayIndices );
+   } );
+
+   // the particles order[groupBegin[g]], ..., order[groupBegin[g + 1] - 1] are located in the same micro-cell
+   std::vector< uint_t > groupBegin;
+   uint_t                numEvaluated = 0;
+   for ( ; numEvaluated < numParticles && locations[order[numEvaluated]].macroCell != notEvaluated; numEvaluated++ )
+   {
+      const auto& location = locations[order[numEvaluated]];
+      if ( numEvaluated == 0 || location.macroCell != locations[order[numEvaluated - 1]].macroCell ||
+           location.vertexArrayIndices != locations[order[numEvaluated - 1]].vertexArrayIndices )
+      {
+         groupBegin.push_back( numEvaluated );
+      }
+   }
+   groupBegin.push_back( numEvaluated );
+
+   // 3. gather the DoFs once per micro-cell and evaluate all particles inside it
+
+#ifdef HYTEG_BUILD_WITH_OPENMP
+#pragma omp parallel for default( shared )
+#endif
+   for ( int g = 0; g < int_c( groupBegin.size() ) - 1; g++ )
+   {
+      const auto& groupLocation = locations[order[groupBegin[uint_c( g )]]];
+      const Cell& cell          = *cells[groupLocation.macroCell];
+
+      if constexpr ( std::is_same< FunctionType, P1Function< real_t > >::value )
+      {
+         std::vector< real_t > dofs( 4 * numFunctions );
+         for ( uint_t i = 0; i < numFunctions; i++ )
+         {
+            const auto data = cell.getData( functions[i].getCellDataID() )->getPointer( level );
+            for ( uint_t k = 0; k < 4; k++ )
+            {
+               dofs[4 * i + k] = data[groupLocation.vertexArrayIndices[k]];
+            }
+         }
+
+         for ( uint_t j = groupBegin[uint_c( g )]; j < groupBegin[uint_c( g ) + 1]; j++ )
+         {
+            const uint_t                  p  = order[j];
+            const Point3D&                xi = locations[p].xiLocal;
+            const std::array< real_t, 4 > phi{ real_c( 1.0 ) - xi[0] - xi[1] - xi[2], xi[0], xi[1], xi[2] };
+
+            for ( uint_t i = 0; i < numFunctions; i++ )
+            {
+               real_t value = real_c( 0 );
+               for ( uint_t k = 0; k < 4; k++ )
+               {
+                  value += dofs[4 * i + k] * phi[k];
+               }
+               results[p * numFunctions + i] = value;
+            }
+         }
+      }
+      else if constexpr ( std::is_same< FunctionType, P2Function< real_t > >::value )
+      {
+         // edges of the micro-cell in the same order as in P2::macrocell::evaluate()
+         const std::array< std::pair< uint_t, uint_t >, 6 > edgeVertices{
+             { { 0, 1 }, { 0, 2 }, { 1, 2 }, { 0, 3 }, { 1, 3 }, { 2, 3 } } };
+
+         std::array< uint_t, 6 > edgeArrayIndices;
+         for ( uint_t k = 0; k < 6; k++ )
+         {
+            const indexing::Index& v0        = groupLocation.microVertices[edgeVertices[k].first];
+            const indexing::Index& v1        = groupLocation.microVertices[edgeVertices[k].second];
+            const auto             edgeIndex = edgedof::calcEdgeDoFIndex( v0, v1 );
+
+            edgeArrayIndices[k] = edgedof::macrocell::index( level,
+                                                             uint_c( edgeIndex.x() ),
+                                                             uint_c( edgeIndex.y() ),
+                                                             uint_c( edgeIndex.z() ),
+                                                             edgedof::calcEdgeDoFOrientation( v0, v1 ) );
+         }
+
+         std::vector< real_t > dofs( 10 * numFunctions );
+         for ( uint_t i = 0; i < numFunctions; i++ )
+         {
+            const auto vertexdofData = cell.getData( functions[i].getVertexDoFFunction().getCellDataID() )->getPointer( level );
+            const auto edgedofData   = cell.getData( functions[i].getEdgeDoFFunction().getCellDataID() )->getPointer( level );
+            for ( uint_t k = 0; k < 4; k++ )
+            {
+               dofs[10 * i + k] = vertexdofData[groupLocation.vertexArrayIndices[k]];
+            }
+            for ( uint_t k = 0; k < 6; k++ )
+            {
+               dofs[10 * i + 4 + k] = edgedofData[edgeArrayIndices[k]];
+            }
+         }
+
+         for ( uint_t j = groupBegin[uint_c( g )]; j < groupBegin[uint_c( g ) + 1]; j++ )
+         {
+            const uint_t p    = order[j];
+            const real_t xi_1 = locations[p].xiLocal[0];
+            const real_t xi_2 = locations[p].xiLocal[1];
+            const real_t xi_3 = locations[p].xiLocal[2];
+
+            // P2 basis functions, see P2::macrocell::evaluate()
+            const std::array< real_t, 10 > phi{
+                real_c( 2.0 * xi_1 * xi_1 + 4.0 * xi_1 * xi_2 + 4.0 * xi_1 * xi_3 - 3.0 * xi_1 + 2.0 * xi_2 * xi_2 +
+                        4.0 * xi_2 * xi_3 - 3.0 * xi_2 + 2.0 * xi_3 * xi_3 - 3.0 * xi_3 + 1.0 ),
+                real_c( 2.0 * xi_1 * xi_1 - 1.0 * xi_1 ),
+                real_c( 2.0 * xi_2 * xi_2 - 1.0 * xi_2 ),
+                real_c( 2.0 * xi_3 * xi_3 - 1.0 * xi_3 ),
+                real_c( -4.0 * xi_1 * xi_1 - 4.0 * xi_1 * xi_2 - 4.0 * xi_1 * xi_3 + 4.0 * xi_1 ),
+                real_c( -4.0 * xi_1 * xi_2 - 4.0 * xi_2 * xi_2 - 4.0 * xi_2 * xi_3 + 4.0 * xi_2 ),
+                real_c( 4.0 * xi_1 * xi_2 ),
+                real_c( -4.0 * xi_1 * xi_3 - 4.0 * xi_2 * xi_3 - 4.0 * xi_3 * xi_3 + 4.0 * xi_3 ),
+                real_c( 4.0 * xi_1 * xi_3 ),
+                real_c( 4.0 * xi_2 * xi_3 ) };
+
+            for ( uint_t i = 0; i < numFunctions; i++ )
+            {
+               real_t value = real_c( 0 );
+               for ( uint_t k = 0; k < 10; k++ )
+               {
+                  value += dofs[10 * i + k] * phi[k];
+               }
+               results[p * numFunctions + i] = value;
+            }
+         }
+      }
+      else
+      {
+         WALBERLA_ABORT( "Not implemented for this discretization." )
+      }
+   }
+}
+
 template < typename FunctionType >
 inline uint_t initializeParticles( walberla::convection_particles::data::ParticleStorage& particleStorage,
                                    PrimitiveStorage&                                      storage,
@@ -915,7 +1215,6 @@ inline void particleIntegration( walberla::convection_particles::data::ParticleS
    for ( uint_t step = 0; step < steps; step++ )
    {
       // WALBERLA_LOG_INFO_ON_ROOT( "Starting inner time step " << step << " ..." )
-      // TODO: sort particle storage by governing macro (optimization, tbd)
 
       // RK stage 0
       // skip setting to start pos (already happened)
@@ -924,33 +1223,44 @@ inline void particleIntegration( walberla::convection_particles::data::ParticleS
 
       storage.getTimingTree()->start( "Evaluate at particle position" );
 
-      std::vector< real_t >       results( { 0, 0 } );
-      std::vector< real_t >       resultsLastTimeStep( { 0, 0 } );
-      std::vector< FunctionType > functions             = { ux, uy };
-      std::vector< FunctionType > functionsLastTimeStep = { uxLastTimeStep, uyLastTimeStep };
+      const uint_t dim = storage.hasGlobalCells() ? 3 : 2;
+
+      std::vector< real_t >       results;
+      std::vector< FunctionType > functions = { ux, uy };
       if ( storage.hasGlobalCells() )
       {
-         results.push_back( 0 );
-         resultsLastTimeStep.push_back( 0 );
          functions.push_back( uz );
-         functionsLastTimeStep.push_back( uzLastTimeStep );
       }
 
-      for ( auto p : particleStorage )
+      // the velocities of both time steps are evaluated together, so that the particles are located only once per stage
+      std::vector< FunctionType > functionsBothTimeSteps = functions;
+      functionsBothTimeSteps.push_back( uxLastTimeStep );
+      functionsBothTimeSteps.push_back( uyLastTimeStep );
+      if ( storage.hasGlobalCells() )
       {
-         evaluateAtParticlePosition( storage,
-                                     functions,
-                                     p,
-                                     level,
-                                     results,
-                                     setParticlesOutsideDomainToZero,
-                                     cautionedEvaluate,
-                                     handleOutsideDomainMethod,
-                                     projectPointsBackOutsideDomain );
-         p->getKRef()[0][0] = -results[0];
-         p->getKRef()[0][1] = -results[1];
-         if ( storage.hasGlobalCells() )
-            p->getKRef()[0][2] = -results[2];
+         functionsBothTimeSteps.push_back( uzLastTimeStep );
+      }
+
+      evaluateAtParticlePositions( storage,
+                                   functions,
+                                   particleStorage,
+                                   level,
+                                   results,
+                                   setParticlesOutsideDomainToZero,
+                                   cautionedEvaluate,
+                                   handleOutsideDomainMethod,
+                                   projectPointsBackOutsideDomain );
+
+#ifdef HYTEG_BUILD_WITH_OPENMP
+#pragma omp parallel for default( shared )
+#endif
+      for ( int i = 0; i < int_c( particleStorage.size() ); i++ )
+      {
+         auto p = particleStorage[uint_c( i )];
+         for ( uint_t d = 0; d < dim; d++ )
+         {
+            p->getKRef()[0][d] = -results[uint_c( i ) * dim + d];
+         }
       }
       storage.getTimingTree()->stop( "Evaluate at particle position" );
 
@@ -959,8 +1269,12 @@ inline void particleIntegration( walberla::convection_particles::data::ParticleS
       {
          // determine function evaluation points for this stage
          storage.getTimingTree()->start( "Update particle position" );
-         for ( auto p : particleStorage )
+#ifdef HYTEG_BUILD_WITH_OPENMP
+#pragma omp parallel for default( shared )
+#endif
+         for ( int i = 0; i < int_c( particleStorage.size() ); i++ )
          {
+            auto p               = particleStorage[uint_c( i )];
             auto evaluationPoint = p.getStartPosition();
             for ( uint_t j = 0; j < stage; j++ )
             {
@@ -980,30 +1294,28 @@ inline void particleIntegration( walberla::convection_particles::data::ParticleS
          // we perform a linear interpolation here using the c-weights of the RK method
          // and the "current" and "last" velocity functions
          storage.getTimingTree()->start( "Evaluate at particle position" );
-         for ( auto p : particleStorage )
+         evaluateAtParticlePositions( storage,
+                                      functionsBothTimeSteps,
+                                      particleStorage,
+                                      level,
+                                      results,
+                                      setParticlesOutsideDomainToZero,
+                                      cautionedEvaluate,
+                                      handleOutsideDomainMethod,
+                                      projectPointsBackOutsideDomain );
+
+#ifdef HYTEG_BUILD_WITH_OPENMP
+#pragma omp parallel for default( shared )
+#endif
+         for ( int i = 0; i < int_c( particleStorage.size() ); i++ )
          {
-            evaluateAtParticlePosition( storage,
-                                        functions,
-                                        p,
-                                        level,
-                                        results,
-                                        setParticlesOutsideDomainToZero,
-                                        cautionedEvaluate,
-                                        handleOutsideDomainMethod,
-                                        projectPointsBackOutsideDomain );
-            evaluateAtParticlePosition( storage,
-                                        functionsLastTimeStep,
-                                        p,
-                                        level,
-                                        resultsLastTimeStep,
-                                        setParticlesOutsideDomainToZero,
-                                        cautionedEvaluate,
-                                        handleOutsideDomainMethod,
-                                        projectPointsBackOutsideDomain );
-            p->getKRef()[stage][0] = -( ( 1.0 - c[stage] ) * results[0] + c[stage] * resultsLastTimeStep[0] );
-            p->getKRef()[stage][1] = -( ( 1.0 - c[stage] ) * results[1] + c[stage] * resultsLastTimeStep[1] );
-            if ( storage.hasGlobalCells() )
-               p->getKRef()[stage][2] = -( ( 1.0 - c[stage] ) * results[2] + c[stage] * resultsLastTimeStep[2] );
+            auto p = particleStorage[uint_c( i )];
+            for ( uint_t d = 0; d < dim; d++ )
+            {
+               const real_t result             = results[uint_c( i ) * 2 * dim + d];
+               const real_t resultLastTimeStep = results[uint_c( i ) * 2 * dim + dim + d];
+               p->getKRef()[stage][d]          = -( ( 1.0 - c[stage] ) * result + c[stage] * resultLastTimeStep );
+            }
          }
          storage.getTimingTree()->stop( "Evaluate at particle position" );
       }
@@ -1011,12 +1323,16 @@ inline void particleIntegration( walberla::convection_particles::data::ParticleS
       // all k[i] are now calculated, set final integration result for each particle and
       // assign the position accordingly
       storage.getTimingTree()->start( "Update particle position" );
-      for ( auto p : particleStorage )
+#ifdef HYTEG_BUILD_WITH_OPENMP
+#pragma omp parallel for default( shared )
+#endif
+      for ( int i = 0; i < int_c( particleStorage.size() ); i++ )
       {
+         auto p             = particleStorage[uint_c( i )];
          auto finalPosition = p->getStartPosition();
-         for ( uint_t i = 0; i < rkStages; i++ )
+         for ( uint_t j = 0; j < rkStages; j++ )
          {
-            finalPosition += dt * b[i] * p->getKRef()[i];
+            finalPosition += dt * b[j] * p->getKRef()[j];
          }
          p->setPosition( finalPosition );
          p->setStartPosition( p->getPosition() );
@@ -1058,22 +1374,29 @@ inline void evaluateTemperature( walberla::convection_particles::data::ParticleS
    }
 
    // evaluate temperature at final position
-   for ( auto p : particleStorage )
+   std::vector< real_t > finalTemperatures;
+   evaluateAtParticlePositions( storage,
+                                std::vector< FunctionType >( { cOld } ),
+                                particleStorage,
+                                level,
+                                finalTemperatures,
+                                setParticlesOutsideDomainToZero,
+                                cautionedEvaluate,
+                                handleOutsideDomainMethod,
+                                projectPointsBackOutsideDomain );
+
+#ifdef HYTEG_BUILD_WITH_OPENMP
+#pragma omp parallel for default( shared )
+#endif
+   for ( int i = 0; i < int_c( particleStorage.size() ); i++ )
    {
-      auto finalTemperature = evaluateAtParticlePosition( storage,
-                                                          cOld,
-                                                          p,
-                                                          level,
-                                                          setParticlesOutsideDomainToZero,
-                                                          cautionedEvaluate,
-                                                          handleOutsideDomainMethod,
-                                                          projectPointsBackOutsideDomain );
+      auto finalTemperature = finalTemperatures[uint_c( i )];
       if ( globalMaxLimiter )
       {
          finalTemperature = std::max( finalTemperature, minTempCOld );
          finalTemperature = std::min( finalTemperature, maxTempCOld );
       }
-      p->setFinalTemperature( finalTemperature );
+      particleStorage[uint_c( i )]->setFinalTemperature( finalTemperature );
    }
 
    // Communicate temperatures in two steps:
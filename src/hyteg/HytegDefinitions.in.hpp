@@ -30,6 +30,7 @@
 #cmakedefine HYTEG_MANTLECONVECTION_APP
 #cmakedefine HYTEG_DONT_BUILD_DURING_CI
 #cmakedefine HYTEG_BUILD_WITH_PYTHON3
+#cmakedefine HYTEG_BUILD_WITH_ZLIB
 #cmakedefine HYTEG_USE_SIGNED_INT_FOR_ADIOS2
 
 namespace hyteg {
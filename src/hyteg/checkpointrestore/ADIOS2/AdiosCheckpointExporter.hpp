@@ -48,6 +48,14 @@ using walberla::uint_t;
 /// - P1Function and P1VectorFunction
 /// - P2Function and P2VectorFunction
 /// - P2P1TaylorHoodFunction
+///
+/// By default a checkpoint is written synchronously, i.e. storeCheckpoint() returns after the data has been
+/// written to the file system. After setAsynchronousWrite( true ) the function data is only copied into the
+/// buffers of the ADIOS2 engine and the actual file I/O is performed by a background thread of the engine
+/// (BP5 parameter AsyncWrite). The functions may be modified directly after the call, while the I/O of the
+/// checkpoint overlaps with the following time steps. The file of a checkpoint is only complete after
+/// waitForPendingWrites() has been called, which happens automatically before the next checkpoint file is opened
+/// and in the destructor.
 class AdiosCheckpointExporter_v03 : public CheckpointExporter< AdiosCheckpointExporter_v03 >
 {
  public:
@@ -86,6 +94,28 @@ class AdiosCheckpointExporter_v03 : public CheckpointExporter< AdiosCheckpointEx
 
 #endif
 
+   ~AdiosCheckpointExporter_v03() { waitForPendingWrites(); }
+
+   /// Switch between synchronous (default) and asynchronous writing of checkpoints
+   ///
+   /// \note The setting is applied when a checkpoint file is opened, i.e. for continuous checkpoints it must
+   ///       be set before the first call to storeCheckpointContinuous().
+   void setAsynchronousWrite( bool asynchronousWrite ) { asynchronousWrite_ = asynchronousWrite; }
+
+   bool getAsynchronousWrite() const { return asynchronousWrite_; }
+
+   /// Block until all checkpoint data that is still being written in the background has reached the file system
+   ///
+   /// Only has an effect in asynchronous mode. Afterwards the last checkpoint file can safely be read.
+   inline void waitForPendingWrites()
+   {
+      if ( closeIsPending_ )
+      {
+         engine_.Close();
+         closeIsPending_ = false;
+      }
+   }
+
    /// Register an FE Function to be included into checkpoints
    ///
    /// By calling this method the passed function object we be included into all future checkpoints.
@@ -271,6 +301,12 @@ class AdiosCheckpointExporter_v03 : public CheckpointExporter< AdiosCheckpointEx
    /// remember if we already had a storeCheckpointContinuous() episode
    bool firstWriteDidHappen_ = false;
 
+   /// whether file I/O is performed in the background, see setAsynchronousWrite()
+   bool asynchronousWrite_ = false;
+
+   /// in asynchronous mode the engine of the last finished checkpoint still needs to be closed
+   bool closeIsPending_ = false;
+
    /// auxilliary variable to add management information to checkpoint
    ///@{
    std::vector< std::string > allFunctionNames_;
@@ -311,6 +347,9 @@ class AdiosCheckpointExporter_v03 : public CheckpointExporter< AdiosCheckpointEx
 
       if ( !firstWriteDidHappen )
       {
+         // the engine of a previous asynchronous checkpoint is still draining
+         waitForPendingWrites();
+
          ptrToIO = std::make_shared< adios2::IO >( adios_.DeclareIO( engineName ) );
          if ( runContinuous )
          {
@@ -318,6 +357,10 @@ class AdiosCheckpointExporter_v03 : public CheckpointExporter< AdiosCheckpointEx
          }
 
          ptrToIO->SetEngine( engineType_ );
+         if ( asynchronousWrite_ )
+         {
+            ptrToIO->SetParameter( "AsyncWrite", "true" );
+         }
          engine_ = ptrToIO->Open( cpFileName, adios2::Mode::Write );
 
          // export meta-data
@@ -396,12 +439,26 @@ class AdiosCheckpointExporter_v03 : public CheckpointExporter< AdiosCheckpointEx
          ptrToIO->DefineAttribute< uint_t >( "FunctionMaxLevels", allMaxLevels.data(), allMaxLevels.size() );
       }
 
+      // The function data was scheduled with deferred Puts, i.e. the engine still references the function memory.
+      // In asynchronous mode we take the snapshot now, so that the functions may change while the file I/O runs.
+      if ( asynchronousWrite_ )
+      {
+         engine_.PerformPuts();
+      }
+
       // actual export performed here (if lazy not overwritten in config file)
       engine_.EndStep();
 
       if ( finalCall )
       {
-         engine_.Close();
+         if ( asynchronousWrite_ )
+         {
+            closeIsPending_ = true;
+         }
+         else
+         {
+            engine_.Close();
+         }
 
          // clean-up for next checkpoint
          allFunctionNames_.clear();
@@ -560,9 +617,9 @@ class AdiosCheckpointExporter_v03 : public CheckpointExporter< AdiosCheckpointEx
             walberla::mpi::SendBuffer buffer;
             buffer << rowIndicesInGlobalAdiosArrayForFaces_;
 
-            // schedule map data for export
+            // schedule map data for export (synchronously, as the buffer goes out of scope)
             std::ptrdiff_t offset = buffer.size() - storage->getNumberOfLocalFaces() * mapEntrySizeInBytes;
-            engine.Put( varMapData, buffer.ptr() + offset );
+            engine.Put( varMapData, buffer.ptr() + offset, adios2::Mode::Sync );
          }
       }
 
@@ -593,9 +650,9 @@ class AdiosCheckpointExporter_v03 : public CheckpointExporter< AdiosCheckpointEx
                                               {},
                                               { storage->getNumberOfLocalCells(), mapEntrySizeInBytes } );
 
-            // schedule map data for export
+            // schedule map data for export (synchronously, as the buffer goes out of scope)
             std::ptrdiff_t offset = buffer.size() - storage->getNumberOfLocalCells() * mapEntrySizeInBytes;
-            engine.Put( varMapData, buffer.ptr() + offset );
+            engine.Put( varMapData, buffer.ptr() + offset, adios2::Mode::Sync );
          }
       }
    }
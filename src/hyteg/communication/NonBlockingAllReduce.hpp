@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2026 Nils Kohl, Marcus Mohr.
+ *
+ * This file is part of HyTeG
+ * (see https://i10git.cs.fau.de/hyteg/hyteg).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <vector>
+
+#include "core/Abort.h"
+#include "core/DataTypes.h"
+#include "core/mpi/MPIManager.h"
+#include "core/mpi/MPIWrapper.h"
+
+#include "hyteg/HytegDefinitions.hpp"
+
+namespace hyteg {
+namespace communication {
+
+using walberla::int_c;
+using walberla::uint_t;
+
+/// \brief Global sum of a small, fixed number of scalars that is performed in the background.
+///
+/// Collects several local values (e.g. the local parts of multiple dot products), sums them over all processes with a
+/// single MPI_Iallreduce() and allows computations (typically an operator application) to be performed until the
+/// result is actually needed. Without MPI the local values are the result.
+///
+/// \code
+///   NonBlockingAllReduce< real_t > reduction( 2 );
+///   reduction[0] = r.dotLocal( r, level, flag );
+///   reduction[1] = r.dotLocal( z, level, flag );
+///   reduction.start();
+///   A.apply( ... );       // overlaps with the reduction
+///   reduction.wait();
+///   const real_t rr = reduction[0];
+/// \endcode
+///
+/// Only one reduction may be in flight per object at a time. The values must not be accessed between start() and wait().
+template < typename ValueType >
+class NonBlockingAllReduce
+{
+ public:
+   explicit NonBlockingAllReduce( uint_t numValues )
+   : values_( numValues, ValueType( 0 ) )
+   , inFlight_( false )
+#ifdef HYTEG_BUILD_WITH_MPI
+   , request_( MPI_REQUEST_NULL )
+#endif
+   {}
+
+   NonBlockingAllReduce( const NonBlockingAllReduce& )            = delete;
+   NonBlockingAllReduce& operator=( const NonBlockingAllReduce& ) = delete;
+
+   ~NonBlockingAllReduce()
+   {
+      if ( inFlight_ )
+      {
+         wait();
+      }
+   }
+
+   ValueType& operator[]( uint_t idx )
+   {
+      WALBERLA_ASSERT( !inFlight_, "Reduction values must not be accessed while the reduction is in flight." );
+      return values_[idx];
+   }
+
+   const ValueType& operator[]( uint_t idx ) const
+   {
+      WALBERLA_ASSERT( !inFlight_, "Reduction values must not be accessed while the reduction is in flight." );
+      return values_[idx];
+   }
+
+   uint_t size() const { return values_.size(); }
+
+   /// Starts the global summation of the currently stored values.
+   void start()
+   {
+      WALBERLA_CHECK( !inFlight_, "Cannot start a reduction that is already in flight." );
+      inFlight_ = true;
+#ifdef HYTEG_BUILD_WITH_MPI
+      if ( walberla::mpi::MPIManager::instance()->numProcesses() > 1 )
+      {
+         MPI_Iallreduce( MPI_IN_PLACE,
+                         values_.data(),
+                         int_c( values_.size() ),
+                         walberla::MPITrait< ValueType >::type(),
+                         MPI_SUM,
+                         walberla::mpi::MPIManager::instance()->comm(),
+                         &request_ );
+      }
+#endif
+   }
+
+   /// Blocks until the reduction has been completed. Afterwards the values hold the global sums.
+   void wait()
+   {
+      WALBERLA_CHECK( inFlight_, "Cannot wait for a reduction that has not been started." );
+#ifdef HYTEG_BUILD_WITH_MPI
+      if ( request_ != MPI_REQUEST_NULL )
+      {
+         MPI_Wait( &request_, MPI_STATUS_IGNORE );
+      }
+#endif
+      inFlight_ = false;
+   }
+
+ private:
+   std::vector< ValueType > values_;
+   bool                     inFlight_;
+#ifdef HYTEG_BUILD_WITH_MPI
+   MPI_Request request_;
+#endif
+};
+
+} // namespace communication
+} // namespace hyteg
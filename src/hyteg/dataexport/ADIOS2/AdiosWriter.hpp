@@ -228,6 +228,16 @@ class AdiosWriter : public FEFunctionWriter< AdiosWriter >
       }
    }
 
+   /// Let the engine perform the file I/O in a background thread
+   ///
+   /// The DoF data is always copied into buffers provided by the ADIOS2 engine when write() is called. In
+   /// asynchronous mode write() returns as soon as this copy is done and the buffers are drained to the file
+   /// system by the engine (BP5 parameter AsyncWrite), overlapping with the following time steps. The next
+   /// write() or the destructor waits for outstanding I/O.
+   ///
+   /// \note Same as setParameter() this only works before the first invocation of write().
+   void setAsynchronousWrite( bool asynchronousWrite ) { setParameter( "AsyncWrite", asynchronousWrite ? "true" : "false" ); }
+
    void write( const uint_t level, const uint_t timestep = 0 );
 
    /// Class that wraps an Adios span such that we can insert data with operator<<
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2026 Nils Kohl, Marcus Mohr.
+ *
+ * This file is part of HyTeG
+ * (see https://i10git.cs.fau.de/hyteg/hyteg).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "hyteg/dataexport/VTKOutput/VTKAppendedDataStream.hpp"
+
+#include <algorithm>
+
+#include "core/Abort.h"
+
+#include "hyteg/HytegDefinitions.hpp"
+
+#ifdef HYTEG_BUILD_WITH_ZLIB
+#include <zlib.h>
+#endif
+
+namespace hyteg {
+namespace vtk {
+
+/// uncompressed size of the blocks the arrays are split into for compression
+static constexpr uint64_t compressionBlockSize = uint64_t( 1 ) << 20;
+
+template < typename T >
+static void appendBytes( std::vector< char >& buffer, const T& value )
+{
+   const char* bytes = reinterpret_cast< const char* >( &value );
+   buffer.insert( buffer.end(), bytes, bytes + sizeof( T ) );
+}
+
+AppendedDataStream::AppendedDataStream( bool compress )
+: compress_( compress )
+{
+#ifndef HYTEG_BUILD_WITH_ZLIB
+   if ( compress_ )
+   {
+      WALBERLA_ABORT( "Compression of VTK output requires HyTeG to be built with zlib (HYTEG_BUILD_WITH_ZLIB)." );
+   }
+#endif
+}
+
+void AppendedDataStream::registerDataArray( const std::string& type, const std::string& name, uint_t numberOfComponents )
+{
+   // find the innermost section that has been opened so far
+   const std::string xml     = str();
+   std::string       section = "";
+   size_t            maxPos  = 0;
+   for ( const std::string& candidate : { "Points", "Cells", "PointData", "CellData" } )
+   {
+      const size_t pos = xml.rfind( "<" + candidate + ">" );
+      if ( pos != std::string::npos && pos >= maxPos )
+      {
+         section = candidate;
+         maxPos  = pos;
+      }
+   }
+   dataArrays_.push_back( { section, type, name, numberOfComponents } );
+}
+
+void AppendedDataStream::appendDataArray( const char* data, uint64_t numBytes )
+{
+   if ( !compress_ )
+   {
+      appendBytes( appendedData_, numBytes );
+      appendedData_.insert( appendedData_.end(), data, data + numBytes );
+      return;
+   }
+
+#ifdef HYTEG_BUILD_WITH_ZLIB
+   // header: [#blocks][uncompressed block size][uncompressed size of last block][compressed size of each block]
+   const uint64_t numBlocks     = ( numBytes + compressionBlockSize - 1 ) / compressionBlockSize;
+   const uint64_t lastBlockSize = numBytes % compressionBlockSize;
+
+   std::vector< uint64_t >            compressedSizes( numBlocks );
+   std::vector< std::vector< char > > compressedBlocks( numBlocks );
+   for ( uint64_t block = 0; block < numBlocks; ++block )
+   {
+      const uint64_t blockSize = std::min( compressionBlockSize, numBytes - block * compressionBlockSize );
+      uLongf         destSize  = compressBound( static_cast< uLong >( blockSize ) );
+      compressedBlocks[block].resize( destSize );
+      const int status = compress( reinterpret_cast< Bytef* >( compressedBlocks[block].data() ),
+                                   &destSize,
+                                   reinterpret_cast< const Bytef* >( data + block * compressionBlockSize ),
+                                   static_cast< uLong >( blockSize ) );
+      WALBERLA_CHECK_EQUAL( status, Z_OK, "zlib compression of VTK data array failed." );
+      compressedSizes[block] = destSize;
+   }
+
+   appendBytes( appendedData_, numBlocks );
+   appendBytes( appendedData_, compressionBlockSize );
+   appendBytes( appendedData_, lastBlockSize );
+   for ( uint64_t block = 0; block < numBlocks; ++block )
+   {
+      appendBytes( appendedData_, compressedSizes[block] );
+   }
+   for ( uint64_t block = 0; block < numBlocks; ++block )
+   {
+      appendedData_.insert(
+          appendedData_.end(), compressedBlocks[block].begin(), compressedBlocks[block].begin() + compressedSizes[block] );
+   }
+#endif
+}
+
+void AppendedDataStream::writeAppendedData( std::ostream& os ) const
+{
+   os << R"(<AppendedData encoding="raw">)"
+         "\n_";
+   os.write( appendedData_.data(), static_cast< std::streamsize >( appendedData_.size() ) );
+   os << "\n</AppendedData>\n";
+}
+
+} // namespace vtk
+} // namespace hyteg
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2026 Nils Kohl, Marcus Mohr.
+ *
+ * This file is part of HyTeG
+ * (see https://i10git.cs.fau.de/hyteg/hyteg).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "core/DataTypes.h"
+
+namespace hyteg {
+
+using walberla::uint_t;
+
+namespace vtk {
+
+/// Output stream for a VTU file whose data arrays are stored in the AppendedData section.
+///
+/// The XML part of the file is written to the stream as usual. The data of the arrays is not encoded, but
+/// collected in a separate binary buffer which is written as raw data (encoding="raw") behind the XML part,
+/// see writeAppendedData(). Each array is prefixed with a UInt64 header, so the VTKFile element must carry
+/// the attribute header_type="UInt64". Optionally the arrays are compressed with zlib (requires
+/// HYTEG_BUILD_WITH_ZLIB), then the VTKFile element also needs compressor="vtkZLibDataCompressor".
+///
+/// openDataElement() and VTKStreamWriter detect this stream type if the format is DataFormat::RAW.
+class AppendedDataStream : public std::ostringstream
+{
+ public:
+   /// Description of a data array, needed to generate the PVTU index file
+   struct DataArrayInfo
+   {
+      /// XML element the array belongs to, i.e. Points, Cells, PointData, or CellData
+      std::string section;
+      std::string type;
+      std::string name;
+      uint_t      numberOfComponents;
+   };
+
+   explicit AppendedDataStream( bool compress = false );
+
+   bool isCompressed() const { return compress_; }
+
+   /// offset of the next array inside the AppendedData section
+   uint64_t currentOffset() const { return appendedData_.size(); }
+
+   /// Remember the description of the array that is opened next
+   void registerDataArray( const std::string& type, const std::string& name, uint_t numberOfComponents );
+
+   /// Append the (uncompressed) data of the current array together with its header
+   void appendDataArray( const char* data, uint64_t numBytes );
+
+   const std::vector< DataArrayInfo >& getDataArrays() const { return dataArrays_; }
+
+   /// Writes the complete AppendedData element
+   void writeAppendedData( std::ostream& os ) const;
+
+ private:
+   bool                         compress_;
+   std::vector< char >          appendedData_;
+   std::vector< DataArrayInfo > dataArrays_;
+};
+
+} // namespace vtk
+} // namespace hyteg
@@ -21,6 +21,8 @@
 
 #include "core/logging/Logging.h"
 
+#include "hyteg/dataexport/VTKOutput/VTKAppendedDataStream.hpp"
+
 namespace hyteg {
 
 using walberla::uint_t;
@@ -30,7 +32,9 @@ namespace vtk {
 enum class DataFormat
 {
    ASCII,
-   BINARY
+   BINARY,
+   /// raw binary data in the AppendedData section, requires an AppendedDataStream as output
+   RAW
 };
 
 enum class DoFType
@@ -87,6 +91,22 @@ inline void writeXMLFooter( std::ostream& output )
    }
 }
 
+/// Header of a VTU file with appended raw data, written by each process for its own piece
+inline void writeXMLHeaderForAppendedData( AppendedDataStream& output )
+{
+   output << R"(<?xml version="1.0"?>)"
+             "\n";
+   output << R"(<VTKFile type="UnstructuredGrid" version="1.0" byte_order=")" << getByteOrder() << R"(" header_type="UInt64")";
+   if ( output.isCompressed() )
+   {
+      output << R"( compressor="vtkZLibDataCompressor")";
+   }
+   output << R"(>)"
+             "\n";
+   output << R"(<UnstructuredGrid>)"
+             "\n";
+}
+
 inline void writePieceHeader( std::ostream& output, const uint_t& numberOfPoints, const uint_t& numberOfCells )
 {
    output << "<Piece "
@@ -129,6 +149,15 @@ inline void
       output << R"( format="binary">)"
                 "\n";
    }
+   else if ( fmt == DataFormat::RAW )
+   {
+      auto appendedDataStream = dynamic_cast< AppendedDataStream* >( &output );
+      WALBERLA_CHECK_NOT_NULLPTR( appendedDataStream, "VTK data format RAW requires an AppendedDataStream as output." );
+      appendedDataStream->registerDataArray( type, name, nComponents );
+      output << R"( format="appended" offset=")" << appendedDataStream->currentOffset()
+             << R"(">)"
+                "\n";
+   }
    else
    {
       WALBERLA_ABORT( "Specified VTK format not supported." );
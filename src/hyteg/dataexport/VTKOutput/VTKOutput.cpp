@@ -19,6 +19,8 @@
  */
 #include "hyteg/dataexport/VTKOutput/VTKOutput.hpp"
 
+#include <fstream>
+
 #include "hyteg/Format.hpp"
 #include "hyteg/Levelinfo.hpp"
 #include "hyteg/communication/Syncing.hpp"
@@ -51,6 +53,7 @@ VTKOutput::VTKOutput( std::string                                dir,
 , write2D_( true )
 , storage_( storage )
 , vtkDataFormat_( vtk::DataFormat::ASCII )
+, vtkCompression_( false )
 {
    // set output to 3D if storage contains cells
    if ( storage->hasGlobalCells() )
@@ -121,6 +124,81 @@ void VTKOutput::writeDoFByType( std::ostream& output, const uint_t& level, const
    }
 }
 
+void VTKOutput::writePiecesAndIndexFile( const std::string& fileBaseName, const uint_t& level, const vtk::DoFType& dofType ) const
+{
+   const uint_t rank = uint_c( walberla::mpi::MPIManager::instance()->rank() );
+
+   // every process writes its own piece, no communication involved
+   vtk::AppendedDataStream output( vtkCompression_ );
+   vtk::writeXMLHeaderForAppendedData( output );
+   writeDoFByType( output, level, dofType );
+   output << "</UnstructuredGrid>\n";
+
+   const std::string pieceFileName = walberla::format( "%s_rank%u.vtu", fileBaseName.c_str(), rank );
+   {
+      std::ofstream pieceFile( walberla::format( "%s/%s", dir_.c_str(), pieceFileName.c_str() ),
+                               std::ofstream::out | std::ofstream::binary );
+      WALBERLA_CHECK( !!pieceFile, "[VTKWriter] Error opening file: " << dir_ << "/" << pieceFileName );
+      pieceFile << output.str();
+      output.writeAppendedData( pieceFile );
+      pieceFile << "</VTKFile>\n";
+   }
+
+   // the index file only needs the names of the pieces and the layout of the data arrays, which is the same on all processes
+   WALBERLA_ROOT_SECTION()
+   {
+      const std::string indexFilePath = walberla::format( "%s/%s.pvtu", dir_.c_str(), fileBaseName.c_str() );
+      std::ofstream     indexFile( indexFilePath );
+      WALBERLA_CHECK( !!indexFile, "[VTKWriter] Error opening file: " << indexFilePath );
+
+      indexFile << R"(<?xml version="1.0"?>)"
+                   "\n";
+      indexFile << R"(<VTKFile type="PUnstructuredGrid" version="1.0" byte_order=")" << vtk::getByteOrder()
+                << R"(" header_type="UInt64">)"
+                   "\n";
+      indexFile << R"(<PUnstructuredGrid GhostLevel="0">)"
+                   "\n";
+
+      const std::vector< std::pair< std::string, std::string > > sections = {
+          { "Points", "PPoints" }, { "PointData", "PPointData" }, { "CellData", "PCellData" } };
+      for ( const auto& [section, pSection] : sections )
+      {
+         std::ostringstream dataArrays;
+         for ( const auto& dataArray : output.getDataArrays() )
+         {
+            if ( dataArray.section != section )
+            {
+               continue;
+            }
+            dataArrays << R"(<PDataArray type=")" << dataArray.type << R"(")";
+            if ( dataArray.name.length() > 0 )
+            {
+               dataArrays << R"( Name=")" << dataArray.name << R"(")";
+            }
+            if ( dataArray.numberOfComponents > 0 )
+            {
+               dataArrays << R"( NumberOfComponents=")" << dataArray.numberOfComponents << R"(")";
+            }
+            dataArrays << "/>\n";
+         }
+         if ( !dataArrays.str().empty() )
+         {
+            indexFile << "<" << pSection << ">\n" << dataArrays.str() << "</" << pSection << ">\n";
+         }
+      }
+
+      const uint_t numProcesses = uint_c( walberla::mpi::MPIManager::instance()->numProcesses() );
+      for ( uint_t piece = 0; piece < numProcesses; ++piece )
+      {
+         indexFile << R"(<Piece Source=")" << walberla::format( "%s_rank%u.vtu", fileBaseName.c_str(), piece ) << R"("/>)"
+                   << "\n";
+      }
+
+      indexFile << "</PUnstructuredGrid>\n";
+      indexFile << "</VTKFile>\n";
+   }
+}
+
 uint_t VTKOutput::getNumRegisteredFunctions( const vtk::DoFType& dofType ) const
 {
    switch ( dofType )
@@ -193,8 +271,14 @@ void VTKOutput::write( const uint_t level, const uint_t timestep )
 
       for ( const auto& dofType : dofTypes )
       {
-         if ( getNumRegisteredFunctions( dofType ) > 0 )
+         if ( getNumRegisteredFunctions( dofType ) > 0 && vtkDataFormat_ == vtk::DataFormat::RAW )
+         {
+            writePiecesAndIndexFile( filename_ + fileNameExtension( dofType, level, timestep ), level, dofType );
+         }
+         else if ( getNumRegisteredFunctions( dofType ) > 0 )
          {
+            WALBERLA_CHECK( !vtkCompression_, "[VTKWriter] Compression is only supported for the RAW data format." );
+
             const std::string completeFilePath = walberla::format(
                 "%s/%s%s.vtu", dir_.c_str(), filename_.c_str(), fileNameExtension( dofType, level, timestep ).c_str() );
             //( fmt::format( "{}/{}{}.vtu", dir_, filename_, fileNameExtension( dofType, level, timestep ) ) );
@@ -119,31 +119,62 @@ class VTKOutput : public FEFunctionWriter< VTKOutput >
 
    /// Set parameter specified by string key to value specified by string value
    ///
-   /// The only key currently supported by VTKOutput is "vtkDataFormat" with the two possible values
-   /// - ASCII
-   /// - BINARY
+   /// The keys currently supported by VTKOutput are
+   /// - "vtkDataFormat" with the possible values ASCII, BINARY, and RAW (see setVTKDataFormat())
+   /// - "vtkCompression" with the possible values NONE and ZLIB (see setVTKCompression())
    void setParameter( const std::string& key, const std::string& value )
    {
-      if ( key != "vtkDataFormat" )
+      if ( key == "vtkDataFormat" )
       {
-         WALBERLA_ABORT( "VTKOutput::setParameter() does not support key = '" << key << "'!" );
-      }
-      else if ( value == "ASCII" )
-      {
-         setVTKDataFormat( vtk::DataFormat::ASCII );
+         if ( value == "ASCII" )
+         {
+            setVTKDataFormat( vtk::DataFormat::ASCII );
+         }
+         else if ( value == "BINARY" )
+         {
+            setVTKDataFormat( vtk::DataFormat::BINARY );
+         }
+         else if ( value == "RAW" )
+         {
+            setVTKDataFormat( vtk::DataFormat::RAW );
+         }
+         else
+         {
+            WALBERLA_ABORT( "VTKOutput::setParameter() key vtkDataFormat = '" << value << "' is not supported!" );
+         }
       }
-      else if ( value == "BINARY" )
+      else if ( key == "vtkCompression" )
       {
-         setVTKDataFormat( vtk::DataFormat::BINARY );
+         if ( value == "NONE" )
+         {
+            setVTKCompression( false );
+         }
+         else if ( value == "ZLIB" )
+         {
+            setVTKCompression( true );
+         }
+         else
+         {
+            WALBERLA_ABORT( "VTKOutput::setParameter() key vtkCompression = '" << value << "' is not supported!" );
+         }
       }
       else
       {
-         WALBERLA_ABORT( "VTKOutput::setParameter() key vtkDataFormat = '" << value << "' is not supported!" );
+         WALBERLA_ABORT( "VTKOutput::setParameter() does not support key = '" << key << "'!" );
       }
    };
 
+   /// Select the format of the data arrays
+   ///
+   /// With ASCII and BINARY (base64 encoded) all processes write their pieces into a single .vtu file per DoF type.
+   /// With RAW each process writes its own .vtu file with the data as raw binary in the AppendedData section and
+   /// the root process writes a .pvtu file that references all pieces. This avoids both the encoding and the
+   /// collective write and is the recommended format for large runs.
    void setVTKDataFormat( vtk::DataFormat vtkDataFormat ) { vtkDataFormat_ = vtkDataFormat; }
 
+   /// Compress the data arrays with zlib, only supported for vtk::DataFormat::RAW (requires HYTEG_BUILD_WITH_ZLIB)
+   void setVTKCompression( bool compress ) { vtkCompression_ = compress; }
+
  private:
    static const std::map< vtk::DoFType, std::string > DoFTypeToString_;
 
@@ -152,6 +183,9 @@ class VTKOutput : public FEFunctionWriter< VTKOutput >
 
    std::string fileNameExtension( const vtk::DoFType& dofType, const uint_t& level, const uint_t& timestep ) const;
 
+   /// Writes one .vtu file per process and the .pvtu index file (vtk::DataFormat::RAW)
+   void writePiecesAndIndexFile( const std::string& fileBaseName, const uint_t& level, const vtk::DoFType& dofType ) const;
+
    /// Writes only macro-faces.
    void set2D() { write2D_ = true; }
 
@@ -173,6 +207,8 @@ class VTKOutput : public FEFunctionWriter< VTKOutput >
 
    vtk::DataFormat vtkDataFormat_;
 
+   bool vtkCompression_;
+
    // all writers currently need to be our friends
    friend class VTKFaceDoFWriter;
    friend class VTKEdgeDoFWriter;
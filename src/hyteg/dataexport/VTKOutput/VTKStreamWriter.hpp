@@ -20,13 +20,15 @@
 
 #pragma once
 
+#include <vector>
+
 #include "hyteg/dataexport/VTKOutput/VTKHelpers.hpp"
 
 #include "vtk/Base64Writer.h"
 
 namespace hyteg {
 
-/// Wrapper class that handles writing data in ASCII or binary format.
+/// Wrapper class that handles writing data in ASCII, binary (base64 encoded), or raw binary (appended) format.
 ///
 /// \tparam DTypeInVTK data type that the input data is converted to before writing it to the VTK file
 template < typename DTypeInVTK >
@@ -53,6 +55,10 @@ class VTKStreamWriter
       {
          outputBase64_ << static_cast< DTypeInVTK >( data );
       }
+      else if ( vtkDataFormat_ == vtk::DataFormat::RAW )
+      {
+         outputRaw_.push_back( static_cast< DTypeInVTK >( data ) );
+      }
 
       return *this;
    }
@@ -72,12 +78,22 @@ class VTKStreamWriter
          // Base64Writer::toStream() already reset the object
          // so nothing left to do for us here
       }
+      else if ( vtkDataFormat_ == vtk::DataFormat::RAW )
+      {
+         // the data goes to the AppendedData section, not into the XML part of the file
+         auto appendedDataStream = dynamic_cast< vtk::AppendedDataStream* >( &os );
+         WALBERLA_CHECK_NOT_NULLPTR( appendedDataStream, "VTK data format RAW requires an AppendedDataStream as output." );
+         appendedDataStream->appendDataArray( reinterpret_cast< const char* >( outputRaw_.data() ),
+                                              outputRaw_.size() * sizeof( DTypeInVTK ) );
+         outputRaw_.clear();
+      }
    }
 
  private:
    vtk::DataFormat             vtkDataFormat_;
    std::ostringstream          outputAscii_;
    walberla::vtk::Base64Writer outputBase64_;
+   std::vector< DTypeInVTK >   outputRaw_;
 };
 
 } // namespace hyteg
@@ -19,6 +19,8 @@
  */
 #include "EdgeDoFFunction.hpp"
 
+#include <tuple>
+
 #include "core/OpenMP.h"
 #include "core/math/KahanSummation.h"
 
@@ -88,6 +90,11 @@ EdgeDoFFunction< ValueType >::EdgeDoFFunction( const std::string&
    storage->addFaceData( faceDataID_, faceDataHandling, name );
    storage->addCellData( cellDataID_, cellDataHandling, name );
 
+   if ( FunctionMemory< ValueType >::useArenaAllocation() )
+   {
+      allocateArenaMemory( minLevel, maxLevel );
+   }
+
    for ( uint_t level = minLevel; level <= maxLevel; ++level )
    {
       for ( const auto& it : storage->getVertices() )
@@ -262,6 +269,51 @@ void EdgeDoFFunction< ValueType >::allocateMemory( const uint_t& level, const Ce
    cell.getData( getCellDataID() )->addData( level, edgedof::edgeDoFMacroCellFunctionMemorySize( level, cell ), 0 );
 }
 
+template < typename ValueType >
+void EdgeDoFFunction< ValueType >::allocateArenaMemory( uint_t minLevel, uint_t maxLevel )
+{
+   using ChunkInfo = std::tuple< FunctionMemory< ValueType >*, uint_t, uint_t, uint_t >;
+
+   FunctionMemoryArena< ValueType > arena;
+   std::vector< ChunkInfo >         chunks;
+
+   auto reserve = [&]( FunctionMemory< ValueType >* memory, uint_t level, uint_t size ) {
+      chunks.emplace_back( memory, level, size, arena.reserve( size ) );
+   };
+
+   // Level-major ordering, so that the data of all primitives of one level is contiguous.
+   for ( uint_t level = minLevel; level <= maxLevel; ++level )
+   {
+      for ( const auto& it : this->getStorage()->getVertices() )
+      {
+         const Vertex& vertex = *it.second;
+         reserve( vertex.getData( getVertexDataID() ), level, edgedof::edgeDoFMacroVertexFunctionMemorySize( level, vertex ) );
+      }
+      for ( const auto& it : this->getStorage()->getEdges() )
+      {
+         const Edge& edge = *it.second;
+         reserve( edge.getData( getEdgeDataID() ), level, edgedof::edgeDoFMacroEdgeFunctionMemorySize( level, edge ) );
+      }
+      for ( const auto& it : this->getStorage()->getFaces() )
+      {
+         const Face& face = *it.second;
+         reserve( face.getData( getFaceDataID() ), level, edgedof::edgeDoFMacroFaceFunctionMemorySize( level, face ) );
+      }
+      for ( const auto& it : this->getStorage()->getCells() )
+      {
+         const Cell& cell = *it.second;
+         reserve( cell.getData( getCellDataID() ), level, edgedof::edgeDoFMacroCellFunctionMemorySize( level, cell ) );
+      }
+   }
+
+   arena.allocate( 0 );
+
+   for ( const auto& [memory, level, size, offset] : chunks )
+   {
+      memory->addArenaChunk( level, size, arena.getChunk( offset ) );
+   }
+}
+
 template < typename ValueType >
 void EdgeDoFFunction< ValueType >::deleteMemory( const uint_t& level, const Vertex& vertex )
 {
@@ -543,54 +595,6 @@ void EdgeDoFFunction< ValueType >::swap( const EdgeDoFFunction< ValueType >& oth
    this->stopTiming( "Swap" );
 }
 
-template < typename ValueType >
-void EdgeDoFFunction< ValueType >::copyFrom( const EdgeDoFFunction< ValueType >& other, const uint_t& level ) const
-{
-   this->startTiming( "Copy" );
-
-   for ( auto& it : this->getStorage()->getVertices() )
-   {
-      auto primitiveID = it.first;
-      WALBERLA_ASSERT( other.getStorage()->vertexExistsLocally( primitiveID ) )
-      this->getStorage()
-          ->getVertex( primitiveID )
-          ->getData( vertexDataID_ )
-          ->copyFrom( *other.getStorage()->getVertex( primitiveID )->getData( other.getVertexDataID() ), level );
-   }
-
-   for ( auto& it : this->getStorage()->getEdges() )
-   {
-      auto primitiveID = it.first;
-      WALBERLA_ASSERT( other.getStorage()->edgeExistsLocally( primitiveID ) )
-      this->getStorage()
-          ->getEdge( primitiveID )
-          ->getData( edgeDataID_ )
-          ->copyFrom( *other.getStorage()->getEdge( primitiveID )->getData( other.getEdgeDataID() ), level );
-   }
-
-   for ( auto& it : this->getStorage()->getFaces() )
-   {
-      auto primitiveID = it.first;
-      WALBERLA_ASSERT( other.getStorage()->faceExistsLocally( primitiveID ) )
-      this->getStorage()
-          ->getFace( primitiveID )
-          ->getData( faceDataID_ )
-          ->copyFrom( *other.getStorage()->getFace( primitiveID )->getData( other.getFaceDataID() ), level );
-   }
-
-   for ( auto& it : this->getStorage()->getCells() )
-   {
-      auto primitiveID = it.first;
-      WALBERLA_ASSERT( other.getStorage()->cellExistsLocally( primitiveID ) )
-      this->getStorage()
-          ->getCell( primitiveID )
-          ->getData( cellDataID_ )
-          ->copyFrom( *other.getStorage()->getCell( primitiveID )->getData( other.getCellDataID() ), level );
-   }
-
-   this->stopTiming( "Copy" );
-}
-
 template < typename ValueType >
 void EdgeDoFFunction< ValueType >::copyFrom( const EdgeDoFFunction< ValueType >&    other,
                                              const uint_t&                          level,
@@ -1280,6 +1284,181 @@ ValueType EdgeDoFFunction< ValueType >::dotGlobal( const EdgeDoFFunction< ValueT
    return scalarProduct;
 }
 
+template < typename ValueType >
+ValueType EdgeDoFFunction< ValueType >::addAndDotGlobal( ValueType                           scalar,
+                                                         const EdgeDoFFunction< ValueType >& src,
+                                                         const uint_t                        level,
+                                                         const DoFType                       flag ) const
+{
+   ValueType scalarProduct = addAndDotLocal( scalar, src, level, flag );
+   this->startTiming( "Dot (reduce)" );
+   walberla::mpi::allReduceInplace( scalarProduct, walberla::mpi::SUM, walberla::mpi::MPIManager::instance()->comm() );
+   this->stopTiming( "Dot (reduce)" );
+   return scalarProduct;
+}
+
+template < typename ValueType >
+ValueType EdgeDoFFunction< ValueType >::addAndDotLocal( ValueType                           scalar,
+                                                        const EdgeDoFFunction< ValueType >& src,
+                                                        const uint_t                        level,
+                                                        const DoFType                       flag ) const
+{
+   this->startTiming( "Add and dot (local)" );
+   auto scalarProduct = ValueType( 0 );
+
+   ValueType                  scalarProductEdges = 0;
+   std::vector< PrimitiveID > edgeIDs            = this->getStorage()->getEdgeIDs();
+#ifdef HYTEG_BUILD_WITH_OPENMP
+#pragma omp parallel for reduction( + : scalarProductEdges )
+#endif
+   for ( int i = 0; i < int_c( edgeIDs.size() ); i++ )
+   {
+      Edge& edge = *this->getStorage()->getEdge( edgeIDs[uint_c( i )] );
+
+      if ( testFlag( boundaryCondition_.getBoundaryType( edge.getMeshBoundaryFlag() ), flag ) )
+      {
+         scalarProductEdges += edgedof::macroedge::addAndDot< ValueType >( level, edge, scalar, src.edgeDataID_, edgeDataID_ );
+      }
+   }
+   scalarProduct += scalarProductEdges;
+
+   ValueType                  scalarProductFaces = 0;
+   std::vector< PrimitiveID > faceIDs            = this->getStorage()->getFaceIDs();
+#ifdef HYTEG_BUILD_WITH_OPENMP
+#pragma omp parallel for reduction( + : scalarProductFaces )
+#endif
+   for ( int i = 0; i < int_c( faceIDs.size() ); i++ )
+   {
+      Face& face = *this->getStorage()->getFace( faceIDs[uint_c( i )] );
+
+      if ( testFlag( boundaryCondition_.getBoundaryType( face.getMeshBoundaryFlag() ), flag ) )
+      {
+         scalarProductFaces += edgedof::macroface::addAndDot< ValueType >( level, face, scalar, src.faceDataID_, faceDataID_ );
+      }
+   }
+   scalarProduct += scalarProductFaces;
+
+   ValueType scalarProductCells = 0;
+   if ( level >= 1 )
+   {
+      std::vector< PrimitiveID > cellIDs = this->getStorage()->getCellIDs();
+#ifdef HYTEG_BUILD_WITH_OPENMP
+#pragma omp parallel for reduction( + : scalarProductCells )
+#endif
+      for ( int i = 0; i < int_c( cellIDs.size() ); i++ )
+      {
+         Cell& cell = *this->getStorage()->getCell( cellIDs[uint_c( i )] );
+
+         if ( testFlag( boundaryCondition_.getBoundaryType( cell.getMeshBoundaryFlag() ), flag ) )
+         {
+            scalarProductCells += edgedof::macrocell::addAndDot< ValueType >( level, cell, scalar, src.cellDataID_, cellDataID_ );
+         }
+      }
+   }
+   scalarProduct += scalarProductCells;
+
+   this->stopTiming( "Add and dot (local)" );
+
+   return scalarProduct;
+}
+
+template < typename ValueType >
+std::vector< ValueType >
+    EdgeDoFFunction< ValueType >::dotLocalBatch( const std::vector< std::reference_wrapper< const EdgeDoFFunction< ValueType > > >& rhs,
+                                                 const uint_t                                                                       level,
+                                                 const DoFType flag ) const
+{
+   this->startTiming( "Dot batch (local)" );
+   std::vector< ValueType > scalarProducts( rhs.size(), ValueType( 0 ) );
+
+   std::vector< PrimitiveDataID< FunctionMemory< ValueType >, Edge > > rhsEdgeIDs;
+   std::vector< PrimitiveDataID< FunctionMemory< ValueType >, Face > > rhsFaceIDs;
+   std::vector< PrimitiveDataID< FunctionMemory< ValueType >, Cell > > rhsCellIDs;
+   for ( const EdgeDoFFunction< ValueType >& function : rhs )
+   {
+      rhsEdgeIDs.push_back( function.edgeDataID_ );
+      rhsFaceIDs.push_back( function.faceDataID_ );
+      rhsCellIDs.push_back( function.cellDataID_ );
+   }
+
+   const std::vector< PrimitiveID > edgeIDs = this->getStorage()->getEdgeIDs();
+   const std::vector< PrimitiveID > faceIDs = this->getStorage()->getFaceIDs();
+   const std::vector< PrimitiveID > cellIDs = this->getStorage()->getCellIDs();
+
+   // each thread accumulates its own products, which are summed up at the end
+#ifdef HYTEG_BUILD_WITH_OPENMP
+#pragma omp parallel
+#endif
+   {
+      std::vector< ValueType > threadScalarProducts( rhs.size(), ValueType( 0 ) );
+
+#ifdef HYTEG_BUILD_WITH_OPENMP
+#pragma omp for
+#endif
+      for ( int i = 0; i < int_c( edgeIDs.size() ); i++ )
+      {
+         Edge& edge = *this->getStorage()->getEdge( edgeIDs[uint_c( i )] );
+         if ( testFlag( boundaryCondition_.getBoundaryType( edge.getMeshBoundaryFlag() ), flag ) )
+         {
+            edgedof::macroedge::dotBatch< ValueType >( level, edge, edgeDataID_, rhsEdgeIDs, threadScalarProducts );
+         }
+      }
+
+#ifdef HYTEG_BUILD_WITH_OPENMP
+#pragma omp for
+#endif
+      for ( int i = 0; i < int_c( faceIDs.size() ); i++ )
+      {
+         Face& face = *this->getStorage()->getFace( faceIDs[uint_c( i )] );
+         if ( testFlag( boundaryCondition_.getBoundaryType( face.getMeshBoundaryFlag() ), flag ) )
+         {
+            edgedof::macroface::dotBatch< ValueType >( level, face, faceDataID_, rhsFaceIDs, threadScalarProducts );
+         }
+      }
+
+      if ( level >= 1 )
+      {
+#ifdef HYTEG_BUILD_WITH_OPENMP
+#pragma omp for
+#endif
+         for ( int i = 0; i < int_c( cellIDs.size() ); i++ )
+         {
+            Cell& cell = *this->getStorage()->getCell( cellIDs[uint_c( i )] );
+            if ( testFlag( boundaryCondition_.getBoundaryType( cell.getMeshBoundaryFlag() ), flag ) )
+            {
+               edgedof::macrocell::dotBatch< ValueType >( level, cell, cellDataID_, rhsCellIDs, threadScalarProducts );
+            }
+         }
+      }
+
+#ifdef HYTEG_BUILD_WITH_OPENMP
+#pragma omp critical
+#endif
+      {
+         for ( uint_t k = 0; k < scalarProducts.size(); k++ )
+         {
+            scalarProducts[k] += threadScalarProducts[k];
+         }
+      }
+   }
+
+   this->stopTiming( "Dot batch (local)" );
+   return scalarProducts;
+}
+
+template < typename ValueType >
+std::vector< ValueType >
+    EdgeDoFFunction< ValueType >::dotGlobalBatch( const std::vector< std::reference_wrapper< const EdgeDoFFunction< ValueType > > >& rhs,
+                                                  const uint_t                                                                       level,
+                                                  const DoFType flag ) const
+{
+   std::vector< ValueType > scalarProducts = dotLocalBatch( rhs, level, flag );
+   this->startTiming( "Dot batch (reduce)" );
+   walberla::mpi::allReduceInplace( scalarProducts, walberla::mpi::SUM, walberla::mpi::MPIManager::instance()->comm() );
+   this->stopTiming( "Dot batch (reduce)" );
+   return scalarProducts;
+}
+
 template < typename ValueType >
 ValueType EdgeDoFFunction< ValueType >::sumGlobal( const uint_t& level, const DoFType& flag, const bool& absolute ) const
 {
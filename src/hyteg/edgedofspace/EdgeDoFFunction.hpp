@@ -24,6 +24,7 @@
 #include "hyteg/ReferenceCounter.hpp"
 #include "hyteg/boundary/BoundaryConditions.hpp"
 #include "hyteg/functions/Function.hpp"
+#include "hyteg/memory/FunctionMemory.hpp"
 #include "hyteg/sparseassembly/VectorProxy.hpp"
 
 namespace hyteg {
@@ -113,7 +114,9 @@ class EdgeDoFFunction final : public Function< EdgeDoFFunction< ValueType > >
    /// \brief Copies all values function data from other to this.
    ///
    /// This method can be used safely if the other function is located on a different PrimitiveStorage.
-   void copyFrom( const EdgeDoFFunction< ValueType >& other, const uint_t& level ) const;
+   /// If the value types differ (e.g. double and float), the values are converted.
+   template < typename otherValueType >
+   void copyFrom( const EdgeDoFFunction< otherValueType >& other, const uint_t& level ) const;
 
    /// \brief Copies all values function data from other to this.
    ///
@@ -202,6 +205,27 @@ class EdgeDoFFunction final : public Function< EdgeDoFFunction< ValueType > >
    ValueType dotLocal( const EdgeDoFFunction< ValueType >& secondOp, const uint_t level, const DoFType flag = All ) const;
    ValueType dotGlobal( const EdgeDoFFunction< ValueType >& secondOp, const uint_t level, const DoFType flag = All ) const;
 
+   /// \brief Adds scalar * src to this function and returns the dot product of the updated function with itself.
+   ///
+   /// Equivalent to add( { scalar }, { src }, level, flag ) followed by dotLocal( *this, level, flag ), but touches the
+   /// memory only once. Useful for residual updates in Krylov methods.
+   ValueType
+       addAndDotLocal( ValueType scalar, const EdgeDoFFunction< ValueType >& src, const uint_t level, const DoFType flag = All ) const;
+   /// Same as addAndDotLocal() but performs a global reduction of the dot product.
+   ValueType
+       addAndDotGlobal( ValueType scalar, const EdgeDoFFunction< ValueType >& src, const uint_t level, const DoFType flag = All ) const;
+
+   /// \brief Computes the dot products of this function with each of the passed functions.
+   ///
+   /// Reads the data of this function only once for all dot products. The global variant sums up all results with a
+   /// single reduction.
+   std::vector< ValueType > dotLocalBatch( const std::vector< std::reference_wrapper< const EdgeDoFFunction< ValueType > > >& rhs,
+                                           const uint_t                                                                       level,
+                                           const DoFType flag = All ) const;
+   std::vector< ValueType > dotGlobalBatch( const std::vector< std::reference_wrapper< const EdgeDoFFunction< ValueType > > >& rhs,
+                                            const uint_t                                                                       level,
+                                            const DoFType flag = All ) const;
+
    ValueType sumLocal( const uint_t& level, const DoFType& flag = All, const bool& absolute = false ) const;
    ValueType sumGlobal( const uint_t& level, const DoFType& flag = All, const bool& absolute = false ) const;
 
@@ -383,6 +407,10 @@ class EdgeDoFFunction final : public Function< EdgeDoFFunction< ValueType > >
    ///@}
 
  private:
+   /// Allocates the memory of all levels and all local primitives in a single FunctionMemoryArena.
+   /// Called by the constructor if FunctionMemory::useArenaAllocation() is set.
+   void allocateArenaMemory( uint_t minLevel, uint_t maxLevel );
+
    inline void deleteFunctionMemory()
    {
       this->storage_->deleteVertexData( vertexDataID_ );
@@ -414,4 +442,53 @@ class EdgeDoFFunction final : public Function< EdgeDoFFunction< ValueType > >
 
 // extern template class EdgeDoFFunction< double >;
 extern template class EdgeDoFFunction< int >;
+
+template < typename ValueType >
+template < typename otherValueType >
+void EdgeDoFFunction< ValueType >::copyFrom( const EdgeDoFFunction< otherValueType >& other, const uint_t& level ) const
+{
+   this->startTiming( "Copy" );
+
+   for ( auto& it : this->getStorage()->getVertices() )
+   {
+      auto primitiveID = it.first;
+      WALBERLA_ASSERT( other.getStorage()->vertexExistsLocally( primitiveID ) )
+      this->getStorage()
+          ->getVertex( primitiveID )
+          ->getData( vertexDataID_ )
+          ->copyFrom( *other.getStorage()->getVertex( primitiveID )->getData( other.getVertexDataID() ), level );
+   }
+
+   for ( auto& it : this->getStorage()->getEdges() )
+   {
+      auto primitiveID = it.first;
+      WALBERLA_ASSERT( other.getStorage()->edgeExistsLocally( primitiveID ) )
+      this->getStorage()
+          ->getEdge( primitiveID )
+          ->getData( edgeDataID_ )
+          ->copyFrom( *other.getStorage()->getEdge( primitiveID )->getData( other.getEdgeDataID() ), level );
+   }
+
+   for ( auto& it : this->getStorage()->getFaces() )
+   {
+      auto primitiveID = it.first;
+      WALBERLA_ASSERT( other.getStorage()->faceExistsLocally( primitiveID ) )
+      this->getStorage()
+          ->getFace( primitiveID )
+          ->getData( faceDataID_ )
+          ->copyFrom( *other.getStorage()->getFace( primitiveID )->getData( other.getFaceDataID() ), level );
+   }
+
+   for ( auto& it : this->getStorage()->getCells() )
+   {
+      auto primitiveID = it.first;
+      WALBERLA_ASSERT( other.getStorage()->cellExistsLocally( primitiveID ) )
+      this->getStorage()
+          ->getCell( primitiveID )
+          ->getData( cellDataID_ )
+          ->copyFrom( *other.getStorage()->getCell( primitiveID )->getData( other.getCellDataID() ), level );
+   }
+
+   this->stopTiming( "Copy" );
+}
 } // namespace hyteg
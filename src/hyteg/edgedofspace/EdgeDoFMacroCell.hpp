@@ -662,6 +662,134 @@ inline void multElementwise( const uint_t&
    }
 }
 
+/// Adds scalar * src to dst and returns the dot product of the updated dst with itself in one sweep.
+template < concepts::value_type ValueType >
+inline ValueType addAndDot( const uint_t&                                               Level,
+                            Cell&                                                       cell,
+                            const ValueType&                                            scalar,
+                            const PrimitiveDataID< FunctionMemory< ValueType >, Cell >& srcId,
+                            const PrimitiveDataID< FunctionMemory< ValueType >, Cell >& dstId )
+{
+   auto srcData = cell.getData( srcId )->getPointer( Level );
+   auto dstData = cell.getData( dstId )->getPointer( Level );
+
+   walberla::math::KahanAccumulator< ValueType > scalarProduct;
+
+   auto update = [&]( const uint_t idx ) {
+      dstData[idx] += scalar * srcData[idx];
+      scalarProduct += dstData[idx] * dstData[idx];
+   };
+
+   for ( const auto& it : edgedof::macrocell::Iterator( Level, 0 ) )
+   {
+      if ( isInnerXEdgeDoF( Level, it ) )
+      {
+         update( edgedof::macrocell::xIndex( Level, it.x(), it.y(), it.z() ) );
+      }
+
+      if ( isInnerYEdgeDoF( Level, it ) )
+      {
+         update( edgedof::macrocell::yIndex( Level, it.x(), it.y(), it.z() ) );
+      }
+
+      if ( isInnerZEdgeDoF( Level, it ) )
+      {
+         update( edgedof::macrocell::zIndex( Level, it.x(), it.y(), it.z() ) );
+      }
+
+      if ( isInnerXYEdgeDoF( Level, it ) )
+      {
+         update( edgedof::macrocell::xyIndex( Level, it.x(), it.y(), it.z() ) );
+      }
+
+      if ( isInnerXZEdgeDoF( Level, it ) )
+      {
+         update( edgedof::macrocell::xzIndex( Level, it.x(), it.y(), it.z() ) );
+      }
+
+      if ( isInnerYZEdgeDoF( Level, it ) )
+      {
+         update( edgedof::macrocell::yzIndex( Level, it.x(), it.y(), it.z() ) );
+      }
+   }
+
+   for ( const auto& it : edgedof::macrocell::IteratorXYZ( Level, 0 ) )
+   {
+      update( edgedof::macrocell::xyzIndex( Level, it.x(), it.y(), it.z() ) );
+   }
+
+   return scalarProduct.get();
+}
+
+template < concepts::value_type ValueType >
+inline void dotBatch( const uint_t&                                                              Level,
+                      Cell&                                                                      cell,
+                      const PrimitiveDataID< FunctionMemory< ValueType >, Cell >&                lhsId,
+                      const std::vector< PrimitiveDataID< FunctionMemory< ValueType >, Cell > >& rhsIds,
+                      std::vector< ValueType >&                                                  scalarProducts )
+{
+   const uint_t                                                 numRhs = rhsIds.size();
+   std::vector< walberla::math::KahanAccumulator< ValueType > > products( numRhs );
+
+   const ValueType*                lhsData = cell.getData( lhsId )->getPointer( Level );
+   std::vector< const ValueType* > rhsData( numRhs );
+   for ( uint_t k = 0; k < numRhs; ++k )
+   {
+      rhsData[k] = cell.getData( rhsIds[k] )->getPointer( Level );
+   }
+
+   auto accumulate = [&]( const uint_t idx ) {
+      const ValueType lhsValue = lhsData[idx];
+      for ( uint_t k = 0; k < numRhs; ++k )
+      {
+         products[k] += lhsValue * rhsData[k][idx];
+      }
+   };
+
+   for ( const auto& it : edgedof::macrocell::Iterator( Level, 0 ) )
+   {
+      if ( isInnerXEdgeDoF( Level, it ) )
+      {
+         accumulate( edgedof::macrocell::xIndex( Level, it.x(), it.y(), it.z() ) );
+      }
+
+      if ( isInnerYEdgeDoF( Level, it ) )
+      {
+         accumulate( edgedof::macrocell::yIndex( Level, it.x(), it.y(), it.z() ) );
+      }
+
+      if ( isInnerZEdgeDoF( Level, it ) )
+      {
+         accumulate( edgedof::macrocell::zIndex( Level, it.x(), it.y(), it.z() ) );
+      }
+
+      if ( isInnerXYEdgeDoF( Level, it ) )
+      {
+         accumulate( edgedof::macrocell::xyIndex( Level, it.x(), it.y(), it.z() ) );
+      }
+
+      if ( isInnerXZEdgeDoF( Level, it ) )
+      {
+         accumulate( edgedof::macrocell::xzIndex( Level, it.x(), it.y(), it.z() ) );
+      }
+
+      if ( isInnerYZEdgeDoF( Level, it ) )
+      {
+         accumulate( edgedof::macrocell::yzIndex( Level, it.x(), it.y(), it.z() ) );
+      }
+   }
+
+   for ( const auto& it : edgedof::macrocell::IteratorXYZ( Level, 0 ) )
+   {
+      accumulate( edgedof::macrocell::xyzIndex( Level, it.x(), it.y(), it.z() ) );
+   }
+
+   for ( uint_t k = 0; k < numRhs; ++k )
+   {
+      scalarProducts[k] += products[k].get();
+   }
+}
+
 template < concepts::value_type ValueType >
 inline ValueType dot( const uint_t&                                               Level,
                       Cell&                                                       cell,
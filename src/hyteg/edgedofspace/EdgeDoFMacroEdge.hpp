@@ -244,6 +244,62 @@ inline void multElementwise( const uint_t&
    }
 }
 
+/// Adds scalar * src to dst and returns the dot product of the updated dst with itself in one sweep.
+template < concepts::value_type ValueType >
+inline ValueType addAndDot( const uint_t&                                               Level,
+                            Edge&                                                       edge,
+                            const ValueType&                                            scalar,
+                            const PrimitiveDataID< FunctionMemory< ValueType >, Edge >& srcId,
+                            const PrimitiveDataID< FunctionMemory< ValueType >, Edge >& dstId )
+{
+   auto srcData = edge.getData( srcId )->getPointer( Level );
+   auto dstData = edge.getData( dstId )->getPointer( Level );
+
+   walberla::math::KahanAccumulator< ValueType > scalarProduct;
+
+   for ( const auto& it : edgedof::macroedge::Iterator( Level ) )
+   {
+      const uint_t idx = edgedof::macroedge::indexFromHorizontalEdge( Level, it.x(), stencilDirection::EDGE_HO_C );
+      dstData[idx] += scalar * srcData[idx];
+      scalarProduct += dstData[idx] * dstData[idx];
+   }
+
+   return scalarProduct.get();
+}
+
+template < concepts::value_type ValueType >
+inline void dotBatch( const uint_t&                                                              Level,
+                      Edge&                                                                      edge,
+                      const PrimitiveDataID< FunctionMemory< ValueType >, Edge >&                lhsId,
+                      const std::vector< PrimitiveDataID< FunctionMemory< ValueType >, Edge > >& rhsIds,
+                      std::vector< ValueType >&                                                  scalarProducts )
+{
+   const uint_t                                                 numRhs = rhsIds.size();
+   std::vector< walberla::math::KahanAccumulator< ValueType > > products( numRhs );
+
+   const ValueType*                lhsData = edge.getData( lhsId )->getPointer( Level );
+   std::vector< const ValueType* > rhsData( numRhs );
+   for ( uint_t k = 0; k < numRhs; ++k )
+   {
+      rhsData[k] = edge.getData( rhsIds[k] )->getPointer( Level );
+   }
+
+   for ( const auto& it : edgedof::macroedge::Iterator( Level ) )
+   {
+      const uint_t    idx      = edgedof::macroedge::indexFromHorizontalEdge( Level, it.x(), stencilDirection::EDGE_HO_C );
+      const ValueType lhsValue = lhsData[idx];
+      for ( uint_t k = 0; k < numRhs; ++k )
+      {
+         products[k] += lhsValue * rhsData[k][idx];
+      }
+   }
+
+   for ( uint_t k = 0; k < numRhs; ++k )
+   {
+      scalarProducts[k] += products[k].get();
+   }
+}
+
 template < concepts::value_type ValueType >
 inline ValueType dot( const uint_t&                                               Level,
                       Edge&                                                       edge,
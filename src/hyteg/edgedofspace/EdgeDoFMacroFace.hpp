@@ -611,6 +611,100 @@ inline void multElementwise( const uint_t&
    }
 }
 
+/// Adds scalar * src to dst and returns the dot product of the updated dst with itself in one sweep.
+template < concepts::value_type ValueType >
+inline ValueType addAndDot( const uint_t&                                               Level,
+                            Face&                                                       face,
+                            const ValueType&                                            scalar,
+                            const PrimitiveDataID< FunctionMemory< ValueType >, Face >& srcId,
+                            const PrimitiveDataID< FunctionMemory< ValueType >, Face >& dstId )
+{
+   auto srcData = face.getData( srcId )->getPointer( Level );
+   auto dstData = face.getData( dstId )->getPointer( Level );
+
+   walberla::math::KahanAccumulator< ValueType > scalarProduct;
+
+   auto update = [&]( const uint_t idx ) {
+      dstData[idx] += scalar * srcData[idx];
+      scalarProduct += dstData[idx] * dstData[idx];
+   };
+
+   for ( const auto& it : edgedof::macroface::Iterator( Level, 0 ) )
+   {
+      // Do not update horizontal DoFs at bottom
+      if ( it.y() != 0 )
+      {
+         update( edgedof::macroface::horizontalIndex( Level, it.x(), it.y() ) );
+      }
+
+      // Do not update vertical DoFs at left border
+      if ( it.x() != 0 )
+      {
+         update( edgedof::macroface::verticalIndex( Level, it.x(), it.y() ) );
+      }
+
+      // Do not update diagonal DoFs at diagonal border
+      if ( it.x() + it.y() != ( hyteg::levelinfo::num_microedges_per_edge( Level ) - 1 ) )
+      {
+         update( edgedof::macroface::diagonalIndex( Level, it.x(), it.y() ) );
+      }
+   }
+
+   return scalarProduct.get();
+}
+
+template < concepts::value_type ValueType >
+inline void dotBatch( const uint_t&                                                              Level,
+                      Face&                                                                      face,
+                      const PrimitiveDataID< FunctionMemory< ValueType >, Face >&                lhsId,
+                      const std::vector< PrimitiveDataID< FunctionMemory< ValueType >, Face > >& rhsIds,
+                      std::vector< ValueType >&                                                  scalarProducts )
+{
+   const uint_t                                                 numRhs = rhsIds.size();
+   std::vector< walberla::math::KahanAccumulator< ValueType > > products( numRhs );
+
+   const ValueType*                lhsData = face.getData( lhsId )->getPointer( Level );
+   std::vector< const ValueType* > rhsData( numRhs );
+   for ( uint_t k = 0; k < numRhs; ++k )
+   {
+      rhsData[k] = face.getData( rhsIds[k] )->getPointer( Level );
+   }
+
+   auto accumulate = [&]( const uint_t idx ) {
+      const ValueType lhsValue = lhsData[idx];
+      for ( uint_t k = 0; k < numRhs; ++k )
+      {
+         products[k] += lhsValue * rhsData[k][idx];
+      }
+   };
+
+   for ( const auto& it : edgedof::macroface::Iterator( Level, 0 ) )
+   {
+      // Do not read horizontal DoFs at bottom
+      if ( it.y() != 0 )
+      {
+         accumulate( edgedof::macroface::horizontalIndex( Level, it.x(), it.y() ) );
+      }
+
+      // Do not read vertical DoFs at left border
+      if ( it.x() != 0 )
+      {
+         accumulate( edgedof::macroface::verticalIndex( Level, it.x(), it.y() ) );
+      }
+
+      // Do not read diagonal DoFs at diagonal border
+      if ( it.x() + it.y() != ( hyteg::levelinfo::num_microedges_per_edge( Level ) - 1 ) )
+      {
+         accumulate( edgedof::macroface::diagonalIndex( Level, it.x(), it.y() ) );
+      }
+   }
+
+   for ( uint_t k = 0; k < numRhs; ++k )
+   {
+      scalarProducts[k] += products[k].get();
+   }
+}
+
 template < concepts::value_type ValueType >
 inline ValueType dot( const uint_t&                                               Level,
                       Face&                                                       face,
@@ -20,6 +20,8 @@
 
 #include "P1ElementwiseSurrogateOperator.hpp"
 
+#include <algorithm>
+
 #include <hyteg/forms/P1RowSumForm.hpp>
 #include <hyteg/forms/form_hyteg_generated/p1/p1_diffusion_blending_q3.hpp>
 #include <hyteg/forms/form_hyteg_generated/p1/p1_div_k_grad_affine_q3.hpp>
@@ -647,27 +649,29 @@ void P1ElementwiseSurrogateOperator< P1Form, DEGREE, Symmetric >::apply_2d( cons
          // iterate over all micro-faces
          indexing::Index micro;
          const auto      row_end = idx_t( facedof::macroface::numFacesPerRowByType( level, fType ) );
+         // entries of the local stiffness matrices of all micro-faces in the current row
+         std::vector< real_t > rowValues( uint_t( surrogate.size() ) * uint_t( row_end ) );
          for ( micro.y() = 0; micro.y() < row_end; micro.y()++ )
          {
-            // restrict to 1d polynomial
-            auto y = X[micro.y()];
+            // restrict to 1d polynomial and evaluate it for the whole row at once
+            const auto y     = X[micro.y()];
+            const auto n_row = uint_t( row_end - micro.y() );
             for ( idx_t i = 0; i < surrogate.rows(); ++i )
             {
                for ( idx_t j = 0; j < surrogate.cols(); ++j )
                {
                   surrogate( i, j ).fix_y( y );
+                  surrogate( i, j ).eval_line( X[0], X.scaling, n_row, &rowValues[uint_t( i * surrogate.cols() + j ) * n_row] );
                }
             }
 
             for ( micro.x() = 0; micro.x() < row_end - micro.y(); micro.x()++ )
             {
-               // evaluate p(x) using Horner's method
-               auto x = X[micro.x()];
                for ( idx_t i = 0; i < surrogate.rows(); ++i )
                {
                   for ( idx_t j = 0; j < surrogate.cols(); ++j )
                   {
-                     elMat( i, j ) = surrogate( i, j ).eval( x );
+                     elMat( i, j ) = rowValues[uint_t( i * surrogate.cols() + j ) * n_row + uint_t( micro.x() )];
                   }
                }
 
@@ -842,6 +846,12 @@ void P1ElementwiseSurrogateOperator< P1Form, DEGREE, Symmetric >::apply_3d( cons
          surrogate::polynomial::Polynomial< real_t, 1, DEGREE > p76;
          surrogate::polynomial::Polynomial< real_t, 1, DEGREE > p77;
 
+         /* entries of the local stiffness matrices of a block of cubes within a row, a_line[8*i+j][b] = a_ij of cube b.
+            The block size is chosen such that these values stay in the L1 cache.
+         */
+         constexpr uint_t                                       LINE_BLOCK = 32;
+         std::array< std::array< real_t, LINE_BLOCK >, 8 * 8 > a_line;
+
          // iterate over all micro-cells
          indexing::Index micro;
          const auto      n = idx_t( celldof::macrocell::numCellsPerRowByType( level, celldof::CellType::WHITE_UP ) );
@@ -1016,155 +1026,226 @@ void P1ElementwiseSurrogateOperator< P1Form, DEGREE, Symmetric >::apply_3d( cons
                std::array< uint_t, 8 > vertexDoFIndices{};
                p1::getGlobalCubeIndices3D( level, micro, vertexDoFIndices );
 
-               /* constant part of local stiffness matrix
-                  For some reason, accessing pij[0] within the x-loop costs performance
-               */
-               const real_t c00 = p00[0], c01 = p01[0], c02 = p02[0], c03 = p03[0], c04 = p04[0], c05 = p05[0], c06 = p06[0],
-                            c07 = p07[0];
-               const real_t c10 = p10[0], c11 = p11[0], c12 = p12[0], c13 = p13[0], c14 = p14[0], c15 = p15[0], c16 = p16[0],
-                            c17 = p17[0];
-               const real_t c20 = p20[0], c21 = p21[0], c22 = p22[0], c23 = p23[0], c24 = p24[0], c25 = p25[0], c26 = p26[0],
-                            c27 = p27[0];
-               const real_t c30 = p30[0], c31 = p31[0], c32 = p32[0], c33 = p33[0], c34 = p34[0], c35 = p35[0], c36 = p36[0],
-                            c37 = p37[0];
-               const real_t c40 = p40[0], c41 = p41[0], c42 = p42[0], c43 = p43[0], c44 = p44[0], c45 = p45[0], c46 = p46[0],
-                            c47 = p47[0];
-               const real_t c50 = p50[0], c51 = p51[0], c52 = p52[0], c53 = p53[0], c54 = p54[0], c55 = p55[0], c56 = p56[0],
-                            c57 = p57[0];
-               const real_t c60 = p60[0], c61 = p61[0], c62 = p62[0], c63 = p63[0], c64 = p64[0], c65 = p65[0], c66 = p66[0],
-                            c67 = p67[0];
-               const real_t c70 = p70[0], c71 = p71[0], c72 = p72[0], c73 = p73[0], c74 = p74[0], c75 = p75[0], c76 = p76[0],
-                            c77 = p77[0];
-
-               // loop over all full cubes in the row
-               for ( micro.x() = 0; micro.x() < n - 2 - micro.z() - micro.y(); micro.x()++ )
+               // number of full cubes in the row
+               const idx_t n_cubes = n - 2 - micro.z() - micro.y();
+
+               // loop over all full cubes in the row, in blocks of LINE_BLOCK cubes
+               for ( idx_t x_block = 0; x_block < n_cubes; x_block += idx_t( LINE_BLOCK ) )
                {
-                  // global indices
-                  const uint_t g0 = vertexDoFIndices[0] + micro.x();
-                  const uint_t g1 = vertexDoFIndices[1] + micro.x();
-                  const uint_t g2 = vertexDoFIndices[2] + micro.x();
-                  const uint_t g3 = vertexDoFIndices[3] + micro.x();
-                  const uint_t g4 = vertexDoFIndices[4] + micro.x();
-                  const uint_t g5 = vertexDoFIndices[5] + micro.x();
-                  const uint_t g6 = vertexDoFIndices[6] + micro.x();
-                  const uint_t g7 = vertexDoFIndices[7] + micro.x();
-
-                  // assemble local element vector v = alpha*src
-                  const auto v0 = alpha * srcVertexData[g0];
-                  const auto v1 = alpha * srcVertexData[g1];
-                  const auto v2 = alpha * srcVertexData[g2];
-                  const auto v3 = alpha * srcVertexData[g3];
-                  const auto v4 = alpha * srcVertexData[g4];
-                  const auto v5 = alpha * srcVertexData[g5];
-                  const auto v6 = alpha * srcVertexData[g6];
-                  const auto v7 = alpha * srcVertexData[g7];
-
-                  // local stiffness matrix
-                  real_t a00, a01, a02, a03, a04, a05, a06, a07;
-                  real_t a10, a11, a12, a13, a14, a15, a16, a17;
-                  real_t a20, a21, a22, a23, a24, a25, a26, a27;
-                  real_t a30, a31, a32, a33, a34, a35, a36, a37;
-                  real_t a40, a41, a42, a43, a44, a45, a46, a47;
-                  real_t a50, a51, a52, a53, a54, a55, a56, a57;
-                  real_t a60, a61, a62, a63, a64, a65, a66, a67;
-                  real_t a70, a71, a72, a73, a74, a75, a76, a77;
-
-                  // todo: exploit hard zeros
-
-                  // constant part
+                  const auto n_block = uint_t( std::min( idx_t( LINE_BLOCK ), n_cubes - x_block ) );
+
+                  // evaluate the 1d polynomials for all cubes in the block at once
+                  const auto x0 = X[x_block];
                   if constexpr ( Symmetric )
                   {
-                     a00 = c00;
-                     a10 = c10, a11 = c11;
-                     a20 = c20, a21 = c21, a22 = c22;
-                     a30 = c30, a31 = c31, a32 = c32, a33 = c33;
-                     a40 = c40, a41 = c41, a42 = c42, a43 = c43, a44 = c44;
-                     a50 = c50, a51 = c51, a52 = c52, a53 = c53, a54 = c54, a55 = c55;
-                     a60 = c60, a61 = c61, a62 = c62, a63 = c63, a64 = c64, a65 = c65, a66 = c66;
-                     a70 = c70, a71 = c71, a72 = c72, a73 = c73, a74 = c74, a75 = c75, a76 = c76, a77 = c77;
+                     p00.eval_line( x0, X.scaling, n_block, a_line[0].data() );
+                     p10.eval_line( x0, X.scaling, n_block, a_line[8].data() );
+                     p11.eval_line( x0, X.scaling, n_block, a_line[9].data() );
+                     p20.eval_line( x0, X.scaling, n_block, a_line[16].data() );
+                     p21.eval_line( x0, X.scaling, n_block, a_line[17].data() );
+                     p22.eval_line( x0, X.scaling, n_block, a_line[18].data() );
+                     p30.eval_line( x0, X.scaling, n_block, a_line[24].data() );
+                     p31.eval_line( x0, X.scaling, n_block, a_line[25].data() );
+                     p32.eval_line( x0, X.scaling, n_block, a_line[26].data() );
+                     p33.eval_line( x0, X.scaling, n_block, a_line[27].data() );
+                     p40.eval_line( x0, X.scaling, n_block, a_line[32].data() );
+                     p41.eval_line( x0, X.scaling, n_block, a_line[33].data() );
+                     p42.eval_line( x0, X.scaling, n_block, a_line[34].data() );
+                     p43.eval_line( x0, X.scaling, n_block, a_line[35].data() );
+                     p44.eval_line( x0, X.scaling, n_block, a_line[36].data() );
+                     p50.eval_line( x0, X.scaling, n_block, a_line[40].data() );
+                     p51.eval_line( x0, X.scaling, n_block, a_line[41].data() );
+                     p52.eval_line( x0, X.scaling, n_block, a_line[42].data() );
+                     p53.eval_line( x0, X.scaling, n_block, a_line[43].data() );
+                     p54.eval_line( x0, X.scaling, n_block, a_line[44].data() );
+                     p55.eval_line( x0, X.scaling, n_block, a_line[45].data() );
+                     p60.eval_line( x0, X.scaling, n_block, a_line[48].data() );
+                     p61.eval_line( x0, X.scaling, n_block, a_line[49].data() );
+                     p62.eval_line( x0, X.scaling, n_block, a_line[50].data() );
+                     p63.eval_line( x0, X.scaling, n_block, a_line[51].data() );
+                     p64.eval_line( x0, X.scaling, n_block, a_line[52].data() );
+                     p65.eval_line( x0, X.scaling, n_block, a_line[53].data() );
+                     p66.eval_line( x0, X.scaling, n_block, a_line[54].data() );
+                     p70.eval_line( x0, X.scaling, n_block, a_line[56].data() );
+                     p71.eval_line( x0, X.scaling, n_block, a_line[57].data() );
+                     p72.eval_line( x0, X.scaling, n_block, a_line[58].data() );
+                     p73.eval_line( x0, X.scaling, n_block, a_line[59].data() );
+                     p74.eval_line( x0, X.scaling, n_block, a_line[60].data() );
+                     p75.eval_line( x0, X.scaling, n_block, a_line[61].data() );
+                     p76.eval_line( x0, X.scaling, n_block, a_line[62].data() );
+                     p77.eval_line( x0, X.scaling, n_block, a_line[63].data() );
                   }
                   else
                   {
-                     a00 = c00, a01 = c01, a02 = c02, a03 = c03, a04 = c04, a05 = c05, a06 = c06, a07 = c07;
-                     a10 = c10, a11 = c11, a12 = c12, a13 = c13, a14 = c14, a15 = c15, a16 = c16, a17 = c17;
-                     a20 = c20, a21 = c21, a22 = c22, a23 = c23, a24 = c24, a25 = c25, a26 = c26, a27 = c27;
-                     a30 = c30, a31 = c31, a32 = c32, a33 = c33, a34 = c34, a35 = c35, a36 = c36, a37 = c37;
-                     a40 = c40, a41 = c41, a42 = c42, a43 = c43, a44 = c44, a45 = c45, a46 = c46, a47 = c47;
-                     a50 = c50, a51 = c51, a52 = c52, a53 = c53, a54 = c54, a55 = c55, a56 = c56, a57 = c57;
-                     a60 = c60, a61 = c61, a62 = c62, a63 = c63, a64 = c64, a65 = c65, a66 = c66, a67 = c67;
-                     a70 = c70, a71 = c71, a72 = c72, a73 = c73, a74 = c74, a75 = c75, a76 = c76, a77 = c77;
+                     p00.eval_line( x0, X.scaling, n_block, a_line[0].data() );
+                     p01.eval_line( x0, X.scaling, n_block, a_line[1].data() );
+                     p02.eval_line( x0, X.scaling, n_block, a_line[2].data() );
+                     p03.eval_line( x0, X.scaling, n_block, a_line[3].data() );
+                     p04.eval_line( x0, X.scaling, n_block, a_line[4].data() );
+                     p05.eval_line( x0, X.scaling, n_block, a_line[5].data() );
+                     p06.eval_line( x0, X.scaling, n_block, a_line[6].data() );
+                     p07.eval_line( x0, X.scaling, n_block, a_line[7].data() );
+                     p10.eval_line( x0, X.scaling, n_block, a_line[8].data() );
+                     p11.eval_line( x0, X.scaling, n_block, a_line[9].data() );
+                     p12.eval_line( x0, X.scaling, n_block, a_line[10].data() );
+                     p13.eval_line( x0, X.scaling, n_block, a_line[11].data() );
+                     p14.eval_line( x0, X.scaling, n_block, a_line[12].data() );
+                     p15.eval_line( x0, X.scaling, n_block, a_line[13].data() );
+                     p16.eval_line( x0, X.scaling, n_block, a_line[14].data() );
+                     p17.eval_line( x0, X.scaling, n_block, a_line[15].data() );
+                     p20.eval_line( x0, X.scaling, n_block, a_line[16].data() );
+                     p21.eval_line( x0, X.scaling, n_block, a_line[17].data() );
+                     p22.eval_line( x0, X.scaling, n_block, a_line[18].data() );
+                     p23.eval_line( x0, X.scaling, n_block, a_line[19].data() );
+                     p24.eval_line( x0, X.scaling, n_block, a_line[20].data() );
+                     p25.eval_line( x0, X.scaling, n_block, a_line[21].data() );
+                     p26.eval_line( x0, X.scaling, n_block, a_line[22].data() );
+                     p27.eval_line( x0, X.scaling, n_block, a_line[23].data() );
+                     p30.eval_line( x0, X.scaling, n_block, a_line[24].data() );
+                     p31.eval_line( x0, X.scaling, n_block, a_line[25].data() );
+                     p32.eval_line( x0, X.scaling, n_block, a_line[26].data() );
+                     p33.eval_line( x0, X.scaling, n_block, a_line[27].data() );
+                     p34.eval_line( x0, X.scaling, n_block, a_line[28].data() );
+                     p35.eval_line( x0, X.scaling, n_block, a_line[29].data() );
+                     p36.eval_line( x0, X.scaling, n_block, a_line[30].data() );
+                     p37.eval_line( x0, X.scaling, n_block, a_line[31].data() );
+                     p40.eval_line( x0, X.scaling, n_block, a_line[32].data() );
+                     p41.eval_line( x0, X.scaling, n_block, a_line[33].data() );
+                     p42.eval_line( x0, X.scaling, n_block, a_line[34].data() );
+                     p43.eval_line( x0, X.scaling, n_block, a_line[35].data() );
+                     p44.eval_line( x0, X.scaling, n_block, a_line[36].data() );
+                     p45.eval_line( x0, X.scaling, n_block, a_line[37].data() );
+                     p46.eval_line( x0, X.scaling, n_block, a_line[38].data() );
+                     p47.eval_line( x0, X.scaling, n_block, a_line[39].data() );
+                     p50.eval_line( x0, X.scaling, n_block, a_line[40].data() );
+                     p51.eval_line( x0, X.scaling, n_block, a_line[41].data() );
+                     p52.eval_line( x0, X.scaling, n_block, a_line[42].data() );
+                     p53.eval_line( x0, X.scaling, n_block, a_line[43].data() );
+                     p54.eval_line( x0, X.scaling, n_block, a_line[44].data() );
+                     p55.eval_line( x0, X.scaling, n_block, a_line[45].data() );
+                     p56.eval_line( x0, X.scaling, n_block, a_line[46].data() );
+                     p57.eval_line( x0, X.scaling, n_block, a_line[47].data() );
+                     p60.eval_line( x0, X.scaling, n_block, a_line[48].data() );
+                     p61.eval_line( x0, X.scaling, n_block, a_line[49].data() );
+                     p62.eval_line( x0, X.scaling, n_block, a_line[50].data() );
+                     p63.eval_line( x0, X.scaling, n_block, a_line[51].data() );
+                     p64.eval_line( x0, X.scaling, n_block, a_line[52].data() );
+                     p65.eval_line( x0, X.scaling, n_block, a_line[53].data() );
+                     p66.eval_line( x0, X.scaling, n_block, a_line[54].data() );
+                     p67.eval_line( x0, X.scaling, n_block, a_line[55].data() );
+                     p70.eval_line( x0, X.scaling, n_block, a_line[56].data() );
+                     p71.eval_line( x0, X.scaling, n_block, a_line[57].data() );
+                     p72.eval_line( x0, X.scaling, n_block, a_line[58].data() );
+                     p73.eval_line( x0, X.scaling, n_block, a_line[59].data() );
+                     p74.eval_line( x0, X.scaling, n_block, a_line[60].data() );
+                     p75.eval_line( x0, X.scaling, n_block, a_line[61].data() );
+                     p76.eval_line( x0, X.scaling, n_block, a_line[62].data() );
+                     p77.eval_line( x0, X.scaling, n_block, a_line[63].data() );
                   }
-                  // evaluate the 1d polynomials (variable part)
-                  const auto x  = X[micro.x()];
-                  auto       xk = real_t( 1.0 );
-                  for ( uint_t k = 1; k < dimP; ++k )
+
+                  for ( uint_t b = 0; b < n_block; ++b )
                   {
-                     xk *= x;
+                     micro.x() = x_block + idx_t( b );
+
+                     // global indices
+                     const uint_t g0 = vertexDoFIndices[0] + micro.x();
+                     const uint_t g1 = vertexDoFIndices[1] + micro.x();
+                     const uint_t g2 = vertexDoFIndices[2] + micro.x();
+                     const uint_t g3 = vertexDoFIndices[3] + micro.x();
+                     const uint_t g4 = vertexDoFIndices[4] + micro.x();
+                     const uint_t g5 = vertexDoFIndices[5] + micro.x();
+                     const uint_t g6 = vertexDoFIndices[6] + micro.x();
+                     const uint_t g7 = vertexDoFIndices[7] + micro.x();
+
+                     // assemble local element vector v = alpha*src
+                     const auto v0 = alpha * srcVertexData[g0];
+                     const auto v1 = alpha * srcVertexData[g1];
+                     const auto v2 = alpha * srcVertexData[g2];
+                     const auto v3 = alpha * srcVertexData[g3];
+                     const auto v4 = alpha * srcVertexData[g4];
+                     const auto v5 = alpha * srcVertexData[g5];
+                     const auto v6 = alpha * srcVertexData[g6];
+                     const auto v7 = alpha * srcVertexData[g7];
+
+                     // local stiffness matrix
+                     real_t a00, a01, a02, a03, a04, a05, a06, a07;
+                     real_t a10, a11, a12, a13, a14, a15, a16, a17;
+                     real_t a20, a21, a22, a23, a24, a25, a26, a27;
+                     real_t a30, a31, a32, a33, a34, a35, a36, a37;
+                     real_t a40, a41, a42, a43, a44, a45, a46, a47;
+                     real_t a50, a51, a52, a53, a54, a55, a56, a57;
+                     real_t a60, a61, a62, a63, a64, a65, a66, a67;
+                     real_t a70, a71, a72, a73, a74, a75, a76, a77;
+
+                     // todo: exploit hard zeros
+
+                     // entries of the local stiffness matrix
                      if constexpr ( Symmetric )
                      {
-                        a00 += p00[k] * xk;
-                        a10 += p10[k] * xk, a11 += p11[k] * xk;
-                        a20 += p20[k] * xk, a21 += p21[k] * xk, a22 += p22[k] * xk;
-                        a30 += p30[k] * xk, a31 += p31[k] * xk, a32 += p32[k] * xk, a33 += p33[k] * xk;
-                        a40 += p40[k] * xk, a41 += p41[k] * xk, a42 += p42[k] * xk, a43 += p43[k] * xk, a44 += p44[k] * xk;
-                        a50 += p50[k] * xk, a51 += p51[k] * xk, a52 += p52[k] * xk, a53 += p53[k] * xk, a54 += p54[k] * xk,
-                            a55 += p55[k] * xk;
-                        a60 += p60[k] * xk, a61 += p61[k] * xk, a62 += p62[k] * xk, a63 += p63[k] * xk, a64 += p64[k] * xk,
-                            a65 += p65[k] * xk, a66 += p66[k] * xk;
-                        a70 += p70[k] * xk, a71 += p71[k] * xk, a72 += p72[k] * xk, a73 += p73[k] * xk, a74 += p74[k] * xk,
-                            a75 += p75[k] * xk, a76 += p76[k] * xk, a77 += p77[k] * xk;
+                        a00 = a_line[0][b];
+                        a10 = a_line[8][b], a11 = a_line[9][b];
+                        a20 = a_line[16][b], a21 = a_line[17][b], a22 = a_line[18][b];
+                        a30 = a_line[24][b], a31 = a_line[25][b], a32 = a_line[26][b], a33 = a_line[27][b];
+                        a40 = a_line[32][b], a41 = a_line[33][b], a42 = a_line[34][b], a43 = a_line[35][b], a44 = a_line[36][b];
+                        a50 = a_line[40][b], a51 = a_line[41][b], a52 = a_line[42][b], a53 = a_line[43][b], a54 = a_line[44][b],
+                            a55 = a_line[45][b];
+                        a60 = a_line[48][b], a61 = a_line[49][b], a62 = a_line[50][b], a63 = a_line[51][b], a64 = a_line[52][b],
+                            a65 = a_line[53][b], a66 = a_line[54][b];
+                        a70 = a_line[56][b], a71 = a_line[57][b], a72 = a_line[58][b], a73 = a_line[59][b], a74 = a_line[60][b],
+                            a75 = a_line[61][b], a76 = a_line[62][b], a77 = a_line[63][b];
                      }
                      else
                      {
-                        a00 += p00[k] * xk, a01 += p01[k] * xk, a02 += p02[k] * xk, a03 += p03[k] * xk, a04 += p04[k] * xk,
-                            a05 += p05[k] * xk, a06 += p06[k] * xk, a07 += p07[k] * xk;
-                        a10 += p10[k] * xk, a11 += p11[k] * xk, a12 += p12[k] * xk, a13 += p13[k] * xk, a14 += p14[k] * xk,
-                            a15 += p15[k] * xk, a16 += p16[k] * xk, a17 += p17[k] * xk;
-                        a20 += p20[k] * xk, a21 += p21[k] * xk, a22 += p22[k] * xk, a23 += p23[k] * xk, a24 += p24[k] * xk,
-                            a25 += p25[k] * xk, a26 += p26[k] * xk, a27 += p27[k] * xk;
-                        a30 += p30[k] * xk, a31 += p31[k] * xk, a32 += p32[k] * xk, a33 += p33[k] * xk, a34 += p34[k] * xk,
-                            a35 += p35[k] * xk, a36 += p36[k] * xk, a37 += p37[k] * xk;
-                        a40 += p40[k] * xk, a41 += p41[k] * xk, a42 += p42[k] * xk, a43 += p43[k] * xk, a44 += p44[k] * xk,
-                            a45 += p45[k] * xk, a46 += p46[k] * xk, a47 += p47[k] * xk;
-                        a50 += p50[k] * xk, a51 += p51[k] * xk, a52 += p52[k] * xk, a53 += p53[k] * xk, a54 += p54[k] * xk,
-                            a55 += p55[k] * xk, a56 += p56[k] * xk, a57 += p57[k] * xk;
-                        a60 += p60[k] * xk, a61 += p61[k] * xk, a62 += p62[k] * xk, a63 += p63[k] * xk, a64 += p64[k] * xk,
-                            a65 += p65[k] * xk, a66 += p66[k] * xk, a67 += p67[k] * xk;
-                        a70 += p70[k] * xk, a71 += p71[k] * xk, a72 += p72[k] * xk, a73 += p73[k] * xk, a74 += p74[k] * xk,
-                            a75 += p75[k] * xk, a76 += p76[k] * xk, a77 += p77[k] * xk;
+                        a00 = a_line[0][b], a01 = a_line[1][b], a02 = a_line[2][b], a03 = a_line[3][b],
+                            a04 = a_line[4][b], a05 = a_line[5][b], a06 = a_line[6][b], a07 = a_line[7][b];
+                        a10 = a_line[8][b], a11 = a_line[9][b], a12 = a_line[10][b], a13 = a_line[11][b],
+                            a14 = a_line[12][b], a15 = a_line[13][b], a16 = a_line[14][b], a17 = a_line[15][b];
+                        a20 = a_line[16][b], a21 = a_line[17][b], a22 = a_line[18][b], a23 = a_line[19][b],
+                            a24 = a_line[20][b], a25 = a_line[21][b], a26 = a_line[22][b], a27 = a_line[23][b];
+                        a30 = a_line[24][b], a31 = a_line[25][b], a32 = a_line[26][b], a33 = a_line[27][b],
+                            a34 = a_line[28][b], a35 = a_line[29][b], a36 = a_line[30][b], a37 = a_line[31][b];
+                        a40 = a_line[32][b], a41 = a_line[33][b], a42 = a_line[34][b], a43 = a_line[35][b],
+                            a44 = a_line[36][b], a45 = a_line[37][b], a46 = a_line[38][b], a47 = a_line[39][b];
+                        a50 = a_line[40][b], a51 = a_line[41][b], a52 = a_line[42][b], a53 = a_line[43][b],
+                            a54 = a_line[44][b], a55 = a_line[45][b], a56 = a_line[46][b], a57 = a_line[47][b];
+                        a60 = a_line[48][b], a61 = a_line[49][b], a62 = a_line[50][b], a63 = a_line[51][b],
+                            a64 = a_line[52][b], a65 = a_line[53][b], a66 = a_line[54][b], a67 = a_line[55][b];
+                        a70 = a_line[56][b], a71 = a_line[57][b], a72 = a_line[58][b], a73 = a_line[59][b],
+                            a74 = a_line[60][b], a75 = a_line[61][b], a76 = a_line[62][b], a77 = a_line[63][b];
+                     }
+                     if constexpr ( Symmetric )
+                     {
+                        a01 = a10, a02 = a20, a03 = a30, a04 = a40, a05 = a50, a06 = a60, a07 = a70;
+                        /*      */ a12 = a21, a13 = a31, a14 = a41, a15 = a51, a16 = a61, a17 = a71;
+                        /*                 */ a23 = a32, a24 = a42, a25 = a52, a26 = a62, a27 = a72;
+                        /*                            */ a34 = a43, a35 = a53, a36 = a63, a37 = a73;
+                        /*                                       */ a45 = a54, a46 = a64, a47 = a74;
+                        /*                                                  */ a56 = a65, a57 = a75;
+                        /*                                                             */ a67 = a76;
                      }
-                  }
-                  if constexpr ( Symmetric )
-                  {
-                     a01 = a10, a02 = a20, a03 = a30, a04 = a40, a05 = a50, a06 = a60, a07 = a70;
-                     /*      */ a12 = a21, a13 = a31, a14 = a41, a15 = a51, a16 = a61, a17 = a71;
-                     /*                 */ a23 = a32, a24 = a42, a25 = a52, a26 = a62, a27 = a72;
-                     /*                            */ a34 = a43, a35 = a53, a36 = a63, a37 = a73;
-                     /*                                       */ a45 = a54, a46 = a64, a47 = a74;
-                     /*                                                  */ a56 = a65, a57 = a75;
-                     /*                                                             */ a67 = a76;
-                  }
 
-                  // local matvec w=Av
-                  const auto w0 = a00 * v0 + a01 * v1 + a02 * v2 + a03 * v3 + a04 * v4 + a05 * v5 + a06 * v6 + a07 * v7;
-                  const auto w1 = a10 * v0 + a11 * v1 + a12 * v2 + a13 * v3 + a14 * v4 + a15 * v5 + a16 * v6 + a17 * v7;
-                  const auto w2 = a20 * v0 + a21 * v1 + a22 * v2 + a23 * v3 + a24 * v4 + a25 * v5 + a26 * v6 + a27 * v7;
-                  const auto w3 = a30 * v0 + a31 * v1 + a32 * v2 + a33 * v3 + a34 * v4 + a35 * v5 + a36 * v6 + a37 * v7;
-                  const auto w4 = a40 * v0 + a41 * v1 + a42 * v2 + a43 * v3 + a44 * v4 + a45 * v5 + a46 * v6 + a47 * v7;
-                  const auto w5 = a50 * v0 + a51 * v1 + a52 * v2 + a53 * v3 + a54 * v4 + a55 * v5 + a56 * v6 + a57 * v7;
-                  const auto w6 = a60 * v0 + a61 * v1 + a62 * v2 + a63 * v3 + a64 * v4 + a65 * v5 + a66 * v6 + a67 * v7;
-                  const auto w7 = a70 * v0 + a71 * v1 + a72 * v2 + a73 * v3 + a74 * v4 + a75 * v5 + a76 * v6 + a77 * v7;
-
-                  // write data back into global vector
-                  dstVertexData[g0] += w0;
-                  dstVertexData[g1] += w1;
-                  dstVertexData[g2] += w2;
-                  dstVertexData[g3] += w3;
-                  dstVertexData[g4] += w4;
-                  dstVertexData[g5] += w5;
-                  dstVertexData[g6] += w6;
-                  dstVertexData[g7] += w7;
+                     // local matvec w=Av
+                     const auto w0 = a00 * v0 + a01 * v1 + a02 * v2 + a03 * v3 + a04 * v4 + a05 * v5 + a06 * v6 + a07 * v7;
+                     const auto w1 = a10 * v0 + a11 * v1 + a12 * v2 + a13 * v3 + a14 * v4 + a15 * v5 + a16 * v6 + a17 * v7;
+                     const auto w2 = a20 * v0 + a21 * v1 + a22 * v2 + a23 * v3 + a24 * v4 + a25 * v5 + a26 * v6 + a27 * v7;
+                     const auto w3 = a30 * v0 + a31 * v1 + a32 * v2 + a33 * v3 + a34 * v4 + a35 * v5 + a36 * v6 + a37 * v7;
+                     const auto w4 = a40 * v0 + a41 * v1 + a42 * v2 + a43 * v3 + a44 * v4 + a45 * v5 + a46 * v6 + a47 * v7;
+                     const auto w5 = a50 * v0 + a51 * v1 + a52 * v2 + a53 * v3 + a54 * v4 + a55 * v5 + a56 * v6 + a57 * v7;
+                     const auto w6 = a60 * v0 + a61 * v1 + a62 * v2 + a63 * v3 + a64 * v4 + a65 * v5 + a66 * v6 + a67 * v7;
+                     const auto w7 = a70 * v0 + a71 * v1 + a72 * v2 + a73 * v3 + a74 * v4 + a75 * v5 + a76 * v6 + a77 * v7;
+
+                     // write data back into global vector
+                     dstVertexData[g0] += w0;
+                     dstVertexData[g1] += w1;
+                     dstVertexData[g2] += w2;
+                     dstVertexData[g3] += w3;
+                     dstVertexData[g4] += w4;
+                     dstVertexData[g5] += w5;
+                     dstVertexData[g6] += w6;
+                     dstVertexData[g7] += w7;
+                  }
                }
+               micro.x() = std::max( n_cubes, idx_t( 0 ) );
 
                // remainder: partial cube with missing white-down-element
                if ( micro.x() == n - 2 - micro.z() - micro.y() )
@@ -20,6 +20,12 @@
 
 #include "P2ElementwiseOperator.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <simd/SIMD.h>
+
+#include "core/mpi/Reduce.h"
+
 #include "hyteg/forms/form_hyteg_generated/p2/p2_epsilonvar_affine_q4.hpp"
 #include "hyteg/forms/form_hyteg_generated/p2/p2_linear_form_blending_q7.hpp"
 
@@ -57,6 +63,10 @@ P2ElementwiseOperator< P2Form >::P2ElementwiseOperator( const std::shared_ptr< P
 : Operator( storage, minLevel, maxLevel )
 , form_( form )
 , localElementMatricesPrecomputed_( false )
+, localElementMatricesUpperTriangleOnly_( false )
+, localElementMatricesSinglePrecision_( false )
+, overlapCommunication_( false )
+, vectorizedApply_( true )
 {
    if ( needsInverseDiagEntries )
    {
@@ -106,6 +116,268 @@ void localMatrixVectorMultiply3D( uint_t                 level,
    }
 }
 
+void localMatrixVectorMultiply3DVectorized( uint_t                                                        level,
+                                            const indexing::Index&                                        microCell,
+                                            celldof::CellType                                             cType,
+                                            const real_t* const                                           srcVertexData,
+                                            const real_t* const                                           srcEdgeData,
+                                            real_t* const                                                 dstVertexData,
+                                            real_t* const                                                 dstEdgeData,
+                                            const real_t* const                                           elMatsInterleaved,
+                                            const real_t&                                                 alpha )
+{
+#ifdef WALBERLA_DOUBLE_ACCURACY
+   static_assert( P2ElementwiseSIMDWidth == 4, "walberla::simd::double4_t holds four values." );
+
+   // obtain data indices of dofs associated with the first micro-cell,
+   // the indices of the others are shifted by one per micro-cell
+   std::array< uint_t, 4 > vertexDoFIndices;
+   vertexdof::getVertexDoFDataIndicesFromMicroCell( microCell, cType, level, vertexDoFIndices );
+
+   std::array< uint_t, 6 > edgeDoFIndices;
+   edgedof::getEdgeDoFDataIndicesFromMicroCellFEniCSOrdering( microCell, cType, level, edgeDoFIndices );
+
+   const real_t* srcPtr[10];
+   real_t*       dstPtr[10];
+   for ( uint_t k = 0; k < 4; ++k )
+   {
+      srcPtr[k] = srcVertexData + vertexDoFIndices[k];
+      dstPtr[k] = dstVertexData + vertexDoFIndices[k];
+   }
+   for ( uint_t k = 4; k < 10; ++k )
+   {
+      srcPtr[k] = srcEdgeData + edgeDoFIndices[k - 4];
+      dstPtr[k] = dstEdgeData + edgeDoFIndices[k - 4];
+   }
+
+   // assemble local element vectors, lane l holds the values of micro-cell l
+   walberla::simd::double4_t elVecOld[10];
+   for ( uint_t k = 0; k < 10; ++k )
+   {
+      elVecOld[k] = walberla::simd::load_unaligned( srcPtr[k] );
+   }
+
+   // walberla::simd only provides aligned stores, so we need this auxiliary memory for the scatter
+   alignas( 32 ) real_t aux[4];
+
+   const auto alphaVec = walberla::simd::make_double4( alpha );
+
+   for ( uint_t i = 0; i < 10; ++i )
+   {
+      // apply matrices, the entries (i, j) of all lanes are stored contiguously
+      walberla::simd::double4_t elVecNew = walberla::simd::make_zero();
+      for ( uint_t j = 0; j < 10; ++j )
+      {
+         elVecNew = elVecNew + walberla::simd::load_aligned( elMatsInterleaved + ( 10 * i + j ) * 4 ) * elVecOld[j];
+      }
+
+      // redistribute result from "local" to "global vector"
+      //
+      // The dst DoF of one local index is distinct for all lanes, so the lanes can be updated at once. Different local
+      // indices may however refer to the same dst DoF for different lanes, therefore the updates are done one local
+      // index after another.
+      const auto dstVec = walberla::simd::load_unaligned( dstPtr[i] ) + alphaVec * elVecNew;
+      walberla::simd::store_aligned( aux, dstVec );
+      std::memcpy( dstPtr[i], aux, sizeof( aux ) );
+   }
+#else
+   Matrix10r elMat;
+   for ( uint_t l = 0; l < P2ElementwiseSIMDWidth; ++l )
+   {
+      for ( uint_t i = 0; i < 10; ++i )
+      {
+         for ( uint_t j = 0; j < 10; ++j )
+         {
+            elMat( i, j ) = elMatsInterleaved[( 10 * i + j ) * P2ElementwiseSIMDWidth + l];
+         }
+      }
+      const indexing::Index micro( microCell.x() + idx_t( l ), microCell.y(), microCell.z() );
+      localMatrixVectorMultiply3D( level, micro, cType, srcVertexData, srcEdgeData, dstVertexData, dstEdgeData, elMat, alpha );
+   }
+#endif
+}
+
+/// Returns true if at least one vertex of the micro-cell lies on the boundary of the macro-cell.
+static inline bool microCellTouchesMacroCellBoundary( uint_t level, const indexing::Index& microCell, celldof::CellType cType )
+{
+   const idx_t maxIdx = idx_t( levelinfo::num_microvertices_per_edge( level ) ) - 1;
+   for ( const auto& v : celldof::macrocell::getMicroVerticesFromMicroCell( microCell, cType ) )
+   {
+      if ( v.x() == 0 || v.y() == 0 || v.z() == 0 || v.x() + v.y() + v.z() == maxIdx )
+      {
+         return true;
+      }
+   }
+   return false;
+}
+
+/// Returns true if at least one vertex of the micro-face lies on the boundary of the macro-face.
+static inline bool microFaceTouchesMacroFaceBoundary( uint_t level, const indexing::Index& microFace, facedof::FaceType fType )
+{
+   const idx_t maxIdx = idx_t( levelinfo::num_microvertices_per_edge( level ) ) - 1;
+   for ( const auto& v : facedof::macroface::getMicroVerticesFromMicroFace( microFace, fType ) )
+   {
+      if ( v.x() == 0 || v.y() == 0 || v.x() + v.y() == maxIdx )
+      {
+         return true;
+      }
+   }
+   return false;
+}
+
+template < class P2Form >
+void P2ElementwiseOperator< P2Form >::applyMicroCells( const real_t&               alpha,
+                                                       Cell&                       cell,
+                                                       const P2Function< real_t >& src,
+                                                       const P2Function< real_t >& dst,
+                                                       uint_t                      level,
+                                                       MicroElementSelection       selection ) const
+{
+   real_t* srcVertexData = cell.getData( src.getVertexDoFFunction().getCellDataID() )->getPointer( level );
+   real_t* dstVertexData = cell.getData( dst.getVertexDoFFunction().getCellDataID() )->getPointer( level );
+
+   real_t* srcEdgeData = cell.getData( src.getEdgeDoFFunction().getCellDataID() )->getPointer( level );
+   real_t* dstEdgeData = cell.getData( dst.getEdgeDoFFunction().getCellDataID() )->getPointer( level );
+
+   const auto isSelected = [level, selection]( const indexing::Index& micro, celldof::CellType cType ) {
+      return selection == MicroElementSelection::ALL ||
+             microCellTouchesMacroCellBoundary( level, micro, cType ) == ( selection == MicroElementSelection::BOUNDARY );
+   };
+
+   // returns the precomputed element matrix or assembles it into the passed buffer
+   const auto elementMatrix = [&]( const indexing::Index& micro,
+                                   celldof::CellType      cType,
+                                   Matrix10r&             buffer ) -> const Matrix10r& {
+      if ( localElementMatricesPrecomputed_ )
+      {
+         return precomputedLocalElementMatrix3D( cell, level, micro, cType, buffer );
+      }
+      assembleLocalElementMatrix3D( cell, level, micro, cType, form_, buffer );
+      return buffer;
+   };
+
+   Matrix10r elMatBuffer = Matrix10r::Zero();
+
+   // element matrices of a batch in lane-interleaved layout, see localMatrixVectorMultiply3DVectorized()
+   alignas( 32 ) real_t elMatsInterleaved[100 * P2ElementwiseSIMDWidth];
+
+   // loop over micro-cells
+   //
+   // The micro-cells of one type are traversed row by row (in x-direction). Batches of P2ElementwiseSIMDWidth
+   // consecutive micro-cells of a row are processed at once, the remainder of the row one by one.
+   for ( const auto& cType : celldof::allCellTypes )
+   {
+      const idx_t numCellsPerRow = idx_t( celldof::macrocell::numCellsPerRowByType( level, cType ) );
+      const idx_t simdWidth      = idx_t( P2ElementwiseSIMDWidth );
+
+      for ( idx_t z = 0; z < numCellsPerRow; ++z )
+      {
+         for ( idx_t y = 0; y < numCellsPerRow - z; ++y )
+         {
+            const idx_t rowLength = numCellsPerRow - z - y;
+
+            idx_t x = 0;
+            while ( x < rowLength )
+            {
+               const indexing::Index micro( x, y, z );
+
+               if ( !isSelected( micro, cType ) )
+               {
+                  ++x;
+                  continue;
+               }
+
+               bool fullBatch = vectorizedApply_ && x + simdWidth <= rowLength;
+               for ( idx_t l = 1; fullBatch && l < simdWidth; ++l )
+               {
+                  fullBatch = isSelected( indexing::Index( x + l, y, z ), cType );
+               }
+
+               if ( fullBatch )
+               {
+                  for ( uint_t l = 0; l < P2ElementwiseSIMDWidth; ++l )
+                  {
+                     const Matrix10r& elMat = elementMatrix( indexing::Index( x + idx_t( l ), y, z ), cType, elMatBuffer );
+                     for ( uint_t i = 0; i < 10; ++i )
+                     {
+                        for ( uint_t j = 0; j < 10; ++j )
+                        {
+                           elMatsInterleaved[( 10 * i + j ) * P2ElementwiseSIMDWidth + l] = elMat( i, j );
+                        }
+                     }
+                  }
+                  localMatrixVectorMultiply3DVectorized(
+                      level, micro, cType, srcVertexData, srcEdgeData, dstVertexData, dstEdgeData, elMatsInterleaved, alpha );
+                  x += simdWidth;
+               }
+               else
+               {
+                  localMatrixVectorMultiply3D( level,
+                                               micro,
+                                               cType,
+                                               srcVertexData,
+                                               srcEdgeData,
+                                               dstVertexData,
+                                               dstEdgeData,
+                                               elementMatrix( micro, cType, elMatBuffer ),
+                                               alpha );
+                  ++x;
+               }
+            }
+         }
+      }
+   }
+}
+
+template < class P2Form >
+void P2ElementwiseOperator< P2Form >::applyMicroFaces( const real_t&               alpha,
+                                                       Face&                       face,
+                                                       const P2Function< real_t >& src,
+                                                       const P2Function< real_t >& dst,
+                                                       uint_t                      level,
+                                                       MicroElementSelection       selection ) const
+{
+   real_t* srcVertexData = face.getData( src.getVertexDoFFunction().getFaceDataID() )->getPointer( level );
+   real_t* dstVertexData = face.getData( dst.getVertexDoFFunction().getFaceDataID() )->getPointer( level );
+
+   real_t* srcEdgeData = face.getData( src.getEdgeDoFFunction().getFaceDataID() )->getPointer( level );
+   real_t* dstEdgeData = face.getData( dst.getEdgeDoFFunction().getFaceDataID() )->getPointer( level );
+
+   Matrix6r elMat = Matrix6r::Zero();
+
+   // loop over micro-faces
+   for ( const auto& fType : facedof::allFaceTypes )
+   {
+      for ( const auto& micro : facedof::macroface::Iterator( level, fType, 0 ) )
+      {
+         if ( selection != MicroElementSelection::ALL &&
+              microFaceTouchesMacroFaceBoundary( level, micro, fType ) != ( selection == MicroElementSelection::BOUNDARY ) )
+         {
+            continue;
+         }
+
+         if ( localElementMatricesPrecomputed_ )
+         {
+            localMatrixVectorMultiply2D( level,
+                                         micro,
+                                         fType,
+                                         srcVertexData,
+                                         srcEdgeData,
+                                         dstVertexData,
+                                         dstEdgeData,
+                                         precomputedLocalElementMatrix2D( face, level, micro, fType, elMat ),
+                                         alpha );
+         }
+         else
+         {
+            assembleLocalElementMatrix2D( face, level, micro, fType, form_, elMat );
+            localMatrixVectorMultiply2D(
+                level, micro, fType, srcVertexData, srcEdgeData, dstVertexData, dstEdgeData, elMat, alpha );
+         }
+      }
+   }
+}
+
 template < class P2Form >
 void P2ElementwiseOperator< P2Form >::gemv( const real_t&               alpha,
                                             const P2Function< real_t >& src,
@@ -118,20 +390,42 @@ void P2ElementwiseOperator< P2Form >::gemv( const real_t&               alpha,
 
    this->startTiming( "apply" );
 
+   // Micro-elements in the interior of the macro-primitives are processed while the halo exchange is in progress
+   // if communication is overlapped.
+   const auto interiorSelection = overlapCommunication_ ? MicroElementSelection::INTERIOR : MicroElementSelection::ALL;
+
    this->storage_->getTimingTree()->start( "sync source communication" );
    // Make sure that halos are up-to-date
    if ( this->storage_->hasGlobalCells() )
    {
       // Note that the order of communication is important, since the face -> cell communication may overwrite
       // parts of the halos that carry the macro-vertex and macro-edge unknowns.
+      //
+      // The direct (process-local) part of a communication is executed when it is started. So only the face -> cell
+      // communication may be left in flight, the others are completed after it finished.
 
-      src.communicate< Face, Cell >( level );
-      src.communicate< Edge, Cell >( level );
-      src.communicate< Vertex, Cell >( level );
+      if ( overlapCommunication_ )
+      {
+         src.startCommunication< Face, Cell >( level );
+      }
+      else
+      {
+         src.communicate< Face, Cell >( level );
+         src.communicate< Edge, Cell >( level );
+         src.communicate< Vertex, Cell >( level );
+      }
    }
    else
    {
-      communication::syncFunctionBetweenPrimitives( src, level );
+      if ( overlapCommunication_ )
+      {
+         src.communicate< Vertex, Edge >( level );
+         src.startCommunication< Edge, Face >( level );
+      }
+      else
+      {
+         communication::syncFunctionBetweenPrimitives( src, level );
+      }
    }
    this->storage_->getTimingTree()->stop( "sync source communication" );
 
@@ -161,18 +455,8 @@ void P2ElementwiseOperator< P2Form >::gemv( const real_t&               alpha,
       {
          Cell& cell = *macroIter.second;
 
-         // get hold of the actual numerical data in the two functions
-         PrimitiveDataID< FunctionMemory< real_t >, Cell > dstVertexDoFIdx = dst.getVertexDoFFunction().getCellDataID();
-         PrimitiveDataID< FunctionMemory< real_t >, Cell > srcVertexDoFIdx = src.getVertexDoFFunction().getCellDataID();
-
-         PrimitiveDataID< FunctionMemory< real_t >, Cell > dstEdgeDoFIdx = dst.getEdgeDoFFunction().getCellDataID();
-         PrimitiveDataID< FunctionMemory< real_t >, Cell > srcEdgeDoFIdx = src.getEdgeDoFFunction().getCellDataID();
-
-         real_t* srcVertexData = cell.getData( srcVertexDoFIdx )->getPointer( level );
-         real_t* dstVertexData = cell.getData( dstVertexDoFIdx )->getPointer( level );
-
-         real_t* srcEdgeData = cell.getData( srcEdgeDoFIdx )->getPointer( level );
-         real_t* dstEdgeData = cell.getData( dstEdgeDoFIdx )->getPointer( level );
+         real_t* dstVertexData = cell.getData( dst.getVertexDoFFunction().getCellDataID() )->getPointer( level );
+         real_t* dstEdgeData   = cell.getData( dst.getEdgeDoFFunction().getCellDataID() )->getPointer( level );
 
          // Zero out dst halos only
          //
@@ -200,25 +484,20 @@ void P2ElementwiseOperator< P2Form >::gemv( const real_t&               alpha,
             }
          }
 
-         Matrix10r elMat = Matrix10r::Zero();
+         applyMicroCells( alpha, cell, src, dst, level, interiorSelection );
+      }
 
-         // loop over micro-cells
-         for ( const auto& cType : celldof::allCellTypes )
-         {
-            for ( const auto& micro : celldof::macrocell::Iterator( level, cType, 0 ) )
-            {
-               if ( localElementMatricesPrecomputed_ )
-               {
-                  elMat = localElementMatrix3D( cell, level, micro, cType );
-               }
-               else
-               {
-                  assembleLocalElementMatrix3D( cell, level, micro, cType, form_, elMat );
-               }
+      if ( overlapCommunication_ )
+      {
+         this->storage_->getTimingTree()->start( "sync source communication" );
+         src.endCommunication< Face, Cell >( level );
+         src.communicate< Edge, Cell >( level );
+         src.communicate< Vertex, Cell >( level );
+         this->storage_->getTimingTree()->stop( "sync source communication" );
 
-               localMatrixVectorMultiply3D(
-                   level, micro, cType, srcVertexData, srcEdgeData, dstVertexData, dstEdgeData, elMat, alpha );
-            }
+         for ( auto& macroIter : storage_->getCells() )
+         {
+            applyMicroCells( alpha, *macroIter.second, src, dst, level, MicroElementSelection::BOUNDARY );
          }
       }
 
@@ -242,135 +521,734 @@ void P2ElementwiseOperator< P2Form >::gemv( const real_t&               alpha,
       {
          Face& face = *it.second;
 
-         Point3D         v0, v1, v2;
-         indexing::Index nodeIdx;
-         indexing::Index offset;
+         real_t* dstVertexData = face.getData( dst.getVertexDoFFunction().getFaceDataID() )->getPointer( level );
+         real_t* dstEdgeData   = face.getData( dst.getEdgeDoFFunction().getFaceDataID() )->getPointer( level );
 
-         // get hold of the actual numerical data in the two functions
-         PrimitiveDataID< FunctionMemory< real_t >, Face > dstVertexDoFIdx = dst.getVertexDoFFunction().getFaceDataID();
-         PrimitiveDataID< FunctionMemory< real_t >, Face > srcVertexDoFIdx = src.getVertexDoFFunction().getFaceDataID();
+         // Zero out dst halos only
+         //
+         // This is also necessary when using update type == Add.
+         // During additive comm we then skip zeroing the data on the lower-dim primitives.
+
+         for ( const auto& idx : vertexdof::macroface::Iterator( level ) )
+         {
+            if ( vertexdof::macroface::isVertexOnBoundary( level, idx ) )
+            {
+               auto arrayIdx           = vertexdof::macroface::index( level, idx.x(), idx.y() );
+               dstVertexData[arrayIdx] = real_c( 0 );
+            }
+         }
+
+         for ( const auto& idx : edgedof::macroface::Iterator( level ) )
+         {
+            for ( const auto& orientation : edgedof::faceLocalEdgeDoFOrientations )
+            {
+               if ( !edgedof::macroface::isInnerEdgeDoF( level, idx, orientation ) )
+               {
+                  auto arrayIdx         = edgedof::macroface::index( level, idx.x(), idx.y(), orientation );
+                  dstEdgeData[arrayIdx] = real_c( 0 );
+               }
+            }
+         }
+
+         applyMicroFaces( alpha, face, src, dst, level, interiorSelection );
+      }
+
+      if ( overlapCommunication_ )
+      {
+         this->storage_->getTimingTree()->start( "sync source communication" );
+         src.endCommunication< Edge, Face >( level );
+         this->storage_->getTimingTree()->stop( "sync source communication" );
+
+         for ( auto& it : storage_->getFaces() )
+         {
+            applyMicroFaces( alpha, *it.second, src, dst, level, MicroElementSelection::BOUNDARY );
+         }
+      }
+
+      // Push result to lower-dimensional primitives
+      //
+      // Note: We could avoid communication here by implementing the apply() also for the respective
+      //       lower dimensional primitives!
+      dst.getVertexDoFFunction().communicateAdditively< Face, Edge >( level, DoFType::All ^ flag, *storage_, betaIsZero );
+      dst.getVertexDoFFunction().communicateAdditively< Face, Vertex >( level, DoFType::All ^ flag, *storage_, betaIsZero );
+      dst.getEdgeDoFFunction().communicateAdditively< Face, Edge >( level, DoFType::All ^ flag, *storage_, betaIsZero );
+   }
+
+   this->stopTiming( "apply" );
+}
+
+template < class P2Form >
+void P2ElementwiseOperator< P2Form >::apply( const P2Function< real_t >& src,
+                                             const P2Function< real_t >& dst,
+                                             uint_t                      level,
+                                             DoFType                     flag,
+                                             UpdateType                  updateType ) const
+{
+   return gemv( real_c( 1 ), src, ( updateType == Replace ? real_c( 0 ) : real_c( 1 ) ), dst, level, flag );
+}
+
+template < class P2Form >
+void P2ElementwiseOperator< P2Form >::applyScaled( const real_t&               alpha,
+                                                   const P2Function< real_t >& src,
+                                                   const P2Function< real_t >& dst,
+                                                   uint_t                      level,
+                                                   DoFType                     flag,
+                                                   UpdateType                  updateType ) const
+{
+   return gemv( alpha, src, ( updateType == Replace ? real_c( 0 ) : real_c( 1 ) ), dst, level, flag );
+}
+
+template < class P2Form >
+void P2ElementwiseOperator< P2Form >::smooth_jac_scaled( const real_t&               alpha,
+                                                         const P2Function< real_t >& dst,
+                                                         const P2Function< real_t >& rhs,
+                                                         const P2Function< real_t >& src,
+                                                         real_t                      omega,
+                                                         size_t                      level,
+                                                         DoFType                     flag ) const
+{
+   this->startTiming( "smooth_jac" );
+
+   // compute the current residual
+   this->applyScaled( alpha, src, dst, level, flag );
+   dst.assign( { real_c( 1 ), real_c( -1 ) }, { rhs, dst }, level, flag );
+
+   // perform Jacobi update step
+   dst.multElementwise( { *getInverseDiagonalValues(), dst }, level, flag );
+   dst.assign( { 1.0, omega }, { src, dst }, level, flag );
+
+   this->stopTiming( "smooth_jac" );
+}
+
+template < class P2Form >
+void P2ElementwiseOperator< P2Form >::smooth_jac( const P2Function< real_t >& dst,
+                                                  const P2Function< real_t >& rhs,
+                                                  const P2Function< real_t >& src,
+                                                  real_t                      omega,
+                                                  size_t                      level,
+                                                  DoFType                     flag ) const
+{
+   smooth_jac_scaled( real_c( 1 ), dst, rhs, src, omega, level, flag );
+}
+
+/// Multicolour ordering of the DoFs in the interior of a macro-primitive for the SOR smoother.
+///
+/// The colour of a DoF is given by its type (vertex DoF or edge DoF of a certain orientation) and the parity of each
+/// component of its logical index. Two DoFs of the same type that belong to a common micro-element differ by at most
+/// one in each component, so DoFs of the same colour are never coupled. Since the colours of the local DoFs of a
+/// micro-element only depend on the element type and the parity of the element index, they are tabulated here as
+/// bit masks of the local DoFs (FEniCS ordering) per colour, element type and parity.
+struct SORColouring
+{
+   /// 8 parity classes for the vertex DoFs and each of the 7 edge DoF orientations
+   static constexpr uint_t numColours = 64;
+
+   /// colours that contain DoFs, in ascending order
+   std::vector< uint_t > colours;
+
+   /// localDoFMasks[colour][elementType][parity]
+   std::array< std::array< std::array< uint_t, 8 >, 6 >, numColours > localDoFMasks{};
+};
+
+static inline uint_t parityOfIndex( const indexing::Index& idx )
+{
+   return uint_c( ( idx.x() & 1 ) + 2 * ( idx.y() & 1 ) + 4 * ( idx.z() & 1 ) );
+}
+
+static inline uint_t colourOfEdgeDoF( const indexing::Index& vertexIdx0, const indexing::Index& vertexIdx1 )
+{
+   const auto orientation = edgedof::calcEdgeDoFOrientation( vertexIdx0, vertexIdx1 );
+   const auto orientationIdx =
+       std::find( edgedof::allEdgeDoFOrientations.begin(), edgedof::allEdgeDoFOrientations.end(), orientation ) -
+       edgedof::allEdgeDoFOrientations.begin();
+   return 8 * ( 1 + uint_c( orientationIdx ) ) + parityOfIndex( edgedof::calcEdgeDoFIndex( vertexIdx0, vertexIdx1 ) );
+}
+
+/// Builds the colouring from the micro-elements of the passed types, getMicroVertices( microIndex, type ) returns
+/// the micro-vertices of an element.
+template < typename ElementType, uint_t NumVertices, uint_t NumEdges, uint_t NumTypes, typename GetMicroVertices >
+static SORColouring buildSORColouring( const std::array< ElementType, NumTypes >&                  elementTypes,
+                                       const std::array< std::pair< uint_t, uint_t >, NumEdges >& edgeVertices,
+                                       uint_t                                                      numParities,
+                                       GetMicroVertices                                            getMicroVertices )
+{
+   SORColouring colouring;
+
+   for ( uint_t t = 0; t < NumTypes; ++t )
+   {
+      for ( uint_t parity = 0; parity < numParities; ++parity )
+      {
+         const indexing::Index micro( idx_t( parity & 1 ), idx_t( ( parity >> 1 ) & 1 ), idx_t( ( parity >> 2 ) & 1 ) );
+         const std::array< indexing::Index, NumVertices > verts = getMicroVertices( micro, elementTypes[t] );
+
+         for ( uint_t k = 0; k < NumVertices; ++k )
+         {
+            colouring.localDoFMasks[parityOfIndex( verts[k] )][t][parity] |= uint_c( 1 ) << k;
+         }
+         for ( uint_t k = 0; k < NumEdges; ++k )
+         {
+            const uint_t colour = colourOfEdgeDoF( verts[edgeVertices[k].first], verts[edgeVertices[k].second] );
+            colouring.localDoFMasks[colour][t][parity] |= uint_c( 1 ) << ( NumVertices + k );
+         }
+      }
+   }
+
+   for ( uint_t colour = 0; colour < SORColouring::numColours; ++colour )
+   {
+      for ( uint_t t = 0; t < NumTypes; ++t )
+      {
+         if ( std::any_of( colouring.localDoFMasks[colour][t].begin(),
+                           colouring.localDoFMasks[colour][t].end(),
+                           []( uint_t mask ) { return mask != 0; } ) )
+         {
+            colouring.colours.push_back( colour );
+            break;
+         }
+      }
+   }
+
+   return colouring;
+}
+
+static const SORColouring& sorColouring3D()
+{
+   static const SORColouring colouring = buildSORColouring< celldof::CellType, 4, 6 >(
+       celldof::allCellTypes,
+       std::array< std::pair< uint_t, uint_t >, 6 >{
+           { { 2, 3 }, { 1, 3 }, { 1, 2 }, { 0, 3 }, { 0, 2 }, { 0, 1 } } },
+       8,
+       []( const indexing::Index& micro, celldof::CellType cType ) {
+          return celldof::macrocell::getMicroVerticesFromMicroCell( micro, cType );
+       } );
+   return colouring;
+}
+
+static const SORColouring& sorColouring2D()
+{
+   static const SORColouring colouring = buildSORColouring< facedof::FaceType, 3, 3 >(
+       facedof::allFaceTypes,
+       std::array< std::pair< uint_t, uint_t >, 3 >{ { { 1, 2 }, { 0, 2 }, { 0, 1 } } },
+       4,
+       []( const indexing::Index& micro, facedof::FaceType fType ) {
+          return facedof::macroface::getMicroVerticesFromMicroFace( micro, fType );
+       } );
+   return colouring;
+}
+
+template < class P2Form >
+void P2ElementwiseOperator< P2Form >::smooth_sor( const P2Function< real_t >& dst,
+                                                  const P2Function< real_t >& rhs,
+                                                  real_t                      relax,
+                                                  uint_t                      level,
+                                                  DoFType                     flag ) const
+{
+   this->startTiming( "smooth_sor" );
+
+   smoothInterfaceDoFsJacobi( dst, rhs, relax, level, flag );
+
+   if ( storage_->hasGlobalCells() )
+   {
+      std::vector< PrimitiveID > cellIDs = storage_->getCellIDs();
+#ifdef HYTEG_BUILD_WITH_OPENMP
+#pragma omp parallel for default( shared )
+#endif
+      for ( int i = 0; i < int_c( cellIDs.size() ); i++ )
+      {
+         Cell& cell = *storage_->getCell( cellIDs[uint_c( i )] );
+         if ( testFlag( dst.getBoundaryCondition().getBoundaryType( cell.getMeshBoundaryFlag() ), flag ) )
+         {
+            smoothMicroCellsSOR( cell, dst, rhs, relax, level, false );
+         }
+      }
+   }
+   else
+   {
+      std::vector< PrimitiveID > faceIDs = storage_->getFaceIDs();
+#ifdef HYTEG_BUILD_WITH_OPENMP
+#pragma omp parallel for default( shared )
+#endif
+      for ( int i = 0; i < int_c( faceIDs.size() ); i++ )
+      {
+         Face& face = *storage_->getFace( faceIDs[uint_c( i )] );
+         if ( testFlag( dst.getBoundaryCondition().getBoundaryType( face.getMeshBoundaryFlag() ), flag ) )
+         {
+            smoothMicroFacesSOR( face, dst, rhs, relax, level, false );
+         }
+      }
+   }
+
+   this->stopTiming( "smooth_sor" );
+}
+
+template < class P2Form >
+void P2ElementwiseOperator< P2Form >::smooth_sor_backwards( const P2Function< real_t >& dst,
+                                                            const P2Function< real_t >& rhs,
+                                                            real_t                      relax,
+                                                            uint_t                      level,
+                                                            DoFType                     flag ) const
+{
+   this->startTiming( "smooth_sor_backwards" );
+
+   // the interior sweeps read the interface DoFs from the halos
+   communication::syncFunctionBetweenPrimitives( dst, level );
+
+   if ( storage_->hasGlobalCells() )
+   {
+      std::vector< PrimitiveID > cellIDs = storage_->getCellIDs();
+#ifdef HYTEG_BUILD_WITH_OPENMP
+#pragma omp parallel for default( shared )
+#endif
+      for ( int i = 0; i < int_c( cellIDs.size() ); i++ )
+      {
+         Cell& cell = *storage_->getCell( cellIDs[uint_c( i )] );
+         if ( testFlag( dst.getBoundaryCondition().getBoundaryType( cell.getMeshBoundaryFlag() ), flag ) )
+         {
+            smoothMicroCellsSOR( cell, dst, rhs, relax, level, true );
+         }
+      }
+   }
+   else
+   {
+      std::vector< PrimitiveID > faceIDs = storage_->getFaceIDs();
+#ifdef HYTEG_BUILD_WITH_OPENMP
+#pragma omp parallel for default( shared )
+#endif
+      for ( int i = 0; i < int_c( faceIDs.size() ); i++ )
+      {
+         Face& face = *storage_->getFace( faceIDs[uint_c( i )] );
+         if ( testFlag( dst.getBoundaryCondition().getBoundaryType( face.getMeshBoundaryFlag() ), flag ) )
+         {
+            smoothMicroFacesSOR( face, dst, rhs, relax, level, true );
+         }
+      }
+   }
+
+   smoothInterfaceDoFsJacobi( dst, rhs, relax, level, flag );
+
+   this->stopTiming( "smooth_sor_backwards" );
+}
+
+template < class P2Form >
+void P2ElementwiseOperator< P2Form >::smoothInterfaceDoFsJacobi( const P2Function< real_t >& dst,
+                                                                 const P2Function< real_t >& rhs,
+                                                                 real_t                      relax,
+                                                                 uint_t                      level,
+                                                                 DoFType                     flag ) const
+{
+   if ( !inverseL1RowNorms_ )
+   {
+      computeInverseL1RowNorms();
+   }
+   if ( !smoothTmp_ )
+   {
+      smoothTmp_ = std::make_shared< P2Function< real_t > >( "SOR tmp", storage_, minLevel_, maxLevel_ );
+   }
+
+   // scaled residual
+   gemv( real_c( 1 ), dst, real_c( 0 ), *smoothTmp_, level, flag );
+   smoothTmp_->assign( { real_c( 1 ), real_c( -1 ) }, { rhs, *smoothTmp_ }, level, flag );
+   smoothTmp_->multElementwise( { *inverseL1RowNorms_, *smoothTmp_ }, level, flag );
+
+   // the DoFs in the interior of the macro-primitives of highest dimension are not touched here
+   if ( storage_->hasGlobalCells() )
+   {
+      for ( auto& it : storage_->getCells() )
+      {
+         it.second->getData( smoothTmp_->getVertexDoFFunction().getCellDataID() )->setToZero( level );
+         it.second->getData( smoothTmp_->getEdgeDoFFunction().getCellDataID() )->setToZero( level );
+      }
+   }
+   else
+   {
+      for ( auto& it : storage_->getFaces() )
+      {
+         it.second->getData( smoothTmp_->getVertexDoFFunction().getFaceDataID() )->setToZero( level );
+         it.second->getData( smoothTmp_->getEdgeDoFFunction().getFaceDataID() )->setToZero( level );
+      }
+   }
+
+   dst.add( { relax }, { *smoothTmp_ }, level, flag );
+
+   // the interior sweeps read the interface DoFs from the halos
+   communication::syncFunctionBetweenPrimitives( dst, level );
+}
+
+template < class P2Form >
+void P2ElementwiseOperator< P2Form >::smoothMicroCellsSOR( Cell&                       cell,
+                                                           const P2Function< real_t >& dst,
+                                                           const P2Function< real_t >& rhs,
+                                                           real_t                      relax,
+                                                           uint_t                      level,
+                                                           bool                        backwards ) const
+{
+   real_t* dstVertexData = cell.getData( dst.getVertexDoFFunction().getCellDataID() )->getPointer( level );
+   real_t* dstEdgeData   = cell.getData( dst.getEdgeDoFFunction().getCellDataID() )->getPointer( level );
+
+   const real_t* rhsVertexData = cell.getData( rhs.getVertexDoFFunction().getCellDataID() )->getPointer( level );
+   const real_t* rhsEdgeData   = cell.getData( rhs.getEdgeDoFFunction().getCellDataID() )->getPointer( level );
+
+   const auto    invDiag           = getInverseDiagonalValues();
+   const real_t* invDiagVertexData = cell.getData( invDiag->getVertexDoFFunction().getCellDataID() )->getPointer( level );
+   const real_t* invDiagEdgeData   = cell.getData( invDiag->getEdgeDoFFunction().getCellDataID() )->getPointer( level );
+
+   // matrix rows times dst of the DoFs of the current colour
+   std::vector< real_t > vertexRowProducts( cell.getData( dst.getVertexDoFFunction().getCellDataID() )->getSize( level ),
+                                            real_c( 0 ) );
+   std::vector< real_t > edgeRowProducts( cell.getData( dst.getEdgeDoFFunction().getCellDataID() )->getSize( level ),
+                                          real_c( 0 ) );
+
+   const SORColouring& colouring = sorColouring3D();
+
+   Matrix10r               elMatBuffer = Matrix10r::Zero();
+   Point10D                elVec;
+   std::array< uint_t, 4 > vertexDoFIndices;
+   std::array< uint_t, 6 > edgeDoFIndices;
+
+   for ( uint_t c = 0; c < colouring.colours.size(); ++c )
+   {
+      const uint_t colour = colouring.colours[backwards ? colouring.colours.size() - 1 - c : c];
+
+      // accumulate the rows of the DoFs of this colour from all micro-cells that contain such DoFs
+      // (rows of DoFs on the macro-cell boundary are accumulated as well, but not used)
+      for ( uint_t t = 0; t < celldof::allCellTypes.size(); ++t )
+      {
+         const celldof::CellType cType = celldof::allCellTypes[t];
+         for ( const auto& micro : celldof::macrocell::Iterator( level, cType, 0 ) )
+         {
+            const uint_t mask = colouring.localDoFMasks[colour][t][parityOfIndex( micro )];
+            if ( mask == 0 )
+            {
+               continue;
+            }
+
+            vertexdof::getVertexDoFDataIndicesFromMicroCell( micro, cType, level, vertexDoFIndices );
+            edgedof::getEdgeDoFDataIndicesFromMicroCellFEniCSOrdering( micro, cType, level, edgeDoFIndices );
+
+            for ( uint_t k = 0; k < 4; ++k )
+            {
+               elVec[int_c( k )] = dstVertexData[vertexDoFIndices[k]];
+            }
+            for ( uint_t k = 0; k < 6; ++k )
+            {
+               elVec[int_c( 4 + k )] = dstEdgeData[edgeDoFIndices[k]];
+            }
+
+            const Matrix10r* elMat = &elMatBuffer;
+            if ( localElementMatricesPrecomputed_ )
+            {
+               elMat = &precomputedLocalElementMatrix3D( cell, level, micro, cType, elMatBuffer );
+            }
+            else
+            {
+               assembleLocalElementMatrix3D( cell, level, micro, cType, form_, elMatBuffer );
+            }
+
+            for ( uint_t k = 0; k < 10; ++k )
+            {
+               if ( ( mask & ( uint_c( 1 ) << k ) ) == 0 )
+               {
+                  continue;
+               }
+
+               real_t rowProduct = 0;
+               for ( int j = 0; j < 10; ++j )
+               {
+                  rowProduct += ( *elMat )( int_c( k ), j ) * elVec[j];
+               }
+
+               if ( k < 4 )
+               {
+                  vertexRowProducts[vertexDoFIndices[k]] += rowProduct;
+               }
+               else
+               {
+                  edgeRowProducts[edgeDoFIndices[k - 4]] += rowProduct;
+               }
+            }
+         }
+      }
+
+      // relax the inner DoFs of this colour
+      const uint_t parity = colour % 8;
+      if ( colour < 8 )
+      {
+         for ( const auto& idx : vertexdof::macrocell::Iterator( level, 1 ) )
+         {
+            if ( parityOfIndex( idx ) != parity )
+            {
+               continue;
+            }
+            const uint_t arrayIdx = vertexdof::macrocell::index( level, idx.x(), idx.y(), idx.z() );
+            dstVertexData[arrayIdx] +=
+                relax * invDiagVertexData[arrayIdx] * ( rhsVertexData[arrayIdx] - vertexRowProducts[arrayIdx] );
+         }
+      }
+      else
+      {
+         const edgedof::EdgeDoFOrientation orientation = edgedof::allEdgeDoFOrientations[colour / 8 - 1];
+
+         const auto relaxEdgeDoF = [&]( const indexing::Index& idx ) {
+            if ( parityOfIndex( idx ) != parity || !edgedof::macrocell::isInnerEdgeDoF( level, idx, orientation ) )
+            {
+               return;
+            }
+            const uint_t arrayIdx = edgedof::macrocell::index( level, idx.x(), idx.y(), idx.z(), orientation );
+            dstEdgeData[arrayIdx] += relax * invDiagEdgeData[arrayIdx] * ( rhsEdgeData[arrayIdx] - edgeRowProducts[arrayIdx] );
+         };
+
+         if ( orientation == edgedof::EdgeDoFOrientation::XYZ )
+         {
+            for ( const auto& idx : edgedof::macrocell::IteratorXYZ( level, 0 ) )
+            {
+               relaxEdgeDoF( idx );
+            }
+         }
+         else
+         {
+            for ( const auto& idx : edgedof::macrocell::Iterator( level, 0 ) )
+            {
+               relaxEdgeDoF( idx );
+            }
+         }
+      }
+
+      std::fill( vertexRowProducts.begin(), vertexRowProducts.end(), real_c( 0 ) );
+      std::fill( edgeRowProducts.begin(), edgeRowProducts.end(), real_c( 0 ) );
+   }
+}
+
+template < class P2Form >
+void P2ElementwiseOperator< P2Form >::smoothMicroFacesSOR( Face&                       face,
+                                                           const P2Function< real_t >& dst,
+                                                           const P2Function< real_t >& rhs,
+                                                           real_t                      relax,
+                                                           uint_t                      level,
+                                                           bool                        backwards ) const
+{
+   real_t* dstVertexData = face.getData( dst.getVertexDoFFunction().getFaceDataID() )->getPointer( level );
+   real_t* dstEdgeData   = face.getData( dst.getEdgeDoFFunction().getFaceDataID() )->getPointer( level );
+
+   const real_t* rhsVertexData = face.getData( rhs.getVertexDoFFunction().getFaceDataID() )->getPointer( level );
+   const real_t* rhsEdgeData   = face.getData( rhs.getEdgeDoFFunction().getFaceDataID() )->getPointer( level );
+
+   const auto    invDiag           = getInverseDiagonalValues();
+   const real_t* invDiagVertexData = face.getData( invDiag->getVertexDoFFunction().getFaceDataID() )->getPointer( level );
+   const real_t* invDiagEdgeData   = face.getData( invDiag->getEdgeDoFFunction().getFaceDataID() )->getPointer( level );
+
+   // matrix rows times dst of the DoFs of the current colour
+   std::vector< real_t > vertexRowProducts( face.getData( dst.getVertexDoFFunction().getFaceDataID() )->getSize( level ),
+                                            real_c( 0 ) );
+   std::vector< real_t > edgeRowProducts( face.getData( dst.getEdgeDoFFunction().getFaceDataID() )->getSize( level ),
+                                          real_c( 0 ) );
+
+   const SORColouring& colouring = sorColouring2D();
+
+   Matrix6r                elMatBuffer = Matrix6r::Zero();
+   Point6D                 elVec;
+   std::array< uint_t, 3 > vertexDoFIndices;
+   std::array< uint_t, 3 > edgeDoFIndices;
 
-         PrimitiveDataID< FunctionMemory< real_t >, Face > dstEdgeDoFIdx = dst.getEdgeDoFFunction().getFaceDataID();
-         PrimitiveDataID< FunctionMemory< real_t >, Face > srcEdgeDoFIdx = src.getEdgeDoFFunction().getFaceDataID();
+   for ( uint_t c = 0; c < colouring.colours.size(); ++c )
+   {
+      const uint_t colour = colouring.colours[backwards ? colouring.colours.size() - 1 - c : c];
 
-         real_t* srcVertexData = face.getData( srcVertexDoFIdx )->getPointer( level );
-         real_t* dstVertexData = face.getData( dstVertexDoFIdx )->getPointer( level );
+      // accumulate the rows of the DoFs of this colour from all micro-faces that contain such DoFs
+      // (rows of DoFs on the macro-face boundary are accumulated as well, but not used)
+      for ( uint_t t = 0; t < facedof::allFaceTypes.size(); ++t )
+      {
+         const facedof::FaceType fType = facedof::allFaceTypes[t];
+         for ( const auto& micro : facedof::macroface::Iterator( level, fType, 0 ) )
+         {
+            const uint_t mask = colouring.localDoFMasks[colour][t][parityOfIndex( micro )];
+            if ( mask == 0 )
+            {
+               continue;
+            }
 
-         real_t* srcEdgeData = face.getData( srcEdgeDoFIdx )->getPointer( level );
-         real_t* dstEdgeData = face.getData( dstEdgeDoFIdx )->getPointer( level );
+            vertexdof::getVertexDoFDataIndicesFromMicroFace( micro, fType, level, vertexDoFIndices );
+            edgedof::getEdgeDoFDataIndicesFromMicroFaceFEniCSOrdering( micro, fType, level, edgeDoFIndices );
 
-         // Zero out dst halos only
-         //
-         // This is also necessary when using update type == Add.
-         // During additive comm we then skip zeroing the data on the lower-dim primitives.
+            for ( uint_t k = 0; k < 3; ++k )
+            {
+               elVec[int_c( k )]     = dstVertexData[vertexDoFIndices[k]];
+               elVec[int_c( 3 + k )] = dstEdgeData[edgeDoFIndices[k]];
+            }
 
-         for ( const auto& idx : vertexdof::macroface::Iterator( level ) )
-         {
-            if ( vertexdof::macroface::isVertexOnBoundary( level, idx ) )
+            const Matrix6r* elMat = &elMatBuffer;
+            if ( localElementMatricesPrecomputed_ )
             {
-               auto arrayIdx           = vertexdof::macroface::index( level, idx.x(), idx.y() );
-               dstVertexData[arrayIdx] = real_c( 0 );
+               elMat = &precomputedLocalElementMatrix2D( face, level, micro, fType, elMatBuffer );
+            }
+            else
+            {
+               assembleLocalElementMatrix2D( face, level, micro, fType, form_, elMatBuffer );
             }
-         }
 
-         for ( const auto& idx : edgedof::macroface::Iterator( level ) )
-         {
-            for ( const auto& orientation : edgedof::faceLocalEdgeDoFOrientations )
+            for ( uint_t k = 0; k < 6; ++k )
             {
-               if ( !edgedof::macroface::isInnerEdgeDoF( level, idx, orientation ) )
+               if ( ( mask & ( uint_c( 1 ) << k ) ) == 0 )
                {
-                  auto arrayIdx         = edgedof::macroface::index( level, idx.x(), idx.y(), orientation );
-                  dstEdgeData[arrayIdx] = real_c( 0 );
+                  continue;
                }
-            }
-         }
 
-         Matrix6r elMat = Matrix6r::Zero();
+               real_t rowProduct = 0;
+               for ( int j = 0; j < 6; ++j )
+               {
+                  rowProduct += ( *elMat )( int_c( k ), j ) * elVec[j];
+               }
 
-         // loop over micro-faces
-         for ( const auto& fType : facedof::allFaceTypes )
-         {
-            for ( const auto& micro : facedof::macroface::Iterator( level, fType, 0 ) )
-            {
-               if ( localElementMatricesPrecomputed_ )
+               if ( k < 3 )
                {
-                  elMat = localElementMatrix2D( face, level, micro, fType );
+                  vertexRowProducts[vertexDoFIndices[k]] += rowProduct;
                }
                else
                {
-                  assembleLocalElementMatrix2D( face, level, micro, fType, form_, elMat );
+                  edgeRowProducts[edgeDoFIndices[k - 3]] += rowProduct;
                }
+            }
+         }
+      }
 
-               localMatrixVectorMultiply2D(
-                   level, micro, fType, srcVertexData, srcEdgeData, dstVertexData, dstEdgeData, elMat, alpha );
+      // relax the inner DoFs of this colour
+      const uint_t parity = colour % 8;
+      if ( colour < 8 )
+      {
+         for ( const auto& idx : vertexdof::macroface::Iterator( level, 1 ) )
+         {
+            if ( parityOfIndex( idx ) != parity )
+            {
+               continue;
+            }
+            const uint_t arrayIdx = vertexdof::macroface::index( level, idx.x(), idx.y() );
+            dstVertexData[arrayIdx] +=
+                relax * invDiagVertexData[arrayIdx] * ( rhsVertexData[arrayIdx] - vertexRowProducts[arrayIdx] );
+         }
+      }
+      else
+      {
+         const edgedof::EdgeDoFOrientation orientation = edgedof::allEdgeDoFOrientations[colour / 8 - 1];
+         for ( const auto& idx : edgedof::macroface::Iterator( level, 0 ) )
+         {
+            if ( parityOfIndex( idx ) != parity || !edgedof::macroface::isInnerEdgeDoF( level, idx, orientation ) )
+            {
+               continue;
             }
+            const uint_t arrayIdx = edgedof::macroface::index( level, idx.x(), idx.y(), orientation );
+            dstEdgeData[arrayIdx] += relax * invDiagEdgeData[arrayIdx] * ( rhsEdgeData[arrayIdx] - edgeRowProducts[arrayIdx] );
          }
       }
 
-      // Push result to lower-dimensional primitives
-      //
-      // Note: We could avoid communication here by implementing the apply() also for the respective
-      //       lower dimensional primitives!
-      dst.getVertexDoFFunction().communicateAdditively< Face, Edge >( level, DoFType::All ^ flag, *storage_, betaIsZero );
-      dst.getVertexDoFFunction().communicateAdditively< Face, Vertex >( level, DoFType::All ^ flag, *storage_, betaIsZero );
-      dst.getEdgeDoFFunction().communicateAdditively< Face, Edge >( level, DoFType::All ^ flag, *storage_, betaIsZero );
+      std::fill( vertexRowProducts.begin(), vertexRowProducts.end(), real_c( 0 ) );
+      std::fill( edgeRowProducts.begin(), edgeRowProducts.end(), real_c( 0 ) );
    }
-
-   this->stopTiming( "apply" );
 }
 
 template < class P2Form >
-void P2ElementwiseOperator< P2Form >::apply( const P2Function< real_t >& src,
-                                             const P2Function< real_t >& dst,
-                                             uint_t                      level,
-                                             DoFType                     flag,
-                                             UpdateType                  updateType ) const
+void P2ElementwiseOperator< P2Form >::computeInverseL1RowNorms() const
 {
-   return gemv( real_c( 1 ), src, ( updateType == Replace ? real_c( 0 ) : real_c( 1 ) ), dst, level, flag );
-}
+   if ( !inverseL1RowNorms_ )
+   {
+      inverseL1RowNorms_ = std::make_shared< P2Function< real_t > >( "inverse l1 row norms", storage_, minLevel_, maxLevel_ );
+   }
 
-template < class P2Form >
-void P2ElementwiseOperator< P2Form >::applyScaled( const real_t&               alpha,
-                                                   const P2Function< real_t >& src,
-                                                   const P2Function< real_t >& dst,
-                                                   uint_t                      level,
-                                                   DoFType                     flag,
-                                                   UpdateType                  updateType ) const
-{
-   return gemv( alpha, src, ( updateType == Replace ? real_c( 0 ) : real_c( 1 ) ), dst, level, flag );
-}
+   for ( uint_t level = minLevel_; level <= maxLevel_; level++ )
+   {
+      inverseL1RowNorms_->setToZero( level );
 
-template < class P2Form >
-void P2ElementwiseOperator< P2Form >::smooth_jac_scaled( const real_t&               alpha,
-                                                         const P2Function< real_t >& dst,
-                                                         const P2Function< real_t >& rhs,
-                                                         const P2Function< real_t >& src,
-                                                         real_t                      omega,
-                                                         size_t                      level,
-                                                         DoFType                     flag ) const
-{
-   this->startTiming( "smooth_jac" );
+      if ( storage_->hasGlobalCells() )
+      {
+         Matrix10r               elMatBuffer = Matrix10r::Zero();
+         std::array< uint_t, 4 > vertexDoFIndices;
+         std::array< uint_t, 6 > edgeDoFIndices;
 
-   // compute the current residual
-   this->applyScaled( alpha, src, dst, level, flag );
-   dst.assign( { real_c( 1 ), real_c( -1 ) }, { rhs, dst }, level, flag );
+         for ( auto& it : storage_->getCells() )
+         {
+            Cell& cell = *it.second;
 
-   // perform Jacobi update step
-   dst.multElementwise( { *getInverseDiagonalValues(), dst }, level, flag );
-   dst.assign( { 1.0, omega }, { src, dst }, level, flag );
+            real_t* vertexData = cell.getData( inverseL1RowNorms_->getVertexDoFFunction().getCellDataID() )->getPointer( level );
+            real_t* edgeData   = cell.getData( inverseL1RowNorms_->getEdgeDoFFunction().getCellDataID() )->getPointer( level );
 
-   this->stopTiming( "smooth_jac" );
-}
+            for ( const auto& cType : celldof::allCellTypes )
+            {
+               for ( const auto& micro : celldof::macrocell::Iterator( level, cType, 0 ) )
+               {
+                  const Matrix10r* elMat = &elMatBuffer;
+                  if ( localElementMatricesPrecomputed_ )
+                  {
+                     elMat = &precomputedLocalElementMatrix3D( cell, level, micro, cType, elMatBuffer );
+                  }
+                  else
+                  {
+                     assembleLocalElementMatrix3D( cell, level, micro, cType, form_, elMatBuffer );
+                  }
+
+                  vertexdof::getVertexDoFDataIndicesFromMicroCell( micro, cType, level, vertexDoFIndices );
+                  edgedof::getEdgeDoFDataIndicesFromMicroCellFEniCSOrdering( micro, cType, level, edgeDoFIndices );
+
+                  for ( int k = 0; k < 4; ++k )
+                  {
+                     vertexData[vertexDoFIndices[uint_c( k )]] += elMat->row( k ).cwiseAbs().sum();
+                  }
+                  for ( int k = 4; k < 10; ++k )
+                  {
+                     edgeData[edgeDoFIndices[uint_c( k - 4 )]] += elMat->row( k ).cwiseAbs().sum();
+                  }
+               }
+            }
+         }
 
-template < class P2Form >
-void P2ElementwiseOperator< P2Form >::smooth_jac( const P2Function< real_t >& dst,
-                                                  const P2Function< real_t >& rhs,
-                                                  const P2Function< real_t >& src,
-                                                  real_t                      omega,
-                                                  size_t                      level,
-                                                  DoFType                     flag ) const
-{
-   smooth_jac_scaled( real_c( 1 ), dst, rhs, src, omega, level, flag );
+         inverseL1RowNorms_->getVertexDoFFunction().communicateAdditively< Cell, Face >( level );
+         inverseL1RowNorms_->getVertexDoFFunction().communicateAdditively< Cell, Edge >( level );
+         inverseL1RowNorms_->getVertexDoFFunction().communicateAdditively< Cell, Vertex >( level );
+         inverseL1RowNorms_->getEdgeDoFFunction().communicateAdditively< Cell, Face >( level );
+         inverseL1RowNorms_->getEdgeDoFFunction().communicateAdditively< Cell, Edge >( level );
+      }
+      else
+      {
+         Matrix6r                elMatBuffer = Matrix6r::Zero();
+         std::array< uint_t, 3 > vertexDoFIndices;
+         std::array< uint_t, 3 > edgeDoFIndices;
+
+         for ( auto& it : storage_->getFaces() )
+         {
+            Face& face = *it.second;
+
+            real_t* vertexData = face.getData( inverseL1RowNorms_->getVertexDoFFunction().getFaceDataID() )->getPointer( level );
+            real_t* edgeData   = face.getData( inverseL1RowNorms_->getEdgeDoFFunction().getFaceDataID() )->getPointer( level );
+
+            for ( const auto& fType : facedof::allFaceTypes )
+            {
+               for ( const auto& micro : facedof::macroface::Iterator( level, fType, 0 ) )
+               {
+                  const Matrix6r* elMat = &elMatBuffer;
+                  if ( localElementMatricesPrecomputed_ )
+                  {
+                     elMat = &precomputedLocalElementMatrix2D( face, level, micro, fType, elMatBuffer );
+                  }
+                  else
+                  {
+                     assembleLocalElementMatrix2D( face, level, micro, fType, form_, elMatBuffer );
+                  }
+
+                  vertexdof::getVertexDoFDataIndicesFromMicroFace( micro, fType, level, vertexDoFIndices );
+                  edgedof::getEdgeDoFDataIndicesFromMicroFaceFEniCSOrdering( micro, fType, level, edgeDoFIndices );
+
+                  for ( int k = 0; k < 3; ++k )
+                  {
+                     vertexData[vertexDoFIndices[uint_c( k )]] += elMat->row( k ).cwiseAbs().sum();
+                     edgeData[edgeDoFIndices[uint_c( k )]] += elMat->row( 3 + k ).cwiseAbs().sum();
+                  }
+               }
+            }
+         }
+
+         inverseL1RowNorms_->getVertexDoFFunction().communicateAdditively< Face, Edge >( level );
+         inverseL1RowNorms_->getVertexDoFFunction().communicateAdditively< Face, Vertex >( level );
+         inverseL1RowNorms_->getEdgeDoFFunction().communicateAdditively< Face, Edge >( level );
+      }
+
+      inverseL1RowNorms_->invertElementwise( level, All, false );
+   }
 }
 
 template < class P2Form >
@@ -419,6 +1297,9 @@ void P2ElementwiseOperator< P2Form >::localMatrixVectorMultiply2D( uint_t
 template < class P2Form >
 void P2ElementwiseOperator< P2Form >::computeDiagonalOperatorValues( bool invert, bool lumped, const real_t& alpha )
 {
+   // the l1 row norms of the SOR smoother are recomputed on demand
+   inverseL1RowNorms_.reset();
+
    std::shared_ptr< P2Function< real_t > > targetFunction;
 
    if ( invert )
@@ -572,35 +1453,135 @@ void P2ElementwiseOperator< P2Form >::computeDiagonalOperatorValues( bool invert
    }
 }
 
+/// Number of entries that are stored per n x n local element matrix.
+static constexpr uint_t numStoredLocalElementMatrixEntries( uint_t n, bool upperTriangleOnly )
+{
+   return upperTriangleOnly ? n * ( n + 1 ) / 2 : n * n;
+}
+
+/// Copies the (upper triangle of the) element matrix row-wise to the passed array.
+template < typename MatrixType, typename StorageType >
+static inline void compressLocalElementMatrix( const MatrixType& elMat, bool upperTriangleOnly, StorageType* const entries )
+{
+   uint_t k = 0;
+   for ( int i = 0; i < elMat.rows(); ++i )
+   {
+      for ( int j = upperTriangleOnly ? i : 0; j < elMat.cols(); ++j )
+      {
+         entries[k++] = static_cast< StorageType >( elMat( i, j ) );
+      }
+   }
+}
+
+/// Inverse of compressLocalElementMatrix().
+template < typename MatrixType, typename StorageType >
+static inline void expandLocalElementMatrix( const StorageType* const entries, bool upperTriangleOnly, MatrixType& elMat )
+{
+   uint_t k = 0;
+   for ( int i = 0; i < elMat.rows(); ++i )
+   {
+      for ( int j = upperTriangleOnly ? i : 0; j < elMat.cols(); ++j )
+      {
+         elMat( i, j ) = static_cast< real_t >( entries[k++] );
+         if ( upperTriangleOnly )
+         {
+            elMat( j, i ) = elMat( i, j );
+         }
+      }
+   }
+}
+
+/// Aborts if the element matrix is not symmetric (up to round-off).
+template < typename MatrixType >
+static inline void checkLocalElementMatrixSymmetry( const MatrixType& elMat )
+{
+   const real_t tolerance = real_c( 100 ) * std::numeric_limits< real_t >::epsilon() * elMat.cwiseAbs().maxCoeff();
+   WALBERLA_CHECK_LESS_EQUAL( ( elMat - elMat.transpose() ).cwiseAbs().maxCoeff(),
+                              tolerance,
+                              "Storing only the upper triangle of the local element matrices requires a symmetric form." );
+}
+
 template < class P2Form >
 void P2ElementwiseOperator< P2Form >::computeAndStoreLocalElementMatrices()
 {
+   computeAndStoreLocalElementMatrices( false, false );
+}
+
+template < class P2Form >
+void P2ElementwiseOperator< P2Form >::computeAndStoreLocalElementMatrices( bool upperTriangleOnly, bool singlePrecision )
+{
+   const bool compressed = upperTriangleOnly || singlePrecision;
+
+   // release the storage of a previously chosen format
+   if ( compressed || localElementMatricesUpperTriangleOnly_ || localElementMatricesSinglePrecision_ )
+   {
+      localElementMatrices2D_.clear();
+      localElementMatrices3D_.clear();
+      compressedLocalElementMatrices_.clear();
+      compressedLocalElementMatricesFloat_.clear();
+   }
+
+   localElementMatricesUpperTriangleOnly_ = upperTriangleOnly;
+   localElementMatricesSinglePrecision_   = singlePrecision;
+
+   // fills the flat array of a macro-primitive, elementIndex( micro, type ) is the position of the micro-element
+   const auto compress = [upperTriangleOnly]( const auto& elMat, auto& entries, uint_t elementIndex ) {
+      if ( upperTriangleOnly )
+      {
+         checkLocalElementMatrixSymmetry( elMat );
+      }
+      const uint_t numEntries = numStoredLocalElementMatrixEntries( uint_c( elMat.rows() ), upperTriangleOnly );
+      compressLocalElementMatrix( elMat, upperTriangleOnly, entries.data() + elementIndex * numEntries );
+   };
+
    for ( uint_t level = minLevel_; level <= maxLevel_; level++ )
    {
       // For 3D we work on cells and for 2D on faces
       if ( storage_->hasGlobalCells() )
       {
          const uint_t numMicroCellsPerMacroCell = celldof::macrocell::numMicroCellsPerMacroCellTotal( level );
+         const uint_t numEntries                = numStoredLocalElementMatrixEntries( 10, upperTriangleOnly );
 
          for ( const auto& it : storage_->getCells() )
          {
             auto cellID = it.first;
             auto cell   = it.second;
 
-            auto& elementMatrices = localElementMatrices3D_[cellID][level];
-
-            if ( !localElementMatricesPrecomputed_ )
+            if ( !compressed )
+            {
+               localElementMatrices3D_[cellID][level].resize( numMicroCellsPerMacroCell );
+            }
+            else if ( singlePrecision )
+            {
+               compressedLocalElementMatricesFloat_[cellID][level].resize( numMicroCellsPerMacroCell * numEntries );
+            }
+            else
             {
-               elementMatrices.resize( numMicroCellsPerMacroCell );
+               compressedLocalElementMatrices_[cellID][level].resize( numMicroCellsPerMacroCell * numEntries );
             }
 
+            Matrix10r elMat;
+
             for ( const auto& cType : celldof::allCellTypes )
             {
                for ( const auto& micro : celldof::macrocell::Iterator( level, cType, 0 ) )
                {
-                  Matrix10r& elMat = localElementMatrix3D( *cell, level, micro, cType );
                   elMat.setZero();
                   assembleLocalElementMatrix3D( *cell, level, micro, cType, form_, elMat );
+
+                  const uint_t elementIndex = celldof::macrocell::index( level, micro.x(), micro.y(), micro.z(), cType );
+                  if ( !compressed )
+                  {
+                     localElementMatrix3D( *cell, level, micro, cType ) = elMat;
+                  }
+                  else if ( singlePrecision )
+                  {
+                     compress( elMat, compressedLocalElementMatricesFloat_[cellID][level], elementIndex );
+                  }
+                  else
+                  {
+                     compress( elMat, compressedLocalElementMatrices_[cellID][level], elementIndex );
+                  }
                }
             }
          }
@@ -608,26 +1589,48 @@ void P2ElementwiseOperator< P2Form >::computeAndStoreLocalElementMatrices()
       else
       {
          const uint_t numMicroFacesPerMacroFace = levelinfo::num_microfaces_per_face( level );
+         const uint_t numEntries                = numStoredLocalElementMatrixEntries( 6, upperTriangleOnly );
 
          for ( const auto& it : storage_->getFaces() )
          {
             auto faceID = it.first;
             auto face   = it.second;
 
-            auto& elementMatrices = localElementMatrices2D_[faceID][level];
-
-            if ( !localElementMatricesPrecomputed_ )
+            if ( !compressed )
+            {
+               localElementMatrices2D_[faceID][level].resize( numMicroFacesPerMacroFace );
+            }
+            else if ( singlePrecision )
             {
-               elementMatrices.resize( numMicroFacesPerMacroFace );
+               compressedLocalElementMatricesFloat_[faceID][level].resize( numMicroFacesPerMacroFace * numEntries );
+            }
+            else
+            {
+               compressedLocalElementMatrices_[faceID][level].resize( numMicroFacesPerMacroFace * numEntries );
             }
 
+            Matrix6r elMat;
+
             for ( const auto& fType : facedof::allFaceTypes )
             {
                for ( const auto& micro : facedof::macroface::Iterator( level, fType, 0 ) )
                {
-                  Matrix6r& elMat = localElementMatrix2D( *face, level, micro, fType );
                   elMat.setZero();
                   assembleLocalElementMatrix2D( *face, level, micro, fType, form_, elMat );
+
+                  const uint_t elementIndex = facedof::macroface::index( level, micro.x(), micro.y(), fType );
+                  if ( !compressed )
+                  {
+                     localElementMatrix2D( *face, level, micro, fType ) = elMat;
+                  }
+                  else if ( singlePrecision )
+                  {
+                     compress( elMat, compressedLocalElementMatricesFloat_[faceID][level], elementIndex );
+                  }
+                  else
+                  {
+                     compress( elMat, compressedLocalElementMatrices_[faceID][level], elementIndex );
+                  }
                }
             }
          }
@@ -635,6 +1638,111 @@ void P2ElementwiseOperator< P2Form >::computeAndStoreLocalElementMatrices()
    }
 
    localElementMatricesPrecomputed_ = true;
+   inverseL1RowNorms_.reset();
+}
+
+template < class P2Form >
+const Matrix10r& P2ElementwiseOperator< P2Form >::precomputedLocalElementMatrix3D( const Cell&            cell,
+                                                                                   uint_t                 level,
+                                                                                   const indexing::Index& microCell,
+                                                                                   celldof::CellType      cType,
+                                                                                   Matrix10r&             buffer ) const
+{
+   if ( !localElementMatricesUpperTriangleOnly_ && !localElementMatricesSinglePrecision_ )
+   {
+      return localElementMatrix3D( cell, level, microCell, cType );
+   }
+
+   const uint_t numEntries   = numStoredLocalElementMatrixEntries( 10, localElementMatricesUpperTriangleOnly_ );
+   const uint_t elementIndex = celldof::macrocell::index( level, microCell.x(), microCell.y(), microCell.z(), cType );
+
+   if ( localElementMatricesSinglePrecision_ )
+   {
+      expandLocalElementMatrix( compressedLocalElementMatricesFloat_.at( cell.getID() ).at( level ).data() +
+                                    elementIndex * numEntries,
+                                localElementMatricesUpperTriangleOnly_,
+                                buffer );
+   }
+   else
+   {
+      expandLocalElementMatrix( compressedLocalElementMatrices_.at( cell.getID() ).at( level ).data() + elementIndex * numEntries,
+                                localElementMatricesUpperTriangleOnly_,
+                                buffer );
+   }
+   return buffer;
+}
+
+template < class P2Form >
+const Matrix6r& P2ElementwiseOperator< P2Form >::precomputedLocalElementMatrix2D( const Face&            face,
+                                                                                  uint_t                 level,
+                                                                                  const indexing::Index& microFace,
+                                                                                  facedof::FaceType      fType,
+                                                                                  Matrix6r&              buffer ) const
+{
+   if ( !localElementMatricesUpperTriangleOnly_ && !localElementMatricesSinglePrecision_ )
+   {
+      return localElementMatrix2D( face, level, microFace, fType );
+   }
+
+   const uint_t numEntries   = numStoredLocalElementMatrixEntries( 6, localElementMatricesUpperTriangleOnly_ );
+   const uint_t elementIndex = facedof::macroface::index( level, microFace.x(), microFace.y(), fType );
+
+   if ( localElementMatricesSinglePrecision_ )
+   {
+      expandLocalElementMatrix( compressedLocalElementMatricesFloat_.at( face.getID() ).at( level ).data() +
+                                    elementIndex * numEntries,
+                                localElementMatricesUpperTriangleOnly_,
+                                buffer );
+   }
+   else
+   {
+      expandLocalElementMatrix( compressedLocalElementMatrices_.at( face.getID() ).at( level ).data() + elementIndex * numEntries,
+                                localElementMatricesUpperTriangleOnly_,
+                                buffer );
+   }
+   return buffer;
+}
+
+template < class P2Form >
+unsigned long long P2ElementwiseOperator< P2Form >::getLocalElementMatricesLocalMemoryInBytes() const
+{
+   unsigned long long bytes = 0;
+   for ( const auto& [id, levels] : localElementMatrices2D_ )
+   {
+      for ( const auto& [level, matrices] : levels )
+      {
+         bytes += matrices.size() * sizeof( Matrix6r );
+      }
+   }
+   for ( const auto& [id, levels] : localElementMatrices3D_ )
+   {
+      for ( const auto& [level, matrices] : levels )
+      {
+         bytes += matrices.size() * sizeof( Matrix10r );
+      }
+   }
+   for ( const auto& [id, levels] : compressedLocalElementMatrices_ )
+   {
+      for ( const auto& [level, entries] : levels )
+      {
+         bytes += entries.size() * sizeof( real_t );
+      }
+   }
+   for ( const auto& [id, levels] : compressedLocalElementMatricesFloat_ )
+   {
+      for ( const auto& [level, entries] : levels )
+      {
+         bytes += entries.size() * sizeof( float );
+      }
+   }
+   return bytes;
+}
+
+template < class P2Form >
+unsigned long long P2ElementwiseOperator< P2Form >::getLocalElementMatricesGlobalMemoryInBytes() const
+{
+   return walberla::mpi::allReduce(
+       getLocalElementMatricesLocalMemoryInBytes(), walberla::mpi::SUM, walberla::mpi::MPIManager::instance()->comm() );
 }
 
 template < class P2Form >
@@ -649,21 +1757,21 @@ void P2ElementwiseOperator< P2Form >::computeLocalDiagonalContributions2D( const
                                                                            bool                         lumped )
 {
    Matrix6r                elMat = Matrix6r::Zero();
-   indexing::Index         nodeIdx;
-   indexing::Index         offset;
    Point3D                 v0, v1, v2;
    std::array< uint_t, 6 > dofDataIdx;
 
    // determine vertices of micro-element
-   nodeIdx = indexing::Index( xIdx, yIdx, 0 );
-   v0      = vertexdof::macroface::coordinateFromIndex( level, face, nodeIdx );
-   offset  = vertexdof::logicalIndexOffsetFromVertex( element[1] );
-   v1      = vertexdof::macroface::coordinateFromIndex( level, face, nodeIdx + offset );
-   offset  = vertexdof::logicalIndexOffsetFromVertex( element[2] );
-   v2      = vertexdof::macroface::coordinateFromIndex( level, face, nodeIdx + offset );
+   std::array< indexing::Index, 3 > verts;
+   verts[0] = indexing::Index( xIdx, yIdx, 0 );
+   verts[1] = verts[0] + vertexdof::logicalIndexOffsetFromVertex( element[1] );
+   verts[2] = verts[0] + vertexdof::logicalIndexOffsetFromVertex( element[2] );
+   v0       = vertexdof::macroface::coordinateFromIndex( level, face, verts[0] );
+   v1       = vertexdof::macroface::coordinateFromIndex( level, face, verts[1] );
+   v2       = vertexdof::macroface::coordinateFromIndex( level, face, verts[2] );
 
    // assemble local element matrix
    form_.setGeometryMap( face.getGeometryMap() );
+   setMicroElementOfForm( form_, face, level, verts );
    form_.integrateAll( { v0, v1, v2 }, elMat );
 
    // get global indices for local dofs
@@ -719,6 +1827,7 @@ void P2ElementwiseOperator< P2Form >::computeLocalDiagonalContributions3D( const
    // assemble local element matrix
    Matrix10r elMat = Matrix10r::Zero();
    form_.setGeometryMap( cell.getGeometryMap() );
+   setMicroElementOfForm( form_, cell, level, verts );
    form_.integrateAll( coords, elMat );
 
    // obtain data indices of dofs associated with micro-cell
@@ -921,22 +2030,22 @@ void P2ElementwiseOperator< P2Form >::localMatrixAssembly2D( const std::shared_p
                                                              const real_t&                               alpha ) const
 {
    Matrix6r                elMat = Matrix6r::Zero();
-   indexing::Index         nodeIdx;
-   indexing::Index         offset;
    Point3D                 v0, v1, v2;
    std::array< uint_t, 6 > dofDataIdx;
    P2Form                  form( form_ );
 
    // determine vertices of micro-element
-   nodeIdx = indexing::Index( xIdx, yIdx, 0 );
-   v0      = vertexdof::macroface::coordinateFromIndex( level, face, nodeIdx );
-   offset  = vertexdof::logicalIndexOffsetFromVertex( element[1] );
-   v1      = vertexdof::macroface::coordinateFromIndex( level, face, nodeIdx + offset );
-   offset  = vertexdof::logicalIndexOffsetFromVertex( element[2] );
-   v2      = vertexdof::macroface::coordinateFromIndex( level, face, nodeIdx + offset );
+   std::array< indexing::Index, 3 > verts;
+   verts[0] = indexing::Index( xIdx, yIdx, 0 );
+   verts[1] = verts[0] + vertexdof::logicalIndexOffsetFromVertex( element[1] );
+   verts[2] = verts[0] + vertexdof::logicalIndexOffsetFromVertex( element[2] );
+   v0       = vertexdof::macroface::coordinateFromIndex( level, face, verts[0] );
+   v1       = vertexdof::macroface::coordinateFromIndex( level, face, verts[1] );
+   v2       = vertexdof::macroface::coordinateFromIndex( level, face, verts[2] );
 
    // assemble local element matrix
    form.setGeometryMap( face.getGeometryMap() );
+   setMicroElementOfForm( form, face, level, verts );
    form.integrateAll( { v0, v1, v2 }, elMat );
 
    // determine global indices of our local DoFs (note the tweaked ordering to go along with FEniCS indexing)
@@ -1001,6 +2110,7 @@ void P2ElementwiseOperator< P2Form >::localMatrixAssembly3D( const std::shared_p
    Matrix10r elMat = Matrix10r::Zero();
    P2Form    form( form_ );
    form.setGeometryMap( cell.getGeometryMap() );
+   setMicroElementOfForm( form, cell, level, verts );
    form.integrateAll( coords, elMat );
 
    // obtain data indices of dofs associated with micro-cell
@@ -1144,4 +2254,108 @@ template class P2ElementwiseOperator< forms::p2_full_stokesvar_2_0_blending_q3 >
 template class P2ElementwiseOperator< forms::p2_full_stokesvar_2_1_blending_q3 >;
 template class P2ElementwiseOperator< forms::p2_full_stokesvar_2_2_blending_q3 >;
 
+
+// Instantiations required for P2ElementwiseVariableViscousOperator.hpp
+template class P2ElementwiseOperator< forms::P2Form_fullStokesVar< 0, 0, forms::CallbackCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_fullStokesVar< 0, 1, forms::CallbackCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_fullStokesVar< 0, 2, forms::CallbackCoefficient > >;
+
+template class P2ElementwiseOperator< forms::P2Form_fullStokesVar< 1, 0, forms::CallbackCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_fullStokesVar< 1, 1, forms::CallbackCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_fullStokesVar< 1, 2, forms::CallbackCoefficient > >;
+
+template class P2ElementwiseOperator< forms::P2Form_fullStokesVar< 2, 0, forms::CallbackCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_fullStokesVar< 2, 1, forms::CallbackCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_fullStokesVar< 2, 2, forms::CallbackCoefficient > >;
+
+template class P2ElementwiseOperator< forms::P2Form_epsilonVar< 0, 0, forms::CallbackCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_epsilonVar< 0, 1, forms::CallbackCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_epsilonVar< 0, 2, forms::CallbackCoefficient > >;
+
+template class P2ElementwiseOperator< forms::P2Form_epsilonVar< 1, 0, forms::CallbackCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_epsilonVar< 1, 1, forms::CallbackCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_epsilonVar< 1, 2, forms::CallbackCoefficient > >;
+
+template class P2ElementwiseOperator< forms::P2Form_epsilonVar< 2, 0, forms::CallbackCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_epsilonVar< 2, 1, forms::CallbackCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_epsilonVar< 2, 2, forms::CallbackCoefficient > >;
+
+template class P2ElementwiseOperator< forms::P2Form_fullStokesVar< 0, 0, forms::RadialProfileCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_fullStokesVar< 0, 1, forms::RadialProfileCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_fullStokesVar< 0, 2, forms::RadialProfileCoefficient > >;
+
+template class P2ElementwiseOperator< forms::P2Form_fullStokesVar< 1, 0, forms::RadialProfileCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_fullStokesVar< 1, 1, forms::RadialProfileCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_fullStokesVar< 1, 2, forms::RadialProfileCoefficient > >;
+
+template class P2ElementwiseOperator< forms::P2Form_fullStokesVar< 2, 0, forms::RadialProfileCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_fullStokesVar< 2, 1, forms::RadialProfileCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_fullStokesVar< 2, 2, forms::RadialProfileCoefficient > >;
+
+template class P2ElementwiseOperator< forms::P2Form_epsilonVar< 0, 0, forms::RadialProfileCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_epsilonVar< 0, 1, forms::RadialProfileCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_epsilonVar< 0, 2, forms::RadialProfileCoefficient > >;
+
+template class P2ElementwiseOperator< forms::P2Form_epsilonVar< 1, 0, forms::RadialProfileCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_epsilonVar< 1, 1, forms::RadialProfileCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_epsilonVar< 1, 2, forms::RadialProfileCoefficient > >;
+
+template class P2ElementwiseOperator< forms::P2Form_epsilonVar< 2, 0, forms::RadialProfileCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_epsilonVar< 2, 1, forms::RadialProfileCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_epsilonVar< 2, 2, forms::RadialProfileCoefficient > >;
+
+template class P2ElementwiseOperator< forms::P2Form_fullStokesVar< 0, 0, forms::P1FunctionCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_fullStokesVar< 0, 1, forms::P1FunctionCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_fullStokesVar< 0, 2, forms::P1FunctionCoefficient > >;
+
+template class P2ElementwiseOperator< forms::P2Form_fullStokesVar< 1, 0, forms::P1FunctionCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_fullStokesVar< 1, 1, forms::P1FunctionCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_fullStokesVar< 1, 2, forms::P1FunctionCoefficient > >;
+
+template class P2ElementwiseOperator< forms::P2Form_fullStokesVar< 2, 0, forms::P1FunctionCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_fullStokesVar< 2, 1, forms::P1FunctionCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_fullStokesVar< 2, 2, forms::P1FunctionCoefficient > >;
+
+template class P2ElementwiseOperator< forms::P2Form_epsilonVar< 0, 0, forms::P1FunctionCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_epsilonVar< 0, 1, forms::P1FunctionCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_epsilonVar< 0, 2, forms::P1FunctionCoefficient > >;
+
+template class P2ElementwiseOperator< forms::P2Form_epsilonVar< 1, 0, forms::P1FunctionCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_epsilonVar< 1, 1, forms::P1FunctionCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_epsilonVar< 1, 2, forms::P1FunctionCoefficient > >;
+
+template class P2ElementwiseOperator< forms::P2Form_epsilonVar< 2, 0, forms::P1FunctionCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_epsilonVar< 2, 1, forms::P1FunctionCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_epsilonVar< 2, 2, forms::P1FunctionCoefficient > >;
+
+template class P2ElementwiseOperator< forms::P2Form_fullStokesVar< 0, 0, forms::P2FunctionCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_fullStokesVar< 0, 1, forms::P2FunctionCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_fullStokesVar< 0, 2, forms::P2FunctionCoefficient > >;
+
+template class P2ElementwiseOperator< forms::P2Form_fullStokesVar< 1, 0, forms::P2FunctionCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_fullStokesVar< 1, 1, forms::P2FunctionCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_fullStokesVar< 1, 2, forms::P2FunctionCoefficient > >;
+
+template class P2ElementwiseOperator< forms::P2Form_fullStokesVar< 2, 0, forms::P2FunctionCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_fullStokesVar< 2, 1, forms::P2FunctionCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_fullStokesVar< 2, 2, forms::P2FunctionCoefficient > >;
+
+template class P2ElementwiseOperator< forms::P2Form_epsilonVar< 0, 0, forms::P2FunctionCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_epsilonVar< 0, 1, forms::P2FunctionCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_epsilonVar< 0, 2, forms::P2FunctionCoefficient > >;
+
+template class P2ElementwiseOperator< forms::P2Form_epsilonVar< 1, 0, forms::P2FunctionCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_epsilonVar< 1, 1, forms::P2FunctionCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_epsilonVar< 1, 2, forms::P2FunctionCoefficient > >;
+
+template class P2ElementwiseOperator< forms::P2Form_epsilonVar< 2, 0, forms::P2FunctionCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_epsilonVar< 2, 1, forms::P2FunctionCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_epsilonVar< 2, 2, forms::P2FunctionCoefficient > >;
+
+// Instantiations required for P2ElementwiseDivKGradVarOperator
+template class P2ElementwiseOperator< forms::P2Form_divKGradVar< forms::CallbackCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_divKGradVar< forms::RadialProfileCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_divKGradVar< forms::P1FunctionCoefficient > >;
+template class P2ElementwiseOperator< forms::P2Form_divKGradVar< forms::P2FunctionCoefficient > >;
+
 } // namespace hyteg
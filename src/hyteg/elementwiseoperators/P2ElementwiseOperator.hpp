@@ -44,6 +44,7 @@
 #include "hyteg/forms/form_hyteg_generated/p2/p2_secondDerivativeTestForm_blending_q3.hpp"
 #include "hyteg/forms/form_hyteg_manual/P2FormDivKGrad.hpp"
 #include "hyteg/forms/form_hyteg_manual/P2FormLaplace.hpp"
+#include "hyteg/forms/form_hyteg_manual/P2FormViscousVar.hpp"
 #include "hyteg/forms/form_hyteg_manual/p2_neighbour_form.hpp"
 #include "hyteg/operators/Operator.hpp"
 #include "hyteg/p1functionspace/VertexDoFMacroFace.hpp"
@@ -60,6 +61,10 @@ using walberla::real_t;
 template < class P2Form >
 class P2ElementwiseOperator : public Operator< P2Function< real_t >, P2Function< real_t > >,
                               public WeightedJacobiSmoothable< P2Function< real_t > >,
+                              public GSSmoothable< P2Function< real_t > >,
+                              public GSBackwardsSmoothable< P2Function< real_t > >,
+                              public SORSmoothable< P2Function< real_t > >,
+                              public SORBackwardsSmoothable< P2Function< real_t > >,
                               public OperatorWithInverseDiagonal< P2Function< real_t > >
 {
  public:
@@ -168,6 +173,41 @@ class P2ElementwiseOperator : public Operator< P2Function< real_t >, P2Function<
    /// If the local element matrices need to be recomputed again, simply call this method again.
    void computeAndStoreLocalElementMatrices();
 
+   /// \brief Pre-computes the local stiffness matrices for each (micro-)element and stores them in a compressed format.
+   ///
+   /// The matrices of all micro-elements of a macro-primitive are stored in one flat array per level. They are expanded
+   /// on-the-fly during apply().
+   ///
+   /// \param upperTriangleOnly if true, only the upper triangle (including the diagonal) of each matrix is stored
+   ///                          (55 % (3D) or 58 % (2D) of the full storage), this requires a symmetric form
+   /// \param singlePrecision   if true, the entries are stored in single precision (50 % of the full storage
+   ///                          if real_t is double)
+   void computeAndStoreLocalElementMatrices( bool upperTriangleOnly, bool singlePrecision );
+
+   /// Returns the memory in bytes that is occupied by the pre-computed local element matrices on this process.
+   unsigned long long getLocalElementMatricesLocalMemoryInBytes() const;
+
+   /// Returns the memory in bytes that is occupied by the pre-computed local element matrices on all processes.
+   unsigned long long getLocalElementMatricesGlobalMemoryInBytes() const;
+
+   /// \brief Overlaps the halo exchange of the source function with the computation in apply() and gemv().
+   ///
+   /// If enabled, the largest part of the halo exchange (face -> cell in 3D, edge -> face in 2D) is only started before
+   /// the micro-elements in the interior of the macro-primitives are processed. These do not access any DoFs that are
+   /// updated by communication. The exchange is completed afterwards and the remaining micro-elements that touch the
+   /// boundary of a macro-primitive are processed in a second sweep.
+   ///
+   /// The result is identical to the non-overlapping apply (up to round-off due to the changed order of the additions).
+   void setOverlapCommunication( bool overlapCommunication ) { overlapCommunication_ = overlapCommunication; }
+
+   bool getOverlapCommunication() const { return overlapCommunication_; }
+
+   /// \brief Processes batches of neighboring micro-cells with SIMD instructions in the 3D apply() and gemv() (enabled by
+   /// default). If disabled, all micro-cells are processed one by one.
+   void setVectorizedApply( bool vectorizedApply ) { vectorizedApply_ = vectorizedApply; }
+
+   bool getVectorizedApply() const { return vectorizedApply_; }
+
    void smooth_jac_scaled( const real_t&               alpha,
                            const P2Function< real_t >& dst,
                            const P2Function< real_t >& rhs,
@@ -183,16 +223,55 @@ class P2ElementwiseOperator : public Operator< P2Function< real_t >, P2Function<
                     size_t                      level,
                     DoFType                     flag ) const override;
 
-   void smooth_gs( const P2Function< real_t >&, const P2Function< real_t >&, size_t, DoFType ) const
+   /// Gauss-Seidel smoothing step, same as smooth_sor() with relaxation parameter 1.
+   void smooth_gs( const P2Function< real_t >& dst, const P2Function< real_t >& rhs, uint_t level, DoFType flag ) const override
    {
-      WALBERLA_ABORT( "Gauss-Seidel not implemented for P2ElementwiseOperator." )
+      smooth_sor( dst, rhs, real_c( 1 ), level, flag );
    }
 
-   void smooth_sor( const P2Function< real_t >&, const P2Function< real_t >&, real_t, size_t, DoFType ) const
+   /// Gauss-Seidel smoothing step in reversed order, same as smooth_sor_backwards() with relaxation parameter 1.
+   void smooth_gs_backwards( const P2Function< real_t >& dst,
+                             const P2Function< real_t >& rhs,
+                             uint_t                      level,
+                             DoFType                     flag ) const override
    {
-      WALBERLA_ABORT( "SOR not implemented for P2ElementwiseOperator." )
+      smooth_sor_backwards( dst, rhs, real_c( 1 ), level, flag );
    }
 
+   /// \brief Multicolour SOR smoothing step.
+   ///
+   /// The DoFs in the interior of the macro-cells (3D) or macro-faces (2D) are relaxed in Gauss-Seidel fashion.
+   /// They are grouped into colours by their type (vertex DoF, edge DoF of a certain orientation) and the parity of
+   /// their logical index, so that DoFs of the same colour never belong to the same micro-element and can be relaxed
+   /// independently. The matrix rows of the DoFs of a colour are accumulated from the (pre-computed or recomputed)
+   /// local element matrices. As the interiors of the macro-primitives are decoupled, they are processed in parallel
+   /// with OpenMP.
+   ///
+   /// The DoFs on the interfaces between the macro-primitives are relaxed before that by a Jacobi step that is
+   /// scaled with the inverse of the l1-norms of the matrix rows. This keeps the resulting hybrid smoother
+   /// convergent for symmetric positive definite operators and 0 < relax < 2, regardless of the partitioning.
+   ///
+   /// Requires the inverse diagonal, see computeInverseDiagonalOperatorValues().
+   ///
+   /// \note Each element matrix is needed once per colour of its DoFs, i.e. up to ten times in 3D. Pre-computing them
+   ///       with computeAndStoreLocalElementMatrices() is therefore strongly recommended.
+   void smooth_sor( const P2Function< real_t >& dst,
+                    const P2Function< real_t >& rhs,
+                    real_t                      relax,
+                    uint_t                      level,
+                    DoFType                     flag ) const override;
+
+   /// \brief Multicolour SOR smoothing step that traverses the colours in reversed order and relaxes the interface
+   ///        DoFs last.
+   ///
+   /// Applying smooth_sor() followed by smooth_sor_backwards() results in a symmetric smoother (e.g. via
+   /// SymmetricSORSmoother).
+   void smooth_sor_backwards( const P2Function< real_t >& dst,
+                              const P2Function< real_t >& rhs,
+                              real_t                      relax,
+                              uint_t                      level,
+                              DoFType                     flag ) const override;
+
    /// Assemble operator as sparse matrix with scaling
    ///
    /// \param alpha constant scaling of the matrix
@@ -228,6 +307,60 @@ class P2ElementwiseOperator : public Operator< P2Function< real_t >, P2Function<
    P2Form getForm() const;
 
  private:
+   /// Selects the micro-elements of a macro-primitive that are processed in a sweep of the apply.
+   enum class MicroElementSelection
+   {
+      /// all micro-elements
+      ALL,
+      /// only micro-elements that do not have a vertex on the boundary of the macro-primitive
+      INTERIOR,
+      /// only micro-elements with at least one vertex on the boundary of the macro-primitive
+      BOUNDARY
+   };
+
+   /// Adds alpha times the element-local matrix-vector products of the selected micro-cells of the passed macro-cell to dst.
+   void applyMicroCells( const real_t&               alpha,
+                         Cell&                       cell,
+                         const P2Function< real_t >& src,
+                         const P2Function< real_t >& dst,
+                         uint_t                      level,
+                         MicroElementSelection       selection ) const;
+
+   /// Adds alpha times the element-local matrix-vector products of the selected micro-faces of the passed macro-face to dst.
+   void applyMicroFaces( const real_t&               alpha,
+                         Face&                       face,
+                         const P2Function< real_t >& src,
+                         const P2Function< real_t >& dst,
+                         uint_t                      level,
+                         MicroElementSelection       selection ) const;
+
+   /// Relaxes the DoFs on the interfaces between the macro-primitives with an l1-scaled Jacobi step, see smooth_sor().
+   void smoothInterfaceDoFsJacobi( const P2Function< real_t >& dst,
+                                   const P2Function< real_t >& rhs,
+                                   real_t                      relax,
+                                   uint_t                      level,
+                                   DoFType                     flag ) const;
+
+   /// Performs a multicolour SOR sweep over the DoFs in the interior of the passed macro-cell.
+   void smoothMicroCellsSOR( Cell&                       cell,
+                             const P2Function< real_t >& dst,
+                             const P2Function< real_t >& rhs,
+                             real_t                      relax,
+                             uint_t                      level,
+                             bool                        backwards ) const;
+
+   /// Performs a multicolour SOR sweep over the DoFs in the interior of the passed macro-face.
+   void smoothMicroFacesSOR( Face&                       face,
+                             const P2Function< real_t >& dst,
+                             const P2Function< real_t >& rhs,
+                             real_t                      relax,
+                             uint_t                      level,
+                             bool                        backwards ) const;
+
+   /// Computes the inverse of the l1-norms of the matrix rows (from the absolute values of the local element
+   /// matrix entries) on all levels.
+   void computeInverseL1RowNorms() const;
+
    /// compute product of element local vector with element matrix
    ///
    /// \param level          level on which we operate in mesh hierarchy
@@ -320,6 +453,12 @@ class P2ElementwiseOperator : public Operator< P2Function< real_t >, P2Function<
    std::shared_ptr< P2Function< real_t > > lumpedDiagonalValues_;
    std::shared_ptr< P2Function< real_t > > lumpedInverseDiagonalValues_;
 
+   /// inverse l1-norms of the matrix rows for the relaxation of the interface DoFs in smooth_sor(), computed on demand
+   mutable std::shared_ptr< P2Function< real_t > > inverseL1RowNorms_;
+
+   /// residual of the interface DoFs in smooth_sor()
+   mutable std::shared_ptr< P2Function< real_t > > smoothTmp_;
+
    P2Form form_;
 
    /// \brief Returns a reference to the a precomputed element matrix of the specified micro face.
@@ -372,8 +511,31 @@ class P2ElementwiseOperator : public Operator< P2Function< real_t >, P2Function<
       return localElementMatrices3D_.at( cell.getID() ).at( level ).at( idx );
    }
 
+   /// \brief Returns a const reference to the precomputed element matrix of the specified micro cell.
+   /// If the matrices are stored compressed, the matrix is expanded into the passed buffer.
+   const Matrix10r& precomputedLocalElementMatrix3D( const Cell&            cell,
+                                                     uint_t                 level,
+                                                     const indexing::Index& microCell,
+                                                     celldof::CellType      cType,
+                                                     Matrix10r&             buffer ) const;
+
+   /// \brief Returns a const reference to the precomputed element matrix of the specified micro face.
+   /// If the matrices are stored compressed, the matrix is expanded into the passed buffer.
+   const Matrix6r& precomputedLocalElementMatrix2D( const Face&            face,
+                                                    uint_t                 level,
+                                                    const indexing::Index& microFace,
+                                                    facedof::FaceType      fType,
+                                                    Matrix6r&              buffer ) const;
+
    bool localElementMatricesPrecomputed_;
 
+   /// storage format of the pre-computed local element matrices, see computeAndStoreLocalElementMatrices( bool, bool )
+   bool localElementMatricesUpperTriangleOnly_;
+   bool localElementMatricesSinglePrecision_;
+
+   bool overlapCommunication_;
+   bool vectorizedApply_;
+
    /// Pre-computed local element matrices.
    /// localElementMatrices2D_[macroCellID][level][cellIdx] = mat6x6
    std::map< PrimitiveID, std::map< uint_t, std::vector< Matrix6r, Eigen::aligned_allocator< Matrix6r > > > >
@@ -383,8 +545,30 @@ class P2ElementwiseOperator : public Operator< P2Function< real_t >, P2Function<
    /// localElementMatrices3D_[macroCellID][level][cellIdx] = mat10x10
    std::map< PrimitiveID, std::map< uint_t, std::vector< Matrix10r, Eigen::aligned_allocator< Matrix10r > > > >
        localElementMatrices3D_;
+
+   /// Compressed pre-computed local element matrices.
+   /// compressedLocalElementMatrices_[macroID][level] = [ entries of micro-element 0, entries of micro-element 1, ... ]
+   std::map< PrimitiveID, std::map< uint_t, std::vector< real_t > > > compressedLocalElementMatrices_;
+
+   /// Compressed pre-computed local element matrices in single precision, layout as in compressedLocalElementMatrices_.
+   std::map< PrimitiveID, std::map< uint_t, std::vector< float > > > compressedLocalElementMatricesFloat_;
 };
 
+/// Passes the current micro-element to forms that need to know it, e.g. to gather the local DoFs of a coefficient given by
+/// a finite element function (see forms::LocalDoFCoefficient). Must be called before integrating on the micro-element.
+/// Does nothing for all other forms.
+template < class P2Form, class PrimitiveType, std::size_t NumVertices >
+inline void setMicroElementOfForm( P2Form&                                          form,
+                                   const PrimitiveType&                             primitive,
+                                   uint_t                                           level,
+                                   const std::array< indexing::Index, NumVertices >& microVertices )
+{
+   if constexpr ( requires { form.setMicroElement( primitive, level, microVertices ); } )
+   {
+      form.setMicroElement( primitive, level, microVertices );
+   }
+}
+
 template < class P2Form >
 void assembleLocalElementMatrix2D( const Face&            face,
                                    uint_t                 level,
@@ -403,6 +587,7 @@ void assembleLocalElementMatrix2D( const Face&            face,
 
    // assemble local element matrix
    form.setGeometryMap( face.getGeometryMap() );
+   setMicroElementOfForm( form, face, level, verts );
    form.integrateAll( coords, elMat );
 }
 
@@ -424,6 +609,7 @@ void assembleLocalElementMatrix3D( const Cell&            cell,
 
    // assemble local element matrix
    form.setGeometryMap( cell.getGeometryMap() );
+   setMicroElementOfForm( form, cell, level, verts );
    form.integrateAll( coords, elMat );
 }
 
@@ -449,6 +635,32 @@ void localMatrixVectorMultiply3D( uint_t                 level,
                                   const Matrix10r&       elMat,
                                   const real_t&          alpha );
 
+/// Number of micro-cells that are processed at once by localMatrixVectorMultiply3DVectorized().
+constexpr uint_t P2ElementwiseSIMDWidth = 4;
+
+/// compute products of element local vectors with element matrices for P2ElementwiseSIMDWidth micro-cells
+/// of the same type that are neighbors in x-direction, i.e. microCell, microCell + (1, 0, 0), ...
+///
+/// The DoFs of these micro-cells are located at consecutive positions in memory, so that the element vectors are
+/// gathered and scattered in structure-of-arrays layout with one (unaligned) SIMD load/store per local DoF.
+/// Falls back to localMatrixVectorMultiply3D() if SIMD is not available for real_t.
+///
+/// \param microCell         index of the first micro-cell of the batch
+/// \param elMatsInterleaved the 10x10 element matrices of the micro-cells of the batch in lane-interleaved layout,
+///                          entry (i, j) of the l-th micro-cell is stored at (10 * i + j) * P2ElementwiseSIMDWidth + l,
+///                          must be aligned to 32 bytes
+///
+/// \note The src and dst data arrays must not be identical.
+void localMatrixVectorMultiply3DVectorized( uint_t                                                        level,
+                                            const indexing::Index&                                        microCell,
+                                            celldof::CellType                                             cType,
+                                            const real_t* const                                           srcVertexData,
+                                            const real_t* const                                           srcEdgeData,
+                                            real_t* const                                                 dstVertexData,
+                                            real_t* const                                                 dstEdgeData,
+                                            const real_t* const                                           elMatsInterleaved,
+                                            const real_t&                                                 alpha );
+
 typedef P2ElementwiseOperator<
     P2FenicsForm< p2_diffusion_cell_integral_0_otherwise, p2_tet_diffusion_cell_integral_0_otherwise > >
     P2ElementwiseLaplaceOperator;
@@ -474,6 +686,10 @@ typedef P2ElementwiseOperator< P2LinearCombinationForm > P2ElementwiseLinearComb
 typedef P2ElementwiseOperator< forms::p2_div_k_grad_affine_q4 >   P2ElementwiseAffineDivKGradOperator;
 typedef P2ElementwiseOperator< forms::p2_div_k_grad_blending_q4 > P2ElementwiseBlendingDivKGradOperator;
 
+/// Variable coefficient diffusion operator, see forms::P2Form_divKGradVar for the admissible coefficients.
+template < typename Coefficient >
+using P2ElementwiseDivKGradVarOperator = P2ElementwiseOperator< forms::P2Form_divKGradVar< Coefficient > >;
+
 typedef P2ElementwiseOperator< forms::p2_div_k_grad_centroid_affine_q3 >   P2ElementwiseAffineDivKGradOperator_Centroid;
 typedef P2ElementwiseOperator< forms::p2_div_k_grad_centroid_blending_q4 > P2ElementwiseBlendingDivKGradOperator_Centroid;
 
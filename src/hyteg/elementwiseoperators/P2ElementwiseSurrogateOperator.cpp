@@ -0,0 +1,503 @@
+/*
+ * Copyright (c) 2026 Nils Kohl, Marcus Mohr.
+ *
+ * This file is part of HyTeG
+ * (see https://i10git.cs.fau.de/hyteg/hyteg).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "P2ElementwiseSurrogateOperator.hpp"
+
+#include <algorithm>
+
+namespace hyteg {
+
+template < class P2Form, uint8_t DEGREE, bool Symmetric >
+P2ElementwiseSurrogateOperator< P2Form, DEGREE, Symmetric >::P2ElementwiseSurrogateOperator(
+    const std::shared_ptr< PrimitiveStorage >& storage,
+    size_t                                     minLevel,
+    size_t                                     maxLevel )
+: P2ElementwiseSurrogateOperator< P2Form, DEGREE, Symmetric >( storage, minLevel, maxLevel, P2Form() )
+{}
+
+template < class P2Form, uint8_t DEGREE, bool Symmetric >
+P2ElementwiseSurrogateOperator< P2Form, DEGREE, Symmetric >::P2ElementwiseSurrogateOperator(
+    const std::shared_ptr< PrimitiveStorage >& storage,
+    size_t                                     minLevel,
+    size_t                                     maxLevel,
+    const P2Form&                              form )
+: Operator( storage, minLevel, maxLevel )
+, form_( form )
+, is_initialized_( false )
+, lsq_( maxLevel + 1 )
+, downsampling_( 0 )
+, a_loc_3d_( storage, Primitive::CELL, 0, std::min( maxLevel, min_lvl_for_surrogate - 1u ) )
+, surrogate_3d_( storage, Primitive::CELL, min_lvl_for_surrogate, maxLevel )
+{
+   if ( !storage->hasGlobalCells() )
+   {
+      WALBERLA_ABORT( "P2ElementwiseSurrogateOperator is only implemented for 3D, use P2SurrogateOperator in 2D." );
+   }
+}
+
+template < class P2Form, uint8_t DEGREE, bool Symmetric >
+void P2ElementwiseSurrogateOperator< P2Form, DEGREE, Symmetric >::init( size_t             downsampling,
+                                                                        const std::string& path_to_svd,
+                                                                        bool               needsInverseDiagEntries )
+{
+   // precompute and store local element matrices for level 0-3
+   for ( uint_t level = minLevel_; level < min_lvl_for_surrogate && level <= maxLevel_; ++level )
+   {
+      precompute_local_stiffness_3d( level );
+   }
+
+   // approximate local element matrices for level 4+ by polynomials
+   for ( uint_t level = std::max( minLevel_, min_lvl_for_surrogate ); level <= maxLevel_; ++level )
+   {
+      // initialize least squares approximation
+      if ( lsq_[level] == nullptr || downsampling_ != downsampling )
+      {
+         /* There is no 'white-down' micro-cell for x=n-1 and only 'white-up' for x=n.
+            Therefore, we don't use these x-values as sample points.
+         */
+         const uint_t offset = 2;
+         if ( path_to_svd == "" )
+         {
+            lsq_[level] = std::make_shared< LSQ >( 3, DEGREE, level, downsampling, offset );
+         }
+         else
+         {
+            lsq_[level] = std::make_shared< LSQ >( path_to_svd, 3, DEGREE, level, downsampling, offset );
+         }
+      }
+
+      compute_local_surrogates_3d( level );
+   }
+   downsampling_ = downsampling;
+
+   if ( needsInverseDiagEntries )
+   {
+      computeInverseDiagonalOperatorValues();
+   }
+
+   is_initialized_ = true;
+}
+
+template < class P2Form, uint8_t DEGREE, bool Symmetric >
+void P2ElementwiseSurrogateOperator< P2Form, DEGREE, Symmetric >::store_svd( const std::string& path_to_svd )
+{
+   for ( uint_t level = min_lvl_for_surrogate; level <= maxLevel_; ++level )
+   {
+      if ( lsq_[level] != nullptr )
+      {
+         lsq_[level]->write_to_file( path_to_svd );
+      }
+   }
+}
+
+template < class P2Form, uint8_t DEGREE, bool Symmetric >
+void P2ElementwiseSurrogateOperator< P2Form, DEGREE, Symmetric >::precompute_local_stiffness_3d( uint_t level )
+{
+   for ( const auto& [id, cell] : storage_->getCells() )
+   {
+      auto& a_loc = a_loc_3d_[id][level];
+      a_loc.set_level( level );
+
+      for ( const auto& cType : celldof::allCellTypes )
+      {
+         for ( const auto& micro : celldof::macrocell::Iterator( level, cType, 0 ) )
+         {
+            auto& elMat = a_loc( cType, micro );
+            elMat.setZero();
+            assembleLocalElementMatrix3D( *cell, level, micro, cType, form_, elMat );
+         }
+      }
+   }
+}
+
+template < class P2Form, uint8_t DEGREE, bool Symmetric >
+void P2ElementwiseSurrogateOperator< P2Form, DEGREE, Symmetric >::compute_local_surrogates_3d( uint_t level )
+{
+   auto& lsq = *lsq_[level];
+   // initialize rhs vectors for lsq
+   RHS_matrix rhs;
+   for ( idx_t i = 0; i < rhs.rows(); ++i )
+   {
+      for ( idx_t j = 0; j < rhs.cols(); ++j )
+      {
+         rhs( i, j ).resize( lsq.rows );
+      }
+   }
+
+   for ( auto& [id, cell] : storage_->getCells() )
+   {
+      for ( const auto& cType : celldof::allCellTypes )
+      {
+         // set up rhs vectors for each entry of the local element matrix
+         auto it = lsq.samplingIterator();
+         while ( it != it.end() )
+         {
+            Matrix10r elMat( Matrix10r::Zero() );
+            assembleLocalElementMatrix3D( *cell, level, it.ijk(), cType, form_, elMat );
+            for ( idx_t i = 0; i < rhs.rows(); ++i )
+            {
+               for ( idx_t j = 0; j < rhs.cols(); ++j )
+               {
+                  rhs( i, j )[it()] = elMat( i, j );
+               }
+            }
+            ++it;
+         }
+         // fit polynomials for each entry of the local element matrix (only the lower triangle for symmetric forms)
+         auto& surrogate = surrogate_3d_[id][level][cType];
+         for ( idx_t i = 0; i < rhs.rows(); ++i )
+         {
+            const idx_t j_end = Symmetric ? i + 1 : rhs.cols();
+            for ( idx_t j = 0; j < j_end; ++j )
+            {
+               // apply least squares fit
+               lsq.setRHS( rhs( i, j ) );
+               auto& coeffs      = lsq.solve();
+               surrogate( i, j ) = Poly( coeffs );
+            }
+         }
+      }
+   }
+}
+
+template < class P2Form, uint8_t DEGREE, bool Symmetric >
+template < typename ElementOperation >
+void P2ElementwiseSurrogateOperator< P2Form, DEGREE, Symmetric >::forEachLocalElementMatrix(
+    const Cell&             cell,
+    const uint_t            level,
+    const celldof::CellType cType,
+    ElementOperation&&      elementOperation ) const
+{
+   auto& id = cell.getID();
+
+   if ( level < min_lvl_for_surrogate )
+   { // use precomputed local matrices
+      auto& a_loc = a_loc_3d_.at( id )[level];
+      for ( const auto& micro : celldof::macrocell::Iterator( level, cType, 0 ) )
+      {
+         elementOperation( micro, a_loc( cType, micro ) );
+      }
+      return;
+   }
+
+   // use surrogate polynomials to approximate local matrices
+   auto& surrogate = surrogate_3d_.at( id )[level][cType];
+   // domain of surrogates
+   const PolyDomain X( level );
+   // local element matrix
+   Matrix10r elMat( Matrix10r::Zero() );
+   // iterate over all micro-cells
+   indexing::Index micro;
+   const auto      row_end = idx_t( celldof::macrocell::numCellsPerRowByType( level, cType ) );
+   // entries of the local element matrices of all micro-cells in the current row
+   std::vector< real_t > rowValues( uint_t( surrogate.size() ) * uint_t( row_end ) );
+   for ( micro.z() = 0; micro.z() < row_end; micro.z()++ )
+   {
+      // restrict to 2d polynomial
+      const auto z = X[micro.z()];
+      for ( idx_t i = 0; i < surrogate.rows(); ++i )
+      {
+         const idx_t j_end = Symmetric ? i + 1 : surrogate.cols();
+         for ( idx_t j = 0; j < j_end; ++j )
+         {
+            surrogate( i, j ).fix_z( z );
+         }
+      }
+
+      for ( micro.y() = 0; micro.y() < row_end - micro.z(); micro.y()++ )
+      {
+         // restrict to 1d polynomial and evaluate it for the whole row at once
+         const auto y     = X[micro.y()];
+         const auto n_row = uint_t( row_end - micro.z() - micro.y() );
+         for ( idx_t i = 0; i < surrogate.rows(); ++i )
+         {
+            const idx_t j_end = Symmetric ? i + 1 : surrogate.cols();
+            for ( idx_t j = 0; j < j_end; ++j )
+            {
+               surrogate( i, j ).fix_y( y );
+               surrogate( i, j ).eval_line( X[0], X.scaling, n_row, &rowValues[uint_t( i * surrogate.cols() + j ) * n_row] );
+            }
+         }
+
+         for ( micro.x() = 0; micro.x() < idx_t( n_row ); micro.x()++ )
+         {
+            for ( idx_t i = 0; i < surrogate.rows(); ++i )
+            {
+               const idx_t j_end = Symmetric ? i + 1 : surrogate.cols();
+               for ( idx_t j = 0; j < j_end; ++j )
+               {
+                  elMat( i, j ) = rowValues[uint_t( i * surrogate.cols() + j ) * n_row + uint_t( micro.x() )];
+                  if constexpr ( Symmetric )
+                  {
+                     elMat( j, i ) = elMat( i, j );
+                  }
+               }
+            }
+
+            elementOperation( micro, elMat );
+         }
+      }
+   }
+}
+
+template < class P2Form, uint8_t DEGREE, bool Symmetric >
+void P2ElementwiseSurrogateOperator< P2Form, DEGREE, Symmetric >::apply( const P2Function< real_t >& src,
+                                                                         const P2Function< real_t >& dst,
+                                                                         size_t                      level,
+                                                                         DoFType                     flag,
+                                                                         UpdateType                  updateType ) const
+{
+   return gemv( real_c( 1 ), src, ( updateType == Replace ? real_c( 0 ) : real_c( 1 ) ), dst, level, flag );
+}
+
+template < class P2Form, uint8_t DEGREE, bool Symmetric >
+void P2ElementwiseSurrogateOperator< P2Form, DEGREE, Symmetric >::gemv( const real_t&               alpha,
+                                                                        const P2Function< real_t >& src,
+                                                                        const real_t&               beta,
+                                                                        const P2Function< real_t >& dst,
+                                                                        size_t                      level,
+                                                                        DoFType                     flag ) const
+{
+   WALBERLA_ASSERT_NOT_IDENTICAL( std::addressof( src ), std::addressof( dst ) );
+   WALBERLA_CHECK( is_initialized_, "P2ElementwiseSurrogateOperator must be initialized by calling init() before use." );
+
+   this->startTiming( "gemv" );
+
+   // Make sure that halos are up-to-date
+   // Note that the order of communication is important, since the face -> cell communication may overwrite
+   // parts of the halos that carry the macro-vertex and macro-edge unknowns.
+   src.communicate< Face, Cell >( level );
+   src.communicate< Edge, Cell >( level );
+   src.communicate< Vertex, Cell >( level );
+
+   // Formerly updateType == Replace
+   const bool betaIsZero = std::fpclassify( beta ) == FP_ZERO;
+   // Formerly updateType == Add
+   const bool betaIsOne = std::fpclassify( beta - real_c( 1.0 ) ) == FP_ZERO;
+
+   if ( betaIsZero )
+   {
+      // We need to zero the destination array (including halos).
+      // However, we must not zero out anything that is not flagged with the specified BCs.
+      // Therefore we first zero out everything that flagged, and then, later,
+      // the halos of the highest dim primitives.
+      dst.interpolate( real_c( 0 ), level, flag );
+   }
+   else if ( !betaIsOne )
+   {
+      dst.assign( { beta }, { dst }, level, flag );
+   }
+
+   // we only perform computations on cell primitives
+   for ( auto& macroIter : storage_->getCells() )
+   {
+      Cell& cell = *macroIter.second;
+
+      // get hold of the actual numerical data in the two functions
+      const real_t* srcVertexData = cell.getData( src.getVertexDoFFunction().getCellDataID() )->getPointer( level );
+      const real_t* srcEdgeData   = cell.getData( src.getEdgeDoFFunction().getCellDataID() )->getPointer( level );
+      real_t*       dstVertexData = cell.getData( dst.getVertexDoFFunction().getCellDataID() )->getPointer( level );
+      real_t*       dstEdgeData   = cell.getData( dst.getEdgeDoFFunction().getCellDataID() )->getPointer( level );
+
+      // Zero out dst halos only
+      //
+      // This is also necessary when using update type == Add.
+      // During additive comm we then skip zeroing the data on the lower-dim primitives.
+      for ( const auto& idx : vertexdof::macrocell::Iterator( level ) )
+      {
+         if ( !vertexdof::macrocell::isOnCellFace( idx, level ).empty() )
+         {
+            auto arrayIdx           = vertexdof::macrocell::index( level, idx.x(), idx.y(), idx.z() );
+            dstVertexData[arrayIdx] = real_c( 0 );
+         }
+      }
+
+      for ( const auto& idx : edgedof::macrocell::Iterator( level ) )
+      {
+         for ( const auto& orientation : edgedof::allEdgeDoFOrientationsWithoutXYZ )
+         {
+            if ( !edgedof::macrocell::isInnerEdgeDoF( level, idx, orientation ) )
+            {
+               auto arrayIdx         = edgedof::macrocell::index( level, idx.x(), idx.y(), idx.z(), orientation );
+               dstEdgeData[arrayIdx] = real_c( 0 );
+            }
+         }
+      }
+
+      // local mat-vec
+      for ( const auto& cType : celldof::allCellTypes )
+      {
+         forEachLocalElementMatrix( cell, level, cType, [&]( const indexing::Index& micro, const Matrix10r& elMat ) {
+            localMatrixVectorMultiply3D(
+                level, micro, cType, srcVertexData, srcEdgeData, dstVertexData, dstEdgeData, elMat, alpha );
+         } );
+      }
+   }
+
+   // Push result to lower-dimensional primitives
+   //
+   // Note: We could avoid communication here by implementing the apply() also for the respective
+   //       lower dimensional primitives!
+   dst.getVertexDoFFunction().communicateAdditively< Cell, Face >( level, DoFType::All ^ flag, *storage_, betaIsZero );
+   dst.getVertexDoFFunction().communicateAdditively< Cell, Edge >( level, DoFType::All ^ flag, *storage_, betaIsZero );
+   dst.getVertexDoFFunction().communicateAdditively< Cell, Vertex >( level, DoFType::All ^ flag, *storage_, betaIsZero );
+   dst.getEdgeDoFFunction().communicateAdditively< Cell, Face >( level, DoFType::All ^ flag, *storage_, betaIsZero );
+   dst.getEdgeDoFFunction().communicateAdditively< Cell, Edge >( level, DoFType::All ^ flag, *storage_, betaIsZero );
+
+   this->stopTiming( "gemv" );
+}
+
+template < class P2Form, uint8_t DEGREE, bool Symmetric >
+void P2ElementwiseSurrogateOperator< P2Form, DEGREE, Symmetric >::smooth_jac( const P2Function< real_t >& dst,
+                                                                              const P2Function< real_t >& rhs,
+                                                                              const P2Function< real_t >& src,
+                                                                              real_t                      omega,
+                                                                              size_t                      level,
+                                                                              DoFType                     flag ) const
+{
+   this->startTiming( "smooth_jac" );
+
+   // compute the current residual
+   this->apply( src, dst, level, flag );
+   dst.assign( { real_c( 1 ), real_c( -1 ) }, { rhs, dst }, level, flag );
+
+   // perform Jacobi update step
+   dst.multElementwise( { *getInverseDiagonalValues(), dst }, level, flag );
+   dst.assign( { 1.0, omega }, { src, dst }, level, flag );
+
+   this->stopTiming( "smooth_jac" );
+}
+
+template < class P2Form, uint8_t DEGREE, bool Symmetric >
+void P2ElementwiseSurrogateOperator< P2Form, DEGREE, Symmetric >::computeDiagonalOperatorValues( bool invert )
+{
+   std::shared_ptr< P2Function< real_t > > targetFunction;
+   if ( invert )
+   {
+      if ( !inverseDiagonalValues_ )
+      {
+         inverseDiagonalValues_ =
+             std::make_shared< P2Function< real_t > >( "inverse diagonal entries", storage_, minLevel_, maxLevel_ );
+      }
+      targetFunction = inverseDiagonalValues_;
+   }
+   else
+   {
+      if ( !diagonalValues_ )
+      {
+         diagonalValues_ = std::make_shared< P2Function< real_t > >( "diagonal entries", storage_, minLevel_, maxLevel_ );
+      }
+      targetFunction = diagonalValues_;
+   }
+
+   for ( uint_t level = minLevel_; level <= maxLevel_; level++ )
+   {
+      // Make sure that halos are up-to-date (can we improve communication here?)
+      communication::syncFunctionBetweenPrimitives( *targetFunction, level );
+
+      // Zero destination before performing additive computation
+      targetFunction->setToZero( level );
+
+      // we only perform computations on cell primitives
+      for ( auto& macroIter : storage_->getCells() )
+      {
+         Cell& cell = *macroIter.second;
+
+         // get hold of the actual numerical data
+         real_t* diagVertexData = cell.getData( targetFunction->getVertexDoFFunction().getCellDataID() )->getPointer( level );
+         real_t* diagEdgeData   = cell.getData( targetFunction->getEdgeDoFFunction().getCellDataID() )->getPointer( level );
+
+         // add contributions of all micro-cells to the central stencil weights
+         for ( const auto& cType : celldof::allCellTypes )
+         {
+            forEachLocalElementMatrix( cell, level, cType, [&]( const indexing::Index& micro, const Matrix10r& elMat ) {
+               // obtain data indices of dofs associated with micro-cell
+               std::array< uint_t, 4 > vertexDoFIndices;
+               vertexdof::getVertexDoFDataIndicesFromMicroCell( micro, cType, level, vertexDoFIndices );
+
+               std::array< uint_t, 6 > edgeDoFIndices;
+               edgedof::getEdgeDoFDataIndicesFromMicroCellFEniCSOrdering( micro, cType, level, edgeDoFIndices );
+
+               for ( int k = 0; k < 4; ++k )
+               {
+                  diagVertexData[vertexDoFIndices[uint_c( k )]] += elMat( k, k );
+               }
+               for ( int k = 4; k < 10; ++k )
+               {
+                  diagEdgeData[edgeDoFIndices[uint_c( k - 4 )]] += elMat( k, k );
+               }
+            } );
+         }
+      }
+
+      // Push result to lower-dimensional primitives
+      targetFunction->getVertexDoFFunction().communicateAdditively< Cell, Face >( level );
+      targetFunction->getVertexDoFFunction().communicateAdditively< Cell, Edge >( level );
+      targetFunction->getVertexDoFFunction().communicateAdditively< Cell, Vertex >( level );
+      targetFunction->getEdgeDoFFunction().communicateAdditively< Cell, Face >( level );
+      targetFunction->getEdgeDoFFunction().communicateAdditively< Cell, Edge >( level );
+
+      // Invert values if desired (note: using false below means we only invert in the interior of the primitives,
+      // the values in the halos are untouched; should be okay for using diagonalValue_ in smoothers)
+      if ( invert )
+      {
+         targetFunction->invertElementwise( level, All, false );
+      }
+   }
+}
+
+template class P2ElementwiseSurrogateOperator< forms::p2_div_k_grad_affine_q4, 0, true >;
+template class P2ElementwiseSurrogateOperator< forms::p2_div_k_grad_affine_q4, 1, true >;
+template class P2ElementwiseSurrogateOperator< forms::p2_div_k_grad_affine_q4, 2, true >;
+template class P2ElementwiseSurrogateOperator< forms::p2_div_k_grad_affine_q4, 3, true >;
+template class P2ElementwiseSurrogateOperator< forms::p2_div_k_grad_affine_q4, 4, true >;
+template class P2ElementwiseSurrogateOperator< forms::p2_div_k_grad_affine_q4, 5, true >;
+template class P2ElementwiseSurrogateOperator< forms::p2_div_k_grad_affine_q4, 6, true >;
+template class P2ElementwiseSurrogateOperator< forms::p2_div_k_grad_affine_q4, 7, true >;
+template class P2ElementwiseSurrogateOperator< forms::p2_div_k_grad_affine_q4, 8, true >;
+
+template class P2ElementwiseSurrogateOperator< forms::p2_div_k_grad_blending_q4, 1, true >;
+template class P2ElementwiseSurrogateOperator< forms::p2_div_k_grad_blending_q4, 2, true >;
+template class P2ElementwiseSurrogateOperator< forms::p2_div_k_grad_blending_q4, 3, true >;
+template class P2ElementwiseSurrogateOperator< forms::p2_div_k_grad_blending_q4, 4, true >;
+template class P2ElementwiseSurrogateOperator< forms::p2_div_k_grad_blending_q4, 5, true >;
+template class P2ElementwiseSurrogateOperator< forms::p2_div_k_grad_blending_q4, 6, true >;
+template class P2ElementwiseSurrogateOperator< forms::p2_div_k_grad_blending_q4, 7, true >;
+template class P2ElementwiseSurrogateOperator< forms::p2_div_k_grad_blending_q4, 8, true >;
+
+template class P2ElementwiseSurrogateOperator< forms::p2_diffusion_blending_q3, 1, true >;
+template class P2ElementwiseSurrogateOperator< forms::p2_diffusion_blending_q3, 2, true >;
+template class P2ElementwiseSurrogateOperator< forms::p2_diffusion_blending_q3, 3, true >;
+template class P2ElementwiseSurrogateOperator< forms::p2_diffusion_blending_q3, 4, true >;
+template class P2ElementwiseSurrogateOperator< forms::p2_diffusion_blending_q3, 5, true >;
+template class P2ElementwiseSurrogateOperator< forms::p2_diffusion_blending_q3, 6, true >;
+template class P2ElementwiseSurrogateOperator< forms::p2_diffusion_blending_q3, 7, true >;
+template class P2ElementwiseSurrogateOperator< forms::p2_diffusion_blending_q3, 8, true >;
+
+template class P2ElementwiseSurrogateOperator< forms::p2_mass_blending_q5, 1, true >;
+template class P2ElementwiseSurrogateOperator< forms::p2_mass_blending_q5, 2, true >;
+template class P2ElementwiseSurrogateOperator< forms::p2_mass_blending_q5, 3, true >;
+template class P2ElementwiseSurrogateOperator< forms::p2_mass_blending_q5, 4, true >;
+template class P2ElementwiseSurrogateOperator< forms::p2_mass_blending_q5, 5, true >;
+template class P2ElementwiseSurrogateOperator< forms::p2_mass_blending_q5, 6, true >;
+template class P2ElementwiseSurrogateOperator< forms::p2_mass_blending_q5, 7, true >;
+template class P2ElementwiseSurrogateOperator< forms::p2_mass_blending_q5, 8, true >;
+
+} // namespace hyteg
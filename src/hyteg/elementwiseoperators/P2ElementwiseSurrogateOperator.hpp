@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2026 Nils Kohl, Marcus Mohr.
+ *
+ * This file is part of HyTeG
+ * (see https://i10git.cs.fau.de/hyteg/hyteg).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <hyteg/communication/Syncing.hpp>
+#include <hyteg/elementwiseoperators/P2ElementwiseOperator.hpp>
+#include <hyteg/forms/form_hyteg_generated/p2/p2_diffusion_blending_q3.hpp>
+#include <hyteg/forms/form_hyteg_generated/p2/p2_div_k_grad_affine_q4.hpp>
+#include <hyteg/forms/form_hyteg_generated/p2/p2_div_k_grad_blending_q4.hpp>
+#include <hyteg/forms/form_hyteg_generated/p2/p2_mass_blending_q5.hpp>
+#include <hyteg/operators/Operator.hpp>
+#include <hyteg/p2functionspace/P2Function.hpp>
+#include <hyteg/polynomial/new/data.hpp>
+#include <hyteg/polynomial/new/leastSquares.hpp>
+#include <hyteg/polynomial/new/polynomial.hpp>
+#include <hyteg/solvers/Smoothables.hpp>
+#include <hyteg/volumedofspace/CellDoFIndexing.hpp>
+
+namespace hyteg {
+
+using walberla::real_t;
+
+/// Matrix-free P2 operator on macro-cells whose local element matrices are approximated by polynomials.
+///
+/// For each macro-cell, level and micro-cell type, every entry of the 10x10 local element matrix (i.e. the
+/// vertex-to-vertex, edge-to-vertex, vertex-to-edge and edge-to-edge couplings) is replaced by a polynomial of
+/// degree DEGREE in the position of the micro-cell, which is fitted to the exact element matrices by a least
+/// squares approximation. For blended geometries, this avoids the evaluation of the blending map and the quadrature
+/// in each application, such that the cost of an application is close to that of a constant coefficient operator.
+///
+/// This is the 3D counterpart of P2SurrogateOperator, which approximates the stencils on macro-faces.
+template < class P2Form, uint8_t DEGREE, bool Symmetric = false >
+class P2ElementwiseSurrogateOperator : public Operator< P2Function< real_t >, P2Function< real_t > >,
+                                       public WeightedJacobiSmoothable< P2Function< real_t > >,
+                                       public OperatorWithInverseDiagonal< P2Function< real_t > >
+{
+   /* On lower levels, storing and evaluating polynomials is significantly less performant.
+      Therefore, on levels 0-3 we precompute and store the local element matrices, while we use
+      surrogates for levels 4+
+    */
+   static constexpr uint_t min_lvl_for_surrogate = 4;
+
+   /* Single precision LSQ may lead to very poor accuracy of the resulting polynomials. Therefore,
+      we use real_t for the polynomial evaluation only, while sticking to double precision LSQ.
+    */
+   using Poly       = surrogate::polynomial::Polynomial< real_t, 3, DEGREE >;
+   using PolyDomain = surrogate::polynomial::Domain< real_t >;
+   using LSQ        = surrogate::LeastSquares< double >;
+
+   using RHS_matrix      = surrogate::RHS_matrix< real_t, 3, 2, 2 >;
+   using PrecomputedData = surrogate::PrecomputedData< real_t, 3, 2, 2 >;
+   using SurrogateData   = surrogate::SurrogateData< real_t, 3, 2, 2, DEGREE >;
+
+ public:
+   P2ElementwiseSurrogateOperator( const std::shared_ptr< PrimitiveStorage >& storage, size_t minLevel, size_t maxLevel );
+
+   P2ElementwiseSurrogateOperator( const std::shared_ptr< PrimitiveStorage >& storage,
+                                   size_t                                     minLevel,
+                                   size_t                                     maxLevel,
+                                   const P2Form&                              form );
+
+   /**
+     * @brief Initializes the surrogate polynomials using an lsq-fit
+     *
+     * @param downsampling The downsampling factor to be applied. Default is 0 (auto).
+     * @param path_to_svd The file path to the SVD data. Default is an empty string (compute SVD on first call).
+     * @param needsInverseDiagEntries Flag indicating whether inverse diagonal entries are needed. Default is true.
+     */
+   void init( size_t downsampling = 0, const std::string& path_to_svd = "", bool needsInverseDiagEntries = true );
+
+   void store_svd( const std::string& path_to_svd );
+
+   void apply( const P2Function< real_t >& src,
+               const P2Function< real_t >& dst,
+               size_t                      level,
+               DoFType                     flag,
+               UpdateType                  updateType = Replace ) const override final;
+
+   void gemv( const real_t&               alpha,
+              const P2Function< real_t >& src,
+              const real_t&               beta,
+              const P2Function< real_t >& dst,
+              size_t                      level,
+              DoFType                     flag ) const override final;
+
+   void smooth_jac( const P2Function< real_t >& dst,
+                    const P2Function< real_t >& rhs,
+                    const P2Function< real_t >& src,
+                    real_t                      omega,
+                    size_t                      level,
+                    DoFType                     flag ) const override;
+
+   /// Trigger (re)computation of diagonal matrix entries (central operator weights)
+   /// Allocates the required memory if the function was not yet allocated.
+   void computeDiagonalOperatorValues() { computeDiagonalOperatorValues( false ); }
+
+   /// Trigger (re)computation of inverse diagonal matrix entries (central operator weights)
+   /// Allocates the required memory if the function was not yet allocated.
+   void computeInverseDiagonalOperatorValues() override final { computeDiagonalOperatorValues( true ); }
+
+   std::shared_ptr< P2Function< real_t > > getDiagonalValues() const
+   {
+      WALBERLA_CHECK_NOT_NULLPTR(
+          diagonalValues_,
+          "Diagonal values have not been assembled, call computeDiagonalOperatorValues() to set up this function." )
+      return diagonalValues_;
+   };
+
+   std::shared_ptr< P2Function< real_t > > getInverseDiagonalValues() const override
+   {
+      WALBERLA_CHECK_NOT_NULLPTR(
+          inverseDiagonalValues_,
+          "Inverse diagonal values have not been assembled, call computeInverseDiagonalOperatorValues() to set up this function." )
+      return inverseDiagonalValues_;
+   };
+
+ private:
+   /// calls elementOperation( microCell, elMat ) for all micro-cells of the given type, where elMat is the precomputed
+   /// local element matrix on levels < min_lvl_for_surrogate and the evaluated surrogate otherwise
+   ///
+   /// The surrogates are restricted to one row of micro-cells at a time and evaluated for the whole row at once.
+   ///
+   /// \param cell              macro cell
+   /// \param level             level on which we operate in mesh hierarchy
+   /// \param cType             type of micro-cell (WHITE_UP, BLUE_DOWN, ...)
+   /// \param elementOperation  callable with signature void( const indexing::Index&, const Matrix10r& )
+   template < typename ElementOperation >
+   void forEachLocalElementMatrix( const Cell&             cell,
+                                   const uint_t            level,
+                                   const celldof::CellType cType,
+                                   ElementOperation&&      elementOperation ) const;
+
+   void precompute_local_stiffness_3d( uint_t level );
+   void compute_local_surrogates_3d( uint_t level );
+
+   /// Trigger (re)computation of diagonal matrix entries (central operator weights)
+   /// Allocates the required memory if the function was not yet allocated.
+   ///
+   /// \param invert if true, assembles the function carrying the inverse of the diagonal
+   void computeDiagonalOperatorValues( bool invert );
+
+   P2Form form_;
+
+   bool is_initialized_;
+
+   std::shared_ptr< P2Function< real_t > > diagonalValues_;
+   std::shared_ptr< P2Function< real_t > > inverseDiagonalValues_;
+
+   // least squares approximator for each level
+   std::vector< std::shared_ptr< LSQ > > lsq_;
+   uint_t                                downsampling_;
+
+   // precomputed local element matrices for level 0-3
+   PrecomputedData a_loc_3d_;
+   // surrogates for level 4+ (one poly matrix for each element type)
+   SurrogateData surrogate_3d_;
+};
+
+template < uint8_t DEGREE >
+using P2ElementwiseSurrogateAffineDivKGradOperator =
+    P2ElementwiseSurrogateOperator< forms::p2_div_k_grad_affine_q4, DEGREE, true >;
+
+template < uint8_t DEGREE >
+using P2ElementwiseSurrogateBlendingDivKGradOperator =
+    P2ElementwiseSurrogateOperator< forms::p2_div_k_grad_blending_q4, DEGREE, true >;
+
+template < uint8_t DEGREE >
+using P2ElementwiseSurrogateBlendingLaplaceOperator =
+    P2ElementwiseSurrogateOperator< forms::p2_diffusion_blending_q3, DEGREE, true >;
+
+template < uint8_t DEGREE >
+using P2ElementwiseSurrogateBlendingMassOperator = P2ElementwiseSurrogateOperator< forms::p2_mass_blending_q5, DEGREE, true >;
+
+} // namespace hyteg
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2026 Nils Kohl, Marcus Mohr.
+ *
+ * This file is part of HyTeG
+ * (see https://i10git.cs.fau.de/hyteg/hyteg).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "hyteg/elementwiseoperators/P2ElementwiseOperator.hpp"
+#include "hyteg/forms/form_hyteg_manual/P2FormViscousVar.hpp"
+#include "hyteg/p2functionspace/P2VectorFunction.hpp"
+
+#include "mixed_operator/VectorToVectorOperator.hpp"
+
+namespace hyteg {
+
+using walberla::real_t;
+
+/// Viscous block of the variable viscosity epsilon (FullStokes == false) or full Stokes (FullStokes == true) operator,
+/// assembled from the blocks of forms::P2Form_viscousVar.
+///
+/// Same operator as P2ElementwiseBlendingFullViscousOperator (resp. its epsilon counterpart), but the viscosity is passed as
+/// a coefficient object whose type is known at compile time, see forms::P2Form_viscousVar for the requirements.
+template < typename Coefficient, bool FullStokes >
+class P2ElementwiseVariableViscousOperator : public VectorToVectorOperator< real_t, P2VectorFunction, P2VectorFunction >,
+                                             public OperatorWithInverseDiagonal< P2VectorFunction< real_t > >
+{
+ public:
+   template < uint_t Row, uint_t Col >
+   using BlockOperator = P2ElementwiseOperator< forms::P2Form_viscousVar< Row, Col, Coefficient, FullStokes > >;
+
+   P2ElementwiseVariableViscousOperator( const std::shared_ptr< PrimitiveStorage >& storage,
+                                         size_t                                     minLevel,
+                                         size_t                                     maxLevel,
+                                         const Coefficient&                         viscosity )
+   : VectorToVectorOperator< real_t, P2VectorFunction, P2VectorFunction >( storage, minLevel, maxLevel )
+   {
+      setBlock< 0, 0 >( storage, minLevel, maxLevel, viscosity );
+      setBlock< 0, 1 >( storage, minLevel, maxLevel, viscosity );
+      setBlock< 1, 0 >( storage, minLevel, maxLevel, viscosity );
+      setBlock< 1, 1 >( storage, minLevel, maxLevel, viscosity );
+
+      if ( this->dim_ == 3 )
+      {
+         setBlock< 0, 2 >( storage, minLevel, maxLevel, viscosity );
+         setBlock< 1, 2 >( storage, minLevel, maxLevel, viscosity );
+         setBlock< 2, 0 >( storage, minLevel, maxLevel, viscosity );
+         setBlock< 2, 1 >( storage, minLevel, maxLevel, viscosity );
+         setBlock< 2, 2 >( storage, minLevel, maxLevel, viscosity );
+      }
+   }
+
+   std::shared_ptr< P2VectorFunction< real_t > > getInverseDiagonalValues() const override final
+   {
+      return this->extractInverseDiagonal();
+   }
+
+   void computeInverseDiagonalOperatorValues() override final
+   {
+      this->VectorToVectorOperator< real_t, P2VectorFunction, P2VectorFunction >::computeInverseDiagonalOperatorValues();
+   }
+
+ private:
+   template < uint_t Row, uint_t Col >
+   void setBlock( const std::shared_ptr< PrimitiveStorage >& storage,
+                  size_t                                     minLevel,
+                  size_t                                     maxLevel,
+                  const Coefficient&                         viscosity )
+   {
+      this->subOper_[Row][Col] = std::make_shared< BlockOperator< Row, Col > >(
+          storage, minLevel, maxLevel, forms::P2Form_viscousVar< Row, Col, Coefficient, FullStokes >( viscosity ) );
+   }
+};
+
+} // namespace hyteg
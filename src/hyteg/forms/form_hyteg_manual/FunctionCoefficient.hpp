@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2026 Nils Kohl, Marcus Mohr.
+ *
+ * This file is part of HyTeG
+ * (see https://i10git.cs.fau.de/hyteg/hyteg).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <concepts>
+
+#include "core/debug/Debug.h"
+
+#include "hyteg/edgedofspace/EdgeDoFIndexing.hpp"
+#include "hyteg/indexing/Common.hpp"
+#include "hyteg/p1functionspace/P1Function.hpp"
+#include "hyteg/p1functionspace/VertexDoFIndexing.hpp"
+#include "hyteg/p2functionspace/P2Function.hpp"
+#include "hyteg/primitives/Cell.hpp"
+#include "hyteg/primitives/Face.hpp"
+#include "hyteg/types/Matrix.hpp"
+
+namespace hyteg {
+namespace forms {
+
+/// Coefficients that are given by the DoFs of a finite element function on the same mesh as the operator.
+///
+/// Before integrating over a micro-element, the elementwise operators pass the micro-element to the form, which in turn
+/// hands it to the coefficient (see setMicroElement() of P2ElementwiseOperator). The coefficient gathers the DoFs of
+/// that element and is afterwards evaluated in reference coordinates of the element, i.e. by the local shape functions.
+template < typename Coefficient >
+concept LocalDoFCoefficient = requires( Coefficient                             coefficient,
+                                        const Face&                             face,
+                                        const Cell&                             cell,
+                                        uint_t                                  level,
+                                        const std::array< indexing::Index, 3 >& faceVertices,
+                                        const std::array< indexing::Index, 4 >& cellVertices,
+                                        const Matrixr< 2, 1 >&                  xi2D,
+                                        const Matrixr< 3, 1 >&                  xi3D ) {
+   coefficient.setMicroElement( face, level, faceVertices );
+   coefficient.setMicroElement( cell, level, cellVertices );
+   { coefficient.evaluateOnReferenceElement( xi2D ) } -> std::convertible_to< real_t >;
+   { coefficient.evaluateOnReferenceElement( xi3D ) } -> std::convertible_to< real_t >;
+};
+
+/// Coefficient given by a P1Function, interpolated with the linear shape functions of the micro-element.
+///
+/// Only a pointer to the function is stored, so the function must outlive all forms and operators using the coefficient.
+/// As for the source function of an operator application, the DoFs on the macro-primitive boundaries must be up to date,
+/// i.e. the function must have been communicated (e.g. by communication::syncFunctionBetweenPrimitives()) after it was
+/// last modified.
+class P1FunctionCoefficient
+{
+ public:
+   P1FunctionCoefficient() = default;
+
+   explicit P1FunctionCoefficient( const P1Function< real_t >& function )
+   : function_( &function )
+   {}
+
+   void setMicroElement( const Face& face, uint_t level, const std::array< indexing::Index, 3 >& microVertices )
+   {
+      WALBERLA_ASSERT_NOT_NULLPTR( function_ );
+      const real_t* vertexData = face.getData( function_->getFaceDataID() )->getPointer( level );
+
+      for ( uint_t k = 0; k < 3; ++k )
+      {
+         localDoFs_[k] = vertexData[vertexdof::macroface::index( level, microVertices[k].x(), microVertices[k].y() )];
+      }
+   }
+
+   void setMicroElement( const Cell& cell, uint_t level, const std::array< indexing::Index, 4 >& microVertices )
+   {
+      WALBERLA_ASSERT_NOT_NULLPTR( function_ );
+      const real_t* vertexData = cell.getData( function_->getCellDataID() )->getPointer( level );
+
+      for ( uint_t k = 0; k < 4; ++k )
+      {
+         localDoFs_[k] = vertexData[vertexdof::macrocell::index(
+             level, microVertices[k].x(), microVertices[k].y(), microVertices[k].z() )];
+      }
+   }
+
+   real_t evaluateOnReferenceElement( const Matrixr< 2, 1 >& xi ) const
+   {
+      return ( real_c( 1 ) - xi( 0 ) - xi( 1 ) ) * localDoFs_[0] + xi( 0 ) * localDoFs_[1] + xi( 1 ) * localDoFs_[2];
+   }
+
+   real_t evaluateOnReferenceElement( const Matrixr< 3, 1 >& xi ) const
+   {
+      return ( real_c( 1 ) - xi( 0 ) - xi( 1 ) - xi( 2 ) ) * localDoFs_[0] + xi( 0 ) * localDoFs_[1] + xi( 1 ) * localDoFs_[2] +
+             xi( 2 ) * localDoFs_[3];
+   }
+
+ private:
+   const P1Function< real_t >* function_ = nullptr;
+   std::array< real_t, 4 >     localDoFs_{};
+};
+
+/// Coefficient given by a P2Function, interpolated with the quadratic shape functions of the micro-element.
+///
+/// The local DoFs are ordered as in ShapeFunctionMacros.hpp, i.e. vertex DoFs first and edge DoFs in FEniCS ordering.
+/// The same requirements as for P1FunctionCoefficient apply.
+class P2FunctionCoefficient
+{
+ public:
+   P2FunctionCoefficient() = default;
+
+   explicit P2FunctionCoefficient( const P2Function< real_t >& function )
+   : function_( &function )
+   {}
+
+   void setMicroElement( const Face& face, uint_t level, const std::array< indexing::Index, 3 >& microVertices )
+   {
+      WALBERLA_ASSERT_NOT_NULLPTR( function_ );
+      const real_t* vertexData = face.getData( function_->getVertexDoFFunction().getFaceDataID() )->getPointer( level );
+      const real_t* edgeData   = face.getData( function_->getEdgeDoFFunction().getFaceDataID() )->getPointer( level );
+
+      for ( uint_t k = 0; k < 3; ++k )
+      {
+         localDoFs_[k] = vertexData[vertexdof::macroface::index( level, microVertices[k].x(), microVertices[k].y() )];
+      }
+
+      const std::array< std::pair< uint_t, uint_t >, 3 > edges = {
+          std::make_pair( 1, 2 ), std::make_pair( 0, 2 ), std::make_pair( 0, 1 ) };
+      for ( uint_t k = 0; k < 3; ++k )
+      {
+         const indexing::Index& vertex0 = microVertices[edges[k].first];
+         const indexing::Index& vertex1 = microVertices[edges[k].second];
+         const indexing::Index  edgeIdx = edgedof::calcEdgeDoFIndex( vertex0, vertex1 );
+
+         localDoFs_[3 + k] = edgeData[edgedof::macroface::index(
+             level, edgeIdx.x(), edgeIdx.y(), edgedof::calcEdgeDoFOrientation( vertex0, vertex1 ) )];
+      }
+   }
+
+   void setMicroElement( const Cell& cell, uint_t level, const std::array< indexing::Index, 4 >& microVertices )
+   {
+      WALBERLA_ASSERT_NOT_NULLPTR( function_ );
+      const real_t* vertexData = cell.getData( function_->getVertexDoFFunction().getCellDataID() )->getPointer( level );
+      const real_t* edgeData   = cell.getData( function_->getEdgeDoFFunction().getCellDataID() )->getPointer( level );
+
+      for ( uint_t k = 0; k < 4; ++k )
+      {
+         localDoFs_[k] = vertexData[vertexdof::macrocell::index(
+             level, microVertices[k].x(), microVertices[k].y(), microVertices[k].z() )];
+      }
+
+      std::array< uint_t, 6 > edgeDoFIndices;
+      edgedof::getEdgeDoFDataIndicesFromMicroVerticesFEniCSOrdering( microVertices, level, edgeDoFIndices );
+      for ( uint_t k = 0; k < 6; ++k )
+      {
+         localDoFs_[4 + k] = edgeData[edgeDoFIndices[k]];
+      }
+   }
+
+   real_t evaluateOnReferenceElement( const Matrixr< 2, 1 >& xi ) const
+   {
+      const real_t L1 = real_c( 1 ) - xi( 0 ) - xi( 1 );
+      const real_t L2 = xi( 0 );
+      const real_t L3 = xi( 1 );
+
+      return L1 * ( 2 * L1 - 1 ) * localDoFs_[0] + L2 * ( 2 * L2 - 1 ) * localDoFs_[1] + L3 * ( 2 * L3 - 1 ) * localDoFs_[2] +
+             4 * ( L2 * L3 * localDoFs_[3] + L1 * L3 * localDoFs_[4] + L1 * L2 * localDoFs_[5] );
+   }
+
+   real_t evaluateOnReferenceElement( const Matrixr< 3, 1 >& xi ) const
+   {
+      const real_t L1 = real_c( 1 ) - xi( 0 ) - xi( 1 ) - xi( 2 );
+      const real_t L2 = xi( 0 );
+      const real_t L3 = xi( 1 );
+      const real_t L4 = xi( 2 );
+
+      return L1 * ( 2 * L1 - 1 ) * localDoFs_[0] + L2 * ( 2 * L2 - 1 ) * localDoFs_[1] + L3 * ( 2 * L3 - 1 ) * localDoFs_[2] +
+             L4 * ( 2 * L4 - 1 ) * localDoFs_[3] +
+             4 * ( L3 * L4 * localDoFs_[4] + L2 * L4 * localDoFs_[5] + L2 * L3 * localDoFs_[6] + L1 * L4 * localDoFs_[7] +
+                   L1 * L3 * localDoFs_[8] + L1 * L2 * localDoFs_[9] );
+   }
+
+ private:
+   const P2Function< real_t >* function_ = nullptr;
+   std::array< real_t, 10 >    localDoFs_{};
+};
+
+} // namespace forms
+} // namespace hyteg
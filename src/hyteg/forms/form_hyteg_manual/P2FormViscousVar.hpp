@@ -0,0 +1,461 @@
+/*
+ * Copyright (c) 2026 Nils Kohl, Marcus Mohr.
+ *
+ * This file is part of HyTeG
+ * (see https://i10git.cs.fau.de/hyteg/hyteg).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "core/debug/CheckFunctions.h"
+
+#include "hyteg/forms/form_hyteg_base/P2FormHyTeG.hpp"
+#include "hyteg/geometry/GeometryMap.hpp"
+#include "hyteg/types/Matrix.hpp"
+#include "hyteg/types/PointND.hpp"
+
+#include "hyteg/forms/form_hyteg_manual/FunctionCoefficient.hpp"
+#include "hyteg/forms/form_hyteg_manual/QuadratureRules.hpp"
+
+namespace hyteg {
+namespace forms {
+
+/// Coefficient for P2Form_viscousVar that wraps a callback.
+///
+/// The callback is still called through the std::function at every quadrature point, so this only
+/// serves as a drop-in for code that has nothing but a callback at hand.
+class CallbackCoefficient
+{
+ public:
+   CallbackCoefficient() = default;
+
+   explicit CallbackCoefficient( std::function< real_t( const Point3D& ) > callback )
+   : callback_( std::move( callback ) )
+   {}
+
+   real_t operator()( const Point3D& x ) const { return callback_( x ); }
+
+ private:
+   std::function< real_t( const Point3D& ) > callback_;
+};
+
+/// Coefficient for P2Form_viscousVar that interpolates a radial profile (e.g. of the viscosity) linearly.
+///
+/// Outside of the sampled radii the profile is extended by the first and last value, respectively.
+/// The samples are shared between all copies, since the elementwise operators copy the form for every element.
+class RadialProfileCoefficient
+{
+ public:
+   RadialProfileCoefficient() = default;
+
+   /// \param radii  sample radii in strictly ascending order
+   /// \param values profile values at the sample radii
+   RadialProfileCoefficient( const std::vector< real_t >& radii, const std::vector< real_t >& values )
+   : profile_( std::make_shared< const Profile >( Profile{ radii, values } ) )
+   {
+      WALBERLA_CHECK_EQUAL( radii.size(), values.size() );
+      WALBERLA_CHECK_GREATER_EQUAL( radii.size(), uint_t( 2 ) );
+      WALBERLA_CHECK( std::is_sorted( radii.begin(), radii.end() ) &&
+                          std::adjacent_find( radii.begin(), radii.end() ) == radii.end(),
+                      "Radii of the profile must be strictly ascending." );
+   }
+
+   real_t operator()( const Point3D& x ) const
+   {
+      const auto&  radii  = profile_->radii;
+      const auto&  values = profile_->values;
+      const real_t r      = x.norm();
+
+      if ( r <= radii.front() )
+      {
+         return values.front();
+      }
+      if ( r >= radii.back() )
+      {
+         return values.back();
+      }
+
+      // radii[idx - 1] <= r < radii[idx]
+      const auto   idx = static_cast< uint_t >( std::upper_bound( radii.begin(), radii.end(), r ) - radii.begin() );
+      const real_t t   = ( r - radii[idx - 1] ) / ( radii[idx] - radii[idx - 1] );
+      return ( real_c( 1 ) - t ) * values[idx - 1] + t * values[idx];
+   }
+
+ private:
+   struct Profile
+   {
+      std::vector< real_t > radii;
+      std::vector< real_t > values;
+   };
+
+   std::shared_ptr< const Profile > profile_;
+};
+
+namespace detail {
+
+/// Quadrature points and weights on the reference element together with the reference gradients of the P2 shape
+/// functions (ordered as in ShapeFunctionMacros.hpp) at these points. Column i of gradients[q] is the gradient of
+/// shape function i.
+template < uint_t Dim >
+struct P2ViscousVarReferenceData
+{
+   static constexpr uint_t numDoFs   = Dim == 2 ? 6 : 10;
+   static constexpr uint_t numPoints = Dim == 2 ? 7 : 5;
+
+   std::array< Matrixr< int( Dim ), 1 >, numPoints >              points;
+   std::array< real_t, numPoints >                                weights;
+   std::array< Matrixr< int( Dim ), int( numDoFs ) >, numPoints > gradients;
+};
+
+/// 2DD-5, exact up to order 3
+inline const P2ViscousVarReferenceData< 2 >& p2ViscousVarReferenceData2D()
+{
+   static const P2ViscousVarReferenceData< 2 > data = []() {
+      P2ViscousVarReferenceData< 2 > d;
+      for ( uint_t q = 0; q < d.numPoints; ++q )
+      {
+         const real_t L2 = quadrature::D5_points[q][0];
+         const real_t L3 = quadrature::D5_points[q][1];
+         const real_t L1 = real_c( 1 ) - L2 - L3;
+
+         const real_t zero = real_c( 0 );
+
+         d.points[q] << L2, L3;
+         d.weights[q] = quadrature::D5_weights[q];
+
+         // clang-format off
+         d.gradients[q] << 1 - 4 * L1, 4 * L2 - 1, zero,       4 * L3, -4 * L3,         4 * L1 - 4 * L2,
+                           1 - 4 * L1, zero,       4 * L3 - 1, 4 * L2, 4 * L1 - 4 * L3, -4 * L2;
+         // clang-format on
+      }
+      return d;
+   }();
+   return data;
+}
+
+/// 3DT-5, exact up to order 3
+inline const P2ViscousVarReferenceData< 3 >& p2ViscousVarReferenceData3D()
+{
+   static const P2ViscousVarReferenceData< 3 > data = []() {
+      P2ViscousVarReferenceData< 3 > d;
+      for ( uint_t q = 0; q < d.numPoints; ++q )
+      {
+         const real_t L2 = cubature::T5_points[q][0];
+         const real_t L3 = cubature::T5_points[q][1];
+         const real_t L4 = cubature::T5_points[q][2];
+         const real_t L1 = real_c( 1 ) - L2 - L3 - L4;
+
+         const real_t zero = real_c( 0 );
+
+         d.points[q] << L2, L3, L4;
+         d.weights[q] = cubature::T5_weights[q];
+
+         // clang-format off
+         d.gradients[q] << 1 - 4 * L1, 4 * L2 - 1, zero,       zero,       zero,   4 * L4, 4 * L3, -4 * L4,         -4 * L3,         4 * L1 - 4 * L2,
+                           1 - 4 * L1, zero,       4 * L3 - 1, zero,       4 * L4, zero,   4 * L2, -4 * L4,         4 * L1 - 4 * L3, -4 * L2,
+                           1 - 4 * L1, zero,       zero,       4 * L4 - 1, 4 * L3, 4 * L2, zero,   4 * L1 - 4 * L4, -4 * L3,         -4 * L2;
+         // clang-format on
+      }
+      return d;
+   }();
+   return data;
+}
+
+/// Integrates a P2 element matrix whose integrand depends on the physical shape function gradients, weighted by
+/// a variable coefficient. For every quadrature point, kernel( factor, grad, elMat ) has to add the contribution, where
+/// factor includes the quadrature weight, the absolute value of the Jacobian determinant and the coefficient, and column
+/// i of grad is the physical gradient of shape function i.
+///
+/// Coefficients satisfying LocalDoFCoefficient are evaluated in reference coordinates, all others at the physical
+/// quadrature points.
+template < uint_t Dim, typename Coefficient, typename ElementMatrix, typename Kernel >
+void integrateP2VariableCoefficient( const std::array< Point3D, Dim + 1 >&           coords,
+                                     const std::shared_ptr< GeometryMap >&           geometryMap,
+                                     const Coefficient&                              coefficient,
+                                     const detail::P2ViscousVarReferenceData< Dim >& data,
+                                     ElementMatrix&                                  elMat,
+                                     Kernel&&                                        kernel )
+{
+   using MatrixDim      = Matrixr< int( Dim ), int( Dim ) >;
+   using MatrixGradient = Matrixr< int( Dim ), int( detail::P2ViscousVarReferenceData< Dim >::numDoFs ) >;
+
+   constexpr bool needsPhysicalPoint = !LocalDoFCoefficient< Coefficient >;
+
+   elMat.setZero();
+
+   // affine map from the reference to the computational element
+   MatrixDim affineJacobian;
+   for ( uint_t d = 0; d < Dim; ++d )
+   {
+      for ( uint_t k = 0; k < Dim; ++k )
+      {
+         affineJacobian( int( d ), int( k ) ) = coords[k + 1][d] - coords[0][d];
+      }
+   }
+
+   // for affine blending the Jacobian is constant and the physical coordinates depend affinely on the computational ones
+   const bool isAffine         = geometryMap == nullptr || geometryMap->isAffine();
+   MatrixDim  blendingJacobian = MatrixDim::Identity();
+   Point3D    physicalOrigin   = coords[0];
+   if ( isAffine && geometryMap != nullptr && !geometryMap->isIdentity() )
+   {
+      geometryMap->evalF( coords[0], physicalOrigin );
+      geometryMap->evalDF( coords[0], blendingJacobian );
+   }
+
+   MatrixDim jacobian     = blendingJacobian * affineJacobian;
+   MatrixDim jacobianInvT = jacobian.inverse().transpose();
+   real_t    absDet       = std::abs( jacobian.determinant() );
+
+   for ( uint_t q = 0; q < data.numPoints; ++q )
+   {
+      Point3D computationalPoint = coords[0];
+      for ( uint_t k = 0; k < Dim; ++k )
+      {
+         computationalPoint += data.points[q]( int( k ) ) * ( coords[k + 1] - coords[0] );
+      }
+
+      Point3D physicalPoint = physicalOrigin;
+      if ( isAffine )
+      {
+         if constexpr ( needsPhysicalPoint )
+         {
+            for ( uint_t d = 0; d < Dim; ++d )
+            {
+               for ( uint_t k = 0; k < Dim; ++k )
+               {
+                  physicalPoint[d] += blendingJacobian( int( d ), int( k ) ) * ( computationalPoint[k] - coords[0][k] );
+               }
+            }
+         }
+      }
+      else
+      {
+         if constexpr ( needsPhysicalPoint )
+         {
+            geometryMap->evalF( computationalPoint, physicalPoint );
+         }
+         geometryMap->evalDF( computationalPoint, blendingJacobian );
+         jacobian     = blendingJacobian * affineJacobian;
+         jacobianInvT = jacobian.inverse().transpose();
+         absDet       = std::abs( jacobian.determinant() );
+      }
+
+      real_t value;
+      if constexpr ( needsPhysicalPoint )
+      {
+         value = coefficient( physicalPoint );
+      }
+      else
+      {
+         value = coefficient.evaluateOnReferenceElement( data.points[q] );
+      }
+
+      const MatrixGradient grad = jacobianInvT * data.gradients[q];
+      kernel( data.weights[q] * absDet * value, grad, elMat );
+   }
+}
+
+} // namespace detail
+
+/// \brief Block ( Row, Col ) of the variable viscosity epsilon or full Stokes operator.
+///
+/// Implements the weak forms
+///
+///     epsilon:      ∫ 2 μ ε(u) : ε(v)
+///     full Stokes:  ∫ 2 μ ε(u) : ε(v) - (2/3) μ (∇ · u) (∇ · v)
+///
+/// where Row is the component of the test function v and Col that of the trial function u. These are the same forms as
+/// p2_epsilonvar_*_blending_q2 and p2_full_stokesvar_*_blending_q3.
+///
+/// The generated forms call the viscosity through a std::function and the blending map twice per quadrature point.
+/// Here, the viscosity is a template parameter instead. Any copyable type providing
+///
+///     real_t operator()( const Point3D& x ) const
+///
+/// (x in physical coordinates) can be used and is inlined into the quadrature loop. As the class is final and
+/// P2ElementwiseOperator integrates on a copy of the concrete form type, integrateAll() is bound statically.
+/// Affine blending maps are evaluated only once per element.
+///
+/// Alternatively, the viscosity can be a finite element function on the same mesh (see LocalDoFCoefficient, e.g.
+/// P1FunctionCoefficient and P2FunctionCoefficient). It is then interpolated from the DoFs of the current micro-element,
+/// which P2ElementwiseOperator passes via setMicroElement() before each integration.
+///
+/// The quadrature is exact for integrands of order 3, as for the q3 forms. P2ElementwiseOperator is instantiated for
+/// the coefficients above. Other coefficient types require explicit instantiations in P2ElementwiseOperator.cpp,
+/// as any other form. Default construction is only meaningful for stateless coefficients.
+template < uint_t Row, uint_t Col, typename Coefficient, bool FullStokes >
+class P2Form_viscousVar final : public P2FormHyTeG
+{
+   static_assert( Row < 3 && Col < 3, "P2Form_viscousVar: invalid block index." );
+
+ public:
+   P2Form_viscousVar() = default;
+
+   explicit P2Form_viscousVar( const Coefficient& viscosity )
+   : viscosity_( viscosity )
+   {}
+
+   void setMicroElement( const Face& face, uint_t level, const std::array< indexing::Index, 3 >& microVertices )
+      requires LocalDoFCoefficient< Coefficient >
+   {
+      viscosity_.setMicroElement( face, level, microVertices );
+   }
+
+   void setMicroElement( const Cell& cell, uint_t level, const std::array< indexing::Index, 4 >& microVertices )
+      requires LocalDoFCoefficient< Coefficient >
+   {
+      viscosity_.setMicroElement( cell, level, microVertices );
+   }
+
+   void integrateAll( const std::array< Point3D, 3 >& coords, Matrix6r& elMat ) const final
+   {
+      integrateAllImpl< 2 >( coords, elMat, detail::p2ViscousVarReferenceData2D() );
+   }
+
+   void integrateAll( const std::array< Point3D, 4 >& coords, Matrix10r& elMat ) const final
+   {
+      integrateAllImpl< 3 >( coords, elMat, detail::p2ViscousVarReferenceData3D() );
+   }
+
+   void integrateRow0( const std::array< Point3D, 3 >& coords, Matrixr< 1, 6 >& elMat ) const final
+   {
+      Matrix6r elMatAll;
+      integrateAll( coords, elMatAll );
+      elMat = elMatAll.row( 0 );
+   }
+
+   void integrateRow0( const std::array< Point3D, 4 >& coords, Matrixr< 1, 10 >& elMat ) const final
+   {
+      Matrix10r elMatAll;
+      integrateAll( coords, elMatAll );
+      elMat = elMatAll.row( 0 );
+   }
+
+ private:
+   template < uint_t Dim, typename ElementMatrix >
+   void integrateAllImpl( const std::array< Point3D, Dim + 1 >&           coords,
+                          ElementMatrix&                                  elMat,
+                          const detail::P2ViscousVarReferenceData< Dim >& data ) const
+   {
+      if constexpr ( Row >= Dim || Col >= Dim )
+      {
+         WALBERLA_UNUSED( coords );
+         WALBERLA_UNUSED( data );
+         elMat.setZero();
+         WALBERLA_ABORT( "P2Form_viscousVar: block ( " << Row << ", " << Col << " ) does not exist in " << Dim << "D." );
+      }
+      else
+      {
+         // elMat( i, j ) couples test function i and trial function j
+         detail::integrateP2VariableCoefficient< Dim >(
+             coords, geometryMap_, viscosity_, data, elMat, []( real_t factor, const auto& grad, ElementMatrix& mat ) {
+                mat.noalias() += factor * grad.row( int( Col ) ).transpose() * grad.row( int( Row ) );
+                if constexpr ( Row == Col )
+                {
+                   mat.noalias() += factor * grad.transpose() * grad;
+                }
+                if constexpr ( FullStokes )
+                {
+                   mat.noalias() -=
+                       ( real_c( 2.0 / 3.0 ) * factor ) * grad.row( int( Row ) ).transpose() * grad.row( int( Col ) );
+                }
+             } );
+      }
+   }
+
+   Coefficient viscosity_;
+};
+
+template < uint_t Row, uint_t Col, typename Coefficient >
+using P2Form_epsilonVar = P2Form_viscousVar< Row, Col, Coefficient, false >;
+
+template < uint_t Row, uint_t Col, typename Coefficient >
+using P2Form_fullStokesVar = P2Form_viscousVar< Row, Col, Coefficient, true >;
+
+/// \brief Variable coefficient diffusion form ∫ k ∇u · ∇v.
+///
+/// Same form as p2_div_k_grad_blending_q4, but with the coefficient k as a template parameter, see P2Form_viscousVar for
+/// the admissible coefficient types. In particular, k can be a P1 or P2 function on the same mesh, which is then
+/// interpolated locally instead of being evaluated through P2Function::evaluate() at the physical quadrature points.
+///
+/// The quadrature is exact for integrands of order 3, i.e. for piecewise linear k on affine elements.
+template < typename Coefficient >
+class P2Form_divKGradVar final : public P2FormHyTeG
+{
+ public:
+   P2Form_divKGradVar() = default;
+
+   explicit P2Form_divKGradVar( const Coefficient& k )
+   : k_( k )
+   {}
+
+   void setMicroElement( const Face& face, uint_t level, const std::array< indexing::Index, 3 >& microVertices )
+      requires LocalDoFCoefficient< Coefficient >
+   {
+      k_.setMicroElement( face, level, microVertices );
+   }
+
+   void setMicroElement( const Cell& cell, uint_t level, const std::array< indexing::Index, 4 >& microVertices )
+      requires LocalDoFCoefficient< Coefficient >
+   {
+      k_.setMicroElement( cell, level, microVertices );
+   }
+
+   void integrateAll( const std::array< Point3D, 3 >& coords, Matrix6r& elMat ) const final
+   {
+      const auto& data   = detail::p2ViscousVarReferenceData2D();
+      const auto   kernel = []( real_t factor, const auto& grad, Matrix6r& mat ) {
+         mat.noalias() += factor * grad.transpose() * grad;
+      };
+      detail::integrateP2VariableCoefficient< 2 >( coords, geometryMap_, k_, data, elMat, kernel );
+   }
+
+   void integrateAll( const std::array< Point3D, 4 >& coords, Matrix10r& elMat ) const final
+   {
+      const auto& data   = detail::p2ViscousVarReferenceData3D();
+      const auto   kernel = []( real_t factor, const auto& grad, Matrix10r& mat ) {
+         mat.noalias() += factor * grad.transpose() * grad;
+      };
+      detail::integrateP2VariableCoefficient< 3 >( coords, geometryMap_, k_, data, elMat, kernel );
+   }
+
+   void integrateRow0( const std::array< Point3D, 3 >& coords, Matrixr< 1, 6 >& elMat ) const final
+   {
+      Matrix6r elMatAll;
+      integrateAll( coords, elMatAll );
+      elMat = elMatAll.row( 0 );
+   }
+
+   void integrateRow0( const std::array< Point3D, 4 >& coords, Matrixr< 1, 10 >& elMat ) const final
+   {
+      Matrix10r elMatAll;
+      integrateAll( coords, elMatAll );
+      elMat = elMatAll.row( 0 );
+   }
+
+ private:
+   Coefficient k_;
+};
+
+} // namespace forms
+} // namespace hyteg
@@ -119,5 +119,15 @@ static const std::array< Point3D, 15 > T4_points = { Point3D( 0.25, 0.25, 0.25 )
                                                      Point3D( 0.44364916731037085, 0.056350832689629156, 0.44364916731037085 ),
                                                      Point3D( 0.056350832689629156, 0.44364916731037085, 0.44364916731037085 ) };
 
+/// 3DT-5: exact for polynomial integrands up to order 3 (note the negative weight)
+/// Stroud's T3:3-1 scheme, same points as used by the generated q3 forms
+static const std::array< Point3D, 5 > T5_points = { Point3D( 0.25, 0.25, 0.25 ),
+                                                    Point3D( 1.0 / 6.0, 1.0 / 6.0, 1.0 / 6.0 ),
+                                                    Point3D( 0.5, 1.0 / 6.0, 1.0 / 6.0 ),
+                                                    Point3D( 1.0 / 6.0, 0.5, 1.0 / 6.0 ),
+                                                    Point3D( 1.0 / 6.0, 1.0 / 6.0, 0.5 ) };
+
+static const std::array< real_t, 5 > T5_weights = { -2.0 / 15.0, 3.0 / 40.0, 3.0 / 40.0, 3.0 / 40.0, 3.0 / 40.0 };
+
 } // namespace cubature
 } // namespace hyteg
@@ -0,0 +1,405 @@
+/*
+ * Copyright (c) 2026 Nils Kohl, Marcus Mohr.
+ *
+ * This file is part of HyTeG
+ * (see https://i10git.cs.fau.de/hyteg/hyteg).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "core/DataTypes.h"
+#include "core/debug/CheckFunctions.h"
+#include "core/mpi/BufferSystem.h"
+#include "core/mpi/Gatherv.h"
+#include "core/mpi/MPIManager.h"
+
+#include "hyteg/communication/MPITagProvider.hpp"
+#include "hyteg/geometry/BlendingHelpers.hpp"
+#include "hyteg/geometry/PrimitiveBoundingVolumeHierarchy.hpp"
+#include "hyteg/primitivestorage/PrimitiveStorage.hpp"
+#include "hyteg/types/Matrix.hpp"
+#include "hyteg/types/PointND.hpp"
+
+/// @file BatchEvaluation.hpp
+///
+/// Building blocks for the evaluation of finite element functions at many points at once
+/// (see e.g. P1Function::evaluateBatch() and P2Function::evaluateBatch()).
+///
+/// Compared to calling evaluate() for each point, the points are first located in the macro-primitives and then
+/// evaluated grouped by macro-primitive and sorted by the micro-element they fall into. This way consecutive
+/// evaluations access neighboring memory of the same macro-primitive instead of jumping around in the function data.
+
+namespace hyteg {
+
+using walberla::real_c;
+using walberla::real_t;
+using walberla::uint_c;
+using walberla::uint_t;
+
+/// Result of the point location step of a batched evaluation.
+struct BatchEvaluationPointLocation
+{
+   bool        found = false;
+   PrimitiveID primitiveID;
+   Point3D     computationalCoords;
+
+   /// index of the micro-element the point falls into, only used for sorting
+   uint_t microElementKey = 0;
+};
+
+/// \brief Locates the passed points in the process-local macro-faces (2D) or macro-cells (3D).
+///
+/// The search parameters have the same meaning as in mapFromPhysicalToComputationalDomain2D/3D().
+inline std::vector< BatchEvaluationPointLocation > locatePointsForBatchEvaluation( const std::shared_ptr< PrimitiveStorage >& storage,
+                                                                                   std::span< const Point3D > physicalCoords,
+                                                                                   uint_t                     level,
+                                                                                   real_t searchToleranceRadius,
+                                                                                   real_t distanceTolerance,
+                                                                                   bool   useBestGuess )
+{
+   const bool   threeD = storage->hasGlobalCells();
+   const real_t n      = real_c( uint_t( 1 ) << level );
+
+   // looked up once for the whole batch, as the lookup locks the global cache of the hierarchies
+   std::shared_ptr< const PrimitiveBoundingVolumeHierarchy< Cell > > cellHierarchy;
+   std::shared_ptr< const PrimitiveBoundingVolumeHierarchy< Face > > faceHierarchy;
+   if ( threeD )
+   {
+      cellHierarchy = PrimitiveBoundingVolumeHierarchy< Cell >::getForStorage( storage, false );
+   }
+   else
+   {
+      faceHierarchy = PrimitiveBoundingVolumeHierarchy< Face >::getForStorage( storage, false );
+   }
+
+   std::vector< BatchEvaluationPointLocation > locations( physicalCoords.size() );
+
+   for ( uint_t i = 0; i < physicalCoords.size(); ++i )
+   {
+      auto& location = locations[i];
+
+      std::tie( location.found, location.primitiveID, location.computationalCoords ) =
+          threeD ? mapFromPhysicalToComputationalDomain3D(
+                       *cellHierarchy, physicalCoords[i], searchToleranceRadius, distanceTolerance, useBestGuess ) :
+                   mapFromPhysicalToComputationalDomain2D(
+                       *faceHierarchy, physicalCoords[i], searchToleranceRadius, distanceTolerance, useBestGuess );
+
+      if ( !location.found )
+      {
+         continue;
+      }
+
+      // local coordinates of the point w.r.t. the macro-primitive
+      Point3D localCoords;
+      if ( threeD )
+      {
+         const auto& coords = storage->getCell( location.primitiveID )->getCoordinates();
+         Matrix3r    mat;
+         for ( uint_t d = 0; d < 3; ++d )
+         {
+            mat.col( int( d ) ) = coords[d + 1] - coords[0];
+         }
+         localCoords = Point3D( mat.inverse() * ( location.computationalCoords - coords[0] ) );
+      }
+      else
+      {
+         const auto& coords = storage->getFace( location.primitiveID )->getCoordinates();
+         Matrix2r    mat;
+         mat << coords[1][0] - coords[0][0], coords[2][0] - coords[0][0], coords[1][1] - coords[0][1],
+             coords[2][1] - coords[0][1];
+         const Point2D local2D( mat.inverse() * Point2D( location.computationalCoords[0] - coords[0][0],
+                                                         location.computationalCoords[1] - coords[0][1] ) );
+         localCoords = Point3D( local2D[0], local2D[1], real_c( 0 ) );
+      }
+
+      // lexicographic index of the micro-cube (micro-square) that contains the point
+      const uint_t stride = uint_c( n ) + 1;
+      uint_t       key    = 0;
+      for ( int d = int( threeD ? 2 : 1 ); d >= 0; --d )
+      {
+         const real_t clamped = std::clamp( localCoords[d] * n, real_c( 0 ), n - real_c( 1 ) );
+         key                  = key * stride + uint_c( std::floor( clamped ) );
+      }
+      location.microElementKey = key;
+   }
+
+   return locations;
+}
+
+/// \brief Evaluates a function at all passed points that can be located on this process.
+///
+/// \param storage               storage of the function
+/// \param physicalCoords        points to evaluate the function at
+/// \param level                 refinement level
+/// \param values                output, values[i] is the function value at physicalCoords[i] if it was found
+/// \param evaluateInPrimitive   callable( const PrimitiveID&, const Point3D& computationalCoords ) -> ValueType that
+///                              evaluates the function in the passed process-local macro-face (2D) or macro-cell (3D)
+/// \return for each point, whether it was found (and evaluated) on this process
+template < typename ValueType, typename EvaluationCallable >
+std::vector< bool > evaluateBatchLocally( const std::shared_ptr< PrimitiveStorage >& storage,
+                                          std::span< const Point3D >                 physicalCoords,
+                                          uint_t                                     level,
+                                          std::span< ValueType >                     values,
+                                          const EvaluationCallable&                  evaluateInPrimitive,
+                                          real_t                                     searchToleranceRadius,
+                                          real_t                                     distanceTolerance,
+                                          bool                                       useBestGuess )
+{
+   WALBERLA_CHECK_EQUAL( physicalCoords.size(), values.size(), "Number of points and values must match." );
+
+   const auto locations =
+       locatePointsForBatchEvaluation( storage, physicalCoords, level, searchToleranceRadius, distanceTolerance, useBestGuess );
+
+   std::vector< uint_t > order;
+   order.reserve( locations.size() );
+   for ( uint_t i = 0; i < locations.size(); ++i )
+   {
+      if ( locations[i].found )
+      {
+         order.push_back( i );
+      }
+   }
+
+   std::sort( order.begin(), order.end(), [&locations]( uint_t a, uint_t b ) {
+      if ( locations[a].primitiveID != locations[b].primitiveID )
+      {
+         return locations[a].primitiveID < locations[b].primitiveID;
+      }
+      return locations[a].microElementKey < locations[b].microElementKey;
+   } );
+
+   std::vector< bool > found( physicalCoords.size(), false );
+   for ( const uint_t i : order )
+   {
+      values[i] = evaluateInPrimitive( locations[i].primitiveID, locations[i].computationalCoords );
+      found[i]  = true;
+   }
+
+   return found;
+}
+
+/// \brief Sends the points that have not been found locally to all candidate processes and evaluates them there.
+///
+/// Helper of evaluateBatchDistributed(), must be called collectively. The remote processes search the points exactly
+/// (i.e. without best guess), so the result does not depend on which process the points were passed on.
+template < typename ValueType, typename LocalBatchEvaluationCallable >
+void evaluateRemainingBatchRemotely( const std::shared_ptr< PrimitiveStorage >& storage,
+                                     std::span< const Point3D >                 physicalCoords,
+                                     std::span< ValueType >                     values,
+                                     std::vector< bool >&                       found,
+                                     const LocalBatchEvaluationCallable&        localBatchEvaluation )
+{
+   const uint_t numProcesses = uint_c( walberla::mpi::MPIManager::instance()->numProcesses() );
+   const uint_t rank         = uint_c( walberla::mpi::MPIManager::instance()->rank() );
+
+   // physical bounding box of the local subdomain, [ min_x, min_y, min_z, max_x, max_y, max_z ]
+   std::vector< real_t > localBounds = { std::numeric_limits< real_t >::max(),
+                                         std::numeric_limits< real_t >::max(),
+                                         std::numeric_limits< real_t >::max(),
+                                         std::numeric_limits< real_t >::lowest(),
+                                         std::numeric_limits< real_t >::lowest(),
+                                         std::numeric_limits< real_t >::lowest() };
+
+   auto extendLocalBounds = [&localBounds]( const AABB< 3 >& box ) {
+      for ( uint_t d = 0; d < 3; ++d )
+      {
+         localBounds[d]     = std::min( localBounds[d], box.min()[d] );
+         localBounds[d + 3] = std::max( localBounds[d + 3], box.max()[d] );
+      }
+   };
+
+   if ( storage->hasGlobalCells() )
+   {
+      auto hierarchy = PrimitiveBoundingVolumeHierarchy< Cell >::getForStorage( storage, false );
+      for ( uint_t i = 0; i < hierarchy->getNumPrimitives(); ++i )
+      {
+         extendLocalBounds( hierarchy->getPrimitiveBounds( i ) );
+      }
+   }
+   else
+   {
+      auto hierarchy = PrimitiveBoundingVolumeHierarchy< Face >::getForStorage( storage, false );
+      for ( uint_t i = 0; i < hierarchy->getNumPrimitives(); ++i )
+      {
+         extendLocalBounds( hierarchy->getPrimitiveBounds( i ) );
+      }
+   }
+
+   const std::vector< real_t > allBounds = walberla::mpi::allGatherv( localBounds );
+   WALBERLA_CHECK_EQUAL( allBounds.size(), 6 * numProcesses );
+
+   auto boundsContain = [&allBounds]( uint_t r, const Point3D& p ) {
+      for ( uint_t d = 0; d < 3; ++d )
+      {
+         if ( p[d] < allBounds[6 * r + d] || p[d] > allBounds[6 * r + d + 3] )
+         {
+            return false;
+         }
+      }
+      return true;
+   };
+
+   static const int requestTag = communication::MPITagProvider::getMPITag();
+   static const int replyTag   = communication::MPITagProvider::getMPITag();
+
+   // send the points that have not been found locally to all candidate processes
+   walberla::mpi::BufferSystem requestBufferSystem( walberla::mpi::MPIManager::instance()->comm(), requestTag );
+   for ( uint_t i = 0; i < physicalCoords.size(); ++i )
+   {
+      if ( found[i] )
+      {
+         continue;
+      }
+      for ( uint_t r = 0; r < numProcesses; ++r )
+      {
+         if ( r != rank && boundsContain( r, physicalCoords[i] ) )
+         {
+            requestBufferSystem.sendBuffer( walberla::mpi::MPIRank( r ) ) << i << physicalCoords[i];
+         }
+      }
+   }
+   requestBufferSystem.setReceiverInfoFromSendBufferState( false, true );
+   requestBufferSystem.sendAll();
+
+   // evaluate the requested points of all processes in a single batch, exactly to stay independent of the partitioning
+   std::vector< walberla::mpi::MPIRank > requestRanks;
+   std::vector< uint_t >                 requestIndices;
+   std::vector< Point3D >                requestCoords;
+   for ( auto msg = requestBufferSystem.begin(); msg != requestBufferSystem.end(); ++msg )
+   {
+      while ( !msg.buffer().isEmpty() )
+      {
+         uint_t  idx;
+         Point3D coords;
+         msg.buffer() >> idx >> coords;
+         requestRanks.push_back( msg.rank() );
+         requestIndices.push_back( idx );
+         requestCoords.push_back( coords );
+      }
+   }
+
+   std::vector< ValueType > requestValues( requestCoords.size(), ValueType( 0 ) );
+   const std::vector< bool > requestFound = localBatchEvaluation( requestCoords, requestValues, false );
+
+   walberla::mpi::BufferSystem replyBufferSystem( walberla::mpi::MPIManager::instance()->comm(), replyTag );
+   for ( uint_t i = 0; i < requestCoords.size(); ++i )
+   {
+      if ( requestFound[i] )
+      {
+         replyBufferSystem.sendBuffer( requestRanks[i] ) << requestIndices[i] << requestValues[i];
+      }
+   }
+   replyBufferSystem.setReceiverInfoFromSendBufferState( false, true );
+   replyBufferSystem.sendAll();
+
+   // messages are received in arbitrary order, so the sender ranks are tracked to prefer the lowest one
+   std::vector< walberla::mpi::MPIRank > valueRanks( physicalCoords.size(),
+                                                     std::numeric_limits< walberla::mpi::MPIRank >::max() );
+   for ( auto msg = replyBufferSystem.begin(); msg != replyBufferSystem.end(); ++msg )
+   {
+      while ( !msg.buffer().isEmpty() )
+      {
+         uint_t    idx;
+         ValueType value;
+         msg.buffer() >> idx >> value;
+         if ( msg.rank() < valueRanks[idx] )
+         {
+            values[idx]     = value;
+            found[idx]      = true;
+            valueRanks[idx] = msg.rank();
+         }
+      }
+   }
+}
+
+/// \brief Evaluates a function at the passed points, regardless of which process owns them.
+///
+/// Must be called collectively. Each process passes its own points and receives the values at all of them.
+///
+/// The points are located in three phases:
+///  1. All points are searched exactly (i.e. without best guess) on the calling process and evaluated there if found.
+///  2. The remaining points are sent to all processes whose subdomain bounding box (in the physical domain) contains
+///     them. These search them exactly as well and send the values back. If a point is found on more than one process,
+///     the value of the process with the lowest rank is used.
+///  3. Only if useBestGuess is set, the points that have not been found on any process are evaluated in the closest
+///     nearby primitive of the calling process.
+///
+/// In all phases, a point is only mapped back to the computational domain in the primitives whose bounding box
+/// (enlarged by the search radius in phase 3) contains it, see mapFromPhysicalToComputationalDomain2D/3D(). So a
+/// point that is not in the subdomain of the calling process only costs a traversal of the local bounding volume
+/// hierarchy in phase 1, plus the inverse maps of the few primitives whose boxes overlap at the point.
+///
+/// Phases 1 and 2 yield the same values for any distribution of the points and the mesh. The best guess in phase 3 is a
+/// last resort for points slightly outside the domain and depends on the subdomain of the calling process: if none of
+/// its primitives is close to the point, the point is not found.
+///
+/// \param localBatchEvaluation  callable( std::span< const Point3D >, std::span< ValueType >, bool useBestGuess )
+///                              -> std::vector< bool > that evaluates the function at the points that are found on
+///                              this process
+/// \param useBestGuess          evaluate points that are not found on any process in the closest nearby local primitive
+/// \return for each point, whether it was found (and evaluated)
+template < typename ValueType, typename LocalBatchEvaluationCallable >
+std::vector< bool > evaluateBatchDistributed( const std::shared_ptr< PrimitiveStorage >& storage,
+                                              std::span< const Point3D >                 physicalCoords,
+                                              std::span< ValueType >                     values,
+                                              const LocalBatchEvaluationCallable&        localBatchEvaluation,
+                                              bool                                       useBestGuess )
+{
+   WALBERLA_CHECK_EQUAL( physicalCoords.size(), values.size(), "Number of points and values must match." );
+
+   std::vector< bool > found = localBatchEvaluation( physicalCoords, values, false );
+
+   const uint_t numProcesses = uint_c( walberla::mpi::MPIManager::instance()->numProcesses() );
+
+   if ( numProcesses > 1 )
+   {
+      evaluateRemainingBatchRemotely( storage, physicalCoords, values, found, localBatchEvaluation );
+   }
+
+   if ( useBestGuess )
+   {
+      std::vector< uint_t >  missingIndices;
+      std::vector< Point3D > missingCoords;
+      for ( uint_t i = 0; i < physicalCoords.size(); ++i )
+      {
+         if ( !found[i] )
+         {
+            missingIndices.push_back( i );
+            missingCoords.push_back( physicalCoords[i] );
+         }
+      }
+
+      std::vector< ValueType >  missingValues( missingCoords.size(), ValueType( 0 ) );
+      const std::vector< bool > missingFound = localBatchEvaluation( missingCoords, missingValues, true );
+      for ( uint_t i = 0; i < missingIndices.size(); ++i )
+      {
+         if ( missingFound[i] )
+         {
+            values[missingIndices[i]] = missingValues[i];
+            found[missingIndices[i]]  = true;
+         }
+      }
+   }
+
+   return found;
+}
+
+} // namespace hyteg
@@ -229,6 +229,43 @@ class BlockFunction
       return sum;
    }
 
+   /// Computes the dot products with all passed functions. Each sub-function of this function is traversed only once
+   /// if the type of the sub-function supports it.
+   ///
+   /// Templated on the type of the passed functions, so that vectors of derived block functions (e.g.
+   /// P2P1TaylorHoodFunction) can be passed without conversion.
+   template < typename BlockFunctionType >
+      requires std::is_base_of_v< BlockFunction< value_t >, BlockFunctionType >
+   std::vector< value_t > dotLocalBatch( const std::vector< std::reference_wrapper< const BlockFunctionType > >& rhs,
+                                         const uint_t                                                             level,
+                                         const DoFType                                                            flag = All ) const
+   {
+      const std::vector< std::reference_wrapper< const BlockFunction< value_t > > > blockRhs( rhs.begin(), rhs.end() );
+
+      std::vector< value_t > sums( rhs.size(), value_t( 0 ) );
+      for ( uint_t k = 0; k < subFunc_.size(); ++k )
+      {
+         const std::vector< value_t > subSums = subFunc_[k]->dotLocalBatch( filter( k, blockRhs ), level, flag );
+         for ( uint_t i = 0; i < sums.size(); ++i )
+         {
+            sums[i] += subSums[i];
+         }
+      }
+      return sums;
+   }
+
+   /// Computes the dot products with all passed functions with a single global reduction.
+   template < typename BlockFunctionType >
+      requires std::is_base_of_v< BlockFunction< value_t >, BlockFunctionType >
+   std::vector< value_t > dotGlobalBatch( const std::vector< std::reference_wrapper< const BlockFunctionType > >& rhs,
+                                          const uint_t                                                             level,
+                                          const DoFType                                                            flag = All ) const
+   {
+      auto sums = dotLocalBatch( rhs, level, flag );
+      walberla::mpi::allReduceInplace( sums, walberla::mpi::SUM, walberla::mpi::MPIManager::instance()->comm() );
+      return sums;
+   }
+
    /// \brief Copies all values function data from other to this.
    ///
    /// This method can be used safely if the other function is located on a different PrimitiveStorage.
@@ -25,6 +25,7 @@
 #include "hyteg/functions/Function.hpp"
 #include "hyteg/functions/GenericFunction.hpp"
 #include "hyteg/functions/VectorFunctionTools.hpp"
+#include "hyteg/types/Concepts.hpp"
 
 namespace hyteg {
 
@@ -308,6 +309,45 @@ class CSFVectorFunction
       return sum;
    }
 
+   /// Computes the dot products with all passed functions. If the component functions support it, each component of
+   /// this function is traversed only once.
+   std::vector< valueType > dotLocalBatch( const std::vector< std::reference_wrapper< const VectorFunctionType > >& rhs,
+                                           const uint_t                                                             level,
+                                           const DoFType flag = All ) const
+   {
+      std::vector< valueType > sums( rhs.size(), valueType( 0 ) );
+      for ( uint_t k = 0; k < compFunc_.size(); ++k )
+      {
+         const auto rhsComponents = vectorFunctionTools::filter( k, rhs );
+         if constexpr ( concepts::batched_dot< VectorComponentType > )
+         {
+            const std::vector< valueType > componentSums = compFunc_[k]->dotLocalBatch( rhsComponents, level, flag );
+            for ( uint_t i = 0; i < sums.size(); ++i )
+            {
+               sums[i] += componentSums[i];
+            }
+         }
+         else
+         {
+            for ( uint_t i = 0; i < sums.size(); ++i )
+            {
+               sums[i] += compFunc_[k]->dotLocal( rhsComponents[i], level, flag );
+            }
+         }
+      }
+      return sums;
+   }
+
+   /// Computes the dot products with all passed functions with a single global reduction.
+   std::vector< valueType > dotGlobalBatch( const std::vector< std::reference_wrapper< const VectorFunctionType > >& rhs,
+                                            const uint_t                                                             level,
+                                            const DoFType flag = All ) const
+   {
+      auto sums = dotLocalBatch( rhs, level, flag );
+      walberla::mpi::allReduceInplace( sums, walberla::mpi::SUM, walberla::mpi::MPIManager::instance()->comm() );
+      return sums;
+   }
+
    valueType getMaxComponentMagnitude( uint_t level, DoFType flag, bool mpiReduce = true ) const
    {
       std::vector< valueType > values;
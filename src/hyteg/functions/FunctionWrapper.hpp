@@ -26,6 +26,7 @@
 #include "hyteg/functions/FunctionTraits.hpp"
 #include "hyteg/functions/GenericFunction.hpp"
 #include "hyteg/sparseassembly/VectorProxy.hpp"
+#include "hyteg/types/Concepts.hpp"
 
 // only needed for using idx_t in to/fromVector() below!
 #include "hyteg/types/types.hpp"
@@ -135,6 +136,31 @@ class FunctionWrapper final : public GenericFunction< typename FunctionTrait< fu
       return wrappedFunc_->dotLocal( secondOp.template unwrap< func_t >(), level, flag );
    };
 
+   std::vector< value_t > dotLocalBatch( const std::vector< std::reference_wrapper< const GenericFunction< value_t > > >& rhs,
+                                         uint_t                                                                           level,
+                                         DoFType flag = All ) const
+   {
+      std::vector< std::reference_wrapper< const func_t > > realFuncs;
+      for ( const GenericFunction< value_t >& func : rhs )
+      {
+         realFuncs.push_back( func.template unwrap< func_t >() );
+      }
+
+      if constexpr ( concepts::batched_dot< func_t > )
+      {
+         return wrappedFunc_->dotLocalBatch( realFuncs, level, flag );
+      }
+      else
+      {
+         std::vector< value_t > sums;
+         for ( const func_t& func : realFuncs )
+         {
+            sums.push_back( wrappedFunc_->dotLocal( func, level, flag ) );
+         }
+         return sums;
+      }
+   };
+
    void enableTiming( const std::shared_ptr< walberla::WcTimingTree >& timingTree ) { wrappedFunc_->enableTiming( timingTree ); };
 
    void setBoundaryCondition( BoundaryCondition bc ) { wrappedFunc_->setBoundaryCondition( bc ); };
@@ -20,6 +20,9 @@
 
 #pragma once
 
+#include <functional>
+#include <vector>
+
 #include "core/DataTypes.h"
 
 #include "hyteg/boundary/BoundaryConditions.hpp"
@@ -96,6 +99,11 @@ class GenericFunction
 
    virtual value_t dotLocal( const GenericFunction< value_t >& secondOp, uint_t level, DoFType flag = All ) const = 0;
 
+   /// Computes the dot products with all passed functions (without global reduction).
+   virtual std::vector< value_t > dotLocalBatch( const std::vector< std::reference_wrapper< const GenericFunction< value_t > > >& rhs,
+                                                 uint_t                                                                           level,
+                                                 DoFType flag = All ) const = 0;
+
    virtual void enableTiming( const std::shared_ptr< walberla::WcTimingTree >& timingTree ) = 0;
 
    virtual void setBoundaryCondition( BoundaryCondition bc ) = 0;
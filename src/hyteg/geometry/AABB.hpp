@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2025 Nils Kohl.
+ *
+ * This file is part of HyTeG
+ * (see https://i10git.cs.fau.de/hyteg/hyteg).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "core/Abort.h"
+#include "core/DataTypes.h"
+#include "core/mpi/RecvBuffer.h"
+#include "core/mpi/SendBuffer.h"
+
+#include "hyteg/types/PointND.hpp"
+
+namespace hyteg {
+
+using walberla::real_t;
+using walberla::mpi::RecvBuffer;
+using walberla::mpi::SendBuffer;
+
+/// @class AABB
+/// @brief Represents an axis-aligned bounding box (AABB) in n-dimensional space.
+template < int Dim >
+class AABB
+{
+ public:
+   static constexpr int D = Dim;
+
+   /// @brief Constructs an AABB with specified minimum and maximum coordinates.
+   ///
+   /// @param aabbMin The minimum coordinates of the bounding box.
+   /// @param aabbMax The maximum coordinates of the bounding box.
+   AABB( const PointND< real_t, Dim >& aabbMin, const PointND< real_t, Dim >& aabbMax )
+   : min_( aabbMin )
+   , max_( aabbMax )
+   {
+      computeLargestAxis();
+   }
+
+   /// @brief Returns the smallest AABB that contains this and the other AABB.
+   ///
+   /// @param other The AABB to merge with.
+   /// @return A new AABB enclosing both AABBs.
+   AABB merge( const AABB& other ) const
+   {
+      PointND< real_t, Dim > newMin;
+      PointND< real_t, Dim > newMax;
+      for ( size_t i = 0; i < min_.size(); ++i )
+      {
+         newMin[i] = std::min( min_[i], other.min_[i] );
+         newMax[i] = std::max( max_[i], other.max_[i] );
+      }
+      return AABB( newMin, newMax );
+   }
+
+   PointND< real_t, Dim > min() const { return min_; }
+   PointND< real_t, Dim > max() const { return max_; }
+   int                    largestAxis() const { return largestAxis_; }
+
+   /// @brief Checks if a given point is contained within the AABB.
+   ///
+   /// @param point The point to check.
+   /// @return True if the point is within the AABB, false otherwise.
+   bool contains( const PointND< real_t, Dim >& point ) const
+   {
+      for ( size_t i = 0; i < min_.size(); ++i )
+      {
+         if ( point[i] < min_[i] || point[i] > max_[i] )
+         {
+            return false;
+         }
+      }
+      return true;
+   }
+
+   /// @brief Extends the AABB by a given factor. The center of the AABB does not change.
+   ///
+   /// @param factor The factor by which to extend the AABB.
+   /// @return A new AABB that is extended by the specified factor.
+   AABB extend( real_t factor ) const
+   {
+      PointND< real_t, Dim > newMin;
+      PointND< real_t, Dim > newMax;
+      for ( size_t i = 0; i < min_.size(); ++i )
+      {
+         real_t center     = ( min_[i] + max_[i] ) / 2;
+         real_t halfExtent = ( max_[i] - min_[i] ) / 2 * factor;
+         newMin[i]         = center - halfExtent;
+         newMax[i]         = center + halfExtent;
+      }
+      return AABB( newMin, newMax );
+   }
+
+   /// @brief Returns the vertices of an AABB.
+   ///
+   /// 2D: in counter-clockwise order
+   /// 3D: first the bottom vertices in counter-clockwise order, then the top vertices in counter-clockwise order
+   ///
+   /// @return A vector of vectors, where each inner vector represents a vertex of the AABB.
+   std::vector< PointND< real_t, Dim > > getVertices() const
+   {
+      if constexpr ( Dim == 2 )
+      {
+         return { { min_[0], min_[1] }, { min_[0], max_[1] }, { max_[0], max_[1] }, { max_[0], min_[1] } };
+      }
+      else if constexpr ( Dim == 3 )
+      {
+         return { { min_[0], min_[1], min_[2] },
+                  { min_[0], max_[1], min_[2] },
+                  { max_[0], max_[1], min_[2] },
+                  { max_[0], min_[1], min_[2] },
+                  { min_[0], min_[1], max_[2] },
+                  { min_[0], max_[1], max_[2] },
+                  { max_[0], max_[1], max_[2] },
+                  { max_[0], min_[1], max_[2] } };
+      }
+
+      WALBERLA_ABORT( "Invalid AABB dim." )
+   }
+
+   void serialize( SendBuffer& sendBuffer ) const
+   {
+      sendBuffer << min_;
+      sendBuffer << max_;
+      sendBuffer << largestAxis_;
+   }
+
+   void deserialize( RecvBuffer& recvBuffer )
+   {
+      recvBuffer >> min_;
+      recvBuffer >> max_;
+      recvBuffer >> largestAxis_;
+   }
+
+ private:
+   void computeLargestAxis()
+   {
+      largestAxis_         = 0;
+      real_t largestExtent = max_[0] - min_[0];
+      for ( int i = 1; i < Dim; ++i )
+      {
+         real_t extent = max_[i] - min_[i];
+         if ( extent > largestExtent )
+         {
+            largestExtent = extent;
+            largestAxis_  = i;
+         }
+      }
+   }
+
+   PointND< real_t, Dim > min_; ///< Minimum coordinates of the bounding box.
+   PointND< real_t, Dim > max_; ///< Maximum coordinates of the bounding box.
+   int                    largestAxis_;
+};
+
+} // namespace hyteg
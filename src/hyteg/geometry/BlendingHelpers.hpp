@@ -20,11 +20,16 @@
 
 #pragma once
 
+#include <algorithm>
+#include <limits>
+#include <vector>
+
 #include "core/DataTypes.h"
 #include "core/math/Matrix3.h"
 
 #include "hyteg/geometry/ClosestPoint.hpp"
 #include "hyteg/geometry/Intersection.hpp"
+#include "hyteg/geometry/PrimitiveBoundingVolumeHierarchy.hpp"
 #include "hyteg/primitives/Cell.hpp"
 #include "hyteg/primitives/Face.hpp"
 #include "hyteg/types/PointND.hpp"
@@ -41,38 +46,40 @@ using walberla::real_t;
 /// you have no information to which macro-face the point belongs on the computational domain.
 /// Figuring this out is then part of the task.
 ///
-/// We apply three approaches to solve the problem:
+/// Only the faces of the passed PrimitiveBoundingVolumeHierarchy whose physical bounding box is close to the point
+/// are considered. We apply three approaches to solve the problem:
 ///
-///   1. For all face primitives of the local subdomain:
+///   1. For all faces whose bounding box contains the point:
 ///      If a point-triangle inclusion test succeeds and the verifyPointPairing() method of
 ///      the corresponding face returns true, then we return true, the ID of the face and the
-///      coordinates obtained from the inverse blending map of that face. While checking all
-///      face primitives, we store the face with the smallest distance to the point that was mapped
-///      back to the computational domain that also fulfills the verifyPointPairing() check.
-///      If a face's distance is smaller than the given distanceTolerance parameter,
-///      then the method can also return that face & respective computational domain point immediately.
-///      Use distanceTolerance = 0 to disable that feature.
+///      coordinates obtained from the inverse blending map of that face. The faces are checked in the order
+///      of their IDs. If a face's distance to the point that was mapped back to the computational domain is
+///      smaller than the given distanceTolerance parameter, then the method can also return that face &
+///      respective computational domain point. Use distanceTolerance = 0 to disable that feature.
 ///
-///   2. If approach #1 fails and searchToleranceRadius is positive, we perform for all face
-///      primitives of the local subdomain a circle-triangle intersection test. If this
+///   2. If approach #1 fails and searchToleranceRadius is positive, we perform for all faces whose bounding box,
+///      enlarged by searchToleranceRadius on each side, contains the point a circle-triangle intersection test. If this
 ///      is successful and the verifyPointPairing() method of the corresponding face returns
 ///      true, then we return true, the ID of the face and the coordinates obtained from the
 ///      inverse blending map of that face.
 ///
 ///   3. If approach #2 fails and returnBestGuess is true, the face & respective computational domain point
-///      fulfilling the verifyPointPairing() check with the smallest point face distance are returned,
-///      provided we found one in step 1.
+///      fulfilling the verifyPointPairing() check with the smallest point face distance among the faces of #2
+///      are returned (if searchToleranceRadius is not positive, among the faces of #1).
 ///
-/// Additionally, if includeNeighboringFaces is true, then we do not only look for a process-local primitive, but also
-/// search in the set of neighboring primitives.
+/// Note that in #2 searchToleranceRadius is measured in the computational domain, but applied to the bounding boxes in
+/// the physical domain. The safety margin of the boxes makes up for moderate distortions by the geometry map.
+/// Faces that are farther away from the point are never mapped back, so a point that cannot be located costs about as
+/// much as a point that can.
+///
+/// Whether neighboring faces are searched, too, is determined by the passed hierarchy.
 ///
 inline std::tuple< bool, PrimitiveID, Point3D >
-    mapFromPhysicalToComputationalDomain2D( std::shared_ptr< PrimitiveStorage > storage,
-                                            const Point3D&                      physicalCoords,
-                                            real_t                              searchToleranceRadius,
-                                            real_t                              distanceTolerance       = real_c( 0 ),
-                                            bool                                returnBestGuess         = false,
-                                            bool                                includeNeighboringFaces = false )
+    mapFromPhysicalToComputationalDomain2D( const PrimitiveBoundingVolumeHierarchy< Face >& hierarchy,
+                                            const Point3D&                                  physicalCoords,
+                                            real_t                                          searchToleranceRadius,
+                                            real_t                                          distanceTolerance = real_c( 0 ),
+                                            bool                                            returnBestGuess   = false )
 {
    bool        foundCandidate = false;
    PrimitiveID faceID;
@@ -80,17 +87,12 @@ inline std::tuple< bool, PrimitiveID, Point3D >
 
    real_t lowestTol = std::numeric_limits< real_t >::max();
 
-   auto allFaces = storage->getFaces();
-
-   if ( includeNeighboringFaces )
-   {
-      auto neighborFaces = storage->getNeighborFaces();
-      allFaces.insert( neighborFaces.begin(), neighborFaces.end() );
-   }
+   std::vector< uint_t > candidates;
+   hierarchy.findCandidates( physicalCoords, candidates );
 
-   for ( const auto& it : allFaces )
+   for ( const uint_t candidate : candidates )
    {
-      Face& face = *it.second;
+      const Face& face = hierarchy.getPrimitive( candidate );
 
       Point3D currentComputationalCoords;
 
@@ -103,40 +105,57 @@ inline std::tuple< bool, PrimitiveID, Point3D >
                                                                            face.getCoordinates()[2] ) )
                         .norm();
 
-      if ( dist < lowestTol && face.getGeometryMap()->verifyPointPairing( currentComputationalCoords, physicalCoords ) )
+      if ( ( std::fpclassify( dist ) == FP_ZERO || ( distanceTolerance > real_c( 0 ) && dist < distanceTolerance ) ) &&
+           face.getGeometryMap()->verifyPointPairing( currentComputationalCoords, physicalCoords ) )
       {
-         foundCandidate      = true;
-         lowestTol           = dist;
-         faceID              = face.getID();
-         computationalCoords = currentComputationalCoords;
-
-         if ( std::fpclassify( dist ) == FP_ZERO || ( distanceTolerance > real_c( 0 ) && dist < distanceTolerance ) )
-         {
-            return { true, faceID, computationalCoords };
-         }
+         return { true, face.getID(), currentComputationalCoords };
       }
    }
 
    // No face found? Try different approach
-   if ( searchToleranceRadius > real_c( 0 ) )
+   if ( searchToleranceRadius > real_c( 0 ) || returnBestGuess )
    {
-      for ( const auto& it : allFaces )
+      hierarchy.findCandidates( physicalCoords, std::max( searchToleranceRadius, real_c( 0 ) ), candidates );
+
+      for ( const uint_t candidate : candidates )
       {
-         Face& face = *it.second;
+         const Face& face = hierarchy.getPrimitive( candidate );
+
+         Point3D currentComputationalCoords;
 
          // map coordinates from physical to computational domain
-         face.getGeometryMap()->evalFinv( physicalCoords, computationalCoords );
+         face.getGeometryMap()->evalFinv( physicalCoords, currentComputationalCoords );
 
-         bool faceIsCandidate = circleTriangleIntersection( computationalCoords,
-                                                            searchToleranceRadius,
-                                                            face.getCoordinates()[0],
-                                                            face.getCoordinates()[1],
-                                                            face.getCoordinates()[2] );
+         if ( searchToleranceRadius > real_c( 0 ) )
+         {
+            bool faceIsCandidate = circleTriangleIntersection( currentComputationalCoords,
+                                                               searchToleranceRadius,
+                                                               face.getCoordinates()[0],
+                                                               face.getCoordinates()[1],
+                                                               face.getCoordinates()[2] );
+
+            // if face is candidate, check that this is actually the correct face
+            if ( faceIsCandidate && face.getGeometryMap()->verifyPointPairing( currentComputationalCoords, physicalCoords ) )
+            {
+               return { true, face.getID(), currentComputationalCoords };
+            }
+         }
 
-         if ( faceIsCandidate && face.getGeometryMap()->verifyPointPairing( computationalCoords, physicalCoords ) )
+         if ( returnBestGuess )
          {
-            faceID = face.getID();
-            return { true, faceID, computationalCoords };
+            real_t dist = ( currentComputationalCoords - closestPointTriangle2D( currentComputationalCoords,
+                                                                                 face.getCoordinates()[0],
+                                                                                 face.getCoordinates()[1],
+                                                                                 face.getCoordinates()[2] ) )
+                              .norm();
+
+            if ( dist < lowestTol && face.getGeometryMap()->verifyPointPairing( currentComputationalCoords, physicalCoords ) )
+            {
+               foundCandidate      = true;
+               lowestTol           = dist;
+               faceID              = face.getID();
+               computationalCoords = currentComputationalCoords;
+            }
          }
       }
    }
@@ -149,6 +168,27 @@ inline std::tuple< bool, PrimitiveID, Point3D >
    return { false, faceID, computationalCoords };
 }
 
+/// Same as above, using the PrimitiveBoundingVolumeHierarchy of the passed storage.
+///
+/// If includeNeighboringFaces is true, then we do not only look for a process-local primitive, but also
+/// search in the set of neighboring primitives.
+///
+/// The hierarchy is obtained from PrimitiveBoundingVolumeHierarchy::getForStorage(), which locks a global cache.
+/// When mapping many points, obtain the hierarchy once and call the overload above instead.
+///
+inline std::tuple< bool, PrimitiveID, Point3D >
+    mapFromPhysicalToComputationalDomain2D( const std::shared_ptr< PrimitiveStorage >& storage,
+                                            const Point3D&                             physicalCoords,
+                                            real_t                                     searchToleranceRadius,
+                                            real_t                                     distanceTolerance       = real_c( 0 ),
+                                            bool                                       returnBestGuess         = false,
+                                            bool                                       includeNeighboringFaces = false )
+{
+   const auto hierarchy = PrimitiveBoundingVolumeHierarchy< Face >::getForStorage( storage, includeNeighboringFaces );
+   return mapFromPhysicalToComputationalDomain2D(
+       *hierarchy, physicalCoords, searchToleranceRadius, distanceTolerance, returnBestGuess );
+}
+
 /// Map point from 3D physical to 3D computational domain
 ///
 /// Given the coordinates of a point in the physical domain try to figure out what its coordinates
@@ -156,38 +196,40 @@ inline std::tuple< bool, PrimitiveID, Point3D >
 /// you have no information to which macro-cell the point belongs on the computational domain.
 /// Figuring this out is then part of the task.
 ///
-/// We apply three approaches to solve the problem:
+/// Only the cells of the passed PrimitiveBoundingVolumeHierarchy whose physical bounding box is close to the point
+/// are considered. We apply three approaches to solve the problem:
 ///
-///   1. For all cell primitives of the local subdomain:
-///      If a point-triangle inclusion test succeeds and the verifyPointPairing() method of
+///   1. For all cells whose bounding box contains the point:
+///      If a point-tetrahedron inclusion test succeeds and the verifyPointPairing() method of
 ///      the corresponding cell returns true, then we return true, the ID of the cell and the
-///      coordinates obtained from the inverse blending map of that cell. While checking all
-///      cell primitives, we store the cell with the smallest distance to the point that was mapped
-///      back to the computational domain that also fulfills the verifyPointPairing() check.
-///      If a cell's distance is smaller than the given distanceTolerance parameter,
-///      then the method can also return that cell & respective computational domain point immediately.
-///      Use distanceTolerance = 0 to disable that feature.
+///      coordinates obtained from the inverse blending map of that cell. The cells are checked in the order
+///      of their IDs. If a cell's distance to the point that was mapped back to the computational domain is
+///      smaller than the given distanceTolerance parameter, then the method can also return that cell &
+///      respective computational domain point. Use distanceTolerance = 0 to disable that feature.
 ///
-///   2. If approach #1 fails and searchToleranceRadius is positive, we perform for all cell
-///      primitives of the local subdomain a sphere-tetrahedron intersection test. If this
+///   2. If approach #1 fails and searchToleranceRadius is positive, we perform for all cells whose bounding box,
+///      enlarged by searchToleranceRadius on each side, contains the point a sphere-tetrahedron intersection test. If this
 ///      is successful and the verifyPointPairing() method of the corresponding cell returns
 ///      true, then we return true, the ID of the cell and the coordinates obtained from the
 ///      inverse blending map of that cell.
 ///
 ///   3. If approach #2 fails and returnBestGuess is true, the cell & respective computational domain point
-///      fulfilling the verifyPointPairing() check with the smallest point cell distance are returned,
-///      provided we found one in step 1.
+///      fulfilling the verifyPointPairing() check with the smallest point cell distance among the cells of #2
+///      are returned (if searchToleranceRadius is not positive, among the cells of #1).
 ///
-/// Additionally, if includeNeighboringCells is true, then we do not only look for a process-local primitive, but also
-/// search in the set of neighboring primitives.
+/// Note that in #2 searchToleranceRadius is measured in the computational domain, but applied to the bounding boxes in
+/// the physical domain. The safety margin of the boxes makes up for moderate distortions by the geometry map.
+/// Cells that are farther away from the point are never mapped back, so a point that cannot be located costs about as
+/// much as a point that can.
+///
+/// Whether neighboring cells are searched, too, is determined by the passed hierarchy.
 ///
 inline std::tuple< bool, PrimitiveID, Point3D >
-    mapFromPhysicalToComputationalDomain3D( std::shared_ptr< PrimitiveStorage > storage,
-                                            const Point3D&                      physicalCoords,
-                                            real_t                              searchToleranceRadius,
-                                            real_t                              distanceTolerance       = real_c( 0 ),
-                                            bool                                returnBestGuess         = false,
-                                            bool                                includeNeighboringCells = false )
+    mapFromPhysicalToComputationalDomain3D( const PrimitiveBoundingVolumeHierarchy< Cell >& hierarchy,
+                                            const Point3D&                                  physicalCoords,
+                                            real_t                                          searchToleranceRadius,
+                                            real_t                                          distanceTolerance = real_c( 0 ),
+                                            bool                                            returnBestGuess   = false )
 {
    bool        foundCandidate = false;
    PrimitiveID cellID;
@@ -195,17 +237,12 @@ inline std::tuple< bool, PrimitiveID, Point3D >
 
    real_t lowestTol = std::numeric_limits< real_t >::max();
 
-   auto allCells = storage->getCells();
-
-   if ( includeNeighboringCells )
-   {
-      auto neighborCells = storage->getNeighborCells();
-      allCells.insert( neighborCells.begin(), neighborCells.end() );
-   }
+   std::vector< uint_t > candidates;
+   hierarchy.findCandidates( physicalCoords, candidates );
 
-   for ( const auto& it : allCells )
+   for ( const uint_t candidate : candidates )
    {
-      Cell& cell = *it.second;
+      const Cell& cell = hierarchy.getPrimitive( candidate );
 
       Point3D currentComputationalCoords;
 
@@ -219,42 +256,59 @@ inline std::tuple< bool, PrimitiveID, Point3D >
                                                                               cell.getCoordinates()[3] ) )
                         .norm();
 
-      if ( dist < lowestTol && cell.getGeometryMap()->verifyPointPairing( currentComputationalCoords, physicalCoords ) )
+      if ( ( std::fpclassify( dist ) == FP_ZERO || ( distanceTolerance > real_c( 0 ) && dist < distanceTolerance ) ) &&
+           cell.getGeometryMap()->verifyPointPairing( currentComputationalCoords, physicalCoords ) )
       {
-         foundCandidate      = true;
-         lowestTol           = dist;
-         cellID              = cell.getID();
-         computationalCoords = currentComputationalCoords;
-
-         if ( std::fpclassify( dist ) == FP_ZERO || ( distanceTolerance > real_c( 0 ) && dist < distanceTolerance ) )
-         {
-            return { true, cellID, computationalCoords };
-         }
+         return { true, cell.getID(), currentComputationalCoords };
       }
    }
 
    // No cell found? Try different approach
-   if ( searchToleranceRadius > real_c( 0 ) )
+   if ( searchToleranceRadius > real_c( 0 ) || returnBestGuess )
    {
-      for ( auto& it : allCells )
+      hierarchy.findCandidates( physicalCoords, std::max( searchToleranceRadius, real_c( 0 ) ), candidates );
+
+      for ( const uint_t candidate : candidates )
       {
-         Cell& cell = *it.second;
+         const Cell& cell = hierarchy.getPrimitive( candidate );
+
+         Point3D currentComputationalCoords;
 
          // map coordinates from physical to computational domain
-         cell.getGeometryMap()->evalFinv( physicalCoords, computationalCoords );
+         cell.getGeometryMap()->evalFinv( physicalCoords, currentComputationalCoords );
 
-         bool cellIsCandidate = sphereTetrahedronIntersection( computationalCoords,
-                                                               searchToleranceRadius,
-                                                               cell.getCoordinates()[0],
-                                                               cell.getCoordinates()[1],
-                                                               cell.getCoordinates()[2],
-                                                               cell.getCoordinates()[3] );
+         if ( searchToleranceRadius > real_c( 0 ) )
+         {
+            bool cellIsCandidate = sphereTetrahedronIntersection( currentComputationalCoords,
+                                                                  searchToleranceRadius,
+                                                                  cell.getCoordinates()[0],
+                                                                  cell.getCoordinates()[1],
+                                                                  cell.getCoordinates()[2],
+                                                                  cell.getCoordinates()[3] );
+
+            // if cell is candidate, check that this is actually the correct cell
+            if ( cellIsCandidate && cell.getGeometryMap()->verifyPointPairing( currentComputationalCoords, physicalCoords ) )
+            {
+               return { true, cell.getID(), currentComputationalCoords };
+            }
+         }
 
-         // if cell is candidate, check that this is actually the correct cell
-         if ( cellIsCandidate && cell.getGeometryMap()->verifyPointPairing( computationalCoords, physicalCoords ) )
+         if ( returnBestGuess )
          {
-            cellID = cell.getID();
-            return { true, cellID, computationalCoords };
+            real_t dist = ( currentComputationalCoords - closestPointTetrahedron3D( currentComputationalCoords,
+                                                                                    cell.getCoordinates()[0],
+                                                                                    cell.getCoordinates()[1],
+                                                                                    cell.getCoordinates()[2],
+                                                                                    cell.getCoordinates()[3] ) )
+                              .norm();
+
+            if ( dist < lowestTol && cell.getGeometryMap()->verifyPointPairing( currentComputationalCoords, physicalCoords ) )
+            {
+               foundCandidate      = true;
+               lowestTol           = dist;
+               cellID              = cell.getID();
+               computationalCoords = currentComputationalCoords;
+            }
          }
       }
    }
@@ -267,4 +321,25 @@ inline std::tuple< bool, PrimitiveID, Point3D >
    return { false, cellID, computationalCoords };
 }
 
+/// Same as above, using the PrimitiveBoundingVolumeHierarchy of the passed storage.
+///
+/// If includeNeighboringCells is true, then we do not only look for a process-local primitive, but also
+/// search in the set of neighboring primitives.
+///
+/// The hierarchy is obtained from PrimitiveBoundingVolumeHierarchy::getForStorage(), which locks a global cache.
+/// When mapping many points, obtain the hierarchy once and call the overload above instead.
+///
+inline std::tuple< bool, PrimitiveID, Point3D >
+    mapFromPhysicalToComputationalDomain3D( const std::shared_ptr< PrimitiveStorage >& storage,
+                                            const Point3D&                             physicalCoords,
+                                            real_t                                     searchToleranceRadius,
+                                            real_t                                     distanceTolerance       = real_c( 0 ),
+                                            bool                                       returnBestGuess         = false,
+                                            bool                                       includeNeighboringCells = false )
+{
+   const auto hierarchy = PrimitiveBoundingVolumeHierarchy< Cell >::getForStorage( storage, includeNeighboringCells );
+   return mapFromPhysicalToComputationalDomain3D(
+       *hierarchy, physicalCoords, searchToleranceRadius, distanceTolerance, returnBestGuess );
+}
+
 } // namespace hyteg
@@ -0,0 +1,316 @@
+/*
+ * Copyright (c) 2026 Nils Kohl, Marcus Mohr.
+ *
+ * This file is part of HyTeG
+ * (see https://i10git.cs.fau.de/hyteg/hyteg).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "hyteg/geometry/PrimitiveBoundingVolumeHierarchy.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <type_traits>
+
+#include "hyteg/geometry/GeometryMap.hpp"
+
+namespace hyteg {
+
+using walberla::real_c;
+using walberla::real_t;
+
+namespace {
+
+/// number of subintervals per edge of the lattice that is mapped to the physical domain to compute the bounding boxes
+constexpr uint_t numBoundingBoxSamplesPerEdge = 8;
+
+/// relative safety margin that is added to the bounding boxes on each side
+constexpr real_t boundingBoxMarginFactor = real_c( 0.05 );
+
+template < typename PrimitiveType >
+AABB< 3 > computePhysicalBoundingBox( const PrimitiveType& primitive )
+{
+   constexpr bool isCell = std::is_same_v< PrimitiveType, Cell >;
+
+   const auto& coords = primitive.getCoordinates();
+   const auto& map    = primitive.getGeometryMap();
+   const uint_t n     = numBoundingBoxSamplesPerEdge;
+
+   Point3D boxMin( std::numeric_limits< real_t >::max(), std::numeric_limits< real_t >::max(), std::numeric_limits< real_t >::max() );
+   Point3D boxMax( std::numeric_limits< real_t >::lowest(), std::numeric_limits< real_t >::lowest(), std::numeric_limits< real_t >::lowest() );
+
+   for ( uint_t k = 0; k <= ( isCell ? n : 0 ); ++k )
+   {
+      for ( uint_t j = 0; j <= n - k; ++j )
+      {
+         for ( uint_t i = 0; i <= n - k - j; ++i )
+         {
+            Point3D computationalCoords = coords[0] + real_c( i ) / real_c( n ) * ( coords[1] - coords[0] ) +
+                                          real_c( j ) / real_c( n ) * ( coords[2] - coords[0] );
+            if constexpr ( isCell )
+            {
+               computationalCoords += real_c( k ) / real_c( n ) * ( coords[3] - coords[0] );
+            }
+
+            Point3D physicalCoords;
+            map->evalF( computationalCoords, physicalCoords );
+
+            for ( uint_t d = 0; d < 3; ++d )
+            {
+               boxMin[d] = std::min( boxMin[d], physicalCoords[d] );
+               boxMax[d] = std::max( boxMax[d], physicalCoords[d] );
+            }
+         }
+      }
+   }
+
+   const real_t margin = boundingBoxMarginFactor * ( boxMax - boxMin ).norm();
+   for ( uint_t d = 0; d < 3; ++d )
+   {
+      boxMin[d] -= margin;
+      boxMax[d] += margin;
+   }
+
+   if constexpr ( !isCell )
+   {
+      boxMin[2] = std::numeric_limits< real_t >::lowest();
+      boxMax[2] = std::numeric_limits< real_t >::max();
+   }
+
+   return AABB< 3 >( boxMin, boxMax );
+}
+
+} // namespace
+
+template < typename PrimitiveType >
+PrimitiveBoundingVolumeHierarchy< PrimitiveType >::PrimitiveBoundingVolumeHierarchy( const PrimitiveStorage& storage,
+                                                                                     bool includeNeighborPrimitives )
+{
+   // std::map keeps the primitives sorted by ID, which is preserved in primitives_
+   std::map< PrimitiveID, std::shared_ptr< PrimitiveType > > allPrimitives;
+   if constexpr ( std::is_same_v< PrimitiveType, Cell > )
+   {
+      allPrimitives = storage.getCells();
+      if ( includeNeighborPrimitives )
+      {
+         auto neighborCells = storage.getNeighborCells();
+         allPrimitives.insert( neighborCells.begin(), neighborCells.end() );
+      }
+   }
+   else
+   {
+      allPrimitives = storage.getFaces();
+      if ( includeNeighborPrimitives )
+      {
+         auto neighborFaces = storage.getNeighborFaces();
+         allPrimitives.insert( neighborFaces.begin(), neighborFaces.end() );
+      }
+   }
+
+   primitives_.reserve( allPrimitives.size() );
+   primitiveBounds_.reserve( allPrimitives.size() );
+   primitiveCentroids_.reserve( allPrimitives.size() );
+   for ( const auto& it : allPrimitives )
+   {
+      primitives_.push_back( it.second );
+      primitiveBounds_.push_back( computePhysicalBoundingBox( *it.second ) );
+
+      Point3D centroid;
+      it.second->getGeometryMap()->evalF( it.second->getCoordinates()[0], centroid );
+      for ( uint_t v = 1; v < it.second->getCoordinates().size(); ++v )
+      {
+         Point3D physicalVertex;
+         it.second->getGeometryMap()->evalF( it.second->getCoordinates()[v], physicalVertex );
+         centroid += physicalVertex;
+      }
+      primitiveCentroids_.push_back( Point3D( centroid / real_c( it.second->getCoordinates().size() ) ) );
+   }
+
+   order_.resize( primitives_.size() );
+   for ( uint_t idx = 0; idx < order_.size(); ++idx )
+   {
+      order_[idx] = idx;
+   }
+
+   if ( !primitives_.empty() )
+   {
+      nodes_.reserve( 2 * primitives_.size() );
+      buildRecursive( 0, primitives_.size() );
+   }
+}
+
+template < typename PrimitiveType >
+uint_t PrimitiveBoundingVolumeHierarchy< PrimitiveType >::buildRecursive( uint_t begin, uint_t end )
+{
+   AABB< 3 > bounds = primitiveBounds_[order_[begin]];
+   for ( uint_t idx = begin + 1; idx < end; ++idx )
+   {
+      bounds = bounds.merge( primitiveBounds_[order_[idx]] );
+   }
+
+   const uint_t nodeIdx = nodes_.size();
+   nodes_.push_back( Node{ bounds, begin, end, 0, 0, true } );
+
+   if ( end - begin <= maxPrimitivesPerLeaf_ )
+   {
+      return nodeIdx;
+   }
+
+   // split at the median of the centroids along the axis of their largest extent
+   // (the extent of the boxes themselves is useless for that in 2D as they are unbounded in z-direction)
+   Point3D centroidMin = primitiveCentroids_[order_[begin]];
+   Point3D centroidMax = centroidMin;
+   for ( uint_t idx = begin + 1; idx < end; ++idx )
+   {
+      for ( uint_t d = 0; d < 3; ++d )
+      {
+         centroidMin[d] = std::min( centroidMin[d], primitiveCentroids_[order_[idx]][d] );
+         centroidMax[d] = std::max( centroidMax[d], primitiveCentroids_[order_[idx]][d] );
+      }
+   }
+
+   uint_t axis = 0;
+   for ( uint_t d = 1; d < 3; ++d )
+   {
+      if ( centroidMax[d] - centroidMin[d] > centroidMax[axis] - centroidMin[axis] )
+      {
+         axis = d;
+      }
+   }
+
+   const uint_t mid = begin + ( end - begin ) / 2;
+   std::nth_element( order_.begin() + long( begin ),
+                     order_.begin() + long( mid ),
+                     order_.begin() + long( end ),
+                     [this, axis]( uint_t a, uint_t b ) { return primitiveCentroids_[a][axis] < primitiveCentroids_[b][axis]; } );
+
+   const uint_t left  = buildRecursive( begin, mid );
+   const uint_t right = buildRecursive( mid, end );
+
+   nodes_[nodeIdx].left   = left;
+   nodes_[nodeIdx].right  = right;
+   nodes_[nodeIdx].isLeaf = false;
+
+   return nodeIdx;
+}
+
+template < typename PrimitiveType >
+bool PrimitiveBoundingVolumeHierarchy< PrimitiveType >::boxContains( const AABB< 3 >& box,
+                                                                     const Point3D&   physicalCoords,
+                                                                     real_t           margin )
+{
+   for ( uint_t d = 0; d < 3; ++d )
+   {
+      if ( physicalCoords[d] < box.min()[d] - margin || physicalCoords[d] > box.max()[d] + margin )
+      {
+         return false;
+      }
+   }
+   return true;
+}
+
+template < typename PrimitiveType >
+void PrimitiveBoundingVolumeHierarchy< PrimitiveType >::findCandidates( const Point3D&         physicalCoords,
+                                                                        real_t                 margin,
+                                                                        std::vector< uint_t >& candidates ) const
+{
+   candidates.clear();
+
+   if ( nodes_.empty() )
+   {
+      return;
+   }
+
+   std::vector< uint_t > stack;
+   stack.push_back( 0 );
+
+   while ( !stack.empty() )
+   {
+      const Node& node = nodes_[stack.back()];
+      stack.pop_back();
+
+      if ( !boxContains( node.bounds, physicalCoords, margin ) )
+      {
+         continue;
+      }
+
+      if ( node.isLeaf )
+      {
+         for ( uint_t idx = node.begin; idx < node.end; ++idx )
+         {
+            if ( boxContains( primitiveBounds_[order_[idx]], physicalCoords, margin ) )
+            {
+               candidates.push_back( order_[idx] );
+            }
+         }
+      }
+      else
+      {
+         stack.push_back( node.right );
+         stack.push_back( node.left );
+      }
+   }
+
+   std::sort( candidates.begin(), candidates.end() );
+}
+
+template < typename PrimitiveType >
+std::shared_ptr< const PrimitiveBoundingVolumeHierarchy< PrimitiveType > >
+    PrimitiveBoundingVolumeHierarchy< PrimitiveType >::getForStorage( const std::shared_ptr< PrimitiveStorage >& storage,
+                                                                      bool includeNeighborPrimitives )
+{
+   struct CacheEntry
+   {
+      std::weak_ptr< PrimitiveStorage >                          storage;
+      bool                                                       includeNeighborPrimitives;
+      uint_t                                                     modificationStamp;
+      std::shared_ptr< const PrimitiveBoundingVolumeHierarchy > hierarchy;
+   };
+
+   static std::mutex                cacheMutex;
+   static std::vector< CacheEntry > cache;
+
+   std::lock_guard< std::mutex > lock( cacheMutex );
+
+   // drop the hierarchies of storages that do not exist anymore
+   cache.erase( std::remove_if( cache.begin(), cache.end(), []( const CacheEntry& entry ) { return entry.storage.expired(); } ),
+                cache.end() );
+
+   for ( auto& entry : cache )
+   {
+      if ( entry.storage.lock() == storage && entry.includeNeighborPrimitives == includeNeighborPrimitives )
+      {
+         if ( entry.modificationStamp != storage->getModificationStamp() )
+         {
+            entry.hierarchy         = std::make_shared< const PrimitiveBoundingVolumeHierarchy >( *storage, includeNeighborPrimitives );
+            entry.modificationStamp = storage->getModificationStamp();
+         }
+         return entry.hierarchy;
+      }
+   }
+
+   cache.push_back( CacheEntry{ storage,
+                                includeNeighborPrimitives,
+                                storage->getModificationStamp(),
+                                std::make_shared< const PrimitiveBoundingVolumeHierarchy >( *storage, includeNeighborPrimitives ) } );
+   return cache.back().hierarchy;
+}
+
+template class PrimitiveBoundingVolumeHierarchy< Face >;
+template class PrimitiveBoundingVolumeHierarchy< Cell >;
+
+} // namespace hyteg
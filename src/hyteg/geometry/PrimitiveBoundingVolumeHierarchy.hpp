@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2026 Nils Kohl, Marcus Mohr.
+ *
+ * This file is part of HyTeG
+ * (see https://i10git.cs.fau.de/hyteg/hyteg).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "core/DataTypes.h"
+
+#include "hyteg/geometry/AABB.hpp"
+#include "hyteg/primitives/Cell.hpp"
+#include "hyteg/primitives/Face.hpp"
+#include "hyteg/primitivestorage/PrimitiveStorage.hpp"
+#include "hyteg/types/PointND.hpp"
+
+namespace hyteg {
+
+using walberla::real_c;
+using walberla::real_t;
+using walberla::uint_t;
+
+/// \brief Bounding volume hierarchy over the macro-faces (2D) or macro-cells (3D) of a PrimitiveStorage in the
+///        physical domain.
+///
+/// Each primitive is enclosed by an axis-aligned box that is computed by mapping a lattice of sample points of the
+/// primitive from the computational to the physical domain with its GeometryMap. The box is enlarged by a safety
+/// margin to account for the curvature of the blended primitive between the samples. The boxes are then sorted into
+/// a binary tree (median split along the axis of largest centroid extent), so that all primitives that may contain a
+/// given physical point are found in logarithmic time (for reasonably shaped meshes).
+///
+/// In 2D the boxes are unbounded in z-direction.
+///
+/// The hierarchy only provides candidates. Whether a point actually lies in a candidate primitive has to be
+/// checked with the inverse geometry map, as done in mapFromPhysicalToComputationalDomain2D/3D().
+///
+/// \tparam PrimitiveType either Face or Cell
+template < typename PrimitiveType >
+class PrimitiveBoundingVolumeHierarchy
+{
+ public:
+   /// Builds the hierarchy over all process-local primitives and, if includeNeighborPrimitives is true, over the
+   /// neighbor primitives, too.
+   PrimitiveBoundingVolumeHierarchy( const PrimitiveStorage& storage, bool includeNeighborPrimitives );
+
+   /// \brief Returns the hierarchy of the passed storage.
+   ///
+   /// The hierarchy is built on first request and cached. It is rebuilt automatically if the modification stamp
+   /// of the storage has changed in the meantime (e.g. after migration of primitives). Thread-safe, but each call locks
+   /// and searches the global cache, so fetch the hierarchy once when locating many points.
+   static std::shared_ptr< const PrimitiveBoundingVolumeHierarchy >
+       getForStorage( const std::shared_ptr< PrimitiveStorage >& storage, bool includeNeighborPrimitives );
+
+   /// Writes the indices of all primitives whose bounding box contains the passed point to candidates
+   /// (in ascending order, i.e. sorted by PrimitiveID). Previous content of candidates is discarded.
+   void findCandidates( const Point3D& physicalCoords, std::vector< uint_t >& candidates ) const
+   {
+      findCandidates( physicalCoords, real_c( 0 ), candidates );
+   }
+
+   /// Same as above, but the bounding boxes are enlarged by the passed margin on each side, i.e. all primitives
+   /// whose bounding box is closer than margin to the point (in the maximum norm) are returned.
+   void findCandidates( const Point3D& physicalCoords, real_t margin, std::vector< uint_t >& candidates ) const;
+
+   /// Returns the primitive with the passed index.
+   const PrimitiveType& getPrimitive( uint_t idx ) const { return *primitives_[idx]; }
+
+   /// Returns the (enlarged) physical bounding box of the primitive with the passed index.
+   const AABB< 3 >& getPrimitiveBounds( uint_t idx ) const { return primitiveBounds_[idx]; }
+
+   uint_t getNumPrimitives() const { return primitives_.size(); }
+
+ private:
+   struct Node
+   {
+      AABB< 3 > bounds;
+      uint_t    begin;
+      uint_t    end;
+      uint_t    left;
+      uint_t    right;
+      bool      isLeaf;
+   };
+
+   /// Returns true if the passed box, enlarged by margin on each side, contains the point.
+   static bool boxContains( const AABB< 3 >& box, const Point3D& physicalCoords, real_t margin );
+
+   /// Recursively builds the subtree for order_[begin, end) and returns the index of its root node.
+   uint_t buildRecursive( uint_t begin, uint_t end );
+
+   static constexpr uint_t maxPrimitivesPerLeaf_ = 4;
+
+   std::vector< std::shared_ptr< PrimitiveType > > primitives_;
+   std::vector< AABB< 3 > >                        primitiveBounds_;
+   std::vector< Point3D >                          primitiveCentroids_;
+
+   /// primitive indices, permuted such that each node covers a contiguous range
+   std::vector< uint_t > order_;
+   std::vector< Node >   nodes_;
+};
+
+extern template class PrimitiveBoundingVolumeHierarchy< Face >;
+extern template class PrimitiveBoundingVolumeHierarchy< Cell >;
+
+} // namespace hyteg
@@ -27,8 +27,12 @@
 #include <core/mpi/RecvBuffer.h>
 #include <core/mpi/Reduce.h>
 #include <core/mpi/SendBuffer.h>
+#include <algorithm>
 #include <map>
 #include <memory>
+#include <new>
+#include <span>
+#include <vector>
 
 #include "hyteg/misc/zeros.hpp"
 #include "hyteg/primitivedata/PrimitiveDataHandling.hpp"
@@ -38,16 +42,24 @@ namespace hyteg {
 
 using walberla::real_c;
 using walberla::real_t;
+using walberla::uint_c;
 using walberla::uint_t;
 using walberla::mpi::RecvBuffer;
 using walberla::mpi::SendBuffer;
 
+/// Alignment in bytes of all data that is allocated through FunctionMemory (one cache line, one AVX-512 register).
+constexpr std::size_t FunctionMemoryAlignment = 64;
+
+template < typename ValueType >
+class FunctionMemoryArena;
+
 template < typename ValueType >
 class FunctionMemory
 {
    static_assert( std::is_arithmetic< ValueType >::value, "Wrong ValueType template" );
    template < typename otherValueType >
    friend class FunctionMemory;
+   friend class FunctionMemoryArena< ValueType >;
 
  public:
    /// Constructs memory for a function
@@ -70,30 +82,37 @@ class FunctionMemory
       }
    }
 
-   ~FunctionMemory()
-   {
-      for ( const auto& it : data_ )
-      {
-         totalAllocatedMemoryInBytes_ -= it.second->size() * sizeof( ValueType );
-      }
-   }
-
    /// Returns true if data is allocated at the specified level, false otherwise.
-   inline bool hasLevel( const uint_t& level ) const { return data_.count( level ) > 0; }
+   inline bool hasLevel( const uint_t& level ) const { return level < data_.size() && data_[level].data != nullptr; }
 
    inline uint_t getSize( const uint_t& level ) const
    {
       WALBERLA_CHECK( hasLevel( level ), "Requested level not allocated" );
-      return data_.at( level )->size();
+      return data_[level].size;
    }
 
    /// Allocates an array of size size for a certain level
    inline void addData( const uint_t& level, const uint_t& size, const ValueType& fillValue )
+   {
+      auto data = allocate( std::max( size, uint_c( 1 ) ), size * sizeof( ValueType ) );
+      fill( data.get(), size, fillValue );
+      addArenaChunk( level, size, data );
+   }
+
+   /// Registers an already allocated (and initialized) chunk of at least size values as the data of a certain level.
+   ///
+   /// The chunk is typically handed out by a FunctionMemoryArena. It is only shared with the arena's block, so the
+   /// memory is released once all chunks of that block have been deleted.
+   inline void addArenaChunk( const uint_t& level, const uint_t& size, const std::shared_ptr< ValueType >& chunk )
    {
       WALBERLA_ASSERT( !hasLevel( level ),
                        "Attempting to overwrite already existing level (level == " << level << ") in function memory!" );
-      data_[level] = std::unique_ptr< std::vector< ValueType > >( new std::vector< ValueType >( size, fillValue ) );
-      totalAllocatedMemoryInBytes_ += size * sizeof( ValueType );
+      if ( level >= data_.size() )
+      {
+         data_.resize( level + 1 );
+      }
+      data_[level].data = chunk;
+      data_[level].size = size;
    }
 
    /// Deletes data of a certain level
@@ -101,29 +120,29 @@ class FunctionMemory
    {
       if ( !hasLevel( level ) )
          return;
-      totalAllocatedMemoryInBytes_ -= data_[level]->size() * sizeof( ValueType );
-      data_.erase( level );
+      data_[level].data.reset();
+      data_[level].size = 0;
    }
 
    /// Returns a pointer to the first entry of the allocated array
    inline ValueType* getPointer( const uint_t& level ) const
    {
       WALBERLA_CHECK( hasLevel( level ), "Requested level " << level << " not allocated" );
-      return data_.at( level )->data();
+      return data_[level].data.get();
    }
 
    /// Copies the data of one leve from the other FunctionMemory.
    template < typename otherValueType >
    inline void copyFrom( const FunctionMemory< otherValueType >& other, const uint_t& level )
    {
-      auto tIt = data_.at( level )->begin();
-      auto oIt = other.data_.at( level )->begin();
-      for ( ; tIt != data_.at( level )->end() && oIt != other.data_.at( level )->end(); ++tIt, ++oIt )
+      WALBERLA_ASSERT_EQUAL( getSize( level ), other.getSize( level ) );
+      ValueType* const            dst  = getPointer( level );
+      const otherValueType* const src  = other.getPointer( level );
+      const uint_t                size = std::min( getSize( level ), other.getSize( level ) );
+      for ( uint_t k = 0; k < size; ++k )
       {
-         ( *tIt ) = walberla::numeric_cast< ValueType >( *oIt );
+         dst[k] = walberla::numeric_cast< ValueType >( src[k] );
       }
-      WALBERLA_ASSERT_EQUAL( data_.at( level )->end(), tIt );
-      WALBERLA_ASSERT_EQUAL( other.data_.at( level )->end(), oIt );
    }
 
    inline void swap( const FunctionMemory< ValueType >& other, const uint_t& level ) const
@@ -131,26 +150,33 @@ class FunctionMemory
       WALBERLA_ASSERT( hasLevel( level ), "Requested level not allocated." );
       WALBERLA_ASSERT( other.hasLevel( level ), "Requested level not allocated." );
       WALBERLA_ASSERT_EQUAL( getSize( level ), other.getSize( level ), "Cannot swap FunctionMemory of different sizes." );
-      data_.at( level )->swap( *( other.data_.at( level ) ) );
+      // Swapping the (shared) pointers is also fine if the data lives in arenas: each chunk keeps its block alive.
+      data_[level].data.swap( other.data_[level].data );
    }
 
    inline void setToZero( const uint_t& level ) const
    {
       WALBERLA_ASSERT( hasLevel( level ), "Requested level not allocated." );
-      ValueType* ptr = data_.at( level )->data();
+      ValueType* ptr = getPointer( level );
       if constexpr ( sizeof( unsigned char ) == 1 )
       {
-         std::memset( ptr, 0u, data_.at( level )->size() * sizeof( ValueType ) );
+         std::memset( ptr, 0u, getSize( level ) * sizeof( ValueType ) );
       }
       else
       {
-         for ( uint_t k = 0; k < data_.at( level )->size(); ++k )
+         for ( uint_t k = 0; k < getSize( level ); ++k )
          {
             ptr[k] = generateZero< ValueType >();
          }
       }
    }
 
+   /// Returns a view on the data of a certain level.
+   inline std::span< const ValueType > getSpan( const uint_t& level ) const { return { getPointer( level ), getSize( level ) }; }
+   inline std::span< ValueType >       getSpan( const uint_t& level ) { return { getPointer( level ), getSize( level ) }; }
+
+   /// Returns the number of bytes that are currently allocated by all FunctionMemory instances of this ValueType on
+   /// this process. If arena allocation is used, this includes the padding between the chunks of an arena.
    inline static unsigned long long getLocalAllocatedMemoryInBytes() { return totalAllocatedMemoryInBytes_; }
    inline static unsigned long long getMinLocalAllocatedMemoryInBytes()
    {
@@ -168,20 +194,41 @@ class FunctionMemory
           totalAllocatedMemoryInBytes_, walberla::mpi::SUM, walberla::mpi::MPIManager::instance()->comm() );
    }
 
+   /// \brief Enables or disables arena allocation for all functions of this ValueType that are created afterwards.
+   ///
+   /// If enabled, functions that support it (VertexDoFFunction, EdgeDoFFunction and all composites built from them)
+   /// allocate the memory of all levels and all local macro-primitives in a single, aligned FunctionMemoryArena.
+   /// Deleting the memory of single levels or primitives (e.g. during load balancing) then does not free memory
+   /// until all chunks of the arena have been deleted.
+   inline static void setArenaAllocation( bool useArenaAllocation ) { useArenaAllocation_ = useArenaAllocation; }
+   inline static bool useArenaAllocation() { return useArenaAllocation_; }
+
    /// Serializes the allocated data to a send buffer
    inline void serialize( SendBuffer& sendBuffer ) const
    {
-      const uint_t numLevels = data_.size();
+      uint_t numLevels = 0;
+      for ( uint_t level = 0; level < data_.size(); level++ )
+      {
+         if ( hasLevel( level ) )
+         {
+            numLevels++;
+         }
+      }
       sendBuffer << numLevels;
 
-      for ( const auto& it : data_ )
+      for ( uint_t level = 0; level < data_.size(); level++ )
       {
-         const uint_t level     = it.first;
-         const uint_t levelSize = it.second->size();
+         if ( !hasLevel( level ) )
+         {
+            continue;
+         }
 
          sendBuffer << level;
-         sendBuffer << levelSize;
-         sendBuffer << getVector( level );
+         sendBuffer << getSize( level );
+         for ( const auto& value : getSpan( level ) )
+         {
+            sendBuffer << value;
+         }
       }
    }
 
@@ -204,25 +251,108 @@ class FunctionMemory
 
          addData( level, levelSize, fillValue_ );
 
-         std::vector< ValueType >& dataVector = getVector( level );
-         recvBuffer >> dataVector;
+         for ( auto& value : getSpan( level ) )
+         {
+            recvBuffer >> value;
+         }
       }
    }
-   inline const std::vector< ValueType >& getVector( const uint_t& level ) const { return *( data_.at( level ) ); }
-   inline std::vector< ValueType >&       getVector( const uint_t& level ) { return *( data_[level] ); }
 
  private:
-   /// Maps a level to the respective allocated data
-   std::map< uint_t, std::unique_ptr< std::vector< ValueType > > > data_;
+   struct LevelData
+   {
+      std::shared_ptr< ValueType > data;
+      uint_t                       size = 0;
+   };
+
+   /// Allocates (uninitialized) aligned memory for numValues values. The returned pointer adds accountedBytes to the
+   /// allocated memory counter until the memory is released.
+   static std::shared_ptr< ValueType > allocate( const uint_t& numValues, const unsigned long long& accountedBytes )
+   {
+      auto ptr = static_cast< ValueType* >(
+          ::operator new( numValues * sizeof( ValueType ), std::align_val_t( FunctionMemoryAlignment ) ) );
+      totalAllocatedMemoryInBytes_ += accountedBytes;
+      return std::shared_ptr< ValueType >( ptr, [accountedBytes]( ValueType* p ) {
+         totalAllocatedMemoryInBytes_ -= accountedBytes;
+         ::operator delete( p, std::align_val_t( FunctionMemoryAlignment ) );
+      } );
+   }
+
+   /// Fills the array. This is the first touch of the memory, so it is distributed like the (statically scheduled)
+   /// compute kernels that access it later.
+   static void fill( ValueType* ptr, const uint_t& size, const ValueType& fillValue )
+   {
+#ifdef HYTEG_BUILD_WITH_OPENMP
+#pragma omp parallel for default( shared ) schedule( static )
+#endif
+      for ( uint_t k = 0; k < size; ++k )
+      {
+         ptr[k] = fillValue;
+      }
+   }
+
+   /// Maps a level to the respective allocated data.
+   /// Mutable since swap() is const - like the function handles, the memory handle is const while the data is not.
+   mutable std::vector< LevelData > data_;
 
    const ValueType fillValue_;
 
    static unsigned long long totalAllocatedMemoryInBytes_;
+   static bool               useArenaAllocation_;
+};
+
+/// \brief A single, aligned allocation that backs the data of many FunctionMemory instances.
+///
+/// Usage is two-phased: first all chunks are reserved (which only computes their offsets), then the block is allocated
+/// and initialized at once and the chunks are handed to the FunctionMemory instances via
+/// FunctionMemory::addArenaChunk(). Each chunk starts at an offset that is a multiple of FunctionMemoryAlignment.
+///
+/// The chunks share the ownership of the block, so the arena object itself may be discarded after distributing them.
+template < typename ValueType >
+class FunctionMemoryArena
+{
+ public:
+   /// Reserves a chunk of size values and returns its offset (in values) in the block.
+   uint_t reserve( const uint_t& size )
+   {
+      WALBERLA_CHECK( block_ == nullptr, "Cannot reserve chunks after the arena has been allocated." );
+      const uint_t valuesPerAlignment = std::max( uint_c( FunctionMemoryAlignment / sizeof( ValueType ) ), uint_c( 1 ) );
+      const uint_t offset             = totalSize_;
+      totalSize_ += ( ( size + valuesPerAlignment - 1 ) / valuesPerAlignment ) * valuesPerAlignment;
+      return offset;
+   }
+
+   /// Allocates the block for all reserved chunks and fills it with the passed value.
+   void allocate( const ValueType& fillValue )
+   {
+      WALBERLA_CHECK( block_ == nullptr, "Arena has already been allocated." );
+      const uint_t size = std::max( totalSize_, uint_c( 1 ) );
+      block_            = FunctionMemory< ValueType >::allocate( size, size * sizeof( ValueType ) );
+      FunctionMemory< ValueType >::fill( block_.get(), size, fillValue );
+   }
+
+   /// Returns a pointer to the chunk at the passed offset that keeps the entire block alive.
+   std::shared_ptr< ValueType > getChunk( const uint_t& offset ) const
+   {
+      WALBERLA_CHECK_NOT_NULLPTR( block_, "Arena has not been allocated yet." );
+      WALBERLA_ASSERT_LESS( offset, std::max( totalSize_, uint_c( 1 ) ) );
+      return std::shared_ptr< ValueType >( block_, block_.get() + offset );
+   }
+
+   /// Returns the size of the block in bytes, including the padding between the chunks.
+   unsigned long long getAllocatedMemoryInBytes() const { return std::max( totalSize_, uint_c( 1 ) ) * sizeof( ValueType ); }
+
+ private:
+   uint_t                       totalSize_ = 0;
+   std::shared_ptr< ValueType > block_;
 };
 
 template < typename ValueType >
 unsigned long long FunctionMemory< ValueType >::totalAllocatedMemoryInBytes_ = 0;
 
+template < typename ValueType >
+bool FunctionMemory< ValueType >::useArenaAllocation_ = false;
+
 } // namespace hyteg
 
 namespace walberla {
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2026 Nils Kohl, Marcus Mohr.
+ *
+ * This file is part of HyTeG
+ * (see https://i10git.cs.fau.de/hyteg/hyteg).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "core/DataTypes.h"
+
+#include "hyteg/functions/FunctionProperties.hpp"
+#include "hyteg/operators/Operator.hpp"
+#include "hyteg/solvers/Smoothables.hpp"
+#include "hyteg/sparseassembly/CSRSparseMatrix.hpp"
+#include "hyteg/sparseassembly/LocalVectorProxy.hpp"
+
+namespace hyteg {
+
+/// \brief Applies an operator through its assembled matrix, stored in the library independent CSRSparseMatrix format.
+///
+/// The matrix of the wrapped operator is assembled once per level in the constructor (including the rows and columns of
+/// all boundary DoFs). Since the wrapper is an operator itself and provides the inverse of the diagonal, it can be used
+/// in all solvers that only rely on apply() and Jacobi-type smoothing, e.g. in the GeometricMultigridSolver together with
+/// the WeightedJacobiSmoother or the ChebyshevSmoother, and the CGSolver as coarse grid solver.
+///
+/// \tparam OperatorType type of the wrapped operator, which must implement toMatrix() and map a function space onto itself
+template < class OperatorType >
+class CSRMatrixOperator : public Operator< typename OperatorType::srcType, typename OperatorType::dstType >,
+                          public WeightedJacobiSmoothable< typename OperatorType::srcType >,
+                          public OperatorWithInverseDiagonal< typename OperatorType::srcType >
+{
+ public:
+   using FunctionType          = typename OperatorType::srcType;
+   using NumeratorFunctionType = typename FunctionType::template FunctionType< idx_t >;
+
+   static_assert( std::is_same_v< typename OperatorType::srcType, typename OperatorType::dstType >,
+                  "CSRMatrixOperator only supports operators that map a function space onto itself." );
+
+   /// \param op        the operator to be assembled
+   /// \param minLevel  the coarsest level on which the operator is assembled
+   /// \param maxLevel  the finest level on which the operator is assembled
+   CSRMatrixOperator( const OperatorType& op, uint_t minLevel, uint_t maxLevel )
+   : Operator< FunctionType, FunctionType >( op.getStorage(), minLevel, maxLevel )
+   , numerator_( "numerator", op.getStorage(), minLevel, maxLevel )
+   {
+      for ( uint_t level = minLevel; level <= maxLevel; ++level )
+      {
+         numerator_.enumerate( level );
+
+         const uint_t localDoFs = numberOfLocalDoFs( numerator_, level );
+
+         auto mat = std::make_shared< CSRSparseMatrix >( localDoFs, localDoFs );
+         op.toMatrix( mat, numerator_, numerator_, level, All );
+         mat->assemble();
+
+         matrices_[level] = mat;
+      }
+   }
+
+   void apply( const FunctionType& src,
+               const FunctionType& dst,
+               uint_t              level,
+               DoFType             flag,
+               UpdateType          updateType = Replace ) const override
+   {
+      this->startTiming( "apply" );
+
+      auto& mat = *matrices_.at( level );
+
+      srcValues_.resize( mat.getNumLocalCols() );
+      src.toVector( numerator_, std::make_shared< LocalVectorProxy >( srcValues_, mat.getColOffset() ), level, All );
+
+      mat.multiply( srcValues_, dstValues_ );
+
+      if ( updateType == Add )
+      {
+         std::vector< real_t > previousValues( dstValues_.size(), real_c( 0 ) );
+         dst.toVector( numerator_, std::make_shared< LocalVectorProxy >( previousValues, mat.getRowOffset() ), level, flag );
+         for ( uint_t i = 0; i < dstValues_.size(); ++i )
+         {
+            dstValues_[i] += previousValues[i];
+         }
+      }
+
+      dst.fromVector( numerator_, std::make_shared< LocalVectorProxy >( dstValues_, mat.getRowOffset() ), level, flag );
+
+      this->stopTiming( "apply" );
+   }
+
+   void smooth_jac( const FunctionType& dst,
+                    const FunctionType& rhs,
+                    const FunctionType& src,
+                    real_t              omega,
+                    size_t              level,
+                    DoFType             flag ) const override
+   {
+      this->startTiming( "smooth_jac" );
+
+      // compute the current residual
+      apply( src, dst, level, flag );
+      dst.assign( { real_c( 1 ), real_c( -1 ) }, { rhs, dst }, level, flag );
+
+      // perform Jacobi update step
+      dst.multElementwise( { *getInverseDiagonalValues(), dst }, level, flag );
+      dst.assign( { real_c( 1 ), omega }, { src, dst }, level, flag );
+
+      this->stopTiming( "smooth_jac" );
+   }
+
+   /// Extracts the inverse of the diagonal from the assembled matrices.
+   /// Allocates the required memory if the function was not yet allocated.
+   void computeInverseDiagonalOperatorValues() override
+   {
+      if ( !inverseDiagonalValues_ )
+      {
+         inverseDiagonalValues_ =
+             std::make_shared< FunctionType >( "inverse diagonal entries", this->storage_, this->minLevel_, this->maxLevel_ );
+      }
+
+      for ( uint_t level = this->minLevel_; level <= this->maxLevel_; ++level )
+      {
+         const auto& mat      = *matrices_.at( level );
+         auto        diagonal = mat.getDiagonal();
+         for ( auto& value : diagonal )
+         {
+            value = real_c( 1 ) / value;
+         }
+         inverseDiagonalValues_->fromVector(
+             numerator_, std::make_shared< LocalVectorProxy >( diagonal, mat.getRowOffset() ), level, All );
+      }
+   }
+
+   std::shared_ptr< FunctionType > getInverseDiagonalValues() const override
+   {
+      WALBERLA_CHECK_NOT_NULLPTR(
+          inverseDiagonalValues_,
+          "Inverse diagonal values have not been assembled, call computeInverseDiagonalOperatorValues() to set up this function." )
+      return inverseDiagonalValues_;
+   }
+
+   /// \brief Returns the assembled matrix on the passed level.
+   const std::shared_ptr< CSRSparseMatrix >& getMatrix( uint_t level ) const { return matrices_.at( level ); }
+
+ private:
+   NumeratorFunctionType numerator_;
+
+   std::map< uint_t, std::shared_ptr< CSRSparseMatrix > > matrices_;
+
+   std::shared_ptr< FunctionType > inverseDiagonalValues_;
+
+   /// buffers for the local parts of the source and destination vectors
+   mutable std::vector< real_t > srcValues_;
+   mutable std::vector< real_t > dstValues_;
+};
+
+} // namespace hyteg
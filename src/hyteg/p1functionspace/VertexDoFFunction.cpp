@@ -19,6 +19,7 @@
  */
 #include "VertexDoFFunction.hpp"
 
+#include <tuple>
 #include <typeinfo>
 #include <utility>
 
@@ -28,6 +29,7 @@
 #include "hyteg/boundary/BoundaryConditions.hpp"
 #include "hyteg/communication/Syncing.hpp"
 #include "hyteg/edgedofspace/EdgeDoFIndexing.hpp"
+#include "hyteg/functions/BatchEvaluation.hpp"
 #include "hyteg/functions/Function.hpp"
 #include "hyteg/functions/FunctionProperties.hpp"
 #include "hyteg/geometry/BlendingHelpers.hpp"
@@ -135,6 +137,11 @@ VertexDoFFunction< ValueType >::VertexDoFFunction( const std::string&
       }
    }
 
+   if ( FunctionMemory< ValueType >::useArenaAllocation() )
+   {
+      allocateArenaMemory( minLevel, maxLevel );
+   }
+
    for ( uint_t level = minLevel; level <= maxLevel; ++level )
    {
       for ( const auto& it : storage->getVertices() )
@@ -332,6 +339,67 @@ void VertexDoFFunction< ValueType >::allocateMemory( const uint_t& level, const
    }
 }
 
+template < typename ValueType >
+void VertexDoFFunction< ValueType >::allocateArenaMemory( uint_t minLevel, uint_t maxLevel )
+{
+   using ChunkInfo = std::tuple< FunctionMemory< ValueType >*, uint_t, uint_t, uint_t >;
+
+   FunctionMemoryArena< ValueType > arena;
+   std::vector< ChunkInfo >         chunks;
+
+   auto reserve = [&]( FunctionMemory< ValueType >* memory, uint_t level, uint_t size ) {
+      chunks.emplace_back( memory, level, size, arena.reserve( size ) );
+   };
+
+   // Level-major ordering, so that the data of all primitives of one level is contiguous.
+   for ( uint_t level = minLevel; level <= maxLevel; ++level )
+   {
+      for ( const auto& it : this->getStorage()->getVertices() )
+      {
+         const Vertex& vertex = *it.second;
+         reserve( vertex.getData( getVertexDataID() ), level, vertexDoFMacroVertexFunctionMemorySize( level, vertex ) );
+      }
+      for ( const auto& it : this->getStorage()->getEdges() )
+      {
+         const Edge& edge = *it.second;
+         reserve( edge.getData( getEdgeDataID() ), level, vertexDoFMacroEdgeFunctionMemorySize( level, edge ) );
+      }
+      for ( const auto& it : this->getStorage()->getFaces() )
+      {
+         const Face& face = *it.second;
+         reserve( face.getData( getFaceDataID() ), level, vertexDoFMacroFaceFunctionMemorySize( level, face ) );
+         if ( !this->getStorage()->hasGlobalCells() && hasVolumeGhostLayer() )
+         {
+            for ( uint_t glID = 0; glID < 3; glID++ )
+            {
+               reserve( face.getData( getFaceGLDataID( glID ) ), level, levelinfo::num_microedges_per_edge( level ) );
+            }
+         }
+      }
+      for ( const auto& it : this->getStorage()->getCells() )
+      {
+         const Cell& cell = *it.second;
+         reserve( cell.getData( getCellDataID() ), level, vertexDoFMacroCellFunctionMemorySize( level, cell ) );
+         if ( this->getStorage()->hasGlobalCells() && hasVolumeGhostLayer() )
+         {
+            for ( uint_t glID = 0; glID < 4; glID++ )
+            {
+               reserve( cell.getData( getCellGLDataID( glID ) ),
+                        level,
+                        facedof::macroface::numMicroFacesPerMacroFace( level, facedof::FaceType::GRAY ) );
+            }
+         }
+      }
+   }
+
+   arena.allocate( 0 );
+
+   for ( const auto& [memory, level, size, offset] : chunks )
+   {
+      memory->addArenaChunk( level, size, arena.getChunk( offset ) );
+   }
+}
+
 template < typename ValueType >
 void VertexDoFFunction< ValueType >::deleteMemory( const uint_t& level, const Vertex& vertex )
 {
@@ -765,6 +833,58 @@ bool VertexDoFFunction< ValueType >::evaluate( const Point3D& physicalCoords,
    return false;
 }
 
+template < typename ValueType >
+std::vector< bool > VertexDoFFunction< ValueType >::evaluateBatch( std::span< const Point3D > physicalCoords,
+                                                                   uint_t                     level,
+                                                                   std::span< ValueType >     values,
+                                                                   real_t                     searchToleranceRadius,
+                                                                   real_t                     distanceTolerance,
+                                                                   bool                       useBestGuess ) const
+{
+   if constexpr ( !std::is_same< ValueType, real_t >::value )
+   {
+      WALBERLA_UNUSED( physicalCoords );
+      WALBERLA_UNUSED( level );
+      WALBERLA_UNUSED( values );
+      WALBERLA_UNUSED( searchToleranceRadius );
+      WALBERLA_UNUSED( distanceTolerance );
+      WALBERLA_UNUSED( useBestGuess );
+      WALBERLA_ABORT( "VertexDoFFunction< ValueType >::evaluateBatch not implemented for requested template parameter" );
+      return {};
+   }
+   else
+   {
+      auto storage = this->getStorage();
+      auto threeD  = storage->hasGlobalCells();
+
+      auto evaluateInPrimitive = [&]( const PrimitiveID& id, const Point3D& computationalCoords ) {
+         return threeD ? vertexdof::macrocell::evaluate( level, *( storage->getCell( id ) ), computationalCoords, cellDataID_ ) :
+                         vertexdof::macroface::evaluate( level, *( storage->getFace( id ) ), computationalCoords, faceDataID_ );
+      };
+
+      return evaluateBatchLocally(
+          storage, physicalCoords, level, values, evaluateInPrimitive, searchToleranceRadius, distanceTolerance, useBestGuess );
+   }
+
+   // will not be reached, but some compilers complain otherwise
+   return {};
+}
+
+template < typename ValueType >
+std::vector< bool > VertexDoFFunction< ValueType >::evaluateBatchGlobal( std::span< const Point3D > physicalCoords,
+                                                                         uint_t                     level,
+                                                                         std::span< ValueType >     values,
+                                                                         real_t                     searchToleranceRadius,
+                                                                         real_t                     distanceTolerance,
+                                                                         bool                       useBestGuess ) const
+{
+   auto localBatchEvaluation =
+       [&]( std::span< const Point3D > localCoords, std::span< ValueType > localValues, bool localUseBestGuess ) {
+          return evaluateBatch( localCoords, level, localValues, searchToleranceRadius, distanceTolerance, localUseBestGuess );
+       };
+   return evaluateBatchDistributed( this->getStorage(), physicalCoords, values, localBatchEvaluation, useBestGuess );
+}
+
 template < typename ValueType >
 void VertexDoFFunction< ValueType >::evaluateGradient( const Point3D& physicalCoords, uint_t level, Point3D& gradient ) const
 {
@@ -1792,6 +1912,208 @@ ValueType VertexDoFFunction< ValueType >::dotLocal( const VertexDoFFunction< Val
    return scalarProduct;
 }
 
+template < typename ValueType >
+ValueType VertexDoFFunction< ValueType >::addAndDotGlobal( ValueType                             scalar,
+                                                           const VertexDoFFunction< ValueType >& src,
+                                                           uint_t                                level,
+                                                           DoFType                               flag ) const
+{
+   ValueType scalarProduct = addAndDotLocal( scalar, src, level, flag );
+   this->startTiming( "Dot (reduce)" );
+   walberla::mpi::allReduceInplace( scalarProduct, walberla::mpi::SUM, walberla::mpi::MPIManager::instance()->comm() );
+   this->stopTiming( "Dot (reduce)" );
+   return scalarProduct;
+}
+
+template < typename ValueType >
+ValueType VertexDoFFunction< ValueType >::addAndDotLocal( ValueType                             scalar,
+                                                          const VertexDoFFunction< ValueType >& src,
+                                                          uint_t                                level,
+                                                          DoFType                               flag ) const
+{
+   this->startTiming( "Add and dot (local)" );
+   auto scalarProduct = ValueType( 0 );
+
+   ValueType                  scalarProductVertices = 0;
+   std::vector< PrimitiveID > vertexIDs             = this->getStorage()->getVertexIDs();
+#ifdef HYTEG_BUILD_WITH_OPENMP
+#pragma omp parallel for reduction( + : scalarProductVertices )
+#endif
+   for ( int i = 0; i < int_c( vertexIDs.size() ); i++ )
+   {
+      Vertex& vertex = *this->getStorage()->getVertex( vertexIDs[uint_c( i )] );
+
+      if ( testFlag( boundaryCondition_.getBoundaryType( vertex.getMeshBoundaryFlag() ), flag ) )
+      {
+         scalarProductVertices += vertexdof::macrovertex::addAndDot( vertex, scalar, src.vertexDataID_, vertexDataID_, level );
+      }
+   }
+   scalarProduct += scalarProductVertices;
+
+   ValueType                  scalarProductEdges = 0;
+   std::vector< PrimitiveID > edgeIDs            = this->getStorage()->getEdgeIDs();
+#ifdef HYTEG_BUILD_WITH_OPENMP
+#pragma omp parallel for reduction( + : scalarProductEdges )
+#endif
+   for ( int i = 0; i < int_c( edgeIDs.size() ); i++ )
+   {
+      Edge& edge = *this->getStorage()->getEdge( edgeIDs[uint_c( i )] );
+
+      if ( testFlag( boundaryCondition_.getBoundaryType( edge.getMeshBoundaryFlag() ), flag ) )
+      {
+         scalarProductEdges += vertexdof::macroedge::addAndDot< ValueType >( level, edge, scalar, src.edgeDataID_, edgeDataID_ );
+      }
+   }
+   scalarProduct += scalarProductEdges;
+
+   ValueType                  scalarProductFaces = 0;
+   std::vector< PrimitiveID > faceIDs            = this->getStorage()->getFaceIDs();
+#ifdef HYTEG_BUILD_WITH_OPENMP
+#pragma omp parallel for reduction( + : scalarProductFaces )
+#endif
+   for ( int i = 0; i < int_c( faceIDs.size() ); i++ )
+   {
+      Face& face = *this->getStorage()->getFace( faceIDs[uint_c( i )] );
+
+      if ( testFlag( boundaryCondition_.getBoundaryType( face.getMeshBoundaryFlag() ), flag ) )
+      {
+         scalarProductFaces += vertexdof::macroface::addAndDot< ValueType >( level, face, scalar, src.faceDataID_, faceDataID_ );
+      }
+   }
+   scalarProduct += scalarProductFaces;
+
+   ValueType                  scalarProductCells = 0;
+   std::vector< PrimitiveID > cellIDs            = this->getStorage()->getCellIDs();
+#ifdef HYTEG_BUILD_WITH_OPENMP
+#pragma omp parallel for reduction( + : scalarProductCells )
+#endif
+   for ( int i = 0; i < int_c( cellIDs.size() ); i++ )
+   {
+      Cell& cell = *this->getStorage()->getCell( cellIDs[uint_c( i )] );
+
+      if ( testFlag( boundaryCondition_.getBoundaryType( cell.getMeshBoundaryFlag() ), flag ) )
+      {
+         scalarProductCells += vertexdof::macrocell::addAndDot< ValueType >( level, cell, scalar, src.cellDataID_, cellDataID_ );
+      }
+   }
+   scalarProduct += scalarProductCells;
+
+   this->stopTiming( "Add and dot (local)" );
+   return scalarProduct;
+}
+
+template < typename ValueType >
+std::vector< ValueType > VertexDoFFunction< ValueType >::dotLocalBatch(
+    const std::vector< std::reference_wrapper< const VertexDoFFunction< ValueType > > >& rhs,
+    uint_t                                                                               level,
+    DoFType                                                                              flag ) const
+{
+   this->startTiming( "Dot batch (local)" );
+   std::vector< ValueType > scalarProducts( rhs.size(), ValueType( 0 ) );
+
+   std::vector< PrimitiveDataID< FunctionMemory< ValueType >, Vertex > > rhsVertexIDs;
+   std::vector< PrimitiveDataID< FunctionMemory< ValueType >, Edge > >   rhsEdgeIDs;
+   std::vector< PrimitiveDataID< FunctionMemory< ValueType >, Face > >   rhsFaceIDs;
+   std::vector< PrimitiveDataID< FunctionMemory< ValueType >, Cell > >   rhsCellIDs;
+   for ( const VertexDoFFunction< ValueType >& function : rhs )
+   {
+      rhsVertexIDs.push_back( function.vertexDataID_ );
+      rhsEdgeIDs.push_back( function.edgeDataID_ );
+      rhsFaceIDs.push_back( function.faceDataID_ );
+      rhsCellIDs.push_back( function.cellDataID_ );
+   }
+
+   const std::vector< PrimitiveID > vertexIDs = this->getStorage()->getVertexIDs();
+   const std::vector< PrimitiveID > edgeIDs   = this->getStorage()->getEdgeIDs();
+   const std::vector< PrimitiveID > faceIDs   = this->getStorage()->getFaceIDs();
+   const std::vector< PrimitiveID > cellIDs   = this->getStorage()->getCellIDs();
+
+   // each thread accumulates its own products, which are summed up at the end
+#ifdef HYTEG_BUILD_WITH_OPENMP
+#pragma omp parallel
+#endif
+   {
+      std::vector< ValueType > threadScalarProducts( rhs.size(), ValueType( 0 ) );
+
+#ifdef HYTEG_BUILD_WITH_OPENMP
+#pragma omp for
+#endif
+      for ( int i = 0; i < int_c( vertexIDs.size() ); i++ )
+      {
+         Vertex& vertex = *this->getStorage()->getVertex( vertexIDs[uint_c( i )] );
+         if ( testFlag( boundaryCondition_.getBoundaryType( vertex.getMeshBoundaryFlag() ), flag ) )
+         {
+            vertexdof::macrovertex::dotBatch( vertex, vertexDataID_, rhsVertexIDs, level, threadScalarProducts );
+         }
+      }
+
+      if ( level >= 1 )
+      {
+#ifdef HYTEG_BUILD_WITH_OPENMP
+#pragma omp for
+#endif
+         for ( int i = 0; i < int_c( edgeIDs.size() ); i++ )
+         {
+            Edge& edge = *this->getStorage()->getEdge( edgeIDs[uint_c( i )] );
+            if ( testFlag( boundaryCondition_.getBoundaryType( edge.getMeshBoundaryFlag() ), flag ) )
+            {
+               vertexdof::macroedge::dotBatch< ValueType >( level, edge, edgeDataID_, rhsEdgeIDs, threadScalarProducts );
+            }
+         }
+
+#ifdef HYTEG_BUILD_WITH_OPENMP
+#pragma omp for
+#endif
+         for ( int i = 0; i < int_c( faceIDs.size() ); i++ )
+         {
+            Face& face = *this->getStorage()->getFace( faceIDs[uint_c( i )] );
+            if ( testFlag( boundaryCondition_.getBoundaryType( face.getMeshBoundaryFlag() ), flag ) )
+            {
+               vertexdof::macroface::dotBatch< ValueType >( level, face, faceDataID_, rhsFaceIDs, threadScalarProducts );
+            }
+         }
+
+#ifdef HYTEG_BUILD_WITH_OPENMP
+#pragma omp for
+#endif
+         for ( int i = 0; i < int_c( cellIDs.size() ); i++ )
+         {
+            Cell& cell = *this->getStorage()->getCell( cellIDs[uint_c( i )] );
+            if ( testFlag( boundaryCondition_.getBoundaryType( cell.getMeshBoundaryFlag() ), flag ) )
+            {
+               vertexdof::macrocell::dotBatch< ValueType >( level, cell, cellDataID_, rhsCellIDs, threadScalarProducts );
+            }
+         }
+      }
+
+#ifdef HYTEG_BUILD_WITH_OPENMP
+#pragma omp critical
+#endif
+      {
+         for ( uint_t k = 0; k < scalarProducts.size(); k++ )
+         {
+            scalarProducts[k] += threadScalarProducts[k];
+         }
+      }
+   }
+
+   this->stopTiming( "Dot batch (local)" );
+   return scalarProducts;
+}
+
+template < typename ValueType >
+std::vector< ValueType > VertexDoFFunction< ValueType >::dotGlobalBatch(
+    const std::vector< std::reference_wrapper< const VertexDoFFunction< ValueType > > >& rhs,
+    uint_t                                                                               level,
+    DoFType                                                                              flag ) const
+{
+   std::vector< ValueType > scalarProducts = dotLocalBatch( rhs, level, flag );
+   this->startTiming( "Dot batch (reduce)" );
+   walberla::mpi::allReduceInplace( scalarProducts, walberla::mpi::SUM, walberla::mpi::MPIManager::instance()->comm() );
+   this->stopTiming( "Dot batch (reduce)" );
+   return scalarProducts;
+}
+
 template < typename ValueType >
 ValueType VertexDoFFunction< ValueType >::sumGlobal( const uint_t& level, const DoFType& flag, const bool& absolute ) const
 {
@@ -20,6 +20,7 @@
 #pragma once
 
 #include <memory>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -219,6 +220,44 @@ class VertexDoFFunction final : public Function< VertexDoFFunction< ValueType >
                   real_t         distanceTolerance     = real_c( 0 ),
                   bool           useBestGuess          = false ) const;
 
+   /// \brief Evaluate finite element function at many coordinates at once.
+   ///
+   /// Equivalent to calling evaluate() for each point (without the PrimitiveID hint), but the points are first located
+   /// in the macro-primitives and then evaluated grouped by macro-primitive and micro-element for better memory locality.
+   ///
+   /// No communication is performed in this function, i.e. only points that can be found in the local subdomain are
+   /// evaluated. Use evaluateBatchGlobal() if the points are distributed arbitrarily.
+   ///
+   /// \param physicalCoords coordinates in physical domain where the function is to be evaluated
+   /// \param level refinement level
+   /// \param values function values at the coordinates (same size as physicalCoords), only set where the search was successful
+   /// \return for each point, true if the function was evaluated successfully
+   ///
+   std::vector< bool > evaluateBatch( std::span< const Point3D > physicalCoords,
+                                      uint_t                     level,
+                                      std::span< ValueType >     values,
+                                      real_t                     searchToleranceRadius = real_c( 1e-05 ),
+                                      real_t                     distanceTolerance     = real_c( 0 ),
+                                      bool                       useBestGuess          = false ) const;
+
+   /// \brief Evaluate finite element function at many coordinates that may lie in the subdomain of any process.
+   ///
+   /// Like evaluateBatch(), but points that are not found in the local subdomain are sent to the processes that may own
+   /// them, evaluated there, and the values are sent back.
+   ///
+   /// Must be called collectively. Each process may pass different points (also none).
+   ///
+   /// All points are first searched exactly on all candidate processes, so the values do not depend on the
+   /// partitioning. If useBestGuess is true, only the points that are not found on any process are evaluated in the
+   /// closest nearby primitive of the calling process (see evaluateBatchDistributed()).
+   ///
+   std::vector< bool > evaluateBatchGlobal( std::span< const Point3D > physicalCoords,
+                                            uint_t                     level,
+                                            std::span< ValueType >     values,
+                                            real_t                     searchToleranceRadius = real_c( 1e-05 ),
+                                            real_t                     distanceTolerance     = real_c( 0 ),
+                                            bool                       useBestGuess          = false ) const;
+
    void evaluateGradient( const Point3D& physicalCoords, uint_t level, Point3D& gradient ) const;
 
    void assign( const std::vector< ValueType >&                                                      scalars,
@@ -254,6 +293,25 @@ class VertexDoFFunction final : public Function< VertexDoFFunction< ValueType >
    ValueType dotLocal( const VertexDoFFunction< ValueType >& rhs, uint_t level, DoFType flag = All ) const;
    ValueType dotGlobal( const VertexDoFFunction< ValueType >& rhs, uint_t level, DoFType flag = All ) const;
 
+   /// \brief Adds scalar * src to this function and returns the dot product of the updated function with itself.
+   ///
+   /// Equivalent to add( { scalar }, { src }, level, flag ) followed by dotLocal( *this, level, flag ), but touches the
+   /// memory only once. Useful for residual updates in Krylov methods.
+   ValueType addAndDotLocal( ValueType scalar, const VertexDoFFunction< ValueType >& src, uint_t level, DoFType flag = All ) const;
+   /// Same as addAndDotLocal() but performs a global reduction of the dot product.
+   ValueType addAndDotGlobal( ValueType scalar, const VertexDoFFunction< ValueType >& src, uint_t level, DoFType flag = All ) const;
+
+   /// \brief Computes the dot products of this function with each of the passed functions.
+   ///
+   /// Reads the data of this function only once for all dot products. The global variant sums up all results with a
+   /// single reduction, which is much cheaper than rhs.size() calls to dotGlobal() if the reductions are latency bound.
+   std::vector< ValueType > dotLocalBatch( const std::vector< std::reference_wrapper< const VertexDoFFunction< ValueType > > >& rhs,
+                                           uint_t                                                                               level,
+                                           DoFType flag = All ) const;
+   std::vector< ValueType > dotGlobalBatch( const std::vector< std::reference_wrapper< const VertexDoFFunction< ValueType > > >& rhs,
+                                            uint_t                                                                               level,
+                                            DoFType flag = All ) const;
+
    ValueType sumLocal( const uint_t& level, const DoFType& flag = All, const bool& absolute = false ) const;
    ValueType sumGlobal( const uint_t& level, const DoFType& flag = All, const bool& absolute = false ) const;
 
@@ -552,6 +610,10 @@ class VertexDoFFunction final : public Function< VertexDoFFunction< ValueType >
    template < typename PrimitiveType >
    void interpolateByPrimitiveType( const ValueType& constant, uint_t level, DoFType flag = All ) const;
 
+   /// Allocates the memory of all levels and all local primitives (including the volume ghost-layers) in a single
+   /// FunctionMemoryArena. Called by the constructor if FunctionMemory::useArenaAllocation() is set.
+   void allocateArenaMemory( uint_t minLevel, uint_t maxLevel );
+
    inline void deleteFunctionMemory()
    {
       this->storage_->deleteVertexData( vertexDataID_ );
@@ -528,6 +528,62 @@ inline ValueType dot( const uint_t&
    return sp;
 }
 
+/// Adds scalar * src to dst and returns the dot product of the updated dst with itself in one sweep.
+template < concepts::value_type ValueType >
+inline ValueType addAndDot( const uint_t&                                               level,
+                            const Cell&                                                 cell,
+                            const ValueType&                                            scalar,
+                            const PrimitiveDataID< FunctionMemory< ValueType >, Cell >& srcId,
+                            const PrimitiveDataID< FunctionMemory< ValueType >, Cell >& dstId )
+{
+   auto sp = ValueType( 0 );
+
+   const ValueType* src = cell.getData( srcId )->getPointer( level );
+   ValueType*       dst = cell.getData( dstId )->getPointer( level );
+
+   for ( const auto& it : vertexdof::macrocell::Iterator( level, 1 ) )
+   {
+      const uint_t idx = vertexdof::macrocell::indexFromVertex( level, it.x(), it.y(), it.z(), stencilDirection::VERTEX_C );
+      dst[idx] += scalar * src[idx];
+      sp += dst[idx] * dst[idx];
+   }
+
+   return sp;
+}
+
+template < concepts::value_type ValueType >
+inline void dotBatch( const uint_t&                                                              level,
+                      const Cell&                                                                cell,
+                      const PrimitiveDataID< FunctionMemory< ValueType >, Cell >&                lhsId,
+                      const std::vector< PrimitiveDataID< FunctionMemory< ValueType >, Cell > >& rhsIds,
+                      std::vector< ValueType >&                                                  scalarProducts )
+{
+   const uint_t             numRhs = rhsIds.size();
+   std::vector< ValueType > products( numRhs, ValueType( 0 ) );
+
+   const ValueType*                lhs = cell.getData( lhsId )->getPointer( level );
+   std::vector< const ValueType* > rhs( numRhs );
+   for ( uint_t k = 0; k < numRhs; ++k )
+   {
+      rhs[k] = cell.getData( rhsIds[k] )->getPointer( level );
+   }
+
+   for ( const auto& it : vertexdof::macrocell::Iterator( level, 1 ) )
+   {
+      const uint_t idx = vertexdof::macrocell::indexFromVertex( level, it.x(), it.y(), it.z(), stencilDirection::VERTEX_C );
+      const ValueType lhsValue = lhs[idx];
+      for ( uint_t k = 0; k < numRhs; ++k )
+      {
+         products[k] += lhsValue * rhs[k][idx];
+      }
+   }
+
+   for ( uint_t k = 0; k < numRhs; ++k )
+   {
+      scalarProducts[k] += products[k];
+   }
+}
+
 template < concepts::value_type ValueType >
 inline ValueType sum( const uint_t&                                               level,
                       const Cell&                                                 cell,
@@ -315,6 +315,64 @@ inline ValueType dot( const uint_t&
    return scalarProduct.get();
 }
 
+/// Adds scalar * src to dst and returns the dot product of the updated dst with itself in one sweep.
+template < concepts::value_type ValueType >
+inline ValueType addAndDot( const uint_t&                                               level,
+                            Edge&                                                       edge,
+                            const ValueType&                                            scalar,
+                            const PrimitiveDataID< FunctionMemory< ValueType >, Edge >& srcId,
+                            const PrimitiveDataID< FunctionMemory< ValueType >, Edge >& dstId )
+{
+   walberla::math::KahanAccumulator< ValueType > scalarProduct;
+   const size_t                                  rowsize = levelinfo::num_microvertices_per_edge( level );
+
+   const ValueType* src = edge.getData( srcId )->getPointer( level );
+   ValueType*       dst = edge.getData( dstId )->getPointer( level );
+
+   for ( size_t i = 1; i < rowsize - 1; ++i )
+   {
+      const uint_t idx = vertexdof::macroedge::indexFromVertex( level, i, stencilDirection::VERTEX_C );
+      dst[idx] += scalar * src[idx];
+      scalarProduct += dst[idx] * dst[idx];
+   }
+
+   return scalarProduct.get();
+}
+
+template < concepts::value_type ValueType >
+inline void dotBatch( const uint_t&                                                              level,
+                      Edge&                                                                      edge,
+                      const PrimitiveDataID< FunctionMemory< ValueType >, Edge >&                lhsMemoryId,
+                      const std::vector< PrimitiveDataID< FunctionMemory< ValueType >, Edge > >& rhsMemoryIds,
+                      std::vector< ValueType >&                                                  scalarProducts )
+{
+   const uint_t                                                 numRhs  = rhsMemoryIds.size();
+   const size_t                                                 rowsize = levelinfo::num_microvertices_per_edge( level );
+   std::vector< walberla::math::KahanAccumulator< ValueType > > products( numRhs );
+
+   const ValueType*                lhs = edge.getData( lhsMemoryId )->getPointer( level );
+   std::vector< const ValueType* > rhs( numRhs );
+   for ( uint_t k = 0; k < numRhs; ++k )
+   {
+      rhs[k] = edge.getData( rhsMemoryIds[k] )->getPointer( level );
+   }
+
+   for ( size_t i = 1; i < rowsize - 1; ++i )
+   {
+      const uint_t    idx      = vertexdof::macroedge::indexFromVertex( level, i, stencilDirection::VERTEX_C );
+      const ValueType lhsValue = lhs[idx];
+      for ( uint_t k = 0; k < numRhs; ++k )
+      {
+         products[k] += lhsValue * rhs[k][idx];
+      }
+   }
+
+   for ( uint_t k = 0; k < numRhs; ++k )
+   {
+      scalarProducts[k] += products[k].get();
+   }
+}
+
 template < concepts::value_type ValueType >
 inline ValueType sum( const uint_t&                                               level,
                       const Edge&                                                 edge,
@@ -544,6 +544,73 @@ inline ValueType dot( const uint_t&
    return scalarProduct.get();
 }
 
+/// Adds scalar * src to dst and returns the dot product of the updated dst with itself in one sweep.
+template < concepts::value_type ValueType >
+inline ValueType addAndDot( const uint_t&                                               level,
+                            Face&                                                       face,
+                            const ValueType&                                            scalar,
+                            const PrimitiveDataID< FunctionMemory< ValueType >, Face >& srcId,
+                            const PrimitiveDataID< FunctionMemory< ValueType >, Face >& dstId )
+{
+   walberla::math::KahanAccumulator< ValueType > scalarProduct;
+
+   const uint_t rowsizeY = levelinfo::num_microvertices_per_edge( level );
+
+   const ValueType* src = face.getData( srcId )->getPointer( level );
+   ValueType*       dst = face.getData( dstId )->getPointer( level );
+
+   for ( uint_t j = 1; j < rowsizeY - 1; ++j )
+   {
+      const uint_t rowsizeX = rowsizeY - j;
+      for ( uint_t i = 1; i < rowsizeX - 1; ++i )
+      {
+         const uint_t idx = vertexdof::macroface::indexFromVertex( level, i, j, stencilDirection::VERTEX_C );
+         dst[idx] += scalar * src[idx];
+         scalarProduct += dst[idx] * dst[idx];
+      }
+   }
+
+   return scalarProduct.get();
+}
+
+template < concepts::value_type ValueType >
+inline void dotBatch( const uint_t&                                                              level,
+                      Face&                                                                      face,
+                      const PrimitiveDataID< FunctionMemory< ValueType >, Face >&                lhsId,
+                      const std::vector< PrimitiveDataID< FunctionMemory< ValueType >, Face > >& rhsIds,
+                      std::vector< ValueType >&                                                  scalarProducts )
+{
+   const uint_t                                                 numRhs   = rhsIds.size();
+   const uint_t                                                 rowsizeY = levelinfo::num_microvertices_per_edge( level );
+   std::vector< walberla::math::KahanAccumulator< ValueType > > products( numRhs );
+
+   const ValueType*                lhs = face.getData( lhsId )->getPointer( level );
+   std::vector< const ValueType* > rhs( numRhs );
+   for ( uint_t k = 0; k < numRhs; ++k )
+   {
+      rhs[k] = face.getData( rhsIds[k] )->getPointer( level );
+   }
+
+   for ( uint_t j = 1; j < rowsizeY - 1; ++j )
+   {
+      const uint_t rowsizeX = rowsizeY - j;
+      for ( uint_t i = 1; i < rowsizeX - 1; ++i )
+      {
+         const uint_t    idx      = vertexdof::macroface::indexFromVertex( level, i, j, stencilDirection::VERTEX_C );
+         const ValueType lhsValue = lhs[idx];
+         for ( uint_t k = 0; k < numRhs; ++k )
+         {
+            products[k] += lhsValue * rhs[k][idx];
+         }
+      }
+   }
+
+   for ( uint_t k = 0; k < numRhs; ++k )
+   {
+      scalarProducts[k] += products[k].get();
+   }
+}
+
 template < concepts::value_type ValueType >
 inline ValueType sum( const uint_t&                                               level,
                       const Face&                                                 face,
@@ -166,6 +166,33 @@ inline ValueType dot( Vertex&
    return vertex.getData( lhsMemoryId )->getPointer( level )[0] * vertex.getData( rhsMemoryId )->getPointer( level )[0];
 }
 
+/// Adds scalar * src to dst and returns the squared value of the updated dst in one sweep.
+template < concepts::value_type ValueType >
+inline ValueType addAndDot( Vertex&                                                       vertex,
+                            const ValueType&                                              scalar,
+                            const PrimitiveDataID< FunctionMemory< ValueType >, Vertex >& srcId,
+                            const PrimitiveDataID< FunctionMemory< ValueType >, Vertex >& dstId,
+                            const uint_t&                                                 level )
+{
+   ValueType& dst = vertex.getData( dstId )->getPointer( level )[0];
+   dst += scalar * vertex.getData( srcId )->getPointer( level )[0];
+   return dst * dst;
+}
+
+template < concepts::value_type ValueType >
+inline void dotBatch( Vertex&                                                                      vertex,
+                      const PrimitiveDataID< FunctionMemory< ValueType >, Vertex >&                lhsMemoryId,
+                      const std::vector< PrimitiveDataID< FunctionMemory< ValueType >, Vertex > >& rhsMemoryIds,
+                      size_t                                                                       level,
+                      std::vector< ValueType >&                                                    scalarProducts )
+{
+   const ValueType lhs = vertex.getData( lhsMemoryId )->getPointer( level )[0];
+   for ( uint_t k = 0; k < rhsMemoryIds.size(); ++k )
+   {
+      scalarProducts[k] += lhs * vertex.getData( rhsMemoryIds[k] )->getPointer( level )[0];
+   }
+}
+
 template < concepts::value_type ValueType >
 inline ValueType sum( const uint_t&                                                 level,
                       const Vertex&                                                 vertex,
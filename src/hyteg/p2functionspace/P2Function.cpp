@@ -21,6 +21,7 @@
 
 #include <algorithm>
 
+#include "hyteg/functions/BatchEvaluation.hpp"
 #include "hyteg/geometry/BlendingHelpers.hpp"
 #include "hyteg/geometry/Intersection.hpp"
 #include "hyteg/p2functionspace/P2MacroCell.hpp"
@@ -121,6 +122,66 @@ bool P2Function< ValueType >::evaluate( const Point3D& physicalCoords,
    return false;
 }
 
+template < typename ValueType >
+std::vector< bool > P2Function< ValueType >::evaluateBatch( std::span< const Point3D > physicalCoords,
+                                                            uint_t                     level,
+                                                            std::span< ValueType >     values,
+                                                            real_t                     searchToleranceRadius,
+                                                            real_t                     distanceTolerance,
+                                                            bool                       useBestGuess ) const
+{
+   if constexpr ( !std::is_same< ValueType, real_t >::value )
+   {
+      WALBERLA_UNUSED( physicalCoords );
+      WALBERLA_UNUSED( level );
+      WALBERLA_UNUSED( values );
+      WALBERLA_UNUSED( searchToleranceRadius );
+      WALBERLA_UNUSED( distanceTolerance );
+      WALBERLA_UNUSED( useBestGuess );
+      WALBERLA_ABORT( "P2Function< ValueType >::evaluateBatch not implemented for requested template parameter" );
+      return {};
+   }
+   else
+   {
+      auto storage = this->getStorage();
+      auto threeD  = storage->hasGlobalCells();
+
+      auto evaluateInPrimitive = [&]( const PrimitiveID& id, const Point3D& computationalCoords ) {
+         return threeD ? P2::macrocell::evaluate( level,
+                                                  *( storage->getCell( id ) ),
+                                                  computationalCoords,
+                                                  vertexDoFFunction_.getCellDataID(),
+                                                  edgeDoFFunction_.getCellDataID() ) :
+                         P2::macroface::evaluate( level,
+                                                  *( storage->getFace( id ) ),
+                                                  computationalCoords,
+                                                  vertexDoFFunction_.getFaceDataID(),
+                                                  edgeDoFFunction_.getFaceDataID() );
+      };
+
+      return evaluateBatchLocally(
+          storage, physicalCoords, level, values, evaluateInPrimitive, searchToleranceRadius, distanceTolerance, useBestGuess );
+   }
+
+   // will not be reached, but some compilers complain otherwise
+   return {};
+}
+
+template < typename ValueType >
+std::vector< bool > P2Function< ValueType >::evaluateBatchGlobal( std::span< const Point3D > physicalCoords,
+                                                                  uint_t                     level,
+                                                                  std::span< ValueType >     values,
+                                                                  real_t                     searchToleranceRadius,
+                                                                  real_t                     distanceTolerance,
+                                                                  bool                       useBestGuess ) const
+{
+   auto localBatchEvaluation =
+       [&]( std::span< const Point3D > localCoords, std::span< ValueType > localValues, bool localUseBestGuess ) {
+          return evaluateBatch( localCoords, level, localValues, searchToleranceRadius, distanceTolerance, localUseBestGuess );
+       };
+   return evaluateBatchDistributed( this->getStorage(), physicalCoords, values, localBatchEvaluation, useBestGuess );
+}
+
 template < typename ValueType >
 void P2Function< ValueType >::evaluateGradient( const Point3D& physicalCoords, uint_t level, Point3D& gradient ) const
 {
@@ -240,13 +301,6 @@ void P2Function< ValueType >::swap( const P2Function< ValueType >& other, const
    edgeDoFFunction_.swap( other.getEdgeDoFFunction(), level, flag );
 }
 
-template < typename ValueType >
-void P2Function< ValueType >::copyFrom( const P2Function< ValueType >& other, const uint_t& level ) const
-{
-   vertexDoFFunction_.copyFrom( other.getVertexDoFFunction(), level );
-   edgeDoFFunction_.copyFrom( other.getEdgeDoFFunction(), level );
-}
-
 template < typename ValueType >
 void P2Function< ValueType >::copyFrom( const P2Function< ValueType >&         other,
                                         const uint_t&                          level,
@@ -347,6 +401,67 @@ ValueType P2Function< ValueType >::dotLocal( const P2Function< ValueType >& rhs,
    return sum;
 }
 
+template < typename ValueType >
+ValueType P2Function< ValueType >::addAndDotGlobal( ValueType                      scalar,
+                                                    const P2Function< ValueType >& src,
+                                                    const uint_t                   level,
+                                                    const DoFType&                 flag ) const
+{
+   ValueType sum = addAndDotLocal( scalar, src, level, flag );
+   this->startTiming( "Dot (reduce)" );
+   walberla::mpi::allReduceInplace( sum, walberla::mpi::SUM, walberla::mpi::MPIManager::instance()->comm() );
+   this->stopTiming( "Dot (reduce)" );
+   return sum;
+}
+
+template < typename ValueType >
+ValueType P2Function< ValueType >::addAndDotLocal( ValueType                      scalar,
+                                                   const P2Function< ValueType >& src,
+                                                   const uint_t                   level,
+                                                   const DoFType&                 flag ) const
+{
+   auto sum = ValueType( 0 );
+   sum += vertexDoFFunction_.addAndDotLocal( scalar, src.vertexDoFFunction_, level, flag );
+   sum += edgeDoFFunction_.addAndDotLocal( scalar, src.edgeDoFFunction_, level, flag );
+   return sum;
+}
+
+template < typename ValueType >
+std::vector< ValueType >
+    P2Function< ValueType >::dotGlobalBatch( const std::vector< std::reference_wrapper< const P2Function< ValueType > > >& rhs,
+                                             const uint_t                                                                  level,
+                                             const DoFType&                                                                flag ) const
+{
+   std::vector< ValueType > sums = dotLocalBatch( rhs, level, flag );
+   this->startTiming( "Dot batch (reduce)" );
+   walberla::mpi::allReduceInplace( sums, walberla::mpi::SUM, walberla::mpi::MPIManager::instance()->comm() );
+   this->stopTiming( "Dot batch (reduce)" );
+   return sums;
+}
+
+template < typename ValueType >
+std::vector< ValueType >
+    P2Function< ValueType >::dotLocalBatch( const std::vector< std::reference_wrapper< const P2Function< ValueType > > >& rhs,
+                                            const uint_t                                                                  level,
+                                            const DoFType&                                                                flag ) const
+{
+   std::vector< std::reference_wrapper< const vertexdof::VertexDoFFunction< ValueType > > > rhsVertexDoFFunctions;
+   std::vector< std::reference_wrapper< const EdgeDoFFunction< ValueType > > >              rhsEdgeDoFFunctions;
+   for ( const P2Function< ValueType >& function : rhs )
+   {
+      rhsVertexDoFFunctions.push_back( function.vertexDoFFunction_ );
+      rhsEdgeDoFFunctions.push_back( function.edgeDoFFunction_ );
+   }
+
+   std::vector< ValueType >       sums     = vertexDoFFunction_.dotLocalBatch( rhsVertexDoFFunctions, level, flag );
+   const std::vector< ValueType > edgeSums = edgeDoFFunction_.dotLocalBatch( rhsEdgeDoFFunctions, level, flag );
+   for ( uint_t k = 0; k < sums.size(); ++k )
+   {
+      sums[k] += edgeSums[k];
+   }
+   return sums;
+}
+
 template < typename ValueType >
 ValueType P2Function< ValueType >::sumGlobal( const uint_t level, const DoFType& flag, const bool& absolute ) const
 {
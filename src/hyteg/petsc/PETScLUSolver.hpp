@@ -111,6 +111,15 @@ class PETScLUSolver : public Solver< OperatorType >
    ///        Default is false.
    void setReassembleMatrix( bool reassembleMatrix ) { reassembleMatrix_ = reassembleMatrix; }
 
+   /// \brief If set to true, the exact sparsity pattern of the operator is determined before the matrices are allocated
+   ///        (see PETScSparseMatrix::setPreallocationFromSparsityPattern()). Must be set before the first assembly.
+   void setPreallocationFromSparsityPattern( bool usePattern )
+   {
+      Amat_.setPreallocationFromSparsityPattern( usePattern );
+      AmatUnsymmetric_.setPreallocationFromSparsityPattern( usePattern );
+      AmatTmp_.setPreallocationFromSparsityPattern( usePattern );
+   }
+
    void setMUMPSIcntrl( uint_t key, int value ) { mumpsIcntrl_[key] = value; }
 
    void setMUMPSCntrl( uint_t key, real_t value ) { mumpsCntrl_[key] = value; }
@@ -37,6 +37,8 @@
 #include "hyteg/petsc/PETScSparseMatrixProxy.hpp"
 #include "hyteg/petsc/PETScVector.hpp"
 #include "hyteg/sparseassembly/DirichletBCs.hpp"
+#include "hyteg/sparseassembly/ElementSparsityPattern.hpp"
+#include "hyteg/sparseassembly/SparsityPatternProxy.hpp"
 
 namespace hyteg {
 
@@ -57,6 +59,7 @@ class PETScSparseMatrix
    , petscCommunicator_( petscCommunicator )
    , allocated_( false )
    , assembled_( false )
+   , preallocateFromSparsityPattern_( false )
    {
       PETScManager::ensureIsInitialized();
    }
@@ -79,9 +82,17 @@ class PETScSparseMatrix
       const uint_t globalRows = numberOfGlobalDoFs( numerator, level, petscCommunicator_ );
       const uint_t globalCols = numberOfGlobalDoFs( numerator, level, petscCommunicator_ );
 
-      allocateSparseMatrix( localRows, localCols, globalRows, globalCols );
+      if ( preallocateFromSparsityPattern_ )
+      {
+         allocateSparseMatrixFromSparsityPattern(
+             op, level, numerator, numerator, flag, localRows, localCols, globalRows, globalCols );
+      }
+      else
+      {
+         allocateSparseMatrix( localRows, localCols, globalRows, globalCols );
+      }
 
-      auto proxy = std::make_shared< PETScSparseMatrixProxy >( mat_ );
+      auto proxy = std::make_shared< PETScSparseMatrixProxy >( mat_, false, !preallocateFromSparsityPattern_ );
 
       op.toMatrix( proxy, numerator, numerator, level, flag );
 
@@ -101,9 +112,17 @@ class PETScSparseMatrix
       const uint_t globalRows = numberOfGlobalDoFs( numeratorDst, level, petscCommunicator_ );
       const uint_t globalCols = numberOfGlobalDoFs( numeratorSrc, level, petscCommunicator_ );
 
-      allocateSparseMatrix( localRows, localCols, globalRows, globalCols );
+      if ( preallocateFromSparsityPattern_ )
+      {
+         allocateSparseMatrixFromSparsityPattern(
+             op, level, numeratorSrc, numeratorDst, flag, localRows, localCols, globalRows, globalCols );
+      }
+      else
+      {
+         allocateSparseMatrix( localRows, localCols, globalRows, globalCols );
+      }
 
-      auto proxy = std::make_shared< PETScSparseMatrixProxy >( mat_ );
+      auto proxy = std::make_shared< PETScSparseMatrixProxy >( mat_, false, !preallocateFromSparsityPattern_ );
       op.toMatrix( proxy, numeratorSrc, numeratorDst, level, flag );
 
       MatAssemblyBegin( mat_, MAT_FINAL_ASSEMBLY );
@@ -245,6 +264,16 @@ class PETScSparseMatrix
 
    inline void reset() { assembled_ = false; }
 
+   /// \brief If set to true, the sparsity pattern of the operator is determined in an additional pass before the matrix
+   ///        is allocated, and the exact number of nonzeros per row is preallocated.
+   ///
+   ///        Compared to the default (a rough overestimation of the nonzeros per row) this needs less memory and avoids
+   ///        costly reallocations during the insertion for operators with many couplings per row.
+   ///        For scalar P1 and P2 spaces, the pattern is built from the DoF indices of the micro-elements only (see
+   ///        recordElementCouplings()). For all other spaces, the operator is assembled twice.
+   ///        Only has an effect if called before the matrix is allocated, i.e. before the first assembly.
+   inline void setPreallocationFromSparsityPattern( bool usePattern ) { preallocateFromSparsityPattern_ = usePattern; }
+
    /// \brief Sets all entries of the matrix to zero.
    inline void zeroEntries()
    {
@@ -316,6 +345,7 @@ class PETScSparseMatrix
    Mat         mat_;
    bool        allocated_;
    bool        assembled_;
+   bool        preallocateFromSparsityPattern_;
 
  private:
    inline void allocateSparseMatrix( uint_t localRows, uint_t localCols, uint_t globalRows, uint_t globalCols )
@@ -337,6 +367,53 @@ class PETScSparseMatrix
          allocated_ = true;
       }
    }
+
+   inline void allocateSparseMatrixFromSparsityPattern( const OperatorType&             op,
+                                                        uint_t                          level,
+                                                        const FunctionTypeSrc< idx_t >& numeratorSrc,
+                                                        const FunctionTypeDst< idx_t >& numeratorDst,
+                                                        DoFType                         flag,
+                                                        uint_t                          localRows,
+                                                        uint_t                          localCols,
+                                                        uint_t                          globalRows,
+                                                        uint_t                          globalCols )
+   {
+      if ( !allocated_ )
+      {
+         auto patternProxy = std::make_shared< SparsityPatternProxy >( localRows, localCols, petscCommunicator_ );
+         if constexpr ( hasElementCouplings< FunctionTypeSrc< idx_t > > && hasElementCouplings< FunctionTypeDst< idx_t > > )
+         {
+            WALBERLA_UNUSED( op );
+            WALBERLA_UNUSED( flag );
+            recordElementCouplings( *patternProxy, numeratorSrc, numeratorDst, level );
+         }
+         else
+         {
+            // No index-only path for composite spaces (e.g. vector functions and Stokes operators, which may also
+            // contain projections that couple the components). Their pattern is recorded by a full assembly into the
+            // proxy, i.e. all element matrices are integrated only to discard the values, which makes the
+            // preallocation about as expensive as the assembly itself.
+            op.toMatrix( patternProxy, numeratorSrc, numeratorDst, level, flag );
+         }
+
+         std::vector< PetscInt > diagonalNonZeros;
+         std::vector< PetscInt > offDiagonalNonZeros;
+         patternProxy->countNonZeros( diagonalNonZeros, offDiagonalNonZeros );
+
+         MatCreate( petscCommunicator_, &mat_ );
+         MatSetType( mat_, MATMPIAIJ );
+         MatSetSizes( mat_,
+                      static_cast< PetscInt >( localRows ),
+                      static_cast< PetscInt >( localCols ),
+                      static_cast< PetscInt >( globalRows ),
+                      static_cast< PetscInt >( globalCols ) );
+
+         MatMPIAIJSetPreallocation( mat_, 0, diagonalNonZeros.data(), 0, offDiagonalNonZeros.data() );
+         setName( name_.c_str() );
+         reset();
+         allocated_ = true;
+      }
+   }
 };
 
 } // namespace hyteg
@@ -34,13 +34,25 @@ using walberla::uint_t;
 class PETScSparseMatrixProxy : public SparseMatrixProxy
 {
  public:
-   PETScSparseMatrixProxy( Mat mat, bool autoDestroy = false )
+   /// \param mat          the PETSc matrix into which the values are inserted
+   /// \param autoDestroy  if true, the matrix is destroyed together with the proxy
+   /// \param preallocate  if true, (re)sets the preallocation to a rough overestimate of the number of nonzeros per row,
+   ///                     pass false if the matrix was already preallocated (e.g. from a SparsityPatternProxy),
+   ///                     in that case inserting an entry that was not preallocated is an error
+   PETScSparseMatrixProxy( Mat mat, bool autoDestroy = false, bool preallocate = true )
    : mat_( mat )
    , autoDestroy_( autoDestroy )
    {
       PETScManager::ensureIsInitialized();
-      MatSetOption( mat_, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE );
-      MatMPIAIJSetPreallocation( mat, 500, NULL, 500, NULL );
+      if ( preallocate )
+      {
+         MatSetOption( mat_, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE );
+         MatMPIAIJSetPreallocation( mat, 500, NULL, 500, NULL );
+      }
+      else
+      {
+         MatSetOption( mat_, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_TRUE );
+      }
    }
 
    ~PETScSparseMatrixProxy()
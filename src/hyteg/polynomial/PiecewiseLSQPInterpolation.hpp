@@ -25,6 +25,7 @@
 #include "core/math/extern/exprtk.h"
 
 #include "hyteg/dataexport/VTKOutput/VTKHexahedraOutput.hpp"
+#include "hyteg/geometry/AABB.hpp"
 
 #include "LSQPInterpolator.hpp"
 
@@ -46,125 +47,6 @@
 
 namespace hyteg {
 
-/// @class AABB
-/// @brief Represents an axis-aligned bounding box (AABB) in n-dimensional space.
-template < int Dim >
-class AABB
-{
- public:
-   static constexpr int D = Dim;
-
-   /// @brief Constructs an AABB with specified minimum and maximum coordinates.
-   ///
-   /// @param aabbMin The minimum coordinates of the bounding box.
-   /// @param aabbMax The maximum coordinates of the bounding box.
-   AABB( const PointND< real_t, Dim >& aabbMin, const PointND< real_t, Dim >& aabbMax )
-   : min_( aabbMin )
-   , max_( aabbMax )
-   {
-      computeLargestAxis();
-   }
-
-   PointND< real_t, Dim > min() const { return min_; }
-   PointND< real_t, Dim > max() const { return max_; }
-   int                    largestAxis() const { return largestAxis_; }
-
-   /// @brief Checks if a given point is contained within the AABB.
-   ///
-   /// @param point The point to check.
-   /// @return True if the point is within the AABB, false otherwise.
-   bool contains( const PointND< real_t, Dim >& point ) const
-   {
-      for ( size_t i = 0; i < min_.size(); ++i )
-      {
-         if ( point[i] < min_[i] || point[i] > max_[i] )
-         {
-            return false;
-         }
-      }
-      return true;
-   }
-
-   /// @brief Extends the AABB by a given factor. The center of the AABB does not change.
-   ///
-   /// @param factor The factor by which to extend the AABB.
-   /// @return A new AABB that is extended by the specified factor.
-   AABB extend( real_t factor ) const
-   {
-      PointND< real_t, Dim > newMin;
-      PointND< real_t, Dim > newMax;
-      for ( size_t i = 0; i < min_.size(); ++i )
-      {
-         real_t center     = ( min_[i] + max_[i] ) / 2;
-         real_t halfExtent = ( max_[i] - min_[i] ) / 2 * factor;
-         newMin[i]         = center - halfExtent;
-         newMax[i]         = center + halfExtent;
-      }
-      return AABB( newMin, newMax );
-   }
-
-   /// @brief Returns the vertices of an AABB.
-   ///
-   /// 2D: in counter-clockwise order
-   /// 3D: first the bottom vertices in counter-clockwise order, then the top vertices in counter-clockwise order
-   ///
-   /// @return A vector of vectors, where each inner vector represents a vertex of the AABB.
-   std::vector< PointND< real_t, Dim > > getVertices() const
-   {
-      if constexpr ( Dim == 2 )
-      {
-         return { { min_[0], min_[1] }, { min_[0], max_[1] }, { max_[0], max_[1] }, { max_[0], min_[1] } };
-      }
-      else if constexpr ( Dim == 3 )
-      {
-         return { { min_[0], min_[1], min_[2] },
-                  { min_[0], max_[1], min_[2] },
-                  { max_[0], max_[1], min_[2] },
-                  { max_[0], min_[1], min_[2] },
-                  { min_[0], min_[1], max_[2] },
-                  { min_[0], max_[1], max_[2] },
-                  { max_[0], max_[1], max_[2] },
-                  { max_[0], min_[1], max_[2] } };
-      }
-
-      WALBERLA_ABORT( "Invalid AABB dim." )
-   }
-
-   void serialize( SendBuffer& sendBuffer ) const
-   {
-      sendBuffer << min_;
-      sendBuffer << max_;
-      sendBuffer << largestAxis_;
-   }
-
-   void deserialize( RecvBuffer& recvBuffer )
-   {
-      recvBuffer >> min_;
-      recvBuffer >> max_;
-      recvBuffer >> largestAxis_;
-   }
-
- private:
-   void computeLargestAxis()
-   {
-      largestAxis_         = 0;
-      real_t largestExtent = max_[0] - min_[0];
-      for ( int i = 1; i < Dim; ++i )
-      {
-         real_t extent = max_[i] - min_[i];
-         if ( extent > largestExtent )
-         {
-            largestExtent = extent;
-            largestAxis_  = i;
-         }
-      }
-   }
-
-   PointND< real_t, Dim > min_; ///< Minimum coordinates of the bounding box.
-   PointND< real_t, Dim > max_; ///< Maximum coordinates of the bounding box.
-   int                    largestAxis_;
-};
-
 /// @class KDTreeNode
 /// @brief Represents a node in a KD-Tree, which is a space-partitioning data structure for organizing points in k-dimensional space.
 template < typename T, int AABBDim >
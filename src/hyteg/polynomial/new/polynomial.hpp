@@ -238,6 +238,17 @@ class Polynomial : public std::array< FLOAT, dimP( DIM, DEGREE ) >
     */
    inline FLOAT eval( const FLOAT x ) const { return _restriction.eval( x ); }
 
+   /** @brief Evaluate the 1d polynomial at the n equidistant points x_i = x0 + i*h.
+    *
+    * Usage: `p.fix_z(z);` `p.fix_y(y);` `p.eval_line(x0, h, n, values);`
+    *
+    * @see Polynomial< FLOAT, 1, DEGREE >::eval_line
+    */
+   inline void eval_line( const FLOAT x0, const FLOAT h, const uint_t n, FLOAT* const values ) const
+   {
+      _restriction.eval_line( x0, h, n, values );
+   }
+
    // evaluate polynomial by summing up basis functions, only use for debugging or testing
    FLOAT eval_naive( const PointND< FLOAT, 3 >& x ) const
    {
@@ -386,6 +397,34 @@ class Polynomial< FLOAT, 1, DEGREE > : public std::array< FLOAT, dimP( 1, DEGREE
          return px;
       }
    }
+
+   /** @brief Evaluate the 1d polynomial at the n equidistant points x_i = x0 + i*h, e.g., for all micro-elements in a row.
+    *
+    * The Horner scheme is applied to all points simultaneously, i.e., each step is a loop over the points without
+    * loop-carried dependencies, which the compiler can map to SIMD lanes. Use this instead of calling eval() once per point
+    * when the values along a whole row are required.
+    *
+    * @param x0     The first point.
+    * @param h      The distance between two consecutive points.
+    * @param n      The number of points.
+    * @param values Output, values[i] = p(x0 + i*h). Must provide space for n values.
+   */
+   inline void eval_line( const FLOAT x0, const FLOAT h, const uint_t n, FLOAT* const values ) const
+   {
+      const FLOAT c_q = ( *this )[DEGREE];
+      for ( uint_t i = 0; i < n; ++i )
+      {
+         values[i] = c_q;
+      }
+      for ( int k = DEGREE - 1; k >= 0; --k )
+      {
+         const FLOAT c_k = ( *this )[static_cast< uint_t >( k )];
+         for ( uint_t i = 0; i < n; ++i )
+         {
+            values[i] = values[i] * ( x0 + FLOAT( i ) * h ) + c_k;
+         }
+      }
+   }
 };
 
 } // namespace polynomial
@@ -0,0 +1,704 @@
+/*
+ * Copyright (c) 2026 Nils Kohl, Marcus Mohr.
+ *
+ * This file is part of HyTeG
+ * (see https://i10git.cs.fau.de/hyteg/hyteg).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <Eigen/LU>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "core/DataTypes.h"
+#include "core/mpi/Gatherv.h"
+#include "core/mpi/Reduce.h"
+
+#include "hyteg/functions/FunctionProperties.hpp"
+#include "hyteg/solvers/Solver.hpp"
+#include "hyteg/sparseassembly/CSRSparseMatrix.hpp"
+#include "hyteg/sparseassembly/LocalVectorProxy.hpp"
+#include "hyteg/types/Matrix.hpp"
+
+namespace hyteg {
+
+/// \brief Smoothed aggregation algebraic multigrid solver.
+///
+/// The operator is assembled via toMatrix() into a CSRSparseMatrix on the first call to solve(), the Dirichlet DoFs are
+/// eliminated symmetrically. From the assembled matrix, a hierarchy of coarser matrices is constructed:
+///
+///   - DoFs are grouped into aggregates of strongly connected DoFs (|a_ij| > theta * sqrt(|a_ii a_jj|)). The aggregation
+///     is performed independently on each process (decoupled aggregation), so no communication is needed here.
+///   - The tentative prolongation interpolates constants from the aggregates and is smoothed by one damped Jacobi step,
+///     P = ( I - omega D^{-1} A ) P_tent with omega = 4 / ( 3 lambda_max( D^{-1} A ) ).
+///   - The coarse matrices are computed by the Galerkin product A_c = P^T A P.
+///
+/// The coarsening stops once the global size drops below a threshold. If the coarsest matrix is small enough, it is
+/// gathered on all processes and factorized by a dense LU decomposition. Since the aggregation does not cross process
+/// boundaries, the coarsest matrix has at least one row per process, so on many processes it may exceed the size
+/// for which a dense factorization on every process is reasonable. In that case the coarsest system is solved by Jacobi
+/// preconditioned CG on the distributed matrix instead. The solver performs V-cycles with damped Jacobi smoothing until
+/// the residual tolerance or the maximum number of iterations is reached.
+///
+/// Since the constant vector is used as near null space, the solver is designed for scalar elliptic problems. It can be
+/// used as coarse grid solver of the GeometricMultigridSolver and in the AgglomerationWrapper (pass the agglomeration
+/// storage to the constructor).
+template < class OperatorType >
+class AlgebraicMultigridSolver : public Solver< OperatorType >
+{
+ public:
+   using FunctionType          = typename OperatorType::srcType;
+   using NumeratorFunctionType = typename FunctionType::template FunctionType< idx_t >;
+
+   /// \param storage            the PrimitiveStorage the operator is defined on
+   /// \param level              the refinement level on which the solver operates
+   /// \param maxIterations      maximum number of V-cycles per solve() call
+   /// \param relativeTolerance  the solver stops when the residual was reduced by this factor
+   /// \param absoluteTolerance  the solver stops when the residual drops below this value
+   AlgebraicMultigridSolver( const std::shared_ptr< PrimitiveStorage >& storage,
+                             uint_t                                     level,
+                             uint_t                                     maxIterations     = 100,
+                             real_t                                     relativeTolerance = real_c( 1e-10 ),
+                             real_t                                     absoluteTolerance = real_c( 1e-16 ) )
+   : storage_( storage )
+   , level_( level )
+   , numerator_( "numerator", storage, level, level )
+   , residual_( "amg_residual", storage, level, level )
+   , correction_( "amg_correction", storage, level, level )
+   , flag_( hyteg::Inner | hyteg::NeumannBoundary | hyteg::FreeslipBoundary )
+   , maxIterations_( maxIterations )
+   , relativeTolerance_( relativeTolerance )
+   , absoluteTolerance_( absoluteTolerance )
+   , strengthThreshold_( real_c( 0.08 ) )
+   , maxCoarseSize_( 1000 )
+   , maxNumLevels_( 20 )
+   , maxDenseCoarseSize_( 2000 )
+   , maxCoarseIterations_( 1000 )
+   , coarseRelativeTolerance_( real_c( 1e-8 ) )
+   , numSmoothingSteps_( 2 )
+   , reassembleMatrix_( false )
+   , printInfo_( false )
+   , assembled_( false )
+   , denseCoarseSolver_( false )
+   {
+      numerator_.enumerate( level );
+   }
+
+   /// \brief Threshold theta for the strength of connection, default is 0.08.
+   void setStrengthThreshold( real_t strengthThreshold ) { strengthThreshold_ = strengthThreshold; }
+
+   /// \brief The coarsening stops once the global number of DoFs is below this value, default is 1000.
+   void setMaxCoarseSize( uint_t maxCoarseSize ) { maxCoarseSize_ = maxCoarseSize; }
+
+   /// \brief Maximum number of levels of the hierarchy (including the finest), default is 20.
+   void setMaxNumLevels( uint_t maxNumLevels ) { maxNumLevels_ = maxNumLevels; }
+
+   /// \brief The coarsest matrix is only gathered and factorized densely if its global number of DoFs does not exceed this
+   ///        value, otherwise it is solved iteratively by CG. Default is 2000.
+   void setMaxDenseCoarseSize( uint_t maxDenseCoarseSize ) { maxDenseCoarseSize_ = maxDenseCoarseSize; }
+
+   /// \brief Maximum number of iterations and relative residual reduction of the iterative coarsest grid solver,
+   ///        defaults are 1000 and 1e-8.
+   void setIterativeCoarseSolverParameters( uint_t maxCoarseIterations, real_t coarseRelativeTolerance )
+   {
+      maxCoarseIterations_     = maxCoarseIterations;
+      coarseRelativeTolerance_ = coarseRelativeTolerance;
+   }
+
+   /// \brief Number of pre- and post-smoothing steps, default is 2.
+   void setSmoothingSteps( uint_t numSmoothingSteps ) { numSmoothingSteps_ = numSmoothingSteps; }
+
+   /// \brief If set to true, the operator is reassembled and the hierarchy is rebuilt for every solve call.
+   ///        Default is false.
+   void setReassembleMatrix( bool reassembleMatrix ) { reassembleMatrix_ = reassembleMatrix; }
+
+   void setPrintInfo( bool printInfo ) { printInfo_ = printInfo; }
+
+   void solve( const OperatorType& A, const FunctionType& x, const FunctionType& b, const uint_t level ) override
+   {
+      WALBERLA_CHECK_EQUAL( level, level_, "AlgebraicMultigridSolver was set up for level " << level_ );
+
+      storage_->getTimingTree()->start( "AMG" );
+
+      if ( !assembled_ || reassembleMatrix_ )
+      {
+         storage_->getTimingTree()->start( "Setup" );
+         setup( A );
+         storage_->getTimingTree()->stop( "Setup" );
+      }
+
+      storage_->getTimingTree()->start( "Solve" );
+
+      // the correction is computed from the residual, so that the solver also works with inhomogeneous Dirichlet BCs
+      A.apply( x, residual_, level, flag_, Replace );
+      residual_.assign( { real_c( 1 ), real_c( -1 ) }, { b, residual_ }, level, flag_ );
+
+      auto& fine = levels_.front();
+      std::fill( fine.b.begin(), fine.b.end(), real_c( 0 ) );
+      std::fill( fine.x.begin(), fine.x.end(), real_c( 0 ) );
+      residual_.toVector( numerator_, std::make_shared< LocalVectorProxy >( fine.b, fine.A->getRowOffset() ), level, flag_ );
+
+      const real_t initialResidual = norm( fine.b );
+      real_t       currentResidual = initialResidual;
+
+      for ( uint_t i = 0; i < maxIterations_; ++i )
+      {
+         if ( currentResidual <= absoluteTolerance_ || currentResidual <= relativeTolerance_ * initialResidual )
+         {
+            break;
+         }
+
+         vCycle( 0 );
+
+         fine.A->multiply( fine.x, fine.r );
+         for ( uint_t k = 0; k < fine.r.size(); ++k )
+         {
+            fine.r[k] = fine.b[k] - fine.r[k];
+         }
+         currentResidual = norm( fine.r );
+
+         if ( printInfo_ )
+         {
+            WALBERLA_LOG_INFO_ON_ROOT( "[AMG] iter: " << i << ", residual: " << std::scientific << currentResidual );
+         }
+      }
+
+      correction_.fromVector( numerator_, std::make_shared< LocalVectorProxy >( fine.x, fine.A->getRowOffset() ), level, flag_ );
+      x.add( { real_c( 1 ) }, { correction_ }, level, flag_ );
+
+      storage_->getTimingTree()->stop( "Solve" );
+      storage_->getTimingTree()->stop( "AMG" );
+   }
+
+   /// \brief Number of levels of the hierarchy, only available after the first solve() call.
+   uint_t getNumLevels() const { return levels_.size(); }
+
+ private:
+   struct Level
+   {
+      std::shared_ptr< CSRSparseMatrix > A;
+      /// prolongation from and restriction to the next coarser level
+      std::shared_ptr< CSRSparseMatrix > P;
+      std::shared_ptr< CSRSparseMatrix > R;
+
+      std::vector< real_t > inverseDiagonal;
+      real_t                omega;
+
+      std::vector< real_t > x;
+      std::vector< real_t > b;
+      std::vector< real_t > r;
+   };
+
+   static constexpr uint_t notAggregated = std::numeric_limits< uint_t >::max();
+
+   void setup( const OperatorType& op )
+   {
+      levels_.clear();
+
+      const uint_t localDoFs = numberOfLocalDoFs( numerator_, level_ );
+
+      Level fine;
+      // on the agglomeration storage only a subset of the processes holds primitives
+      fine.A = std::make_shared< CSRSparseMatrix >(
+          localDoFs, localDoFs, storage_->getSplitCommunicatorByPrimitiveDistribution() );
+      op.toMatrix( fine.A, numerator_, numerator_, level_, All );
+      fine.A->assemble();
+
+      FunctionType dirichletMask( "dirichletMask", storage_, level_, level_ );
+      dirichletMask.interpolate( real_c( 1 ), level_, DirichletBoundary );
+      std::vector< real_t > localMask( localDoFs, real_c( 0 ) );
+      dirichletMask.toVector(
+          numerator_, std::make_shared< LocalVectorProxy >( localMask, fine.A->getRowOffset() ), level_, All );
+      fine.A->zeroRowsColumns( localMask, real_c( 1 ) );
+
+      levels_.push_back( fine );
+
+      while ( true )
+      {
+         setupSmoother( levels_.back() );
+
+         const uint_t globalSize = levels_.back().A->getNumGlobalRows();
+         if ( globalSize <= maxCoarseSize_ || levels_.size() >= maxNumLevels_ )
+         {
+            break;
+         }
+
+         Level coarse = coarsen( levels_.back() );
+         if ( coarse.A->getNumGlobalRows() == 0 || coarse.A->getNumGlobalRows() >= globalSize )
+         {
+            levels_.back().P.reset();
+            levels_.back().R.reset();
+            break;
+         }
+         levels_.push_back( coarse );
+      }
+
+      for ( auto& level : levels_ )
+      {
+         level.x.assign( level.A->getNumLocalRows(), real_c( 0 ) );
+         level.b.assign( level.A->getNumLocalRows(), real_c( 0 ) );
+         level.r.assign( level.A->getNumLocalRows(), real_c( 0 ) );
+      }
+
+      setupCoarseSolver( levels_.back() );
+
+      if ( printInfo_ )
+      {
+         for ( uint_t l = 0; l < levels_.size(); ++l )
+         {
+            WALBERLA_LOG_INFO_ON_ROOT( "[AMG] level " << l << ": " << levels_[l].A->getNumGlobalRows() << " DoFs" );
+         }
+         WALBERLA_LOG_INFO_ON_ROOT( "[AMG] coarsest grid solver: " << ( denseCoarseSolver_ ? "dense LU" : "CG" ) );
+      }
+
+      assembled_ = true;
+   }
+
+   /// Computes the inverse diagonal and the damping factor 4 / ( 3 lambda_max( D^{-1} A ) ) with a few power iterations.
+   void setupSmoother( Level& level )
+   {
+      auto& A = *level.A;
+
+      level.inverseDiagonal = A.getDiagonal();
+      for ( auto& value : level.inverseDiagonal )
+      {
+         value = value != real_c( 0 ) ? real_c( 1 ) / value : real_c( 0 );
+      }
+
+      const uint_t          n = A.getNumLocalRows();
+      std::vector< real_t > v( n ), Av( n );
+      for ( uint_t i = 0; i < n; ++i )
+      {
+         v[i] = real_c( 1 ) + real_c( ( A.getRowOffset() + i ) % 7 ) / real_c( 7 );
+      }
+
+      real_t lambdaMax = real_c( 1 );
+      for ( uint_t iter = 0; iter < 15; ++iter )
+      {
+         const real_t vNorm = norm( v );
+         if ( vNorm == real_c( 0 ) )
+         {
+            break;
+         }
+         for ( auto& value : v )
+         {
+            value /= vNorm;
+         }
+         A.multiply( v, Av );
+         for ( uint_t i = 0; i < n; ++i )
+         {
+            v[i] = level.inverseDiagonal[i] * Av[i];
+         }
+         lambdaMax = norm( v );
+      }
+
+      level.omega = real_c( 4 ) / ( real_c( 3 ) * lambdaMax );
+   }
+
+   /// Aggregates the local DoFs and builds the smoothed prolongation, the restriction and the Galerkin coarse matrix.
+   Level coarsen( Level& fine )
+   {
+      auto&        A      = *fine.A;
+      const uint_t n      = A.getNumLocalRows();
+      const uint_t offset = A.getRowOffset();
+
+      // strong connections among the local DoFs
+      const auto                           diagonal = A.getDiagonal();
+      std::vector< std::vector< uint_t > > strongNeighbors( n );
+      A.forEachLocalEntry( [&]( uint_t row, uint_t col, real_t value ) {
+         const uint_t i = row - offset;
+         if ( col < offset || col >= offset + n || col == row )
+         {
+            return;
+         }
+         const uint_t j = col - offset;
+         if ( std::abs( value ) > strengthThreshold_ * std::sqrt( std::abs( diagonal[i] * diagonal[j] ) ) )
+         {
+            strongNeighbors[i].push_back( j );
+         }
+      } );
+
+      // isolated DoFs (e.g. eliminated Dirichlet DoFs) are not aggregated, they are handled by the smoother alone
+      std::vector< uint_t > aggregate( n, notAggregated );
+      uint_t                numAggregates = 0;
+
+      // 1. form aggregates from DoFs whose strong neighbors are not yet aggregated
+      for ( uint_t i = 0; i < n; ++i )
+      {
+         if ( aggregate[i] != notAggregated || strongNeighbors[i].empty() )
+         {
+            continue;
+         }
+         bool neighborsFree = true;
+         for ( const auto& j : strongNeighbors[i] )
+         {
+            neighborsFree = neighborsFree && aggregate[j] == notAggregated;
+         }
+         if ( neighborsFree )
+         {
+            aggregate[i] = numAggregates;
+            for ( const auto& j : strongNeighbors[i] )
+            {
+               aggregate[j] = numAggregates;
+            }
+            numAggregates++;
+         }
+      }
+
+      // 2. attach remaining DoFs to an aggregate of a strong neighbor
+      const auto firstPassAggregates = aggregate;
+      for ( uint_t i = 0; i < n; ++i )
+      {
+         if ( aggregate[i] != notAggregated )
+         {
+            continue;
+         }
+         for ( const auto& j : strongNeighbors[i] )
+         {
+            if ( firstPassAggregates[j] != notAggregated )
+            {
+               aggregate[i] = firstPassAggregates[j];
+               break;
+            }
+         }
+      }
+
+      // 3. form new aggregates from the DoFs that are still left
+      for ( uint_t i = 0; i < n; ++i )
+      {
+         if ( aggregate[i] != notAggregated || strongNeighbors[i].empty() )
+         {
+            continue;
+         }
+         aggregate[i] = numAggregates;
+         for ( const auto& j : strongNeighbors[i] )
+         {
+            if ( aggregate[j] == notAggregated )
+            {
+               aggregate[j] = numAggregates;
+            }
+         }
+         numAggregates++;
+      }
+
+      // global numbering of the aggregates, also required for the ghost columns
+      int commRank = 0;
+      WALBERLA_MPI_SECTION()
+      {
+         MPI_Comm_rank( A.getCommunicator(), &commRank );
+      }
+
+      const auto aggregatesPerRank = walberla::mpi::allGather( numAggregates, A.getCommunicator() );
+      uint_t     aggregateOffset   = 0;
+      for ( uint_t rank = 0; rank < uint_c( commRank ); ++rank )
+      {
+         aggregateOffset += aggregatesPerRank[rank];
+      }
+
+      std::vector< real_t > globalAggregate( n );
+      for ( uint_t i = 0; i < n; ++i )
+      {
+         globalAggregate[i] = aggregate[i] == notAggregated ? real_c( -1 ) : real_c( aggregateOffset + aggregate[i] );
+      }
+      std::vector< real_t > columnAggregate;
+      A.gatherColumnValues( globalAggregate, columnAggregate );
+
+      // smoothed prolongation P = ( I - omega D^{-1} A ) P_tent and restriction R = P^T
+      fine.P = std::make_shared< CSRSparseMatrix >( n, numAggregates, A.getCommunicator() );
+      fine.R = std::make_shared< CSRSparseMatrix >( numAggregates, n, A.getCommunicator() );
+
+      std::map< uint_t, real_t > prolongationRow;
+      uint_t                     currentRow = offset;
+
+      const auto insertRow = [&]( uint_t row ) {
+         for ( const auto& [col, value] : prolongationRow )
+         {
+            fine.P->addValue( row, col, value );
+            fine.R->addValue( col, row, value );
+         }
+         prolongationRow.clear();
+      };
+
+      A.forEachLocalEntry( [&]( uint_t row, uint_t col, real_t value ) {
+         if ( row != currentRow )
+         {
+            insertRow( currentRow );
+            currentRow = row;
+         }
+         const real_t colAggregate = columnAggregate[A.getLocalColumnIndex( col )];
+         if ( colAggregate >= real_c( 0 ) )
+         {
+            prolongationRow[uint_c( colAggregate )] -= fine.omega * fine.inverseDiagonal[row - offset] * value;
+         }
+      } );
+      insertRow( currentRow );
+
+      for ( uint_t i = 0; i < n; ++i )
+      {
+         if ( aggregate[i] != notAggregated )
+         {
+            fine.P->addValue( offset + i, aggregateOffset + aggregate[i], real_c( 1 ) );
+            fine.R->addValue( aggregateOffset + aggregate[i], offset + i, real_c( 1 ) );
+         }
+      }
+
+      fine.P->assemble();
+      fine.R->assemble();
+
+      // Galerkin product A_c = P^T A P, the rows of P that belong to ghost columns of A are fetched from their owners
+      std::vector< uint_t > localRows( n );
+      for ( uint_t i = 0; i < n; ++i )
+      {
+         localRows[i] = offset + i;
+      }
+      const auto rowsOfA = A.getRows( localRows );
+
+      std::vector< uint_t > requiredRows;
+      for ( const auto& [row, entries] : rowsOfA )
+      {
+         for ( const auto& entry : entries )
+         {
+            requiredRows.push_back( entry.first );
+         }
+      }
+      std::sort( requiredRows.begin(), requiredRows.end() );
+      requiredRows.erase( std::unique( requiredRows.begin(), requiredRows.end() ), requiredRows.end() );
+      const auto rowsOfP = fine.P->getRows( requiredRows );
+
+      Level coarse;
+      coarse.A = std::make_shared< CSRSparseMatrix >( numAggregates, numAggregates, A.getCommunicator() );
+
+      std::map< uint_t, real_t > rowOfAP;
+      for ( const auto& [row, entries] : rowsOfA )
+      {
+         rowOfAP.clear();
+         for ( const auto& [col, value] : entries )
+         {
+            for ( const auto& [coarseCol, prolongationValue] : rowsOfP.at( col ) )
+            {
+               rowOfAP[coarseCol] += value * prolongationValue;
+            }
+         }
+         for ( const auto& [coarseRow, prolongationValue] : rowsOfP.at( row ) )
+         {
+            for ( const auto& [coarseCol, value] : rowOfAP )
+            {
+               coarse.A->addValue( coarseRow, coarseCol, prolongationValue * value );
+            }
+         }
+      }
+      coarse.A->assemble();
+
+      return coarse;
+   }
+
+   /// Gathers the coarsest matrix on all processes and computes its LU decomposition, if it is small enough.
+   void setupCoarseSolver( Level& coarsest )
+   {
+      denseCoarseSolver_ = coarsest.A->getNumGlobalRows() <= maxDenseCoarseSize_;
+      if ( !denseCoarseSolver_ )
+      {
+         coarseLU_ = Eigen::PartialPivLU< MatrixXr >();
+         return;
+      }
+
+      std::vector< uint_t > rows;
+      std::vector< uint_t > cols;
+      std::vector< real_t > values;
+      coarsest.A->forEachLocalEntry( [&]( uint_t row, uint_t col, real_t value ) {
+         rows.push_back( row );
+         cols.push_back( col );
+         values.push_back( value );
+      } );
+
+      const auto& comm = coarsest.A->getCommunicator();
+      rows             = walberla::mpi::allGatherv( rows, comm );
+      cols             = walberla::mpi::allGatherv( cols, comm );
+      values           = walberla::mpi::allGatherv( values, comm );
+
+      const auto size = static_cast< Eigen::Index >( coarsest.A->getNumGlobalRows() );
+      MatrixXr   dense = MatrixXr::Zero( size, size );
+      for ( uint_t k = 0; k < values.size(); ++k )
+      {
+         dense( static_cast< Eigen::Index >( rows[k] ), static_cast< Eigen::Index >( cols[k] ) ) += values[k];
+      }
+      coarseLU_.compute( dense );
+   }
+
+   void vCycle( uint_t l )
+   {
+      auto& level = levels_[l];
+
+      if ( l + 1 == levels_.size() && !denseCoarseSolver_ )
+      {
+         solveCoarsestIteratively( level );
+         return;
+      }
+
+      if ( l + 1 == levels_.size() )
+      {
+         const auto& comm   = level.A->getCommunicator();
+         const auto  b      = walberla::mpi::allGatherv( level.b, comm );
+         const auto  bEigen = Eigen::Map< const VectorXr >( b.data(), static_cast< Eigen::Index >( b.size() ) );
+         const VectorXr x   = coarseLU_.solve( bEigen );
+         for ( uint_t i = 0; i < level.x.size(); ++i )
+         {
+            level.x[i] = x( static_cast< Eigen::Index >( level.A->getRowOffset() + i ) );
+         }
+         return;
+      }
+
+      for ( uint_t s = 0; s < numSmoothingSteps_; ++s )
+      {
+         smoothJacobi( level );
+      }
+
+      level.A->multiply( level.x, level.r );
+      for ( uint_t i = 0; i < level.r.size(); ++i )
+      {
+         level.r[i] = level.b[i] - level.r[i];
+      }
+
+      auto& coarse = levels_[l + 1];
+      level.R->multiply( level.r, coarse.b );
+      std::fill( coarse.x.begin(), coarse.x.end(), real_c( 0 ) );
+
+      vCycle( l + 1 );
+
+      level.P->multiply( coarse.x, level.r );
+      for ( uint_t i = 0; i < level.x.size(); ++i )
+      {
+         level.x[i] += level.r[i];
+      }
+
+      for ( uint_t s = 0; s < numSmoothingSteps_; ++s )
+      {
+         smoothJacobi( level );
+      }
+   }
+
+   /// Jacobi preconditioned CG on the distributed coarsest matrix, starting from zero.
+   void solveCoarsestIteratively( Level& level )
+   {
+      const uint_t n = level.x.size();
+
+      std::fill( level.x.begin(), level.x.end(), real_c( 0 ) );
+      level.r = level.b;
+
+      std::vector< real_t > z( n ), p( n ), Ap( n );
+      for ( uint_t i = 0; i < n; ++i )
+      {
+         z[i] = level.inverseDiagonal[i] * level.r[i];
+      }
+      p         = z;
+      real_t rz = dot( level.r, z );
+
+      const real_t initialResidual = norm( level.r );
+      if ( initialResidual == real_c( 0 ) )
+      {
+         return;
+      }
+
+      for ( uint_t iter = 0; iter < maxCoarseIterations_; ++iter )
+      {
+         level.A->multiply( p, Ap );
+         const real_t pAp = dot( p, Ap );
+         if ( pAp <= real_c( 0 ) )
+         {
+            break;
+         }
+
+         const real_t alpha = rz / pAp;
+         for ( uint_t i = 0; i < n; ++i )
+         {
+            level.x[i] += alpha * p[i];
+            level.r[i] -= alpha * Ap[i];
+         }
+
+         if ( norm( level.r ) <= coarseRelativeTolerance_ * initialResidual )
+         {
+            break;
+         }
+
+         for ( uint_t i = 0; i < n; ++i )
+         {
+            z[i] = level.inverseDiagonal[i] * level.r[i];
+         }
+         const real_t rzNew = dot( level.r, z );
+         const real_t beta  = rzNew / rz;
+         rz                 = rzNew;
+         for ( uint_t i = 0; i < n; ++i )
+         {
+            p[i] = z[i] + beta * p[i];
+         }
+      }
+   }
+
+   void smoothJacobi( Level& level )
+   {
+      level.A->multiply( level.x, level.r );
+      for ( uint_t i = 0; i < level.x.size(); ++i )
+      {
+         level.x[i] += level.omega * level.inverseDiagonal[i] * ( level.b[i] - level.r[i] );
+      }
+   }
+
+   real_t dot( const std::vector< real_t >& a, const std::vector< real_t >& b ) const
+   {
+      real_t sum = real_c( 0 );
+      for ( uint_t i = 0; i < a.size(); ++i )
+      {
+         sum += a[i] * b[i];
+      }
+      walberla::mpi::allReduceInplace( sum, walberla::mpi::SUM, levels_.front().A->getCommunicator() );
+      return sum;
+   }
+
+   real_t norm( const std::vector< real_t >& v ) const { return std::sqrt( dot( v, v ) ); }
+
+   std::shared_ptr< PrimitiveStorage > storage_;
+   uint_t                              level_;
+
+   NumeratorFunctionType numerator_;
+   FunctionType          residual_;
+   FunctionType          correction_;
+   DoFType               flag_;
+
+   uint_t maxIterations_;
+   real_t relativeTolerance_;
+   real_t absoluteTolerance_;
+   real_t strengthThreshold_;
+   uint_t maxCoarseSize_;
+   uint_t maxNumLevels_;
+   uint_t maxDenseCoarseSize_;
+   uint_t maxCoarseIterations_;
+   real_t coarseRelativeTolerance_;
+   uint_t numSmoothingSteps_;
+   bool   reassembleMatrix_;
+   bool   printInfo_;
+   bool   assembled_;
+   bool   denseCoarseSolver_;
+
+   std::vector< Level >           levels_;
+   Eigen::PartialPivLU< MatrixXr > coarseLU_;
+};
+
+} // namespace hyteg
@@ -19,6 +19,7 @@
 */
 #pragma once
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 
@@ -30,6 +31,7 @@
 #include "hyteg/primitivestorage/PrimitiveStorage.hpp"
 #include "hyteg/solvers/Solver.hpp"
 #include "hyteg/solvers/preconditioners/IdentityPreconditioner.hpp"
+#include "hyteg/types/Concepts.hpp"
 
 #include "../eigen/Eigen/Eigen"
 
@@ -44,6 +46,9 @@ using walberla::uint_t;
 /// SIAM Journal on Scientific Computing, Vol. 14, No. 2, p. 461-469, 1993
 /// https://doi.org/10.1137/0914028
 ///
+/// The Arnoldi vectors are orthogonalized with classical Gram-Schmidt (applied twice for doubleOrthoTOL == 0). For
+/// functions that provide dotGlobalBatch() each pass needs a single global reduction, independent of the Krylov dimension.
+///
 /// \param maxKrylowDim Maximum number of iterations, i.e. maximum krylov dimension
 /// \param restartLength Restart the algorithm after restartLength steps. Restarting means, that we discard all data from previous steps (especially the saved functions) and start from the previous approximate solution as an initial guess.
 /// \param arnoldiTOL The loop constructing an orthogonal basis for the preconditioned Krylov space is called "Arnoldi loop" or "Arnoldi process". If the 2-norm of a newly formed basis vector (before normalisation) is smaller than the arnoldi tolerance, the algorithm terminates.
@@ -217,11 +222,10 @@ class FGMRESSolver : public Solver< OperatorType >
          H_.block( 0, currentIndex - 1, currentIndex + 1, 1 ) = MatrixXr::Zero( currentIndex + 1, 1 );
 
          // (b), 3
+         const std::vector< real_t > h = classicalGramSchmidt( currentIndex, level );
          for ( uint_t i = 1; i <= currentIndex; i++ )
          {
-            real_t h                      = vecV_[currentIndex].dotGlobal( vecV_[i - 1], level, flag_ );
-            H_( i - 1, currentIndex - 1 ) = h;
-            vecV_[currentIndex].add( { -h }, { vecV_[i - 1] }, level, flag_ );
+            H_( i - 1, currentIndex - 1 ) = h[i - 1];
          }
 
          // check if double orthogonalisation should be used
@@ -239,11 +243,10 @@ class FGMRESSolver : public Solver< OperatorType >
             {
                WALBERLA_LOG_INFO_ON_ROOT( "[" << name_ << "] invoked double-orthogonalization at iteration " << j );
             }
+            const std::vector< real_t > hCorrection = classicalGramSchmidt( currentIndex, level );
             for ( uint_t i = 1; i <= ( currentIndex ); i++ )
             {
-               real_t h = vecV_[currentIndex].dotGlobal( vecV_[i - 1], level, flag_ );
-               H_( i - 1, currentIndex - 1 ) += h;
-               vecV_[currentIndex].add( { -h }, { vecV_[i - 1] }, level, flag_ );
+               H_( i - 1, currentIndex - 1 ) += hCorrection[i - 1];
             }
          }
 
@@ -330,6 +333,46 @@ class FGMRESSolver : public Solver< OperatorType >
    }
 
  private:
+   /// Classical Gram-Schmidt step: orthogonalizes vecV_[currentIndex] against vecV_[0], ..., vecV_[currentIndex - 1]
+   /// and returns the projection coefficients. All coefficients are computed with a single global reduction if the
+   /// function type supports batched dot products, so the number of synchronizations per Arnoldi step does not
+   /// grow with the Krylov dimension.
+   std::vector< real_t > classicalGramSchmidt( uint_t currentIndex, uint_t level ) const
+   {
+      const FunctionType&                                         w = vecV_[currentIndex];
+      std::vector< std::reference_wrapper< const FunctionType > > basis( vecV_.begin(), vecV_.begin() + currentIndex );
+
+      std::vector< real_t > h;
+      if constexpr ( concepts::batched_dot< FunctionType > )
+      {
+         const auto dots = w.dotGlobalBatch( basis, level, flag_ );
+         h.assign( dots.begin(), dots.end() );
+      }
+      else
+      {
+         for ( const FunctionType& v : basis )
+         {
+            h.push_back( w.dotGlobal( v, level, flag_ ) );
+         }
+      }
+
+      std::vector< real_t > minusH( h.size() );
+      std::transform( h.begin(), h.end(), minusH.begin(), []( real_t value ) { return -value; } );
+      if constexpr ( requires { w.add( minusH, basis, level, flag_ ); } )
+      {
+         w.add( minusH, basis, level, flag_ );
+      }
+      else
+      {
+         for ( uint_t i = 0; i < basis.size(); i++ )
+         {
+            w.add( { minusH[i] }, { basis[i].get() }, level, flag_ );
+         }
+      }
+
+      return h;
+   }
+
    void init( const OperatorType&                    A,
               const FunctionType&                    x,
               const FunctionType&                    b,
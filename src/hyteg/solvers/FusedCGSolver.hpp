@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2026 Nils Kohl, Marcus Mohr.
+ *
+ * This file is part of HyTeG
+ * (see https://i10git.cs.fau.de/hyteg/hyteg).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "core/Abort.h"
+#include "core/timing/TimingTree.h"
+
+#include "hyteg/functions/FunctionTools.hpp"
+#include "hyteg/primitivestorage/PrimitiveStorage.hpp"
+#include "hyteg/solvers/Solver.hpp"
+#include "hyteg/solvers/preconditioners/IdentityPreconditioner.hpp"
+
+namespace hyteg {
+
+using walberla::uint_t;
+
+namespace concepts {
+
+/// Concept matching functions that provide the fused update addAndDotGlobal() (e.g. P1Function, P2Function).
+template < typename FunctionType >
+concept fused_add_and_dot = requires( const FunctionType& f, typename FunctionType::valueType s, uint_t level, DoFType flag ) {
+   { f.addAndDotGlobal( s, f, level, flag ) } -> std::convertible_to< typename FunctionType::valueType >;
+};
+
+} // namespace concepts
+
+/// \brief Preconditioned conjugate gradient method with fused vector updates.
+///
+/// Mathematically equivalent to CGSolver, but the residual update and the computation of its norm are done in a single
+/// sweep over the memory via FunctionType::addAndDotGlobal(). If no preconditioner (i.e. the IdentityPreconditioner)
+/// is used, the preconditioned residual z = r is not stored at all and r^T z equals the already computed r^T r.
+///
+/// Per iteration this saves one (unpreconditioned: four) full traversals of the function memory and one (two) global
+/// reductions compared to CGSolver.
+template < class OperatorType >
+   requires concepts::fused_add_and_dot< typename OperatorType::srcType >
+class FusedCGSolver : public Solver< OperatorType >
+{
+ public:
+   using FunctionType = typename OperatorType::srcType;
+   using ValueType    = typename FunctionTrait< FunctionType >::ValueType;
+
+   FusedCGSolver(
+       const std::shared_ptr< PrimitiveStorage >& storage,
+       uint_t                                     minLevel,
+       uint_t                                     maxLevel,
+       uint_t                                     maxIter           = std::numeric_limits< uint_t >::max(),
+       ValueType                                  relativeTolerance = 1e-16,
+       ValueType                                  absoluteTolerance = 1e-16,
+       std::shared_ptr< Solver< OperatorType > >  preconditioner = std::make_shared< IdentityPreconditioner< OperatorType > >() )
+   : p_( "p", storage, minLevel, maxLevel )
+   , ap_( "ap", storage, minLevel, maxLevel )
+   , r_( "r", storage, minLevel, maxLevel )
+   , preconditioner_( preconditioner )
+   , isPreconditioned_( std::dynamic_pointer_cast< IdentityPreconditioner< OperatorType > >( preconditioner ) == nullptr )
+   , flag_( hyteg::Inner | hyteg::NeumannBoundary | hyteg::FreeslipBoundary )
+   , printInfo_( false )
+   , absoluteTolerance_( absoluteTolerance )
+   , relativeTolerance_( relativeTolerance )
+   , maxIter_( maxIter )
+   , iterations_( maxIter_ )
+   , name_( "FusedCG" )
+   , timingTree_( storage->getTimingTree() )
+   {
+      if ( !std::is_same< FunctionType, typename OperatorType::dstType >::value )
+      {
+         WALBERLA_ABORT( "FusedCGSolver does not work for Operator with different src and dst FunctionTypes" );
+      }
+
+      if ( isPreconditioned_ )
+      {
+         z_ = std::make_shared< FunctionType >( "z", storage, minLevel, maxLevel );
+      }
+   }
+
+   void solve( const OperatorType& A, const FunctionType& x, const FunctionType& b, const uint_t level ) override
+   {
+      if ( maxIter_ == 0 )
+         return;
+
+      timingTree_->start( "Fused CG Solver" );
+
+      copyBCs( x, p_ );
+      copyBCs( x, ap_ );
+      copyBCs( x, r_ );
+
+      p_.setToZero( level );
+      ap_.setToZero( level );
+      r_.setToZero( level );
+
+      // the preconditioned residual z aliases r if there is no preconditioner
+      const FunctionType& z = isPreconditioned_ ? *z_ : r_;
+      if ( isPreconditioned_ )
+      {
+         copyBCs( x, *z_ );
+         z_->setToZero( level );
+      }
+
+      // r = b - A x
+      A.apply( x, ap_, level, flag_, Replace );
+      r_.assign( { ValueType( 1 ), ValueType( -1 ) }, { b, ap_ }, level, flag_ );
+
+      ValueType rr = r_.dotGlobal( r_, level, flag_ );
+      ValueType rz = precondition( A, z, rr, level );
+      p_.assign( { ValueType( 1 ) }, { z }, level, flag_ );
+
+      const ValueType resStart = std::sqrt( rr );
+      if ( resStart < absoluteTolerance_ )
+      {
+         if ( printInfo_ )
+         {
+            WALBERLA_LOG_INFO_ON_ROOT( "[" << name_ << "] converged" );
+         }
+         timingTree_->stop( "Fused CG Solver" );
+         return;
+      }
+
+      for ( uint_t i = 0; i < maxIter_; ++i )
+      {
+         A.apply( p_, ap_, level, flag_, Replace );
+         const ValueType pAp   = p_.dotGlobal( ap_, level, flag_ );
+         const ValueType alpha = rz / pAp;
+
+         x.add( { alpha }, { p_ }, level, flag_ );
+         rr = r_.addAndDotGlobal( -alpha, ap_, level, flag_ );
+
+         const ValueType res    = std::sqrt( rr );
+         const ValueType relRes = res / resStart;
+
+         if ( printInfo_ )
+         {
+            WALBERLA_LOG_INFO_ON_ROOT( "[" << name_ << "] iter: " << i << ", residual: " << res
+                                           << " ; relative residual: " << relRes );
+         }
+
+         if ( relRes < relativeTolerance_ || res < absoluteTolerance_ )
+         {
+            iterations_ = i;
+            if ( printInfo_ )
+            {
+               WALBERLA_LOG_INFO_ON_ROOT( "[" << name_ << "] converged after " << i << " iterations" );
+            }
+            break;
+         }
+
+         const ValueType rzNew = precondition( A, z, rr, level );
+         const ValueType beta  = rzNew / rz;
+         rz                    = rzNew;
+
+         p_.assign( { ValueType( 1 ), beta }, { z, p_ }, level, flag_ );
+      }
+
+      timingTree_->stop( "Fused CG Solver" );
+   }
+
+   uint_t getIterations() const { return iterations_; }
+
+   void setPrintInfo( bool printInfo ) { printInfo_ = printInfo; }
+   void setName( std::string newName ) { name_ = newName; }
+   void setDoFType( hyteg::DoFType flag ) { flag_ = flag; }
+
+ private:
+   /// Applies the preconditioner to the current residual and returns r^T z.
+   /// Without preconditioner z is r itself and r^T r is passed in.
+   ValueType precondition( const OperatorType& A, const FunctionType& z, const ValueType& rr, const uint_t level ) const
+   {
+      if ( !isPreconditioned_ )
+      {
+         return rr;
+      }
+      z.interpolate( ValueType( 0 ), level, All );
+      preconditioner_->solve( A, z, r_, level );
+      return r_.dotGlobal( z, level, flag_ );
+   }
+
+   FunctionType                    p_;
+   FunctionType                    ap_;
+   FunctionType                    r_;
+   std::shared_ptr< FunctionType > z_;
+
+   std::shared_ptr< Solver< OperatorType > > preconditioner_;
+   bool                                      isPreconditioned_;
+
+   hyteg::DoFType flag_;
+   bool           printInfo_;
+   ValueType      absoluteTolerance_;
+   ValueType      relativeTolerance_;
+   uint_t         maxIter_;
+   uint_t         iterations_;
+
+   std::string name_;
+
+   std::shared_ptr< walberla::WcTimingTree > timingTree_;
+};
+
+} // namespace hyteg
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2026 Nils Kohl, Marcus Mohr.
+ *
+ * This file is part of HyTeG
+ * (see https://i10git.cs.fau.de/hyteg/hyteg).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "core/timing/TimingTree.h"
+
+#include "hyteg/functions/FunctionTools.hpp"
+#include "hyteg/primitivestorage/PrimitiveStorage.hpp"
+#include "hyteg/solvers/Solver.hpp"
+
+namespace hyteg {
+
+using walberla::uint_t;
+
+/// \brief Iterative refinement with an inner solver that works in a different (typically lower) precision.
+///
+/// In each iteration the residual r = b - A x is computed in the precision of OperatorType (e.g. double). It is
+/// converted to the function type of InnerOperatorType (e.g. P1Function< float >), the correction equation
+///
+///   A_inner e = r
+///
+/// is solved approximately by the inner solver (e.g. a few multigrid V-cycles in single precision) and the
+/// converted correction is added to x. As long as the inner solver reduces the error by a fixed factor, the outer
+/// iteration converges to the accuracy of the outer precision, while most of the memory traffic happens in the
+/// inner precision.
+///
+/// The function types must support conversion via copyFrom() (e.g. P1Function and P2Function).
+///
+/// \code
+///   auto gmgSP = std::make_shared< GeometricMultigridSolver< P1ConstantLaplaceOperatorSP > >( ... );
+///   MixedPrecisionIterativeRefinementSolver< P1ConstantLaplaceOperatorDP, P1ConstantLaplaceOperatorSP > solver(
+///       storage, minLevel, maxLevel, ASP, gmgSP, 20, 1e-12 );
+///   solver.solve( ADP, u, f, maxLevel );
+/// \endcode
+template < class OperatorType, class InnerOperatorType >
+class MixedPrecisionIterativeRefinementSolver : public Solver< OperatorType >
+{
+ public:
+   using FunctionType      = typename OperatorType::srcType;
+   using ValueType         = typename FunctionTrait< FunctionType >::ValueType;
+   using InnerFunctionType = typename InnerOperatorType::srcType;
+
+   MixedPrecisionIterativeRefinementSolver( const std::shared_ptr< PrimitiveStorage >&     storage,
+                                            uint_t                                         minLevel,
+                                            uint_t                                         maxLevel,
+                                            std::shared_ptr< InnerOperatorType >           innerOperator,
+                                            std::shared_ptr< Solver< InnerOperatorType > > innerSolver,
+                                            uint_t    maxIter           = std::numeric_limits< uint_t >::max(),
+                                            ValueType relativeTolerance = 1e-16,
+                                            ValueType absoluteTolerance = 1e-16 )
+   : r_( "ir_r", storage, minLevel, maxLevel )
+   , e_( "ir_e", storage, minLevel, maxLevel )
+   , rInner_( "ir_r_inner", storage, minLevel, maxLevel )
+   , eInner_( "ir_e_inner", storage, minLevel, maxLevel )
+   , innerOperator_( innerOperator )
+   , innerSolver_( innerSolver )
+   , flag_( hyteg::Inner | hyteg::NeumannBoundary | hyteg::FreeslipBoundary )
+   , printInfo_( false )
+   , absoluteTolerance_( absoluteTolerance )
+   , relativeTolerance_( relativeTolerance )
+   , maxIter_( maxIter )
+   , iterations_( maxIter_ )
+   , name_( "MixedPrecisionIR" )
+   , timingTree_( storage->getTimingTree() )
+   {}
+
+   void solve( const OperatorType& A, const FunctionType& x, const FunctionType& b, const uint_t level ) override
+   {
+      timingTree_->start( "Mixed Precision Iterative Refinement Solver" );
+
+      copyBCs( x, r_ );
+      copyBCs( x, e_ );
+      copyBCs( x, rInner_ );
+      copyBCs( x, eInner_ );
+
+      r_.setToZero( level );
+
+      ValueType resStart = 0;
+
+      iterations_ = maxIter_;
+      for ( uint_t i = 0; i <= maxIter_; ++i )
+      {
+         // residual in outer precision (e is used as temporary)
+         A.apply( x, e_, level, flag_, Replace );
+         r_.assign( { ValueType( 1 ), ValueType( -1 ) }, { b, e_ }, level, flag_ );
+
+         const ValueType res = std::sqrt( r_.dotGlobal( r_, level, flag_ ) );
+         if ( i == 0 )
+         {
+            resStart = res;
+         }
+         const ValueType relRes = resStart > 0 ? res / resStart : ValueType( 0 );
+
+         if ( printInfo_ )
+         {
+            WALBERLA_LOG_INFO_ON_ROOT( "[" << name_ << "] iter: " << i << ", residual: " << res
+                                           << " ; relative residual: " << relRes );
+         }
+
+         if ( res < absoluteTolerance_ || relRes < relativeTolerance_ )
+         {
+            iterations_ = i;
+            if ( printInfo_ )
+            {
+               WALBERLA_LOG_INFO_ON_ROOT( "[" << name_ << "] converged after " << i << " iterations" );
+            }
+            break;
+         }
+
+         if ( i == maxIter_ )
+         {
+            break;
+         }
+
+         // correction in inner precision, the correction vanishes on the Dirichlet boundary
+         timingTree_->start( "Conversion" );
+         rInner_.copyFrom( r_, level );
+         eInner_.setToZero( level );
+         timingTree_->stop( "Conversion" );
+
+         timingTree_->start( "Inner solver" );
+         innerSolver_->solve( *innerOperator_, eInner_, rInner_, level );
+         timingTree_->stop( "Inner solver" );
+
+         timingTree_->start( "Conversion" );
+         e_.copyFrom( eInner_, level );
+         timingTree_->stop( "Conversion" );
+
+         x.add( { ValueType( 1 ) }, { e_ }, level, flag_ );
+      }
+
+      timingTree_->stop( "Mixed Precision Iterative Refinement Solver" );
+   }
+
+   /// Returns the number of corrections that have been applied in the last call to solve().
+   uint_t getIterations() const { return iterations_; }
+
+   void setPrintInfo( bool printInfo ) { printInfo_ = printInfo; }
+   void setName( std::string newName ) { name_ = newName; }
+   void setDoFType( hyteg::DoFType flag ) { flag_ = flag; }
+
+ private:
+   FunctionType      r_;
+   FunctionType      e_;
+   InnerFunctionType rInner_;
+   InnerFunctionType eInner_;
+
+   std::shared_ptr< InnerOperatorType >           innerOperator_;
+   std::shared_ptr< Solver< InnerOperatorType > > innerSolver_;
+
+   hyteg::DoFType flag_;
+   bool           printInfo_;
+   ValueType      absoluteTolerance_;
+   ValueType      relativeTolerance_;
+   uint_t         maxIter_;
+   uint_t         iterations_;
+
+   std::string name_;
+
+   std::shared_ptr< walberla::WcTimingTree > timingTree_;
+};
+
+} // namespace hyteg
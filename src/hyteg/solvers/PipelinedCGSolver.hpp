@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2026 Nils Kohl, Marcus Mohr.
+ *
+ * This file is part of HyTeG
+ * (see https://i10git.cs.fau.de/hyteg/hyteg).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "core/Abort.h"
+#include "core/timing/TimingTree.h"
+
+#include "hyteg/communication/NonBlockingAllReduce.hpp"
+#include "hyteg/functions/FunctionTools.hpp"
+#include "hyteg/primitivestorage/PrimitiveStorage.hpp"
+#include "hyteg/solvers/Solver.hpp"
+#include "hyteg/solvers/preconditioners/IdentityPreconditioner.hpp"
+
+namespace hyteg {
+
+using walberla::uint_t;
+
+/// \brief Pipelined preconditioned conjugate gradient method (Ghysels and Vanroose, 2014).
+///
+/// Mathematically equivalent to CGSolver, but all inner products of an iteration are summed up globally with a single,
+/// non-blocking reduction. The reduction is overlapped with the application of the preconditioner and the operator
+/// for the next iteration. This removes the global synchronization points from the critical path, which dominate
+/// on large process counts if the local work per process is small (e.g. on coarse grids).
+///
+/// The price are five additional vectors and four additional vector updates per iteration compared to CGSolver.
+/// Also, the recursively updated residual may deviate from the true residual slightly earlier in finite precision,
+/// so very tight tolerances may not be reached.
+///
+/// The residual norm that is checked in iteration i is the one of the approximation after i updates, i.e. the solver
+/// detects convergence one operator application later than CGSolver.
+template < class OperatorType >
+class PipelinedCGSolver : public Solver< OperatorType >
+{
+ public:
+   using FunctionType = typename OperatorType::srcType;
+   using ValueType    = typename FunctionTrait< FunctionType >::ValueType;
+
+   PipelinedCGSolver(
+       const std::shared_ptr< PrimitiveStorage >& storage,
+       uint_t                                     minLevel,
+       uint_t                                     maxLevel,
+       uint_t                                     maxIter           = std::numeric_limits< uint_t >::max(),
+       ValueType                                  relativeTolerance = 1e-16,
+       ValueType                                  absoluteTolerance = 1e-16,
+       std::shared_ptr< Solver< OperatorType > >  preconditioner = std::make_shared< IdentityPreconditioner< OperatorType > >() )
+   : r_( "pcg_r", storage, minLevel, maxLevel )
+   , u_( "pcg_u", storage, minLevel, maxLevel )
+   , w_( "pcg_w", storage, minLevel, maxLevel )
+   , m_( "pcg_m", storage, minLevel, maxLevel )
+   , n_( "pcg_n", storage, minLevel, maxLevel )
+   , z_( "pcg_z", storage, minLevel, maxLevel )
+   , q_( "pcg_q", storage, minLevel, maxLevel )
+   , s_( "pcg_s", storage, minLevel, maxLevel )
+   , p_( "pcg_p", storage, minLevel, maxLevel )
+   , preconditioner_( preconditioner )
+   , flag_( hyteg::Inner | hyteg::NeumannBoundary | hyteg::FreeslipBoundary )
+   , printInfo_( false )
+   , absoluteTolerance_( absoluteTolerance )
+   , relativeTolerance_( relativeTolerance )
+   , maxIter_( maxIter )
+   , iterations_( maxIter_ )
+   , name_( "PipelinedCG" )
+   , timingTree_( storage->getTimingTree() )
+   {
+      if ( !std::is_same< FunctionType, typename OperatorType::dstType >::value )
+      {
+         WALBERLA_ABORT( "PipelinedCGSolver does not work for Operator with different src and dst FunctionTypes" );
+      }
+   }
+
+   void solve( const OperatorType& A, const FunctionType& x, const FunctionType& b, const uint_t level ) override
+   {
+      if ( maxIter_ == 0 )
+         return;
+
+      timingTree_->start( "Pipelined CG Solver" );
+
+      for ( auto f : { &r_, &u_, &w_, &m_, &n_, &z_, &q_, &s_, &p_ } )
+      {
+         copyBCs( x, *f );
+         f->setToZero( level );
+      }
+
+      // r = b - A x, u = M r, w = A u
+      A.apply( x, w_, level, flag_, Replace );
+      r_.assign( { ValueType( 1 ), ValueType( -1 ) }, { b, w_ }, level, flag_ );
+      preconditioner_->solve( A, u_, r_, level );
+      A.apply( u_, w_, level, flag_, Replace );
+
+      // [ r^T u, w^T u, r^T r ]
+      communication::NonBlockingAllReduce< ValueType > reduction( 3 );
+
+      ValueType resStart = 0;
+      ValueType gammaOld = 0;
+      ValueType alphaOld = 0;
+
+      iterations_ = maxIter_;
+      for ( uint_t i = 0; i < maxIter_; ++i )
+      {
+         reduction[0] = r_.dotLocal( u_, level, flag_ );
+         reduction[1] = w_.dotLocal( u_, level, flag_ );
+         reduction[2] = r_.dotLocal( r_, level, flag_ );
+         reduction.start();
+
+         // overlapped with the reduction: m = M w, n = A m
+         m_.interpolate( ValueType( 0 ), level, All );
+         preconditioner_->solve( A, m_, w_, level );
+         A.apply( m_, n_, level, flag_, Replace );
+
+         reduction.wait();
+         const ValueType gamma = reduction[0];
+         const ValueType delta = reduction[1];
+         const ValueType res   = std::sqrt( reduction[2] );
+
+         if ( i == 0 )
+         {
+            resStart = res;
+         }
+         const ValueType relRes = res / resStart;
+
+         if ( printInfo_ )
+         {
+            WALBERLA_LOG_INFO_ON_ROOT( "[" << name_ << "] iter: " << i << ", residual: " << res
+                                           << " ; relative residual: " << relRes );
+         }
+
+         if ( res < absoluteTolerance_ || relRes < relativeTolerance_ )
+         {
+            iterations_ = i;
+            if ( printInfo_ )
+            {
+               WALBERLA_LOG_INFO_ON_ROOT( "[" << name_ << "] converged after " << i << " iterations" );
+            }
+            break;
+         }
+
+         ValueType alpha = gamma / delta;
+         ValueType beta  = 0;
+         if ( i > 0 )
+         {
+            beta  = gamma / gammaOld;
+            alpha = gamma / ( delta - beta * gamma / alphaOld );
+         }
+
+         z_.assign( { ValueType( 1 ), beta }, { n_, z_ }, level, flag_ );
+         q_.assign( { ValueType( 1 ), beta }, { m_, q_ }, level, flag_ );
+         s_.assign( { ValueType( 1 ), beta }, { w_, s_ }, level, flag_ );
+         p_.assign( { ValueType( 1 ), beta }, { u_, p_ }, level, flag_ );
+
+         x.add( { alpha }, { p_ }, level, flag_ );
+         r_.add( { -alpha }, { s_ }, level, flag_ );
+         u_.add( { -alpha }, { q_ }, level, flag_ );
+         w_.add( { -alpha }, { z_ }, level, flag_ );
+
+         gammaOld = gamma;
+         alphaOld = alpha;
+      }
+
+      timingTree_->stop( "Pipelined CG Solver" );
+   }
+
+   uint_t getIterations() const { return iterations_; }
+
+   void setPrintInfo( bool printInfo ) { printInfo_ = printInfo; }
+   void setName( std::string newName ) { name_ = newName; }
+   void setDoFType( hyteg::DoFType flag ) { flag_ = flag; }
+
+ private:
+   FunctionType r_;
+   FunctionType u_;
+   FunctionType w_;
+   FunctionType m_;
+   FunctionType n_;
+   FunctionType z_;
+   FunctionType q_;
+   FunctionType s_;
+   FunctionType p_;
+
+   std::shared_ptr< Solver< OperatorType > > preconditioner_;
+
+   hyteg::DoFType flag_;
+   bool           printInfo_;
+   ValueType      absoluteTolerance_;
+   ValueType      relativeTolerance_;
+   uint_t         maxIter_;
+   uint_t         iterations_;
+
+   std::string name_;
+
+   std::shared_ptr< walberla::WcTimingTree > timingTree_;
+};
+
+} // namespace hyteg
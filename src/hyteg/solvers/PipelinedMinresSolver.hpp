@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2026 Nils Kohl, Marcus Mohr.
+ *
+ * This file is part of HyTeG
+ * (see https://i10git.cs.fau.de/hyteg/hyteg).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "core/Abort.h"
+#include "core/timing/TimingTree.h"
+
+#include "hyteg/Format.hpp"
+#include "hyteg/communication/NonBlockingAllReduce.hpp"
+#include "hyteg/functions/FunctionTools.hpp"
+#include "hyteg/primitivestorage/PrimitiveStorage.hpp"
+#include "hyteg/solvers/Solver.hpp"
+#include "hyteg/solvers/preconditioners/IdentityPreconditioner.hpp"
+
+namespace hyteg {
+
+using walberla::uint_t;
+
+/// \brief Pipelined preconditioned MINRES method.
+///
+/// Mathematically equivalent to MinResSolver, i.e. suited for symmetric (indefinite) operators and symmetric positive
+/// definite preconditioners. The preconditioned Lanczos process is rearranged such that both Lanczos coefficients of
+/// an iteration only depend on the inner products z_k^T A z_k and (A z_k)^T M (A z_k). These are summed up globally
+/// with a single, non-blocking reduction that overlaps with the operator application for the next iteration.
+/// MinResSolver requires two blocking reductions per iteration instead.
+///
+/// The off-diagonal Lanczos coefficient is computed from the identity gamma_{k+1}^2 = (M A z_k)^T A z_k - delta_k^2 -
+/// gamma_k^2, which only holds as long as the Lanczos vectors stay orthogonal. If it becomes non-positive due to
+/// rounding errors (or an invariant subspace has been found) the solver stops.
+template < class OperatorType >
+class PipelinedMinResSolver : public Solver< OperatorType >
+{
+ public:
+   using FunctionType = typename OperatorType::srcType;
+   using ValueType    = typename FunctionTrait< FunctionType >::ValueType;
+
+   PipelinedMinResSolver(
+       const std::shared_ptr< PrimitiveStorage >& storage,
+       uint_t                                     minLevel,
+       uint_t                                     maxLevel,
+       uint_t                                     maxIter           = std::numeric_limits< uint_t >::max(),
+       ValueType                                  relativeTolerance = 1e-16,
+       ValueType                                  absoluteTolerance = 1e-16,
+       std::shared_ptr< Solver< OperatorType > >  preconditioner = std::make_shared< IdentityPreconditioner< OperatorType > >() )
+   : z_( "pminres_z", storage, minLevel, maxLevel )
+   , zm_( "pminres_zm", storage, minLevel, maxLevel )
+   , w_( "pminres_w", storage, minLevel, maxLevel )
+   , wm_( "pminres_wm", storage, minLevel, maxLevel )
+   , m_( "pminres_m", storage, minLevel, maxLevel )
+   , n_( "pminres_n", storage, minLevel, maxLevel )
+   , d_( "pminres_d", storage, minLevel, maxLevel )
+   , dm_( "pminres_dm", storage, minLevel, maxLevel )
+   , preconditioner_( preconditioner )
+   , flag_( hyteg::Inner | hyteg::NeumannBoundary | hyteg::FreeslipBoundary )
+   , printInfo_( false )
+   , absoluteTolerance_( absoluteTolerance )
+   , relativeTolerance_( relativeTolerance )
+   , maxIter_( maxIter )
+   , iterations_( maxIter_ )
+   , name_( "PipelinedMinRes" )
+   , timingTree_( storage->getTimingTree() )
+   {
+      if ( !std::is_same< FunctionType, typename OperatorType::dstType >::value )
+      {
+         WALBERLA_ABORT( "PipelinedMinResSolver does not work for Operator with different src and dst FunctionTypes" );
+      }
+   }
+
+   void solve( const OperatorType& A, const FunctionType& x, const FunctionType& b, const uint_t level ) override
+   {
+      if ( maxIter_ == 0 )
+      {
+         iterations_ = 0;
+         return;
+      }
+
+      timingTree_->start( "Pipelined MinRes Solver" );
+
+      for ( auto f : { &z_, &zm_, &w_, &wm_, &m_, &n_, &d_, &dm_ } )
+      {
+         copyBCs( x, *f );
+         f->setToZero( level );
+      }
+
+      // the initial residual r = b - A x is stored in n
+      A.apply( x, w_, level, flag_, Replace );
+      n_.assign( { ValueType( 1 ), ValueType( -1 ) }, { b, w_ }, level, flag_ );
+      preconditioner_->solve( A, z_, n_, level );
+
+      const ValueType resStart = std::sqrt( z_.dotGlobal( n_, level, flag_ ) );
+
+      if ( printInfo_ )
+      {
+         WALBERLA_LOG_INFO_ON_ROOT( "[" << name_ << "] residuum: " << std::scientific << resStart );
+      }
+
+      if ( resStart < absoluteTolerance_ )
+      {
+         if ( printInfo_ )
+         {
+            WALBERLA_LOG_INFO_ON_ROOT( "[" << name_ << "] converged" );
+         }
+         timingTree_->stop( "Pipelined MinRes Solver" );
+         return;
+      }
+
+      // normalized first Lanczos vector z and w = A z
+      z_.assign( { ValueType( 1 ) / resStart }, { z_ }, level, flag_ );
+      A.apply( z_, w_, level, flag_, Replace );
+
+      // [ w^T z, m^T w ]
+      communication::NonBlockingAllReduce< ValueType > reduction( 2 );
+
+      ValueType gamma = 0;
+      ValueType eta   = resStart;
+      ValueType c_old = 1;
+      ValueType c_new = 1;
+      ValueType s_old = 0;
+      ValueType s_new = 0;
+
+      iterations_ = maxIter_;
+      for ( uint_t i = 0; i < maxIter_; ++i )
+      {
+         m_.interpolate( ValueType( 0 ), level, All );
+         preconditioner_->solve( A, m_, w_, level );
+
+         reduction[0] = w_.dotLocal( z_, level, flag_ );
+         reduction[1] = m_.dotLocal( w_, level, flag_ );
+         reduction.start();
+
+         // overlapped with the reduction
+         A.apply( m_, n_, level, flag_, Replace );
+
+         reduction.wait();
+         const ValueType delta        = reduction[0];
+         const ValueType gammaNextSqr = reduction[1] - delta * delta - gamma * gamma;
+         const bool      breakdown    = !( gammaNextSqr > 0 );
+         const ValueType gammaNext    = breakdown ? ValueType( 0 ) : std::sqrt( gammaNextSqr );
+
+         // QR update of the tridiagonal Lanczos matrix via Givens rotations
+         const ValueType alpha0 = c_new * delta - c_old * s_new * gamma;
+         const ValueType alpha1 = std::sqrt( alpha0 * alpha0 + gammaNext * gammaNext );
+         const ValueType alpha2 = s_new * delta + c_old * c_new * gamma;
+         const ValueType alpha3 = s_old * gamma;
+
+         c_old = c_new;
+         c_new = alpha0 / alpha1;
+         s_old = s_new;
+         s_new = gammaNext / alpha1;
+
+         dm_.assign(
+             { ValueType( 1 ) / alpha1, -alpha3 / alpha1, -alpha2 / alpha1 }, { z_, dm_, d_ }, level, flag_ );
+         d_.swap( dm_, level );
+         x.add( { c_new * eta }, { d_ }, level, flag_ );
+
+         eta = -s_new * eta;
+
+         if ( printInfo_ )
+         {
+            WALBERLA_LOG_INFO_ON_ROOT( walberla::format(
+                std::string( "[" ) + name_ + std::string( "] iter: %6d | residuum: %10.5e" ), i, std::abs( eta ) ) );
+         }
+
+         if ( std::abs( eta ) / resStart < relativeTolerance_ || std::abs( eta ) < absoluteTolerance_ )
+         {
+            if ( printInfo_ )
+            {
+               WALBERLA_LOG_INFO_ON_ROOT( "[" << name_ << "] converged after " << std::defaultfloat << i << " iterations" );
+            }
+            iterations_ = i;
+            break;
+         }
+
+         if ( breakdown )
+         {
+            if ( printInfo_ )
+            {
+               WALBERLA_LOG_INFO_ON_ROOT( "[" << name_ << "] Lanczos breakdown after " << std::defaultfloat << i
+                                              << " iterations" );
+            }
+            iterations_ = i;
+            break;
+         }
+
+         // next Lanczos vectors: z_{k+1} = ( M A z_k - delta z_k - gamma z_{k-1} ) / gamma_{k+1}, w_{k+1} = A z_{k+1}
+         zm_.assign( { ValueType( 1 ) / gammaNext, -delta / gammaNext, -gamma / gammaNext }, { m_, z_, zm_ }, level, flag_ );
+         z_.swap( zm_, level );
+         wm_.assign( { ValueType( 1 ) / gammaNext, -delta / gammaNext, -gamma / gammaNext }, { n_, w_, wm_ }, level, flag_ );
+         w_.swap( wm_, level );
+
+         gamma = gammaNext;
+      }
+
+      timingTree_->stop( "Pipelined MinRes Solver" );
+   }
+
+   uint_t getIterations() const { return iterations_; }
+
+   void setPrintInfo( bool printInfo ) { printInfo_ = printInfo; }
+   void setName( std::string newName ) { name_ = newName; }
+   void setDoFType( hyteg::DoFType flag ) { flag_ = flag; }
+   void setAbsoluteTolerance( ValueType absoluteTolerance ) { absoluteTolerance_ = absoluteTolerance; }
+   void setRelativeTolerance( ValueType relativeTolerance ) { relativeTolerance_ = relativeTolerance; }
+
+ private:
+   FunctionType z_;
+   FunctionType zm_;
+   FunctionType w_;
+   FunctionType wm_;
+   FunctionType m_;
+   FunctionType n_;
+   FunctionType d_;
+   FunctionType dm_;
+
+   std::shared_ptr< Solver< OperatorType > > preconditioner_;
+
+   hyteg::DoFType flag_;
+   bool           printInfo_;
+   ValueType      absoluteTolerance_;
+   ValueType      relativeTolerance_;
+   uint_t         maxIter_;
+   uint_t         iterations_;
+
+   std::string name_;
+
+   std::shared_ptr< walberla::WcTimingTree > timingTree_;
+};
+
+} // namespace hyteg
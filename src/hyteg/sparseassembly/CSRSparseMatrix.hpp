@@ -0,0 +1,591 @@
+/*
+ * Copyright (c) 2026 Nils Kohl, Marcus Mohr.
+ *
+ * This file is part of HyTeG
+ * (see https://i10git.cs.fau.de/hyteg/hyteg).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "core/Abort.h"
+#include "core/debug/CheckFunctions.h"
+#include "core/mpi/BufferSystem.h"
+#include "core/mpi/Gatherv.h"
+#include "core/mpi/MPIManager.h"
+
+#include "hyteg/communication/MPITagProvider.hpp"
+#include "hyteg/sparseassembly/SparseMatrixProxy.hpp"
+
+namespace hyteg {
+
+using walberla::int_c;
+using walberla::real_c;
+using walberla::uint_c;
+
+/// \brief Distributed sparse matrix in compressed sparse row (CSR) format that does not depend on any external library.
+///
+/// Each process owns a contiguous range of global rows and columns, ordered by rank, as obtained from enumerating the
+/// HyTeG functions. The matrix is filled through the SparseMatrixProxy interface (i.e. by passing it to an operator's
+/// toMatrix() method) and must then be converted to the CSR format by calling assemble().
+///
+/// Columns that are owned by other processes are stored as "ghost" columns behind the local columns. Their values are
+/// exchanged with the owning processes during each multiplication. The communication pattern is set up once during
+/// the assembly.
+class CSRSparseMatrix : public SparseMatrixProxy
+{
+ public:
+   /// \param localRows        number of rows owned by this process
+   /// \param localCols        number of columns owned by this process
+   /// \param MpiCommunicator  the communicator over which the matrix is distributed
+   CSRSparseMatrix( uint_t          localRows,
+                    uint_t          localCols,
+                    const MPI_Comm& MpiCommunicator = walberla::mpi::MPIManager::instance()->comm() )
+   : comm_( MpiCommunicator )
+   , localRows_( localRows )
+   , localCols_( localCols )
+   , assembled_( false )
+   , haloTag_( -1 )
+   {
+      int rank = 0;
+      WALBERLA_MPI_SECTION()
+      {
+         MPI_Comm_rank( comm_, &rank );
+      }
+
+      rowOffsets_ = exclusiveOffsets( walberla::mpi::allGather( localRows, comm_ ) );
+      colOffsets_ = exclusiveOffsets( walberla::mpi::allGather( localCols, comm_ ) );
+
+      rowBegin_ = rowOffsets_[uint_c( rank )];
+      colBegin_ = colOffsets_[uint_c( rank )];
+   }
+
+   ~CSRSparseMatrix() override
+   {
+      if ( haloTag_ >= 0 )
+      {
+         communication::MPITagProvider::returnMPITag( haloTag_ );
+      }
+   }
+
+   std::shared_ptr< SparseMatrixProxy > createCopy() const override { WALBERLA_ABORT( "Not implemented." ); }
+   std::shared_ptr< SparseMatrixProxy > createEmptyCopy() const override { WALBERLA_ABORT( "Not implemented." ); }
+   std::shared_ptr< SparseMatrixProxy > createMatrix( uint_t          localRows,
+                                                      uint_t          localCols,
+                                                      uint_t          globalRows,
+                                                      uint_t          globalCols,
+                                                      const MPI_Comm& MpiCommunicator ) const override
+   {
+      WALBERLA_ABORT( "Not implemented." );
+   }
+
+   /// \brief Adds the passed value on the existing value in the matrix, or sets it to the value if no value exists.
+   void addValue( uint_t row, uint_t col, real_t value ) override
+   {
+      WALBERLA_CHECK( !assembled_, "Cannot add values to the CSR matrix after assemble() was called." );
+      entries_.push_back( { row, col, value } );
+   }
+
+   /// \brief Adds a "block" of values to the sparse matrix at once.
+   ///
+   /// The values vector is expected to be of size rows.size() * cols.size().
+   void addValues( const std::vector< uint_t >& rows,
+                   const std::vector< uint_t >& cols,
+                   const std::vector< real_t >& values ) override
+   {
+      WALBERLA_CHECK( !assembled_, "Cannot add values to the CSR matrix after assemble() was called." );
+      WALBERLA_ASSERT_EQUAL( values.size(), rows.size() * cols.size() );
+      for ( uint_t i = 0; i < rows.size(); i++ )
+      {
+         for ( uint_t j = 0; j < cols.size(); j++ )
+         {
+            entries_.push_back( { rows[i], cols[j], values[i * cols.size() + j] } );
+         }
+      }
+   }
+
+   void createFromMatrixProduct( const std::vector< std::shared_ptr< SparseMatrixProxy > >& matrices ) override
+   {
+      WALBERLA_ABORT( "Not implemented." );
+   }
+
+   void createFromMatrixLinComb( const std::vector< real_t >&                               scalars,
+                                 const std::vector< std::shared_ptr< SparseMatrixProxy > >& matrices ) override
+   {
+      WALBERLA_ABORT( "Not implemented." );
+   }
+
+   /// \brief Converts the added entries to the CSR format and sets up the communication for the multiplication.
+   ///
+   /// Entries in rows owned by other processes are sent to their owners, entries with the same position are summed up.
+   /// Must be called collectively by all processes of the communicator.
+   void assemble()
+   {
+      WALBERLA_CHECK( !assembled_, "CSR matrix has already been assembled." );
+
+      gatherLocalEntries();
+
+      std::sort( entries_.begin(), entries_.end(), []( const Entry& a, const Entry& b ) {
+         return a.row < b.row || ( a.row == b.row && a.col < b.col );
+      } );
+
+      // the ghost columns are numbered consecutively after the local columns, in order of their global index
+      for ( const auto& entry : entries_ )
+      {
+         if ( !isLocalColumn( entry.col ) )
+         {
+            ghostCols_.push_back( entry.col );
+         }
+      }
+      std::sort( ghostCols_.begin(), ghostCols_.end() );
+      ghostCols_.erase( std::unique( ghostCols_.begin(), ghostCols_.end() ), ghostCols_.end() );
+
+      rowPtr_.assign( localRows_ + 1, 0 );
+      colIdx_.clear();
+      values_.clear();
+      colIdx_.reserve( entries_.size() );
+      values_.reserve( entries_.size() );
+
+      for ( uint_t i = 0; i < entries_.size(); ++i )
+      {
+         const auto& entry = entries_[i];
+         if ( i > 0 && entry.row == entries_[i - 1].row && entry.col == entries_[i - 1].col )
+         {
+            values_.back() += entry.value;
+            continue;
+         }
+         colIdx_.push_back( getLocalColumnIndex( entry.col ) );
+         values_.push_back( entry.value );
+         rowPtr_[entry.row - rowBegin_ + 1]++;
+      }
+      for ( uint_t row = 0; row < localRows_; ++row )
+      {
+         rowPtr_[row + 1] += rowPtr_[row];
+      }
+
+      entries_.clear();
+      entries_.shrink_to_fit();
+
+      setupHaloExchange();
+
+      columnValues_.resize( localCols_ + ghostCols_.size() );
+      assembled_ = true;
+   }
+
+   /// \brief Computes y = A x.
+   ///
+   /// \param x  values of the local columns, i.e. of size getNumLocalCols()
+   /// \param y  is resized to the number of local rows
+   void multiply( const std::vector< real_t >& x, std::vector< real_t >& y )
+   {
+      WALBERLA_CHECK( assembled_, "CSR matrix must be assembled before it can be multiplied." );
+      WALBERLA_CHECK_EQUAL( x.size(), localCols_ );
+
+      gatherColumnValues( x, columnValues_ );
+
+      y.resize( localRows_ );
+
+      const uint_t* rowPtr = rowPtr_.data();
+      const uint_t* colIdx = colIdx_.data();
+      const real_t* values = values_.data();
+      const real_t* xExt   = columnValues_.data();
+
+#ifdef HYTEG_BUILD_WITH_OPENMP
+#pragma omp parallel for default( shared )
+#endif
+      for ( int row = 0; row < int_c( localRows_ ); ++row )
+      {
+         real_t sum = real_c( 0 );
+         for ( uint_t k = rowPtr[row]; k < rowPtr[row + 1]; ++k )
+         {
+            sum += values[k] * xExt[colIdx[k]];
+         }
+         y[uint_c( row )] = sum;
+      }
+   }
+
+   /// \brief Returns the diagonal entries of the local rows (zero if the entry does not exist).
+   ///
+   /// Requires the diagonal block to be square, i.e. the same distribution of rows and columns.
+   std::vector< real_t > getDiagonal() const
+   {
+      WALBERLA_CHECK( assembled_, "CSR matrix must be assembled before the diagonal can be extracted." );
+      WALBERLA_CHECK_EQUAL(
+          rowBegin_, colBegin_, "Diagonal can only be extracted from matrices with matching row and column distribution." );
+
+      std::vector< real_t > diagonal( localRows_, real_c( 0 ) );
+      for ( uint_t row = 0; row < localRows_; ++row )
+      {
+         for ( uint_t k = rowPtr_[row]; k < rowPtr_[row + 1]; ++k )
+         {
+            if ( colIdx_[k] == row )
+            {
+               diagonal[row] = values_[k];
+            }
+         }
+      }
+      return diagonal;
+   }
+
+   /// \brief Collects the values of the local columns followed by the values of the ghost columns.
+   ///
+   /// Must be called collectively by all processes of the communicator.
+   ///
+   /// \param x             values of the local columns, i.e. of size getNumLocalCols()
+   /// \param xWithGhosts   is resized to the number of local and ghost columns
+   void gatherColumnValues( const std::vector< real_t >& x, std::vector< real_t >& xWithGhosts )
+   {
+      WALBERLA_CHECK( assembled_, "CSR matrix must be assembled before the ghost values can be exchanged." );
+      WALBERLA_CHECK_EQUAL( x.size(), localCols_ );
+
+      xWithGhosts.resize( localCols_ + ghostCols_.size() );
+      std::copy( x.begin(), x.end(), xWithGhosts.begin() );
+      exchangeGhostValues( xWithGhosts );
+   }
+
+   /// \brief Calls f( row, col, value ) with the global indices for all locally stored entries.
+   template < typename EntryFunction >
+   void forEachLocalEntry( EntryFunction&& f ) const
+   {
+      WALBERLA_CHECK( assembled_, "CSR matrix must be assembled before its entries can be accessed." );
+      for ( uint_t row = 0; row < localRows_; ++row )
+      {
+         for ( uint_t k = rowPtr_[row]; k < rowPtr_[row + 1]; ++k )
+         {
+            f( rowBegin_ + row, globalColumnIndex( colIdx_[k] ), values_[k] );
+         }
+      }
+   }
+
+   /// \brief Returns the entries (global column index and value) of the requested rows, which may be owned by any process.
+   ///
+   /// Must be called collectively by all processes of the communicator.
+   std::map< uint_t, std::vector< std::pair< uint_t, real_t > > > getRows( const std::vector< uint_t >& globalRows ) const
+   {
+      WALBERLA_CHECK( assembled_, "CSR matrix must be assembled before its rows can be accessed." );
+
+      std::map< uint_t, std::vector< std::pair< uint_t, real_t > > > rows;
+
+      static const int requestTag = communication::MPITagProvider::getMPITag();
+      static const int replyTag   = communication::MPITagProvider::getMPITag();
+
+      walberla::mpi::BufferSystem requestBufferSystem( comm_, requestTag );
+      for ( const auto& row : globalRows )
+      {
+         if ( isLocalRow( row ) )
+         {
+            rows[row] = localRow( row );
+         }
+         else
+         {
+            requestBufferSystem.sendBuffer( owner( rowOffsets_, row ) ) << row;
+         }
+      }
+      requestBufferSystem.setReceiverInfoFromSendBufferState( false, true );
+      requestBufferSystem.sendAll();
+
+      walberla::mpi::BufferSystem replyBufferSystem( comm_, replyTag );
+      for ( auto pkg = requestBufferSystem.begin(); pkg != requestBufferSystem.end(); ++pkg )
+      {
+         while ( !pkg.buffer().isEmpty() )
+         {
+            uint_t row;
+            pkg.buffer() >> row;
+            WALBERLA_CHECK( isLocalRow( row ), "Requested row " << row << " is not owned by this process." );
+            const auto entries = localRow( row );
+            auto&      buffer  = replyBufferSystem.sendBuffer( pkg.rank() );
+            buffer << row << uint_c( entries.size() );
+            for ( const auto& [col, value] : entries )
+            {
+               buffer << col << value;
+            }
+         }
+      }
+      replyBufferSystem.setReceiverInfoFromSendBufferState( false, true );
+      replyBufferSystem.sendAll();
+
+      for ( auto pkg = replyBufferSystem.begin(); pkg != replyBufferSystem.end(); ++pkg )
+      {
+         while ( !pkg.buffer().isEmpty() )
+         {
+            uint_t row;
+            uint_t numEntries;
+            pkg.buffer() >> row >> numEntries;
+            auto& entries = rows[row];
+            entries.resize( numEntries );
+            for ( auto& [col, value] : entries )
+            {
+               pkg.buffer() >> col >> value;
+            }
+         }
+      }
+
+      return rows;
+   }
+
+   /// \brief Zeros the rows and columns of the marked DoFs and sets their diagonal entries to the passed value.
+   ///
+   /// Symmetric counterpart to the elimination of Dirichlet DoFs with MatZeroRowsColumns() in PETSc. The diagonal
+   /// entries of the marked rows must be part of the sparsity pattern. Must be called collectively by all processes of
+   /// the communicator.
+   ///
+   /// \param localMask      nonzero for the local DoFs to be eliminated, of size getNumLocalRows()
+   /// \param diagonalValue  value of the diagonal entries in the eliminated rows
+   void zeroRowsColumns( const std::vector< real_t >& localMask, real_t diagonalValue )
+   {
+      WALBERLA_CHECK_EQUAL(
+          rowBegin_, colBegin_, "Rows and columns can only be eliminated for matching row and column distribution." );
+
+      std::vector< real_t > columnMask;
+      gatherColumnValues( localMask, columnMask );
+
+      for ( uint_t row = 0; row < localRows_; ++row )
+      {
+         bool diagonalFound = false;
+         for ( uint_t k = rowPtr_[row]; k < rowPtr_[row + 1]; ++k )
+         {
+            if ( colIdx_[k] == row )
+            {
+               diagonalFound = true;
+               if ( localMask[row] != real_c( 0 ) )
+               {
+                  values_[k] = diagonalValue;
+               }
+            }
+            else if ( localMask[row] != real_c( 0 ) || columnMask[colIdx_[k]] != real_c( 0 ) )
+            {
+               values_[k] = real_c( 0 );
+            }
+         }
+         WALBERLA_CHECK( diagonalFound || localMask[row] == real_c( 0 ),
+                         "Diagonal entry of eliminated row " << rowBegin_ + row << " is not part of the sparsity pattern." );
+      }
+   }
+
+   /// \brief Returns the position of the passed global column in the output of gatherColumnValues().
+   ///
+   /// Only valid for local columns and for columns that occur in the local rows.
+   uint_t getLocalColumnIndex( uint_t col ) const
+   {
+      if ( isLocalColumn( col ) )
+      {
+         return col - colBegin_;
+      }
+      return localCols_ + uint_c( std::lower_bound( ghostCols_.begin(), ghostCols_.end(), col ) - ghostCols_.begin() );
+   }
+
+   uint_t getNumLocalRows() const { return localRows_; }
+   uint_t getNumLocalCols() const { return localCols_; }
+   uint_t getNumGlobalRows() const { return rowOffsets_.back(); }
+   uint_t getNumGlobalCols() const { return colOffsets_.back(); }
+   uint_t getNumLocalNonZeros() const { return values_.size(); }
+   uint_t getRowOffset() const { return rowBegin_; }
+   uint_t getColOffset() const { return colBegin_; }
+
+   const MPI_Comm& getCommunicator() const { return comm_; }
+
+ private:
+   struct Entry
+   {
+      uint_t row;
+      uint_t col;
+      real_t value;
+   };
+
+   static std::vector< uint_t > exclusiveOffsets( const std::vector< uint_t >& sizes )
+   {
+      std::vector< uint_t > offsets( 1, 0 );
+      for ( const auto& size : sizes )
+      {
+         offsets.push_back( offsets.back() + size );
+      }
+      return offsets;
+   }
+
+   static walberla::mpi::MPIRank owner( const std::vector< uint_t >& offsets, uint_t globalIndex )
+   {
+      WALBERLA_CHECK_LESS( globalIndex, offsets.back(), "Index exceeds the global size of the matrix." );
+      return walberla::mpi::MPIRank( std::upper_bound( offsets.begin(), offsets.end(), globalIndex ) - offsets.begin() - 1 );
+   }
+
+   bool isLocalRow( uint_t row ) const { return row >= rowBegin_ && row < rowBegin_ + localRows_; }
+   bool isLocalColumn( uint_t col ) const { return col >= colBegin_ && col < colBegin_ + localCols_; }
+
+   uint_t globalColumnIndex( uint_t localCol ) const
+   {
+      return localCol < localCols_ ? colBegin_ + localCol : ghostCols_[localCol - localCols_];
+   }
+
+   std::vector< std::pair< uint_t, real_t > > localRow( uint_t globalRow ) const
+   {
+      const uint_t                               row = globalRow - rowBegin_;
+      std::vector< std::pair< uint_t, real_t > > entries;
+      entries.reserve( rowPtr_[row + 1] - rowPtr_[row] );
+      for ( uint_t k = rowPtr_[row]; k < rowPtr_[row + 1]; ++k )
+      {
+         entries.emplace_back( globalColumnIndex( colIdx_[k] ), values_[k] );
+      }
+      return entries;
+   }
+
+   /// Sends the entries of rows that are owned by other processes to their owners.
+   void gatherLocalEntries()
+   {
+      static const int tag = communication::MPITagProvider::getMPITag();
+
+      walberla::mpi::BufferSystem bufferSystem( comm_, tag );
+
+      std::vector< Entry > localEntries;
+      localEntries.reserve( entries_.size() );
+      for ( const auto& entry : entries_ )
+      {
+         if ( isLocalRow( entry.row ) )
+         {
+            localEntries.push_back( entry );
+         }
+         else
+         {
+            bufferSystem.sendBuffer( owner( rowOffsets_, entry.row ) ) << entry.row << entry.col << entry.value;
+         }
+      }
+
+      bufferSystem.setReceiverInfoFromSendBufferState( false, true );
+      bufferSystem.sendAll();
+
+      for ( auto pkg = bufferSystem.begin(); pkg != bufferSystem.end(); ++pkg )
+      {
+         while ( !pkg.buffer().isEmpty() )
+         {
+            Entry entry;
+            pkg.buffer() >> entry.row >> entry.col >> entry.value;
+            WALBERLA_CHECK( isLocalRow( entry.row ), "Received row " << entry.row << " that is not owned by this process." );
+            localEntries.push_back( entry );
+         }
+      }
+
+      entries_.swap( localEntries );
+   }
+
+   /// Tells the owners of the ghost columns which of their values are required by this process.
+   void setupHaloExchange()
+   {
+      static const int tag = communication::MPITagProvider::getMPITag();
+
+      walberla::mpi::BufferSystem bufferSystem( comm_, tag );
+
+      // the ghost columns are sorted, so the columns of each owner form a contiguous range
+      std::set< walberla::mpi::MPIRank > ranksToRecvFrom;
+      for ( uint_t i = 0; i < ghostCols_.size(); ++i )
+      {
+         const auto rank = owner( colOffsets_, ghostCols_[i] );
+         if ( ranksToRecvFrom.count( rank ) == 0 )
+         {
+            ranksToRecvFrom.insert( rank );
+            ghostRecvBegin_[rank] = i;
+         }
+         bufferSystem.sendBuffer( rank ) << ghostCols_[i];
+      }
+
+      bufferSystem.setReceiverInfoFromSendBufferState( false, true );
+      bufferSystem.sendAll();
+
+      for ( auto pkg = bufferSystem.begin(); pkg != bufferSystem.end(); ++pkg )
+      {
+         auto& indices = haloSendIndices_[pkg.rank()];
+         while ( !pkg.buffer().isEmpty() )
+         {
+            uint_t col;
+            pkg.buffer() >> col;
+            WALBERLA_CHECK( isLocalColumn( col ), "Requested column " << col << " is not owned by this process." );
+            indices.push_back( col - colBegin_ );
+         }
+      }
+
+      if ( haloTag_ < 0 )
+      {
+         haloTag_ = communication::MPITagProvider::getMPITag();
+      }
+      haloBufferSystem_ = std::make_unique< walberla::mpi::BufferSystem >( comm_, haloTag_ );
+      haloBufferSystem_->setReceiverInfo( ranksToRecvFrom, false );
+   }
+
+   /// Receives the current values of the ghost columns from their owners.
+   void exchangeGhostValues( std::vector< real_t >& columnValues )
+   {
+      for ( const auto& [rank, indices] : haloSendIndices_ )
+      {
+         auto& buffer = haloBufferSystem_->sendBuffer( rank );
+         for ( const auto& idx : indices )
+         {
+            buffer << columnValues[idx];
+         }
+      }
+
+      haloBufferSystem_->sendAll();
+
+      for ( auto pkg = haloBufferSystem_->begin(); pkg != haloBufferSystem_->end(); ++pkg )
+      {
+         uint_t ghost = ghostRecvBegin_.at( pkg.rank() );
+         while ( !pkg.buffer().isEmpty() )
+         {
+            pkg.buffer() >> columnValues[localCols_ + ghost];
+            ghost++;
+         }
+      }
+   }
+
+   MPI_Comm comm_;
+
+   uint_t localRows_;
+   uint_t localCols_;
+   uint_t rowBegin_;
+   uint_t colBegin_;
+
+   /// global index of the first row (column) owned by each process, the last entry is the global number of rows (columns)
+   std::vector< uint_t > rowOffsets_;
+   std::vector< uint_t > colOffsets_;
+
+   bool assembled_;
+
+   /// entries added through the proxy interface, cleared during the assembly
+   std::vector< Entry > entries_;
+
+   std::vector< uint_t > rowPtr_;
+   std::vector< uint_t > colIdx_;
+   std::vector< real_t > values_;
+
+   /// global indices of the ghost columns
+   std::vector< uint_t > ghostCols_;
+
+   /// values of the local columns followed by the values of the ghost columns
+   std::vector< real_t > columnValues_;
+
+   /// local column indices whose values are sent to the respective process in each multiplication
+   std::map< walberla::mpi::MPIRank, std::vector< uint_t > > haloSendIndices_;
+   /// index of the first ghost column that is received from the respective process
+   std::map< walberla::mpi::MPIRank, uint_t > ghostRecvBegin_;
+
+   int                                            haloTag_;
+   std::unique_ptr< walberla::mpi::BufferSystem > haloBufferSystem_;
+};
+
+} // namespace hyteg
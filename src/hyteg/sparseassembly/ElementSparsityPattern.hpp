@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2026 Nils Kohl, Marcus Mohr.
+ *
+ * This file is part of HyTeG
+ * (see https://i10git.cs.fau.de/hyteg/hyteg).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <array>
+#include <type_traits>
+#include <vector>
+
+#include "hyteg/edgedofspace/EdgeDoFIndexing.hpp"
+#include "hyteg/p1functionspace/P1Function.hpp"
+#include "hyteg/p1functionspace/VertexDoFIndexing.hpp"
+#include "hyteg/p2functionspace/P2Function.hpp"
+#include "hyteg/sparseassembly/SparsityPatternProxy.hpp"
+#include "hyteg/volumedofspace/CellDoFIndexing.hpp"
+#include "hyteg/volumedofspace/FaceDoFIndexing.hpp"
+
+namespace hyteg {
+
+/// True for the numerator types whose DoF couplings can be determined by recordElementCouplings().
+template < typename NumeratorType >
+constexpr bool hasElementCouplings =
+    std::is_same_v< NumeratorType, P1Function< idx_t > > || std::is_same_v< NumeratorType, P2Function< idx_t > >;
+
+namespace detail {
+
+/// Writes the global indices of the DoFs of the passed micro-face to indices.
+inline void elementDoFIndices( const P1Function< idx_t >& numerator,
+                               const Face&                face,
+                               uint_t                     level,
+                               const indexing::Index&     microFace,
+                               facedof::FaceType          fType,
+                               std::vector< uint_t >&     indices )
+{
+   std::array< uint_t, 3 > vertexDoFIndices;
+   vertexdof::getVertexDoFDataIndicesFromMicroFace( microFace, fType, level, vertexDoFIndices );
+
+   const idx_t* vertexData = face.getData( numerator.getFaceDataID() )->getPointer( level );
+
+   indices.clear();
+   for ( const uint_t idx : vertexDoFIndices )
+   {
+      indices.push_back( uint_c( vertexData[idx] ) );
+   }
+}
+
+inline void elementDoFIndices( const P2Function< idx_t >& numerator,
+                               const Face&                face,
+                               uint_t                     level,
+                               const indexing::Index&     microFace,
+                               facedof::FaceType          fType,
+                               std::vector< uint_t >&     indices )
+{
+   elementDoFIndices( numerator.getVertexDoFFunction(), face, level, microFace, fType, indices );
+
+   std::array< uint_t, 3 > edgeDoFIndices;
+   edgedof::getEdgeDoFDataIndicesFromMicroFaceFEniCSOrdering( microFace, fType, level, edgeDoFIndices );
+
+   const idx_t* edgeData = face.getData( numerator.getEdgeDoFFunction().getFaceDataID() )->getPointer( level );
+   for ( const uint_t idx : edgeDoFIndices )
+   {
+      indices.push_back( uint_c( edgeData[idx] ) );
+   }
+}
+
+/// Writes the global indices of the DoFs of the passed micro-cell to indices.
+inline void elementDoFIndices( const P1Function< idx_t >& numerator,
+                               const Cell&                cell,
+                               uint_t                     level,
+                               const indexing::Index&     microCell,
+                               celldof::CellType          cType,
+                               std::vector< uint_t >&     indices )
+{
+   std::array< uint_t, 4 > vertexDoFIndices;
+   vertexdof::getVertexDoFDataIndicesFromMicroCell( microCell, cType, level, vertexDoFIndices );
+
+   const idx_t* vertexData = cell.getData( numerator.getCellDataID() )->getPointer( level );
+
+   indices.clear();
+   for ( const uint_t idx : vertexDoFIndices )
+   {
+      indices.push_back( uint_c( vertexData[idx] ) );
+   }
+}
+
+inline void elementDoFIndices( const P2Function< idx_t >& numerator,
+                               const Cell&                cell,
+                               uint_t                     level,
+                               const indexing::Index&     microCell,
+                               celldof::CellType          cType,
+                               std::vector< uint_t >&     indices )
+{
+   elementDoFIndices( numerator.getVertexDoFFunction(), cell, level, microCell, cType, indices );
+
+   std::array< uint_t, 6 > edgeDoFIndices;
+   edgedof::getEdgeDoFDataIndicesFromMicroCellFEniCSOrdering( microCell, cType, level, edgeDoFIndices );
+
+   const idx_t* edgeData = cell.getData( numerator.getEdgeDoFFunction().getCellDataID() )->getPointer( level );
+   for ( const uint_t idx : edgeDoFIndices )
+   {
+      indices.push_back( uint_c( edgeData[idx] ) );
+   }
+}
+
+} // namespace detail
+
+/// \brief Records the couplings of all DoFs that belong to the same micro-element (micro-face in 2D, micro-cell in 3D)
+///        in the passed sparsity pattern.
+///
+/// This is the sparsity pattern of the P1 and P2 operators (elementwise and stencil-based) that map between the passed
+/// function spaces. Compared to recording the pattern with the operator's toMatrix() method, no element matrices are
+/// integrated, only the DoF indices are gathered from the numerators.
+///
+/// \param pattern  sparsity pattern to record the couplings in
+/// \param src      numerator of the source space (columns)
+/// \param dst      numerator of the destination space (rows)
+/// \param level    refinement level
+template < typename SrcNumeratorType, typename DstNumeratorType >
+void recordElementCouplings( SparsityPatternProxy&   pattern,
+                             const SrcNumeratorType& src,
+                             const DstNumeratorType& dst,
+                             uint_t                  level )
+{
+   static_assert( hasElementCouplings< SrcNumeratorType > && hasElementCouplings< DstNumeratorType >,
+                  "Element couplings are only available for P1 and P2 numerators." );
+
+   const auto storage = src.getStorage();
+
+   std::vector< uint_t >       rowIdx;
+   std::vector< uint_t >       colIdx;
+   const std::vector< real_t > noValues;
+
+   if ( storage->hasGlobalCells() )
+   {
+      for ( const auto& it : storage->getCells() )
+      {
+         const Cell& cell = *it.second;
+         for ( const auto& cType : celldof::allCellTypes )
+         {
+            for ( const auto& micro : celldof::macrocell::Iterator( level, cType, 0 ) )
+            {
+               detail::elementDoFIndices( dst, cell, level, micro, cType, rowIdx );
+               detail::elementDoFIndices( src, cell, level, micro, cType, colIdx );
+               pattern.addValues( rowIdx, colIdx, noValues );
+            }
+         }
+      }
+   }
+   else
+   {
+      for ( const auto& it : storage->getFaces() )
+      {
+         const Face& face = *it.second;
+         for ( const auto& fType : facedof::allFaceTypes )
+         {
+            for ( const auto& micro : facedof::macroface::Iterator( level, fType, 0 ) )
+            {
+               detail::elementDoFIndices( dst, face, level, micro, fType, rowIdx );
+               detail::elementDoFIndices( src, face, level, micro, fType, colIdx );
+               pattern.addValues( rowIdx, colIdx, noValues );
+            }
+         }
+      }
+   }
+}
+
+} // namespace hyteg
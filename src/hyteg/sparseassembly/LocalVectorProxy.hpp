@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2026 Nils Kohl, Marcus Mohr.
+ *
+ * This file is part of HyTeG
+ * (see https://i10git.cs.fau.de/hyteg/hyteg).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "core/DataTypes.h"
+#include "core/debug/Debug.h"
+
+#include "hyteg/sparseassembly/VectorProxy.hpp"
+
+namespace hyteg {
+
+/// \brief Proxy onto the locally owned part of a distributed vector, stored in a std::vector.
+///
+/// The global indices passed to the proxy are shifted by the global index of the first locally owned entry.
+/// The caller must ensure that `vectorRef` outlives `this`.
+class LocalVectorProxy : public VectorProxy
+{
+ public:
+   LocalVectorProxy( std::vector< real_t >& vectorRef, uint_t offset )
+   : vectorRef_( vectorRef )
+   , offset_( offset )
+   {}
+
+   /// \brief Sets the passed value in the vector.
+   void setValue( uint_t idx, real_t value ) override
+   {
+      WALBERLA_ASSERT_GREATER_EQUAL( idx, offset_ );
+      WALBERLA_ASSERT_LESS( idx - offset_, vectorRef_.size() );
+      vectorRef_[idx - offset_] = value;
+   }
+
+   /// \brief Returns the passed value of the vector.
+   real_t getValue( uint_t idx ) const override
+   {
+      WALBERLA_ASSERT_GREATER_EQUAL( idx, offset_ );
+      WALBERLA_ASSERT_LESS( idx - offset_, vectorRef_.size() );
+      return vectorRef_[idx - offset_];
+   }
+
+ private:
+   std::vector< real_t >& vectorRef_;
+   uint_t                 offset_;
+};
+
+} // namespace hyteg
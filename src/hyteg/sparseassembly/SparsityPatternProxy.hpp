@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2026 Nils Kohl, Marcus Mohr.
+ *
+ * This file is part of HyTeG
+ * (see https://i10git.cs.fau.de/hyteg/hyteg).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include "core/Abort.h"
+#include "core/debug/CheckFunctions.h"
+#include "core/mpi/BufferDataTypeExtensions.h"
+#include "core/mpi/BufferSystem.h"
+#include "core/mpi/Gatherv.h"
+
+#include "hyteg/communication/MPITagProvider.hpp"
+#include "hyteg/sparseassembly/SparseMatrixProxy.hpp"
+
+namespace hyteg {
+
+/// \brief Sparse matrix proxy that only records the positions of the entries, but not their values.
+///
+/// This allows a two-pass assembly of sparse matrices: In the first pass, the operator's toMatrix() method is called with
+/// this proxy to determine the nonzero pattern. From the pattern, the exact number of nonzeros per row can be computed for
+/// the preallocation of the actual matrix, into which the values are then inserted in the second pass.
+///
+/// The rows and columns are distributed as for the matrices of the external libraries, i.e. each process owns a
+/// contiguous range of global row (column) indices, ordered by rank. Entries in rows that are owned by other processes
+/// (e.g. couplings assembled on a macro-cell for DoFs on a neighboring macro-face) are sent to their owners when the
+/// nonzeros are counted.
+class SparsityPatternProxy : public SparseMatrixProxy
+{
+ public:
+   /// \param localRows        number of rows owned by this process
+   /// \param localCols        number of columns owned by this process (i.e. the size of the diagonal block)
+   /// \param MpiCommunicator  the communicator over which the matrix is distributed
+   SparsityPatternProxy( uint_t localRows, uint_t localCols, const MPI_Comm& MpiCommunicator )
+   : comm_( MpiCommunicator )
+   , rowOffsets_( 1, 0 )
+   , pattern_( localRows )
+   {
+      const std::vector< uint_t > rowsPerRank = walberla::mpi::allGather( localRows, comm_ );
+      const std::vector< uint_t > colsPerRank = walberla::mpi::allGather( localCols, comm_ );
+
+      int rank = 0;
+      WALBERLA_MPI_SECTION()
+      {
+         MPI_Comm_rank( comm_, &rank );
+      }
+
+      colBegin_ = 0;
+      for ( uint_t i = 0; i < rowsPerRank.size(); ++i )
+      {
+         rowOffsets_.push_back( rowOffsets_.back() + rowsPerRank[i] );
+         if ( i < uint_c( rank ) )
+         {
+            colBegin_ += colsPerRank[i];
+         }
+      }
+      rowBegin_ = rowOffsets_[uint_c( rank )];
+      rowEnd_   = rowOffsets_[uint_c( rank ) + 1];
+      colEnd_   = colBegin_ + localCols;
+   }
+
+   std::shared_ptr< SparseMatrixProxy > createCopy() const override { WALBERLA_ABORT( "Not implemented." ); }
+   std::shared_ptr< SparseMatrixProxy > createEmptyCopy() const override { WALBERLA_ABORT( "Not implemented." ); }
+   std::shared_ptr< SparseMatrixProxy > createMatrix( uint_t          localRows,
+                                                      uint_t          localCols,
+                                                      uint_t          globalRows,
+                                                      uint_t          globalCols,
+                                                      const MPI_Comm& MpiCommunicator ) const override
+   {
+      WALBERLA_ABORT( "Not implemented." );
+   }
+
+   /// \brief Records the position of the entry, the value is ignored.
+   void addValue( uint_t row, uint_t col, real_t ) override { columnsOfRow( row ).push_back( col ); }
+
+   /// \brief Records the positions of a "block" of entries, the values are ignored.
+   void addValues( const std::vector< uint_t >& rows, const std::vector< uint_t >& cols, const std::vector< real_t >& ) override
+   {
+      for ( const auto& row : rows )
+      {
+         auto& columns = columnsOfRow( row );
+         columns.insert( columns.end(), cols.begin(), cols.end() );
+      }
+   }
+
+   void createFromMatrixProduct( const std::vector< std::shared_ptr< SparseMatrixProxy > >& ) override
+   {
+      WALBERLA_ABORT( "Not implemented." );
+   }
+
+   void createFromMatrixLinComb( const std::vector< real_t >&,
+                                 const std::vector< std::shared_ptr< SparseMatrixProxy > >& ) override
+   {
+      WALBERLA_ABORT( "Not implemented." );
+   }
+
+   /// \brief Counts the nonzeros in each row owned by this process.
+   ///
+   /// Must be called collectively by all processes of the communicator after the pattern has been recorded.
+   ///
+   /// \param diagonalNonZeros     number of nonzeros in the diagonal block (columns owned by this process), per local row
+   /// \param offDiagonalNonZeros  number of nonzeros in the off-diagonal block, per local row
+   template < typename IndexType >
+   void countNonZeros( std::vector< IndexType >& diagonalNonZeros, std::vector< IndexType >& offDiagonalNonZeros )
+   {
+      exchangeNonLocalRows();
+
+      diagonalNonZeros.assign( pattern_.size(), IndexType( 0 ) );
+      offDiagonalNonZeros.assign( pattern_.size(), IndexType( 0 ) );
+
+      for ( uint_t i = 0; i < pattern_.size(); ++i )
+      {
+         auto& columns = pattern_[i];
+         std::sort( columns.begin(), columns.end() );
+         columns.erase( std::unique( columns.begin(), columns.end() ), columns.end() );
+
+         const auto diagonalBegin = std::lower_bound( columns.begin(), columns.end(), colBegin_ );
+         const auto diagonalEnd   = std::lower_bound( diagonalBegin, columns.end(), colEnd_ );
+
+         diagonalNonZeros[i]    = static_cast< IndexType >( diagonalEnd - diagonalBegin );
+         offDiagonalNonZeros[i] = static_cast< IndexType >( columns.size() ) - diagonalNonZeros[i];
+      }
+   }
+
+ private:
+   std::vector< uint_t >& columnsOfRow( uint_t row )
+   {
+      if ( row >= rowBegin_ && row < rowEnd_ )
+      {
+         return pattern_[row - rowBegin_];
+      }
+      return nonLocalPattern_[row];
+   }
+
+   /// Sends the recorded entries of rows that are owned by other processes to their owners.
+   void exchangeNonLocalRows()
+   {
+      static const int tag = communication::MPITagProvider::getMPITag();
+
+      walberla::mpi::BufferSystem bufferSystem( comm_, tag );
+
+      for ( auto& [row, columns] : nonLocalPattern_ )
+      {
+         WALBERLA_CHECK_LESS( row, rowOffsets_.back(), "Row index exceeds the global number of rows." );
+
+         // remove duplicates before sending
+         std::sort( columns.begin(), columns.end() );
+         columns.erase( std::unique( columns.begin(), columns.end() ), columns.end() );
+
+         const auto owner = std::upper_bound( rowOffsets_.begin(), rowOffsets_.end(), row ) - rowOffsets_.begin() - 1;
+         bufferSystem.sendBuffer( walberla::mpi::MPIRank( owner ) ) << row << columns;
+      }
+      nonLocalPattern_.clear();
+
+      bufferSystem.setReceiverInfoFromSendBufferState( false, true );
+      bufferSystem.sendAll();
+
+      for ( auto pkg = bufferSystem.begin(); pkg != bufferSystem.end(); ++pkg )
+      {
+         while ( !pkg.buffer().isEmpty() )
+         {
+            uint_t                row;
+            std::vector< uint_t > columns;
+            pkg.buffer() >> row >> columns;
+
+            WALBERLA_CHECK( row >= rowBegin_ && row < rowEnd_, "Received row " << row << " that is not owned by this process." );
+            auto& localColumns = pattern_[row - rowBegin_];
+            localColumns.insert( localColumns.end(), columns.begin(), columns.end() );
+         }
+      }
+   }
+
+   MPI_Comm comm_;
+
+   /// global index of the first row owned by each process, rowOffsets_.back() is the global number of rows
+   std::vector< uint_t > rowOffsets_;
+
+   uint_t rowBegin_;
+   uint_t rowEnd_;
+   uint_t colBegin_;
+   uint_t colEnd_;
+
+   /// column indices of the entries in the local rows (may contain duplicates until the nonzeros are counted)
+   std::vector< std::vector< uint_t > > pattern_;
+   /// column indices of the entries in rows owned by other processes
+   std::map< uint_t, std::vector< uint_t > > nonLocalPattern_;
+};
+
+} // namespace hyteg
@@ -66,12 +66,18 @@ class TrilinosSparseMatrixProxy : public SparseMatrixProxy
                    const std::vector< real_t >& values ) override
    {
       WALBERLA_ASSERT_EQUAL( values.size(), rows.size() * cols.size() );
+
+      // insert one row of the block per call instead of each entry separately
+      std::vector< Tpetra::Vector<>::global_ordinal_type > rowCols( cols.begin(), cols.end() );
+      std::vector< Tpetra::Vector<>::scalar_type >         rowValues( cols.size() );
       for ( uint_t i = 0; i < rows.size(); i++ )
       {
          for ( uint_t j = 0; j < cols.size(); j++ )
          {
-            addValue( rows[i], cols[j], values[i * cols.size() + j] );
+            rowValues[j] = values[i * cols.size() + j];
          }
+         mat_->insertGlobalValues(
+             rows[i], Teuchos::arrayViewFromVector( rowCols ), Teuchos::arrayViewFromVector( rowValues ) );
       }
    }
 
@@ -21,6 +21,10 @@
 #pragma once
 
 #include <concepts>
+#include <functional>
+#include <vector>
+
+#include "hyteg/types/types.hpp"
 
 namespace hyteg {
 
@@ -75,5 +79,14 @@ concept fe_function_composite = std::is_base_of_v< BlockFunction< typename T::Va
 template < typename T >
 concept fe_function = fe_function_scalar< T > || fe_function_vectorial< T > || fe_function_composite< T >;
 
+/// Concept matching functions that compute the dot products with several other functions in a single sweep
+/// (e.g. P1Function, P2Function)
+template < typename T >
+concept batched_dot =
+    requires( const T& f, const std::vector< std::reference_wrapper< const T > >& rhs, std::size_t level, DoFType flag ) {
+       f.dotLocalBatch( rhs, level, flag );
+       f.dotGlobalBatch( rhs, level, flag );
+    };
+
 } // namespace concepts
 } // namespace hyteg
@@ -694,6 +694,110 @@ ValueType VolumeDoFFunction< ValueType >::dotLocal( const VolumeDoFFunction< Val
    return sum;
 }
 
+/// \brief Evaluates the dot products with all passed functions on all local DoFs in one sweep over the DoFs of this
+/// function. No communication is involved and the results may be different on each process.
+template < typename ValueType >
+std::vector< ValueType >
+    VolumeDoFFunction< ValueType >::dotLocalBatch( const std::vector< std::reference_wrapper< const VolumeDoFFunction< ValueType > > >& rhs,
+                                                   uint_t level ) const
+{
+   const uint_t             numRhs = rhs.size();
+   std::vector< ValueType > sums( numRhs, ValueType( 0 ) );
+
+   std::vector< ValueType* >                      otherMems( numRhs );
+   std::vector< indexing::VolumeDoFMemoryLayout > otherLayouts( numRhs );
+   for ( uint_t k = 0; k < numRhs; k++ )
+   {
+      otherLayouts[k] = rhs[k].get().memoryLayout();
+   }
+
+   if ( this->storage_->hasGlobalCells() )
+   {
+      for ( const auto& cellIt : this->getStorage()->getCells() )
+      {
+         const auto cellId = cellIt.first;
+
+         const auto mem     = dofMemory( cellId, level );
+         const auto layout  = memoryLayout_;
+         const auto numDofs = this->numScalarsPerPrimitive_.at( cellId );
+
+         for ( uint_t k = 0; k < numRhs; k++ )
+         {
+            otherMems[k] = rhs[k].get().dofMemory( cellId, level );
+         }
+
+         for ( auto cellType : celldof::allCellTypes )
+         {
+            for ( auto elementIdx : celldof::macrocell::Iterator( level, cellType ) )
+            {
+               for ( uint_t dof = 0; dof < numDofs; dof++ )
+               {
+                  const auto idx =
+                      indexing::index( elementIdx.x(), elementIdx.y(), elementIdx.z(), cellType, dof, numDofs, level, layout );
+                  const auto value = mem[idx];
+
+                  for ( uint_t k = 0; k < numRhs; k++ )
+                  {
+                     const auto otherIdx = indexing::index(
+                         elementIdx.x(), elementIdx.y(), elementIdx.z(), cellType, dof, numDofs, level, otherLayouts[k] );
+                     sums[k] += value * otherMems[k][otherIdx];
+                  }
+               }
+            }
+         }
+      }
+   }
+   else
+   {
+      for ( const auto& faceIt : this->getStorage()->getFaces() )
+      {
+         const auto faceId = faceIt.first;
+
+         const auto mem     = dofMemory( faceId, level );
+         const auto layout  = memoryLayout_;
+         const auto numDofs = this->numScalarsPerPrimitive_.at( faceId );
+
+         for ( uint_t k = 0; k < numRhs; k++ )
+         {
+            otherMems[k] = rhs[k].get().dofMemory( faceId, level );
+         }
+
+         for ( auto faceType : facedof::allFaceTypes )
+         {
+            for ( auto elementIdx : facedof::macroface::Iterator( level, faceType ) )
+            {
+               for ( uint_t dof = 0; dof < numDofs; dof++ )
+               {
+                  const auto idx   = indexing::index( elementIdx.x(), elementIdx.y(), faceType, dof, numDofs, level, layout );
+                  const auto value = mem[idx];
+
+                  for ( uint_t k = 0; k < numRhs; k++ )
+                  {
+                     const auto otherIdx =
+                         indexing::index( elementIdx.x(), elementIdx.y(), faceType, dof, numDofs, level, otherLayouts[k] );
+                     sums[k] += value * otherMems[k][otherIdx];
+                  }
+               }
+            }
+         }
+      }
+   }
+
+   return sums;
+}
+
+/// \brief Evaluates the (global) dot products with all passed functions with a single reduction. Involves communication and
+/// has to be called collectively.
+template < typename ValueType >
+std::vector< ValueType >
+    VolumeDoFFunction< ValueType >::dotGlobalBatch( const std::vector< std::reference_wrapper< const VolumeDoFFunction< ValueType > > >& rhs,
+                                                    uint_t level ) const
+{
+   auto sums = dotLocalBatch( rhs, level );
+   walberla::mpi::allReduceInplace( sums, walberla::mpi::SUM );
+   return sums;
+}
+
 /// \brief swaps the content of one volumeDoFFunction with another.
 template < typename ValueType >
 void VolumeDoFFunction< ValueType >::swap( const VolumeDoFFunction< ValueType >& rhs, uint_t level ) const
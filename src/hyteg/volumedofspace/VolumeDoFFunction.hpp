@@ -120,6 +120,16 @@ class VolumeDoFFunction : public Function< VolumeDoFFunction< ValueType > >
    /// \brief Evaluates the (global) dot product. Involves communication and has to be called collectively.
    ValueType dotGlobal( const VolumeDoFFunction< ValueType >& rhs, uint_t level ) const;
 
+   /// \brief Evaluates the dot products with all passed functions on all local DoFs, reading the DoFs of this function
+   /// only once. No communication is involved and the results may be different on each process.
+   std::vector< ValueType > dotLocalBatch( const std::vector< std::reference_wrapper< const VolumeDoFFunction< ValueType > > >& rhs,
+                                           uint_t level ) const;
+
+   /// \brief Evaluates the (global) dot products with all passed functions with a single reduction. Involves communication
+   /// and has to be called collectively.
+   std::vector< ValueType > dotGlobalBatch( const std::vector< std::reference_wrapper< const VolumeDoFFunction< ValueType > > >& rhs,
+                                            uint_t level ) const;
+
    /// Return the maximal value of the degrees of freedom of the function
    ///
    /// \param level     function acts on the dofs of this refinement level
@@ -24,13 +24,27 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <functional>
+#include <limits>
+#include <map>
 #include <vector>
 
 #include "core/DataTypes.h"
 #include "core/debug/CheckFunctions.h"
+#include "core/mpi/Reduce.h"
 
 #include "hyteg/Format.hpp"
+#include "hyteg/edgedofspace/EdgeDoFIndexing.hpp"
+#include "hyteg/geometry/IcosahedralShellMap.hpp"
+#include "hyteg/geometry/IdentityMap.hpp"
+#include "hyteg/mesh/micro/MicroMesh.hpp"
+#include "hyteg/p1functionspace/P1VectorFunction.hpp"
+#include "hyteg/p1functionspace/VertexDoFIndexing.hpp"
+#include "hyteg/p2functionspace/P2VectorFunction.hpp"
+#include "hyteg/primitivestorage/PrimitiveStorage.hpp"
 
 using namespace hyteg;
 
@@ -84,7 +98,7 @@ inline real_t radiusOfMacroMeshShell( uint_t layer, real_t rMin, real_t rMax, ui
    return rMin + real_c( layer ) * ( rMax - rMin ) / real_c( nRad - 1 );
 }
 
-std::vector< real_t >
+inline std::vector< real_t >
     computeShellRadii( const std::vector< real_t >& layers, uint_t level, uint_t polynomialOrderOfLagrangeDiscr )
 {
    uint_t effectiveLevel = level + polynomialOrderOfLagrangeDiscr - 1;
@@ -126,20 +140,27 @@ inline uint_t nearestShellFromRadius( real_t radius,
 }
 
 /// Computes the index of the nearest shell from a given radius.
+///
+/// The shell radii must be sorted in ascending order (as returned by computeShellRadii()). If the radius lies exactly in the
+/// middle of two shells, the inner one is returned.
 inline uint_t nearestShellFromRadius( real_t radius, const std::vector< real_t >& shellRadii )
 {
-   uint_t nearestShell    = 0u;
-   real_t nearestDistance = __DBL_MAX__;
-   for ( uint_t iShell = 0u; iShell < shellRadii.size(); iShell++ )
+   WALBERLA_ASSERT( !shellRadii.empty() );
+   WALBERLA_ASSERT( std::is_sorted( shellRadii.begin(), shellRadii.end() ) );
+
+   const auto upper = std::lower_bound( shellRadii.begin(), shellRadii.end(), radius );
+
+   if ( upper == shellRadii.begin() )
    {
-      if ( std::abs( radius - shellRadii[iShell] ) < nearestDistance )
-      {
-         nearestShell    = iShell;
-         nearestDistance = std::abs( radius - shellRadii[iShell] );
-      }
+      return 0;
+   }
+
+   if ( upper == shellRadii.end() || radius - *( upper - 1 ) <= *upper - radius )
+   {
+      return uint_c( upper - shellRadii.begin() ) - 1;
    }
 
-   return nearestShell;
+   return uint_c( upper - shellRadii.begin() );
 }
 
 /// Computes the index of the nearest shell from a given radius.
@@ -210,6 +231,415 @@ inline void interpolateRadialShellID( ScalarFunctionType& u, std::vector< real_t
    u.interpolate( radialShellID, level );
 }
 
+namespace detail {
+
+/// Radial shell index of the micro-vertices of a macro-primitive of a spherical shell mesh that is blended with the
+/// IcosahedralShellMap.
+///
+/// The map moves each point radially to a radius that is an affine function of its computational coordinates, and the
+/// micro-shells subdivide each macro-layer uniformly. Therefore, the shell index of a micro-vertex is an affine function of
+/// its logical index with integer coefficients that follow from the macro-layers of the vertices of the macro-primitive.
+class MicroVertexShellIndex
+{
+ public:
+   template < size_t NumVertices >
+   MicroVertexShellIndex( const std::array< Point3D, NumVertices >& macroVertexCoordinates,
+                          const std::vector< real_t >&              layers,
+                          uint_t                                    level )
+   : slope_{ 0, 0, 0 }
+   {
+      static_assert( NumVertices >= 1 && NumVertices <= 4 );
+
+      std::array< idx_t, NumVertices > macroLayer;
+      for ( uint_t k = 0; k < NumVertices; k++ )
+      {
+         macroLayer[k] = idx_t( nearestShellFromRadius( macroVertexCoordinates[k].norm(), layers ) );
+      }
+
+      offset_ = idx_t( levelinfo::num_microedges_per_edge( level ) ) * macroLayer[0];
+      for ( uint_t k = 1; k < NumVertices; k++ )
+      {
+         slope_[k - 1] = macroLayer[k] - macroLayer[0];
+      }
+   }
+
+   idx_t operator()( const indexing::Index& microVertexIndex ) const
+   {
+      return offset_ + slope_[0] * microVertexIndex.x() + slope_[1] * microVertexIndex.y() + slope_[2] * microVertexIndex.z();
+   }
+
+ private:
+   idx_t                  offset_;
+   std::array< idx_t, 3 > slope_;
+};
+
+/// Returns true if the shells of all DoFs on this process can be computed with MicroVertexShellIndex, i.e. if the mesh is
+/// three-dimensional, all macro-edges, -faces, and -cells are blended with the IcosahedralShellMap, the macro-vertices are not
+/// mapped, and no MicroMesh is used.
+inline bool isBlendedWithIcosahedralShellMap( const PrimitiveStorage& storage )
+{
+   if ( !storage.hasGlobalCells() || storage.getMicroMesh() != nullptr )
+   {
+      return false;
+   }
+
+   for ( const auto& it : storage.getVertices() )
+   {
+      if ( std::dynamic_pointer_cast< IdentityMap >( it.second->getGeometryMap() ) == nullptr )
+      {
+         return false;
+      }
+   }
+
+   const auto isShellMap = []( const Primitive& primitive ) {
+      return std::dynamic_pointer_cast< IcosahedralShellMap >( primitive.getGeometryMap() ) != nullptr;
+   };
+
+   for ( const auto& it : storage.getEdges() )
+   {
+      if ( !isShellMap( *it.second ) )
+      {
+         return false;
+      }
+   }
+
+   for ( const auto& it : storage.getFaces() )
+   {
+      if ( !isShellMap( *it.second ) )
+      {
+         return false;
+      }
+   }
+
+   for ( const auto& it : storage.getCells() )
+   {
+      if ( !isShellMap( *it.second ) )
+      {
+         return false;
+      }
+   }
+
+   return true;
+}
+
+/// Visits all process-local DoFs of the passed vertex DoF functions (components of the same vector function or a single
+/// scalar function) on a mesh that satisfies isBlendedWithIcosahedralShellMap().
+///
+/// Calls visitor( shell, values, position ) for each DoF, where values holds the DoF value of each function and position() is
+/// a callable that returns the coordinates of the DoF. The shell index is computed from the logical index and multiplied by
+/// shellFactor (2 for the vertex DoFs of P2 functions).
+template < typename ValueType, size_t N, typename Visitor >
+void visitVertexDoFsOnShells( const std::array< const vertexdof::VertexDoFFunction< ValueType >*, N >& u,
+                              uint_t                                                                 level,
+                              const std::vector< real_t >&                                           layers,
+                              idx_t                                                                  shellFactor,
+                              Visitor&&                                                              visitor )
+{
+   const auto storage = u[0]->getStorage();
+
+   std::array< const ValueType*, N > data;
+   std::array< ValueType, N >        values;
+
+   for ( const auto& it : storage->getVertices() )
+   {
+      const Vertex&               vertex = *it.second;
+      const MicroVertexShellIndex shellIndex( std::array< Point3D, 1 >{ vertex.getCoordinates() }, layers, level );
+      const indexing::Index       index( 0, 0, 0 );
+
+      for ( uint_t c = 0; c < N; c++ )
+      {
+         values[c] = vertex.getData( u[c]->getVertexDataID() )->getPointer( level )[0];
+      }
+      visitor( uint_c( shellFactor * shellIndex( index ) ), values, [&]() {
+         return micromesh::microVertexPosition( storage, vertex.getID(), level, index );
+      } );
+   }
+
+   for ( const auto& it : storage->getEdges() )
+   {
+      const Edge&                 edge = *it.second;
+      const MicroVertexShellIndex shellIndex( edge.getCoordinates(), layers, level );
+
+      for ( uint_t c = 0; c < N; c++ )
+      {
+         data[c] = edge.getData( u[c]->getEdgeDataID() )->getPointer( level );
+      }
+      for ( const auto& index : vertexdof::macroedge::Iterator( level, 1 ) )
+      {
+         const uint_t idx = vertexdof::macroedge::index( level, index.x() );
+         for ( uint_t c = 0; c < N; c++ )
+         {
+            values[c] = data[c][idx];
+         }
+         visitor( uint_c( shellFactor * shellIndex( index ) ), values, [&]() {
+            return micromesh::microVertexPosition( storage, edge.getID(), level, index );
+         } );
+      }
+   }
+
+   for ( const auto& it : storage->getFaces() )
+   {
+      const Face&                 face = *it.second;
+      const MicroVertexShellIndex shellIndex( face.getCoordinates(), layers, level );
+
+      for ( uint_t c = 0; c < N; c++ )
+      {
+         data[c] = face.getData( u[c]->getFaceDataID() )->getPointer( level );
+      }
+      for ( const auto& index : vertexdof::macroface::Iterator( level, 1 ) )
+      {
+         const uint_t idx = vertexdof::macroface::index( level, index.x(), index.y() );
+         for ( uint_t c = 0; c < N; c++ )
+         {
+            values[c] = data[c][idx];
+         }
+         visitor( uint_c( shellFactor * shellIndex( index ) ), values, [&]() {
+            return micromesh::microVertexPosition( storage, face.getID(), level, index );
+         } );
+      }
+   }
+
+   for ( const auto& it : storage->getCells() )
+   {
+      const Cell&                 cell = *it.second;
+      const MicroVertexShellIndex shellIndex( cell.getCoordinates(), layers, level );
+
+      for ( uint_t c = 0; c < N; c++ )
+      {
+         data[c] = cell.getData( u[c]->getCellDataID() )->getPointer( level );
+      }
+      for ( const auto& index : vertexdof::macrocell::Iterator( level, 1 ) )
+      {
+         const uint_t idx = vertexdof::macrocell::index( level, index.x(), index.y(), index.z() );
+         for ( uint_t c = 0; c < N; c++ )
+         {
+            values[c] = data[c][idx];
+         }
+         visitor( uint_c( shellFactor * shellIndex( index ) ), values, [&]() {
+            return micromesh::microVertexPosition( storage, cell.getID(), level, index );
+         } );
+      }
+   }
+}
+
+/// Same as visitVertexDoFsOnShells() for edge DoF functions (the edge DoFs of P2 functions).
+///
+/// An edge DoF lies in the middle of its micro-edge, so its shell index on level + 1 is the sum of the shell indices of the
+/// two micro-vertices of the edge on level.
+template < typename ValueType, size_t N, typename Visitor >
+void visitEdgeDoFsOnShells( const std::array< const EdgeDoFFunction< ValueType >*, N >& u,
+                            uint_t                                                     level,
+                            const std::vector< real_t >&                               layers,
+                            Visitor&&                                                  visitor )
+{
+   const auto storage = u[0]->getStorage();
+
+   std::array< const ValueType*, N > data;
+   std::array< ValueType, N >        values;
+
+   const auto shellOfEdge = []( const MicroVertexShellIndex&       shellIndex,
+                                const indexing::Index&             index,
+                                const edgedof::EdgeDoFOrientation& orientation ) {
+      const auto vertices = edgedof::calcNeighboringVertexDoFIndices( orientation );
+      return uint_c( shellIndex( index + vertices[0] ) + shellIndex( index + vertices[1] ) );
+   };
+
+   for ( const auto& it : storage->getEdges() )
+   {
+      const Edge&                 edge = *it.second;
+      const MicroVertexShellIndex shellIndex( edge.getCoordinates(), layers, level );
+
+      for ( uint_t c = 0; c < N; c++ )
+      {
+         data[c] = edge.getData( u[c]->getEdgeDataID() )->getPointer( level );
+      }
+      for ( const auto& index : edgedof::macroedge::Iterator( level, 0 ) )
+      {
+         const uint_t idx = edgedof::macroedge::index( level, index.x() );
+         for ( uint_t c = 0; c < N; c++ )
+         {
+            values[c] = data[c][idx];
+         }
+         visitor( shellOfEdge( shellIndex, index, edgedof::EdgeDoFOrientation::X ), values, [&]() {
+            return micromesh::microEdgeCenterPosition( storage, edge.getID(), level, index, edgedof::EdgeDoFOrientation::X );
+         } );
+      }
+   }
+
+   for ( const auto& it : storage->getFaces() )
+   {
+      const Face&                 face = *it.second;
+      const MicroVertexShellIndex shellIndex( face.getCoordinates(), layers, level );
+
+      for ( uint_t c = 0; c < N; c++ )
+      {
+         data[c] = face.getData( u[c]->getFaceDataID() )->getPointer( level );
+      }
+      for ( const auto& index : edgedof::macroface::Iterator( level, 0 ) )
+      {
+         for ( const auto& orientation : edgedof::faceLocalEdgeDoFOrientations )
+         {
+            if ( !edgedof::macroface::isInnerEdgeDoF( level, index, orientation ) )
+            {
+               continue;
+            }
+            const uint_t idx = edgedof::macroface::index( level, index.x(), index.y(), orientation );
+            for ( uint_t c = 0; c < N; c++ )
+            {
+               values[c] = data[c][idx];
+            }
+            visitor( shellOfEdge( shellIndex, index, orientation ), values, [&]() {
+               return micromesh::microEdgeCenterPosition( storage, face.getID(), level, index, orientation );
+            } );
+         }
+      }
+   }
+
+   if ( level == 0 )
+   {
+      return;
+   }
+
+   for ( const auto& it : storage->getCells() )
+   {
+      const Cell&                 cell = *it.second;
+      const MicroVertexShellIndex shellIndex( cell.getCoordinates(), layers, level );
+
+      for ( uint_t c = 0; c < N; c++ )
+      {
+         data[c] = cell.getData( u[c]->getCellDataID() )->getPointer( level );
+      }
+
+      const auto visitEdge = [&]( const indexing::Index& index, const edgedof::EdgeDoFOrientation& orientation ) {
+         const uint_t idx = edgedof::macrocell::index( level, index.x(), index.y(), index.z(), orientation );
+         for ( uint_t c = 0; c < N; c++ )
+         {
+            values[c] = data[c][idx];
+         }
+         visitor( shellOfEdge( shellIndex, index, orientation ), values, [&]() {
+            return micromesh::microEdgeCenterPosition( storage, cell.getID(), level, index, orientation );
+         } );
+      };
+
+      for ( const auto& index : edgedof::macrocell::Iterator( level, 0 ) )
+      {
+         for ( const auto& orientation : edgedof::allEdgeDoFOrientationsWithoutXYZ )
+         {
+            if ( edgedof::macrocell::isInnerEdgeDoF( level, index, orientation ) )
+            {
+               visitEdge( index, orientation );
+            }
+         }
+      }
+
+      for ( const auto& index : edgedof::macrocell::IteratorXYZ( level, 0 ) )
+      {
+         visitEdge( index, edgedof::EdgeDoFOrientation::XYZ );
+      }
+   }
+}
+
+/// Visits all process-local DoFs of a P1Function, P2Function, P1VectorFunction, or P2VectorFunction and calls
+/// visitor( shell, values, position ) for each of them, where values is a std::array with one entry per component and
+/// position() is a callable that returns the coordinates of the DoF.
+///
+/// If radiusFunc is empty and the mesh satisfies isBlendedWithIcosahedralShellMap(), the DoFs are visited directly and
+/// their shells are computed from their logical indices. Otherwise, interpolate() is used to cycle through the DoFs and the
+/// shell is the one nearest to radiusFunc( x ) (or the norm of x if radiusFunc is empty).
+///
+/// The DoFs are always visited in the same order for the same mesh and function space.
+template < typename FunctionType, typename Visitor >
+void visitDoFsOnShells( const FunctionType&                              u,
+                        const std::vector< real_t >&                     layers,
+                        uint_t                                           level,
+                        const std::function< real_t( const Point3D& ) >& radiusFunc,
+                        Visitor&&                                        visitor )
+{
+   using ValueType = typename FunctionType::valueType;
+   using Tag       = typename FunctionType::Tag;
+
+   constexpr bool isScalar = std::is_same_v< Tag, P1FunctionTag > || std::is_same_v< Tag, P2FunctionTag >;
+   constexpr bool isVector = std::is_same_v< Tag, P1VectorFunctionTag > || std::is_same_v< Tag, P2VectorFunctionTag >;
+
+   static_assert( isScalar || isVector, "Currently only PxFunctions and PxVectorFunctions for x in {1, 2} are supported." );
+
+   constexpr size_t N = isScalar ? 1 : 3;
+
+   if ( !radiusFunc && isBlendedWithIcosahedralShellMap( *u.getStorage() ) )
+   {
+      if constexpr ( std::is_same_v< Tag, P1FunctionTag > )
+      {
+         visitVertexDoFsOnShells< ValueType, N >( { &u }, level, layers, 1, visitor );
+      }
+      else if constexpr ( std::is_same_v< Tag, P2FunctionTag > )
+      {
+         visitVertexDoFsOnShells< ValueType, N >( { &u.getVertexDoFFunction() }, level, layers, 2, visitor );
+         visitEdgeDoFsOnShells< ValueType, N >( { &u.getEdgeDoFFunction() }, level, layers, visitor );
+      }
+      else if constexpr ( std::is_same_v< Tag, P1VectorFunctionTag > )
+      {
+         visitVertexDoFsOnShells< ValueType, N >( { &u[0], &u[1], &u[2] }, level, layers, 1, visitor );
+      }
+      else
+      {
+         visitVertexDoFsOnShells< ValueType, N >(
+             { &u[0].getVertexDoFFunction(), &u[1].getVertexDoFFunction(), &u[2].getVertexDoFFunction() },
+             level,
+             layers,
+             2,
+             visitor );
+         visitEdgeDoFsOnShells< ValueType, N >(
+             { &u[0].getEdgeDoFFunction(), &u[1].getEdgeDoFFunction(), &u[2].getEdgeDoFFunction() }, level, layers, visitor );
+      }
+      return;
+   }
+
+   const auto shellRadii = computeShellRadii( layers, level, polynomialDegreeOfBasisFunctions< FunctionType >() );
+
+   std::array< ValueType, N > values;
+
+   std::function< ValueType( const Point3D&, const std::vector< ValueType >& ) > visitValues =
+       [&]( const Point3D& x, const std::vector< ValueType >& srcValues ) {
+          const real_t radius = radiusFunc ? radiusFunc( x ) : x.norm();
+
+          std::copy( srcValues.begin(), srcValues.end(), values.begin() );
+          visitor( nearestShellFromRadius( radius, shellRadii ), values, [&]() { return x; } );
+
+          // Returning the value of the first function to ensure that the values are not altered.
+          return srcValues[0];
+       };
+
+   if constexpr ( isScalar )
+   {
+      u.interpolate( visitValues, { u }, level, All );
+   }
+   else
+   {
+      u[0].interpolate( visitValues, { u[0], u[1], u[2] }, level, All );
+   }
+}
+
+/// Value that enters the radial profile: the value itself for scalar functions and the magnitude for vector functions.
+template < typename ValueType, size_t N >
+inline real_t magnitude( const std::array< ValueType, N >& values )
+{
+   if constexpr ( N == 1 )
+   {
+      return real_c( values[0] );
+   }
+   else
+   {
+      real_t squaredNorm = 0;
+      for ( const auto& value : values )
+      {
+         squaredNorm += real_c( value * value );
+      }
+      return std::sqrt( squaredNorm );
+   }
+}
+
+} // namespace detail
+
 /// Simple struct to store data organized by radial shells.
 ///
 /// Can (and should) be used to store data for multiple functions if the positions are the same. This way, the positions are only
@@ -246,7 +676,6 @@ class RadialShellData
 
       auto arePointsInitialized = points_.size() > 0;
 
-      const auto numLayers = numberOfLayers( nRad, level, polynomialDegreeOfBasisFunctions< FunctionType >() );
       const auto numShells = numberOfShells( nRad, level, polynomialDegreeOfBasisFunctions< FunctionType >() );
 
       uint_t numComponents = 1;
@@ -256,49 +685,18 @@ class RadialShellData
       {
          numComponents = 3;
       }
-      else if constexpr ( !std::is_same_v< typename FunctionType::Tag, P1FunctionTag > &&
-                          !std::is_same_v< typename FunctionType::Tag, P2FunctionTag > )
-      {
-         WALBERLA_ABORT( "Currently only PxFunctions and PxVectorFunctions for x in {1, 2} are supported." );
-      }
 
       // To allocate the correct amount of memory required to store all process-local points and values on each shell, we need to
       // count them first. Computing that number analytically may be possible, but is certainly very tricky.
 
       std::vector< uint_t > numLocalPointsPerShell( numShells, 0 );
 
-      auto shellRadii = computeShellRadii( layers, level, polynomialDegreeOfBasisFunctions< FunctionType >() );
-
-      std::function< real_t( const Point3D&, const std::vector< real_t >& ) > countNodes =
-          [&]( const Point3D& x, const std::vector< real_t >& values ) {
-             real_t radius      = std::sqrt( x[0] * x[0] + x[1] * x[1] + x[2] * x[2] );
-             real_t scalarValue = values[0];
+      detail::visitDoFsOnShells( u, layers, level, {}, [&]( uint_t shell, const auto&, const auto& ) {
+         // Manual bounds checking.
+         WALBERLA_ASSERT_LESS( shell, numShells );
 
-             uint_t shell = nearestShellFromRadius( radius, shellRadii );
-
-             // Manual bounds checking.
-             WALBERLA_ASSERT_LESS( shell, numShells );
-
-             numLocalPointsPerShell[shell]++;
-
-             // Returning the value to ensure that the values are not altered.
-             return scalarValue;
-          };
-
-      if constexpr ( std::is_same_v< typename FunctionType::Tag, P1FunctionTag > ||
-                     std::is_same_v< typename FunctionType::Tag, P2FunctionTag > )
-      {
-         u.interpolate( countNodes, { u }, level, All );
-      }
-      else if constexpr ( std::is_same_v< typename FunctionType::Tag, P1VectorFunctionTag > ||
-                          std::is_same_v< typename FunctionType::Tag, P2VectorFunctionTag > )
-      {
-         u[0].interpolate( countNodes, { u[0] }, level, All );
-      }
-      else
-      {
-         WALBERLA_ABORT( "Radial data cannot be collected for the selected function type." );
-      }
+         numLocalPointsPerShell[shell]++;
+      } );
 
       if ( !arePointsInitialized )
       {
@@ -310,64 +708,30 @@ class RadialShellData
       }
 
       // Initialize/resize arrays
-      values_[u.getFunctionName()].resize( numComponents );
+      auto& values = values_[u.getFunctionName()];
+      values.resize( numComponents );
       for ( uint_t component = 0; component < numComponents; component++ )
       {
-         values_[u.getFunctionName()][component].resize( numShells );
+         values[component].resize( numShells );
          for ( uint_t shell = 0; shell < numShells; shell++ )
          {
-            values_[u.getFunctionName()][component][shell].reserve( numLocalPointsPerShell[shell] );
+            values[component][shell].reserve( numLocalPointsPerShell[shell] );
          }
       }
 
-      // Interpolate is used to cycle through all DoFs on a process and fill relevant parts of profile with total temperature and
-      // number of DoFs.
-
-      for ( uint_t component = 0; component < numComponents; component++ )
-      {
-         std::function< real_t( const Point3D&, const std::vector< real_t >& ) > gatherValues =
-             [&]( const Point3D& x, const std::vector< real_t >& values ) {
-                real_t radius = std::sqrt( x[0] * x[0] + x[1] * x[1] + x[2] * x[2] );
-
-                real_t scalarValue = values[0];
+      // All components are gathered in a single pass. No worries about push_back(), enough space has been reserved previously.
 
-                uint_t shell = nearestShellFromRadius( radius, shellRadii );
-
-                // Manual bounds checking.
-                WALBERLA_ASSERT_LESS( shell, numShells );
-
-                // Set point
-                if ( !arePointsInitialized )
-                {
-                   // No worries about push_back(), enough space has been reserved previously.
-                   points_[shell].push_back( x );
-                }
-
-                // Add value to corresponding shell in data array.
-                // No worries about push_back(), enough space has been reserved previously.
-                values_[u.getFunctionName()][component][shell].push_back( scalarValue );
-
-                // Returning the value to ensure that the values are not altered.
-                return scalarValue;
-             };
-
-         if constexpr ( std::is_same_v< typename FunctionType::Tag, P1FunctionTag > ||
-                        std::is_same_v< typename FunctionType::Tag, P2FunctionTag > )
-         {
-            u.interpolate( gatherValues, { u }, level, All );
-         }
-         else if constexpr ( std::is_same_v< typename FunctionType::Tag, P1VectorFunctionTag > ||
-                             std::is_same_v< typename FunctionType::Tag, P2VectorFunctionTag > )
+      detail::visitDoFsOnShells( u, layers, level, {}, [&]( uint_t shell, const auto& dofValues, const auto& position ) {
+         if ( !arePointsInitialized )
          {
-            u[component].interpolate( gatherValues, { u[component] }, level, All );
+            points_[shell].push_back( position() );
          }
-         else
+
+         for ( uint_t component = 0; component < numComponents; component++ )
          {
-            WALBERLA_ABORT( "Radial data cannot be collected for the selected function type." );
+            values[component][shell].push_back( real_c( dofValues[component] ) );
          }
-
-         arePointsInitialized = true;
-      }
+      } );
    }
 
    void addDataFromFunction( const FunctionType& u, real_t rMin, real_t rMax, uint_t nRad, uint_t level )
@@ -484,7 +848,11 @@ struct RadialProfile
 ///
 ///   rms( x ) = sqrt( (1/n) * sum_j (x_j)^2 ).
 ///
-/// Involves global communication!
+/// On meshes blended with the IcosahedralShellMap (and without a custom radiusFunc), the DoFs are visited directly and their
+/// shells follow from their logical indices. Otherwise, the shell of each DoF is the one nearest to radiusFunc( x ), where
+/// radiusFunc defaults to the Euclidean norm.
+///
+/// Involves global communication (two reductions)!
 ///
 ///! Note: Currently only implemented for P1Functions, P2Functions, P1VectorFunctions, and P2VectorFunctions - but can easily be
 /// extended.
@@ -495,16 +863,16 @@ struct RadialProfile
 /// \param rMax                radius of outermost shell
 /// \param nRad                number of radial layers
 /// \param level               FE function refinement level
+/// \param radiusFunc          optional function that maps a point to the "radius" that is used to determine its shell
 /// \return a filled RadialProfile struct
 
 template < typename FunctionType >
-RadialProfile computeRadialProfile(
-    const FunctionType&                       u,
-    real_t                                    rMin,
-    real_t                                    rMax,
-    std::vector< real_t >                     layers,
-    uint_t                                    level,
-    std::function< real_t( const Point3D& ) > radiusFunc = []( const Point3D& x ) { return x.norm(); } )
+RadialProfile computeRadialProfile( const FunctionType&                       u,
+                                    real_t                                    rMin,
+                                    real_t                                    rMax,
+                                    std::vector< real_t >                     layers,
+                                    uint_t                                    level,
+                                    std::function< real_t( const Point3D& ) > radiusFunc = {} )
 {
    WALBERLA_CHECK_LESS_EQUAL( rMin, rMax );
 
@@ -512,103 +880,60 @@ RadialProfile computeRadialProfile(
 
    uint_t nRad = layers.size();
 
-   const auto numLayers = numberOfLayers( nRad, level, polynomialDegreeOfBasisFunctions< FunctionType >() );
    const auto numShells = numberOfShells( nRad, level, polynomialDegreeOfBasisFunctions< FunctionType >() );
 
-   profile.shellRadii.resize( numShells );
-   profile.min.resize( numShells, std::numeric_limits< real_t >::max() );
-   profile.max.resize( numShells, std::numeric_limits< real_t >::lowest() );
+   profile.shellRadii = computeShellRadii( layers, level, polynomialDegreeOfBasisFunctions< FunctionType >() );
+   profile.min.resize( numShells );
+   profile.max.resize( numShells );
    profile.mean.resize( numShells );
    profile.rms.resize( numShells );
    profile.numDoFsPerShell.resize( numShells );
    profile.depthDim.resize( numShells );
 
-   profile.shellRadii = computeShellRadii( layers, level, polynomialDegreeOfBasisFunctions< FunctionType >() );
-
-   // WALBERLA_LOG_INFO_ON_ROOT("Shell Layer " << numShells - 1 << " = " << profile.shellRadii[numShells - 1]);
+   // Process-local data is accumulated per shell so that only two reductions are required:
+   // extrema[2 * shell] = max, extrema[2 * shell + 1] = -min (reduced with MAX), and
+   // sums[3 * shell] = sum, sums[3 * shell + 1] = sum of squares, sums[3 * shell + 2] = number of DoFs (reduced with SUM).
+   // The sums are accumulated in double precision so that the number of DoFs is exact.
+   std::vector< real_t > extrema( 2 * numShells, std::numeric_limits< real_t >::lowest() );
+   std::vector< double > sums( 3 * numShells, 0.0 );
 
-   // Interpolate is used to cycle through all DoFs on a process and fill relevant parts of profile with total temperature and
-   // number of DoFs.
+   detail::visitDoFsOnShells( u, layers, level, radiusFunc, [&]( uint_t shell, const auto& values, const auto& ) {
+      // Manual bounds checking.
+      WALBERLA_ASSERT_LESS( shell, numShells );
 
-   std::function< real_t( const Point3D&, const std::vector< real_t >& ) > gatherValues =
-       [&]( const Point3D& x, const std::vector< real_t >& values ) {
-          real_t radius = radiusFunc( x ); // std::sqrt( x[0] * x[0] + x[1] * x[1] + x[2] * x[2] );
+      const real_t value = detail::magnitude( values );
 
-          auto scalarValue = real_c( 0.0 );
-
-          if constexpr ( std::is_same_v< typename FunctionType::Tag, P1FunctionTag > ||
-                         std::is_same_v< typename FunctionType::Tag, P2FunctionTag > )
-          {
-             scalarValue = values[0];
-          }
-          else if constexpr ( std::is_same_v< typename FunctionType::Tag, P1VectorFunctionTag > ||
-                              std::is_same_v< typename FunctionType::Tag, P2VectorFunctionTag > )
-          {
-             scalarValue = std::sqrt( values[0] * values[0] + values[1] * values[1] + values[2] * values[2] );
-          }
-          else
-          {
-             WALBERLA_ABORT( "Radial profile cannot be computed for the selected function type." );
-          }
-
-          uint_t shell = nearestShellFromRadius( radius, profile.shellRadii );
-
-          // Manual bounds checking.
-          WALBERLA_ASSERT_LESS( shell, numShells );
-
-          // Add value to corresponding row in profile (using the shell number)
-          profile.min[shell] = std::min( profile.min[shell], scalarValue );
-          profile.max[shell] = std::max( profile.max[shell], scalarValue );
-          profile.mean[shell] += scalarValue;
-          profile.rms[shell] += scalarValue * scalarValue;
-          profile.numDoFsPerShell[shell] += 1;
-
-          // Returning the value of the first function to ensure that the values are not altered.
-          // This should be called on the first component of a CSFVectorFunction until we have a better implementation that
-          // does not abuse interpolate().
-          return values[0];
-       };
-
-   if constexpr ( std::is_same_v< typename FunctionType::Tag, P1FunctionTag > ||
-                  std::is_same_v< typename FunctionType::Tag, P2FunctionTag > )
-   {
-      u.interpolate( gatherValues, { u }, level, All );
-   }
-   else if constexpr ( std::is_same_v< typename FunctionType::Tag, P1VectorFunctionTag > ||
-                       std::is_same_v< typename FunctionType::Tag, P2VectorFunctionTag > )
-   {
-      u[0].interpolate( gatherValues, { u[0], u[1], u[2] }, level, All );
-   }
-   else
-   {
-      WALBERLA_ABORT( "Radial profile cannot be computed for the selected function type." );
-   }
+      extrema[2 * shell]     = std::max( extrema[2 * shell], value );
+      extrema[2 * shell + 1] = std::max( extrema[2 * shell + 1], -value );
+      sums[3 * shell] += double( value );
+      sums[3 * shell + 1] += double( value ) * double( value );
+      sums[3 * shell + 2] += 1.0;
+   } );
 
    // Reduce values on each shell over all processes
-   walberla::mpi::allReduceInplace( profile.min, walberla::mpi::MIN );
-   walberla::mpi::allReduceInplace( profile.max, walberla::mpi::MAX );
-   walberla::mpi::allReduceInplace( profile.mean, walberla::mpi::SUM );
-   walberla::mpi::allReduceInplace( profile.rms, walberla::mpi::SUM );
-   walberla::mpi::allReduceInplace( profile.numDoFsPerShell, walberla::mpi::SUM );
+   walberla::mpi::allReduceInplace( extrema, walberla::mpi::MAX );
+   walberla::mpi::allReduceInplace( sums, walberla::mpi::SUM );
 
    // Now compute mean with total / counter
    for ( uint_t shell = 0; shell < numShells; ++shell )
    {
-      profile.mean[shell] /= real_c( profile.numDoFsPerShell[shell] );
-      profile.rms[shell] = std::sqrt( profile.rms[shell] / real_c( profile.numDoFsPerShell[shell] ) );
+      profile.max[shell]             = extrema[2 * shell];
+      profile.min[shell]             = -extrema[2 * shell + 1];
+      profile.numDoFsPerShell[shell] = uint_c( sums[3 * shell + 2] );
+      profile.mean[shell]            = real_c( sums[3 * shell] / sums[3 * shell + 2] );
+      profile.rms[shell]             = real_c( std::sqrt( sums[3 * shell + 1] / sums[3 * shell + 2] ) );
    }
 
    return profile;
 }
 
 template < typename FunctionType >
-RadialProfile computeRadialProfile(
-    const FunctionType&                       u,
-    real_t                                    rMin,
-    real_t                                    rMax,
-    uint_t                                    nRad,
-    uint_t                                    level,
-    std::function< real_t( const Point3D& ) > radiusFunc = []( const Point3D& x ) { return x.norm(); } )
+RadialProfile computeRadialProfile( const FunctionType&                       u,
+                                    real_t                                    rMin,
+                                    real_t                                    rMax,
+                                    uint_t                                    nRad,
+                                    uint_t                                    level,
+                                    std::function< real_t( const Point3D& ) > radiusFunc = {} )
 {
    std::vector< real_t > layers( nRad, 0.0 );
    for ( uint_t layer = 0; layer < nRad; layer++ )
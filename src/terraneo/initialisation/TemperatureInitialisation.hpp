@@ -209,6 +209,12 @@ inline std::function< real_t( const Point3D& ) >
     temperatureSingleSPH( const TemperatureInitializationParameters&       tempInitParams,
                           const std::function< real_t( const Point3D& ) >& referenceTemp )
 {
+   // represent the single harmonic by a coefficient vector, which allows the thread-safe evaluation
+   const auto            deg = tempInitParams.deviationParameters()->deg;
+   const auto            ord = tempInitParams.deviationParameters()->ord;
+   std::vector< real_t > coeffs( SphericalHarmonicsTool::numberOfCoefficients( deg ), real_c( 0 ) );
+   coeffs[SphericalHarmonicsTool::coefficientIndex( deg, walberla::uint_c( std::abs( ord ) ), ord > 0 ? 1 : 0 )] = real_c( 1 );
+
    return [=]( const hyteg::Point3D& x ) {
       const auto rMin     = tempInitParams.rMin();
       const auto rMax     = tempInitParams.rMax();
@@ -221,8 +227,6 @@ inline std::function< real_t( const Point3D& ) >
       const auto initialTemperatureSteepness = tempDevInitParams->initialTemperatureSteepness;
       const auto tempInit                    = tempDevInitParams->tempInit;
 
-      const auto  deg            = tempDevInitParams->deg;
-      const auto  ord            = tempDevInitParams->ord;
       const auto  buoyancyFactor = tempDevInitParams->buoyancyFactor;
       const auto& sphTool        = tempDevInitParams->sphTool;
 
@@ -254,7 +258,7 @@ inline std::function< real_t( const Point3D& ) >
       }
 
       retVal += ( buoyancyFactor * filter * std::sin( walberla::math::pi * ( radius - rMin ) / ( rMax - rMin ) ) *
-                  sphTool->shconvert_eval( deg, ord, x[0], x[1], x[2] ) / std::sqrt( real_c( 4 ) * walberla::math::pi ) );
+                  sphTool->evaluate( coeffs, deg, x[0], x[1], x[2] ) / std::sqrt( real_c( 4 ) * walberla::math::pi ) );
 
       return retVal;
    };
@@ -272,6 +276,27 @@ inline std::function< real_t( const Point3D& ) >
     temperatureRandomSuperpositioneSPH( const TemperatureInitializationParameters&       tempInitParams,
                                        const std::function< real_t( const Point3D& ) >& referenceTemp )
 {
+   // Collect the random weights of the superposition in a coefficient vector once. Evaluating the expansion then
+   // requires a single computation of the associated Legendre functions per point (instead of one per harmonic)
+   // and is thread-safe.
+   const auto            lmin              = tempInitParams.deviationParameters()->lmin;
+   const auto            lmax              = tempInitParams.deviationParameters()->lmax;
+   const auto&           superpositionRand = tempInitParams.deviationParameters()->superpositionRand;
+   std::vector< real_t > coeffs( SphericalHarmonicsTool::numberOfCoefficients( lmax ), real_c( 0 ) );
+
+   WALBERLA_CHECK_GREATER_EQUAL( superpositionRand.size(), ( lmax + 1 ) * ( lmax + 1 ) - lmin * lmin );
+
+   uint_t count = 0;
+   for ( uint_t deg = lmin; deg <= lmax; ++deg )
+   {
+      for ( int ord = -walberla::int_c( deg ); ord <= walberla::int_c( deg ); ++ord )
+      {
+         coeffs[SphericalHarmonicsTool::coefficientIndex( deg, walberla::uint_c( std::abs( ord ) ), ord > 0 ? 1 : 0 )] =
+             superpositionRand[count];
+         ++count;
+      }
+   }
+
    return [=]( const hyteg::Point3D& x ) {
       const auto rMin     = tempInitParams.rMin();
       const auto rMax     = tempInitParams.rMax();
@@ -284,11 +309,8 @@ inline std::function< real_t( const Point3D& ) >
       const auto initialTemperatureSteepness = tempDevInitParams->initialTemperatureSteepness;
       const auto tempInit                    = tempDevInitParams->tempInit;
 
-      const auto  lmax              = tempDevInitParams->lmax;
-      const auto  lmin              = tempDevInitParams->lmin;
-      const auto  buoyancyFactor    = tempDevInitParams->buoyancyFactor;
-      const auto  superpositionRand = tempDevInitParams->superpositionRand;
-      const auto& sphTool           = tempDevInitParams->sphTool;
+      const auto  buoyancyFactor = tempDevInitParams->buoyancyFactor;
+      const auto& sphTool        = tempDevInitParams->sphTool;
 
       real_t retVal = referenceTemp( x );
 
@@ -317,17 +339,9 @@ inline std::function< real_t( const Point3D& ) >
          break;
       }
 
-      uint_t count = 0;
-      for ( uint_t deg = lmin; deg <= lmax; ++deg )
-      {
-         for ( int ord = -walberla::int_c( deg ); ord <= walberla::int_c( deg ); ++ord )
-         {
-            // Normalisation of 1/sqrt(4*pi) for non-dimensional temperature range [0,1]
-            retVal += ( buoyancyFactor * superpositionRand[count] * filter *
-                        sphTool->shconvert_eval( deg, ord, x[0], x[1], x[2] ) / std::sqrt( real_c( 4 ) * walberla::math::pi ) );
-            ++count;
-         }
-      }
+      // Normalisation of 1/sqrt(4*pi) for non-dimensional temperature range [0,1]
+      retVal += ( buoyancyFactor * filter * sphTool->evaluate( coeffs, lmax, x[0], x[1], x[2] ) /
+                  std::sqrt( real_c( 4 ) * walberla::math::pi ) );
 
       return retVal;
    };
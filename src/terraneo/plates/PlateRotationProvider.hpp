@@ -20,7 +20,14 @@
 
 #pragma once
 
+#include <cstddef>
+#include <map>
+#include <utility>
+
+#include "core/Abort.h"
+
 #include "terraneo/dataimport/FileIO.hpp"
+#include "terraneo/plates/types.hpp"
 
 namespace terraneo {
 namespace plates {
@@ -37,12 +44,51 @@ class PlateRotationProvider
    PlateRotationProvider( std::string nameOfRotationsFile, ImportStrategy readRotationsFile )
    {
       rotInfos_ = readRotationsFile( nameOfRotationsFile );
+      buildPlateIndex();
    }
 
    const std::vector< RotationInfo >& getRotations() const { return rotInfos_; };
 
+   /// Returns the range of consecutive rotations in the rotations vector that belongs to the given plate
+   ///
+   /// If the plate has several separate blocks of rotations in the data-file, the first one is returned.
+   std::pair< rotIter_t, rotIter_t > getRotationsForPlate( uint_t plateID ) const
+   {
+      auto iter = plateIndex_.find( plateID );
+      if ( iter == plateIndex_.end() )
+      {
+         WALBERLA_ABORT( "No rotations found for plate with ID = " << plateID );
+      }
+
+      const auto& [blockBegin, blockEnd] = iter->second;
+      return { rotInfos_.begin() + std::ptrdiff_t( blockBegin ), rotInfos_.begin() + std::ptrdiff_t( blockEnd ) };
+   }
+
  private:
+   /// set up map from plate IDs to the position of their rotations in the rotations vector
+   void buildPlateIndex()
+   {
+      plateIndex_.clear();
+
+      uint_t blockBegin = 0;
+      while ( blockBegin < rotInfos_.size() )
+      {
+         uint_t blockEnd = blockBegin + 1;
+         while ( blockEnd < rotInfos_.size() && rotInfos_[blockEnd].plateID == rotInfos_[blockBegin].plateID )
+         {
+            ++blockEnd;
+         }
+
+         // emplace does not overwrite, so we keep the first block for each plate
+         plateIndex_.emplace( rotInfos_[blockBegin].plateID, std::make_pair( blockBegin, blockEnd ) );
+         blockBegin = blockEnd;
+      }
+   }
+
    std::vector< RotationInfo > rotInfos_;
+
+   /// map from plate IDs to [begin, end) index ranges into rotInfos_
+   std::map< uint_t, std::pair< uint_t, uint_t > > plateIndex_;
 };
 
 } // namespace plates
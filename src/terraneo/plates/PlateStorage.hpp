@@ -21,6 +21,9 @@
 #pragma once
 
 #include <algorithm>
+#include <cmath>
+
+#include <boost/geometry.hpp>
 
 #include "core/extern/json.hpp"
 
@@ -34,10 +37,27 @@
 namespace terraneo {
 namespace plates {
 
+typedef boost::geometry::model::point<double, 2, boost::geometry::cs::spherical_equatorial<boost::geometry::degree>> spherical_point;
+typedef boost::geometry::model::polygon<spherical_point> polygon_on_sphere;
+typedef boost::geometry::model::segment<spherical_point> segment_on_sphere;
+
 /// Class for managing plate topology information
 class PlateStorage
 {
  public:
+   /// A single segment of a plate boundary together with a spherical cap containing it
+   struct BoundarySegment
+   {
+      /// The segment itself (a great circle arc)
+      segment_on_sphere segment;
+
+      /// Centre of the bounding cap (unit vector in cartesian coordinates)
+      vec3D midpoint{ 0, 0, 0 };
+
+      /// Opening angle of the bounding cap in radians, i.e. half of the length of the arc on the unit sphere
+      real_t halfLength{ real_c( 0 ) };
+   };
+
    /// Information describing a single plate at a certain age
    struct PlateInfo
    {
@@ -49,6 +69,18 @@ class PlateStorage
 
       /// Textual name of plate
       std::string name;
+
+      /// Boundary of the plate as corrected polygon on the sphere, set up once on import
+      polygon_on_sphere polygon;
+
+      /// Centre of a spherical cap containing the plate (unit vector in cartesian coordinates)
+      vec3D capCenter{ 0, 0, 0 };
+
+      /// Cosine of the opening angle of the bounding cap; -1 if the cap must cover the whole sphere
+      real_t capCosRadius{ real_c( -1 ) };
+
+      /// Segments of the corrected boundary polygon, used for computing distances to the plate boundary
+      std::vector< BoundarySegment > segments;
    };
 
    using plateVec_t       = std::vector< PlateInfo >;
@@ -156,6 +188,8 @@ class PlateStorage
             {
                plates[k].boundary.push_back( {element[0], element[1], real_c( 0 )} );
             }
+
+            setupPlateGeometry( plates[k] );
          }
       }
 
@@ -164,6 +198,99 @@ class PlateStorage
       std::sort( listOfPlateStages_.begin(), listOfPlateStages_.end() );
    };
 
+   /// set up the geometric data required for locating points on a plate
+   ///
+   /// Constructing and correcting the boost::geometry polygon is much more expensive than the
+   /// point-in-polygon test itself, so we do this only once per plate. Additionally, we compute
+   /// a spherical cap that contains the plate, which allows to discard most plates for a given
+   /// point with a single inner product, and bounding caps for all boundary segments, which allow
+   /// to skip most segments when computing the distance of a point to the plate boundary.
+   static void setupPlateGeometry( PlateInfo& plate )
+   {
+      for ( const auto& node : plate.boundary )
+      {
+         boost::geometry::append( plate.polygon.outer(), spherical_point( node[0], node[1] ) );
+      }
+      boost::geometry::correct( plate.polygon );
+
+      // bounding caps of the boundary segments
+      plate.segments.clear();
+      boost::geometry::for_each_segment( plate.polygon, [&plate]( const auto& segment ) {
+         BoundarySegment entry;
+         entry.segment = segment_on_sphere( segment.first, segment.second );
+
+         const vec3D start = toUnitVector( segment.first );
+         const vec3D end   = toUnitVector( segment.second );
+         const vec3D sum   = start + end;
+         if ( sum.norm() > real_c( 1e-12 ) )
+         {
+            entry.midpoint   = sum.normalized();
+            entry.halfLength = real_c( 0.5 ) * angleBetween( start, end );
+         }
+         else
+         {
+            // antipodal end points, the cap cannot be used for pruning
+            entry.midpoint   = start;
+            entry.halfLength = conversions::pi;
+         }
+         plate.segments.push_back( entry );
+      } );
+
+      // bounding cap of the whole plate
+      plate.capCenter    = vec3D( 0, 0, 0 );
+      plate.capCosRadius = real_c( -1 );
+
+      vec3D center( 0, 0, 0 );
+      for ( const auto& point : plate.polygon.outer() )
+      {
+         center += toUnitVector( point );
+      }
+
+      if ( center.norm() < real_c( 1e-12 ) )
+      {
+         return;
+      }
+      center.normalize();
+
+      real_t radius{ real_c( 0 ) };
+      for ( const auto& point : plate.polygon.outer() )
+      {
+         radius = std::max( radius, angleBetween( center, toUnitVector( point ) ) );
+      }
+
+      // The boundary is only guaranteed to stay inside the cap, if the cap is convex. Then the plate
+      // either lies inside the cap or contains the whole complement of the cap, which we can detect
+      // by checking the antipode of the centre.
+      if ( radius >= real_c( 0.5 ) * conversions::pi )
+      {
+         return;
+      }
+
+      const vec3D antipodeLonLat = conversions::cart2sph( -center );
+      if ( boost::geometry::within( spherical_point( antipodeLonLat[0], antipodeLonLat[1] ), plate.polygon ) )
+      {
+         return;
+      }
+
+      // small safety margin for points close to the plate boundary
+      plate.capCenter    = center;
+      plate.capCosRadius = std::cos( radius + real_c( 1e-6 ) );
+   }
+
+   /// convert a point given by longitude and latitude into a unit vector in cartesian coordinates
+   static vec3D toUnitVector( const spherical_point& point )
+   {
+      const real_t lon = real_c( boost::geometry::get< 0 >( point ) );
+      const real_t lat = real_c( boost::geometry::get< 1 >( point ) );
+      return conversions::sph2cart( { lon, lat } );
+   }
+
+   /// angle between two unit vectors in radians
+   static real_t angleBetween( const vec3D& a, const vec3D& b )
+   {
+      return std::acos( std::clamp( a.dot( b ), real_c( -1 ), real_c( 1 ) ) );
+   }
+
    /// name of datafile from which object obtained information
    std::string srcFile_;
 
@@ -20,6 +20,10 @@
 
 #pragma once
 
+#include <algorithm>
+#include <iterator>
+#include <map>
+
 #include "terraneo/dataimport/FileIO.hpp"
 #include "terraneo/helpers/conversions.hpp"
 #include "terraneo/plates/PlateNotFoundHandlers.hpp"
@@ -115,7 +119,52 @@ class PlateVelocityProvider
 
       WALBERLA_LOG_DETAIL_ON_ROOT( "Smoothing Factor: " << smoothingFactor );
       WALBERLA_LOG_DETAIL_ON_ROOT( "Plate ID: " << plateID << "\n" );
-      return computeCartesianVelocityVector( plateRotations_, plateID, age, pointLonLat, smoothingFactor );
+      return computeVelocity( plateID, age, pointLonLat, smoothingFactor );
+   }
+
+   /// Returns velocity vectors for a batch of points, e.g. all DoFs on the surface of the mantle
+   ///
+   /// Gives the same results as calling getPointVelocity() for each point, but the plates for
+   /// all points are located together (in parallel, if OpenMP is available). Calls prepareAge(),
+   /// so it must not be called concurrently with the other getters.
+   template < typename SmoothingStrategy, typename PlateNotFoundStrategy >
+   std::vector< vec3D > getPointVelocities( const std::vector< vec3D >& points,
+                                            const real_t                age,
+                                            SmoothingStrategy           computeSmoothing,
+                                            PlateNotFoundStrategy&&     errorHandler )
+   {
+      std::vector< vec3D > pointsLonLat;
+      pointsLonLat.reserve( points.size() );
+      for ( const auto& point : points )
+      {
+         pointsLonLat.push_back( terraneo::conversions::cart2sph( point ) );
+      }
+
+      const auto platesAndDistances = findPlatesAndDistances( age, plateTopologies_, pointsLonLat, idWhenNoPlateFound );
+
+      prepareAge( age );
+
+      std::vector< vec3D > velocities;
+      velocities.reserve( points.size() );
+      for ( uint_t k = 0; k < points.size(); ++k )
+      {
+         const auto& [plateFound, plateID, distance] = platesAndDistances[k];
+         if ( !plateFound )
+         {
+            velocities.push_back( errorHandler( points[k], age ) );
+            continue;
+         }
+
+         velocities.push_back( computeVelocity( plateID, age, pointsLonLat[k], computeSmoothing( distance ) ) );
+      }
+
+      return velocities;
+   }
+
+   /// Convenience version of getPointVelocities() with the same defaults as getPointVelocity()
+   std::vector< vec3D > getPointVelocities( const std::vector< vec3D >& points, const real_t age )
+   {
+      return getPointVelocities( points, age, LinearDistanceSmoother{ 0.015 }, DefaultPlateNotFoundHandler{} );
    }
 
    /// Returns velocity vector for a point determined from the velocity of the associated plate at given age stage
@@ -186,9 +235,8 @@ class PlateVelocityProvider
       WALBERLA_LOG_DETAIL_ON_ROOT( "Plate ID Floor: " << plateIDFloor );
       WALBERLA_LOG_DETAIL_ON_ROOT( "Plate ID Ceil: " << plateIDCeil << "\n" );
 
-      vec3D vecFloor =
-          computeCartesianVelocityVector( plateRotations_, plateIDFloor, ageFloor, pointLonLat, smoothingFactorFloor );
-      vec3D vecCeil = computeCartesianVelocityVector( plateRotations_, plateIDCeil, ageCeil, pointLonLat, smoothingFactorCeil );
+      vec3D vecFloor = computeVelocity( plateIDFloor, ageFloor, pointLonLat, smoothingFactorFloor );
+      vec3D vecCeil  = computeVelocity( plateIDCeil, ageCeil, pointLonLat, smoothingFactorCeil );
 
       // linear interpolation in time
       return vecFloor + interpolationFactor * ( vecCeil - vecFloor );
@@ -226,7 +274,7 @@ class PlateVelocityProvider
          // We do not apply averaging since all points that would be used for averaging are on the same plate.
          WALBERLA_LOG_DETAIL_ON_ROOT( "No averaging." );
          WALBERLA_LOG_DETAIL_ON_ROOT( "Plate ID: " << plateID << "\n" );
-         return computeCartesianVelocityVector( plateRotations_, plateID, age, pointLonLat, 1.0 );
+         return computeVelocity( plateID, age, pointLonLat, 1.0 );
       }
 
       const auto pointsAndWeights = pointWeightProvider.samplePointsAndWeightsLonLat( pointLonLat );
@@ -247,8 +295,7 @@ class PlateVelocityProvider
             // out the normal component. It would be better to average in the "lonlat-space" and then convert and return the
             // cartesian vector. On the other hand, averaging the plate velocities is already a somewhat arbitrary and physically
             // meaningless approximation in the first place, so this might just work.
-            avgVelCart +=
-                weight * computeCartesianVelocityVector( plateRotations_, avgPointPlateID, age, samplePointSphLonLat, 1.0 );
+            avgVelCart += weight * computeVelocity( avgPointPlateID, age, samplePointSphLonLat, 1.0 );
             weightSum += weight;
          }
       }
@@ -263,6 +310,42 @@ class PlateVelocityProvider
       return tangentComponent;
    }
 
+   /// Computes the Euler vectors of all plates for the given age up front
+   ///
+   /// Besides the age itself, this also prepares the two surrounding age stages used by
+   /// getPointVelocityLinearlyInterpolatedInTime(). See getEulerVector() for the rules on concurrent calls.
+   ///
+   /// Calling it is optional, without preparation the Euler vectors are recomputed for every point.
+   void prepareAge( const real_t age )
+   {
+      const auto& plateStages = plateTopologies_.getListOfPlateStages();
+
+      // the age itself is only required, if its age stage exists (otherwise only the interpolation in time works)
+      std::vector< real_t > ages;
+      if ( std::binary_search( plateStages.begin(), plateStages.end(), std::ceil( age ) ) )
+      {
+         ages.push_back( age );
+      }
+
+      auto iteratorLowerBound = std::lower_bound( plateStages.begin(), plateStages.end(), age );
+      if ( iteratorLowerBound != plateStages.end() )
+      {
+         ages.push_back( *iteratorLowerBound );
+      }
+      if ( iteratorLowerBound != plateStages.begin() )
+      {
+         ages.push_back( *std::prev( iteratorLowerBound ) );
+      }
+
+      for ( const real_t stageAge : ages )
+      {
+         cacheEulerVectors( stageAge, age, ages );
+      }
+   }
+
+   /// Number of ages for which Euler vectors are currently cached
+   uint_t getNumberOfCachedAges() const { return eulerVectorCache_.size(); }
+
    /// Query function to obtain a vector of plate stages available in the datafiles
    const std::vector< real_t >& getListOfPlateStages() const { return plateTopologies_.getListOfPlateStages(); }
 
@@ -273,8 +356,84 @@ class PlateVelocityProvider
    real_t getMaxAge() const { return plateTopologies_.getMaxAge(); }
 
  private:
+   /// Returns the velocity of a point on the given plate, reusing the Euler vector of the plate
+   vec3D computeVelocity( uint_t plateID, real_t age, const vec3D& pointLonLat, real_t smoothing ) const
+   {
+      vec3D wXYZ = getEulerVector( plateID, age );
+      return eulerVectorToVelocity( pointLonLat, wXYZ, smoothing );
+   }
+
+   /// Returns the Euler vector of a plate at the given age
+   ///
+   /// All velocity getters obtain the Euler vectors here, and this only reads the cache filled by prepareAge().
+   /// Hence the getters may be called from several threads at once (e.g. in the callbacks of interpolate()),
+   /// as long as prepareAge() is not called at the same time. Euler vectors of ages that were not prepared
+   /// are computed on the fly, but not stored.
+   vec3D getEulerVector( uint_t plateID, real_t age ) const
+   {
+      const auto cacheForAge = eulerVectorCache_.find( age );
+      if ( cacheForAge != eulerVectorCache_.end() )
+      {
+         const auto iter = cacheForAge->second.find( plateID );
+         if ( iter != cacheForAge->second.end() )
+         {
+            return iter->second;
+         }
+      }
+
+      return computeEulerVector( plateRotations_, int( plateID ), age );
+   }
+
+   /// Computes the Euler vectors of all plates of the age stage of the given age and stores them in the cache
+   ///
+   /// Evicts the ages farthest from referenceAge, if the cache is full, but none of the ages in keepAges.
+   void cacheEulerVectors( real_t age, real_t referenceAge, const std::vector< real_t >& keepAges )
+   {
+      if ( eulerVectorCache_.find( age ) != eulerVectorCache_.end() )
+      {
+         return;
+      }
+
+      while ( eulerVectorCache_.size() >= maxNumberOfCachedAges_ )
+      {
+         auto farthest = eulerVectorCache_.end();
+         for ( auto iter = eulerVectorCache_.begin(); iter != eulerVectorCache_.end(); ++iter )
+         {
+            if ( std::find( keepAges.begin(), keepAges.end(), iter->first ) != keepAges.end() )
+            {
+               continue;
+            }
+            if ( farthest == eulerVectorCache_.end() ||
+                 std::abs( iter->first - referenceAge ) > std::abs( farthest->first - referenceAge ) )
+            {
+               farthest = iter;
+            }
+         }
+         if ( farthest == eulerVectorCache_.end() )
+         {
+            break;
+         }
+         eulerVectorCache_.erase( farthest );
+      }
+
+      auto& cacheForAge = eulerVectorCache_[age];
+      for ( const auto& plate : plateTopologies_.getPlatesForStage( std::ceil( age ) ) )
+      {
+         if ( cacheForAge.find( plate.id ) == cacheForAge.end() )
+         {
+            cacheForAge.emplace( plate.id, computeEulerVector( plateRotations_, int( plate.id ), age ) );
+         }
+      }
+   }
+
    PlateStorage          plateTopologies_;
    PlateRotationProvider plateRotations_;
+
+   /// Euler vectors of the plates, stored per age and plate ID
+   std::map< real_t, std::map< uint_t, vec3D > > eulerVectorCache_;
+
+   /// Number of ages for which Euler vectors are kept in eulerVectorCache_
+   const uint_t maxNumberOfCachedAges_{ 6 };
 };
 
 } // namespace plates
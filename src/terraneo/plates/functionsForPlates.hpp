@@ -20,11 +20,14 @@
 
 #pragma once
 
+#include <algorithm>
 #include <limits>
+#include <vector>
 
 #include <boost/geometry.hpp>
 
 #include "terraneo/helpers/conversions.hpp"
+#include "terraneo/plates/PlateStorage.hpp"
 #include "terraneo/plates/functionsForGeometry.hpp"
 #include "terraneo/plates/functionsForRotations.hpp"
 #include "terraneo/plates/types.hpp"
@@ -32,64 +35,108 @@
 namespace terraneo {
 namespace plates {
 
-typedef boost::geometry::model::point<double, 2, boost::geometry::cs::spherical_equatorial<boost::geometry::degree>> spherical_point;
-typedef boost::geometry::model::polygon<spherical_point> polygon_on_sphere;
+/// Compute the distance of a point to the boundary of a plate on the unit sphere
+///
+/// The bounding caps of the boundary segments provide lower bounds for the distances to the
+/// segments, so that the exact distance only needs to be computed for few of them.
+inline real_t distanceToPlateBoundary( const PlateStorage::PlateInfo& plate, const spherical_point& pntSph, const vec3D& pntXYZ )
+{
+   const auto& segments = plate.segments;
+   if ( segments.empty() )
+   {
+      return std::numeric_limits< real_t >::max();
+   }
 
-/// Determine to which plate a point belongs
+   std::vector< real_t > lowerBounds( segments.size() );
+   uint_t                closest{ 0 };
+   for ( uint_t k = 0; k < segments.size(); ++k )
+   {
+      const real_t angle = std::acos( std::clamp( pntXYZ.dot( segments[k].midpoint ), real_c( -1 ), real_c( 1 ) ) );
+      lowerBounds[k]     = angle - segments[k].halfLength;
+      if ( lowerBounds[k] < lowerBounds[closest] )
+      {
+         closest = k;
+      }
+   }
+
+   real_t distance = boost::geometry::distance( segments[closest].segment, pntSph );
+   for ( uint_t k = 0; k < segments.size(); ++k )
+   {
+      if ( k != closest && lowerBounds[k] < distance )
+      {
+         distance = std::min< real_t >( distance, boost::geometry::distance( segments[k].segment, pntSph ) );
+      }
+   }
+
+   return distance;
+}
+
+/// Determine to which of the given plates a point belongs
 ///
 /// The function returns a bool to indicate whether any plate matched, the plate's ID and
 /// the distance from this plate's boundary
 inline std::tuple< bool, uint_t, real_t >
-    findPlateAndDistance( const real_t age, const PlateStorage& plateStore, const vec3D& point, uint_t idWhenNoPlateFound )
+    findPlateAndDistance( const PlateStorage::plateVec_t& plates, const vec3D& point, uint_t idWhenNoPlateFound )
 {
-   // query all plates for given age stage
-   auto& plates = plateStore.getPlatesForStage( std::ceil( age ) );
-
-   // be pessimistic
-   bool   plateFound{ false };
-   uint_t plateID{ idWhenNoPlateFound };
-   real_t distance{ std::numeric_limits< real_t >::max() };
-
-   // Create the point in the surface of a sphere from the library boost::geometry 
-   spherical_point pntSph(point[0], point[1]);
+   // Create the point in the surface of a sphere from the library boost::geometry
+   spherical_point pntSph( point[0], point[1] );
+   const vec3D     pntXYZ = terraneo::conversions::sph2cart( { point[0], point[1] } );
 
    //loop over the plates available
    for ( auto& currentPlate : plates )
    {
-      // create the polygon on the surface of a sphere and populate with the plate boundary coordinates
-      const Polygon& bdrPolygon = currentPlate.boundary;
-      polygon_on_sphere polygonOnSphere;
-      for ( int index = 0; index < bdrPolygon.size(); ++index )
+      // cheap check against the bounding cap of the plate
+      if ( pntXYZ.dot( currentPlate.capCenter ) < currentPlate.capCosRadius )
       {
-         boost::geometry::append(polygonOnSphere.outer(), spherical_point(bdrPolygon[index]( 0 ), bdrPolygon[index]( 1 )));
+         continue;
       }
-      // Correct the geometry
-      boost::geometry::correct(polygonOnSphere);
 
       // check if the point belongs to the polygon
-      if (boost::geometry::within(pntSph, polygonOnSphere))
+      if ( boost::geometry::within( pntSph, currentPlate.polygon ) )
       {
-         // calculate the distace from the polygon to the point
-         boost::geometry::for_each_segment(polygonOnSphere, [&distance, &pntSph](const auto& segment){
-            distance = std::min<real_t>(distance, boost::geometry::distance(segment, pntSph));
-         });
          // distance at the surface of the Earth
-         distance = distance * 6371.0; 
-         // plate is found 
-         plateFound = true;
-      }
-      else{
-         // ;
+         real_t distance = distanceToPlateBoundary( currentPlate, pntSph, pntXYZ ) * plates::constants::earthRadiusInKm;
+         return std::make_tuple( true, currentPlate.id, distance );
       }
+   }
 
-      // plate found then leave loop
-      if ( plateFound )
-      {
-         plateID = currentPlate.id;
-         break;
-      }
+   return std::make_tuple( false, idWhenNoPlateFound, std::numeric_limits< real_t >::max() );
+}
+
+/// Determine to which plate a point belongs
+///
+/// The function returns a bool to indicate whether any plate matched, the plate's ID and
+/// the distance from this plate's boundary
+inline std::tuple< bool, uint_t, real_t >
+    findPlateAndDistance( const real_t age, const PlateStorage& plateStore, const vec3D& point, uint_t idWhenNoPlateFound )
+{
+   // query all plates for given age stage
+   return findPlateAndDistance( plateStore.getPlatesForStage( std::ceil( age ) ), point, idWhenNoPlateFound );
+}
+
+/// Determine for a batch of points to which plates they belong
+///
+/// This is the batched version of findPlateAndDistance(), meant for e.g. all DoFs on the surface
+/// of the mantle. Points must be given as (longitude, latitude) in degrees, the queries are
+/// processed in parallel if OpenMP is available.
+inline std::vector< std::tuple< bool, uint_t, real_t > > findPlatesAndDistances( const real_t                age,
+                                                                                  const PlateStorage&         plateStore,
+                                                                                  const std::vector< vec3D >& points,
+                                                                                  uint_t idWhenNoPlateFound )
+{
+   const auto& plates = plateStore.getPlatesForStage( std::ceil( age ) );
+
+   std::vector< std::tuple< bool, uint_t, real_t > > result( points.size() );
+
+#ifdef HYTEG_BUILD_WITH_OPENMP
+#pragma omp parallel for default( shared )
+#endif
+   for ( int i = 0; i < walberla::int_c( points.size() ); i++ )
+   {
+      result[walberla::uint_c( i )] = findPlateAndDistance( plates, points[walberla::uint_c( i )], idWhenNoPlateFound );
    }
-   return std::make_tuple( plateFound, plateID, distance );
+
+   return result;
 }
 
 /// From the Euler vector compute the surface velocity in xyz
@@ -112,46 +159,28 @@ inline vec3D eulerVectorToVelocity( const vec3D& point, vec3D& wXYZ, const real_
    return v;
 }
 
-/// Get the velocity in given the plate id, create the reconstruction path, get
-/// the rotations and calculate the velocity
-inline vec3D computeCartesianVelocityVector( const PlateRotationProvider& rotData,
-                                             const int                    plateID,
-                                             const real_t                 age,
-                                             const vec3D&                 point,
-                                             const real_t                 smoothing )
+/// Get the Euler vector of a plate at a given age: create the reconstruction path,
+/// get the rotations and compute the stage pole
+///
+/// The Euler vector is the same for all points on a plate, so callers evaluating
+/// velocities for many points should compute it only once per plate and age.
+inline vec3D computeEulerVector( const PlateRotationProvider& rotData, const int plateID, const real_t age )
 {
    // age of the euler pole is defined by ((age1 + age2)/2)
    // This is valid when the velocities are calculated every 1 Myrs. 
    // Otherwise this needs to be changed to the desired time step
    // taking into conserdation the time resolution of the plate boundaries available.
-   std::array< real_t, 2 >     time{ age, age + 1 };
-   std::vector< RotationInfo > recTree;
-
-   std::vector< FiniteRotation >      FinRot;
-   const std::vector< RotationInfo >& rotations = rotData.getRotations();
+   std::array< real_t, 2 >       time{ age, age + 1 };
+   std::vector< FiniteRotation > FinRot;
 
    int pID = plateID;
 
    while ( pID != 0 )
    {
-      rotIter_t rangeBegin;
-      rotIter_t rangeEnd;
+      const auto [rangeBegin, rangeEnd] = rotData.getRotationsForPlate( uint_t( pID ) );
 
-      for ( rotIter_t it = rotations.begin(); it != rotations.end(); ++it )
-      {
-         if ( it->plateID == pID )
-         {
-            rangeBegin = it;
-            rangeEnd   = rangeBegin + 1;
-            while ( rangeEnd->plateID == pID )
-            {
-               ++rangeEnd;
-            }
-            // append to list of finite rotations
-            pID = terraneo::plates::determineSeriesOfFiniteRotations( rangeBegin, rangeEnd, time, FinRot );
-            break;
-         }
-      }
+      // append to list of finite rotations
+      pID = terraneo::plates::determineSeriesOfFiniteRotations( rangeBegin, rangeEnd, time, FinRot );
       // WALBERLA_LOG_DETAIL_ON_ROOT( "Looping ... (pID = " << pID << ")" );
    }
 
@@ -160,8 +189,18 @@ inline vec3D computeCartesianVelocityVector( const PlateRotationProvider& rotDat
    // compute Euler Vector
    vec3D lonlatang = terraneo::plates::stagePoleF( finNahs[0].lonLatAng, finNahs[1].lonLatAng );
    lonlatang[2]    = lonlatang[2] / ( finNahs[1].time - finNahs[0].time );
-   vec3D wXYZ      = terraneo::conversions::sph2cart( { lonlatang[0], lonlatang[1] }, lonlatang[2] );
+   return terraneo::conversions::sph2cart( { lonlatang[0], lonlatang[1] }, lonlatang[2] );
+}
 
+/// Get the velocity in given the plate id, create the reconstruction path, get
+/// the rotations and calculate the velocity
+inline vec3D computeCartesianVelocityVector( const PlateRotationProvider& rotData,
+                                             const int                    plateID,
+                                             const real_t                 age,
+                                             const vec3D&                 point,
+                                             const real_t                 smoothing )
+{
+   vec3D wXYZ = computeEulerVector( rotData, plateID, age );
    return eulerVectorToVelocity( point, wXYZ, smoothing );
 }
 
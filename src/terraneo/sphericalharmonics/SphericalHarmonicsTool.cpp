@@ -1,8 +1,13 @@
 
 #include "terraneo/sphericalharmonics/SphericalHarmonicsTool.hpp"
 
+#include <algorithm>
+#include <limits>
+
+#include "core/debug/CheckFunctions.h"
 #include "core/debug/Debug.h"
 #include "core/logging/Logging.h"
+#include "core/math/Constants.h"
 
 namespace terraneo {
 
@@ -13,8 +18,7 @@ using walberla::uint_t;
 
 SphericalHarmonicsTool::SphericalHarmonicsTool( uint_t lmax )
 {
-   initialized_ = false;
-   maxDegree_   = lmax;
+   maxDegree_ = lmax;
 
    plm_    = new real_t[( lmax + 1 ) * ( lmax + 2 ) / 2];
    dplm_   = new real_t[( lmax + 1 ) * ( lmax + 2 ) / 2];
@@ -27,6 +31,8 @@ SphericalHarmonicsTool::SphericalHarmonicsTool( uint_t lmax )
    plm0_.fac1 = new real_t[( lmax + 1 ) * ( lmax + 2 ) / 2 - 1];
    plm0_.fac2 = new real_t[( lmax + 1 ) * ( lmax + 2 ) / 2 - 1];
    plm0_.srt  = new real_t[2 * lmax + 2];
+
+   initialiseFactors();
 }
 
 SphericalHarmonicsTool::~SphericalHarmonicsTool()
@@ -43,6 +49,336 @@ SphericalHarmonicsTool::~SphericalHarmonicsTool()
    delete[] plm0_.srt;
 }
 
+// ===================
+//  initialiseFactors
+// ===================
+//
+// Set up square roots and recursion factors for plmbar() and dplmbar(). This is
+// done once for the maximal degree, so that plmbar() only reads member data.
+void SphericalHarmonicsTool::initialiseFactors()
+{
+   const uint_t lmax = maxDegree_;
+   uint_t       k, kstart;
+
+   for ( k = 1; k <= 2 * lmax + 2; k++ )
+   {
+      plm0_.srt[k - 1] = sqrt( real_c( k ) );
+   }
+
+   if ( lmax == 0 )
+   {
+      return;
+   }
+
+   // case for m > 0
+   kstart = 1;
+
+   for ( uint_t m = 1; m <= lmax; m++ )
+   {
+      // case for P(m,m)
+      kstart = kstart + m + 1;
+
+      if ( m != lmax )
+      {
+         // case for P(m+1,m)
+         k = kstart + m + 1;
+
+         // case for P(l,m) with l > m+1
+         if ( m < lmax - 1 )
+         {
+            for ( uint_t l = m + 2; l <= lmax; l++ )
+            {
+               k               = k + l;
+               plm0_.f1[k - 1] = ( plm0_.srt[2 * l] * plm0_.srt[2 * l - 2] ) / ( plm0_.srt[l + m - 1] * plm0_.srt[l - m - 1] );
+               plm0_.f2[k - 1] = ( plm0_.srt[2 * l] * plm0_.srt[l - m - 2] * plm0_.srt[l + m - 2] ) /
+                                 ( plm0_.srt[2 * l - 4] * plm0_.srt[l + m - 1] * plm0_.srt[l - m - 1] );
+            }
+         }
+      }
+   }
+
+   k = 3;
+
+   for ( uint_t l = 2; l <= lmax; l++ )
+   {
+      k = k + 1;
+      for ( uint_t m = 1; m <= l - 1; m++ )
+      {
+         k                 = k + 1;
+         plm0_.fac1[k - 1] = plm0_.srt[l - m - 1] * plm0_.srt[l + m];
+         plm0_.fac2[k - 1] = plm0_.srt[l + m - 1] * plm0_.srt[l - m];
+         if ( m == 1 )
+         {
+            plm0_.fac2[k - 1] = plm0_.fac2[k - 1] * plm0_.srt[1];
+         }
+      }
+      k = k + 1;
+   }
+}
+
+// ================
+//  sumOverDegrees
+// ================
+void SphericalHarmonicsTool::sumOverDegrees( const std::vector< real_t >& coeffs,
+                                             const std::vector< real_t >& plm,
+                                             uint_t                       lmax,
+                                             std::vector< real_t >&       cosSum,
+                                             std::vector< real_t >&       sinSum )
+{
+   cosSum.assign( lmax + 1, real_c( 0 ) );
+   sinSum.assign( lmax + 1, real_c( 0 ) );
+
+   uint_t a = 0;
+   for ( uint_t ll = 0; ll <= lmax; ll++ )
+   {
+      for ( uint_t mm = 0; mm <= ll; mm++ )
+      {
+         cosSum[mm] += plm[a] * coeffs[2 * a];
+         sinSum[mm] += plm[a] * coeffs[2 * a + 1];
+         a++;
+      }
+   }
+}
+
+// ===============
+//  sumOverOrders
+// ===============
+//
+// The values cos(m*phi) and sin(m*phi) are obtained from the addition theorems,
+// so only a single sine and cosine need to be evaluated per point.
+real_t SphericalHarmonicsTool::sumOverOrders( const std::vector< real_t >& cosSum,
+                                              const std::vector< real_t >& sinSum,
+                                              uint_t                       lmax,
+                                              real_t                       phi )
+{
+   const real_t cosPhi = cos( phi );
+   const real_t sinPhi = sin( phi );
+
+   real_t cosMPhi = real_c( 1 );
+   real_t sinMPhi = real_c( 0 );
+   real_t val     = cosSum[0];
+
+   for ( uint_t mm = 1; mm <= lmax; mm++ )
+   {
+      const real_t cosTmp = cosMPhi * cosPhi - sinMPhi * sinPhi;
+      sinMPhi             = sinMPhi * cosPhi + cosMPhi * sinPhi;
+      cosMPhi             = cosTmp;
+
+      val += cosMPhi * cosSum[mm] + sinMPhi * sinSum[mm];
+   }
+
+   return val;
+}
+
+// ==========
+//  evaluate
+// ==========
+//
+// Reentrant evaluation of a scalar function described by a vector of
+// spherical harmonics coefficients.
+real_t SphericalHarmonicsTool::evaluate( const std::vector< real_t >& coeffs, uint_t lmax, real_t x, real_t y, real_t z ) const
+{
+   WALBERLA_ASSERT_LESS_EQUAL( lmax, maxDegree_ );
+   WALBERLA_ASSERT_GREATER_EQUAL( coeffs.size(), numberOfCoefficients( lmax ) );
+
+   std::vector< real_t > plm( ( lmax + 1 ) * ( lmax + 2 ) / 2 );
+   std::vector< real_t > cosSum;
+   std::vector< real_t > sinSum;
+
+   const real_t r = sqrt( x * x + y * y + z * z );
+   plmbar( plm.data(), lmax, std::clamp( z / r, real_c( -1 ), real_c( 1 ) ) );
+   sumOverDegrees( coeffs, plm, lmax, cosSum, sinSum );
+
+   // poles are no problem, since c++-atan2 implements atan2(0,0)
+   return sumOverOrders( cosSum, sinSum, lmax, atan2( y, x ) );
+}
+
+// ==========
+//  evaluate
+// ==========
+//
+// Batched evaluation of a scalar function described by a vector of spherical
+// harmonics coefficients.
+void SphericalHarmonicsTool::evaluate( const std::vector< real_t >&         coeffs,
+                                       uint_t                               lmax,
+                                       const std::vector< hyteg::Point3D >& points,
+                                       std::vector< real_t >&               values ) const
+{
+   WALBERLA_CHECK_LESS_EQUAL( lmax, maxDegree_ );
+   WALBERLA_CHECK_GREATER_EQUAL( coeffs.size(), numberOfCoefficients( lmax ) );
+
+   values.resize( points.size() );
+
+   // sort points by co-latitude
+   std::vector< real_t > cosTheta( points.size() );
+   std::vector< uint_t > order( points.size() );
+   for ( uint_t idx = 0; idx < points.size(); ++idx )
+   {
+      cosTheta[idx] = std::clamp( points[idx][2] / points[idx].norm(), real_c( -1 ), real_c( 1 ) );
+      order[idx]    = idx;
+   }
+   std::sort( order.begin(), order.end(), [&cosTheta]( uint_t a, uint_t b ) { return cosTheta[a] < cosTheta[b]; } );
+
+   // Group points of equal co-latitude; the small tolerance accounts for round-off
+   // in the coordinates of points on the same parallel.
+   const real_t          tolerance = real_c( 100 ) * std::numeric_limits< real_t >::epsilon();
+   std::vector< uint_t > groupBegin;
+   for ( uint_t k = 0; k < order.size(); ++k )
+   {
+      if ( k == 0 || cosTheta[order[k]] - cosTheta[order[groupBegin.back()]] > tolerance )
+      {
+         groupBegin.push_back( k );
+      }
+   }
+   groupBegin.push_back( order.size() );
+
+#ifdef HYTEG_BUILD_WITH_OPENMP
+#pragma omp parallel for default( shared ) schedule( dynamic )
+#endif
+   for ( int group = 0; group < walberla::int_c( groupBegin.size() ) - 1; group++ )
+   {
+      const uint_t begin = groupBegin[walberla::uint_c( group )];
+      const uint_t end   = groupBegin[walberla::uint_c( group ) + 1];
+
+      std::vector< real_t > plm( ( lmax + 1 ) * ( lmax + 2 ) / 2 );
+      std::vector< real_t > cosSum;
+      std::vector< real_t > sinSum;
+
+      plmbar( plm.data(), lmax, cosTheta[order[begin]] );
+      sumOverDegrees( coeffs, plm, lmax, cosSum, sinSum );
+
+      for ( uint_t k = begin; k < end; ++k )
+      {
+         const auto& point = points[order[k]];
+         values[order[k]]  = sumOverOrders( cosSum, sinSum, lmax, atan2( point[1], point[0] ) );
+      }
+   }
+}
+
+// =========================
+//  gaussLegendreQuadrature
+// =========================
+//
+// Nodes are the roots of the Legendre polynomial of degree n, computed by
+// Newton's method starting from an asymptotic approximation.
+void SphericalHarmonicsTool::gaussLegendreQuadrature( uint_t n, std::vector< real_t >& nodes, std::vector< real_t >& weights )
+{
+   nodes.resize( n );
+   weights.resize( n );
+
+   for ( uint_t i = 0; i < ( n + 1 ) / 2; ++i )
+   {
+      real_t z  = cos( walberla::math::pi * ( real_c( i ) + real_c( 0.75 ) ) / ( real_c( n ) + real_c( 0.5 ) ) );
+      real_t dp = real_c( 0 );
+
+      for ( uint_t iter = 0; iter < 100; ++iter )
+      {
+         // evaluate Legendre polynomial of degree n and its derivative by the three-term recurrence
+         real_t p1 = real_c( 1 );
+         real_t p2 = real_c( 0 );
+         for ( uint_t j = 1; j <= n; ++j )
+         {
+            const real_t p3 = p2;
+            p2              = p1;
+            p1              = ( real_c( 2 * j - 1 ) * z * p2 - real_c( j - 1 ) * p3 ) / real_c( j );
+         }
+         dp = real_c( n ) * ( z * p1 - p2 ) / ( z * z - real_c( 1 ) );
+
+         const real_t zOld = z;
+         z                 = zOld - p1 / dp;
+         if ( std::abs( z - zOld ) <= real_c( 10 ) * std::numeric_limits< real_t >::epsilon() )
+         {
+            break;
+         }
+      }
+
+      nodes[i]           = -z;
+      nodes[n - 1 - i]   = z;
+      weights[i]         = real_c( 2 ) / ( ( real_c( 1 ) - z * z ) * dp * dp );
+      weights[n - 1 - i] = weights[i];
+   }
+}
+
+// ===============
+//  gridLongitude
+// ===============
+real_t SphericalHarmonicsTool::gridLongitude( uint_t lmax, uint_t j )
+{
+   return real_c( 2 ) * walberla::math::pi * real_c( j ) / real_c( numberOfGridMeridians( lmax ) );
+}
+
+// ===========================
+//  addParallelToCoefficients
+// ===========================
+void SphericalHarmonicsTool::addParallelToCoefficients( const std::vector< real_t >& values,
+                                                        real_t                       cosTheta,
+                                                        real_t                       weight,
+                                                        uint_t                       lmax,
+                                                        std::vector< real_t >&       coeffs ) const
+{
+   WALBERLA_CHECK_LESS_EQUAL( lmax, maxDegree_ );
+   WALBERLA_CHECK_EQUAL( values.size(), numberOfGridMeridians( lmax ) );
+
+   coeffs.resize( numberOfCoefficients( lmax ), real_c( 0 ) );
+
+   // discrete Fourier coefficients along the parallel
+   std::vector< real_t > cosSum( lmax + 1, real_c( 0 ) );
+   std::vector< real_t > sinSum( lmax + 1, real_c( 0 ) );
+   for ( uint_t j = 0; j < values.size(); ++j )
+   {
+      const real_t phi = gridLongitude( lmax, j );
+      for ( uint_t mm = 0; mm <= lmax; ++mm )
+      {
+         cosSum[mm] += values[j] * cos( real_c( mm ) * phi );
+         sinSum[mm] += values[j] * sin( real_c( mm ) * phi );
+      }
+   }
+
+   std::vector< real_t > plm( ( lmax + 1 ) * ( lmax + 2 ) / 2 );
+   plmbar( plm.data(), lmax, cosTheta );
+
+   // weights of the Gauss-Legendre and trapezoidal rule, and normalisation by 1/(4*pi)
+   const real_t factor = weight / real_c( 2 * values.size() );
+
+   uint_t a = 0;
+   for ( uint_t ll = 0; ll <= lmax; ll++ )
+   {
+      for ( uint_t mm = 0; mm <= ll; mm++ )
+      {
+         coeffs[2 * a] += factor * plm[a] * cosSum[mm];
+         coeffs[2 * a + 1] += factor * plm[a] * sinSum[mm];
+         a++;
+      }
+   }
+}
+
+// ==================
+//  forwardTransform
+// ==================
+std::vector< real_t >
+    SphericalHarmonicsTool::forwardTransform( const std::function< real_t( const hyteg::Point3D& ) >& f, uint_t lmax ) const
+{
+   std::vector< real_t > nodes;
+   std::vector< real_t > weights;
+   gaussLegendreQuadrature( numberOfGridParallels( lmax ), nodes, weights );
+
+   std::vector< real_t > coeffs( numberOfCoefficients( lmax ), real_c( 0 ) );
+   std::vector< real_t > values( numberOfGridMeridians( lmax ) );
+
+   for ( uint_t i = 0; i < nodes.size(); ++i )
+   {
+      const real_t sinTheta = sqrt( real_c( 1 ) - nodes[i] * nodes[i] );
+      for ( uint_t j = 0; j < values.size(); ++j )
+      {
+         const real_t phi = gridLongitude( lmax, j );
+         values[j]        = f( hyteg::Point3D( sinTheta * cos( phi ), sinTheta * sin( phi ), nodes[i] ) );
+      }
+      addParallelToCoefficients( values, nodes[i], weights[i], lmax, coeffs );
+   }
+
+   return coeffs;
+}
+
 // ================
 //  shconvert_eval
 // ================
@@ -225,7 +561,7 @@ real_t SphericalHarmonicsTool::shconvert_eval( real_t***** sphdata,
 // ========
 //  plmbar
 // ========
-void SphericalHarmonicsTool::plmbar( real_t* p, uint_t lmax, real_t z )
+void SphericalHarmonicsTool::plmbar( real_t* p, uint_t lmax, real_t z ) const
 {
    // local variables
    real_t fden, fnum, pm1, pm2, pmm, sintsq, plm;
@@ -236,70 +572,6 @@ void SphericalHarmonicsTool::plmbar( real_t* p, uint_t lmax, real_t z )
       WALBERLA_ABORT( "Parameter inconsistency in SphericalHarmonicsTool::plmbar!" );
    }
 
-   // ---------------------------------------
-   //  set up sqrt and factors on first pass
-   // ---------------------------------------
-   if ( !initialized_ )
-   {
-      for ( k = 1; k <= 2 * lmax + 2; k++ )
-      {
-         plm0_.srt[k - 1] = sqrt( real_c( k ) );
-      }
-
-      if ( lmax == 0 )
-      {
-         p[0] = 1.0;
-         return;
-      }
-
-      // case for m > 0
-      kstart = 1;
-
-      for ( uint_t m = 1; m <= lmax; m++ )
-      {
-         // case for P(m,m)
-         kstart = kstart + m + 1;
-
-         if ( m != lmax )
-         {
-            // case for P(m+1,m)
-            k = kstart + m + 1;
-
-            // case for P(l,m) with l > m+1
-            if ( m < lmax - 1 )
-            {
-               for ( uint_t l = m + 2; l <= lmax; l++ )
-               {
-                  k               = k + l;
-                  plm0_.f1[k - 1] = ( plm0_.srt[2 * l] * plm0_.srt[2 * l - 2] ) / ( plm0_.srt[l + m - 1] * plm0_.srt[l - m - 1] );
-                  plm0_.f2[k - 1] = ( plm0_.srt[2 * l] * plm0_.srt[l - m - 2] * plm0_.srt[l + m - 2] ) /
-                                    ( plm0_.srt[2 * l - 4] * plm0_.srt[l + m - 1] * plm0_.srt[l - m - 1] );
-               }
-            }
-         }
-      }
-
-      k = 3;
-
-      for ( uint_t l = 2; l <= lmax; l++ )
-      {
-         k = k + 1;
-         for ( uint_t m = 1; m <= l - 1; m++ )
-         {
-            k                 = k + 1;
-            plm0_.fac1[k - 1] = plm0_.srt[l - m - 1] * plm0_.srt[l + m];
-            plm0_.fac2[k - 1] = plm0_.srt[l + m - 1] * plm0_.srt[l - m];
-            if ( m == 1 )
-            {
-               plm0_.fac2[k - 1] = plm0_.fac2[k - 1] * plm0_.srt[1];
-            }
-         }
-         k = k + 1;
-      }
-
-      initialized_ = true;
-   }
-
    // --------------------------------
    //  start calculation of Plm, etc.
    // --------------------------------
@@ -1,8 +1,13 @@
 
 #pragma once
 
+#include <functional>
+#include <vector>
+
 #include "core/DataTypes.h"
 
+#include "hyteg/types/PointND.hpp"
+
 namespace terraneo {
 
 using walberla::real_t;
@@ -20,9 +25,6 @@ class SphericalHarmonicsTool
       real_t *f1, *f2, *fac1, *fac2, *srt;
    } plm0_;
 
-   //! Remember, if we have initialized plmbar
-   bool initialized_;
-
    //! Remember largest degree used in intialisation
    uint_t maxDegree_;
 
@@ -64,6 +66,29 @@ class SphericalHarmonicsTool
    /// \param   lmax    maximal degree of spherical harmonics
    void dplmbar( real_t* dplm, real_t* plm, uint_t lmax );
 
+   /// Set up square roots and recursion factors for plmbar() up to maxDegree_
+   void initialiseFactors();
+
+   /// Sum up the coefficients for each order weighted with the associated Legendre functions
+   ///
+   /// For a fixed co-latitude the expansion reduces to a trigonometric polynomial in the
+   /// longitude, whose coefficients are computed here
+   ///
+   /// \param   coeffs   spherical harmonics coefficients, see coefficientIndex()
+   /// \param   plm      values of \f$P_l^m\f$ for the co-latitude as computed by plmbar()
+   /// \param   lmax     maximal degree of spherical harmonics
+   /// \param   cosSum   coefficients of \f$\cos(m\phi)\f$ for m = 0, ..., lmax
+   /// \param   sinSum   coefficients of \f$\sin(m\phi)\f$ for m = 0, ..., lmax
+   static void sumOverDegrees( const std::vector< real_t >& coeffs,
+                               const std::vector< real_t >& plm,
+                               uint_t                       lmax,
+                               std::vector< real_t >&       cosSum,
+                               std::vector< real_t >&       sinSum );
+
+   /// Evaluate the trigonometric polynomial computed by sumOverDegrees() for given longitude
+   static real_t
+       sumOverOrders( const std::vector< real_t >& cosSum, const std::vector< real_t >& sinSum, uint_t lmax, real_t phi );
+
    /// Determine position of value of Legendre function in internal array
    uint_t getArrayIndex( uint_t deg, uint_t ord )
    {
@@ -87,6 +112,87 @@ class SphericalHarmonicsTool
    SphericalHarmonicsTool( uint_t lmax );
    ~SphericalHarmonicsTool();
 
+   SphericalHarmonicsTool( const SphericalHarmonicsTool& )            = delete;
+   SphericalHarmonicsTool& operator=( const SphericalHarmonicsTool& ) = delete;
+
+   //! Number of entries in a coefficient vector for expansions up to degree lmax
+   static uint_t numberOfCoefficients( uint_t lmax ) { return ( lmax + 1 ) * ( lmax + 2 ); }
+
+   //! Position of a coefficient in a coefficient vector
+   //!
+   //! Coefficient vectors store for each degree l and order 0 <= m <= l the coefficient
+   //! of the cosine (cs = 0) and of the sine (cs = 1) variant of \f$Y_l^m\f$. The ordering
+   //! of (l,m) is the same as for the values of the associated Legendre functions in plmbar().
+   static uint_t coefficientIndex( uint_t deg, uint_t ord, uint_t cs ) { return 2 * ( deg * ( deg + 1 ) / 2 + ord ) + cs; }
+
+   //! Evaluate scalar function described by a vector of spherical harmonics coefficients
+   //!
+   //! In contrast to shconvert_eval() this method does not use internal work arrays and can
+   //! be called concurrently, e.g. from callbacks of FE function interpolation with OpenMP.
+   //!
+   //!  \param  coeffs  coefficients up to degree lmax, see coefficientIndex()
+   //!  \param  lmax    largest spherical harmonics degree
+   //!  \param  x       x-coordinate of evaluation node
+   //!  \param  y       y-coordinate of evaluation node
+   //!  \param  z       z-coordinate of evaluation node
+   real_t evaluate( const std::vector< real_t >& coeffs, uint_t lmax, real_t x, real_t y, real_t z ) const;
+
+   //! Evaluate scalar function described by a vector of spherical harmonics coefficients at many points
+   //!
+   //! Intended for e.g. all DoFs on a radial shell. Points are grouped by co-latitude, so that the
+   //! associated Legendre functions and the sums over the degrees are computed only once per group.
+   //! For the remaining sum over the orders only one sine and cosine is needed per point. The groups
+   //! are processed in parallel, if OpenMP is available.
+   //!
+   //!  \param  coeffs  coefficients up to degree lmax, see coefficientIndex()
+   //!  \param  lmax    largest spherical harmonics degree
+   //!  \param  points  evaluation nodes (need not lie on the unit sphere)
+   //!  \param  values  [out] values at the evaluation nodes
+   void evaluate( const std::vector< real_t >&         coeffs,
+                  uint_t                               lmax,
+                  const std::vector< hyteg::Point3D >& points,
+                  std::vector< real_t >&               values ) const;
+
+   //! Compute nodes and weights of the Gauss-Legendre quadrature rule with n points on [-1,1]
+   static void gaussLegendreQuadrature( uint_t n, std::vector< real_t >& nodes, std::vector< real_t >& weights );
+
+   //! Number of parallels (co-latitudes) of the quadrature grid used for the forward transform
+   static uint_t numberOfGridParallels( uint_t lmax ) { return lmax + 1; }
+
+   //! Number of meridians (equidistant longitudes) of the quadrature grid used for the forward transform
+   static uint_t numberOfGridMeridians( uint_t lmax ) { return 2 * lmax + 2; }
+
+   //! Longitude of the j-th meridian of the quadrature grid
+   static real_t gridLongitude( uint_t lmax, uint_t j );
+
+   //! Add the contribution of one parallel of the quadrature grid to the spherical harmonics coefficients
+   //!
+   //! The forward transform uses a Gauss-Legendre rule in \f$\cos(\theta)\f$ and the trapezoidal
+   //! rule in longitude. This grid integrates products of two spherical harmonics up to degree lmax
+   //! exactly, so that band-limited functions are recovered up to round-off. Summing the contributions
+   //! of all parallels gives the coefficients
+   //! \f[
+   //!    c_l^m = \frac{1}{4\pi} \int_S f(\theta,\phi) \, Y_l^m(\theta,\phi)
+   //! \f]
+   //! The parallels are independent, so that they can be distributed over processes or threads.
+   //!
+   //!  \param  values     function values on the meridians of the parallel, see gridLongitude()
+   //!  \param  cosTheta   Gauss-Legendre node of the parallel
+   //!  \param  weight     Gauss-Legendre weight of the parallel
+   //!  \param  lmax       largest spherical harmonics degree
+   //!  \param  coeffs     [in,out] coefficients, see coefficientIndex()
+   void addParallelToCoefficients( const std::vector< real_t >& values,
+                                   real_t                       cosTheta,
+                                   real_t                       weight,
+                                   uint_t                       lmax,
+                                   std::vector< real_t >&       coeffs ) const;
+
+   //! Compute spherical harmonics coefficients up to degree lmax of a function on the unit sphere
+   //!
+   //! Serial convenience version of the forward transform, evaluating the function on all nodes
+   //! of the quadrature grid, see addParallelToCoefficients().
+   std::vector< real_t > forwardTransform( const std::function< real_t( const hyteg::Point3D& ) >& f, uint_t lmax ) const;
+
    //! Evaluate scalar function described by spherical harmonics coefficients
    //! at given cartesian coordinates. The point has to be on the sphere.
    //!
@@ -202,7 +308,10 @@ class SphericalHarmonicsTool
    /// \param    p        array for storing values \f$ P_l^m(z) \f$
    /// \param    lmax     we evaluate all functions up to degree lmax
    /// \param    z        argument to \f$ P_l^m \f$, i.e. z = cos(colatitude)
-   void plmbar( real_t* p, uint_t lmax, real_t z );
+   ///
+   /// All factors of the recursion are set up in the constructor, so this method can be
+   /// called concurrently with different arrays p.
+   void plmbar( real_t* p, uint_t lmax, real_t z ) const;
 
    //! Compute derivatives of associated Legendre functions
 
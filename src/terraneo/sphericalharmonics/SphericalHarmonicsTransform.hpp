@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2026 Nils Kohl, Marcus Mohr.
+ *
+ * This file is part of HyTeG
+ * (see https://i10git.cs.fau.de/hyteg/hyteg).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "core/DataTypes.h"
+#include "core/debug/CheckFunctions.h"
+#include "core/mpi/MPIManager.h"
+#include "core/mpi/Reduce.h"
+
+#include "hyteg/types/PointND.hpp"
+
+#include "terraneo/sphericalharmonics/SphericalHarmonicsTool.hpp"
+
+namespace terraneo {
+
+/// \brief Computes the spherical harmonics coefficients of a scalar FE function on a radial shell.
+///
+/// The function is evaluated on the quadrature grid of the forward transform (see
+/// SphericalHarmonicsTool::addParallelToCoefficients()) scaled to the given radius. The parallels of the grid are
+/// distributed round-robin over the processes, the FE function is evaluated with evaluateBatchGlobal(), and the
+/// contributions of all processes are summed up in a single reduction.
+///
+/// Must be called collectively. The coefficients are returned on all processes.
+///
+/// \param sphTool  tool set up for at least degree lmax
+/// \param f        scalar P1 or P2 function
+/// \param level    refinement level of f
+/// \param radius   radius of the shell
+/// \param lmax     largest degree of the expansion
+/// \return coefficients ordered as described in SphericalHarmonicsTool::coefficientIndex()
+template < typename FunctionType >
+std::vector< real_t > computeSphericalHarmonicsCoefficients( const SphericalHarmonicsTool& sphTool,
+                                                             const FunctionType&           f,
+                                                             uint_t                        level,
+                                                             real_t                        radius,
+                                                             uint_t                        lmax )
+{
+   const uint_t rank         = walberla::uint_c( walberla::mpi::MPIManager::instance()->rank() );
+   const uint_t numProcesses = walberla::uint_c( walberla::mpi::MPIManager::instance()->numProcesses() );
+
+   std::vector< real_t > nodes;
+   std::vector< real_t > weights;
+   SphericalHarmonicsTool::gaussLegendreQuadrature( SphericalHarmonicsTool::numberOfGridParallels( lmax ), nodes, weights );
+
+   const uint_t numMeridians = SphericalHarmonicsTool::numberOfGridMeridians( lmax );
+
+   // the parallels this process takes care of
+   std::vector< uint_t > localParallels;
+   for ( uint_t i = rank; i < nodes.size(); i += numProcesses )
+   {
+      localParallels.push_back( i );
+   }
+
+   std::vector< hyteg::Point3D > points;
+   points.reserve( localParallels.size() * numMeridians );
+   for ( auto i : localParallels )
+   {
+      const real_t sinTheta = std::sqrt( walberla::real_c( 1 ) - nodes[i] * nodes[i] );
+      for ( uint_t j = 0; j < numMeridians; ++j )
+      {
+         const real_t phi = SphericalHarmonicsTool::gridLongitude( lmax, j );
+         points.emplace_back( radius * sinTheta * std::cos( phi ), radius * sinTheta * std::sin( phi ), radius * nodes[i] );
+      }
+   }
+
+   std::vector< real_t > values( points.size() );
+   const auto            found = f.evaluateBatchGlobal( points, level, values );
+   for ( uint_t k = 0; k < found.size(); ++k )
+   {
+      WALBERLA_CHECK( found[k], "Could not evaluate function at point " << points[k] << " of the quadrature grid." );
+   }
+
+   std::vector< real_t > coeffs( SphericalHarmonicsTool::numberOfCoefficients( lmax ), walberla::real_c( 0 ) );
+   std::vector< real_t > valuesOnParallel( numMeridians );
+   for ( uint_t p = 0; p < localParallels.size(); ++p )
+   {
+      const auto first = values.begin() + std::ptrdiff_t( p * numMeridians );
+      std::copy( first, first + std::ptrdiff_t( numMeridians ), valuesOnParallel.begin() );
+      sphTool.addParallelToCoefficients( valuesOnParallel, nodes[localParallels[p]], weights[localParallels[p]], lmax, coeffs );
+   }
+
+   walberla::mpi::allReduceInplace( coeffs, walberla::mpi::SUM );
+
+   return coeffs;
+}
+
+} // namespace terraneo
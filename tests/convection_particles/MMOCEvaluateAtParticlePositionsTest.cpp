@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2026 Nils Kohl, Marcus Mohr.
+ *
+ * This file is part of HyTeG
+ * (see https://i10git.cs.fau.de/hyteg/hyteg).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Compares the batched evaluation of functions at the particle positions (evaluateAtParticlePositions()) with the
+// evaluation particle by particle (evaluateAtParticlePosition()). The particles are spread over all local macro-cells
+// and many micro-cells. Some groups of particles share a micro-cell, and some particles are outside the domain. Those
+// are either set to zero or projected back into the domain.
+
+#include "core/Environment.h"
+#include "core/debug/CheckFunctions.h"
+#include "core/math/Random.h"
+
+#include "hyteg/communication/Syncing.hpp"
+#include "hyteg/geometry/IcosahedralShellMap.hpp"
+#include "hyteg/mesh/MeshInfo.hpp"
+#include "hyteg/primitivestorage/PrimitiveStorage.hpp"
+#include "hyteg/primitivestorage/SetupPrimitiveStorage.hpp"
+
+#include "coupling_hyteg_convection_particles/MMOCTransport.hpp"
+
+using walberla::real_c;
+using walberla::real_t;
+using walberla::uint_c;
+using walberla::uint_t;
+
+using namespace hyteg;
+
+/// shift of the particles that are placed outside of the domain, projecting them back removes it again
+const Point3D outsideShift( 10, 0, 0 );
+
+/// random point in the simplex spanned by the passed vertices
+template < uint_t NumVertices >
+Point3D randomPointInSimplex( const std::array< Point3D, NumVertices >& vertices )
+{
+   std::array< real_t, NumVertices > weights;
+   real_t                            sum = 0;
+   for ( auto& w : weights )
+   {
+      w = walberla::math::realRandom( real_c( 0.05 ), real_c( 1 ) );
+      sum += w;
+   }
+
+   Point3D p;
+   for ( uint_t i = 0; i < NumVertices; ++i )
+   {
+      p += weights[i] / sum * vertices[i];
+   }
+   return p;
+}
+
+void addParticle( walberla::convection_particles::data::ParticleStorage& particleStorage,
+                  const Primitive&                                       primitive,
+                  const Point3D&                                         computationalCoords,
+                  bool                                                   outsideDomain )
+{
+   Point3D physicalCoords;
+   primitive.getGeometryMap()->evalF( computationalCoords, physicalCoords );
+
+   auto particleIt = particleStorage.create();
+   particleIt->setOwner( walberla::mpi::MPIManager::instance()->rank() );
+   particleIt->setContainingPrimitive( primitive.getID() );
+   if ( outsideDomain )
+   {
+      particleIt->setPosition( toVec3( physicalCoords + outsideShift ) );
+      particleIt->setOutsideDomain( 1 );
+   }
+   else
+   {
+      particleIt->setPosition( toVec3( physicalCoords ) );
+      particleIt->setOutsideDomain( 0 );
+   }
+}
+
+/// Creates particles at random positions in all local macro-faces (2D) or macro-cells (3D). In 3D, additional groups of
+/// particles are placed in the same micro-cell.
+void createParticles( const PrimitiveStorage&                                storage,
+                      uint_t                                                 level,
+                      walberla::convection_particles::data::ParticleStorage& particleStorage )
+{
+   const uint_t numRandomParticles = 40;
+   const uint_t numMicroCells      = 5;
+   const uint_t numPerMicroCell    = 4;
+   const uint_t numOutside         = 5;
+
+   if ( storage.hasGlobalCells() )
+   {
+      for ( const auto& it : storage.getCells() )
+      {
+         const Cell& cell = *it.second;
+
+         for ( uint_t k = 0; k < numRandomParticles; ++k )
+         {
+            addParticle( particleStorage, cell, randomPointInSimplex( cell.getCoordinates() ), false );
+         }
+
+         for ( uint_t k = 0; k < numMicroCells; ++k )
+         {
+            const auto microVertices =
+                vertexdof::macrocell::detail::findLocalMicroCell( level, cell, randomPointInSimplex( cell.getCoordinates() ) );
+            std::array< Point3D, 4 > microCellCoords;
+            for ( uint_t v = 0; v < 4; ++v )
+            {
+               microCellCoords[v] = vertexdof::macrocell::coordinateFromIndex( level, cell, microVertices[v] );
+            }
+            for ( uint_t j = 0; j < numPerMicroCell; ++j )
+            {
+               addParticle( particleStorage, cell, randomPointInSimplex( microCellCoords ), false );
+            }
+         }
+
+         for ( uint_t k = 0; k < numOutside; ++k )
+         {
+            addParticle( particleStorage, cell, randomPointInSimplex( cell.getCoordinates() ), true );
+         }
+      }
+   }
+   else
+   {
+      for ( const auto& it : storage.getFaces() )
+      {
+         const Face& face = *it.second;
+
+         for ( uint_t k = 0; k < numRandomParticles; ++k )
+         {
+            addParticle( particleStorage, face, randomPointInSimplex( face.getCoordinates() ), false );
+         }
+         for ( uint_t k = 0; k < numOutside; ++k )
+         {
+            addParticle( particleStorage, face, randomPointInSimplex( face.getCoordinates() ), true );
+         }
+      }
+   }
+}
+
+template < typename FunctionType >
+void testEvaluation( const std::shared_ptr< PrimitiveStorage >& storage, uint_t level )
+{
+   const std::vector< std::function< real_t( const Point3D& ) > > expressions = {
+       []( const Point3D& x ) { return real_c( 1 ) + x[0] - real_c( 2 ) * x[1] + real_c( 3 ) * x[2]; },
+       []( const Point3D& x ) { return std::sin( real_c( 4 ) * x[0] ) * std::cos( real_c( 3 ) * x[1] ) + x[2] * x[2]; },
+       []( const Point3D& x ) { return std::exp( x[0] * x[1] ) - x[2]; } };
+
+   std::vector< FunctionType > functions;
+   for ( uint_t i = 0; i < expressions.size(); ++i )
+   {
+      functions.emplace_back( "f" + std::to_string( i ), storage, level, level );
+      functions.back().interpolate( expressions[i], level );
+      communication::syncFunctionBetweenPrimitives( functions.back(), level );
+   }
+
+   walberla::convection_particles::data::ParticleStorage particleStorage( 1 );
+   createParticles( *storage, level, particleStorage );
+
+   const std::function< void( const Point3D&, Point3D& ) > projectBack = []( const Point3D& position, Point3D& projected ) {
+      projected = position - outsideShift;
+   };
+
+   const real_t tolerance = std::is_same_v< real_t, double > ? real_c( 1e-12 ) : real_c( 1e-5 );
+
+   for ( const bool setOutsideToZero : { true, false } )
+   {
+      const auto handleOutside = setOutsideToZero ? HandleOutsideDomainMethod::DO_NOTHING :
+                                                    HandleOutsideDomainMethod::PROJECT_POINTS_BACK;
+
+      std::vector< real_t > results;
+      evaluateAtParticlePositions(
+          *storage, functions, particleStorage, level, results, setOutsideToZero, false, handleOutside, projectBack );
+      WALBERLA_CHECK_EQUAL( results.size(), particleStorage.size() * functions.size() );
+
+      std::vector< real_t > particleResults( functions.size() );
+      for ( uint_t p = 0; p < particleStorage.size(); ++p )
+      {
+         const auto particle = particleStorage[p];
+         evaluateAtParticlePosition(
+             *storage, functions, particle, level, particleResults, setOutsideToZero, false, handleOutside, projectBack );
+
+         for ( uint_t i = 0; i < functions.size(); ++i )
+         {
+            const real_t batched = results[p * functions.size() + i];
+            WALBERLA_CHECK_LESS_EQUAL( std::abs( batched - particleResults[i] ),
+                                       tolerance * std::max( real_c( 1 ), std::abs( particleResults[i] ) ),
+                                       "Batched and particle-wise evaluation differ for function "
+                                           << i << " at particle " << p << " (outside domain: " << particle.getOutsideDomain()
+                                           << ")" );
+            if ( setOutsideToZero && particle.getOutsideDomain() == 1 )
+            {
+               WALBERLA_CHECK_EQUAL( batched, real_c( 0 ) );
+            }
+         }
+      }
+   }
+}
+
+int main( int argc, char* argv[] )
+{
+   walberla::debug::enterTestMode();
+   walberla::Environment walberlaEnv( argc, argv );
+   walberla::MPIManager::instance()->useWorldComm();
+   walberla::math::seedRandomGenerator( 42 + uint_c( walberla::mpi::MPIManager::instance()->rank() ) );
+
+   {
+      WALBERLA_LOG_INFO_ON_ROOT( "2D, rectangle" );
+      MeshInfo meshInfo = MeshInfo::meshRectangle( Point2D( 0, 0 ), Point2D( 1, 1 ), MeshInfo::CRISSCROSS, 2, 2 );
+      SetupPrimitiveStorage setupStorage( meshInfo, uint_c( walberla::mpi::MPIManager::instance()->numProcesses() ) );
+      auto                  storage = std::make_shared< PrimitiveStorage >( setupStorage );
+      testEvaluation< P1Function< real_t > >( storage, 3 );
+      testEvaluation< P2Function< real_t > >( storage, 3 );
+   }
+
+   {
+      WALBERLA_LOG_INFO_ON_ROOT( "3D, cube" );
+      MeshInfo meshInfo = MeshInfo::meshSymmetricCuboid( Point3D( 0, 0, 0 ), Point3D( 1, 1, 1 ), 1, 1, 1 );
+      SetupPrimitiveStorage setupStorage( meshInfo, uint_c( walberla::mpi::MPIManager::instance()->numProcesses() ) );
+      auto                  storage = std::make_shared< PrimitiveStorage >( setupStorage );
+      testEvaluation< P1Function< real_t > >( storage, 3 );
+      testEvaluation< P2Function< real_t > >( storage, 3 );
+   }
+
+   {
+      WALBERLA_LOG_INFO_ON_ROOT( "3D, spherical shell with blending" );
+      MeshInfo              meshInfo = MeshInfo::meshSphericalShell( 3, 2, real_c( 1 ), real_c( 2 ) );
+      SetupPrimitiveStorage setupStorage( meshInfo, uint_c( walberla::mpi::MPIManager::instance()->numProcesses() ) );
+      IcosahedralShellMap::setMap( setupStorage );
+      auto storage = std::make_shared< PrimitiveStorage >( setupStorage );
+      testEvaluation< P1Function< real_t > >( storage, 2 );
+      testEvaluation< P2Function< real_t > >( storage, 2 );
+   }
+
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2026 Nils Kohl, Marcus Mohr.
+ *
+ * This file is part of HyTeG
+ * (see https://i10git.cs.fau.de/hyteg/hyteg).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Compares the batched evaluation of P1 and P2 functions with the point-wise evaluate() and checks that
+// evaluateBatchGlobal() finds all points, regardless of the process that owns them. With best guess, the values of
+// points inside the domain must not depend on the partitioning.
+
+#include "core/Environment.h"
+#include "core/math/Random.h"
+
+#include "hyteg/communication/Syncing.hpp"
+#include "hyteg/p1functionspace/P1Function.hpp"
+#include "hyteg/p2functionspace/P2Function.hpp"
+#include "hyteg/primitivestorage/SetupPrimitiveStorage.hpp"
+
+using walberla::real_c;
+using walberla::real_t;
+using walberla::uint_c;
+using walberla::uint_t;
+
+using namespace hyteg;
+
+template < typename FunctionType >
+void testBatchEvaluation( const std::shared_ptr< PrimitiveStorage >&       storage,
+                          uint_t                                           level,
+                          const std::function< real_t( const Point3D& ) >& testFunc,
+                          const std::function< Point3D() >&                randomPoint,
+                          real_t                                           tolerance )
+{
+   FunctionType u( "u", storage, level, level );
+   u.interpolate( testFunc, level );
+   communication::syncFunctionBetweenPrimitives( u, level );
+
+   // different points and a different number of points on each process
+   const uint_t numPoints = 200 + 50 * uint_c( walberla::mpi::MPIManager::instance()->rank() );
+
+   std::vector< Point3D > points( numPoints );
+   for ( auto& p : points )
+   {
+      p = randomPoint();
+   }
+
+   // local batch evaluation must agree with the point-wise evaluation
+   std::vector< real_t > values( numPoints );
+   auto                  found = u.evaluateBatch( points, level, values );
+   WALBERLA_CHECK_EQUAL( found.size(), numPoints );
+
+   for ( uint_t i = 0; i < numPoints; ++i )
+   {
+      real_t     value;
+      const bool foundSingle = u.evaluate( points[i], level, value );
+      WALBERLA_CHECK_EQUAL( bool( found[i] ), foundSingle );
+      if ( foundSingle )
+      {
+         WALBERLA_CHECK_FLOAT_EQUAL( values[i], value );
+      }
+   }
+
+   // global batch evaluation must find all points
+   std::vector< real_t > globalValues( numPoints );
+   auto                  globalFound = u.evaluateBatchGlobal( points, level, globalValues );
+
+   for ( uint_t i = 0; i < numPoints; ++i )
+   {
+      WALBERLA_CHECK( globalFound[i], "Point " << points[i] << " was not found." );
+      WALBERLA_CHECK_LESS( std::abs( globalValues[i] - testFunc( points[i] ) ), tolerance, "Wrong value at " << points[i] );
+   }
+
+   // With best guess, the points inside the domain must still be evaluated in the element that contains them, no matter
+   // on which process they are passed. A function that is not represented exactly reveals evaluations in a neighboring
+   // element, since these extrapolate a different polynomial.
+   FunctionType w( "w", storage, level, level );
+   w.interpolate(
+       []( const Point3D& x ) { return std::sin( real_c( 5 ) * x[0] ) * std::cos( real_c( 3 ) * x[1] ) + std::exp( x[2] ); },
+       level );
+   communication::syncFunctionBetweenPrimitives( w, level );
+
+   std::vector< real_t > exactValues( numPoints );
+   std::vector< real_t > bestGuessValues( numPoints );
+   auto exactFound     = w.evaluateBatchGlobal( points, level, exactValues );
+   auto bestGuessFound = w.evaluateBatchGlobal( points, level, bestGuessValues, real_c( 1e-05 ), real_c( 0 ), true );
+
+   for ( uint_t i = 0; i < numPoints; ++i )
+   {
+      WALBERLA_CHECK( exactFound[i], "Point " << points[i] << " was not found." );
+      WALBERLA_CHECK( bestGuessFound[i], "Point " << points[i] << " was not found with best guess." );
+      WALBERLA_CHECK_FLOAT_EQUAL( bestGuessValues[i], exactValues[i], "Best guess changed the value at " << points[i] );
+   }
+
+   // points slightly outside of the domain (farther away than the search radius, but within the safety margin of the
+   // bounding boxes of the macro-primitives) are only found with best guess, and then in the same primitive as by the
+   // local best guess
+   std::vector< Point3D > outsidePoints( 10 );
+   for ( auto& p : outsidePoints )
+   {
+      p    = randomPoint();
+      p[0] = real_c( 1 ) + real_c( 1e-03 );
+   }
+
+   std::vector< real_t > outsideValues( outsidePoints.size() );
+   auto                  outsideFound = w.evaluateBatchGlobal( outsidePoints, level, outsideValues );
+   for ( uint_t i = 0; i < outsidePoints.size(); ++i )
+   {
+      WALBERLA_CHECK( !outsideFound[i], "Point " << outsidePoints[i] << " outside of the domain was found." );
+   }
+
+   std::vector< real_t > localOutsideValues( outsidePoints.size() );
+   auto localOutsideFound = w.evaluateBatch( outsidePoints, level, localOutsideValues, real_c( 1e-05 ), real_c( 0 ), true );
+   outsideFound = w.evaluateBatchGlobal( outsidePoints, level, outsideValues, real_c( 1e-05 ), real_c( 0 ), true );
+   for ( uint_t i = 0; i < outsidePoints.size(); ++i )
+   {
+      WALBERLA_CHECK_EQUAL( bool( outsideFound[i] ), bool( localOutsideFound[i] ) );
+      if ( walberla::mpi::MPIManager::instance()->numProcesses() == 1 )
+      {
+         WALBERLA_CHECK( outsideFound[i], "Point " << outsidePoints[i] << " outside of the domain not found with best guess." );
+      }
+      if ( outsideFound[i] )
+      {
+         WALBERLA_CHECK_FLOAT_EQUAL( outsideValues[i], localOutsideValues[i] );
+      }
+   }
+
+   // points far away from the domain are not found, not even with best guess
+   for ( auto& p : outsidePoints )
+   {
+      p[0] += real_c( 2 );
+   }
+
+   outsideFound = w.evaluateBatchGlobal( outsidePoints, level, outsideValues, real_c( 1e-05 ), real_c( 0 ), true );
+   for ( uint_t i = 0; i < outsidePoints.size(); ++i )
+   {
+      WALBERLA_CHECK( !outsideFound[i], "Point " << outsidePoints[i] << " far away from the domain was found." );
+   }
+}
+
+int main( int argc, char** argv )
+{
+   walberla::debug::enterTestMode();
+   walberla::mpi::Environment MPIenv( argc, argv );
+   walberla::MPIManager::instance()->useWorldComm();
+
+   walberla::math::seedRandomGenerator( 42 + uint_c( walberla::mpi::MPIManager::instance()->rank() ) );
+
+   const real_t tolerance = std::is_same_v< real_t, double > ? real_c( 1e-10 ) : real_c( 1e-4 );
+
+   // 2D, unit square, functions that are represented exactly
+   {
+      MeshInfo meshInfo = MeshInfo::meshRectangle( Point2D( 0, 0 ), Point2D( 1, 1 ), MeshInfo::CRISSCROSS, 4, 4 );
+      SetupPrimitiveStorage setupStorage( meshInfo, uint_c( walberla::mpi::MPIManager::instance()->numProcesses() ) );
+      auto                  storage = std::make_shared< PrimitiveStorage >( setupStorage );
+
+      auto randomPoint = []() {
+         return Point3D( walberla::math::realRandom( real_c( 0 ), real_c( 1 ) ),
+                         walberla::math::realRandom( real_c( 0 ), real_c( 1 ) ),
+                         real_c( 0 ) );
+      };
+
+      WALBERLA_LOG_INFO_ON_ROOT( "2D, P1" );
+      testBatchEvaluation< P1Function< real_t > >(
+          storage, 3, []( const Point3D& x ) { return real_c( 1 ) + real_c( 2 ) * x[0] - real_c( 3 ) * x[1]; }, randomPoint, tolerance );
+
+      WALBERLA_LOG_INFO_ON_ROOT( "2D, P2" );
+      testBatchEvaluation< P2Function< real_t > >(
+          storage,
+          3,
+          []( const Point3D& x ) { return real_c( 1 ) + x[0] * x[0] + real_c( 2 ) * x[0] * x[1] - x[1]; },
+          randomPoint,
+          tolerance );
+   }
+
+   // 3D, cube
+   {
+      MeshInfo meshInfo = MeshInfo::meshSymmetricCuboid( Point3D( 0, 0, 0 ), Point3D( 1, 1, 1 ), 1, 1, 1 );
+      SetupPrimitiveStorage setupStorage( meshInfo, uint_c( walberla::mpi::MPIManager::instance()->numProcesses() ) );
+      auto                  storage = std::make_shared< PrimitiveStorage >( setupStorage );
+
+      auto randomPoint = []() {
+         return Point3D( walberla::math::realRandom( real_c( 0 ), real_c( 1 ) ),
+                         walberla::math::realRandom( real_c( 0 ), real_c( 1 ) ),
+                         walberla::math::realRandom( real_c( 0 ), real_c( 1 ) ) );
+      };
+
+      WALBERLA_LOG_INFO_ON_ROOT( "3D, P1" );
+      testBatchEvaluation< P1Function< real_t > >(
+          storage, 2, []( const Point3D& x ) { return x[0] - x[1] + real_c( 4 ) * x[2]; }, randomPoint, tolerance );
+
+      WALBERLA_LOG_INFO_ON_ROOT( "3D, P2" );
+      testBatchEvaluation< P2Function< real_t > >(
+          storage, 2, []( const Point3D& x ) { return x[0] * x[2] - x[1] * x[1] + x[2]; }, randomPoint, tolerance );
+   }
+
+   return EXIT_SUCCESS;
+}
@@ -74,17 +74,6 @@ void smooth( OperatorType& oper,
   oper.smooth_gs( u, rhs, level, Inner );
 }
 
-void smooth( P2ElementwiseLaplaceOperator& oper,
-             P2Function< real_t >& u, 
-             P2Function< real_t >& rhs, 
-             uint_t level ) {
-  WALBERLA_UNUSED( oper  );
-  WALBERLA_UNUSED( u     );
-  WALBERLA_UNUSED( rhs   );
-  WALBERLA_UNUSED( level );
-  WALBERLA_ABORT( "Elementwise operator does not offer Gauss-Seidel smoothing!" );
-}
-
 
 template<typename OperatorTypeMass, typename OperatorTypeLaplace >
 void testSmoother( SmootherType type,
@@ -201,6 +190,7 @@ int main( int argc, char** argv )
 
    WALBERLA_LOG_INFO_ON_ROOT( "Running tests with (P2ElementwiseMassOperator, P2ElementwiseLaplaceOperator)" );
    testSmoother<P2ElementwiseMassOperator, P2ElementwiseLaplaceOperator>( JACOBI, rhsStrong, poly, storage, level );
+   testSmoother<P2ElementwiseMassOperator, P2ElementwiseLaplaceOperator>( GAUSS_SEIDEL, rhsStrong, poly, storage, level );
 
    return EXIT_SUCCESS;
 }
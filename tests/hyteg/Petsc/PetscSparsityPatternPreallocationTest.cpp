@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2026 Nils Kohl, Marcus Mohr.
+ *
+ * This file is part of HyTeG
+ * (see https://i10git.cs.fau.de/hyteg/hyteg).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Assembles operators with and without the preallocation from the sparsity pattern and checks that the matrices are
+// identical and that no additional memory had to be allocated during the insertion of the values. The scalar P1 and P2
+// operators (elementwise and stencil-based) use the pattern built from the micro-element DoF indices, the Stokes
+// operator the pattern recorded by an additional assembly.
+
+#include "core/Environment.h"
+#include "core/logging/Logging.h"
+
+#include "hyteg/elementwiseoperators/P1ElementwiseOperator.hpp"
+#include "hyteg/elementwiseoperators/P2ElementwiseOperator.hpp"
+#include "hyteg/mesh/MeshInfo.hpp"
+#include "hyteg/petsc/PETScManager.hpp"
+#include "hyteg/petsc/PETScSparseMatrix.hpp"
+#include "hyteg/primitivestorage/PrimitiveStorage.hpp"
+#include "hyteg/primitivestorage/SetupPrimitiveStorage.hpp"
+#include "hyteg/primitivestorage/loadbalancing/SimpleBalancer.hpp"
+
+#include "constant_stencil_operator/P1ConstantOperator.hpp"
+#include "constant_stencil_operator/P2ConstantOperator.hpp"
+#include "mixed_operator/P2P1TaylorHoodStokesOperator.hpp"
+
+#ifndef HYTEG_BUILD_WITH_PETSC
+#error "This test only works with PETSc enabled. Please enable it via -DHYTEG_BUILD_WITH_PETSC=ON"
+#endif
+
+using walberla::real_t;
+using walberla::uint_c;
+using walberla::uint_t;
+
+using namespace hyteg;
+
+template < typename OperatorType >
+void testPreallocation( const std::string& meshFile, uint_t level )
+{
+   WALBERLA_LOG_INFO_ON_ROOT( "* " << meshFile << ", level " << level );
+
+   MeshInfo              meshInfo = MeshInfo::fromGmshFile( meshFile );
+   SetupPrimitiveStorage setupStorage( meshInfo, uint_c( walberla::mpi::MPIManager::instance()->numProcesses() ) );
+   setupStorage.setMeshBoundaryFlagsOnBoundary( 1, 0, true );
+   // distribute the primitives such that many couplings cross process boundaries
+   loadbalancing::roundRobin( setupStorage );
+   auto storage = std::make_shared< PrimitiveStorage >( setupStorage );
+
+   OperatorType op( storage, level, level );
+
+   typename PETScSparseMatrix< OperatorType >::template FunctionTypeSrc< idx_t > numerator(
+       "numerator", storage, level, level );
+   numerator.enumerate( level );
+
+   PETScSparseMatrix< OperatorType > matDefault( "default" );
+   matDefault.createMatrixFromOperator( op, level, numerator );
+
+   PETScSparseMatrix< OperatorType > matPattern( "pattern" );
+   matPattern.setPreallocationFromSparsityPattern( true );
+   matPattern.createMatrixFromOperator( op, level, numerator );
+
+   PetscBool equal;
+   MatEqual( matDefault.get(), matPattern.get(), &equal );
+   WALBERLA_CHECK( equal == PETSC_TRUE, "Matrices assembled with and without the sparsity pattern differ." );
+
+   MatInfo info;
+   MatGetInfo( matPattern.get(), MAT_GLOBAL_SUM, &info );
+   WALBERLA_CHECK_EQUAL(
+       info.mallocs, PetscLogDouble( 0 ), "Mallocs during the insertion despite preallocation from the sparsity pattern." );
+}
+
+int main( int argc, char* argv[] )
+{
+   walberla::debug::enterTestMode();
+   walberla::Environment walberlaEnv( argc, argv );
+   walberla::MPIManager::instance()->useWorldComm();
+   PETScManager petscManager( &argc, &argv );
+
+   const std::string mesh2D = prependHyTeGMeshDir( "2D/quad_8el.msh" );
+   const std::string mesh3D = prependHyTeGMeshDir( "3D/cube_24el.msh" );
+
+   testPreallocation< P1ElementwiseLaplaceOperator >( mesh2D, 3 );
+   testPreallocation< P2ElementwiseLaplaceOperator >( mesh2D, 3 );
+   testPreallocation< P1ConstantLaplaceOperator >( mesh2D, 3 );
+   testPreallocation< P2ConstantLaplaceOperator >( mesh2D, 3 );
+   testPreallocation< P2P1TaylorHoodStokesOperator >( mesh2D, 3 );
+   testPreallocation< P1ElementwiseLaplaceOperator >( mesh3D, 2 );
+   testPreallocation< P2ElementwiseLaplaceOperator >( mesh3D, 2 );
+   testPreallocation< P1ConstantLaplaceOperator >( mesh3D, 2 );
+   testPreallocation< P2ConstantLaplaceOperator >( mesh3D, 2 );
+   testPreallocation< P2P1TaylorHoodStokesOperator >( mesh3D, 2 );
+
+   return EXIT_SUCCESS;
+}
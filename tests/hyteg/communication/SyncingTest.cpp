@@ -153,12 +153,12 @@ auto getPrimitiveExtrema( const std::shared_ptr< PrimitiveStorage >& storage, ui
    for ( const auto& it : storage->getVertices() )
    {
       const Vertex& vertex = *it.second;
-      for ( const auto& value : vertex.getData( vFunc.getVertexDataID() )->getVector( level ) )
+      for ( const auto& value : vertex.getData( vFunc.getVertexDataID() )->getSpan( level ) )
       {
          minVertex = value < minVertex ? value : minVertex;
          maxVertex = value > maxVertex ? value : maxVertex;
       }
-      for ( const auto& value : vertex.getData( eFunc.getVertexDataID() )->getVector( level ) )
+      for ( const auto& value : vertex.getData( eFunc.getVertexDataID() )->getSpan( level ) )
       {
          minVertex = value < minVertex ? value : minVertex;
          maxVertex = value > maxVertex ? value : maxVertex;
@@ -168,12 +168,12 @@ auto getPrimitiveExtrema( const std::shared_ptr< PrimitiveStorage >& storage, ui
    for ( const auto& it : storage->getEdges() )
    {
       const Edge& edge = *it.second;
-      for ( const auto& value : edge.getData( vFunc.getEdgeDataID() )->getVector( level ) )
+      for ( const auto& value : edge.getData( vFunc.getEdgeDataID() )->getSpan( level ) )
       {
          minEdge = value < minEdge ? value : minEdge;
          maxEdge = value > maxEdge ? value : maxEdge;
       }
-      for ( const auto& value : edge.getData( eFunc.getEdgeDataID() )->getVector( level ) )
+      for ( const auto& value : edge.getData( eFunc.getEdgeDataID() )->getSpan( level ) )
       {
          minEdge = value < minEdge ? value : minEdge;
          maxEdge = value > maxEdge ? value : maxEdge;
@@ -183,12 +183,12 @@ auto getPrimitiveExtrema( const std::shared_ptr< PrimitiveStorage >& storage, ui
    for ( const auto& it : storage->getFaces() )
    {
       const Face& face = *it.second;
-      for ( const auto& value : face.getData( vFunc.getFaceDataID() )->getVector( level ) )
+      for ( const auto& value : face.getData( vFunc.getFaceDataID() )->getSpan( level ) )
       {
          minFace = value < minFace ? value : minFace;
          maxFace = value > maxFace ? value : maxFace;
       }
-      for ( const auto& value : face.getData( eFunc.getFaceDataID() )->getVector( level ) )
+      for ( const auto& value : face.getData( eFunc.getFaceDataID() )->getSpan( level ) )
       {
          minFace = value < minFace ? value : minFace;
          maxFace = value > maxFace ? value : maxFace;
@@ -96,7 +96,8 @@ auto exportCheckpointContinuous( const std::string&                         file
                                  const uint_t                               minLevel,
                                  const uint_t                               maxLevel,
                                  const uint_t                               nSteps,
-                                 bool                                       verbose = false )
+                                 bool                                       asynchronous = false,
+                                 bool                                       verbose      = false )
 {
    WALBERLA_UNUSED( verbose );
 
@@ -110,6 +111,7 @@ auto exportCheckpointContinuous( const std::string&                         file
    func_t< value_t > feFunc( funcName, storage, minLevel, maxLevel );
 
    AdiosCheckpointExporter checkpointer( "" );
+   checkpointer.setAsynchronousWrite( asynchronous );
 
    checkpointer.registerFunction( feFunc, minLevel, maxLevel );
 
@@ -261,7 +263,8 @@ void runTestWithIdenticalCommunicator( const std::string& filePath,
                                        const uint_t       maxLevel,
                                        bool               verbose          = false,
                                        bool               testContinuous   = false,
-                                       const uint_t       nStepsContinuous = 0U )
+                                       const uint_t       nStepsContinuous = 0U,
+                                       bool               asynchronous     = false )
 {
    bool exportFuncs = false;
 
@@ -275,6 +278,7 @@ void runTestWithIdenticalCommunicator( const std::string& filePath,
       WALBERLA_LOG_INFO_ON_ROOT( " - filePath ........... '" << filePath << "'" );
       WALBERLA_LOG_INFO_ON_ROOT( " - fileName ........... '" << fileName << "'" );
       WALBERLA_LOG_INFO_ON_ROOT( " - testContinuous ..... '" << std::boolalpha << testContinuous << "'" );
+      WALBERLA_LOG_INFO_ON_ROOT( " - asynchronous ....... '" << std::boolalpha << asynchronous << "'" );
       WALBERLA_LOG_INFO_ON_ROOT( "--------------------------------------------------------------" );
    }
 
@@ -399,7 +403,7 @@ void runTestWithIdenticalCommunicator( const std::string& filePath,
          WALBERLA_LOG_INFO_ON_ROOT( " * exporting checkpoint continuous" );
       }
       auto funcListTimePairExported = exportCheckpointContinuous< func_t, value_t >(
-          filePath, "Continuous" + fileName, storage, minLevel, maxLevel, nStepsContinuous );
+          filePath, "Continuous" + fileName, storage, minLevel, maxLevel, nStepsContinuous, asynchronous );
 
       if ( verbose )
       {
@@ -573,6 +577,12 @@ int main( int argc, char* argv[] )
       runTestWithIdenticalCommunicator< P2VectorFunction, real_t >(
           filePath, fileName, meshFile3D, minLevel, maxLevel, true, true, 4U );
 
+      // the function is modified directly after each checkpoint, while the data is still written in the background
+      runTestWithIdenticalCommunicator< P2Function, real_t >(
+          filePath, fileName, meshFile3D, minLevel, maxLevel, true, true, 4U, true );
+      runTestWithIdenticalCommunicator< P2VectorFunction, real_t >(
+          filePath, fileName, meshFile2D, minLevel, maxLevel, true, true, 4U, true );
+
       // We currently would need to import the two component functions separately; Better than having specialised code here,
       // alter AdiosCheckpoint[Ex|Im]porter
       // runTestWithIdenticalCommunicator< P2P1TaylorHoodFunction, real_t >( filePath, fileName, meshFile3D, minLevel, maxLevel, true );
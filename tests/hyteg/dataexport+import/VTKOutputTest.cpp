@@ -20,6 +20,11 @@
 
 #include "hyteg/dataexport/VTKOutput/VTKOutput.hpp"
 
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+
 #include "core/DataTypes.h"
 #include "core/Environment.h"
 #include "core/debug/CheckFunctions.h"
@@ -50,6 +55,177 @@
 
 namespace hyteg {
 
+/// A DataArray element of a VTU piece
+struct VTKDataArray
+{
+   std::string                type;
+   std::string                name;
+   uint64_t                   offset;
+   std::vector< std::string > asciiValues;
+};
+
+static std::string readFileContent( const std::string& filePath )
+{
+   std::ifstream file( filePath, std::ifstream::binary );
+   WALBERLA_CHECK( !!file, "Cannot open " << filePath );
+   std::stringstream content;
+   content << file.rdbuf();
+   return content.str();
+}
+
+/// Returns the value of the attribute of the XML element (or an empty string)
+static std::string xmlAttribute( const std::string& element, const std::string& attribute )
+{
+   const std::string key = " " + attribute + "=\"";
+   const size_t      pos = element.find( key );
+   if ( pos == std::string::npos )
+   {
+      return "";
+   }
+   const size_t begin = pos + key.length();
+   return element.substr( begin, element.find( '"', begin ) - begin );
+}
+
+/// Returns the DataArray elements of an XML fragment, the values are only read for the ASCII format
+static std::vector< VTKDataArray > parseDataArrays( const std::string& xml )
+{
+   std::vector< VTKDataArray > dataArrays;
+   for ( size_t pos = xml.find( "<DataArray" ); pos != std::string::npos; pos = xml.find( "<DataArray", pos + 1 ) )
+   {
+      const size_t      end     = xml.find( '>', pos );
+      const std::string element = xml.substr( pos, end - pos );
+
+      VTKDataArray dataArray;
+      dataArray.type   = xmlAttribute( element, "type" );
+      dataArray.name   = xmlAttribute( element, "Name" );
+      dataArray.offset = 0;
+      if ( xmlAttribute( element, "format" ) == "appended" )
+      {
+         dataArray.offset = std::stoull( xmlAttribute( element, "offset" ) );
+      }
+      else if ( xmlAttribute( element, "format" ) == "ascii" )
+      {
+         std::istringstream values( xml.substr( end + 1, xml.find( "</DataArray>", end ) - end - 1 ) );
+         std::string        value;
+         while ( values >> value )
+         {
+            dataArray.asciiValues.push_back( value );
+         }
+      }
+      dataArrays.push_back( dataArray );
+   }
+   return dataArrays;
+}
+
+static uint64_t vtkTypeSize( const std::string& type )
+{
+   const std::map< std::string, uint64_t > sizes = { { "Int8", 1 },
+                                                     { "UInt8", 1 },
+                                                     { "Int16", 2 },
+                                                     { "UInt16", 2 },
+                                                     { "Int32", 4 },
+                                                     { "UInt32", 4 },
+                                                     { "Int64", 8 },
+                                                     { "UInt64", 8 },
+                                                     { "Float32", 4 },
+                                                     { "Float64", 8 } };
+   WALBERLA_CHECK_GREATER( sizes.count( type ), 0, "Unknown VTK type " << type );
+   return sizes.at( type );
+}
+
+template < typename T >
+static double decodeValue( const char* data )
+{
+   T value;
+   std::memcpy( &value, data, sizeof( T ) );
+   return static_cast< double >( value );
+}
+
+static double decodeVTKValue( const std::string& type, const char* data )
+{
+   // clang-format off
+   if ( type == "Int8" )    return decodeValue< int8_t >( data );
+   if ( type == "UInt8" )   return decodeValue< uint8_t >( data );
+   if ( type == "Int16" )   return decodeValue< int16_t >( data );
+   if ( type == "UInt16" )  return decodeValue< uint16_t >( data );
+   if ( type == "Int32" )   return decodeValue< int32_t >( data );
+   if ( type == "UInt32" )  return decodeValue< uint32_t >( data );
+   if ( type == "Int64" )   return decodeValue< int64_t >( data );
+   if ( type == "UInt64" )  return decodeValue< uint64_t >( data );
+   if ( type == "Float32" ) return decodeValue< float >( data );
+   // clang-format on
+   return decodeValue< double >( data );
+}
+
+/// Reads back the piece of this process written in the RAW format and compares it with the same piece written in the
+/// ASCII format. Checks that the offsets in the XML part and the UInt64 headers in the AppendedData section are
+/// consistent with the array sizes, and that the decoded values agree with the ASCII values.
+static void checkRawAgainstASCII( const std::string& rawFilePath, const std::string& asciiFilePath )
+{
+   const uint_t rank = uint_c( walberla::mpi::MPIManager::instance()->rank() );
+
+   const std::string raw   = readFileContent( rawFilePath );
+   const std::string ascii = readFileContent( asciiFilePath );
+
+   WALBERLA_CHECK_UNEQUAL( raw.find( R"(header_type="UInt64")" ), std::string::npos );
+
+   // the ASCII file contains the pieces of all processes in the order of the ranks
+   size_t asciiPieceBegin = ascii.find( "<Piece" );
+   for ( uint_t piece = 0; piece < rank; ++piece )
+   {
+      asciiPieceBegin = ascii.find( "<Piece", asciiPieceBegin + 1 );
+   }
+   WALBERLA_CHECK_UNEQUAL( asciiPieceBegin, std::string::npos );
+   const std::string asciiPiece = ascii.substr( asciiPieceBegin, ascii.find( "</Piece>", asciiPieceBegin ) - asciiPieceBegin );
+
+   const size_t      appendedBegin = raw.find( "<AppendedData" );
+   const std::string rawXML        = raw.substr( 0, appendedBegin );
+   const size_t      rawPieceBegin = rawXML.find( "<Piece" );
+   const std::string rawPiece      = rawXML.substr( rawPieceBegin, rawXML.find( '>', rawPieceBegin ) - rawPieceBegin );
+   WALBERLA_CHECK_EQUAL( xmlAttribute( rawPiece, "NumberOfPoints" ), xmlAttribute( asciiPiece, "NumberOfPoints" ) );
+   WALBERLA_CHECK_EQUAL( xmlAttribute( rawPiece, "NumberOfCells" ), xmlAttribute( asciiPiece, "NumberOfCells" ) );
+
+   // the raw data starts behind the underscore and ends before the closing tag
+   const size_t dataBegin = raw.find( '_', appendedBegin ) + 1;
+   const size_t dataEnd   = raw.rfind( "\n</AppendedData>" );
+   const char*  data      = raw.data() + dataBegin;
+
+   const auto rawArrays   = parseDataArrays( rawXML );
+   const auto asciiArrays = parseDataArrays( asciiPiece );
+   WALBERLA_CHECK_EQUAL( rawArrays.size(), asciiArrays.size() );
+
+   // the points come first, three coordinates per point
+   const uint64_t numberOfPoints = std::stoull( xmlAttribute( rawPiece, "NumberOfPoints" ) );
+   WALBERLA_CHECK_EQUAL( asciiArrays[0].asciiValues.size(), 3 * numberOfPoints );
+
+   uint64_t expectedOffset = 0;
+   for ( uint_t k = 0; k < rawArrays.size(); ++k )
+   {
+      WALBERLA_CHECK_EQUAL( rawArrays[k].type, asciiArrays[k].type );
+      WALBERLA_CHECK_EQUAL( rawArrays[k].name, asciiArrays[k].name );
+      WALBERLA_CHECK_EQUAL( rawArrays[k].offset, expectedOffset, "Offset of data array " << k );
+
+      uint64_t numBytes;
+      std::memcpy( &numBytes, data + rawArrays[k].offset, sizeof( uint64_t ) );
+      const uint64_t typeSize = vtkTypeSize( rawArrays[k].type );
+      WALBERLA_CHECK_EQUAL( numBytes, asciiArrays[k].asciiValues.size() * typeSize, "Header of data array " << k );
+
+      const char* values = data + rawArrays[k].offset + sizeof( uint64_t );
+      for ( uint_t i = 0; i < asciiArrays[k].asciiValues.size(); ++i )
+      {
+         const double rawValue   = decodeVTKValue( rawArrays[k].type, values + i * typeSize );
+         const double asciiValue = std::stod( asciiArrays[k].asciiValues[i] );
+         // ASCII output uses the default precision of six digits
+         WALBERLA_CHECK_LESS_EQUAL( std::abs( rawValue - asciiValue ),
+                                    1e-5 * std::max( 1.0, std::abs( asciiValue ) ),
+                                    "Value " << i << " of data array " << k << " (" << rawArrays[k].name << ")" );
+      }
+
+      expectedOffset += sizeof( uint64_t ) + numBytes;
+   }
+   WALBERLA_CHECK_EQUAL( dataBegin + expectedOffset, dataEnd );
+}
+
 static void exportFunctions2D( uint_t level )
 {
    uint_t minLevel = level;
@@ -291,6 +467,65 @@ static void exportFunctions3D( uint_t level )
       vtkOutputP2.add( p2VectorFunc );
       vtkOutputP2.write( maxLevel );
 
+      // one file per process plus .pvtu index
+      fName = "VTKOutputTest3D-P2-RAW";
+      WALBERLA_LOG_INFO_ON_ROOT( "Exporting to '" << fPath << "/" << fName << "'" );
+      VTKOutput vtkOutputP2Raw( fPath, fName, storage );
+      vtkOutputP2Raw.setParameter( "vtkDataFormat", "RAW" );
+      vtkOutputP2Raw.add( p2ScalarFunc1 );
+      vtkOutputP2Raw.add( p2VectorFunc );
+      vtkOutputP2Raw.write( maxLevel );
+
+      fName = "VTKOutputTest3D-P0-RAW";
+      WALBERLA_LOG_INFO_ON_ROOT( "Exporting to '" << fPath << "/" << fName << "'" );
+      VTKOutput vtkOutputP0Raw( fPath, fName, storageDG );
+      vtkOutputP0Raw.setVTKDataFormat( vtk::DataFormat::RAW );
+      vtkOutputP0Raw.add( p0ScalarFunc1 );
+      vtkOutputP0Raw.add( p0ScalarFunc2 );
+      vtkOutputP0Raw.write( maxLevel );
+
+      // read back the RAW pieces and compare them to the same output in ASCII format
+      for ( const std::string& fNameRaw : { std::string( "VTKOutputTest3D-P2-RAW" ), std::string( "VTKOutputTest3D-P0-RAW" ) } )
+      {
+         const bool        isP2       = fNameRaw == "VTKOutputTest3D-P2-RAW";
+         const std::string fNameASCII = fNameRaw + "-ASCII";
+         VTKOutput         vtkOutputASCII( fPath, fNameASCII, isP2 ? storage : storageDG );
+         vtkOutputASCII.setVTKDataFormat( vtk::DataFormat::ASCII );
+         if ( isP2 )
+         {
+            vtkOutputASCII.add( p2ScalarFunc1 );
+            vtkOutputASCII.add( p2VectorFunc );
+         }
+         else
+         {
+            vtkOutputASCII.add( p0ScalarFunc1 );
+            vtkOutputASCII.add( p0ScalarFunc2 );
+         }
+         vtkOutputASCII.write( maxLevel );
+         WALBERLA_MPI_BARRIER();
+
+         const std::string extension = walberla::format( "_%s_level%u_ts0", isP2 ? "P2" : "P0", maxLevel );
+         const std::string rawFile   = walberla::format( "%s/%s%s_rank%d.vtu",
+                                                       fPath.c_str(),
+                                                       fNameRaw.c_str(),
+                                                       extension.c_str(),
+                                                       walberla::mpi::MPIManager::instance()->rank() );
+         const std::string asciiFile = walberla::format( "%s/%s%s.vtu", fPath.c_str(), fNameASCII.c_str(), extension.c_str() );
+         WALBERLA_LOG_INFO_ON_ROOT( "Reading back '" << fPath << "/" << fNameRaw << extension << "'" );
+         checkRawAgainstASCII( rawFile, asciiFile );
+      }
+
+#ifdef HYTEG_BUILD_WITH_ZLIB
+      fName = "VTKOutputTest3D-P2-RAW-ZLIB";
+      WALBERLA_LOG_INFO_ON_ROOT( "Exporting to '" << fPath << "/" << fName << "'" );
+      VTKOutput vtkOutputP2RawZlib( fPath, fName, storage );
+      vtkOutputP2RawZlib.setVTKDataFormat( vtk::DataFormat::RAW );
+      vtkOutputP2RawZlib.setParameter( "vtkCompression", "ZLIB" );
+      vtkOutputP2RawZlib.add( p2ScalarFunc1 );
+      vtkOutputP2RawZlib.add( p2VectorFunc );
+      vtkOutputP2RawZlib.write( maxLevel );
+#endif
+
       fName = "VTKOutputTest3D-DG1";
       WALBERLA_LOG_INFO_ON_ROOT( "Exporting to '" << fPath << "/" << fName << "'" );
       VTKOutput vtkOutputDG1( fPath, fName, storageDG );
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2026 Nils Kohl, Marcus Mohr.
+ *
+ * This file is part of HyTeG
+ * (see https://i10git.cs.fau.de/hyteg/hyteg).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Compares operators whose coefficient is given by a P1 or P2 function with the same operators using a callback.
+//
+// The coefficients are chosen such that they are represented exactly by the functions and the meshes are not blended,
+// so that the local interpolation must reproduce the callback values at all quadrature points.
+
+#include "core/Environment.h"
+#include "core/debug/CheckFunctions.h"
+
+#include "hyteg/communication/Syncing.hpp"
+#include "hyteg/elementwiseoperators/P2ElementwiseOperator.hpp"
+#include "hyteg/elementwiseoperators/P2ElementwiseVariableViscousOperator.hpp"
+#include "hyteg/forms/form_hyteg_manual/FunctionCoefficient.hpp"
+#include "hyteg/p1functionspace/P1Function.hpp"
+#include "hyteg/p2functionspace/P2Function.hpp"
+#include "hyteg/primitivestorage/SetupPrimitiveStorage.hpp"
+
+using walberla::real_c;
+using walberla::real_t;
+using walberla::uint_c;
+using walberla::uint_t;
+
+using namespace hyteg;
+
+using Coefficient = std::function< real_t( const Point3D& ) >;
+
+template < typename FunctionType >
+real_t relativeDifference( const FunctionType& reference, const FunctionType& other, uint_t level, DoFType flag )
+{
+   FunctionType difference( "difference", reference.getStorage(), level, level );
+   difference.assign( { real_c( 1 ), real_c( -1 ) }, { other, reference }, level, flag );
+   return std::sqrt( difference.dotGlobal( difference, level, flag ) / reference.dotGlobal( reference, level, flag ) );
+}
+
+template < typename CoefficientFunctionType, typename FunctionCoefficient >
+void testDivKGrad( const std::shared_ptr< PrimitiveStorage >& storage,
+                   uint_t                                     level,
+                   const Coefficient&                         k,
+                   const std::string&                         name,
+                   real_t                                     tolerance )
+{
+   CoefficientFunctionType kFunction( "k", storage, level, level );
+   kFunction.interpolate( k, level, All );
+   communication::syncFunctionBetweenPrimitives( kFunction, level );
+
+   const forms::P2Form_divKGradVar< FunctionCoefficient >        functionForm( ( FunctionCoefficient( kFunction ) ) );
+   const forms::P2Form_divKGradVar< forms::CallbackCoefficient > callbackForm( ( forms::CallbackCoefficient( k ) ) );
+
+   P2ElementwiseDivKGradVarOperator< FunctionCoefficient >        functionOperator( storage, level, level, functionForm );
+   P2ElementwiseDivKGradVarOperator< forms::CallbackCoefficient > callbackOperator( storage, level, level, callbackForm );
+
+   P2Function< real_t > u( "u", storage, level, level );
+   P2Function< real_t > dstFunction( "dstFunction", storage, level, level );
+   P2Function< real_t > dstCallback( "dstCallback", storage, level, level );
+
+   u.interpolate( []( const Point3D& x ) { return std::sin( real_c( 3 ) * x[0] ) * x[1] + x[2]; }, level, All );
+
+   functionOperator.apply( u, dstFunction, level, Inner | NeumannBoundary );
+   callbackOperator.apply( u, dstCallback, level, Inner | NeumannBoundary );
+
+   const real_t errorApply = relativeDifference( dstCallback, dstFunction, level, Inner | NeumannBoundary );
+   WALBERLA_LOG_INFO_ON_ROOT( name << ", apply, relative difference: " << errorApply );
+   WALBERLA_CHECK_LESS( errorApply, tolerance );
+
+   functionOperator.computeInverseDiagonalOperatorValues();
+   callbackOperator.computeInverseDiagonalOperatorValues();
+
+   const real_t errorDiagonal = relativeDifference( *callbackOperator.getInverseDiagonalValues(),
+                                                    *functionOperator.getInverseDiagonalValues(),
+                                                    level,
+                                                    Inner | NeumannBoundary );
+   WALBERLA_LOG_INFO_ON_ROOT( name << ", inverse diagonal, relative difference: " << errorDiagonal );
+   WALBERLA_CHECK_LESS( errorDiagonal, tolerance );
+}
+
+template < typename CoefficientFunctionType, typename FunctionCoefficient, bool FullStokes >
+void testViscous( const std::shared_ptr< PrimitiveStorage >& storage,
+                  uint_t                                     level,
+                  const Coefficient&                         mu,
+                  const std::string&                         name,
+                  real_t                                     tolerance )
+{
+   CoefficientFunctionType muFunction( "mu", storage, level, level );
+   muFunction.interpolate( mu, level, All );
+   communication::syncFunctionBetweenPrimitives( muFunction, level );
+
+   P2ElementwiseVariableViscousOperator< FunctionCoefficient, FullStokes > functionOperator(
+       storage, level, level, FunctionCoefficient( muFunction ) );
+   P2ElementwiseVariableViscousOperator< forms::CallbackCoefficient, FullStokes > callbackOperator(
+       storage, level, level, forms::CallbackCoefficient( mu ) );
+
+   P2VectorFunction< real_t > u( "u", storage, level, level );
+   P2VectorFunction< real_t > dstFunction( "dstFunction", storage, level, level );
+   P2VectorFunction< real_t > dstCallback( "dstCallback", storage, level, level );
+
+   std::vector< Coefficient > uComponents = { []( const Point3D& x ) { return std::sin( real_c( 3 ) * x[0] ) * x[1]; },
+                                              []( const Point3D& x ) { return x[0] * x[1] - x[2]; },
+                                              []( const Point3D& x ) { return std::cos( x[1] + x[2] ); } };
+   uComponents.resize( storage->hasGlobalCells() ? 3 : 2 );
+   u.interpolate( uComponents, level, All );
+
+   functionOperator.apply( u, dstFunction, level, Inner | NeumannBoundary );
+   callbackOperator.apply( u, dstCallback, level, Inner | NeumannBoundary );
+
+   const real_t error = relativeDifference( dstCallback, dstFunction, level, Inner | NeumannBoundary );
+   WALBERLA_LOG_INFO_ON_ROOT( name << ", apply, relative difference: " << error );
+   WALBERLA_CHECK_LESS( error, tolerance );
+}
+
+int main( int argc, char** argv )
+{
+   walberla::debug::enterTestMode();
+   walberla::mpi::Environment MPIenv( argc, argv );
+   walberla::MPIManager::instance()->useWorldComm();
+
+   const real_t tolerance = std::is_same_v< real_t, double > ? real_c( 1e-12 ) : real_c( 1e-5 );
+
+   const Coefficient linear    = []( const Point3D& x ) { return real_c( 2 ) + x[0] - real_c( 0.5 ) * x[1] + x[2]; };
+   const Coefficient quadratic = []( const Point3D& x ) {
+      return real_c( 1 ) + x[0] * x[0] + real_c( 2 ) * x[0] * x[1] - x[1] * x[2] + real_c( 0.5 ) * x[2] * x[2];
+   };
+
+   // 2D
+   {
+      MeshInfo meshInfo = MeshInfo::meshRectangle( Point2D( 0, 0 ), Point2D( 2, 1 ), MeshInfo::CRISSCROSS, 2, 2 );
+      SetupPrimitiveStorage setupStorage( meshInfo, uint_c( walberla::mpi::MPIManager::instance()->numProcesses() ) );
+      auto                  storage = std::make_shared< PrimitiveStorage >( setupStorage );
+
+      testDivKGrad< P1Function< real_t >, forms::P1FunctionCoefficient >( storage, 3, linear, "2D, div k grad, P1", tolerance );
+      testDivKGrad< P2Function< real_t >, forms::P2FunctionCoefficient >(
+          storage, 3, quadratic, "2D, div k grad, P2", tolerance );
+      testViscous< P1Function< real_t >, forms::P1FunctionCoefficient, false >(
+          storage, 3, linear, "2D, epsilon, P1", tolerance );
+      testViscous< P2Function< real_t >, forms::P2FunctionCoefficient, true >(
+          storage, 3, quadratic, "2D, full Stokes, P2", tolerance );
+   }
+
+   // 3D
+   {
+      MeshInfo meshInfo = MeshInfo::meshSymmetricCuboid( Point3D( 0, 0, 0 ), Point3D( 1, 2, 1 ), 1, 1, 1 );
+      SetupPrimitiveStorage setupStorage( meshInfo, uint_c( walberla::mpi::MPIManager::instance()->numProcesses() ) );
+      auto                  storage = std::make_shared< PrimitiveStorage >( setupStorage );
+
+      testDivKGrad< P1Function< real_t >, forms::P1FunctionCoefficient >( storage, 2, linear, "3D, div k grad, P1", tolerance );
+      testDivKGrad< P2Function< real_t >, forms::P2FunctionCoefficient >(
+          storage, 2, quadratic, "3D, div k grad, P2", tolerance );
+      testViscous< P1Function< real_t >, forms::P1FunctionCoefficient, true >(
+          storage, 2, linear, "3D, full Stokes, P1", tolerance );
+      testViscous< P2Function< real_t >, forms::P2FunctionCoefficient, false >(
+          storage, 2, quadratic, "3D, epsilon, P2", tolerance );
+   }
+
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2026 Nils Kohl, Marcus Mohr.
+ *
+ * This file is part of HyTeG
+ * (see https://i10git.cs.fau.de/hyteg/hyteg).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Compares the element matrices of the coefficient-templated P2Form_viscousVar with those of the generated
+// variable viscosity forms and the resulting operator with P2ElementwiseBlendingFullViscousOperator.
+//
+// In 3D the quadrature points coincide with those of the generated q3 forms, so that the results must agree up to
+// round-off for any viscosity and blending map. In 2D the rules differ and the viscosity is chosen such that both
+// integrate exactly.
+
+#include "core/Environment.h"
+#include "core/debug/CheckFunctions.h"
+
+#include "hyteg/elementwiseoperators/P2ElementwiseBlendingFullViscousOperator.hpp"
+#include "hyteg/elementwiseoperators/P2ElementwiseVariableViscousOperator.hpp"
+#include "hyteg/forms/form_hyteg_generated/p2/p2_epsilonvar_affine_q4.hpp"
+#include "hyteg/forms/form_hyteg_generated/p2/p2_full_stokesvar_blending_q3.hpp"
+#include "hyteg/forms/form_hyteg_manual/P2FormViscousVar.hpp"
+#include "hyteg/geometry/AffineMap2D.hpp"
+#include "hyteg/geometry/AffineMap3D.hpp"
+#include "hyteg/geometry/IcosahedralShellMap.hpp"
+#include "hyteg/geometry/IdentityMap.hpp"
+#include "hyteg/geometry/SphericalCoordsMap.hpp"
+#include "hyteg/primitivestorage/SetupPrimitiveStorage.hpp"
+
+using walberla::real_c;
+using walberla::real_t;
+using walberla::uint_c;
+using walberla::uint_t;
+
+using namespace hyteg;
+
+using Coefficient = std::function< real_t( const Point3D& ) >;
+
+template < uint_t Row, uint_t Col, bool FullStokes, typename GeneratedForm, size_t NumVertices >
+void compareBlock( const GeneratedForm&                      generatedForm,
+                   const Coefficient&                        viscosity,
+                   const std::shared_ptr< GeometryMap >&     map,
+                   const std::array< Point3D, NumVertices >& element,
+                   real_t                                    tolerance )
+{
+   using ElementMatrix = std::conditional_t< NumVertices == 3, Matrix6r, Matrix10r >;
+
+   const forms::CallbackCoefficient                                             coefficient( viscosity );
+   forms::P2Form_viscousVar< Row, Col, forms::CallbackCoefficient, FullStokes > form( coefficient );
+
+   form.setGeometryMap( map );
+   generatedForm.setGeometryMap( map );
+
+   ElementMatrix elMat;
+   ElementMatrix elMatGenerated;
+   form.integrateAll( element, elMat );
+   generatedForm.integrateAll( element, elMatGenerated );
+
+   const real_t error = ( elMat - elMatGenerated ).norm() / elMatGenerated.norm();
+   WALBERLA_LOG_INFO_ON_ROOT( "block ( " << Row << ", " << Col << " ), relative difference: " << error );
+   WALBERLA_CHECK_LESS( error, tolerance );
+
+   // the row that is used for the diagonal must match the full matrix
+   Matrixr< 1, int( NumVertices == 3 ? 6 : 10 ) > row;
+   form.integrateRow0( element, row );
+   WALBERLA_CHECK_LESS_EQUAL( ( row - elMat.row( 0 ) ).norm(), tolerance * elMat.norm() );
+}
+
+void testElementMatrices3D( real_t tolerance )
+{
+   const std::array< Point3D, 4 > element = {
+       Point3D( 1.1, 0.3, 0.2 ), Point3D( 1.4, 0.35, 0.25 ), Point3D( 1.2, 0.6, 0.3 ), Point3D( 1.15, 0.4, 0.55 ) };
+
+   const Coefficient mu = []( const Point3D& x ) { return real_c( 2 ) + x[0] * x[1] + std::sin( x[2] ); };
+
+   Matrix3r affineMatrix;
+   affineMatrix << 1.2, 0.1, -0.3, 0.2, 0.9, 0.1, 0.0, 0.4, 1.1;
+
+   const std::vector< std::pair< std::string, std::shared_ptr< GeometryMap > > > maps = {
+       { "identity", std::make_shared< IdentityMap >() },
+       { "affine", std::make_shared< AffineMap3D >( affineMatrix, Point3D( 0.5, -1.0, 2.0 ) ) },
+       { "spherical coordinates", std::make_shared< SphericalCoordsMap >() } };
+
+   for ( const auto& [name, map] : maps )
+   {
+      WALBERLA_LOG_INFO_ON_ROOT( "3D, full Stokes, " << name << " map" );
+      compareBlock< 0, 0, true >( forms::p2_full_stokesvar_0_0_blending_q3( mu, mu ), mu, map, element, tolerance );
+      compareBlock< 0, 1, true >( forms::p2_full_stokesvar_0_1_blending_q3( mu, mu ), mu, map, element, tolerance );
+      compareBlock< 0, 2, true >( forms::p2_full_stokesvar_0_2_blending_q3( mu ), mu, map, element, tolerance );
+      compareBlock< 1, 0, true >( forms::p2_full_stokesvar_1_0_blending_q3( mu, mu ), mu, map, element, tolerance );
+      compareBlock< 1, 1, true >( forms::p2_full_stokesvar_1_1_blending_q3( mu, mu ), mu, map, element, tolerance );
+      compareBlock< 1, 2, true >( forms::p2_full_stokesvar_1_2_blending_q3( mu ), mu, map, element, tolerance );
+      compareBlock< 2, 0, true >( forms::p2_full_stokesvar_2_0_blending_q3( mu ), mu, map, element, tolerance );
+      compareBlock< 2, 1, true >( forms::p2_full_stokesvar_2_1_blending_q3( mu ), mu, map, element, tolerance );
+      compareBlock< 2, 2, true >( forms::p2_full_stokesvar_2_2_blending_q3( mu ), mu, map, element, tolerance );
+   }
+
+   // the q4 epsilon forms are exact for a linear viscosity, as is P2Form_viscousVar
+   const Coefficient muLinear = []( const Point3D& x ) { return real_c( 1 ) + x[0] - real_c( 0.5 ) * x[1] + real_c( 2 ) * x[2]; };
+   const auto        identity = std::make_shared< IdentityMap >();
+
+   WALBERLA_LOG_INFO_ON_ROOT( "3D, epsilon, identity map" );
+   compareBlock< 0, 0, false >( forms::p2_epsilonvar_0_0_affine_q4( muLinear, muLinear ), muLinear, identity, element, tolerance );
+   compareBlock< 0, 1, false >( forms::p2_epsilonvar_0_1_affine_q4( muLinear, muLinear ), muLinear, identity, element, tolerance );
+   compareBlock< 0, 2, false >( forms::p2_epsilonvar_0_2_affine_q4( muLinear ), muLinear, identity, element, tolerance );
+   compareBlock< 1, 0, false >( forms::p2_epsilonvar_1_0_affine_q4( muLinear, muLinear ), muLinear, identity, element, tolerance );
+   compareBlock< 1, 1, false >( forms::p2_epsilonvar_1_1_affine_q4( muLinear, muLinear ), muLinear, identity, element, tolerance );
+   compareBlock< 1, 2, false >( forms::p2_epsilonvar_1_2_affine_q4( muLinear ), muLinear, identity, element, tolerance );
+   compareBlock< 2, 0, false >( forms::p2_epsilonvar_2_0_affine_q4( muLinear ), muLinear, identity, element, tolerance );
+   compareBlock< 2, 1, false >( forms::p2_epsilonvar_2_1_affine_q4( muLinear ), muLinear, identity, element, tolerance );
+   compareBlock< 2, 2, false >( forms::p2_epsilonvar_2_2_affine_q4( muLinear ), muLinear, identity, element, tolerance );
+}
+
+void testElementMatrices2D( real_t tolerance )
+{
+   const std::array< Point3D, 3 > element = { Point3D( 0.1, 0.345, 0 ), Point3D( 0.2, 0.083745, 0 ), Point3D( 0.985, 0.3, 0 ) };
+
+   // both quadrature rules are exact for a linear viscosity (with affine maps)
+   const Coefficient mu = []( const Point3D& x ) { return real_c( 1 ) + x[0] + real_c( 2 ) * x[1]; };
+
+   Matrix2r affineMatrix;
+   affineMatrix << 1.2, 0.3, -0.2, 0.8;
+
+   const std::vector< std::pair< std::string, std::shared_ptr< GeometryMap > > > maps = {
+       { "identity", std::make_shared< IdentityMap >() },
+       { "affine", std::make_shared< AffineMap2D >( affineMatrix, Point2D( 0.5, -1.0 ) ) } };
+
+   for ( const auto& [name, map] : maps )
+   {
+      WALBERLA_LOG_INFO_ON_ROOT( "2D, full Stokes, " << name << " map" );
+      compareBlock< 0, 0, true >( forms::p2_full_stokesvar_0_0_blending_q3( mu, mu ), mu, map, element, tolerance );
+      compareBlock< 0, 1, true >( forms::p2_full_stokesvar_0_1_blending_q3( mu, mu ), mu, map, element, tolerance );
+      compareBlock< 1, 0, true >( forms::p2_full_stokesvar_1_0_blending_q3( mu, mu ), mu, map, element, tolerance );
+      compareBlock< 1, 1, true >( forms::p2_full_stokesvar_1_1_blending_q3( mu, mu ), mu, map, element, tolerance );
+   }
+
+   const auto identity = std::make_shared< IdentityMap >();
+
+   WALBERLA_LOG_INFO_ON_ROOT( "2D, epsilon, identity map" );
+   compareBlock< 0, 0, false >( forms::p2_epsilonvar_0_0_affine_q4( mu, mu ), mu, identity, element, tolerance );
+   compareBlock< 0, 1, false >( forms::p2_epsilonvar_0_1_affine_q4( mu, mu ), mu, identity, element, tolerance );
+   compareBlock< 1, 0, false >( forms::p2_epsilonvar_1_0_affine_q4( mu, mu ), mu, identity, element, tolerance );
+   compareBlock< 1, 1, false >( forms::p2_epsilonvar_1_1_affine_q4( mu, mu ), mu, identity, element, tolerance );
+}
+
+void testRadialProfile( real_t tolerance )
+{
+   const std::vector< real_t > radii  = { 1.0, 1.25, 1.5, 2.0 };
+   const std::vector< real_t > values = { 10.0, 2.0, 1.0, 4.0 };
+
+   const forms::RadialProfileCoefficient profile( radii, values );
+
+   WALBERLA_CHECK_FLOAT_EQUAL( profile( Point3D( 0.5, 0, 0 ) ), real_c( 10 ) );
+   WALBERLA_CHECK_FLOAT_EQUAL( profile( Point3D( 0, 1.0, 0 ) ), real_c( 10 ) );
+   WALBERLA_CHECK_FLOAT_EQUAL( profile( Point3D( 0, 0, 1.125 ) ), real_c( 6 ) );
+   WALBERLA_CHECK_FLOAT_EQUAL( profile( Point3D( 0, 1.5, 0 ) ), real_c( 1 ) );
+   WALBERLA_CHECK_FLOAT_EQUAL( profile( Point3D( 1.75, 0, 0 ) ), real_c( 2.5 ) );
+   WALBERLA_CHECK_FLOAT_EQUAL( profile( Point3D( 3.0, 0, 0 ) ), real_c( 4 ) );
+
+   // the same profile via a callback must give the same element matrix
+   const forms::CallbackCoefficient callback( [profile]( const Point3D& x ) { return profile( x ); } );
+
+   const std::array< Point3D, 4 > element = {
+       Point3D( 1.1, 0.3, 0.2 ), Point3D( 1.4, 0.35, 0.25 ), Point3D( 1.2, 0.6, 0.3 ), Point3D( 1.15, 0.4, 0.55 ) };
+
+   forms::P2Form_fullStokesVar< 1, 2, forms::RadialProfileCoefficient > form( profile );
+   forms::P2Form_fullStokesVar< 1, 2, forms::CallbackCoefficient >      formCallback( callback );
+
+   Matrix10r elMat;
+   Matrix10r elMatCallback;
+   form.integrateAll( element, elMat );
+   formCallback.integrateAll( element, elMatCallback );
+
+   WALBERLA_CHECK_LESS( ( elMat - elMatCallback ).norm() / elMatCallback.norm(), tolerance );
+}
+
+void testOperator( real_t tolerance )
+{
+   const uint_t level = 2;
+
+   MeshInfo              meshInfo = MeshInfo::meshSphericalShell( 3, 2, real_c( 1 ), real_c( 2 ) );
+   SetupPrimitiveStorage setupStorage( meshInfo, uint_c( walberla::mpi::MPIManager::instance()->numProcesses() ) );
+   IcosahedralShellMap::setMap( setupStorage );
+   auto storage = std::make_shared< PrimitiveStorage >( setupStorage );
+
+   const Coefficient mu = []( const Point3D& x ) { return std::exp( real_c( 2 ) - x.norm() ) + x[0] * x[2]; };
+
+   P2ElementwiseBlendingFullViscousOperator                                 generatedOperator( storage, level, level, mu );
+   P2ElementwiseVariableViscousOperator< forms::CallbackCoefficient, true > templatedOperator(
+       storage, level, level, forms::CallbackCoefficient( mu ) );
+
+   P2VectorFunction< real_t > u( "u", storage, level, level );
+   P2VectorFunction< real_t > dstGenerated( "dstGenerated", storage, level, level );
+   P2VectorFunction< real_t > dstTemplated( "dstTemplated", storage, level, level );
+
+   u.interpolate( { []( const Point3D& x ) { return std::sin( real_c( 3 ) * x[0] ) * x[1]; },
+                    []( const Point3D& x ) { return x[0] * x[1] - x[2]; },
+                    []( const Point3D& x ) { return std::cos( x[1] + x[2] ); } },
+                  level,
+                  All );
+
+   generatedOperator.apply( u, dstGenerated, level, Inner | NeumannBoundary );
+   templatedOperator.apply( u, dstTemplated, level, Inner | NeumannBoundary );
+
+   const real_t normGenerated = std::sqrt( dstGenerated.dotGlobal( dstGenerated, level, Inner | NeumannBoundary ) );
+   dstTemplated.assign( { real_c( 1 ), real_c( -1 ) }, { dstTemplated, dstGenerated }, level, Inner | NeumannBoundary );
+   const real_t error = std::sqrt( dstTemplated.dotGlobal( dstTemplated, level, Inner | NeumannBoundary ) ) / normGenerated;
+
+   WALBERLA_LOG_INFO_ON_ROOT( "operator, relative difference: " << error );
+   WALBERLA_CHECK_LESS( error, tolerance );
+}
+
+int main( int argc, char** argv )
+{
+   walberla::debug::enterTestMode();
+   walberla::mpi::Environment MPIenv( argc, argv );
+   walberla::MPIManager::instance()->useWorldComm();
+
+   const real_t tolerance = std::is_same_v< real_t, double > ? real_c( 1e-12 ) : real_c( 1e-5 );
+
+   testElementMatrices3D( tolerance );
+   testElementMatrices2D( tolerance );
+   testRadialProfile( tolerance );
+   testOperator( tolerance );
+
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2026 Nils Kohl, Marcus Mohr.
+ *
+ * This file is part of HyTeG
+ * (see https://i10git.cs.fau.de/hyteg/hyteg).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Checks that dotGlobalBatch() returns the same values as the respective calls to dotGlobal().
+
+#include "core/DataTypes.h"
+#include "core/Environment.h"
+#include "core/debug/all.h"
+#include "core/mpi/all.h"
+
+#include "hyteg/composites/P2P1TaylorHoodFunction.hpp"
+#include "hyteg/p1functionspace/P1Function.hpp"
+#include "hyteg/p2functionspace/P2Function.hpp"
+#include "hyteg/p2functionspace/P2VectorFunction.hpp"
+#include "hyteg/primitivestorage/PrimitiveStorage.hpp"
+#include "hyteg/primitivestorage/SetupPrimitiveStorage.hpp"
+
+using walberla::real_c;
+using walberla::real_t;
+using walberla::uint_t;
+using namespace hyteg;
+
+template < typename FunctionType >
+void runTest( const std::shared_ptr< PrimitiveStorage >& storage, const uint_t level, const std::string& tag )
+{
+   const uint_t numFunctions = 5;
+
+   FunctionType                lhs( "lhs", storage, level, level );
+   std::vector< FunctionType > rhs;
+   for ( uint_t k = 0; k < numFunctions; k++ )
+   {
+      rhs.emplace_back( "rhs" + std::to_string( k ), storage, level, level );
+   }
+
+   lhs.interpolate( []( const Point3D& x ) { return std::sin( x[0] ) + x[1] * x[2] + real_c( 0.5 ); }, level, All );
+   for ( uint_t k = 0; k < numFunctions; k++ )
+   {
+      const real_t factor = real_c( k + 1 );
+      rhs[k].interpolate( [factor]( const Point3D& x ) { return std::cos( factor * x[0] ) * x[1] + factor * x[2]; }, level, All );
+   }
+
+   const std::vector< std::reference_wrapper< const FunctionType > > rhsRefs( rhs.begin(), rhs.end() );
+
+   for ( auto flag : { All, Inner, DirichletBoundary, Inner | NeumannBoundary } )
+   {
+      const auto batch = lhs.dotGlobalBatch( rhsRefs, level, flag );
+      WALBERLA_CHECK_EQUAL( batch.size(), numFunctions );
+
+      for ( uint_t k = 0; k < numFunctions; k++ )
+      {
+         const real_t single = lhs.dotGlobal( rhs[k], level, flag );
+         WALBERLA_LOG_DEVEL_ON_ROOT( "[" << tag << "] k = " << k << ": batch = " << batch[k] << ", single = " << single );
+         WALBERLA_CHECK_FLOAT_EQUAL( batch[k], single );
+      }
+   }
+
+   // empty batches are fine
+   WALBERLA_CHECK( lhs.dotGlobalBatch( std::vector< std::reference_wrapper< const FunctionType > >(), level, All ).empty() );
+}
+
+int main( int argc, char* argv[] )
+{
+   walberla::debug::enterTestMode();
+   walberla::Environment walberlaEnv( argc, argv );
+   walberla::logging::Logging::instance()->setLogLevel( walberla::logging::Logging::PROGRESS );
+   walberla::MPIManager::instance()->useWorldComm();
+
+   const uint_t level = 3;
+
+   for ( const auto& meshFile : { prependHyTeGMeshDir( "2D/quad_8el.msh" ), prependHyTeGMeshDir( "3D/cube_6el.msh" ) } )
+   {
+      auto                  meshInfo = MeshInfo::fromGmshFile( meshFile );
+      SetupPrimitiveStorage setupStorage( meshInfo, walberla::uint_c( walberla::mpi::MPIManager::instance()->numProcesses() ) );
+      setupStorage.setMeshBoundaryFlagsOnBoundary( 1, 0, true );
+      auto storage = std::make_shared< PrimitiveStorage >( setupStorage );
+
+      runTest< P1Function< real_t > >( storage, level, "P1Function" );
+      runTest< P2Function< real_t > >( storage, level, "P2Function" );
+      runTest< P2VectorFunction< real_t > >( storage, level, "P2VectorFunction" );
+      runTest< P2P1TaylorHoodFunction< real_t > >( storage, level, "P2P1TaylorHoodFunction" );
+   }
+
+   return EXIT_SUCCESS;
+}
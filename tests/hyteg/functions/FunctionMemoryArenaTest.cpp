@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2026 Nils Kohl.
+ *
+ * This file is part of HyTeG
+ * (see https://i10git.cs.fau.de/hyteg/hyteg).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdint>
+
+#include "core/Environment.h"
+#include "core/logging/Logging.h"
+#include "core/mpi/MPIManager.h"
+
+#include "hyteg/memory/FunctionMemory.hpp"
+#include "hyteg/p2functionspace/P2Function.hpp"
+#include "hyteg/primitivestorage/PrimitiveStorage.hpp"
+#include "hyteg/primitivestorage/SetupPrimitiveStorage.hpp"
+
+using walberla::real_c;
+using walberla::real_t;
+using walberla::uint_c;
+using walberla::uint_t;
+
+using namespace hyteg;
+
+/// Checks that functions allocated in a FunctionMemoryArena behave exactly like those with separately allocated levels,
+/// that all chunks are aligned, that chunks swapped between arenas outlive the function they came from, and that the
+/// memory is released once the last function handle goes out of scope.
+void testFunctionMemoryArena( const std::string& meshFile )
+{
+   const uint_t minLevel = 2;
+   const uint_t maxLevel = 4;
+
+   auto                  meshInfo = MeshInfo::fromGmshFile( meshFile );
+   SetupPrimitiveStorage setupStorage( meshInfo, uint_c( walberla::mpi::MPIManager::instance()->numProcesses() ) );
+   const auto            storage = std::make_shared< PrimitiveStorage >( setupStorage );
+
+   WALBERLA_CHECK_EQUAL( FunctionMemory< real_t >::getGlobalAllocatedMemoryInBytes(), 0 );
+
+   std::function< real_t( const Point3D& ) > expr = []( const Point3D& x ) {
+      return std::sin( x[0] ) + real_c( 2 ) * x[1] * x[1] - x[2];
+   };
+
+   P2Function< real_t > u( "u", storage, minLevel, maxLevel );
+   P2Function< real_t > v( "v", storage, minLevel, maxLevel );
+
+   const auto memoryWithoutArena = FunctionMemory< real_t >::getLocalAllocatedMemoryInBytes();
+
+   P2Function< real_t > err( "err", storage, minLevel, maxLevel );
+
+   const auto memoryBeforeArena = FunctionMemory< real_t >::getLocalAllocatedMemoryInBytes();
+
+   for ( uint_t level = minLevel; level <= maxLevel; level++ )
+   {
+      u.interpolate( expr, level, All );
+      v.interpolate( 1, level, All );
+   }
+
+   FunctionMemory< real_t >::setArenaAllocation( true );
+   {
+      P2Function< real_t > uArena( "uArena", storage, minLevel, maxLevel );
+      {
+         P2Function< real_t > vArena( "vArena", storage, minLevel, maxLevel );
+
+         // arena memory includes padding, so it must be at least as large as the separately allocated memory
+         const auto memoryWithArena = FunctionMemory< real_t >::getLocalAllocatedMemoryInBytes() - memoryBeforeArena;
+         WALBERLA_CHECK_GREATER_EQUAL( memoryWithArena, memoryWithoutArena );
+
+         for ( const auto& it : storage->getFaces() )
+         {
+            for ( uint_t level = minLevel; level <= maxLevel; level++ )
+            {
+               const auto ptr = it.second->getData( uArena.getVertexDoFFunction().getFaceDataID() )->getPointer( level );
+               WALBERLA_CHECK_EQUAL( reinterpret_cast< std::uintptr_t >( ptr ) % FunctionMemoryAlignment, 0 );
+            }
+         }
+
+         for ( uint_t level = minLevel; level <= maxLevel; level++ )
+         {
+            uArena.interpolate( expr, level, All );
+            vArena.interpolate( 1, level, All );
+
+            const real_t dot      = u.dotGlobal( v, level, All );
+            const real_t dotArena = uArena.dotGlobal( vArena, level, All );
+            WALBERLA_LOG_INFO_ON_ROOT( "level " << level << ": dot = " << dot << ", dot (arena) = " << dotArena );
+            WALBERLA_CHECK_FLOAT_EQUAL( dot, dotArena );
+
+            // swapping exchanges chunks of different arenas
+            uArena.swap( vArena, level );
+         }
+      }
+
+      // vArena has been destroyed, the chunks that were swapped into uArena must still hold its data
+      for ( uint_t level = minLevel; level <= maxLevel; level++ )
+      {
+         err.assign( { real_c( 1 ), real_c( -1 ) }, { uArena, v }, level, All );
+         WALBERLA_CHECK_EQUAL( err.getMaxDoFMagnitude( level, All ), real_c( 0 ) );
+      }
+   }
+   FunctionMemory< real_t >::setArenaAllocation( false );
+
+   WALBERLA_CHECK_EQUAL( FunctionMemory< real_t >::getLocalAllocatedMemoryInBytes(), memoryBeforeArena );
+}
+
+int main( int argc, char* argv[] )
+{
+   walberla::Environment walberlaEnv( argc, argv );
+   walberla::logging::Logging::instance()->setLogLevel( walberla::logging::Logging::PROGRESS );
+   walberla::MPIManager::instance()->useWorldComm();
+
+   testFunctionMemoryArena( prependHyTeGMeshDir( "2D/tri_2el.msh" ) );
+   testFunctionMemoryArena( prependHyTeGMeshDir( "3D/cube_24el.msh" ) );
+   return 0;
+}
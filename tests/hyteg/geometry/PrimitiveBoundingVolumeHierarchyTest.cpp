@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2026 Nils Kohl, Marcus Mohr.
+ *
+ * This file is part of HyTeG
+ * (see https://i10git.cs.fau.de/hyteg/hyteg).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Checks that the bounding volume hierarchy over the blended macro-primitives returns every primitive that contains
+// a given physical point as a candidate, and that it is cached per storage and rebuilt after the storage was modified.
+
+#include <algorithm>
+
+#include "core/Environment.h"
+#include "core/debug/CheckFunctions.h"
+#include "core/math/Constants.h"
+#include "core/math/Random.h"
+
+#include "hyteg/geometry/AnnulusMap.hpp"
+#include "hyteg/geometry/BlendingHelpers.hpp"
+#include "hyteg/geometry/IcosahedralShellMap.hpp"
+#include "hyteg/geometry/PrimitiveBoundingVolumeHierarchy.hpp"
+#include "hyteg/mesh/MeshInfo.hpp"
+#include "hyteg/primitivestorage/PrimitiveStorage.hpp"
+#include "hyteg/primitivestorage/SetupPrimitiveStorage.hpp"
+
+using walberla::real_c;
+using walberla::real_t;
+using walberla::uint_c;
+using walberla::uint_t;
+
+using namespace hyteg;
+
+/// random point in the simplex spanned by the passed vertices
+template < uint_t NumVertices >
+Point3D randomPointInSimplex( const std::array< Point3D, NumVertices >& vertices )
+{
+   std::array< real_t, NumVertices > weights;
+   real_t                            sum = 0;
+   for ( auto& w : weights )
+   {
+      w = walberla::math::realRandom( real_c( 0.01 ), real_c( 1 ) );
+      sum += w;
+   }
+
+   Point3D p;
+   for ( uint_t i = 0; i < NumVertices; ++i )
+   {
+      p += weights[i] / sum * vertices[i];
+   }
+   return p;
+}
+
+template < typename PrimitiveType >
+void testHierarchy( const std::shared_ptr< PrimitiveStorage >& storage, uint_t numSamplesPerPrimitive )
+{
+   constexpr bool is3D = std::is_same_v< PrimitiveType, Cell >;
+
+   auto hierarchy = PrimitiveBoundingVolumeHierarchy< PrimitiveType >::getForStorage( storage, false );
+
+   // the hierarchy is cached
+   WALBERLA_CHECK_EQUAL( hierarchy, ( PrimitiveBoundingVolumeHierarchy< PrimitiveType >::getForStorage( storage, false ) ) );
+   WALBERLA_CHECK_EQUAL( hierarchy->getNumPrimitives(), is3D ? storage->getNumberOfLocalCells() : storage->getNumberOfLocalFaces() );
+
+   std::vector< uint_t > candidates;
+   for ( uint_t idx = 0; idx < hierarchy->getNumPrimitives(); ++idx )
+   {
+      const PrimitiveType& primitive = hierarchy->getPrimitive( idx );
+
+      for ( uint_t sample = 0; sample < numSamplesPerPrimitive; ++sample )
+      {
+         const Point3D computationalCoords = randomPointInSimplex( primitive.getCoordinates() );
+         Point3D       physicalCoords;
+         primitive.getGeometryMap()->evalF( computationalCoords, physicalCoords );
+
+         hierarchy->findCandidates( physicalCoords, candidates );
+         WALBERLA_CHECK( std::find( candidates.begin(), candidates.end(), idx ) != candidates.end() );
+         WALBERLA_CHECK( std::is_sorted( candidates.begin(), candidates.end() ) );
+
+         auto [found, primitiveID, backMapped] =
+             is3D ? mapFromPhysicalToComputationalDomain3D( storage, physicalCoords, real_c( -1 ) ) :
+                    mapFromPhysicalToComputationalDomain2D( storage, physicalCoords, real_c( -1 ) );
+         WALBERLA_CHECK( found );
+         WALBERLA_CHECK_EQUAL( primitiveID, primitive.getID() );
+         WALBERLA_CHECK_FLOAT_EQUAL_EPSILON( ( backMapped - computationalCoords ).norm(), real_c( 0 ), real_c( 1e-6 ) );
+      }
+   }
+
+   // points far away from the domain do not have any candidates
+   hierarchy->findCandidates( Point3D( 1e3, 1e3, is3D ? 1e3 : 0 ), candidates );
+   WALBERLA_CHECK( candidates.empty() );
+}
+
+/// Migrates all primitives to the root process and checks that the hierarchies are rebuilt instead of being served stale.
+template < typename PrimitiveType >
+void testRebuildAfterMigration( const std::shared_ptr< PrimitiveStorage >& storage, uint_t numSamplesPerPrimitive )
+{
+   constexpr bool is3D = std::is_same_v< PrimitiveType, Cell >;
+
+   auto         hierarchyBefore         = PrimitiveBoundingVolumeHierarchy< PrimitiveType >::getForStorage( storage, false );
+   auto         neighborHierarchyBefore = PrimitiveBoundingVolumeHierarchy< PrimitiveType >::getForStorage( storage, true );
+   const uint_t modificationStampBefore = storage->getModificationStamp();
+
+   MigrationMap_T             migrationMap;
+   std::vector< PrimitiveID > localPrimitiveIDs;
+   storage->getPrimitiveIDs( localPrimitiveIDs );
+   for ( const auto& id : localPrimitiveIDs )
+   {
+      migrationMap[id] = 0;
+   }
+   storage->migratePrimitives( MigrationInfo( migrationMap, getNumReceivingPrimitives( migrationMap ) ) );
+   WALBERLA_CHECK_GREATER( storage->getModificationStamp(), modificationStampBefore );
+
+   auto hierarchy         = PrimitiveBoundingVolumeHierarchy< PrimitiveType >::getForStorage( storage, false );
+   auto neighborHierarchy = PrimitiveBoundingVolumeHierarchy< PrimitiveType >::getForStorage( storage, true );
+   WALBERLA_CHECK_UNEQUAL( hierarchy, hierarchyBefore );
+   WALBERLA_CHECK_UNEQUAL( neighborHierarchy, neighborHierarchyBefore );
+
+   const uint_t numLocalPrimitives    = is3D ? storage->getNumberOfLocalCells() : storage->getNumberOfLocalFaces();
+   const uint_t numNeighborPrimitives = is3D ? storage->getNeighborCells().size() : storage->getNeighborFaces().size();
+   WALBERLA_CHECK_EQUAL( hierarchy->getNumPrimitives(), numLocalPrimitives );
+   WALBERLA_CHECK_EQUAL( neighborHierarchy->getNumPrimitives(), numLocalPrimitives + numNeighborPrimitives );
+
+   // all primitives are on the root process now
+   const uint_t numGlobalPrimitives = is3D ? storage->getNumberOfGlobalCells() : storage->getNumberOfGlobalFaces();
+   WALBERLA_ROOT_SECTION()
+   {
+      WALBERLA_CHECK_EQUAL( hierarchy->getNumPrimitives(), numGlobalPrimitives );
+   }
+
+   testHierarchy< PrimitiveType >( storage, numSamplesPerPrimitive );
+}
+
+int main( int argc, char* argv[] )
+{
+   walberla::Environment walberlaEnv( argc, argv );
+   walberla::logging::Logging::instance()->setLogLevel( walberla::logging::Logging::PROGRESS );
+   walberla::MPIManager::instance()->useWorldComm();
+   walberla::math::seedRandomGenerator( 4711 );
+
+   {
+      WALBERLA_LOG_INFO_ON_ROOT( "2D: annulus" );
+      MeshInfo meshInfo = MeshInfo::meshAnnulus(
+          real_c( 1 ), real_c( 2 ), real_c( 0 ), real_c( 2 * walberla::math::pi ), MeshInfo::CROSS, 16, 4 );
+      SetupPrimitiveStorage setupStorage( meshInfo, uint_c( walberla::mpi::MPIManager::instance()->numProcesses() ) );
+      AnnulusMap::setMap( setupStorage );
+      auto storage = std::make_shared< PrimitiveStorage >( setupStorage );
+      testHierarchy< Face >( storage, 10 );
+      testRebuildAfterMigration< Face >( storage, 10 );
+   }
+
+   {
+      WALBERLA_LOG_INFO_ON_ROOT( "3D: spherical shell" );
+      MeshInfo              meshInfo = MeshInfo::meshSphericalShell( 3, 2, real_c( 1 ), real_c( 2 ) );
+      SetupPrimitiveStorage setupStorage( meshInfo, uint_c( walberla::mpi::MPIManager::instance()->numProcesses() ) );
+      IcosahedralShellMap::setMap( setupStorage );
+      auto storage = std::make_shared< PrimitiveStorage >( setupStorage );
+      testHierarchy< Cell >( storage, 5 );
+      testRebuildAfterMigration< Cell >( storage, 5 );
+   }
+
+   return EXIT_SUCCESS;
+}
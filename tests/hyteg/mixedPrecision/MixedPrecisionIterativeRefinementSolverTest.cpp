@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2026 Nils Kohl, Marcus Mohr.
+ *
+ * This file is part of HyTeG
+ * (see https://i10git.cs.fau.de/hyteg/hyteg).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <limits>
+
+#include "core/Environment.h"
+#include "core/logging/Logging.h"
+#include "core/math/Random.h"
+
+#include "hyteg/gridtransferoperators/P1toP1LinearProlongation.hpp"
+#include "hyteg/gridtransferoperators/P1toP1LinearRestriction.hpp"
+#include "hyteg/p1functionspace/P1Function.hpp"
+#include "hyteg/p2functionspace/P2Function.hpp"
+#include "hyteg/primitivestorage/PrimitiveStorage.hpp"
+#include "hyteg/primitivestorage/SetupPrimitiveStorage.hpp"
+#include "hyteg/solvers/CGSolver.hpp"
+#include "hyteg/solvers/GaussSeidelSmoother.hpp"
+#include "hyteg/solvers/GeometricMultigridSolver.hpp"
+#include "hyteg/solvers/MixedPrecisionIterativeRefinementSolver.hpp"
+
+#include "constant_stencil_operator/P1ConstantOperator.hpp"
+
+// Tests the conversion of P1 and P2 functions between double and single precision and checks that the
+// MixedPrecisionIterativeRefinementSolver with a single precision multigrid solver converges beyond
+// single precision accuracy.
+
+using walberla::real_c;
+using walberla::uint_c;
+using walberla::uint_t;
+
+namespace hyteg {
+
+typedef P1ConstantOperator< P1FenicsForm< p1_diffusion_cell_integral_0_otherwise, p1_tet_diffusion_cell_integral_0_otherwise >,
+                            false,
+                            false,
+                            false,
+                            float >
+    P1ConstantLaplaceOperatorSP;
+
+typedef P1ConstantOperator< P1FenicsForm< p1_diffusion_cell_integral_0_otherwise, p1_tet_diffusion_cell_integral_0_otherwise >,
+                            false,
+                            false,
+                            false,
+                            double >
+    P1ConstantLaplaceOperatorDP;
+
+template < template < typename > class FunctionType >
+void conversionTest( const std::shared_ptr< PrimitiveStorage >& storage, uint_t level )
+{
+   FunctionType< double > u( "u", storage, level, level );
+   FunctionType< double > v( "v", storage, level, level );
+   FunctionType< double > err( "err", storage, level, level );
+   FunctionType< float >  uSP( "uSP", storage, level, level );
+
+   u.interpolate( []( const Point3D& x ) { return std::exp( x[0] ) * std::sin( 3.0 * x[1] ) + 1.0 / 3.0; }, level, All );
+
+   uSP.copyFrom( u, level );
+   v.copyFrom( uSP, level );
+
+   err.assign( { 1.0, -1.0 }, { u, v }, level, All );
+   const double maxErr = err.getMaxDoFMagnitude( level );
+   const double maxVal = u.getMaxDoFMagnitude( level );
+
+   WALBERLA_LOG_INFO_ON_ROOT( "conversion double -> float -> double, max. relative error: " << maxErr / maxVal )
+   WALBERLA_CHECK_LESS_EQUAL( maxErr / maxVal, double( std::numeric_limits< float >::epsilon() ) );
+   WALBERLA_CHECK_GREATER( maxErr, 0.0, "The round trip should actually truncate the values." );
+}
+
+void iterativeRefinementTest( const std::shared_ptr< PrimitiveStorage >& storage, uint_t minLevel, uint_t maxLevel )
+{
+   P1Function< double > u( "u", storage, minLevel, maxLevel );
+   P1Function< double > f( "f", storage, minLevel, maxLevel );
+   P1Function< double > r( "r", storage, minLevel, maxLevel );
+
+   P1ConstantLaplaceOperatorDP A( storage, minLevel, maxLevel );
+   auto                        ASP = std::make_shared< P1ConstantLaplaceOperatorSP >( storage, minLevel, maxLevel );
+
+   auto coarseGridSolverSP = std::make_shared< CGSolver< P1ConstantLaplaceOperatorSP > >( storage, minLevel, maxLevel );
+   auto smootherSP         = std::make_shared< GaussSeidelSmoother< P1ConstantLaplaceOperatorSP > >();
+   auto gmgSolverSP        = std::make_shared< GeometricMultigridSolver< P1ConstantLaplaceOperatorSP > >(
+       storage,
+       smootherSP,
+       coarseGridSolverSP,
+       std::make_shared< P1toP1LinearRestriction< float > >(),
+       std::make_shared< P1toP1LinearProlongation< float > >(),
+       minLevel,
+       maxLevel );
+
+   const double relativeTolerance = 1e-12;
+
+   MixedPrecisionIterativeRefinementSolver< P1ConstantLaplaceOperatorDP, P1ConstantLaplaceOperatorSP > solver(
+       storage, minLevel, maxLevel, ASP, gmgSolverSP, 50, relativeTolerance );
+   solver.setPrintInfo( true );
+
+   std::function< double( const Point3D& ) > exact = []( const Point3D& x ) { return std::sin( 2 * x[0] ) * std::sinh( x[1] ); };
+   std::function< double( const Point3D& ) > random = []( const Point3D& ) { return walberla::math::realRandom(); };
+
+   u.interpolate( exact, maxLevel, DirichletBoundary );
+   u.interpolate( random, maxLevel, Inner );
+   f.interpolate( random, maxLevel, All );
+
+   A.apply( u, r, maxLevel, Inner, Replace );
+   r.assign( { 1.0, -1.0 }, { f, r }, maxLevel, Inner );
+   const double resStart = std::sqrt( r.dotGlobal( r, maxLevel, Inner ) );
+
+   solver.solve( A, u, f, maxLevel );
+
+   A.apply( u, r, maxLevel, Inner, Replace );
+   r.assign( { 1.0, -1.0 }, { f, r }, maxLevel, Inner );
+   const double resEnd = std::sqrt( r.dotGlobal( r, maxLevel, Inner ) );
+
+   WALBERLA_LOG_INFO_ON_ROOT( "iterations: " << solver.getIterations() << ", relative residual: " << resEnd / resStart )
+
+   // the inner solver alone stagnates at the level of single precision
+   WALBERLA_CHECK_LESS( resEnd / resStart, relativeTolerance );
+   WALBERLA_CHECK_LESS( solver.getIterations(), uint_c( 50 ) );
+}
+
+} // namespace hyteg
+
+int main( int argc, char* argv[] )
+{
+   walberla::Environment walberlaEnv( argc, argv );
+   walberla::logging::Logging::instance()->setLogLevel( walberla::logging::Logging::PROGRESS );
+   walberla::MPIManager::instance()->useWorldComm();
+
+   const uint_t numProcesses = uint_c( walberla::mpi::MPIManager::instance()->numProcesses() );
+
+   auto setupStorage2D = std::make_shared< hyteg::SetupPrimitiveStorage >( hyteg::MeshInfo::meshUnitSquare( 0 ), numProcesses );
+   setupStorage2D->setMeshBoundaryFlagsOnBoundary( 1, 0, true );
+   auto storage2D = std::make_shared< hyteg::PrimitiveStorage >( *setupStorage2D );
+
+   auto setupStorage3D = std::make_shared< hyteg::SetupPrimitiveStorage >(
+       hyteg::MeshInfo::fromGmshFile( hyteg::prependHyTeGMeshDir( "3D/cube_6el.msh" ) ), numProcesses );
+   setupStorage3D->setMeshBoundaryFlagsOnBoundary( 1, 0, true );
+   auto storage3D = std::make_shared< hyteg::PrimitiveStorage >( *setupStorage3D );
+
+   hyteg::conversionTest< hyteg::P1Function >( storage2D, 4 );
+   hyteg::conversionTest< hyteg::P2Function >( storage2D, 4 );
+   hyteg::conversionTest< hyteg::P1Function >( storage3D, 3 );
+   hyteg::conversionTest< hyteg::P2Function >( storage3D, 3 );
+
+   hyteg::iterativeRefinementTest( storage2D, 2, 6 );
+   hyteg::iterativeRefinementTest( storage3D, 2, 4 );
+
+   return 0;
+}
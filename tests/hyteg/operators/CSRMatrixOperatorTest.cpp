@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2026 Nils Kohl, Marcus Mohr.
+ *
+ * This file is part of HyTeG
+ * (see https://i10git.cs.fau.de/hyteg/hyteg).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Compares the application of operators through their assembled CSR matrix with the matrix-free application
+// and runs a geometric multigrid solver on the assembled operators.
+
+#include "core/Environment.h"
+#include "core/debug/CheckFunctions.h"
+#include "core/math/Random.h"
+
+#include "hyteg/elementwiseoperators/P1ElementwiseOperator.hpp"
+#include "hyteg/elementwiseoperators/P2ElementwiseOperator.hpp"
+#include "hyteg/gridtransferoperators/P1toP1LinearProlongation.hpp"
+#include "hyteg/gridtransferoperators/P1toP1LinearRestriction.hpp"
+#include "hyteg/operators/CSRMatrixOperator.hpp"
+#include "hyteg/p1functionspace/P1Function.hpp"
+#include "hyteg/p2functionspace/P2Function.hpp"
+#include "hyteg/primitivestorage/SetupPrimitiveStorage.hpp"
+#include "hyteg/solvers/CGSolver.hpp"
+#include "hyteg/solvers/GeometricMultigridSolver.hpp"
+#include "hyteg/solvers/WeightedJacobiSmoother.hpp"
+
+using walberla::real_c;
+using walberla::real_t;
+using walberla::uint_c;
+using walberla::uint_t;
+
+using namespace hyteg;
+
+template < typename OperatorType >
+void testApply( const std::shared_ptr< PrimitiveStorage >& storage, uint_t level, const std::string& name )
+{
+   using FunctionType = typename OperatorType::srcType;
+
+   const real_t tolerance = std::is_same_v< real_t, double > ? real_c( 1e-12 ) : real_c( 1e-5 );
+
+   OperatorType                      A( storage, level, level );
+   CSRMatrixOperator< OperatorType > A_csr( A, level, level );
+
+   FunctionType u( "u", storage, level, level );
+   FunctionType dstMatrixFree( "dstMatrixFree", storage, level, level );
+   FunctionType dstCSR( "dstCSR", storage, level, level );
+   FunctionType difference( "difference", storage, level, level );
+
+   u.interpolate( []( const Point3D& ) { return real_c( walberla::math::realRandom( 0.0, 1.0 ) ); }, level, All );
+
+   for ( auto updateType : { Replace, Add } )
+   {
+      dstMatrixFree.interpolate( real_c( 1 ), level, All );
+      dstCSR.interpolate( real_c( 1 ), level, All );
+
+      A.apply( u, dstMatrixFree, level, Inner | NeumannBoundary, updateType );
+      A_csr.apply( u, dstCSR, level, Inner | NeumannBoundary, updateType );
+
+      difference.assign( { real_c( 1 ), real_c( -1 ) }, { dstMatrixFree, dstCSR }, level, All );
+      const real_t error = difference.getMaxDoFMagnitude( level );
+      WALBERLA_LOG_INFO_ON_ROOT( name << ", apply (" << ( updateType == Replace ? "Replace" : "Add" )
+                                      << "), max error: " << error );
+      WALBERLA_CHECK_LESS( error, tolerance );
+   }
+
+   A.computeInverseDiagonalOperatorValues();
+   A_csr.computeInverseDiagonalOperatorValues();
+
+   difference.assign(
+       { real_c( 1 ), real_c( -1 ) }, { *A.getInverseDiagonalValues(), *A_csr.getInverseDiagonalValues() }, level, Inner );
+   const real_t errorDiagonal = difference.getMaxDoFMagnitude( level );
+   WALBERLA_LOG_INFO_ON_ROOT( name << ", inverse diagonal, max error: " << errorDiagonal );
+   WALBERLA_CHECK_LESS( errorDiagonal, tolerance );
+}
+
+void testMultigrid( const std::shared_ptr< PrimitiveStorage >& storage, uint_t minLevel, uint_t maxLevel )
+{
+   using OperatorType = CSRMatrixOperator< P1ElementwiseLaplaceOperator >;
+
+   P1ElementwiseLaplaceOperator A( storage, minLevel, maxLevel );
+   OperatorType                 A_csr( A, minLevel, maxLevel );
+   A_csr.computeInverseDiagonalOperatorValues();
+
+   P1Function< real_t > u( "u", storage, minLevel, maxLevel );
+   P1Function< real_t > f( "f", storage, minLevel, maxLevel );
+   P1Function< real_t > r( "r", storage, minLevel, maxLevel );
+
+   u.interpolate( []( const Point3D& ) { return real_c( walberla::math::realRandom( 0.0, 1.0 ) ); }, maxLevel, Inner );
+
+   auto smoother =
+       std::make_shared< WeightedJacobiSmoother< OperatorType > >( storage, minLevel, maxLevel, real_c( 2.0 / 3.0 ) );
+   auto coarseSolver = std::make_shared< CGSolver< OperatorType > >( storage, minLevel, minLevel );
+   auto restriction  = std::make_shared< P1toP1LinearRestriction<> >();
+   auto prolongation = std::make_shared< P1toP1LinearProlongation<> >();
+
+   GeometricMultigridSolver< OperatorType > gmg(
+       storage, smoother, coarseSolver, restriction, prolongation, minLevel, maxLevel, 3, 3 );
+
+   A_csr.apply( u, r, maxLevel, Inner );
+   real_t lastResidual = std::sqrt( r.dotGlobal( r, maxLevel, Inner ) );
+
+   for ( uint_t cycle = 1; cycle <= 5; ++cycle )
+   {
+      gmg.solve( A_csr, u, f, maxLevel );
+
+      // the residual is computed matrix-free to check the assembled operators
+      A.apply( u, r, maxLevel, Inner );
+      const real_t residual = std::sqrt( r.dotGlobal( r, maxLevel, Inner ) );
+      WALBERLA_LOG_INFO_ON_ROOT( "GMG cycle " << cycle << ", residual: " << residual << ", rate: " << residual / lastResidual );
+      WALBERLA_CHECK_LESS( residual / lastResidual, real_c( 0.2 ) );
+      lastResidual = residual;
+   }
+}
+
+int main( int argc, char** argv )
+{
+   walberla::debug::enterTestMode();
+   walberla::mpi::Environment MPIenv( argc, argv );
+   walberla::MPIManager::instance()->useWorldComm();
+
+   // 2D
+   {
+      MeshInfo meshInfo = MeshInfo::meshRectangle( Point2D( 0, 0 ), Point2D( 2, 1 ), MeshInfo::CRISSCROSS, 2, 2 );
+      SetupPrimitiveStorage setupStorage( meshInfo, uint_c( walberla::mpi::MPIManager::instance()->numProcesses() ) );
+      setupStorage.setMeshBoundaryFlagsOnBoundary( 1, 0, true );
+      auto storage = std::make_shared< PrimitiveStorage >( setupStorage );
+
+      testApply< P1ElementwiseLaplaceOperator >( storage, 3, "2D, P1" );
+      testApply< P2ElementwiseLaplaceOperator >( storage, 3, "2D, P2" );
+      testMultigrid( storage, 1, 5 );
+   }
+
+   // 3D
+   {
+      MeshInfo meshInfo = MeshInfo::meshSymmetricCuboid( Point3D( 0, 0, 0 ), Point3D( 1, 1, 1 ), 1, 1, 1 );
+      SetupPrimitiveStorage setupStorage( meshInfo, uint_c( walberla::mpi::MPIManager::instance()->numProcesses() ) );
+      setupStorage.setMeshBoundaryFlagsOnBoundary( 1, 0, true );
+      auto storage = std::make_shared< PrimitiveStorage >( setupStorage );
+
+      testApply< P1ElementwiseLaplaceOperator >( storage, 2, "3D, P1" );
+      testApply< P2ElementwiseLaplaceOperator >( storage, 2, "3D, P2" );
+      testMultigrid( storage, 0, 3 );
+   }
+
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2026 Nils Kohl, Marcus Mohr.
+ *
+ * This file is part of HyTeG
+ * (see https://i10git.cs.fau.de/hyteg/hyteg).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "core/DataTypes.h"
+#include "core/mpi/MPIManager.h"
+
+#include "hyteg/elementwiseoperators/P2ElementwiseOperator.hpp"
+#include "hyteg/mesh/MeshInfo.hpp"
+#include "hyteg/p2functionspace/P2Function.hpp"
+#include "hyteg/primitivestorage/SetupPrimitiveStorage.hpp"
+#include "hyteg/primitivestorage/loadbalancing/SimpleBalancer.hpp"
+
+// This test checks that the application of the P2ElementwiseOperator with the halo exchange overlapped with the
+// computation (setOverlapCommunication( true )) yields the same result as the standard application.
+
+using walberla::real_t;
+using namespace hyteg;
+
+template < typename OpType >
+void overlapCommunicationTest( const std::shared_ptr< PrimitiveStorage >& storage, const uint_t level, bool precompute )
+{
+   const real_t epsilon = real_c( std::is_same< real_t, double >() ? 1e-12 : 1e-5 );
+
+   P2Function< real_t > src( "src", storage, level, level );
+   P2Function< real_t > dstBlocking( "dstBlocking", storage, level, level );
+   P2Function< real_t > dstOverlap( "dstOverlap", storage, level, level );
+   P2Function< real_t > error( "error", storage, level, level );
+
+   OpType blockingOp( storage, level, level );
+   OpType overlapOp( storage, level, level );
+   overlapOp.setOverlapCommunication( true );
+
+   if ( precompute )
+   {
+      blockingOp.computeAndStoreLocalElementMatrices();
+      overlapOp.computeAndStoreLocalElementMatrices();
+   }
+
+   auto srcFunction = []( const Point3D& x ) {
+      return std::sin( x[0] ) + 6.0 * std::sin( x[1] * x[1] * x[1] ) + x[2] * x[2] * x[2];
+   };
+
+   auto dstFunction = []( const Point3D& x ) { return 2 * std::sin( 2.0 * x[0] ) + 7.0 * std::cos( x[1] ) + x[2]; };
+
+   src.interpolate( srcFunction, level, All );
+
+   // replace
+   blockingOp.apply( src, dstBlocking, level, All, Replace );
+   overlapOp.apply( src, dstOverlap, level, All, Replace );
+
+   error.assign( { 1.0, -1.0 }, { dstBlocking, dstOverlap }, level, All );
+   WALBERLA_CHECK_LESS( error.getMaxDoFMagnitude( level ), epsilon, "replace" );
+
+   // add
+   blockingOp.apply( src, dstBlocking, level, Inner, Add );
+   overlapOp.apply( src, dstOverlap, level, Inner, Add );
+
+   error.assign( { 1.0, -1.0 }, { dstBlocking, dstOverlap }, level, All );
+   WALBERLA_CHECK_LESS( error.getMaxDoFMagnitude( level ), epsilon, "add" );
+
+   // gemv
+   dstBlocking.interpolate( dstFunction, level, All );
+   dstOverlap.interpolate( dstFunction, level, All );
+   blockingOp.gemv( real_c( 0.5 ), src, real_c( -2.0 ), dstBlocking, level, All );
+   overlapOp.gemv( real_c( 0.5 ), src, real_c( -2.0 ), dstOverlap, level, All );
+
+   error.assign( { 1.0, -1.0 }, { dstBlocking, dstOverlap }, level, All );
+   WALBERLA_CHECK_LESS( error.getMaxDoFMagnitude( level ), epsilon, "gemv" );
+}
+
+int main( int argc, char* argv[] )
+{
+   walberla::MPIManager::instance()->initializeMPI( &argc, &argv );
+   walberla::MPIManager::instance()->useWorldComm();
+
+   const uint_t numProcesses = walberla::uint_c( walberla::mpi::MPIManager::instance()->numProcesses() );
+
+   MeshInfo              meshInfo2D = MeshInfo::fromGmshFile( prependHyTeGMeshDir( "2D/quad_16el.msh" ) );
+   SetupPrimitiveStorage setupStorage2D( meshInfo2D, numProcesses );
+   loadbalancing::roundRobin( setupStorage2D );
+   auto storage2D = std::make_shared< PrimitiveStorage >( setupStorage2D );
+
+   MeshInfo              meshInfo3D = MeshInfo::fromGmshFile( prependHyTeGMeshDir( "3D/pyramid_tilted_4el.msh" ) );
+   SetupPrimitiveStorage setupStorage3D( meshInfo3D, numProcesses );
+   loadbalancing::roundRobin( setupStorage3D );
+   auto storage3D = std::make_shared< PrimitiveStorage >( setupStorage3D );
+
+   for ( bool precompute : { false, true } )
+   {
+      for ( uint_t level = 2; level <= 4; level++ )
+      {
+         WALBERLA_LOG_INFO_ON_ROOT( "2D, level " << level << ", precomputed element matrices: " << precompute )
+         overlapCommunicationTest< P2ElementwiseLaplaceOperator >( storage2D, level, precompute );
+         overlapCommunicationTest< P2ElementwiseMassOperator >( storage2D, level, precompute );
+      }
+
+      for ( uint_t level = 2; level <= 3; level++ )
+      {
+         WALBERLA_LOG_INFO_ON_ROOT( "3D, level " << level << ", precomputed element matrices: " << precompute )
+         overlapCommunicationTest< P2ElementwiseLaplaceOperator >( storage3D, level, precompute );
+         overlapCommunicationTest< P2ElementwiseMassOperator >( storage3D, level, precompute );
+      }
+   }
+
+   return 0;
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2026 Nils Kohl, Marcus Mohr.
+ *
+ * This file is part of HyTeG
+ * (see https://i10git.cs.fau.de/hyteg/hyteg).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "core/DataTypes.h"
+#include "core/mpi/MPIManager.h"
+
+#include "hyteg/elementwiseoperators/P2ElementwiseOperator.hpp"
+#include "hyteg/mesh/MeshInfo.hpp"
+#include "hyteg/p2functionspace/P2Function.hpp"
+#include "hyteg/primitivestorage/SetupPrimitiveStorage.hpp"
+#include "hyteg/primitivestorage/loadbalancing/SimpleBalancer.hpp"
+
+// This test checks that the application of the P2ElementwiseOperator with compressed pre-computed local element
+// matrices (upper triangle and/or single precision) yields the same result as with on-the-fly assembly, and that
+// the reported memory footprint matches the storage format.
+
+using walberla::real_t;
+using namespace hyteg;
+
+void compressedElementMatricesTest( const std::shared_ptr< PrimitiveStorage >& storage, const uint_t level )
+{
+   P2Function< real_t > src( "src", storage, level, level );
+   P2Function< real_t > dstReference( "dstReference", storage, level, level );
+   P2Function< real_t > dst( "dst", storage, level, level );
+   P2Function< real_t > error( "error", storage, level, level );
+
+   P2ElementwiseLaplaceOperator onTheFlyOp( storage, level, level );
+   P2ElementwiseLaplaceOperator precomputedOp( storage, level, level );
+
+   auto srcFunction = []( const Point3D& x ) {
+      return std::sin( x[0] ) + 6.0 * std::sin( x[1] * x[1] * x[1] ) + x[2] * x[2] * x[2];
+   };
+   src.interpolate( srcFunction, level, All );
+
+   onTheFlyOp.apply( src, dstReference, level, All, Replace );
+   const real_t referenceMax = dstReference.getMaxDoFMagnitude( level );
+
+   WALBERLA_CHECK_EQUAL( onTheFlyOp.getLocalElementMatricesGlobalMemoryInBytes(), 0ULL );
+
+   precomputedOp.computeAndStoreLocalElementMatrices();
+   const auto fullMemory = precomputedOp.getLocalElementMatricesGlobalMemoryInBytes();
+   WALBERLA_CHECK_GREATER( fullMemory, 0ULL );
+
+   const uint_t numRowsAndCols = storage->hasGlobalCells() ? 10 : 6;
+   const real_t upperTriangleRatio =
+       real_c( numRowsAndCols * ( numRowsAndCols + 1 ) / 2 ) / real_c( numRowsAndCols * numRowsAndCols );
+
+   for ( bool upperTriangleOnly : { false, true } )
+   {
+      for ( bool singlePrecision : { false, true } )
+      {
+         precomputedOp.computeAndStoreLocalElementMatrices( upperTriangleOnly, singlePrecision );
+         precomputedOp.apply( src, dst, level, All, Replace );
+
+         error.assign( { 1.0, -1.0 }, { dstReference, dst }, level, All );
+         const real_t relativeError = error.getMaxDoFMagnitude( level ) / referenceMax;
+
+         real_t expectedMemoryRatio = upperTriangleOnly ? upperTriangleRatio : real_c( 1 );
+         if ( singlePrecision )
+         {
+            expectedMemoryRatio *= real_c( sizeof( float ) ) / real_c( sizeof( real_t ) );
+         }
+         const real_t memoryRatio =
+             real_c( precomputedOp.getLocalElementMatricesGlobalMemoryInBytes() ) / real_c( fullMemory );
+
+         WALBERLA_LOG_INFO_ON_ROOT( "upper triangle only: " << upperTriangleOnly << ", single precision: " << singlePrecision
+                                                            << " | relative error: " << relativeError
+                                                            << " | memory ratio: " << memoryRatio )
+
+         const real_t tolerance = singlePrecision || std::is_same< real_t, float >() ? real_c( 1e-4 ) : real_c( 1e-12 );
+         WALBERLA_CHECK_LESS( relativeError, tolerance );
+         WALBERLA_CHECK_FLOAT_EQUAL( memoryRatio, expectedMemoryRatio );
+      }
+   }
+}
+
+int main( int argc, char* argv[] )
+{
+   walberla::MPIManager::instance()->initializeMPI( &argc, &argv );
+   walberla::MPIManager::instance()->useWorldComm();
+
+   const uint_t numProcesses = walberla::uint_c( walberla::mpi::MPIManager::instance()->numProcesses() );
+
+   MeshInfo              meshInfo2D = MeshInfo::fromGmshFile( prependHyTeGMeshDir( "2D/quad_8el.msh" ) );
+   SetupPrimitiveStorage setupStorage2D( meshInfo2D, numProcesses );
+   loadbalancing::roundRobin( setupStorage2D );
+   auto storage2D = std::make_shared< PrimitiveStorage >( setupStorage2D );
+
+   MeshInfo              meshInfo3D = MeshInfo::fromGmshFile( prependHyTeGMeshDir( "3D/cube_6el.msh" ) );
+   SetupPrimitiveStorage setupStorage3D( meshInfo3D, numProcesses );
+   loadbalancing::roundRobin( setupStorage3D );
+   auto storage3D = std::make_shared< PrimitiveStorage >( setupStorage3D );
+
+   WALBERLA_LOG_INFO_ON_ROOT( "2D" )
+   compressedElementMatricesTest( storage2D, 4 );
+
+   WALBERLA_LOG_INFO_ON_ROOT( "3D" )
+   compressedElementMatricesTest( storage3D, 3 );
+
+   return 0;
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2026 Nils Kohl, Marcus Mohr.
+ *
+ * This file is part of HyTeG
+ * (see https://i10git.cs.fau.de/hyteg/hyteg).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "core/DataTypes.h"
+#include "core/math/Random.h"
+#include "core/mpi/MPIManager.h"
+
+#include "hyteg/elementwiseoperators/P2ElementwiseOperator.hpp"
+#include "hyteg/mesh/MeshInfo.hpp"
+#include "hyteg/p2functionspace/P2Function.hpp"
+#include "hyteg/primitivestorage/SetupPrimitiveStorage.hpp"
+#include "hyteg/primitivestorage/loadbalancing/SimpleBalancer.hpp"
+
+// This test checks the multicolour SOR smoother of the P2ElementwiseOperator. For a homogeneous problem, the energy
+// norm of the error has to decrease in each forward and backward sweep. The results with pre-computed and with
+// recomputed local element matrices have to agree.
+
+using walberla::real_t;
+using namespace hyteg;
+
+real_t energyNorm( const P2ElementwiseLaplaceOperator& A, const P2Function< real_t >& u, P2Function< real_t >& tmp, uint_t level )
+{
+   A.apply( u, tmp, level, Inner, Replace );
+   return std::sqrt( u.dotGlobal( tmp, level, Inner ) );
+}
+
+void sorSmoothTest( const std::shared_ptr< PrimitiveStorage >& storage, const uint_t level, const real_t relax )
+{
+   P2Function< real_t > u( "u", storage, level, level );
+   P2Function< real_t > uPrecomputed( "uPrecomputed", storage, level, level );
+   P2Function< real_t > rhs( "rhs", storage, level, level );
+   P2Function< real_t > tmp( "tmp", storage, level, level );
+
+   P2ElementwiseLaplaceOperator onTheFlyOp( storage, level, level );
+   P2ElementwiseLaplaceOperator precomputedOp( storage, level, level );
+   precomputedOp.computeAndStoreLocalElementMatrices();
+
+   u.interpolate( []( const Point3D& ) { return walberla::math::realRandom( real_c( -1 ), real_c( 1 ) ); }, level, Inner );
+   uPrecomputed.assign( { real_c( 1 ) }, { u }, level, All );
+
+   real_t previousNorm = energyNorm( onTheFlyOp, u, tmp, level );
+   const real_t initialNorm = previousNorm;
+
+   for ( uint_t sweep = 0; sweep < 10; ++sweep )
+   {
+      if ( sweep % 2 == 0 )
+      {
+         onTheFlyOp.smooth_sor( u, rhs, relax, level, Inner );
+         precomputedOp.smooth_sor( uPrecomputed, rhs, relax, level, Inner );
+      }
+      else
+      {
+         onTheFlyOp.smooth_sor_backwards( u, rhs, relax, level, Inner );
+         precomputedOp.smooth_sor_backwards( uPrecomputed, rhs, relax, level, Inner );
+      }
+
+      const real_t norm = energyNorm( onTheFlyOp, u, tmp, level );
+      WALBERLA_LOG_INFO_ON_ROOT( "sweep " << sweep << " | energy norm of the error: " << norm )
+      WALBERLA_CHECK_LESS( norm, previousNorm );
+      previousNorm = norm;
+
+      tmp.assign( { 1.0, -1.0 }, { u, uPrecomputed }, level, All );
+      WALBERLA_CHECK_LESS( tmp.getMaxDoFMagnitude( level ),
+                           std::is_same< real_t, double >() ? real_c( 1e-12 ) : real_c( 1e-4 ) );
+   }
+
+   WALBERLA_CHECK_LESS( previousNorm, real_c( 0.5 ) * initialNorm );
+}
+
+int main( int argc, char* argv[] )
+{
+   walberla::MPIManager::instance()->initializeMPI( &argc, &argv );
+   walberla::MPIManager::instance()->useWorldComm();
+
+   walberla::math::seedRandomGenerator( 42 + walberla::uint_c( walberla::mpi::MPIManager::instance()->rank() ) );
+
+   const uint_t numProcesses = walberla::uint_c( walberla::mpi::MPIManager::instance()->numProcesses() );
+
+   MeshInfo              meshInfo2D = MeshInfo::fromGmshFile( prependHyTeGMeshDir( "2D/quad_8el.msh" ) );
+   SetupPrimitiveStorage setupStorage2D( meshInfo2D, numProcesses );
+   loadbalancing::roundRobin( setupStorage2D );
+   auto storage2D = std::make_shared< PrimitiveStorage >( setupStorage2D );
+
+   MeshInfo              meshInfo3D = MeshInfo::fromGmshFile( prependHyTeGMeshDir( "3D/cube_6el.msh" ) );
+   SetupPrimitiveStorage setupStorage3D( meshInfo3D, numProcesses );
+   loadbalancing::roundRobin( setupStorage3D );
+   auto storage3D = std::make_shared< PrimitiveStorage >( setupStorage3D );
+
+   for ( real_t relax : { real_c( 1 ), real_c( 1.3 ) } )
+   {
+      WALBERLA_LOG_INFO_ON_ROOT( "2D, relax = " << relax )
+      sorSmoothTest( storage2D, 4, relax );
+
+      WALBERLA_LOG_INFO_ON_ROOT( "3D, relax = " << relax )
+      sorSmoothTest( storage3D, 3, relax );
+   }
+
+   return 0;
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2026 Nils Kohl, Marcus Mohr.
+ *
+ * This file is part of HyTeG
+ * (see https://i10git.cs.fau.de/hyteg/hyteg).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <core/DataTypes.h>
+#include <core/math/Random.h>
+#include <core/mpi/MPIManager.h>
+#include <hyteg/elementwiseoperators/P2ElementwiseOperator.hpp>
+#include <hyteg/elementwiseoperators/P2ElementwiseSurrogateOperator.hpp>
+#include <hyteg/primitivestorage/PrimitiveStorage.hpp>
+#include <hyteg/primitivestorage/SetupPrimitiveStorage.hpp>
+#include <hyteg/primitivestorage/loadbalancing/SimpleBalancer.hpp>
+
+using walberla::real_t;
+using namespace hyteg;
+
+/* This test checks whether the P2 elementwise surrogate
+   operator works correctly. As for the P1 operator,
+   we verify the following theorem:
+   Let A be the discrete operator associated with
+      -div(k grad(u)) = f,
+   on an affine mesh, where k is a polynomial of degree p.
+   Then, for the surrogate operator A_q, defined
+   by polynomials of degree q, it holds
+      q>=p => A_q = A.
+   On level 3, the precomputed local matrices are used instead of the surrogates.
+*/
+template < uint8_t DEGREE >
+void P2SurrogateOperatorTest( const std::shared_ptr< PrimitiveStorage >& storage, const uint_t level )
+{
+   WALBERLA_LOG_INFO_ON_ROOT( "" );
+   WALBERLA_LOG_INFO_ON_ROOT( walberla::format( "level=%d, degree=%d", level, DEGREE ) );
+
+   double epsilon, errorMax;
+
+   // setup pde coefficient k ∈ P_q
+   hyteg::surrogate::polynomial::Polynomial< real_t, 3, DEGREE > k_poly;
+   for ( auto& c : k_poly )
+   {
+      c = walberla::math::realRandom();
+   }
+   auto k = [&]( const hyteg::Point3D& x ) { return k_poly.eval_naive( x ); };
+
+   // operators
+   forms::p2_div_k_grad_affine_q4                         form( k, k );
+   P2ElementwiseAffineDivKGradOperator                    A( storage, level, level, form );
+   P2ElementwiseSurrogateAffineDivKGradOperator< DEGREE > A_q( storage, level, level, form );
+
+   A_q.init( 1, "", false );
+
+   // functions
+   hyteg::P2Function< real_t > u( "u", storage, level, level );
+   hyteg::P2Function< real_t > Au( "Au", storage, level, level );
+   hyteg::P2Function< real_t > Aqu( "(A_q)u", storage, level, level );
+   hyteg::P2Function< real_t > err( "(A-A_q)u", storage, level, level );
+
+   std::function< real_t( const hyteg::Point3D& ) > initialU = []( const hyteg::Point3D& x ) {
+      return cos( 2 * M_PI * x[0] ) * cos( 2 * M_PI * x[1] ) * cos( 2 * M_PI * x[2] );
+   };
+   u.interpolate( initialU, level );
+
+   epsilon = std::is_same< real_t, double >() ? 1e-10 : 1e-4;
+
+   // apply operators
+   A.apply( u, Au, level, All, Replace );
+   A_q.apply( u, Aqu, level, All, Replace );
+   err.assign( { 1.0, -1.0 }, { Au, Aqu }, level, All );
+   errorMax = err.getMaxDoFMagnitude( level );
+   WALBERLA_LOG_INFO_ON_ROOT( walberla::format( "%37s = %e", "||(A - A_q)u||_inf", errorMax ) )
+   WALBERLA_CHECK_LESS( errorMax, epsilon, "||(A - A_q)u||_inf" );
+
+   // diagonal values
+   A.computeDiagonalOperatorValues();
+   A_q.computeDiagonalOperatorValues();
+   err.assign( { 1.0, -1.0 }, { *A.getDiagonalValues(), *A_q.getDiagonalValues() }, level, All );
+   errorMax = err.getMaxDoFMagnitude( level );
+   WALBERLA_LOG_INFO_ON_ROOT( walberla::format( "%37s = %e", "||diag(A) - diag(A_q)||_inf", errorMax ) )
+   WALBERLA_CHECK_LESS( errorMax, epsilon, "||diag(A) - diag(A_q)||_inf" );
+}
+
+int main( int argc, char* argv[] )
+{
+   // General setup stuff
+   walberla::MPIManager::instance()->initializeMPI( &argc, &argv );
+   walberla::MPIManager::instance()->useWorldComm();
+
+   MeshInfo              meshInfo = MeshInfo::meshCuboid( Point3D( 0.0, 0.0, 0.0 ), Point3D( 1.0, 1.0, 1.0 ), 1, 1, 1 );
+   SetupPrimitiveStorage setupStorage( meshInfo, walberla::uint_c( walberla::mpi::MPIManager::instance()->numProcesses() ) );
+   loadbalancing::roundRobin( setupStorage );
+   std::shared_ptr< PrimitiveStorage > storage = std::make_shared< PrimitiveStorage >( setupStorage );
+
+   for ( uint_t lvl = 3; lvl <= 4; ++lvl )
+   {
+      P2SurrogateOperatorTest< 1 >( storage, lvl );
+      P2SurrogateOperatorTest< 2 >( storage, lvl );
+      P2SurrogateOperatorTest< 3 >( storage, lvl );
+   }
+   return 0;
+}
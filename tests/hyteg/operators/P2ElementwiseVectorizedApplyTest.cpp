@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2026 Nils Kohl, Marcus Mohr.
+ *
+ * This file is part of HyTeG
+ * (see https://i10git.cs.fau.de/hyteg/hyteg).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "core/DataTypes.h"
+#include "core/mpi/MPIManager.h"
+
+#include "hyteg/elementwiseoperators/P2ElementwiseOperator.hpp"
+#include "hyteg/mesh/MeshInfo.hpp"
+#include "hyteg/p2functionspace/P2Function.hpp"
+#include "hyteg/primitivestorage/SetupPrimitiveStorage.hpp"
+#include "hyteg/primitivestorage/loadbalancing/SimpleBalancer.hpp"
+
+// This test checks that the 3D application of the P2ElementwiseOperator that processes batches of micro-cells with SIMD
+// instructions (setVectorizedApply( true )) yields the same result as processing the micro-cells one by one.
+
+using walberla::real_t;
+using namespace hyteg;
+
+enum class ElementMatrices
+{
+   ON_THE_FLY,
+   PRECOMPUTED,
+   PRECOMPUTED_COMPRESSED
+};
+
+template < typename OpType >
+void vectorizedApplyTest( const std::shared_ptr< PrimitiveStorage >& storage, const uint_t level, ElementMatrices elementMatrices )
+{
+   const real_t epsilon = real_c( std::is_same< real_t, double >() ? 1e-12 : 1e-5 );
+
+   P2Function< real_t > src( "src", storage, level, level );
+   P2Function< real_t > dstScalar( "dstScalar", storage, level, level );
+   P2Function< real_t > dstVectorized( "dstVectorized", storage, level, level );
+   P2Function< real_t > error( "error", storage, level, level );
+
+   OpType scalarOp( storage, level, level );
+   OpType vectorizedOp( storage, level, level );
+   scalarOp.setVectorizedApply( false );
+   vectorizedOp.setVectorizedApply( true );
+
+   if ( elementMatrices == ElementMatrices::PRECOMPUTED )
+   {
+      scalarOp.computeAndStoreLocalElementMatrices();
+      vectorizedOp.computeAndStoreLocalElementMatrices();
+   }
+   else if ( elementMatrices == ElementMatrices::PRECOMPUTED_COMPRESSED )
+   {
+      scalarOp.computeAndStoreLocalElementMatrices( true, true );
+      vectorizedOp.computeAndStoreLocalElementMatrices( true, true );
+   }
+
+   auto srcFunction = []( const Point3D& x ) {
+      return std::sin( x[0] ) + 6.0 * std::sin( x[1] * x[1] * x[1] ) + x[2] * x[2] * x[2];
+   };
+
+   auto dstFunction = []( const Point3D& x ) { return 2 * std::sin( 2.0 * x[0] ) + 7.0 * std::cos( x[1] ) + x[2]; };
+
+   src.interpolate( srcFunction, level, All );
+
+   // replace
+   scalarOp.apply( src, dstScalar, level, All, Replace );
+   vectorizedOp.apply( src, dstVectorized, level, All, Replace );
+
+   const real_t scale = dstScalar.getMaxDoFMagnitude( level );
+
+   error.assign( { 1.0, -1.0 }, { dstScalar, dstVectorized }, level, All );
+   WALBERLA_CHECK_LESS( error.getMaxDoFMagnitude( level ), epsilon * scale, "replace" );
+
+   // add
+   scalarOp.apply( src, dstScalar, level, Inner, Add );
+   vectorizedOp.apply( src, dstVectorized, level, Inner, Add );
+
+   error.assign( { 1.0, -1.0 }, { dstScalar, dstVectorized }, level, All );
+   WALBERLA_CHECK_LESS( error.getMaxDoFMagnitude( level ), epsilon * scale, "add" );
+
+   // gemv
+   dstScalar.interpolate( dstFunction, level, All );
+   dstVectorized.interpolate( dstFunction, level, All );
+   scalarOp.gemv( real_c( 0.5 ), src, real_c( -2.0 ), dstScalar, level, All );
+   vectorizedOp.gemv( real_c( 0.5 ), src, real_c( -2.0 ), dstVectorized, level, All );
+
+   error.assign( { 1.0, -1.0 }, { dstScalar, dstVectorized }, level, All );
+   WALBERLA_CHECK_LESS( error.getMaxDoFMagnitude( level ), epsilon * scale, "gemv" );
+}
+
+int main( int argc, char* argv[] )
+{
+   walberla::MPIManager::instance()->initializeMPI( &argc, &argv );
+   walberla::MPIManager::instance()->useWorldComm();
+
+   const uint_t numProcesses = walberla::uint_c( walberla::mpi::MPIManager::instance()->numProcesses() );
+
+   for ( const auto& meshFile : { "3D/pyramid_tilted_4el.msh", "3D/cube_6el.msh" } )
+   {
+      MeshInfo              meshInfo = MeshInfo::fromGmshFile( prependHyTeGMeshDir( meshFile ) );
+      SetupPrimitiveStorage setupStorage( meshInfo, numProcesses );
+      loadbalancing::roundRobin( setupStorage );
+      auto storage = std::make_shared< PrimitiveStorage >( setupStorage );
+
+      for ( auto elementMatrices :
+            { ElementMatrices::ON_THE_FLY, ElementMatrices::PRECOMPUTED, ElementMatrices::PRECOMPUTED_COMPRESSED } )
+      {
+         for ( uint_t level = 2; level <= 4; level++ )
+         {
+            WALBERLA_LOG_INFO_ON_ROOT( meshFile << ", level " << level << ", element matrices: " << int( elementMatrices ) )
+            vectorizedApplyTest< P2ElementwiseLaplaceOperator >( storage, level, elementMatrices );
+            vectorizedApplyTest< P2ElementwiseMassOperator >( storage, level, elementMatrices );
+         }
+      }
+   }
+
+   return 0;
+}
@@ -143,11 +143,26 @@ void PolynomialTest()
    // evaluate 1d polynomial by Horner's method
    real_t px_horner = p.eval( x[0] );
 
+   // ---------------------------------------------------------
+   /// evaluate p along a line using eval_line (restriction is still fixed)
+   // ---------------------------------------------------------
+   constexpr uint_t      n_line = 37;
+   const real_t          h      = real_t( 0.1 ) * realRandom();
+   std::vector< real_t > p_line( n_line );
+   p.eval_line( x[0], h, n_line, p_line.data() );
+
    // ---------------------------------------------------------
    /// compare solutions
    // ---------------------------------------------------------
    check( "Naive evaluation", px_manual, px_naive );
    check( "Horner's method", px_manual, px_horner );
+   check( "Line evaluation", px_manual, p_line[0] );
+   for ( uint_t i = 1; i < n_line; ++i )
+   {
+      constexpr double epsilon = std::is_same< real_t, double >() ? 1e-14 : 1e-6;
+      const real_t     p_i     = p.eval( x[0] + real_t( i ) * h );
+      WALBERLA_CHECK_LESS_EQUAL( std::abs( p_line[i] - p_i ), epsilon * std::abs( p_i ), "line evaluation at x_" << i );
+   }
 }
 
 int main( int argc, char* argv[] )
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2026 Nils Kohl, Marcus Mohr.
+ *
+ * This file is part of HyTeG
+ * (see https://i10git.cs.fau.de/hyteg/hyteg).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Solves Poisson problems with the algebraic multigrid solver, standalone (with the dense and the iterative coarsest
+// grid solver) and as coarse grid solver of the GMG solver.
+
+#include "core/Environment.h"
+#include "core/debug/CheckFunctions.h"
+
+#include "hyteg/elementwiseoperators/P1ElementwiseOperator.hpp"
+#include "hyteg/gridtransferoperators/P1toP1LinearProlongation.hpp"
+#include "hyteg/gridtransferoperators/P1toP1LinearRestriction.hpp"
+#include "hyteg/p1functionspace/P1Function.hpp"
+#include "hyteg/primitivestorage/SetupPrimitiveStorage.hpp"
+#include "hyteg/solvers/AlgebraicMultigridSolver.hpp"
+#include "hyteg/solvers/GeometricMultigridSolver.hpp"
+#include "hyteg/solvers/WeightedJacobiSmoother.hpp"
+
+using walberla::real_c;
+using walberla::real_t;
+using walberla::uint_c;
+using walberla::uint_t;
+
+using namespace hyteg;
+
+real_t residualNorm( const P1ElementwiseLaplaceOperator& A,
+                     const P1Function< real_t >&         u,
+                     const P1Function< real_t >&         f,
+                     const P1Function< real_t >&         r,
+                     uint_t                              level )
+{
+   A.apply( u, r, level, Inner );
+   r.assign( { real_c( 1 ), real_c( -1 ) }, { f, r }, level, Inner );
+   return std::sqrt( r.dotGlobal( r, level, Inner ) );
+}
+
+void testStandalone( const std::shared_ptr< PrimitiveStorage >& storage,
+                     uint_t                                     level,
+                     const std::string&                         name,
+                     bool                                       denseCoarseSolver )
+{
+   const real_t tolerance = std::is_same_v< real_t, double > ? real_c( 1e-8 ) : real_c( 1e-3 );
+
+   P1ElementwiseLaplaceOperator A( storage, level, level );
+
+   P1Function< real_t > u( "u", storage, level, level );
+   P1Function< real_t > f( "f", storage, level, level );
+   P1Function< real_t > r( "r", storage, level, level );
+
+   // inhomogeneous Dirichlet BCs and a nonzero right-hand side
+   u.interpolate( []( const Point3D& x ) { return x[0] * x[0] - x[1] + x[2]; }, level, DirichletBoundary );
+   f.interpolate( real_c( 1 ), level, Inner );
+
+   AlgebraicMultigridSolver< P1ElementwiseLaplaceOperator > amg( storage, level, 50, real_c( 1e-10 ) );
+   amg.setMaxCoarseSize( 50 );
+   if ( !denseCoarseSolver )
+   {
+      // forces the iterative solver on the coarsest grid
+      amg.setMaxDenseCoarseSize( 0 );
+   }
+
+   const real_t initialResidual = residualNorm( A, u, f, r, level );
+   amg.solve( A, u, f, level );
+   const real_t finalResidual = residualNorm( A, u, f, r, level );
+
+   WALBERLA_LOG_INFO_ON_ROOT( name << ( denseCoarseSolver ? ", dense LU" : ", CG" ) << ", AMG levels: " << amg.getNumLevels()
+                                   << ", residual reduction: " << finalResidual / initialResidual );
+   WALBERLA_CHECK_GREATER( amg.getNumLevels(), 1 );
+   WALBERLA_CHECK_LESS( finalResidual / initialResidual, tolerance );
+}
+
+void testCoarseGridSolver( const std::shared_ptr< PrimitiveStorage >& storage, uint_t minLevel, uint_t maxLevel )
+{
+   using OperatorType = P1ElementwiseLaplaceOperator;
+
+   OperatorType A( storage, minLevel, maxLevel );
+   A.computeInverseDiagonalOperatorValues();
+
+   P1Function< real_t > u( "u", storage, minLevel, maxLevel );
+   P1Function< real_t > f( "f", storage, minLevel, maxLevel );
+   P1Function< real_t > r( "r", storage, minLevel, maxLevel );
+
+   f.interpolate( real_c( 1 ), maxLevel, Inner );
+
+   auto coarseSolver = std::make_shared< AlgebraicMultigridSolver< OperatorType > >( storage, minLevel, 20, real_c( 1e-8 ) );
+   coarseSolver->setMaxCoarseSize( 50 );
+
+   auto smoother =
+       std::make_shared< WeightedJacobiSmoother< OperatorType > >( storage, minLevel, maxLevel, real_c( 2.0 / 3.0 ) );
+   auto restriction  = std::make_shared< P1toP1LinearRestriction<> >();
+   auto prolongation = std::make_shared< P1toP1LinearProlongation<> >();
+
+   GeometricMultigridSolver< OperatorType > gmg(
+       storage, smoother, coarseSolver, restriction, prolongation, minLevel, maxLevel, 3, 3 );
+
+   real_t lastResidual = residualNorm( A, u, f, r, maxLevel );
+   for ( uint_t cycle = 1; cycle <= 5; ++cycle )
+   {
+      gmg.solve( A, u, f, maxLevel );
+      const real_t residual = residualNorm( A, u, f, r, maxLevel );
+      WALBERLA_LOG_INFO_ON_ROOT( "GMG cycle " << cycle << ", residual: " << residual << ", rate: " << residual / lastResidual );
+      WALBERLA_CHECK_LESS( residual / lastResidual, real_c( 0.3 ) );
+      lastResidual = residual;
+   }
+}
+
+int main( int argc, char** argv )
+{
+   walberla::debug::enterTestMode();
+   walberla::mpi::Environment MPIenv( argc, argv );
+   walberla::MPIManager::instance()->useWorldComm();
+
+   // 2D
+   {
+      MeshInfo meshInfo = MeshInfo::meshRectangle( Point2D( 0, 0 ), Point2D( 2, 1 ), MeshInfo::CRISSCROSS, 2, 2 );
+      SetupPrimitiveStorage setupStorage( meshInfo, uint_c( walberla::mpi::MPIManager::instance()->numProcesses() ) );
+      setupStorage.setMeshBoundaryFlagsOnBoundary( 1, 0, true );
+      auto storage = std::make_shared< PrimitiveStorage >( setupStorage );
+
+      testStandalone( storage, 5, "2D", true );
+      testStandalone( storage, 5, "2D", false );
+      testCoarseGridSolver( storage, 3, 6 );
+   }
+
+   // 3D
+   {
+      MeshInfo meshInfo = MeshInfo::meshSymmetricCuboid( Point3D( 0, 0, 0 ), Point3D( 1, 1, 1 ), 1, 1, 1 );
+      SetupPrimitiveStorage setupStorage( meshInfo, uint_c( walberla::mpi::MPIManager::instance()->numProcesses() ) );
+      setupStorage.setMeshBoundaryFlagsOnBoundary( 1, 0, true );
+      auto storage = std::make_shared< PrimitiveStorage >( setupStorage );
+
+      testStandalone( storage, 3, "3D", true );
+      testStandalone( storage, 3, "3D", false );
+   }
+
+   return EXIT_SUCCESS;
+}
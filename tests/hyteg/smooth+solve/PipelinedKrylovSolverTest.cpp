@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2026 Nils Kohl, Marcus Mohr.
+ *
+ * This file is part of HyTeG
+ * (see https://i10git.cs.fau.de/hyteg/hyteg).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Checks that PipelinedCGSolver and PipelinedMinResSolver compute the same iterates as CGSolver and MinResSolver
+// (up to round-off) for P1 and P2 functions, in 2D and 3D, with and without preconditioner.
+
+#include "core/Environment.h"
+#include "core/logging/Logging.h"
+#include "core/math/Constants.h"
+
+#include "hyteg/elementwiseoperators/P1ElementwiseOperator.hpp"
+#include "hyteg/elementwiseoperators/P2ElementwiseOperator.hpp"
+#include "hyteg/primitivestorage/PrimitiveStorage.hpp"
+#include "hyteg/primitivestorage/SetupPrimitiveStorage.hpp"
+#include "hyteg/solvers/CGSolver.hpp"
+#include "hyteg/solvers/MinresSolver.hpp"
+#include "hyteg/solvers/PipelinedCGSolver.hpp"
+#include "hyteg/solvers/PipelinedMinresSolver.hpp"
+#include "hyteg/solvers/WeightedJacobiSmoother.hpp"
+
+using walberla::real_t;
+using walberla::uint_c;
+using walberla::uint_t;
+using walberla::math::pi;
+
+using namespace hyteg;
+
+template < typename OperatorType, typename SolverType, typename PipelinedSolverType >
+void runCheck( const std::string& meshFile, bool precondition )
+{
+   using FunctionType = typename OperatorType::srcType;
+
+   const uint_t level   = 3;
+   const uint_t maxIter = 20;
+
+   auto                  meshInfo = MeshInfo::fromGmshFile( meshFile );
+   SetupPrimitiveStorage setupStorage( meshInfo, uint_c( walberla::mpi::MPIManager::instance()->numProcesses() ) );
+   setupStorage.setMeshBoundaryFlagsOnBoundary( 1, 0, true );
+   auto storage = std::make_shared< PrimitiveStorage >( setupStorage );
+
+   OperatorType A( storage, level, level );
+
+   FunctionType u( "u", storage, level, level );
+   FunctionType uPipelined( "uPipelined", storage, level, level );
+   FunctionType f( "f", storage, level, level );
+   FunctionType err( "err", storage, level, level );
+
+   std::function< real_t( const Point3D& ) > rhs = []( const Point3D& x ) {
+      return std::sin( pi * x[0] ) * std::sin( pi * x[1] ) + x[2];
+   };
+   f.interpolate( rhs, level, All );
+
+   std::shared_ptr< Solver< OperatorType > > preconditioner = std::make_shared< IdentityPreconditioner< OperatorType > >();
+   if ( precondition )
+   {
+      A.computeInverseDiagonalOperatorValues();
+      preconditioner = std::make_shared< WeightedJacobiSmoother< OperatorType > >( storage, level, level, real_c( 0.66 ) );
+   }
+
+   SolverType          solver( storage, level, level, maxIter, real_c( 0 ), real_c( 0 ), preconditioner );
+   PipelinedSolverType pipelinedSolver( storage, level, level, maxIter, real_c( 0 ), real_c( 0 ), preconditioner );
+
+   solver.solve( A, u, f, level );
+   pipelinedSolver.solve( A, uPipelined, f, level );
+
+   err.assign( { real_c( 1 ), real_c( -1 ) }, { u, uPipelined }, level, All );
+   const real_t diff = std::sqrt( err.dotGlobal( err, level, All ) );
+   const real_t norm = std::sqrt( u.dotGlobal( u, level, All ) );
+
+   WALBERLA_LOG_INFO_ON_ROOT( meshFile << ", preconditioned: " << precondition
+                                       << ", ||u - u_pipelined|| / ||u|| = " << diff / norm );
+   // the pipelined recurrences amplify round-off errors a bit more than the classical ones
+   WALBERLA_CHECK_LESS( diff / norm, real_c( std::is_same< real_t, double >() ? 1e-8 : 1e-3 ) );
+
+   // without iterations, the solver must not touch the solution
+   PipelinedSolverType noIterationSolver( storage, level, level, 0, real_c( 0 ), real_c( 0 ), preconditioner );
+   err.assign( { real_c( 1 ) }, { uPipelined }, level, All );
+   noIterationSolver.solve( A, err, f, level );
+   err.assign( { real_c( 1 ), real_c( -1 ) }, { err, uPipelined }, level, All );
+   WALBERLA_CHECK_EQUAL( err.getMaxDoFMagnitude( level, All ), real_c( 0 ) );
+}
+
+int main( int argc, char* argv[] )
+{
+   walberla::Environment walberlaEnv( argc, argv );
+   walberla::logging::Logging::instance()->setLogLevel( walberla::logging::Logging::PROGRESS );
+   walberla::MPIManager::instance()->useWorldComm();
+
+   for ( const auto& mesh : { prependHyTeGMeshDir( "2D/quad_8el.msh" ), prependHyTeGMeshDir( "3D/cube_6el.msh" ) } )
+   {
+      for ( bool precondition : { false, true } )
+      {
+         runCheck< P1ElementwiseLaplaceOperator,
+                   CGSolver< P1ElementwiseLaplaceOperator >,
+                   PipelinedCGSolver< P1ElementwiseLaplaceOperator > >( mesh, precondition );
+         runCheck< P2ElementwiseLaplaceOperator,
+                   CGSolver< P2ElementwiseLaplaceOperator >,
+                   PipelinedCGSolver< P2ElementwiseLaplaceOperator > >( mesh, precondition );
+         runCheck< P1ElementwiseLaplaceOperator,
+                   MinResSolver< P1ElementwiseLaplaceOperator >,
+                   PipelinedMinResSolver< P1ElementwiseLaplaceOperator > >( mesh, precondition );
+         runCheck< P2ElementwiseLaplaceOperator,
+                   MinResSolver< P2ElementwiseLaplaceOperator >,
+                   PipelinedMinResSolver< P2ElementwiseLaplaceOperator > >( mesh, precondition );
+      }
+   }
+
+   return 0;
+}
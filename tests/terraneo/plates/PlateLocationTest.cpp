@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2026 Nils Kohl, Marcus Mohr.
+ *
+ * This file is part of HyTeG
+ * (see https://i10git.cs.fau.de/hyteg/hyteg).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Compares the plate IDs and boundary distances from findPlatesAndDistances() and findPlateAndDistance(), which prune
+// plates and boundary segments with bounding caps, against a brute-force search over all plates and segments. Besides
+// random points on the sphere, points close to plate boundaries and close to the antipodes of the bounding caps are
+// tested, as there the pruning is most likely to go wrong.
+
+#include <cmath>
+
+#include "core/Environment.h"
+#include "core/debug/CheckFunctions.h"
+#include "core/logging/Logging.h"
+#include "core/math/Random.h"
+
+#include "terraneo/dataimport/FileIO.hpp"
+#include "terraneo/plates/PlateStorage.hpp"
+#include "terraneo/plates/functionsForPlates.hpp"
+
+using namespace hyteg;
+using namespace terraneo;
+using namespace terraneo::plates;
+
+const uint_t idWhenNoPlateFound{ 0 };
+
+/// Determines the plate and the distance to its boundary without any precomputed geometry, i.e. the polygon is
+/// constructed for every plate and the distances to all segments are computed
+std::tuple< bool, uint_t, real_t > findPlateAndDistanceBruteForce( const PlateStorage::plateVec_t& plates, const vec3D& point )
+{
+   spherical_point pntSph( point[0], point[1] );
+
+   for ( const auto& currentPlate : plates )
+   {
+      polygon_on_sphere polygonOnSphere;
+      for ( const auto& node : currentPlate.boundary )
+      {
+         boost::geometry::append( polygonOnSphere.outer(), spherical_point( node[0], node[1] ) );
+      }
+      boost::geometry::correct( polygonOnSphere );
+
+      if ( boost::geometry::within( pntSph, polygonOnSphere ) )
+      {
+         real_t distance{ std::numeric_limits< real_t >::max() };
+         boost::geometry::for_each_segment( polygonOnSphere, [&distance, &pntSph]( const auto& segment ) {
+            distance = std::min< real_t >( distance, boost::geometry::distance( segment, pntSph ) );
+         } );
+         return std::make_tuple( true, currentPlate.id, distance * plates::constants::earthRadiusInKm );
+      }
+   }
+
+   return std::make_tuple( false, idWhenNoPlateFound, std::numeric_limits< real_t >::max() );
+}
+
+/// returns (longitude, latitude) of a point that is perturbed by up to maxOffset degrees in both directions
+vec3D perturbedLonLat( real_t lon, real_t lat, real_t maxOffset )
+{
+   lon += walberla::math::realRandom( -maxOffset, maxOffset );
+   lat += walberla::math::realRandom( -maxOffset, maxOffset );
+   lat = std::clamp( lat, real_c( -90 ), real_c( 90 ) );
+   if ( lon > real_c( 180 ) )
+   {
+      lon -= real_c( 360 );
+   }
+   else if ( lon < real_c( -180 ) )
+   {
+      lon += real_c( 360 );
+   }
+   return vec3D( lon, lat, real_c( 0 ) );
+}
+
+void testStage( const PlateStorage& plateStore, real_t age )
+{
+   const auto& plates = plateStore.getPlatesForStage( age );
+
+   std::vector< vec3D > points;
+
+   // uniformly distributed points on the sphere
+   for ( uint_t k = 0; k < 5000; ++k )
+   {
+      const real_t lon = walberla::math::realRandom( real_c( -180 ), real_c( 180 ) );
+      const real_t lat = conversions::radToDeg( std::asin( walberla::math::realRandom( real_c( -1 ), real_c( 1 ) ) ) );
+      points.push_back( vec3D( lon, lat, real_c( 0 ) ) );
+   }
+
+   uint_t numCaps{ 0 };
+   for ( const auto& plate : plates )
+   {
+      // points close to the boundary nodes and to the midpoints of the boundary segments
+      for ( uint_t k = 0; k < plate.boundary.size(); k += 5 )
+      {
+         points.push_back( perturbedLonLat( plate.boundary[k][0], plate.boundary[k][1], real_c( 1e-2 ) ) );
+         points.push_back( perturbedLonLat( plate.boundary[k][0], plate.boundary[k][1], real_c( 1e-6 ) ) );
+      }
+      for ( const auto& segment : plate.segments )
+      {
+         const vec3D midpoint = conversions::cart2sph( segment.midpoint );
+         points.push_back( perturbedLonLat( midpoint[0], midpoint[1], real_c( 1e-4 ) ) );
+      }
+
+      // points close to the antipode of the bounding cap and close to the rim of the cap
+      if ( plate.capCosRadius > real_c( -1 ) )
+      {
+         ++numCaps;
+
+         const vec3D antipode = conversions::cart2sph( -plate.capCenter );
+         points.push_back( vec3D( antipode[0], antipode[1], real_c( 0 ) ) );
+         for ( uint_t k = 0; k < 10; ++k )
+         {
+            points.push_back( perturbedLonLat( antipode[0], antipode[1], real_c( 1 ) ) );
+         }
+
+         const vec3D  center = conversions::cart2sph( plate.capCenter );
+         const real_t radius = conversions::radToDeg( std::acos( plate.capCosRadius ) );
+         for ( uint_t k = 0; k < 10; ++k )
+         {
+            const real_t lat = std::clamp( center[1] + radius, real_c( -90 ), real_c( 90 ) );
+            points.push_back( perturbedLonLat( center[0], lat, real_c( 1e-3 ) ) );
+         }
+      }
+   }
+
+   WALBERLA_LOG_INFO_ON_ROOT( "age " << age << ": " << plates.size() << " plates (" << numCaps << " with bounding cap), "
+                                     << points.size() << " points" );
+
+   const auto batchResults = findPlatesAndDistances( age, plateStore, points, idWhenNoPlateFound );
+   WALBERLA_CHECK_EQUAL( batchResults.size(), points.size() );
+
+   for ( uint_t k = 0; k < points.size(); ++k )
+   {
+      const auto [refFound, refID, refDistance] = findPlateAndDistanceBruteForce( plates, points[k] );
+      const auto [found, id, distance]          = batchResults[k];
+
+      WALBERLA_CHECK_EQUAL( found, refFound, "Plate detection differs for (lon, lat) = " << points[k] );
+      WALBERLA_CHECK_EQUAL( id, refID, "Plate ID differs for (lon, lat) = " << points[k] );
+      if ( refFound )
+      {
+         WALBERLA_CHECK_LESS_EQUAL( std::abs( distance - refDistance ),
+                                    real_c( 1e-9 ) * std::max( real_c( 1 ), refDistance ),
+                                    "Distance differs for (lon, lat) = " << points[k] );
+      }
+
+      // the point-wise query must give the same result as the batched one
+      const auto [singleFound, singleID, singleDistance] = findPlateAndDistance( age, plateStore, points[k], idWhenNoPlateFound );
+      WALBERLA_CHECK_EQUAL( singleFound, found );
+      WALBERLA_CHECK_EQUAL( singleID, id );
+      WALBERLA_CHECK_EQUAL( singleDistance, distance );
+   }
+}
+
+int main( int argc, char* argv[] )
+{
+   walberla::Environment walberlaEnv( argc, argv );
+   walberla::logging::Logging::instance()->setLogLevel( walberla::logging::Logging::PROGRESS );
+   walberla::MPIManager::instance()->useWorldComm();
+
+   walberla::math::seedRandomGenerator( 4711 );
+
+   std::string  dataDir{ "../../data/terraneo/plates/" };
+   PlateStorage plateStore( dataDir + "topologies0-100Ma.geojson", real_c( 1 ), []( const std::string& filename ) {
+      return terraneo::io::readJsonFile( filename );
+   } );
+
+   const auto& stages = plateStore.getListOfPlateStages();
+   for ( const real_t age : { stages.front(), stages[stages.size() / 2], stages.back() } )
+   {
+      testStage( plateStore, age );
+   }
+
+   return EXIT_SUCCESS;
+}
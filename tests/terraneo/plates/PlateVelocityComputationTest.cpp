@@ -90,6 +90,67 @@ std::vector< checkItem > setupReferenceValues()
    return refs;
 }
 
+/// Compares the velocities obtained with the cached Euler vectors of the oracle against the uncached
+/// computeCartesianVelocityVector() for several ages, such that ages are evicted from the cache and revisited
+void checkEulerVectorCache( terraneo::plates::PlateVelocityProvider& oracle,
+                            const std::string&                       fnameTopologies,
+                            const std::string&                       fnameReconstructions )
+{
+   terraneo::plates::PlateStorage plateStore(
+       fnameTopologies, real_c( 1 ), []( const std::string& filename ) { return terraneo::io::readJsonFile( filename ); } );
+   terraneo::plates::PlateRotationProvider rotations(
+       fnameReconstructions, []( const std::string& filename ) { return terraneo::io::readRotationsFile( filename ); } );
+   terraneo::plates::LinearDistanceSmoother smoother{ 0.015 };
+
+   std::vector< vec3D > points;
+   for ( int lat = -80; lat <= 80; lat += 20 )
+   {
+      for ( int lon = -170; lon < 180; lon += 20 )
+      {
+         points.push_back( terraneo::conversions::sph2cart( { real_c( lon ), real_c( lat ) } ) );
+      }
+   }
+
+   // more ages than fit into the cache, the first ones are revisited after being evicted
+   const auto&           stages = oracle.getListOfPlateStages();
+   std::vector< real_t > ages;
+   for ( uint_t k = 0; k < 10; ++k )
+   {
+      ages.push_back( stages[( k * ( stages.size() - 1 ) ) / 9] );
+   }
+   ages.push_back( ages[0] );
+   ages.push_back( ages[1] );
+   ages.push_back( ages[9] );
+
+   for ( const real_t age : ages )
+   {
+      oracle.prepareAge( age );
+      WALBERLA_CHECK_LESS_EQUAL( oracle.getNumberOfCachedAges(), 6 );
+
+      const std::vector< vec3D > batchVelocities = oracle.getPointVelocities( points, age );
+
+      for ( uint_t k = 0; k < points.size(); ++k )
+      {
+         const vec3D pointLonLat = terraneo::conversions::cart2sph( points[k] );
+         const auto [plateFound, plateID, distance] =
+             terraneo::plates::findPlateAndDistance( age, plateStore, pointLonLat, oracle.idWhenNoPlateFound );
+         if ( !plateFound )
+         {
+            continue;
+         }
+
+         const vec3D reference = terraneo::plates::computeCartesianVelocityVector(
+             rotations, int( plateID ), age, pointLonLat, smoother( distance ) );
+         const vec3D cached = oracle.getPointVelocity( points[k], age );
+
+         const real_t tolerance = real_c( std::is_same_v< real_t, double > ? 1e-12 : 1e-5f ) * reference.norm();
+         WALBERLA_CHECK_LESS_EQUAL( ( cached - reference ).norm(), tolerance, "age = " << age << ", point = " << pointLonLat );
+         WALBERLA_CHECK_LESS_EQUAL(
+             ( batchVelocities[k] - reference ).norm(), tolerance, "age = " << age << ", point = " << pointLonLat );
+      }
+   }
+}
+
 int main( int argc, char* argv[] )
 {
 
@@ -167,5 +228,10 @@ int main( int argc, char* argv[] )
       WALBERLA_CHECK_LESS_EQUAL( magDiff, angleTol );
    }
 
+   WALBERLA_LOG_INFO_ON_ROOT( " ======================================================\n"
+                              << "  Testing cached Euler vectors\n"
+                              << " ----------------------------" );
+   checkEulerVectorCache( oracle, fnameTopologies, fnameReconstructions );
+
    return EXIT_SUCCESS;
 }
@@ -128,6 +128,59 @@ void testRadialPointCloudOutput( uint_t nTan, uint_t nRad, real_t rMin, real_t r
    }
 }
 
+/// Compares the radial profiles computed by visiting the DoFs directly with the ones computed from the DoF coordinates.
+template < typename FunctionType >
+void testRadialProfile( uint_t nTan, std::vector< real_t > layers, uint_t level )
+{
+   auto storage = setupSphericalShellStorage( nTan, layers );
+
+   const real_t rMin = layers.front();
+   const real_t rMax = layers.back();
+
+   FunctionType u( "u", storage, level, level );
+
+   std::function< real_t( const Point3D& ) > f = []( const Point3D& x ) {
+      return x.norm() + std::sin( real_c( 3 ) * x[0] ) * x[1] - x[2] * x[2];
+   };
+   if constexpr ( std::is_same_v< typename FunctionType::Tag, P1VectorFunctionTag > ||
+                  std::is_same_v< typename FunctionType::Tag, P2VectorFunctionTag > )
+   {
+      u.interpolate( { f, []( const Point3D& x ) { return x[0] * x[2]; }, []( const Point3D& x ) { return x[1]; } }, level );
+   }
+   else
+   {
+      u.interpolate( f, level );
+   }
+
+   const auto profile         = computeRadialProfile( u, rMin, rMax, layers, level );
+   const auto profileByRadius = computeRadialProfile( u, rMin, rMax, layers, level, []( const Point3D& x ) { return x.norm(); } );
+
+   const real_t tolerance = std::is_same_v< real_t, double > ? real_c( 1e-12 ) : real_c( 1e-5 );
+
+   const uint_t numShells = numberOfShells( layers.size(), level, polynomialDegreeOfBasisFunctions< FunctionType >() );
+
+   WALBERLA_CHECK_EQUAL( profile.shellRadii.size(), numShells );
+   for ( uint_t shell = 0; shell < profile.shellRadii.size(); shell++ )
+   {
+      WALBERLA_CHECK_EQUAL( profile.numDoFsPerShell[shell], profileByRadius.numDoFsPerShell[shell], "shell " << shell );
+      WALBERLA_CHECK_FLOAT_EQUAL( profile.min[shell], profileByRadius.min[shell], "shell " << shell );
+      WALBERLA_CHECK_FLOAT_EQUAL( profile.max[shell], profileByRadius.max[shell], "shell " << shell );
+      WALBERLA_CHECK_LESS( std::abs( profile.mean[shell] - profileByRadius.mean[shell] ), tolerance, "shell " << shell );
+      WALBERLA_CHECK_LESS( std::abs( profile.rms[shell] - profileByRadius.rms[shell] ), tolerance, "shell " << shell );
+   }
+
+   // all gathered points must lie on the shell they are stored for
+   RadialShellData< FunctionType > shellData;
+   shellData.addDataFromFunction( u, rMin, rMax, layers, level );
+   for ( uint_t shell = 0; shell < profile.shellRadii.size(); shell++ )
+   {
+      for ( const auto& x : shellData.points( shell ) )
+      {
+         WALBERLA_CHECK_LESS( std::abs( x.norm() - profile.shellRadii[shell] ), tolerance, "shell " << shell );
+      }
+   }
+}
+
 template < typename FunctionType >
 void testRadialIntegerIDOutput( uint_t nTan, uint_t nRad, real_t rMin, real_t rMax, uint_t level )
 {
@@ -178,6 +231,18 @@ int main( int argc, char** argv )
    WALBERLA_LOG_INFO_ON_ROOT( "testRadialOutput< P2VectorFunction< real_t > >()" )
    terraneo::testRadialPointCloudOutput< P2VectorFunction< real_t > >( 5, 3, 0.5, 1.0, 2 );
 
+   WALBERLA_LOG_INFO_ON_ROOT( "testRadialProfile< P1Function< real_t > >()" )
+   terraneo::testRadialProfile< P1Function< real_t > >( 3, { 0.5, 0.55, 0.8, 1.0 }, 3 );
+
+   WALBERLA_LOG_INFO_ON_ROOT( "testRadialProfile< P1VectorFunction< real_t > >()" )
+   terraneo::testRadialProfile< P1VectorFunction< real_t > >( 3, { 0.5, 0.55, 0.8, 1.0 }, 2 );
+
+   WALBERLA_LOG_INFO_ON_ROOT( "testRadialProfile< P2Function< real_t > >()" )
+   terraneo::testRadialProfile< P2Function< real_t > >( 3, { 0.5, 0.55, 0.8, 1.0 }, 2 );
+
+   WALBERLA_LOG_INFO_ON_ROOT( "testRadialProfile< P2VectorFunction< real_t > >()" )
+   terraneo::testRadialProfile< P2VectorFunction< real_t > >( 3, { 0.5, 0.55, 0.8, 1.0 }, 1 );
+
    WALBERLA_LOG_INFO_ON_ROOT( "testRadialOutput< P1Function< real_t > >()" )
    terraneo::testRadialIntegerIDOutput< P1Function< int32_t > >( 5, 3, 0.5, 1.0, 2 );
 
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2026 Nils Kohl, Marcus Mohr.
+ *
+ * This file is part of HyTeG
+ * (see https://i10git.cs.fau.de/hyteg/hyteg).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Checks the coefficient based synthesis of the SphericalHarmonicsTool against the evaluation of single harmonics,
+// and the forward transform for functions given analytically and as P2 functions on a spherical shell.
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+#include "core/DataTypes.h"
+#include "core/Environment.h"
+#include "core/debug/CheckFunctions.h"
+#include "core/math/Random.h"
+#include "core/mpi/MPIManager.h"
+
+#include "hyteg/geometry/IcosahedralShellMap.hpp"
+#include "hyteg/mesh/MeshInfo.hpp"
+#include "hyteg/p2functionspace/P2Function.hpp"
+#include "hyteg/primitivestorage/PrimitiveStorage.hpp"
+#include "hyteg/primitivestorage/SetupPrimitiveStorage.hpp"
+#include "hyteg/primitivestorage/loadbalancing/SimpleBalancer.hpp"
+
+#include "terraneo/sphericalharmonics/SphericalHarmonicsTool.hpp"
+#include "terraneo/sphericalharmonics/SphericalHarmonicsTransform.hpp"
+
+using terraneo::SphericalHarmonicsTool;
+using walberla::int_c;
+using walberla::real_c;
+using walberla::real_t;
+using walberla::uint_c;
+using walberla::uint_t;
+using namespace hyteg;
+
+std::vector< real_t > randomCoefficients( uint_t lmax )
+{
+   std::vector< real_t > coeffs( SphericalHarmonicsTool::numberOfCoefficients( lmax ), real_c( 0 ) );
+   for ( uint_t deg = 0; deg <= lmax; ++deg )
+   {
+      for ( uint_t ord = 0; ord <= deg; ++ord )
+      {
+         coeffs[SphericalHarmonicsTool::coefficientIndex( deg, ord, 0 )] = real_c( walberla::math::realRandom( -1.0, 1.0 ) );
+         if ( ord > 0 )
+         {
+            coeffs[SphericalHarmonicsTool::coefficientIndex( deg, ord, 1 )] = real_c( walberla::math::realRandom( -1.0, 1.0 ) );
+         }
+      }
+   }
+   return coeffs;
+}
+
+real_t maxDifference( const std::vector< real_t >& a, const std::vector< real_t >& b )
+{
+   WALBERLA_CHECK_EQUAL( a.size(), b.size() );
+   real_t diff = real_c( 0 );
+   for ( uint_t k = 0; k < a.size(); ++k )
+   {
+      diff = std::max( diff, std::abs( a[k] - b[k] ) );
+   }
+   return diff;
+}
+
+void testSynthesis( uint_t lmax )
+{
+   const real_t tolerance = std::is_same_v< real_t, double > ? real_c( 1e-11 ) : real_c( 1e-3 );
+
+   SphericalHarmonicsTool sphTool( lmax );
+   const auto             coeffs = randomCoefficients( lmax );
+
+   // random points, and points sharing the co-latitude to exercise the grouping in the batched evaluation
+   std::vector< Point3D > points;
+   for ( uint_t k = 0; k < 20; ++k )
+   {
+      points.emplace_back( real_c( walberla::math::realRandom( -1.0, 1.0 ) ),
+                           real_c( walberla::math::realRandom( -1.0, 1.0 ) ),
+                           real_c( walberla::math::realRandom( -1.0, 1.0 ) ) );
+   }
+   for ( uint_t k = 0; k < 10; ++k )
+   {
+      const real_t phi = real_c( 0.6 ) * real_c( k );
+      points.emplace_back( real_c( 2 ) * std::cos( phi ), real_c( 2 ) * std::sin( phi ), real_c( 0.5 ) );
+   }
+   points.emplace_back( real_c( 0 ), real_c( 0 ), real_c( 1 ) );
+   points.emplace_back( real_c( 0 ), real_c( 0 ), real_c( -3 ) );
+
+   std::vector< real_t > reference;
+   std::vector< real_t > single;
+   for ( const auto& x : points )
+   {
+      real_t value = real_c( 0 );
+      for ( uint_t deg = 0; deg <= lmax; ++deg )
+      {
+         for ( int ord = -int_c( deg ); ord <= int_c( deg ); ++ord )
+         {
+            const real_t c = coeffs[SphericalHarmonicsTool::coefficientIndex( deg, uint_c( std::abs( ord ) ), ord > 0 ? 1 : 0 )];
+            value += c * sphTool.shconvert_eval( deg, ord, x[0], x[1], x[2] );
+         }
+      }
+      reference.push_back( value );
+      single.push_back( sphTool.evaluate( coeffs, lmax, x[0], x[1], x[2] ) );
+   }
+
+   std::vector< real_t > batched;
+   sphTool.evaluate( coeffs, lmax, points, batched );
+
+   const real_t errorSingle  = maxDifference( reference, single );
+   const real_t errorBatched = maxDifference( reference, batched );
+   WALBERLA_LOG_INFO_ON_ROOT( "lmax = " << lmax << ", synthesis error: single point " << errorSingle << ", batched "
+                                        << errorBatched );
+   WALBERLA_CHECK_LESS( errorSingle, tolerance );
+   WALBERLA_CHECK_LESS( errorBatched, tolerance );
+}
+
+void testForwardTransform( uint_t lmax )
+{
+   const real_t tolerance = std::is_same_v< real_t, double > ? real_c( 1e-11 ) : real_c( 1e-3 );
+
+   SphericalHarmonicsTool sphTool( lmax );
+   const auto             coeffs = randomCoefficients( lmax );
+
+   const auto computed = sphTool.forwardTransform(
+       [&]( const Point3D& x ) { return sphTool.evaluate( coeffs, lmax, x[0], x[1], x[2] ); }, lmax );
+
+   const real_t error = maxDifference( coeffs, computed );
+   WALBERLA_LOG_INFO_ON_ROOT( "lmax = " << lmax << ", forward transform error: " << error );
+   WALBERLA_CHECK_LESS( error, tolerance );
+}
+
+void testForwardTransformOfFEFunction( uint_t lmax, uint_t level )
+{
+   const real_t rMin = real_c( 0.5 );
+   const real_t rMax = real_c( 1.0 );
+
+   MeshInfo              meshInfo = MeshInfo::meshSphericalShell( 3, 2, rMin, rMax );
+   SetupPrimitiveStorage setupStorage( meshInfo, uint_c( walberla::mpi::MPIManager::instance()->numProcesses() ) );
+   loadbalancing::roundRobin( setupStorage );
+   setupStorage.setMeshBoundaryFlagsOnBoundary( 1, 0, true );
+   IcosahedralShellMap::setMap( setupStorage );
+   auto storage = std::make_shared< PrimitiveStorage >( setupStorage );
+
+   SphericalHarmonicsTool sphTool( lmax );
+   const auto             coeffs = randomCoefficients( lmax );
+
+   // the expansion is scaled linearly in radial direction
+   P2Function< real_t > f( "f", storage, level, level );
+   f.interpolate( [&]( const Point3D& x ) { return x.norm() * sphTool.evaluate( coeffs, lmax, x[0], x[1], x[2] ); }, level, All );
+
+   for ( real_t radius : { real_c( 0.6 ), real_c( 0.75 ), real_c( 0.9 ) } )
+   {
+      auto computed = terraneo::computeSphericalHarmonicsCoefficients( sphTool, f, level, radius, lmax );
+      for ( auto& c : computed )
+      {
+         c /= radius;
+      }
+
+      const real_t error = maxDifference( coeffs, computed );
+      WALBERLA_LOG_INFO_ON_ROOT( "lmax = " << lmax << ", radius = " << radius << ", P2 forward transform error: " << error );
+      WALBERLA_CHECK_LESS( error, real_c( 2e-2 ) );
+   }
+}
+
+int main( int argc, char* argv[] )
+{
+   walberla::debug::enterTestMode();
+   walberla::mpi::Environment MPIenv( argc, argv );
+   walberla::MPIManager::instance()->useWorldComm();
+
+   // all processes must use the same coefficients
+   walberla::math::seedRandomGenerator( 42 );
+
+   testSynthesis( 6 );
+   testSynthesis( 40 );
+
+   testForwardTransform( 6 );
+   testForwardTransform( 40 );
+
+   testForwardTransformOfFEFunction( 3, 3 );
+
+   return EXIT_SUCCESS;
+}